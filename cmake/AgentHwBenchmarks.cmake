@@ -17,6 +17,20 @@ target_link_libraries(hw_tx_slow_path_rate
   Folly::follybenchmark
 )
 
+add_library(hw_tun_tx_rate
+  fboss/agent/hw/benchmarks/HwTunTxBenchmark.cpp
+)
+
+target_link_libraries(hw_tun_tx_rate
+  mono_agent_ensemble
+  mono_agent_benchmarks
+  config_factory
+  ecmp_helper
+  state_utils
+  Folly::folly
+  Folly::follybenchmark
+)
+
 add_library(hw_stats_collection_speed
   fboss/agent/hw/benchmarks/HwStatsCollectionBenchmark.cpp
 )
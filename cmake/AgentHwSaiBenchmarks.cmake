@@ -222,6 +222,23 @@ function(BUILD_SAI_BENCHMARKS SAI_IMPL_NAME SAI_IMPL_ARG)
     -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
   )
 
+  add_executable(sai_tun_tx_rate-${SAI_IMPL_NAME} /dev/null)
+
+  target_link_libraries(sai_tun_tx_rate-${SAI_IMPL_NAME}
+    -Wl,--whole-archive
+    hw_tun_tx_rate
+    mono_sai_agent_benchmarks_main
+    ${SAI_IMPL_ARG}
+    -Wl,--no-whole-archive
+  )
+
+  set_target_properties(sai_tun_tx_rate-${SAI_IMPL_NAME}
+    PROPERTIES COMPILE_FLAGS
+    "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+    -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+    -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+  )
+
   add_executable(sai_ecmp_shrink_speed-${SAI_IMPL_NAME} /dev/null)
 
   target_link_libraries(sai_ecmp_shrink_speed-${SAI_IMPL_NAME}
@@ -542,6 +559,9 @@ if(SAI_IMPL AND BENCHMARK_INSTALL)
   install(
     TARGETS
     sai_tx_slow_path_rate-sai_impl)
+  install(
+    TARGETS
+    sai_tun_tx_rate-sai_impl)
   install(
     TARGETS
     sai_rx_slow_path_rate-sai_impl)
@@ -11,8 +11,10 @@ add_library(sai_store
 
 target_link_libraries(sai_store
   sai_api
+  sai_store_warmboot_cpp2
   ref_map
   tuple_utils
+  Folly::folly
 )
 
 set_target_properties(sai_store PROPERTIES COMPILE_FLAGS
@@ -33,6 +33,7 @@ set(SAI_SWITCH_SRC
   fboss/agent/hw/sai/switch/SaiRxPacket.cpp
   fboss/agent/hw/sai/switch/SaiSamplePacketManager.cpp
   fboss/agent/hw/sai/switch/SaiSchedulerManager.cpp
+  fboss/agent/hw/sai/switch/SaiStatsCollector.cpp
   fboss/agent/hw/sai/switch/SaiSwitch.cpp
   fboss/agent/hw/sai/switch/SaiSwitchManager.cpp
   fboss/agent/hw/sai/switch/SaiSystemPortManager.cpp
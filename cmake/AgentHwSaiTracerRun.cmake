@@ -27,13 +27,32 @@ function(BUILD_SAI_REPLAYER SAI_IMPL_NAME SAI_IMPL_ARG)
       -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
     )
 
+  add_executable(sai_binary_trace-${SAI_IMPL_NAME}
+    fboss/agent/hw/sai/tracer/run/SaiBinaryTraceMain.cpp
+    fboss/agent/hw/sai/tracer/run/SaiBinaryTraceReplayer.cpp
+  )
+
+  target_link_libraries(sai_binary_trace-${SAI_IMPL_NAME}
+    sai_tracer
+    ${SAI_IMPL_ARG}
+    Folly::folly
+  )
+
+  set_target_properties(sai_binary_trace-${SAI_IMPL_NAME}
+      PROPERTIES COMPILE_FLAGS
+      "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+      -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+      -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+    )
+
 endfunction()
 
 if(BUILD_SAI_FAKE)
 BUILD_SAI_REPLAYER("fake" fake_sai)
 install(
   TARGETS
-  sai_replayer-fake)
+  sai_replayer-fake
+  sai_binary_trace-fake)
 endif()
 
 # If libsai_impl is provided, build sai replayer linking with it
@@ -50,5 +69,6 @@ if(SAI_IMPL)
   BUILD_SAI_REPLAYER("sai_impl" ${SAI_IMPL})
   install(
     TARGETS
-    sai_replayer-sai_impl)
+    sai_replayer-sai_impl
+    sai_binary_trace-sai_impl)
 endif()
@@ -5,6 +5,7 @@
 
 add_library(standalone_rib
   fboss/agent/rib/ConfigApplier.cpp
+  fboss/agent/rib/NextHopDependencyIndex.cpp
   fboss/agent/rib/RouteUpdater.cpp
   fboss/agent/rib/RoutingInformationBase.cpp
 )
@@ -94,6 +94,7 @@ target_link_libraries(led_manager_lib
   fsdb_stream_client
   fsdb_pub_sub
   fsdb_flags
+  thrift_cow_serializer
 )
 
 add_library(led_core_lib
@@ -0,0 +1,20 @@
+# CMake to build libraries and binaries in fboss/led_service/test
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(led_service_sw_test
+  fboss/led_service/test/FsdbSwitchStateSubscriberTest.cpp
+)
+
+target_link_libraries(led_service_sw_test
+  led_manager_lib
+  address_utils
+  switch_state_cpp2
+  thrift_cow_serializer
+  Folly::folly
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+install(TARGETS led_service_sw_test)
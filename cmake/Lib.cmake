@@ -4,6 +4,8 @@
 # cmake/FooBar.cmake
 
 add_library(radix_tree
+  fboss/lib/PooledRadixTree.h
+  fboss/lib/PooledRadixTree-inl.h
   fboss/lib/RadixTree.h
   fboss/lib/RadixTree-inl.h
 )
@@ -50,6 +50,7 @@ target_link_libraries(platform_manager_i2c_explorer
   fmt::fmt
   platform_manager_config_cpp2
   i2c_ctrl
+  platform_fs_utils
   platform_utils
   Folly::folly
   ${RE2}
@@ -95,6 +96,7 @@ target_link_libraries(platform_manager_pci_explorer
   platform_manager_i2c_explorer
   platform_manager_config_cpp2
   platform_manager_utils
+  platform_fs_utils
   Folly::folly
 )
 
@@ -32,6 +32,7 @@ add_library(rackmon_lib
   fboss/platform/rackmon/Rackmon.cpp
   fboss/platform/rackmon/RackmonPlsManager.cpp
   fboss/platform/rackmon/Register.cpp
+  fboss/platform/rackmon/RegisterReadPlanner.cpp
   fboss/platform/rackmon/UARTDevice.cpp
   fboss/platform/rackmon/GeneratedRackmonRegisterMapConfig.cpp
   fboss/platform/rackmon/GeneratedRackmonInterfaceConfig.cpp
@@ -73,6 +74,7 @@ add_executable(rackmon_test
   fboss/platform/rackmon/tests/RackmonTest.cpp
   fboss/platform/rackmon/tests/RegisterDescriptorTest.cpp
   fboss/platform/rackmon/tests/RegisterMapTest.cpp
+  fboss/platform/rackmon/tests/RegisterReadPlannerTest.cpp
   fboss/platform/rackmon/tests/RegisterTest.cpp
   fboss/platform/rackmon/tests/RegisterValueTest.cpp
 )
@@ -185,6 +185,7 @@ target_link_libraries(transceiver_validator
 
 add_library(transceiver_manager STATIC
     fboss/qsfp_service/TransceiverManager.cpp
+    fboss/qsfp_service/TransceiverRefreshScheduler.cpp
     fboss/qsfp_service/TransceiverStateMachine.cpp
     fboss/qsfp_service/TransceiverStateMachineUpdate.cpp
 )
@@ -19,6 +19,7 @@ target_link_libraries(thrift_cow_serializer
 
 add_library(
   thrift_cow_nodes
+  fboss/thrift_cow/nodes/ThriftHybridNode-inl.h
   fboss/thrift_cow/nodes/ThriftListNode-inl.h
   fboss/thrift_cow/nodes/ThriftMapNode-inl.h
   fboss/thrift_cow/nodes/ThriftPrimitiveNode-inl.h
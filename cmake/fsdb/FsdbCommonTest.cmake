@@ -0,0 +1,13 @@
+add_executable(fsdb_common_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/fsdb/common/tests/UtilsTests.cpp
+)
+
+target_link_libraries(fsdb_common_test
+  fsdb_utils
+  thrift_cow_visitors
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(fsdb_common_test)
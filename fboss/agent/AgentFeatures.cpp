@@ -43,6 +43,11 @@ DEFINE_bool(
     dsf_subscribe_patch,
     false,
     "Subscribe to remote FSDB using Patch apis");
+DEFINE_uint32(
+    dsf_update_batch_interval_ms,
+    100,
+    "Interval over which updates from remote DSF nodes are batched into a "
+    "single switch state update. 0 applies them as soon as possible");
 // Remote neighbor entries are always flushed to avoid blackholing the traffic.
 // However, by default, remote{systemPorts, Rifs} are not flushed but marked
 // STALE in the software. This is to avoid hardware programmign churn.
@@ -44,6 +44,7 @@ DECLARE_uint32(dsf_num_parallel_sessions_per_remote_interface_node);
 DECLARE_int32(dsf_num_fsdb_connect_threads);
 DECLARE_int32(dsf_num_fsdb_stream_threads);
 DECLARE_bool(dsf_subscribe_patch);
+DECLARE_uint32(dsf_update_batch_interval_ms);
 
 DECLARE_bool(set_classid_for_my_subnet_and_ip_routes);
 DECLARE_int32(stat_publish_interval_ms);
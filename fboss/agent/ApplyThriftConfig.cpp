@@ -12,6 +12,8 @@
 #include <fboss/thrift_cow/nodes/ThriftMapNode-inl.h>
 #include <folly/FileUtil.h>
 #include <folly/gen/Base.h>
+#include <folly/hash/Hash.h>
+#include <folly/hash/SpookyHashV2.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <memory>
 #include <optional>
@@ -76,6 +78,7 @@
 #include <boost/container/flat_set.hpp>
 #include <folly/Range.h>
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <utility>
 #include <vector>
@@ -166,7 +169,8 @@ class ThriftConfigApplier {
       RoutingInformationBase* rib,
       AclNexthopHandler* aclNexthopHandler,
       const PlatformMapping* platformMapping,
-      const HwAsicTable* hwAsicTable)
+      const HwAsicTable* hwAsicTable,
+      ConfigFingerprint* fingerprint)
       : orig_(orig),
         cfg_(config),
         supportsAddRemovePort_(supportsAddRemovePort),
@@ -174,7 +178,8 @@ class ThriftConfigApplier {
         aclNexthopHandler_(aclNexthopHandler),
         scopeResolver_(getSwitchInfoFromConfig(config)),
         platformMapping_(platformMapping),
-        hwAsicTable_(hwAsicTable) {}
+        hwAsicTable_(hwAsicTable),
+        fingerprint_(fingerprint) {}
 
   ThriftConfigApplier(
       const std::shared_ptr<SwitchState>& orig,
@@ -183,7 +188,8 @@ class ThriftConfigApplier {
       RouteUpdateWrapper* routeUpdater,
       AclNexthopHandler* aclNexthopHandler,
       const PlatformMapping* platformMapping,
-      const HwAsicTable* hwAsicTable)
+      const HwAsicTable* hwAsicTable,
+      ConfigFingerprint* fingerprint)
       : orig_(orig),
         cfg_(config),
         supportsAddRemovePort_(supportsAddRemovePort),
@@ -191,7 +197,8 @@ class ThriftConfigApplier {
         aclNexthopHandler_(aclNexthopHandler),
         scopeResolver_(getSwitchInfoFromConfig(config)),
         platformMapping_(platformMapping),
-        hwAsicTable_(hwAsicTable) {}
+        hwAsicTable_(hwAsicTable),
+        fingerprint_(fingerprint) {}
 
   std::shared_ptr<SwitchState> run();
 
@@ -502,6 +509,21 @@ class ThriftConfigApplier {
       std::shared_ptr<SwitchSettings> switchSettings);
   QueueConfig getVoqConfig(PortID portId);
 
+  /*
+   * Config fingerprinting, see ConfigFingerprint.
+   *
+   * skipSection() is called right before a section would be evaluated, so
+   * the nodes it compares are the ones the section is about to read.
+   */
+  using Section = ConfigFingerprint::Section;
+  using SectionNodes = std::vector<std::shared_ptr<const void>>;
+  uint64_t getSectionHash(Section section) const;
+  SectionNodes getSectionNodes(
+      Section section,
+      const std::shared_ptr<SwitchState>& state) const;
+  bool skipSection(Section section);
+  void updateFingerprint(const std::shared_ptr<SwitchState>& state);
+
   std::shared_ptr<SwitchState> orig_;
   std::shared_ptr<SwitchState> new_;
   const cfg::SwitchConfig* cfg_{nullptr};
@@ -512,6 +534,10 @@ class ThriftConfigApplier {
   SwitchIdScopeResolver scopeResolver_;
   const PlatformMapping* platformMapping_{nullptr};
   const HwAsicTable* hwAsicTable_{nullptr};
+  ConfigFingerprint* fingerprint_{nullptr};
+  std::array<std::optional<uint64_t>, ConfigFingerprint::kNumSections>
+      sectionHashes_;
+  std::array<bool, ConfigFingerprint::kNumSections> skippedSections_{};
 
   struct InterfaceIpInfo {
     InterfaceIpInfo(uint8_t mask, MacAddress mac, InterfaceID intf)
@@ -574,7 +600,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
 
   processInterfaceForPort();
 
-  {
+  if (!skipSection(Section::PORTS)) {
     auto newPorts = updatePorts(new_->getTransceivers());
     if (newPorts) {
       new_->resetPorts(
@@ -588,7 +614,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!skipSection(Section::AGGREGATE_PORTS)) {
     auto newAggPorts = updateAggregatePorts();
     if (newAggPorts) {
       new_->resetAggregatePorts(toMultiSwitchMap<MultiSwitchAggregatePortMap>(
@@ -598,7 +624,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // updateMirrors must be called after updatePorts, mirror needs ports!
-  {
+  if (!skipSection(Section::MIRRORS)) {
     auto newMirrors = updateMirrors();
     if (newMirrors) {
       new_->resetMirrors(
@@ -608,7 +634,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
+  if (!skipSection(Section::ACLS)) {
     if (FLAGS_enable_acl_table_group) {
       auto newAclTableGroups = updateAclTableGroups();
       if (newAclTableGroups) {
@@ -626,7 +652,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!skipSection(Section::QOS_POLICIES)) {
     auto newQosPolicies = updateQosPolicies();
     if (newQosPolicies) {
       new_->resetQosPolicies(toMultiSwitchMap<MultiSwitchQosPolicyMap>(
@@ -740,7 +766,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // Add sFlow collectors
-  {
+  if (!skipSection(Section::SFLOW_COLLECTORS)) {
     auto newCollectors = updateSflowCollectors();
     if (newCollectors) {
       new_->resetSflowCollectors(toMultiSwitchMap<MultiSwitchSflowCollectorMap>(
@@ -749,7 +775,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!skipSection(Section::LOAD_BALANCERS)) {
     LoadBalancerConfigApplier loadBalancerConfigApplier(
         orig_->getLoadBalancers(), cfg_->get_loadBalancers());
     auto newLoadBalancers = loadBalancerConfigApplier.updateLoadBalancers(
@@ -762,7 +788,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  if (!skipSection(Section::IP_TUNNELS)) {
     auto newTunnels = updateIpInIpTunnels();
     if (newTunnels) {
       new_->resetTunnels(
@@ -781,7 +807,10 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
           orig_->getSwitchSettings()->getNodeIf(matcher.matcherString());
     }
 
-    auto newDsfNodes = updateDsfNodes();
+    std::shared_ptr<DsfNodeMap> newDsfNodes;
+    if (!skipSection(Section::DSF_NODES)) {
+      newDsfNodes = updateDsfNodes();
+    }
     if (newDsfNodes) {
       new_->resetDsfNodes(
           toMultiSwitchMap<MultiSwitchDsfNodeMap>(newDsfNodes, scopeResolver_));
@@ -807,12 +836,155 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
+  updateFingerprint(changed ? new_ : orig_);
   if (!changed) {
     return nullptr;
   }
   return new_;
 }
 
+uint64_t ThriftConfigApplier::getSectionHash(Section section) const {
+  // Only copy over the fields the section is built from, so that changes to
+  // any other part of the config leave its hash alone
+  cfg::SwitchConfig sectionCfg;
+  // Flags changing how the section is evaluated
+  uint64_t flags = 0;
+  switch (section) {
+    case Section::PORTS:
+      sectionCfg.ports().copy_from(cfg_->ports());
+      sectionCfg.vlanPorts().copy_from(cfg_->vlanPorts());
+      sectionCfg.interfaces().copy_from(cfg_->interfaces());
+      sectionCfg.dsfNodes().copy_from(cfg_->dsfNodes());
+      sectionCfg.switchSettings().copy_from(cfg_->switchSettings());
+      sectionCfg.portQueueConfigs().copy_from(cfg_->portQueueConfigs());
+      sectionCfg.defaultPortQueues().copy_from(cfg_->defaultPortQueues());
+      sectionCfg.dataPlaneTrafficPolicy().copy_from(
+          cfg_->dataPlaneTrafficPolicy());
+      sectionCfg.qosPolicies().copy_from(cfg_->qosPolicies());
+      sectionCfg.portPgConfigs().copy_from(cfg_->portPgConfigs());
+      sectionCfg.bufferPoolConfigs().copy_from(cfg_->bufferPoolConfigs());
+      sectionCfg.portFlowletConfigs().copy_from(cfg_->portFlowletConfigs());
+      flags = FLAGS_allow_zero_headroom_for_lossless_pg;
+      break;
+    case Section::AGGREGATE_PORTS:
+      sectionCfg.aggregatePorts().copy_from(cfg_->aggregatePorts());
+      sectionCfg.lacp().copy_from(cfg_->lacp());
+      // Member interfaces are derived from these
+      sectionCfg.ports().copy_from(cfg_->ports());
+      sectionCfg.vlanPorts().copy_from(cfg_->vlanPorts());
+      sectionCfg.interfaces().copy_from(cfg_->interfaces());
+      sectionCfg.dsfNodes().copy_from(cfg_->dsfNodes());
+      sectionCfg.switchSettings().copy_from(cfg_->switchSettings());
+      break;
+    case Section::MIRRORS:
+      sectionCfg.mirrors().copy_from(cfg_->mirrors());
+      sectionCfg.switchSettings().copy_from(cfg_->switchSettings());
+      break;
+    case Section::ACLS:
+      sectionCfg.acls().copy_from(cfg_->acls());
+      sectionCfg.aclTableGroup().copy_from(cfg_->aclTableGroup());
+      sectionCfg.cpuTrafficPolicy().copy_from(cfg_->cpuTrafficPolicy());
+      sectionCfg.dataPlaneTrafficPolicy().copy_from(
+          cfg_->dataPlaneTrafficPolicy());
+      sectionCfg.trafficCounters().copy_from(cfg_->trafficCounters());
+      sectionCfg.udfConfig().copy_from(cfg_->udfConfig());
+      flags = FLAGS_enable_acl_table_group | (FLAGS_sai_user_defined_trap << 1);
+      break;
+    case Section::QOS_POLICIES:
+      sectionCfg.qosPolicies().copy_from(cfg_->qosPolicies());
+      sectionCfg.dataPlaneTrafficPolicy().copy_from(
+          cfg_->dataPlaneTrafficPolicy());
+      break;
+    case Section::SFLOW_COLLECTORS:
+      sectionCfg.sFlowCollectors().copy_from(cfg_->sFlowCollectors());
+      break;
+    case Section::LOAD_BALANCERS:
+      sectionCfg.loadBalancers().copy_from(cfg_->loadBalancers());
+      sectionCfg.sdkVersion().copy_from(cfg_->sdkVersion());
+      break;
+    case Section::IP_TUNNELS:
+      sectionCfg.ipInIpTunnels().copy_from(cfg_->ipInIpTunnels());
+      break;
+    case Section::DSF_NODES:
+      sectionCfg.dsfNodes().copy_from(cfg_->dsfNodes());
+      break;
+  }
+  auto serialized =
+      apache::thrift::CompactSerializer::serialize<std::string>(sectionCfg);
+  return folly::hash::hash_128_to_64(
+      folly::hash::SpookyHashV2::Hash64(
+          serialized.data(), serialized.size(), 0 /* seed */),
+      flags);
+}
+
+ThriftConfigApplier::SectionNodes ThriftConfigApplier::getSectionNodes(
+    Section section,
+    const std::shared_ptr<SwitchState>& state) const {
+  // Nodes the section produces, followed by any other nodes it reads
+  switch (section) {
+    case Section::PORTS:
+      return {
+          state->getPorts(),
+          state->getTransceivers(),
+          state->getSwitchSettings(),
+          state->getBufferPoolCfgs(),
+          state->getPortFlowletCfgs()};
+    case Section::AGGREGATE_PORTS:
+      return {state->getAggregatePorts(), state->getSwitchSettings()};
+    case Section::MIRRORS:
+      return {state->getMirrors(), state->getPorts()};
+    case Section::ACLS:
+      return {
+          state->getAcls(), state->getAclTableGroups(), state->getMirrors()};
+    case Section::QOS_POLICIES:
+      return {state->getQosPolicies()};
+    case Section::SFLOW_COLLECTORS:
+      return {state->getSflowCollectors()};
+    case Section::LOAD_BALANCERS:
+      return {state->getLoadBalancers()};
+    case Section::IP_TUNNELS:
+      return {state->getTunnels()};
+    case Section::DSF_NODES:
+      return {state->getDsfNodes()};
+  }
+  throw FbossError("Unknown config section ", static_cast<int>(section));
+}
+
+bool ThriftConfigApplier::skipSection(Section section) {
+  if (!fingerprint_) {
+    return false;
+  }
+  auto idx = static_cast<size_t>(section);
+  sectionHashes_[idx] = getSectionHash(section);
+  const auto& prev = fingerprint_->sections_[idx];
+  // Nothing that feeds the section changed since it was last evaluated, so
+  // evaluating it again would leave the state as is
+  skippedSections_[idx] = prev && prev->hash == *sectionHashes_[idx] &&
+      prev->nodes == getSectionNodes(section, new_);
+  if (skippedSections_[idx]) {
+    XLOG(DBG2) << "Config section " << idx << " unchanged, skipping";
+  }
+  return skippedSections_[idx];
+}
+
+void ThriftConfigApplier::updateFingerprint(
+    const std::shared_ptr<SwitchState>& state) {
+  if (!fingerprint_) {
+    return;
+  }
+  for (size_t idx = 0; idx < ConfigFingerprint::kNumSections; ++idx) {
+    auto section = static_cast<Section>(idx);
+    auto& entry = fingerprint_->sections_[idx];
+    if (!sectionHashes_[idx]) {
+      entry.reset();
+      continue;
+    }
+    entry = ConfigFingerprint::SectionFingerprint{
+        *sectionHashes_[idx], getSectionNodes(section, state)};
+  }
+  fingerprint_->skipped_ = skippedSections_;
+}
+
 std::optional<SwitchID> ThriftConfigApplier::getAnyVoqSwitchId() {
   std::optional<SwitchID> switchId;
   for (const auto& switchIdAndSwitchInfo :
@@ -5348,7 +5520,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RoutingInformationBase* rib,
-    AclNexthopHandler* aclNexthopHandler) {
+    AclNexthopHandler* aclNexthopHandler,
+    ConfigFingerprint* fingerprint) {
   return ThriftConfigApplier(
              state,
              config,
@@ -5356,7 +5529,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
              rib,
              aclNexthopHandler,
              platformMapping,
-             hwAsicTable)
+             hwAsicTable,
+             fingerprint)
       .run();
 }
 
@@ -5367,7 +5541,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler) {
+    AclNexthopHandler* aclNexthopHandler,
+    ConfigFingerprint* fingerprint) {
   return ThriftConfigApplier(
              state,
              config,
@@ -5375,7 +5550,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
              routeUpdater,
              aclNexthopHandler,
              platformMapping,
-             hwAsicTable)
+             hwAsicTable,
+             fingerprint)
       .run();
 }
 
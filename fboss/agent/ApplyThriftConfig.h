@@ -10,7 +10,11 @@
 #pragma once
 
 #include <folly/Range.h>
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace facebook::fboss {
 
@@ -26,12 +30,70 @@ class RouteUpdateWrapper;
 class AclNexthopHandler;
 class PlatformMapping;
 class HwAsicTable;
+class ThriftConfigApplier;
+
+/*
+ * Per section fingerprints of the config last applied by applyThriftConfig().
+ *
+ * Each section records a hash of the config fields it is built from, along
+ * with the SwitchState nodes it read and produced. When passed back in on
+ * the next call, a section whose hash is unchanged and whose nodes are still
+ * the ones in the state being updated is left as is instead of being
+ * re-evaluated. Any other update to those nodes in between, including a
+ * state update that got rolled back, simply causes the section to be
+ * evaluated again.
+ *
+ * Sections that feed the route tables (interfaces, vlans) are always
+ * evaluated.
+ */
+class ConfigFingerprint {
+ public:
+  enum class Section : uint8_t {
+    PORTS,
+    AGGREGATE_PORTS,
+    MIRRORS,
+    ACLS,
+    QOS_POLICIES,
+    SFLOW_COLLECTORS,
+    LOAD_BALANCERS,
+    IP_TUNNELS,
+    DSF_NODES,
+  };
+  static constexpr size_t kNumSections =
+      static_cast<size_t>(Section::DSF_NODES) + 1;
+
+  // Forget all sections, the next apply evaluates the full config
+  void clear() {
+    sections_ = {};
+    skipped_ = {};
+  }
+
+  // Whether the section was reused as is by the last apply
+  bool wasSkipped(Section section) const {
+    return skipped_[static_cast<size_t>(section)];
+  }
+
+ private:
+  friend class ThriftConfigApplier;
+
+  struct SectionFingerprint {
+    uint64_t hash{0};
+    // Compared by identity only, holding on to them rules out address reuse
+    std::vector<std::shared_ptr<const void>> nodes;
+  };
+
+  std::array<std::optional<SectionFingerprint>, kNumSections> sections_;
+  std::array<bool, kNumSections> skipped_{};
+};
 
 /*
  * Apply a thrift config structure to a SwitchState object.
  *
  * Returns a new SwitchState object with the resulting state, or null if
  * the config file results in no changes.
+ *
+ * If fingerprint is set, sections unchanged since the config it was last
+ * updated with are skipped, and it is updated to reflect this config.
  */
 
 std::shared_ptr<SwitchState> applyThriftConfig(
@@ -41,7 +103,8 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RoutingInformationBase* rib = nullptr,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    ConfigFingerprint* fingerprint = nullptr);
 
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
@@ -50,6 +113,7 @@ std::shared_ptr<SwitchState> applyThriftConfig(
     const PlatformMapping* platformMapping,
     const HwAsicTable* hwAsicTable,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    ConfigFingerprint* fingerprint = nullptr);
 
 } // namespace facebook::fboss
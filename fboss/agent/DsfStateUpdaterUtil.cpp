@@ -33,6 +33,31 @@ std::shared_ptr<facebook::fboss::SwitchState> updateFibForRemoteConnectedRoutes(
 
 namespace facebook::fboss {
 
+void DsfRemoteChanges::merge(DsfRemoteChanges&& newer) {
+  auto mergeObjects = [](auto& changed,
+                         auto& removed,
+                         auto& newerChanged,
+                         const auto& newerRemoved) {
+    for (auto& [id, node] : newerChanged) {
+      removed.erase(id);
+      changed[id] = std::move(node);
+    }
+    for (const auto& id : newerRemoved) {
+      changed.erase(id);
+      removed.insert(id);
+    }
+  };
+  mergeObjects(
+      changedSystemPorts,
+      removedSystemPorts,
+      newer.changedSystemPorts,
+      newer.removedSystemPorts);
+  mergeObjects(
+      changedIntfs, removedIntfs, newer.changedIntfs, newer.removedIntfs);
+  fullSyncSwitchIds.insert(
+      newer.fullSyncSwitchIds.begin(), newer.fullSyncSwitchIds.end());
+}
+
 std::shared_ptr<SwitchState> DsfStateUpdaterUtil::getUpdatedState(
     const std::shared_ptr<SwitchState>& in,
     const SwitchIdScopeResolver* scopeResolver,
@@ -40,6 +65,31 @@ std::shared_ptr<SwitchState> DsfStateUpdaterUtil::getUpdatedState(
     const std::map<SwitchID, std::shared_ptr<SystemPortMap>>&
         switchId2SystemPorts,
     const std::map<SwitchID, std::shared_ptr<InterfaceMap>>& switchId2Intfs) {
+  DsfRemoteChanges changes;
+  for (const auto& [nodeSwitchId, newSysPorts] : switchId2SystemPorts) {
+    XLOG(DBG2) << "SwitchId: " << static_cast<int64_t>(nodeSwitchId)
+               << " updated # of sys ports: " << newSysPorts->size();
+
+    auto origSysPorts = in->getSystemPorts(nodeSwitchId);
+    changes.addSystemPortsDelta(
+        ThriftMapDelta<SystemPortMap>(origSysPorts.get(), newSysPorts.get()));
+  }
+
+  for (const auto& [nodeSwitchId, newRifs] : switchId2Intfs) {
+    XLOG(DBG2) << "SwitchId: " << static_cast<int64_t>(nodeSwitchId)
+               << " updated # of intfs: " << newRifs->size();
+
+    auto origRifs = in->getInterfaces(nodeSwitchId);
+    changes.addIntfsDelta(InterfaceMapDelta(origRifs.get(), newRifs.get()));
+  }
+  return getUpdatedState(in, scopeResolver, rib, changes);
+}
+
+std::shared_ptr<SwitchState> DsfStateUpdaterUtil::getUpdatedState(
+    const std::shared_ptr<SwitchState>& in,
+    const SwitchIdScopeResolver* scopeResolver,
+    RoutingInformationBase* rib,
+    const DsfRemoteChanges& changes) {
   bool changed{false};
   auto out = in->clone();
   IntfRouteTable remoteIntfRoutesToAdd;
@@ -228,87 +278,112 @@ std::shared_ptr<SwitchState> DsfStateUpdaterUtil::getUpdatedState(
     }
   };
 
-  auto processDelta = [&]<typename MapT>(
-                          auto& delta, MapT* mapToUpdate, auto& makeRemote) {
-    DeltaFunctions::forEachChanged(
-        delta,
-        [&](const auto& oldNode, const auto& newNode) {
-          if (*oldNode != *newNode) {
-            // Compare contents as we reconstructed
-            // map from deserialized FSDB
-            // subscriptions. So can't just rely on
-            // pointer comparison here.
-            auto clonedNode = makeRemote(oldNode, newNode);
-            if constexpr (std::is_same_v<MapT, MultiSwitchSystemPortMap>) {
-              mapToUpdate->updateNode(
-                  clonedNode, scopeResolver->scope(clonedNode));
-            } else {
-              processRemoteIntfRoute(oldNode, false /* add */);
-              processRemoteIntfRoute(newNode, true /* add */);
-              mapToUpdate->updateNode(
-                  clonedNode, scopeResolver->scope(clonedNode, in));
-            }
-            changed = true;
-          }
-        },
-        [&](const auto& newNode) {
-          auto clonedNode =
-              makeRemote(std::decay_t<decltype(newNode)>{nullptr}, newNode);
-          if (!clonedNode) {
-            return;
-          }
-          if constexpr (std::is_same_v<MapT, MultiSwitchSystemPortMap>) {
-            mapToUpdate->addNode(clonedNode, scopeResolver->scope(clonedNode));
-          } else {
-            processRemoteIntfRoute(clonedNode, true /* add */);
-            mapToUpdate->addNode(
-                clonedNode, scopeResolver->scope(clonedNode, in));
-          }
-          changed = true;
-        },
-        [&](const auto& rmNode) {
-          if (rmNode->getScope() == cfg::Scope::LOCAL) {
-            XLOG(DBG3) << "Skip removing LOCAL:: "
-                       << static_cast<int>(rmNode->getID()) << " "
-                       << rmNode->getName();
-
-            return;
-          }
-          if (rmNode->isStatic()) {
-            XLOG(DBG3) << "Skip removing STATIC:: "
-                       << static_cast<int>(rmNode->getID()) << " "
-                       << rmNode->getName();
-            return;
-          }
-
-          if constexpr (std::is_same_v<MapT, MultiSwitchInterfaceMap>) {
-            processRemoteIntfRoute(rmNode, false /* add */);
-          }
-          mapToUpdate->removeNode(rmNode);
-          changed = true;
-        });
-  };
-
-  for (const auto& [nodeSwitchId, newSysPorts] : switchId2SystemPorts) {
-    XLOG(DBG2) << "SwitchId: " << static_cast<int64_t>(nodeSwitchId)
-               << " updated # of sys ports: " << newSysPorts->size();
+  auto processChanges = [&]<typename MapT>(
+                            const MapT* origMap,
+                            const auto& changedNodes,
+                            const auto& removedIds,
+                            auto& makeRemote) {
+    if (changedNodes.empty() && removedIds.empty()) {
+      return;
+    }
+    MapT* mapToUpdate;
+    if constexpr (std::is_same_v<MapT, MultiSwitchSystemPortMap>) {
+      mapToUpdate = out->getRemoteSystemPorts()->modify(&out);
+    } else {
+      mapToUpdate = out->getRemoteInterfaces()->modify(&out);
+    }
+    for (const auto& [id, newNode] : changedNodes) {
+      auto oldNode = origMap->getNodeIf(id);
+      if (oldNode) {
+        auto clonedNode = makeRemote(oldNode, newNode);
+        if constexpr (std::is_same_v<MapT, MultiSwitchSystemPortMap>) {
+          mapToUpdate->updateNode(clonedNode, scopeResolver->scope(clonedNode));
+        } else {
+          processRemoteIntfRoute(oldNode, false /* add */);
+          processRemoteIntfRoute(newNode, true /* add */);
+          mapToUpdate->updateNode(
+              clonedNode, scopeResolver->scope(clonedNode, in));
+        }
+        changed = true;
+        continue;
+      }
+      auto clonedNode =
+          makeRemote(std::decay_t<decltype(newNode)>{nullptr}, newNode);
+      if (!clonedNode) {
+        continue;
+      }
+      if constexpr (std::is_same_v<MapT, MultiSwitchSystemPortMap>) {
+        mapToUpdate->addNode(clonedNode, scopeResolver->scope(clonedNode));
+      } else {
+        processRemoteIntfRoute(clonedNode, true /* add */);
+        mapToUpdate->addNode(clonedNode, scopeResolver->scope(clonedNode, in));
+      }
+      changed = true;
+    }
+    for (const auto& id : removedIds) {
+      auto rmNode = origMap->getNodeIf(id);
+      if (!rmNode) {
+        continue;
+      }
+      if (rmNode->getScope() == cfg::Scope::LOCAL) {
+        XLOG(DBG3) << "Skip removing LOCAL:: "
+                   << static_cast<int>(rmNode->getID()) << " "
+                   << rmNode->getName();
 
-    auto origSysPorts = in->getSystemPorts(nodeSwitchId);
-    ThriftMapDelta<SystemPortMap> delta(origSysPorts.get(), newSysPorts.get());
-    auto remoteSysPorts = out->getRemoteSystemPorts()->modify(&out);
-    processDelta(delta, remoteSysPorts, makeRemoteSysPort);
-  }
+        continue;
+      }
+      if (rmNode->isStatic()) {
+        XLOG(DBG3) << "Skip removing STATIC:: "
+                   << static_cast<int>(rmNode->getID()) << " "
+                   << rmNode->getName();
+        continue;
+      }
 
-  for (const auto& [nodeSwitchId, newRifs] : switchId2Intfs) {
-    XLOG(DBG2) << "SwitchId: " << static_cast<int64_t>(nodeSwitchId)
-               << " updated # of intfs: " << newRifs->size();
+      if constexpr (std::is_same_v<MapT, MultiSwitchInterfaceMap>) {
+        processRemoteIntfRoute(rmNode, false /* add */);
+      }
+      mapToUpdate->removeNode(rmNode);
+      changed = true;
+    }
+  };
 
-    auto origRifs = in->getInterfaces(nodeSwitchId);
-    InterfaceMapDelta delta(origRifs.get(), newRifs.get());
-    auto remoteRifs = out->getRemoteInterfaces()->modify(&out);
-    processDelta(delta, remoteRifs, makeRemoteRif);
+  // Full sync carries every remote object of those switches. Whatever the
+  // local state has beyond that is gone from the remote node, no matter
+  // what updates were applied or missed before.
+  auto removedSystemPorts = changes.removedSystemPorts;
+  auto removedIntfs = changes.removedIntfs;
+  for (auto switchId : changes.fullSyncSwitchIds) {
+    for (const auto& [id, _] : std::as_const(*in->getSystemPorts(switchId))) {
+      if (changes.changedSystemPorts.find(SystemPortID(id)) ==
+          changes.changedSystemPorts.end()) {
+        removedSystemPorts.insert(SystemPortID(id));
+      }
+    }
+    for (const auto& [id, _] : std::as_const(*in->getInterfaces(switchId))) {
+      if (changes.changedIntfs.find(InterfaceID(id)) ==
+          changes.changedIntfs.end()) {
+        removedIntfs.insert(InterfaceID(id));
+      }
+    }
   }
 
+  XLOG(DBG2) << "Remote sys ports changed: "
+             << changes.changedSystemPorts.size()
+             << " removed: " << removedSystemPorts.size()
+             << ", remote intfs changed: " << changes.changedIntfs.size()
+             << " removed: " << removedIntfs.size()
+             << ", full sync of switches: " << changes.fullSyncSwitchIds.size();
+  processChanges(
+      in->getRemoteSystemPorts().get(),
+      changes.changedSystemPorts,
+      removedSystemPorts,
+      makeRemoteSysPort);
+  processChanges(
+      in->getRemoteInterfaces().get(),
+      changes.changedIntfs,
+      removedIntfs,
+      makeRemoteRif);
+
   if (!remoteIntfRoutesToAdd.empty() || !remoteIntfRoutesToDel.empty()) {
     rib->updateRemoteInterfaceRoutes(
         scopeResolver,
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "fboss/agent/SwitchIdScopeResolver.h"
+#include "fboss/agent/state/DeltaFunctions.h"
 #include "fboss/agent/state/InterfaceMap.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/SystemPortMap.h"
@@ -11,8 +12,82 @@ namespace facebook::fboss {
 
 class RoutingInformationBase;
 
+/*
+ * Remote system ports and interfaces that were added, changed or removed
+ * since the last update applied from remote nodes.
+ */
+struct DsfRemoteChanges {
+  bool empty() const {
+    return changedSystemPorts.empty() && changedIntfs.empty() &&
+        removedSystemPorts.empty() && removedIntfs.empty() &&
+        fullSyncSwitchIds.empty();
+  }
+  void clear() {
+    changedSystemPorts.clear();
+    changedIntfs.clear();
+    removedSystemPorts.clear();
+    removedIntfs.clear();
+    fullSyncSwitchIds.clear();
+  }
+  // Fold in changes that came after these ones. A full sync in newer
+  // must not be for switches that already have changes here, as those
+  // are superseded rather than merged.
+  void merge(DsfRemoteChanges&& newer);
+
+  // Add the difference between two versions of remote objects. Nodes that
+  // are the same object in both versions are skipped without comparing them,
+  // so this is cheap for versions patched from one another.
+  template <typename DeltaT>
+  void addSystemPortsDelta(const DeltaT& delta) {
+    addDelta(delta, changedSystemPorts, removedSystemPorts);
+  }
+  template <typename DeltaT>
+  void addIntfsDelta(const DeltaT& delta) {
+    addDelta(delta, changedIntfs, removedIntfs);
+  }
+
+  // Added or changed objects
+  std::map<SystemPortID, std::shared_ptr<SystemPort>> changedSystemPorts;
+  std::map<InterfaceID, std::shared_ptr<Interface>> changedIntfs;
+  std::set<SystemPortID> removedSystemPorts;
+  std::set<InterfaceID> removedIntfs;
+  // Switches whose remote objects were all sent again, e.g. on initial
+  // sync after a (re)connect. Remote objects of these switches in the
+  // local state that are not among the changed objects get removed.
+  std::set<SwitchID> fullSyncSwitchIds;
+
+ private:
+  template <typename DeltaT, typename IdT, typename NodeT>
+  static void addDelta(
+      const DeltaT& delta,
+      std::map<IdT, std::shared_ptr<NodeT>>& changed,
+      std::set<IdT>& removed) {
+    DeltaFunctions::forEachChanged(
+        delta,
+        [&](const auto& oldNode, const auto& newNode) {
+          // Compare contents as maps deserialized from FSDB
+          // are new objects even when nothing changed.
+          if (*oldNode != *newNode) {
+            removed.erase(newNode->getID());
+            changed[newNode->getID()] = newNode;
+          }
+        },
+        [&](const auto& newNode) {
+          removed.erase(newNode->getID());
+          changed[newNode->getID()] = newNode;
+        },
+        [&](const auto& oldNode) {
+          // Node may have moved to another switch's map
+          if (changed.find(oldNode->getID()) == changed.end()) {
+            removed.insert(oldNode->getID());
+          }
+        });
+  }
+};
+
 class DsfStateUpdaterUtil {
  public:
+  // Replace remote objects of each switch with the ones passed in
   static std::shared_ptr<SwitchState> getUpdatedState(
       const std::shared_ptr<SwitchState>& in,
       const SwitchIdScopeResolver* scopeResolver,
@@ -20,6 +95,13 @@ class DsfStateUpdaterUtil {
       const std::map<SwitchID, std::shared_ptr<SystemPortMap>>&
           switchId2SystemPorts,
       const std::map<SwitchID, std::shared_ptr<InterfaceMap>>& switchId2Intfs);
+
+  // Apply only the remote objects that changed, leaving the rest as is
+  static std::shared_ptr<SwitchState> getUpdatedState(
+      const std::shared_ptr<SwitchState>& in,
+      const SwitchIdScopeResolver* scopeResolver,
+      RoutingInformationBase* rib,
+      const DsfRemoteChanges& changes);
 };
 
 } // namespace facebook::fboss
@@ -60,7 +60,10 @@ DsfSubscriber::DsfSubscriber(SwSwitch* sw)
               "DsfSubscriberStreamServe"))),
       hwUpdatePool_(std::make_unique<folly::IOThreadPoolExecutor>(
           1,
-          std::make_shared<folly::NamedThreadFactory>("DsfHwUpdate"))) {
+          std::make_shared<folly::NamedThreadFactory>("DsfHwUpdate"))),
+      updateBatcher_(std::make_unique<DsfUpdateBatcher>(
+          hwUpdatePool_->getEventBase(),
+          sw)) {
   // TODO(aeckert): add dedicated config field for localNodeName
   sw_->registerStateObserver(this, "DsfSubscriber");
   // Since we want to schedule destruction of DSFSubscription
@@ -148,7 +151,7 @@ void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
               std::move(opts),
               streamConnectPool_->getEventBase(),
               streamServePool_->getEventBase(),
-              hwUpdatePool_->getEventBase(),
+              updateBatcher_.get(),
               localNodeName_,
               nodeName,
               getAllSwitchIDsForSwitch(
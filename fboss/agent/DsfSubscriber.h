@@ -3,6 +3,7 @@
 #pragma once
 
 #include "fboss/agent/DsfSubscription.h"
+#include "fboss/agent/DsfUpdateBatcher.h"
 #include "fboss/agent/StateObserver.h"
 #include "fboss/fsdb/client/FsdbPubSubManager.h"
 
@@ -63,6 +64,8 @@ class DsfSubscriber : public StateObserver {
   std::unique_ptr<folly::IOThreadPoolExecutor> streamConnectPool_;
   std::unique_ptr<folly::IOThreadPoolExecutor> streamServePool_;
   std::unique_ptr<folly::IOThreadPoolExecutor> hwUpdatePool_;
+  // Applies updates from all subscriptions on hwUpdatePool_
+  std::unique_ptr<DsfUpdateBatcher> updateBatcher_;
   bool stopped_{false};
 };
 
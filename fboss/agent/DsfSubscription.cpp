@@ -3,8 +3,10 @@
 #include "fboss/agent/DsfSubscription.h"
 #include "fboss/agent/AgentFeatures.h"
 #include "fboss/agent/DsfStateUpdaterUtil.h"
+#include "fboss/agent/DsfUpdateBatcher.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/fsdb/if/FsdbModel.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_common_types.h"
@@ -64,7 +66,7 @@ DsfSubscription::DsfSubscription(
     fsdb::SubscriptionOptions options,
     folly::EventBase* reconnectEvb,
     folly::EventBase* subscriberEvb,
-    folly::EventBase* hwUpdateEvb,
+    DsfUpdateBatcher* updateBatcher,
     std::string localNodeName,
     std::string remoteNodeName,
     std::set<SwitchID> remoteNodeSwitchIds,
@@ -72,7 +74,7 @@ DsfSubscription::DsfSubscription(
     folly::IPAddress remoteIp,
     SwSwitch* sw)
     : opts_(std::move(options)),
-      hwUpdateEvb_(hwUpdateEvb),
+      updateBatcher_(updateBatcher),
       fsdbPubSubMgr_(new fsdb::FsdbPubSubManager(
           opts_.clientId_,
           reconnectEvb,
@@ -112,13 +114,18 @@ void DsfSubscription::stop() {
     sw_->stats()->failedDsfSubscription(remoteNodeName_, -1);
   }
   tearDownSubscription();
-  // Nullify any pending update lambdas already scheduled on
-  // hwUpdateEvb_
-  auto nextDsfUpdateWlock = nextDsfUpdate_.wlock();
-  nextDsfUpdateWlock->reset();
+  // Drop any pending update, so updateBatcher_ does not
+  // apply it after we are stopped
+  updateBatcher_->cancelUpdate(this);
+  nextDsfUpdate_.wlock()->clear();
   stopped_ = true;
 }
 void DsfSubscription::setupSubscription() {
+  // Subscription starts with a full sync of remote state,
+  // apply all of it
+  *lastRemoteObjects_.wlock() = RemoteObjects{};
+  curMswitchSysPorts_ = std::make_shared<MultiSwitchSystemPortMap>();
+  curMswitchIntfs_ = std::make_shared<MultiSwitchInterfaceMap>();
   auto subscriptionStateCb = [this](
                                  fsdb::SubscriptionState oldState,
                                  fsdb::SubscriptionState newState) {
@@ -151,8 +158,10 @@ void DsfSubscription::setupSubscription() {
           if (portsOrIntfsChanged) {
             auto switchState =
                 agentState->template safe_cref<k_fsdb_model::switchState>();
+            // Remote state is patched in place, so objects that did
+            // not change are shared with the previous update
             queueRemoteStateChanged(
-                *switchState->getSystemPorts(), *switchState->getInterfaces());
+                switchState->getSystemPorts(), switchState->getInterfaces());
           }
         },
         std::move(subscriptionStateCb));
@@ -238,6 +247,12 @@ void DsfSubscription::handleFsdbSubscriptionStateUpdate(
     session_.localSubStateChanged(newThriftState);
   }
 
+  if (newState == fsdb::SubscriptionState::CONNECTED) {
+    // (Re)connecting starts with a full sync of remote state. Called in
+    // the stream thread right before that sync is served.
+    *lastRemoteObjects_.wlock() = RemoteObjects{};
+  }
+
   if (fsdb::isGRHoldExpired(newState)) {
     processGRHoldTimerExpired();
   }
@@ -248,17 +263,24 @@ void DsfSubscription::handleFsdbUpdate(fsdb::OperSubPathUnit&& operStateUnit) {
   for (const auto& change : *operStateUnit.changes()) {
     if (getSystemPortsPath().matchesPath(*change.path()->path())) {
       XLOG(DBG2) << "Got sys port update from : " << remoteNodeName_;
-      curMswitchSysPorts_.fromThrift(thrift_cow::deserialize<
-                                     MultiSwitchSystemPortMapTypeClass,
-                                     MultiSwitchSystemPortMapThriftType>(
+      auto sysPorts = std::make_shared<MultiSwitchSystemPortMap>();
+      sysPorts->fromThrift(thrift_cow::deserialize<
+                           MultiSwitchSystemPortMapTypeClass,
+                           MultiSwitchSystemPortMapThriftType>(
           fsdb::OperProtocol::BINARY, *change.state()->contents()));
+      // Published, so applying the update does not modify our copy
+      sysPorts->publish();
+      curMswitchSysPorts_ = std::move(sysPorts);
       portsOrIntfsChanged = true;
     } else if (getInterfacesPath().matchesPath(*change.path()->path())) {
       XLOG(DBG2) << "Got rif update from : " << remoteNodeName_;
-      curMswitchIntfs_.fromThrift(thrift_cow::deserialize<
-                                  MultiSwitchInterfaceMapTypeClass,
-                                  MultiSwitchInterfaceMapThriftType>(
+      auto intfs = std::make_shared<MultiSwitchInterfaceMap>();
+      intfs->fromThrift(thrift_cow::deserialize<
+                        MultiSwitchInterfaceMapTypeClass,
+                        MultiSwitchInterfaceMapThriftType>(
           fsdb::OperProtocol::BINARY, *change.state()->contents()));
+      intfs->publish();
+      curMswitchIntfs_ = std::move(intfs);
       portsOrIntfsChanged = true;
     } else if (getDsfSubscriptionsPath(
                    makeRemoteEndpoint(localNodeName_, localIp_))
@@ -287,37 +309,71 @@ void DsfSubscription::handleFsdbUpdate(fsdb::OperSubPathUnit&& operStateUnit) {
 }
 
 void DsfSubscription::queueRemoteStateChanged(
-    const MultiSwitchSystemPortMap& newPortMap,
-    const MultiSwitchInterfaceMap& newInterfaceMap) {
-  DsfUpdate dsfUpdate;
-  for (const auto& [id, sysPortMap] : newPortMap) {
-    auto matcher = HwSwitchMatcher(id);
-    dsfUpdate.switchId2SystemPorts[matcher.switchId()] = sysPortMap;
+    const std::shared_ptr<MultiSwitchSystemPortMap>& newPortMap,
+    const std::shared_ptr<MultiSwitchInterfaceMap>& newInterfaceMap) {
+  auto hasNoLocalSwitchId = [this](const auto& mSwitchObjects) {
+    for (const auto& [id, _] : std::as_const(*mSwitchObjects)) {
+      auto switchId = HwSwitchMatcher(id).switchId();
+      if (this->isLocal(switchId)) {
+        throw FbossError(
+            "Got updates for a local switch ID, from: ",
+            localNodeName_,
+            " id: ",
+            switchId);
+      }
+    }
+  };
+
+  hasNoLocalSwitchId(newPortMap);
+  hasNoLocalSwitchId(newInterfaceMap);
+
+  DsfRemoteChanges dsfUpdate;
+  {
+    auto lastRemoteObjects = lastRemoteObjects_.wlock();
+    if (!lastRemoteObjects->sysPorts) {
+      // Removals are then worked out against local state when applying
+      dsfUpdate.fullSyncSwitchIds = remoteNodeSwitchIds_;
+    }
+    auto lastSysPorts = lastRemoteObjects->sysPorts
+        ? lastRemoteObjects->sysPorts
+        : std::make_shared<MultiSwitchSystemPortMap>();
+    auto lastIntfs = lastRemoteObjects->intfs
+        ? lastRemoteObjects->intfs
+        : std::make_shared<MultiSwitchInterfaceMap>();
+    // Only walks the objects that are not shared between the two versions
+    dsfUpdate.addSystemPortsDelta(MultiSwitchMapDelta<MultiSwitchSystemPortMap>(
+        lastSysPorts.get(), newPortMap.get()));
+    dsfUpdate.addIntfsDelta(
+        MultiSwitchInterfaceMapDelta(lastIntfs.get(), newInterfaceMap.get()));
+    lastRemoteObjects->sysPorts = newPortMap;
+    lastRemoteObjects->intfs = newInterfaceMap;
   }
-  for (const auto& [id, intfMap] : newInterfaceMap) {
-    auto matcher = HwSwitchMatcher(id);
-    dsfUpdate.switchId2Intfs[matcher.switchId()] = intfMap;
+  XLOG(DBG2) << "Remote sys ports changed: "
+             << dsfUpdate.changedSystemPorts.size()
+             << " removed: " << dsfUpdate.removedSystemPorts.size()
+             << ", remote intfs changed: " << dsfUpdate.changedIntfs.size()
+             << " removed: " << dsfUpdate.removedIntfs.size()
+             << " from: " << remoteNodeName_;
+  if (!dsfUpdate.empty()) {
+    queueDsfUpdate(std::move(dsfUpdate));
   }
-  queueDsfUpdate(std::move(dsfUpdate));
 }
 
-void DsfSubscription::queueDsfUpdate(DsfUpdate&& dsfUpdate) {
-  bool needsScheduling = false;
-
+void DsfSubscription::queueDsfUpdate(DsfRemoteChanges&& dsfUpdate) {
+  // Changes that were not applied yet are still needed, fold the
+  // new ones on top of them, unless the new ones are a full sync
+  // which supersedes them. updateBatcher_ picks up whatever is
+  // queued when it runs next.
   {
-    auto nextDsfUpdateWlock = nextDsfUpdate_.wlock();
-    // If nextDsfUpdate is not null, then just overwrite
-    // nextDsfUpdate with latest info but don't schedule
-    // another lambda on the hwUpdateThread. The idea here
-    // is that since nextDsfUpdate_ was not empty it implies
-    // we have already scheduled a update on the hwUpdateEvb
-    // and that update will now simply consume the latest
-    // contents.
-    needsScheduling = (*nextDsfUpdateWlock == nullptr);
-    *nextDsfUpdateWlock = std::make_unique<DsfUpdate>(std::move(dsfUpdate));
+    auto nextDsfUpdate = nextDsfUpdate_.wlock();
+    if (dsfUpdate.fullSyncSwitchIds.empty()) {
+      nextDsfUpdate->merge(std::move(dsfUpdate));
+    } else {
+      *nextDsfUpdate = std::move(dsfUpdate);
+    }
   }
   /*
-   * Schedule updates async on hwUpdateEvb, so we don't
+   * Updates are applied async on hwUpdateEvb, so we don't
    * keep the streamEventEvb blocked waiting on HW updates.
    * Doing everything on streamEvb slows down convergence
    * when multiple session have simultaneous updates.
@@ -325,25 +381,13 @@ void DsfSubscription::queueDsfUpdate(DsfUpdate&& dsfUpdate) {
    * hundred sessions come up close together and wait on
    * each other for initial sync to complete.
    */
-  if (needsScheduling) {
-    hwUpdateEvb_->runInEventBaseThread([this]() {
-      DsfUpdate update;
-      {
-        auto nextDsfUpdateWlock = nextDsfUpdate_.wlock();
-        if (*nextDsfUpdateWlock == nullptr) {
-          // Update was already done or cancelled
-          return;
-        }
-        update = std::move(**nextDsfUpdateWlock);
-        nextDsfUpdateWlock->reset();
+  updateBatcher_->scheduleUpdate(this);
+}
 
-        // At this point nextDsfUpdate should be null
-        CHECK_EQ(*nextDsfUpdateWlock, nullptr);
-      }
-      updateWithRollbackProtection(
-          update.switchId2SystemPorts, update.switchId2Intfs);
-    });
-  }
+DsfRemoteChanges DsfSubscription::takeDsfUpdate() {
+  DsfRemoteChanges dsfUpdate;
+  std::swap(dsfUpdate, *nextDsfUpdate_.wlock());
+  return dsfUpdate;
 }
 
 bool DsfSubscription::isLocal(SwitchID nodeSwitchId) const {
@@ -402,21 +446,30 @@ void DsfSubscription::updateDsfState(
       XLOG(DBG2) << kDsfCtrlLogPrefix
                  << " update failed for : " << remoteEndpointStr();
       sw_->stats()->dsfUpdateFailed();
-      // Tear down subscription so no more updates come for this
-      // subscription
-      tearDownSubscription();
-      // Clear any queued updates
-      auto nextDsfUpdateWlock = nextDsfUpdate_.wlock();
-      nextDsfUpdateWlock->reset();
-      // Setup subscription again to trigger a full resync
-      setupSubscription();
+      resync();
     }
   });
 }
 
+void DsfSubscription::resync() {
+  if (stopped_) {
+    return;
+  }
+  // Tear down subscription so no more updates come for this
+  // subscription
+  tearDownSubscription();
+  // Clear any queued updates
+  nextDsfUpdate_.wlock()->clear();
+  // Setup subscription again to trigger a full resync
+  setupSubscription();
+}
+
 void DsfSubscription::processGRHoldTimerExpired() {
   sw_->stats()->dsfSessionGrExpired();
   XLOG(DBG2) << kDsfCtrlLogPrefix << "GR expired for : " << remoteEndpointStr();
+  // Remote objects are marked STALE or removed below, make sure
+  // the next update from remote applies all of them again
+  *lastRemoteObjects_.wlock() = RemoteObjects{};
   auto updateDsfStateFn = [this](const std::shared_ptr<SwitchState>& in) {
     bool changed{false};
     auto out = in->clone();
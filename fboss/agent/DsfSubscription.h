@@ -4,15 +4,18 @@
 
 #include <fboss/thrift_cow/storage/CowStorage.h>
 #include "fboss/agent/DsfSession.h"
+#include "fboss/agent/DsfStateUpdaterUtil.h"
 #include "fboss/agent/FsdbAdaptedSubManager.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/fsdb/client/FsdbPubSubManager.h"
 #include "fboss/fsdb/client/FsdbSubManager.h"
 #include "fboss/fsdb/if/FsdbModel.h"
 
+#include <atomic>
 #include <string>
 
 namespace facebook::fboss {
+class DsfUpdateBatcher;
 class SwitchStats;
 class InterfaceMap;
 class SystemPortMap;
@@ -25,7 +28,7 @@ class DsfSubscription {
       fsdb::SubscriptionOptions options,
       folly::EventBase* reconnectEvb,
       folly::EventBase* subscriberEvb,
-      folly::EventBase* hwUpdateEvb,
+      DsfUpdateBatcher* updateBatcher,
       std::string localNodeName,
       std::string remoteNodeName,
       std::set<SwitchID> remoteNodeSwitchIds,
@@ -51,16 +54,11 @@ class DsfSubscription {
   }
 
  private:
-  struct DsfUpdate {
-    bool isEmpty() const {
-      return switchId2SystemPorts.empty() && switchId2Intfs.empty();
-    }
-    void clear() {
-      switchId2SystemPorts.clear();
-      switchId2Intfs.clear();
-    }
-    std::map<SwitchID, std::shared_ptr<SystemPortMap>> switchId2SystemPorts;
-    std::map<SwitchID, std::shared_ptr<InterfaceMap>> switchId2Intfs;
+  friend class DsfUpdateBatcher;
+  // Remote objects the last queued update was computed against
+  struct RemoteObjects {
+    std::shared_ptr<MultiSwitchSystemPortMap> sysPorts;
+    std::shared_ptr<MultiSwitchInterfaceMap> intfs;
   };
   void updateDsfState(
       const std::function<std::shared_ptr<SwitchState>(
@@ -73,6 +71,8 @@ class DsfSubscription {
   void processGRHoldTimerExpired();
   void setupSubscription();
   void tearDownSubscription();
+  // Tear down and setup subscription again to get a full resync
+  void resync();
 
   bool isLocal(SwitchID nodeSwitchId) const;
   void handleFsdbSubscriptionStateUpdate(
@@ -80,14 +80,15 @@ class DsfSubscription {
       fsdb::SubscriptionState newState);
   void handleFsdbUpdate(fsdb::OperSubPathUnit&& operStateUnit);
   void queueRemoteStateChanged(
-      const MultiSwitchSystemPortMap& newPortMap,
-      const MultiSwitchInterfaceMap& newInterfaceMap);
-  void queueDsfUpdate(DsfUpdate&& dsfUpdate);
+      const std::shared_ptr<MultiSwitchSystemPortMap>& newPortMap,
+      const std::shared_ptr<MultiSwitchInterfaceMap>& newInterfaceMap);
+  void queueDsfUpdate(DsfRemoteChanges&& dsfUpdate);
+  DsfRemoteChanges takeDsfUpdate();
 
   fsdb::FsdbStreamClient::State getStreamState() const;
 
   fsdb::SubscriptionOptions opts_;
-  folly::EventBase* hwUpdateEvb_;
+  DsfUpdateBatcher* updateBatcher_;
   std::unique_ptr<fsdb::FsdbPubSubManager> fsdbPubSubMgr_;
   std::unique_ptr<FsdbAdaptedSubManager> subMgr_;
   std::string localNodeName_;
@@ -97,7 +98,12 @@ class DsfSubscription {
   folly::IPAddress remoteIp_;
   SwSwitch* sw_;
   DsfSession session_;
-  folly::Synchronized<std::unique_ptr<DsfUpdate>> nextDsfUpdate_;
+  // Changes not yet applied by updateBatcher_
+  folly::Synchronized<DsfRemoteChanges> nextDsfUpdate_;
+  // Only changes against these get queued. Reset whenever a full
+  // sync is expected, or local state may have diverged from them,
+  // so that the next update is applied as a full sync.
+  folly::Synchronized<RemoteObjects> lastRemoteObjects_;
   // Cache current state of sysports and intfs received from remote
   // node. Since after the initial update we are not guaranteed to
   // receive the entire set of sysports and rifs in any update. For
@@ -106,10 +112,12 @@ class DsfSubscription {
   // apply RIFs and sys ports together. To that end we need to
   // cache the current sysports and rifs and then patch the
   // receieved update on top of it.
+  // Only used with path subscriptions, patch subscriptions
+  // keep the whole remote state.
   // TODO: kill this code after we cutover to patch subscriptions.
-  MultiSwitchSystemPortMap curMswitchSysPorts_;
-  MultiSwitchInterfaceMap curMswitchIntfs_;
-  bool stopped_{false};
+  std::shared_ptr<MultiSwitchSystemPortMap> curMswitchSysPorts_;
+  std::shared_ptr<MultiSwitchInterfaceMap> curMswitchIntfs_;
+  std::atomic<bool> stopped_{false};
   // Used for tests only
   std::shared_ptr<SwitchState> cachedState_;
   template <typename T>
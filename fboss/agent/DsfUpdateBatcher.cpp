@@ -0,0 +1,111 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/agent/DsfUpdateBatcher.h"
+#include "fboss/agent/AgentFeatures.h"
+#include "fboss/agent/DsfStateUpdaterUtil.h"
+#include "fboss/agent/DsfSubscription.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/util/Logging.h"
+
+namespace facebook::fboss {
+
+DsfUpdateBatcher::DsfUpdateBatcher(folly::EventBase* hwUpdateEvb, SwSwitch* sw)
+    : hwUpdateEvb_(hwUpdateEvb),
+      sw_(sw),
+      batchTimeout_(folly::AsyncTimeout::make(
+          *hwUpdateEvb,
+          [this]() noexcept { applyUpdates(); })) {}
+
+DsfUpdateBatcher::~DsfUpdateBatcher() {
+  // Timeout must be cancelled on the evb it is scheduled on
+  hwUpdateEvb_->runImmediatelyOrRunInEventBaseThreadAndWait(
+      [this]() { batchTimeout_.reset(); });
+}
+
+void DsfUpdateBatcher::scheduleUpdate(DsfSubscription* subscription) {
+  {
+    auto pendingUpdates = pendingUpdates_.wlock();
+    pendingUpdates->subscriptions.insert(subscription);
+    // Already scheduled update will pick this subscription up
+    if (pendingUpdates->scheduled) {
+      return;
+    }
+    pendingUpdates->scheduled = true;
+  }
+  hwUpdateEvb_->runInEventBaseThread([this]() {
+    if (FLAGS_dsf_update_batch_interval_ms == 0) {
+      applyUpdates();
+    } else {
+      batchTimeout_->scheduleTimeout(FLAGS_dsf_update_batch_interval_ms);
+    }
+  });
+}
+
+void DsfUpdateBatcher::cancelUpdate(DsfSubscription* subscription) {
+  pendingUpdates_.wlock()->subscriptions.erase(subscription);
+}
+
+void DsfUpdateBatcher::applyUpdates() {
+  std::set<DsfSubscription*> subscriptions;
+  {
+    auto pendingUpdates = pendingUpdates_.wlock();
+    subscriptions.swap(pendingUpdates->subscriptions);
+    pendingUpdates->scheduled = false;
+  }
+  auto changes = std::make_shared<DsfRemoteChanges>();
+  std::vector<DsfSubscription*> updated;
+  for (auto subscription : subscriptions) {
+    auto update = subscription->takeDsfUpdate();
+    if (update.empty()) {
+      // Update was cancelled
+      continue;
+    }
+    changes->merge(std::move(update));
+    updated.push_back(subscription);
+  }
+  if (updated.empty()) {
+    return;
+  }
+
+  auto updateDsfStateFn = [this, changes, updated](
+                              const std::shared_ptr<SwitchState>& in) {
+    auto out = DsfStateUpdaterUtil::getUpdatedState(
+        in, sw_->getScopeResolver(), sw_->getRib(), *changes);
+
+    if (FLAGS_dsf_subscriber_cache_updated_state) {
+      for (auto subscription : updated) {
+        subscription->cachedState_ = out;
+      }
+    }
+    if (!FLAGS_dsf_subscriber_skip_hw_writes) {
+      return out;
+    }
+
+    return std::shared_ptr<SwitchState>{};
+  };
+  bool failed{false};
+  sw_->getRib()->updateStateInRibThread([&]() {
+    try {
+      sw_->updateStateWithHwFailureProtection(
+          folly::sformat(
+              "Update state for {} remote DSF sessions", updated.size()),
+          updateDsfStateFn);
+    } catch (const std::exception& e) {
+      XLOG(DBG2) << kDsfCtrlLogPrefix << " update failed for "
+                 << updated.size() << " remote DSF sessions: " << e.what();
+      sw_->stats()->dsfUpdateFailed();
+      failed = true;
+    }
+  });
+  if (failed) {
+    // We can't tell which of the changes failed, so resync every
+    // subscription that contributed to this update
+    for (auto subscription : updated) {
+      subscription->resync();
+    }
+  }
+}
+
+} // namespace facebook::fboss
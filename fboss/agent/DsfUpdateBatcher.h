@@ -0,0 +1,50 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/EventBase.h>
+
+#include <memory>
+#include <set>
+
+namespace facebook::fboss {
+class DsfSubscription;
+class SwSwitch;
+
+/*
+ * Applies remote state changes queued by DsfSubscriptions to the switch
+ * state. Changes queued by all subscriptions within
+ * FLAGS_dsf_update_batch_interval_ms are applied in a single state update,
+ * so that a burst of updates from many remote nodes (e.g. on bootup, or on
+ * neighbor churn across the cluster) does not turn into a state update per
+ * remote node.
+ *
+ * Updates are applied on hwUpdateEvb, which is also where DsfSubscriptions
+ * get destroyed, so a subscription stays valid while its update is applied.
+ */
+class DsfUpdateBatcher {
+ public:
+  DsfUpdateBatcher(folly::EventBase* hwUpdateEvb, SwSwitch* sw);
+  ~DsfUpdateBatcher();
+
+  // Subscription has queued changes, apply them with the next batch
+  void scheduleUpdate(DsfSubscription* subscription);
+  // Subscription is being stopped, forget about it
+  void cancelUpdate(DsfSubscription* subscription);
+
+ private:
+  struct PendingUpdates {
+    std::set<DsfSubscription*> subscriptions;
+    bool scheduled{false};
+  };
+  void applyUpdates();
+
+  folly::EventBase* hwUpdateEvb_;
+  SwSwitch* sw_;
+  std::unique_ptr<folly::AsyncTimeout> batchTimeout_;
+  folly::Synchronized<PendingUpdates> pendingUpdates_;
+};
+
+} // namespace facebook::fboss
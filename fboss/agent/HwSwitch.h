@@ -28,6 +28,8 @@
 #include <folly/ThreadLocal.h>
 #include <optional>
 
+#include <chrono>
+#include <map>
 #include <memory>
 #include <utility>
 
@@ -234,6 +236,23 @@ class HwSwitch {
    */
   void updateStats();
 
+  /*
+   * How long the last updateStats() call held the locks that block state
+   * updates. Implementations that don't track this report 0.
+   */
+  virtual std::chrono::microseconds getLastStatsCollectionLockHoldTime() const {
+    return std::chrono::microseconds(0);
+  }
+
+  /*
+   * How long reloading each type of hardware object took during init, keyed
+   * by object type. Implementations that don't track this report nothing.
+   */
+  virtual std::map<std::string, std::chrono::microseconds>
+  getObjectReloadTimes() const {
+    return {};
+  }
+
   multiswitch::HwSwitchStats getHwSwitchStats();
 
   virtual folly::F14FastMap<std::string, HwPortStats> getPortStats() const = 0;
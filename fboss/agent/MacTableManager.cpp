@@ -12,22 +12,109 @@
 #include "fboss/agent/L2Entry.h"
 #include "fboss/agent/MacTableUtils.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <gflags/gflags.h>
+
+#include <algorithm>
+
+DEFINE_int32(
+    l2_learn_batch_window_ms,
+    0,
+    "How long L2 learn/age callbacks are gathered before being applied as "
+    "one state update. 0 applies them on the next background thread loop.");
+
+DEFINE_int32(
+    l2_learn_batch_max_events,
+    1024,
+    "Number of L2 learn/age callbacks after which a batch is applied "
+    "without waiting for the batch window");
+
 namespace facebook::fboss {
 
-MacTableManager::MacTableManager(SwSwitch* sw) : sw_(sw) {}
+MacTableManager::MacTableManager(SwSwitch* sw)
+    : sw_(sw), pending_(std::make_shared<SynchronizedBatch>()) {}
 
 void MacTableManager::handleL2LearningUpdate(
     L2Entry l2Entry,
     L2EntryUpdateType l2EntryUpdateType) {
-  auto updateMacTableFn =
-      [l2Entry, l2EntryUpdateType](const std::shared_ptr<SwitchState>& state) {
-        return MacTableUtils::updateMacTable(state, l2Entry, l2EntryUpdateType);
-      };
+  sw_->stats()->l2LearnEventReceived();
+  bool scheduleNeeded{false};
+  {
+    auto batch = pending_->lock();
+    auto& updates = batch->vlanUpdates[l2Entry.getVlanID()][l2Entry.getMac()];
+    if (!updates.empty() && updates.back().type == l2EntryUpdateType) {
+      // Superseded by the newer callback, e.g. a MAC move between learns
+      sw_->stats()->l2LearnEventFolded();
+      updates.back().entry = std::move(l2Entry);
+      return;
+    }
+    if (!updates.empty() &&
+        l2EntryUpdateType == L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD) {
+      // Age followed by learn: apply the age in its own update first
+      flushLocked(sw_, *batch);
+      batch->vlanUpdates[l2Entry.getVlanID()][l2Entry.getMac()].push_back(
+          {std::move(l2Entry), l2EntryUpdateType});
+    } else {
+      updates.push_back({std::move(l2Entry), l2EntryUpdateType});
+    }
+    ++batch->numEvents;
+    if (batch->numEvents >=
+        static_cast<size_t>(std::max(FLAGS_l2_learn_batch_max_events, 1))) {
+      flushLocked(sw_, *batch);
+    } else {
+      scheduleNeeded = batch->numEvents == 1;
+    }
+  }
+  if (scheduleNeeded) {
+    scheduleFlush();
+  }
+}
+
+void MacTableManager::scheduleFlush() {
+  auto flushFn = [sw = sw_, pending = std::weak_ptr(pending_)]() {
+    if (auto batch = pending.lock()) {
+      flushLocked(sw, *batch->lock());
+    }
+  };
+  auto* evb = sw_->getBackgroundEvb();
+  if (FLAGS_l2_learn_batch_window_ms <= 0) {
+    evb->runInFbossEventBaseThread(std::move(flushFn));
+    return;
+  }
+  evb->runInFbossEventBaseThread(
+      [evb, flushFn = std::move(flushFn)]() mutable {
+        evb->runAfterDelay(std::move(flushFn), FLAGS_l2_learn_batch_window_ms);
+      });
+}
+
+// Called with the batch locked, so batches are queued in arrival order
+void MacTableManager::flushLocked(SwSwitch* sw, Batch& batch) {
+  if (batch.numEvents == 0) {
+    return;
+  }
+  auto updates = std::make_shared<Batch>(std::move(batch));
+  batch = Batch();
+  sw->stats()->l2LearnBatchApplied();
+
+  auto updateMacTableFn = [updates](
+                              const std::shared_ptr<SwitchState>& state) {
+    auto newState = state;
+    for (const auto& [vlanID, macUpdates] : updates->vlanUpdates) {
+      for (const auto& [mac, macUpdate] : macUpdates) {
+        for (const auto& update : macUpdate) {
+          newState = MacTableUtils::updateMacTable(
+              newState, update.entry, update.type);
+        }
+      }
+    }
+    return newState;
+  };
 
-  sw_->updateStateNoCoalescing(
-      folly::to<std::string>("Programming : ", l2Entry.str()),
+  sw->updateStateNoCoalescing(
+      folly::to<std::string>(
+          "Programming ", updates->numEvents, " L2 learn/age updates"),
       std::move(updateMacTableFn));
 }
 
@@ -11,10 +11,30 @@
 
 #include "fboss/agent/L2Entry.h"
 
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <folly/small_vector.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
 namespace facebook::fboss {
 
 class SwSwitch;
 
+/*
+ * Applies L2 learn and age callbacks to the MAC tables in SwitchState.
+ *
+ * Callbacks are not applied one state update at a time. They are gathered
+ * per VLAN and MAC into a batch, which is applied as a single state update
+ * on the background thread, after --l2_learn_batch_window_ms or once it
+ * holds --l2_learn_batch_max_events callbacks. A callback that repeats the
+ * previous one for the same MAC (learn after learn, age after age)
+ * replaces it. An age followed by a learn of the same MAC is never folded
+ * into one update: the learn must reprogram the entry to take it out of
+ * pending state, so the batch holding the age is applied first.
+ */
 class MacTableManager {
  public:
   explicit MacTableManager(SwSwitch* sw);
@@ -24,11 +44,31 @@ class MacTableManager {
       L2EntryUpdateType l2EntryUpdateType);
 
  private:
+  struct L2Update {
+    L2Entry entry;
+    L2EntryUpdateType type;
+  };
+  // At most a learn followed by an age per MAC, see above
+  using MacUpdates = folly::small_vector<L2Update, 2>;
+
+  struct Batch {
+    std::map<VlanID, folly::F14FastMap<folly::MacAddress, MacUpdates>>
+        vlanUpdates;
+    size_t numEvents{0};
+  };
+  using SynchronizedBatch = folly::Synchronized<Batch, std::mutex>;
+
+  static void flushLocked(SwSwitch* sw, Batch& batch);
+  void scheduleFlush();
+
   // Forbidden copy constructor and assignment operator
   MacTableManager(MacTableManager const&) = delete;
   MacTableManager& operator=(MacTableManager const&) = delete;
 
   SwSwitch* sw_{nullptr};
+  // Shared with flushes scheduled on the background thread, which may run
+  // after this manager is destroyed
+  std::shared_ptr<SynchronizedBatch> pending_;
 };
 
 } // namespace facebook::fboss
@@ -90,6 +90,14 @@ class RxPacket : public Packet {
     return -1;
   }
 
+  /*
+   * Replace the packet data, e.g. to copy the packet out of a buffer owned
+   * by the SDK before handling it outside of the RX callback.
+   */
+  void setBuf(std::unique_ptr<folly::IOBuf> buf) {
+    buf_ = std::move(buf);
+  }
+
   /*
    * Struct to hold reason information
    */
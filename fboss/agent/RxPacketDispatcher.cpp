@@ -0,0 +1,252 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketDispatcher.h"
+
+#include "fboss/agent/RxPacket.h"
+#include "fboss/agent/Utils.h"
+
+#include <folly/Conv.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+DEFINE_bool(
+    rx_dispatch,
+    false,
+    "Handle trapped packets on per protocol worker threads instead of "
+    "the thread delivering them");
+
+DEFINE_int32(
+    rx_dispatch_queue_size,
+    4096,
+    "Number of packets each per protocol RX dispatch queue can hold");
+
+namespace {
+constexpr uint16_t kEthertypeVlan = 0x8100;
+constexpr uint16_t kEthertypeIPv4 = 0x0800;
+constexpr uint16_t kEthertypeArp = 0x0806;
+constexpr uint16_t kEthertypeIPv6 = 0x86DD;
+constexpr uint16_t kEthertypeSlowProtocols = 0x8809;
+constexpr uint16_t kEthertypeLldp = 0x88CC;
+constexpr uint16_t kEthertypeEapol = 0x888E;
+
+constexpr uint8_t kIpProtoUdp = 17;
+constexpr uint8_t kIpProtoIcmpv6 = 58;
+
+constexpr uint16_t kDhcpV4ServerPort = 67;
+constexpr uint16_t kDhcpV4ClientPort = 68;
+constexpr uint16_t kDhcpV6ClientPort = 546;
+constexpr uint16_t kDhcpV6ServerPort = 547;
+
+constexpr size_t kIPv4MinHdrSize = 20;
+constexpr size_t kIPv6HdrSize = 40;
+
+// Caps pooled memory at ~20MB, packets beyond this are heap copied
+constexpr size_t kMaxPooledBuffers = 2048;
+} // namespace
+
+namespace facebook::fboss {
+
+RxBufferPool* RxBufferPool::create(size_t maxBuffers) {
+  return new RxBufferPool(maxBuffers);
+}
+
+RxBufferPool::RxBufferPool(size_t maxBuffers)
+    : maxBuffers_(maxBuffers), freeList_(maxBuffers) {}
+
+RxBufferPool::~RxBufferPool() {
+  uint8_t* buf;
+  while (freeList_.read(buf)) {
+    delete[] buf;
+  }
+}
+
+void RxBufferPool::release() {
+  decRef();
+}
+
+void RxBufferPool::decRef() {
+  if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
+
+void RxBufferPool::freeBuffer(void* buf, void* pool) {
+  auto self = static_cast<RxBufferPool*>(pool);
+  // Every buffer we hand out was accounted for in freeList_'s capacity
+  // when it was allocated, so this never fails
+  self->freeList_.write(static_cast<uint8_t*>(buf));
+  self->decRef();
+}
+
+std::unique_ptr<folly::IOBuf> RxBufferPool::copy(const folly::IOBuf* buf) {
+  auto len = buf->computeChainDataLength();
+  auto heapCopy = [buf, len]() {
+    auto ret = folly::IOBuf::create(len);
+    folly::io::Cursor(buf).pull(ret->writableData(), len);
+    ret->append(len);
+    return ret;
+  };
+  if (len > kBufferSize) {
+    return heapCopy();
+  }
+  uint8_t* data = nullptr;
+  if (!freeList_.read(data)) {
+    auto allocated = allocated_.load(std::memory_order_relaxed);
+    do {
+      if (allocated >= maxBuffers_) {
+        return heapCopy();
+      }
+    } while (!allocated_.compare_exchange_weak(
+        allocated, allocated + 1, std::memory_order_relaxed));
+    data = new uint8_t[kBufferSize];
+  }
+  folly::io::Cursor(buf).pull(data, len);
+  refs_.fetch_add(1, std::memory_order_relaxed);
+  return folly::IOBuf::takeOwnership(data, kBufferSize, len, freeBuffer, this);
+}
+
+RxPacketDispatcher::RxPacketDispatcher(Handler handler, size_t queueSize)
+    : handler_(std::move(handler)),
+      pool_(RxBufferPool::create(
+          std::min(queueSize * kNumClasses, kMaxPooledBuffers))) {
+  for (size_t i = 0; i < kNumClasses; ++i) {
+    queues_[i] = std::make_unique<ClassQueue>(queueSize);
+  }
+  for (size_t i = 0; i < kNumClasses; ++i) {
+    auto pktClass = static_cast<PacketClass>(i);
+    queues_[i]->worker = std::make_unique<std::thread>(
+        [this, pktClass]() { workerLoop(pktClass); });
+  }
+}
+
+RxPacketDispatcher::~RxPacketDispatcher() {
+  stop();
+  pool_->release();
+}
+
+void RxPacketDispatcher::stop() {
+  if (stopped_.exchange(true)) {
+    return;
+  }
+  for (auto& classQueue : queues_) {
+    classQueue->queue.blockingWrite(nullptr);
+  }
+  for (auto& classQueue : queues_) {
+    classQueue->worker->join();
+  }
+}
+
+bool RxPacketDispatcher::dispatch(std::unique_ptr<RxPacket> pkt) {
+  auto& classQueue = *queues_[static_cast<size_t>(classify(pkt.get()))];
+  if (stopped_.load(std::memory_order_relaxed) ||
+      classQueue.queue.sizeGuess() >=
+          static_cast<ssize_t>(classQueue.queue.capacity())) {
+    // Check before paying for the copy, the write below catches any race
+    classQueue.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  // The packet may be backed by a buffer the SDK reclaims once we return
+  pkt->setBuf(pool_->copy(pkt->buf()));
+  if (!classQueue.queue.write(std::move(pkt))) {
+    classQueue.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  classQueue.dispatched.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void RxPacketDispatcher::workerLoop(PacketClass pktClass) {
+  initThread(folly::to<std::string>("RxDisp", className(pktClass)));
+  auto& classQueue = *queues_[static_cast<size_t>(pktClass)];
+  while (true) {
+    std::unique_ptr<RxPacket> pkt;
+    classQueue.queue.blockingRead(pkt);
+    if (!pkt) {
+      break;
+    }
+    handler_(std::move(pkt));
+  }
+}
+
+RxPacketDispatcher::PacketClass RxPacketDispatcher::classify(
+    const RxPacket* pkt) {
+  folly::io::Cursor c(pkt->buf());
+  try {
+    c.skip(12); // dst and src MAC
+    auto ethertype = c.readBE<uint16_t>();
+    if (ethertype == kEthertypeVlan) {
+      c.skip(2);
+      ethertype = c.readBE<uint16_t>();
+    }
+    switch (ethertype) {
+      case kEthertypeSlowProtocols:
+      case kEthertypeLldp:
+      case kEthertypeEapol:
+        return PacketClass::CONTROL;
+      case kEthertypeArp:
+        return PacketClass::NEIGHBOR;
+      case kEthertypeIPv4: {
+        size_t ihl = (c.read<uint8_t>() & 0x0f) * 4;
+        c.skip(8);
+        auto proto = c.read<uint8_t>();
+        if (proto != kIpProtoUdp || ihl < kIPv4MinHdrSize) {
+          return PacketClass::OTHER;
+        }
+        c.skip(ihl - 10);
+        c.skip(2); // UDP source port
+        auto dstPort = c.readBE<uint16_t>();
+        return dstPort == kDhcpV4ServerPort || dstPort == kDhcpV4ClientPort
+            ? PacketClass::DHCP
+            : PacketClass::OTHER;
+      }
+      case kEthertypeIPv6: {
+        c.skip(6);
+        auto nextHeader = c.read<uint8_t>();
+        if (nextHeader == kIpProtoIcmpv6) {
+          return PacketClass::NEIGHBOR;
+        }
+        if (nextHeader != kIpProtoUdp) {
+          return PacketClass::OTHER;
+        }
+        c.skip(kIPv6HdrSize - 7);
+        c.skip(2); // UDP source port
+        auto dstPort = c.readBE<uint16_t>();
+        return dstPort == kDhcpV6ServerPort || dstPort == kDhcpV6ClientPort
+            ? PacketClass::DHCP
+            : PacketClass::OTHER;
+      }
+      default:
+        break;
+    }
+  } catch (const std::out_of_range&) {
+    // Truncated packet, let the regular handlers account for it
+  }
+  return PacketClass::OTHER;
+}
+
+const char* RxPacketDispatcher::className(PacketClass pktClass) {
+  switch (pktClass) {
+    case PacketClass::CONTROL:
+      return "Control";
+    case PacketClass::NEIGHBOR:
+      return "Neighbor";
+    case PacketClass::DHCP:
+      return "Dhcp";
+    case PacketClass::OTHER:
+      return "Other";
+  }
+  return "Unknown";
+}
+
+} // namespace facebook::fboss
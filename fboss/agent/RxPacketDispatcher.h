@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/MPMCQueue.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace folly {
+class IOBuf;
+}
+
+namespace facebook::fboss {
+
+class RxPacket;
+
+/*
+ * Fixed size buffers that trapped packets are copied into before they are
+ * queued, so that the SDK can reuse its own buffer as soon as the RX
+ * callback returns.
+ *
+ * Buffers are allocated lazily, up to maxBuffers, and recycled through a
+ * lock free free list. Packets larger than a buffer, or arriving while all
+ * buffers are in flight, fall back to a regular heap copy.
+ *
+ * The pool is reference counted by its owner and by every buffer in
+ * flight, since packets may outlive the dispatcher (e.g. when held by a
+ * handler waiting on neighbor resolution).
+ */
+class RxBufferPool {
+ public:
+  static constexpr size_t kBufferSize = 10 * 1024;
+
+  static RxBufferPool* create(size_t maxBuffers);
+  // Drop the owner's reference, the pool is freed once all buffers return
+  void release();
+
+  std::unique_ptr<folly::IOBuf> copy(const folly::IOBuf* buf);
+
+  size_t numAllocated() const {
+    return allocated_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  explicit RxBufferPool(size_t maxBuffers);
+  ~RxBufferPool();
+  // Not copyable or movable
+  RxBufferPool(RxBufferPool const&) = delete;
+  RxBufferPool& operator=(RxBufferPool const&) = delete;
+
+  static void freeBuffer(void* buf, void* pool);
+  void decRef();
+
+  const size_t maxBuffers_;
+  std::atomic<size_t> allocated_{0};
+  std::atomic<size_t> refs_{1};
+  folly::MPMCQueue<uint8_t*> freeList_;
+};
+
+/*
+ * Moves handling of trapped packets off the thread delivering them.
+ *
+ * Packets are classified by ethertype into a handful of classes, each with
+ * its own bounded queue and dedicated worker thread. A storm in one class
+ * (e.g. ARP or DHCP) can then only fill its own queue; control protocol
+ * packets (LACP, LLDP, EAPOL) keep being served by their own worker. When a
+ * queue is full the packet is dropped before it is copied and the drop is
+ * accounted against its class.
+ *
+ * Packets within a class are handled in the order they were received.
+ * Packets of different classes are handled concurrently.
+ */
+class RxPacketDispatcher {
+ public:
+  enum class PacketClass : uint8_t {
+    // LACP, LLDP, EAPOL
+    CONTROL,
+    // ARP and ICMPv6 (NDP)
+    NEIGHBOR,
+    // DHCPv4 and DHCPv6
+    DHCP,
+    // Everything else
+    OTHER,
+  };
+  static constexpr size_t kNumClasses =
+      static_cast<size_t>(PacketClass::OTHER) + 1;
+
+  using Handler = std::function<void(std::unique_ptr<RxPacket>)>;
+
+  RxPacketDispatcher(Handler handler, size_t queueSize);
+  ~RxPacketDispatcher();
+
+  /*
+   * Queue pkt for handling on the worker of its class.
+   *
+   * Returns false if the queue was full and the packet was dropped.
+   */
+  bool dispatch(std::unique_ptr<RxPacket> pkt);
+
+  /*
+   * Drain the queues and join the workers. No more packets are accepted
+   * after this.
+   */
+  void stop();
+
+  bool isStopped() const {
+    return stopped_.load(std::memory_order_relaxed);
+  }
+
+  static PacketClass classify(const RxPacket* pkt);
+  static const char* className(PacketClass pktClass);
+
+  uint64_t getDispatched(PacketClass pktClass) const {
+    return queues_[static_cast<size_t>(pktClass)]->dispatched.load(
+        std::memory_order_relaxed);
+  }
+  uint64_t getDropped(PacketClass pktClass) const {
+    return queues_[static_cast<size_t>(pktClass)]->dropped.load(
+        std::memory_order_relaxed);
+  }
+
+ private:
+  // Not copyable or movable
+  RxPacketDispatcher(RxPacketDispatcher const&) = delete;
+  RxPacketDispatcher& operator=(RxPacketDispatcher const&) = delete;
+
+  struct ClassQueue {
+    explicit ClassQueue(size_t size) : queue(size) {}
+    // A null packet asks the worker to exit
+    folly::MPMCQueue<std::unique_ptr<RxPacket>> queue;
+    std::atomic<uint64_t> dispatched{0};
+    std::atomic<uint64_t> dropped{0};
+    std::unique_ptr<std::thread> worker;
+  };
+
+  void workerLoop(PacketClass pktClass);
+
+  Handler handler_;
+  RxBufferPool* pool_;
+  std::atomic<bool> stopped_{false};
+  std::array<std::unique_ptr<ClassQueue>, kNumClasses> queues_;
+};
+
+} // namespace facebook::fboss
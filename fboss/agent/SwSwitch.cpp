@@ -61,6 +61,7 @@
 #include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/RxPacket.h"
+#include "fboss/agent/RxPacketDispatcher.h"
 #include "fboss/agent/StaticL2ForNeighborObserver.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/SwSwitchWarmBootHelper.h"
@@ -163,12 +164,20 @@ DEFINE_int32(
     "Interval at which stats subscriptions are served");
 
 DECLARE_bool(intf_nbr_tables);
+DECLARE_bool(rx_dispatch);
+DECLARE_int32(rx_dispatch_queue_size);
 
 DEFINE_int32(
     hwagent_base_thrift_port,
     5931,
     "The first thrift server port reserved for HwAgent");
 
+DEFINE_bool(
+    config_fingerprint,
+    true,
+    "Skip re-evaluating parts of the config that did not change since the "
+    "previously applied config");
+
 DEFINE_bool(
     dsf_publisher_GR,
     false,
@@ -422,6 +431,13 @@ SwSwitch::SwSwitch(
   }
   fsdbSyncer_.withWLock(
       [this](auto& syncer) { syncer = std::make_unique<FsdbSyncer>(this); });
+  if (FLAGS_rx_dispatch) {
+    rxPacketDispatcher_ = std::make_unique<RxPacketDispatcher>(
+        [this](std::unique_ptr<RxPacket> pkt) {
+          handleDispatchedPacket(std::move(pkt));
+        },
+        FLAGS_rx_dispatch_queue_size);
+  }
   if (initialState) {
     initialState->publish();
     setStateInternal(initialState);
@@ -493,6 +509,13 @@ void SwSwitch::stop(bool isGracefulStop, bool revertToMinAlpmState) {
   if (tunMgr_) {
     tunMgr_->stopProcessing();
   }
+  // Drain packets already queued for handling while the handlers are still
+  // around. Packets that still arrive (e.g. over multi switch RX streams)
+  // are handled inline from here on, the dispatcher itself is only destroyed
+  // along with SwSwitch, once the HW switch handlers are gone.
+  if (rxPacketDispatcher_) {
+    rxPacketDispatcher_->stop();
+  }
 
   resolvedNexthopMonitor_.reset();
   resolvedNexthopProbeScheduler_.reset();
@@ -1846,6 +1869,12 @@ void SwSwitch::packetReceived(std::unique_ptr<RxPacket> pkt) noexcept {
       stats()->packetRxHeartbeatDelay(delay.count());
     }
     lastPacketRxTime_ = now;
+    if (rxPacketDispatcher_ && !rxPacketDispatcher_->isStopped()) {
+      if (!rxPacketDispatcher_->dispatch(std::move(pkt))) {
+        stats()->pktDispatchDropped();
+      }
+      return;
+    }
     handlePacket(std::move(pkt));
   } catch (const std::exception& ex) {
     portStats(port)->pktError();
@@ -1855,6 +1884,16 @@ void SwSwitch::packetReceived(std::unique_ptr<RxPacket> pkt) noexcept {
   }
 }
 
+void SwSwitch::handleDispatchedPacket(std::unique_ptr<RxPacket> pkt) noexcept {
+  PortID port = pkt->getSrcPort();
+  try {
+    handlePacket(std::move(pkt));
+  } catch (const std::exception& ex) {
+    portStats(port)->pktError();
+    XLOG(ERR) << "error processing trapped packet: " << folly::exceptionStr(ex);
+  }
+}
+
 void SwSwitch::packetReceivedThrowExceptionOnError(
     std::unique_ptr<RxPacket> pkt) {
   handlePacket(std::move(pkt));
@@ -1925,26 +1964,29 @@ void SwSwitch::handlePacketImpl(
     ethertype = c.readBE<uint16_t>();
   }
 
-  auto vlanID = getVlanIDFromVlanOrIntf(vlanOrIntf);
-  auto vlanIDStr = vlanID.has_value()
-      ? folly::to<std::string>(static_cast<int>(vlanID.value()))
-      : "None";
+  // Only build the log string when it is going to be logged
+  auto vlanIDStr = [&vlanOrIntf]() -> std::string {
+    auto vlanID = getVlanIDFromVlanOrIntf(vlanOrIntf);
+    return vlanID.has_value()
+        ? folly::to<std::string>(static_cast<int>(vlanID.value()))
+        : "None";
+  };
 
   XLOG(DBG5) << "trapped packet: src_port=" << pkt->getSrcPort()
              << " srcAggPort="
              << (pkt->isFromAggregatePort()
                      ? folly::to<string>(pkt->getSrcAggregatePort())
                      : "None")
-             << " vlan=" << vlanIDStr << " length=" << len << " src=" << srcMac
-             << " dst=" << dstMac << " ethertype=0x" << std::hex << ethertype
-             << " :: " << pkt->describeDetails();
+             << " vlan=" << vlanIDStr() << " length=" << len
+             << " src=" << srcMac << " dst=" << dstMac << " ethertype=0x"
+             << std::hex << ethertype << " :: " << pkt->describeDetails();
   XLOG_EVERY_N(DBG2, 10000)
       << "sampled " << "trapped packet: src_port=" << pkt->getSrcPort()
       << " srcAggPort="
       << (pkt->isFromAggregatePort()
               ? folly::to<string>(pkt->getSrcAggregatePort())
               : "None")
-      << " vlan=" << vlanIDStr << " length=" << len << " src=" << srcMac
+      << " vlan=" << vlanIDStr() << " length=" << len << " src=" << srcMac
       << " dst=" << dstMac << " ethertype=0x" << std::hex << ethertype
       << " :: " << pkt->describeDetails();
 
@@ -2765,6 +2807,11 @@ void SwSwitch::applyConfigImpl(
       reason,
       [&](const shared_ptr<SwitchState>& state) -> shared_ptr<SwitchState> {
         auto originalState = state;
+        if (FLAGS_config_fingerprint && !configFingerprint_) {
+          configFingerprint_ = std::make_unique<ConfigFingerprint>();
+        } else if (!FLAGS_config_fingerprint) {
+          configFingerprint_.reset();
+        }
         auto newState = applyThriftConfig(
             originalState,
             &newConfig,
@@ -2772,7 +2819,8 @@ void SwSwitch::applyConfigImpl(
             platformMapping_.get(),
             hwAsicTable_.get(),
             &routeUpdater,
-            aclNexthopHandler_.get());
+            aclNexthopHandler_.get(),
+            configFingerprint_.get());
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
@@ -64,6 +64,7 @@ class PortDescriptor;
 class PortStats;
 class PortUpdateHandler;
 class RxPacket;
+class RxPacketDispatcher;
 class SwitchState;
 class SwitchStats;
 class SwitchIdScopeResolver;
@@ -76,6 +77,7 @@ class TunManager;
 class MirrorManager;
 class PhySnapshotManager;
 class AclNexthopHandler;
+class ConfigFingerprint;
 class LookupClassUpdater;
 class LookupClassRouteUpdater;
 class MacTableManager;
@@ -1006,6 +1008,7 @@ class SwSwitch : public HwSwitchCallback {
   PortDescriptor getPortFromPkt(const RxPacket* pkt) const;
 
   void handlePacket(std::unique_ptr<RxPacket> pkt);
+  void handleDispatchedPacket(std::unique_ptr<RxPacket> pkt) noexcept;
   template <typename VlanOrIntfT>
   void handlePacketImpl(
       std::unique_ptr<RxPacket> pkt,
@@ -1091,6 +1094,10 @@ class SwSwitch : public HwSwitchCallback {
   void updateAddrToLocalIntf(const StateDelta& delta);
 
   std::optional<cfg::SdkVersion> sdkVersion_;
+  // Set with --rx_dispatch. Its workers are joined in stop(), but HW switch
+  // handlers may keep delivering packets until they are destroyed, so it is
+  // declared before (and hence destroyed after) them.
+  std::unique_ptr<RxPacketDispatcher> rxPacketDispatcher_;
   std::unique_ptr<MultiHwSwitchHandler> multiHwSwitchHandler_;
   const AgentDirectoryUtil* agentDirUtil_;
   bool supportsAddRemovePort_;
@@ -1224,6 +1231,8 @@ class SwSwitch : public HwSwitchCallback {
 
   std::unique_ptr<PhySnapshotManager> phySnapshotManager_;
   std::unique_ptr<AclNexthopHandler> aclNexthopHandler_;
+  // Only accessed while applying config on the update thread
+  std::unique_ptr<ConfigFingerprint> configFingerprint_;
   folly::Synchronized<std::unique_ptr<FsdbSyncer>> fsdbSyncer_;
   std::unique_ptr<TeFlowNexthopHandler> teFlowNextHopHandler_;
   std::unique_ptr<DsfSubscriber> dsfSubscriber_;
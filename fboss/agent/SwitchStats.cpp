@@ -46,6 +46,11 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map, int numSwitches)
       trapPktBogus_(map, kCounterPrefix + "trapped.bogus", SUM, RATE),
       trapPktErrors_(map, kCounterPrefix + "trapped.error", SUM, RATE),
       trapPktUnhandled_(map, kCounterPrefix + "trapped.unhandled", SUM, RATE),
+      trapPktDispatchDrops_(
+          map,
+          kCounterPrefix + "trapped.dispatch_drops",
+          SUM,
+          RATE),
       trapPktToHost_(map, kCounterPrefix + "host.rx", SUM, RATE),
       trapPktToHostBytes_(map, kCounterPrefix + "host.rx.bytes", SUM, RATE),
       pktFromHost_(map, kCounterPrefix + "host.tx", SUM, RATE),
@@ -296,6 +301,13 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map, int numSwitches)
           RATE),
       dsfGrExpired_(map, kCounterPrefix + "dsfsession_gr_expired", SUM, RATE),
       dsfUpdateFailed_(map, kCounterPrefix + "dsf_update_failed", SUM, RATE),
+      l2LearnEvents_(map, kCounterPrefix + "l2.learn_events", SUM, RATE),
+      l2LearnEventsFolded_(
+          map,
+          kCounterPrefix + "l2.learn_events.folded",
+          SUM,
+          RATE),
+      l2LearnBatches_(map, kCounterPrefix + "l2.learn_batches", SUM, RATE),
       multiSwitchStatus_(map, kCounterPrefix + "multi_switch", SUM, RATE)
 
 {
@@ -105,6 +105,10 @@ class SwitchStats : public boost::noncopyable {
     trapPktUnhandled_.addValue(1);
     trapPktDrops_.addValue(1);
   }
+  void pktDispatchDropped() {
+    trapPktDispatchDrops_.addValue(1);
+    trapPktDrops_.addValue(1);
+  }
   void pktToHost(uint32_t bytes) {
     trapPktToHost_.addValue(1);
     trapPktToHostBytes_.addValue(bytes);
@@ -546,6 +550,25 @@ class SwitchStats : public boost::noncopyable {
     return getCumulativeValue(dsfUpdateFailed_);
   }
 
+  void l2LearnEventReceived() {
+    l2LearnEvents_.addValue(1);
+  }
+  void l2LearnEventFolded() {
+    l2LearnEventsFolded_.addValue(1);
+  }
+  void l2LearnBatchApplied() {
+    l2LearnBatches_.addValue(1);
+  }
+  int64_t getL2LearnEvents() const {
+    return getCumulativeValue(l2LearnEvents_);
+  }
+  int64_t getL2LearnEventsFolded() const {
+    return getCumulativeValue(l2LearnEventsFolded_);
+  }
+  int64_t getL2LearnBatches() const {
+    return getCumulativeValue(l2LearnBatches_);
+  }
+
   void getHwAgentStatus(
       std::map<int16_t, HwAgentEventSyncStatus>& statusMap) const;
 
@@ -724,6 +747,8 @@ class SwitchStats : public boost::noncopyable {
   TLTimeseries trapPktErrors_;
   // Trapped packets that the controller didn't know how to handle.
   TLTimeseries trapPktUnhandled_;
+  // Trapped packets dropped because their RX dispatch queue was full
+  TLTimeseries trapPktDispatchDrops_;
   // Trapped packets forwarded to host
   TLTimeseries trapPktToHost_;
   // Trapped packets forwarded to host in bytes
@@ -963,6 +988,13 @@ class SwitchStats : public boost::noncopyable {
   TLTimeseries switchConfiguredMs_;
   TLTimeseries dsfGrExpired_;
   TLTimeseries dsfUpdateFailed_;
+  // L2 learn/age callbacks received from the HwSwitch
+  TLTimeseries l2LearnEvents_;
+  // L2 learn/age callbacks superseded by a later one for the same MAC
+  // before their batch was applied
+  TLTimeseries l2LearnEventsFolded_;
+  // State updates issued for batches of L2 learn/age callbacks
+  TLTimeseries l2LearnBatches_;
 
   // TODO: delete this once multi_switch becomes default
   TLTimeseries multiSwitchStatus_;
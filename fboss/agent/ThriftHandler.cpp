@@ -69,6 +69,9 @@
 #include <folly/MoveWrapper.h>
 #include <folly/Range.h>
 #include <folly/container/F14Map.h>
+#if FOLLY_HAS_COROUTINES
+#include <folly/coro/AsyncGenerator.h>
+#endif
 #include <folly/functional/Partial.h>
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
@@ -77,6 +80,7 @@
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/async/DuplexChannel.h>
 #include <memory>
+#include <variant>
 
 #include <limits>
 
@@ -687,6 +691,109 @@ void addRecylePortRifNeighbors(
     }
   }
 }
+
+// Route as programmed, i.e. its resolved forwarding info
+template <typename RouteT>
+UnicastRoute toUnicastRoute(const std::shared_ptr<RouteT>& route) {
+  UnicastRoute tempRoute;
+  const auto& fwdInfo = route->getForwardInfo();
+  tempRoute.dest()->ip() = toBinaryAddress(route->prefix().network());
+  tempRoute.dest()->prefixLength() = route->prefix().mask();
+  tempRoute.nextHopAddrs() = util::fromFwdNextHops(fwdInfo.getNextHopSet());
+  tempRoute.nextHops() =
+      util::fromRouteNextHopSet(fwdInfo.normalizedNextHops());
+  if (fwdInfo.getCounterID().has_value()) {
+    tempRoute.counterID() = *fwdInfo.getCounterID();
+  }
+  if (fwdInfo.getClassID().has_value()) {
+    tempRoute.classID() = *fwdInfo.getClassID();
+  }
+  return tempRoute;
+}
+
+// Route as added by client
+template <typename RouteT>
+UnicastRoute toUnicastRoute(
+    const std::shared_ptr<RouteT>& route,
+    const RouteNextHopEntry& entry) {
+  UnicastRoute tempRoute;
+  tempRoute.dest()->ip() = toBinaryAddress(route->prefix().network());
+  tempRoute.dest()->prefixLength() = route->prefix().mask();
+  tempRoute.nextHops() = util::fromRouteNextHopSet(entry.getNextHopSet());
+  if (entry.getCounterID()) {
+    tempRoute.counterID() = *entry.getCounterID();
+  }
+  if (auto classID = entry.getClassID()) {
+    tempRoute.classID() = *classID;
+  }
+  for (const auto& nh : *tempRoute.nextHops()) {
+    tempRoute.nextHopAddrs()->emplace_back(*nh.address());
+  }
+  return tempRoute;
+}
+
+#if FOLLY_HAS_COROUTINES
+constexpr int32_t kDefaultRouteChunkSize = 1000;
+
+template <typename RouteT>
+bool routeMatchesFilter(
+    const std::shared_ptr<RouteT>& route,
+    const RouteTableFilter& filter) {
+  if (auto prefix = filter.prefix()) {
+    auto filterIp = toIPAddress(*prefix->ip());
+    const auto& routePrefix = route->prefix();
+    if (filterIp.isV4() != routePrefix.network().isV4() ||
+        routePrefix.mask() < *prefix->prefixLength() ||
+        !folly::IPAddress(routePrefix.network())
+             .inSubnet(filterIp, *prefix->prefixLength())) {
+      return false;
+    }
+  }
+  if (auto clientId = filter.clientId()) {
+    if (!route->getEntryForClient(ClientID(*clientId))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * Yields the routes of state for which match returns true, in chunks of up
+ * to chunkSize, converted with toThrift. Only pointers to the matching
+ * routes are collected up front, thrift routes are built one chunk at a
+ * time as the client asks for more. Holding state keeps the routes alive
+ * and consistent for the life of the stream.
+ */
+template <typename ThriftRouteT, typename MatchFn, typename ToThriftFn>
+folly::coro::AsyncGenerator<std::vector<ThriftRouteT>&&> streamRoutes(
+    std::shared_ptr<SwitchState> state,
+    int32_t chunkSize,
+    MatchFn match,
+    ToThriftFn toThrift) {
+  if (chunkSize <= 0) {
+    chunkSize = kDefaultRouteChunkSize;
+  }
+  using RouteVariant =
+      std::variant<std::shared_ptr<RouteV6>, std::shared_ptr<RouteV4>>;
+  std::vector<RouteVariant> routes;
+  forAllRoutes(state, [&](RouterID /*rid*/, const auto& route) {
+    if (match(route)) {
+      routes.emplace_back(route);
+    }
+  });
+  for (size_t begin = 0; begin < routes.size(); begin += chunkSize) {
+    auto end = std::min(routes.size(), begin + chunkSize);
+    std::vector<ThriftRouteT> chunk;
+    chunk.reserve(end - begin);
+    for (auto idx = begin; idx < end; idx++) {
+      std::visit(
+          [&](const auto& route) { chunk.emplace_back(toThrift(route)); },
+          routes[idx]);
+    }
+    co_yield std::move(chunk);
+  }
+}
+#endif
 } // namespace
 
 namespace facebook::fboss {
@@ -1885,24 +1992,11 @@ void ThriftHandler::getRouteTable(std::vector<UnicastRoute>& routes) {
   ensureConfigured(__func__);
   auto state = sw_->getState();
   forAllRoutes(state, [&routes](RouterID /*rid*/, const auto& route) {
-    UnicastRoute tempRoute;
     if (!route->isResolved()) {
       XLOG(DBG2) << "Skipping unresolved route: " << route->toFollyDynamic();
       return;
     }
-    const auto& fwdInfo = route->getForwardInfo();
-    tempRoute.dest()->ip() = toBinaryAddress(route->prefix().network());
-    tempRoute.dest()->prefixLength() = route->prefix().mask();
-    tempRoute.nextHopAddrs() = util::fromFwdNextHops(fwdInfo.getNextHopSet());
-    tempRoute.nextHops() =
-        util::fromRouteNextHopSet(fwdInfo.normalizedNextHops());
-    if (fwdInfo.getCounterID().has_value()) {
-      tempRoute.counterID() = *fwdInfo.getCounterID();
-    }
-    if (fwdInfo.getClassID().has_value()) {
-      tempRoute.classID() = *fwdInfo.getClassID();
-    }
-    routes.emplace_back(std::move(tempRoute));
+    routes.emplace_back(toUnicastRoute(route));
   });
 }
 
@@ -1917,20 +2011,7 @@ void ThriftHandler::getRouteTableByClient(
     if (not entry) {
       return;
     }
-    UnicastRoute tempRoute;
-    tempRoute.dest()->ip() = toBinaryAddress(route->prefix().network());
-    tempRoute.dest()->prefixLength() = route->prefix().mask();
-    tempRoute.nextHops() = util::fromRouteNextHopSet(entry->getNextHopSet());
-    if (entry->getCounterID()) {
-      tempRoute.counterID() = *entry->getCounterID();
-    }
-    if (auto classID = entry->getClassID()) {
-      tempRoute.classID() = *classID;
-    }
-    for (const auto& nh : *tempRoute.nextHops()) {
-      tempRoute.nextHopAddrs()->emplace_back(*nh.address());
-    }
-    routes.emplace_back(std::move(tempRoute));
+    routes.emplace_back(toUnicastRoute(route, *entry));
   });
 }
 
@@ -1942,6 +2023,51 @@ void ThriftHandler::getRouteTableDetails(std::vector<RouteDetails>& routes) {
   });
 }
 
+#if FOLLY_HAS_COROUTINES
+apache::thrift::ServerStream<std::vector<UnicastRoute>>
+ThriftHandler::streamRouteTable(
+    std::unique_ptr<RouteTableFilter> filter,
+    int32_t chunkSize) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  if (auto clientId = filter->clientId()) {
+    // Like getRouteTableByClient
+    return streamRoutes<UnicastRoute>(
+        sw_->getState(),
+        chunkSize,
+        [filter = *filter](const auto& route) {
+          return routeMatchesFilter(route, filter);
+        },
+        [client = ClientID(*clientId)](const auto& route) {
+          return toUnicastRoute(route, *route->getEntryForClient(client));
+        });
+  }
+  // Like getRouteTable
+  return streamRoutes<UnicastRoute>(
+      sw_->getState(),
+      chunkSize,
+      [filter = *filter](const auto& route) {
+        return route->isResolved() && routeMatchesFilter(route, filter);
+      },
+      [](const auto& route) { return toUnicastRoute(route); });
+}
+
+apache::thrift::ServerStream<std::vector<RouteDetails>>
+ThriftHandler::streamRouteTableDetails(
+    std::unique_ptr<RouteTableFilter> filter,
+    int32_t chunkSize) {
+  auto log = LOG_THRIFT_CALL(DBG1);
+  ensureConfigured(__func__);
+  return streamRoutes<RouteDetails>(
+      sw_->getState(),
+      chunkSize,
+      [filter = *filter](const auto& route) {
+        return routeMatchesFilter(route, filter);
+      },
+      [](const auto& route) { return route->toRouteDetails(true); });
+}
+#endif
+
 void ThriftHandler::getIpRoute(
     UnicastRoute& route,
     std::unique_ptr<Address> addr,
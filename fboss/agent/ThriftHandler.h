@@ -168,6 +168,15 @@ class ThriftHandler : virtual public FbossCtrlSvIf,
       std::vector<UnicastRoute>& routeTable,
       int16_t clientId) override;
   void getRouteTableDetails(std::vector<RouteDetails>& routeTable) override;
+#if FOLLY_HAS_COROUTINES
+  apache::thrift::ServerStream<std::vector<UnicastRoute>> streamRouteTable(
+      std::unique_ptr<RouteTableFilter> filter,
+      int32_t chunkSize) override;
+  apache::thrift::ServerStream<std::vector<RouteDetails>>
+  streamRouteTableDetails(
+      std::unique_ptr<RouteTableFilter> filter,
+      int32_t chunkSize) override;
+#endif
 
   void getPortStatus(
       std::map<int32_t, PortStatus>& status,
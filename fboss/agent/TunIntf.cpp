@@ -32,6 +32,13 @@ extern "C" {
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/packet/EthHdr.h"
 
+#include <gflags/gflags.h>
+
+DEFINE_int32(
+    tun_read_batch,
+    64,
+    "Max packets read from a multi queue tun queue per wakeup");
+
 namespace facebook::fboss {
 
 namespace {
@@ -62,12 +69,57 @@ struct iplink_req {
 
 } // anonymous namespace
 
+/*
+ * Reads one IFF_MULTI_QUEUE queue of the interface on its own EventBase
+ */
+class TunIntf::HostQueue : public folly::EventHandler {
+ public:
+  HostQueue(TunIntf* intf, folly::EventBase* evb, int fd)
+      : folly::EventHandler(evb), intf_(intf), evb_(evb), fd_(fd) {}
+
+  ~HostQueue() override {
+    stop();
+  }
+
+  void start() {
+    evb_->runImmediatelyOrRunInEventBaseThreadAndWait([this]() {
+      if (!isHandlerRegistered()) {
+        changeHandlerFD(folly::NetworkSocket::fromFd(fd_));
+        registerHandler(
+            folly::EventHandler::READ | folly::EventHandler::PERSIST);
+      }
+    });
+  }
+
+  void stop() {
+    evb_->runImmediatelyOrRunInEventBaseThreadAndWait(
+        [this]() { unregisterHandler(); });
+  }
+
+  int getFD() const {
+    return fd_;
+  }
+
+ private:
+  void handlerReady(uint16_t /*events*/) noexcept override {
+    if (!intf_->forwardPacketsFromHost(fd_, spare_, FLAGS_tun_read_batch)) {
+      unregisterHandler();
+    }
+  }
+
+  TunIntf* intf_;
+  folly::EventBase* evb_;
+  const int fd_;
+  std::unique_ptr<TxPacket> spare_;
+};
+
 TunIntf::TunIntf(
     SwSwitch* sw,
     folly::EventBase* evb,
     InterfaceID ifID,
     int ifIndex,
-    int mtu)
+    int mtu,
+    const std::vector<folly::EventBase*>& queueEvbs)
     : folly::EventHandler(evb),
       sw_(sw),
       name_(utility::createTunIntfName(ifID)),
@@ -77,7 +129,7 @@ TunIntf::TunIntf(
   DCHECK(sw) << "NULL pointer to SwSwitch.";
   DCHECK(evb) << "NULL pointer to EventBase";
 
-  openFD();
+  openFD(queueEvbs);
   SCOPE_FAIL {
     closeFD();
   };
@@ -97,7 +149,8 @@ TunIntf::TunIntf(
     InterfaceID ifID,
     bool status,
     const Interface::Addresses& addr,
-    int mtu)
+    int mtu,
+    const std::vector<folly::EventBase*>& queueEvbs)
     : folly::EventHandler(evb),
       sw_(sw),
       name_(utility::createTunIntfName(ifID)),
@@ -109,7 +162,7 @@ TunIntf::TunIntf(
   DCHECK(evb) << "NULL pointer to EventBase";
 
   // Open Tun interface FD for socket-IO
-  openFD();
+  openFD(queueEvbs);
   SCOPE_FAIL {
     closeFD();
   };
@@ -174,55 +227,113 @@ TunIntf::~TunIntf() {
 }
 
 void TunIntf::stop() {
+  for (auto& queue : queues_) {
+    queue->stop();
+  }
   unregisterHandler();
 }
 
 void TunIntf::start() {
+  if (!queues_.empty()) {
+    for (auto& queue : queues_) {
+      queue->start();
+    }
+    return;
+  }
   if (fd_ != -1 && !isHandlerRegistered()) {
     changeHandlerFD(folly::NetworkSocket::fromFd(fd_));
     registerHandler(folly::EventHandler::READ | folly::EventHandler::PERSIST);
   }
 }
 
-void TunIntf::openFD() {
-  fd_ = open(kTunDev.c_str(), O_RDWR);
-  sysCheckError(fd_, "Cannot open ", kTunDev.c_str());
-  SCOPE_FAIL {
-    closeFD();
-  };
+int TunIntf::attachFD(short ifrFlags) {
+  int fd = open(kTunDev.c_str(), O_RDWR);
+  sysCheckError(fd, "Cannot open ", kTunDev.c_str());
 
   struct ifreq ifr;
   memset(&ifr, 0, sizeof(ifr));
-  // Flags: IFF_TUN   - TUN device (no Ethernet headers)
-  //        IFF_NO_PI - Do not provide packet information
-  ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  ifr.ifr_flags = ifrFlags;
   bzero(ifr.ifr_name, sizeof(ifr.ifr_name));
   size_t len = std::min(name_.size(), sizeof(ifr.ifr_name));
   memmove(ifr.ifr_name, name_.c_str(), len);
-  auto ret = ioctl(fd_, TUNSETIFF, (void*)&ifr);
-  sysCheckError(ret, "Failed to create/attach interface ", name_);
-
-  // Set configured MTU
-  setMtu(mtu_);
+  auto ret = ioctl(fd, TUNSETIFF, (void*)&ifr);
+  if (ret < 0) {
+    auto err = errno;
+    close(fd);
+    errno = err;
+    return -1;
+  }
+  SCOPE_FAIL {
+    close(fd);
+  };
 
   // make fd non-blocking
-  auto flags = fcntl(fd_, F_GETFL);
-  sysCheckError(flags, "Failed to get flags from fd ", fd_);
+  auto flags = fcntl(fd, F_GETFL);
+  sysCheckError(flags, "Failed to get flags from fd ", fd);
   flags |= O_NONBLOCK;
-  ret = fcntl(fd_, F_SETFL, flags);
-  sysCheckError(
-      ret, "Failed to set non-blocking flags ", flags, " to fd ", fd_);
-  flags = fcntl(fd_, F_GETFD);
-  sysCheckError(flags, "Failed to get flags from fd ", fd_);
+  ret = fcntl(fd, F_SETFL, flags);
+  sysCheckError(ret, "Failed to set non-blocking flags ", flags, " to fd ", fd);
+  flags = fcntl(fd, F_GETFD);
+  sysCheckError(flags, "Failed to get flags from fd ", fd);
   flags |= FD_CLOEXEC;
-  ret = fcntl(fd_, F_SETFD, flags);
+  ret = fcntl(fd, F_SETFD, flags);
   sysCheckError(
-      ret, "Failed to set close-on-exec flags ", flags, " to fd ", fd_);
+      ret, "Failed to set close-on-exec flags ", flags, " to fd ", fd);
+  return fd;
+}
+
+void TunIntf::openFD(const std::vector<folly::EventBase*>& queueEvbs) {
+  // Flags: IFF_TUN   - TUN device (no Ethernet headers)
+  //        IFF_NO_PI - Do not provide packet information
+  const short singleQueue = IFF_TUN | IFF_NO_PI;
+  const short multiQueue = singleQueue | IFF_MULTI_QUEUE;
+  bool isMultiQueue = !queueEvbs.empty();
+  fd_ = attachFD(isMultiQueue ? multiQueue : singleQueue);
+  if (fd_ == -1 && errno == EINVAL) {
+    // A persistent interface keeps the queue mode it was created with, e.g.
+    // by an agent running with a different --tun_multi_queue
+    isMultiQueue = !isMultiQueue;
+    XLOG(WARN) << "Interface " << name_ << " exists in "
+               << (isMultiQueue ? "multi" : "single")
+               << " queue mode, attaching to it in that mode";
+    fd_ = attachFD(isMultiQueue ? multiQueue : singleQueue);
+  }
+  sysCheckError(fd_, "Failed to create/attach interface ", name_);
+  SCOPE_FAIL {
+    closeFD();
+  };
 
-  XLOG(DBG2) << "Create/attach to tun interface " << name_ << " @ fd " << fd_;
+  // Set configured MTU
+  setMtu(mtu_);
+
+  // In multi queue mode, the first queue is fd_ and the rest are attached
+  // here. The kernel spreads flows over them.
+  if (isMultiQueue && !queueEvbs.empty()) {
+    queues_.push_back(std::make_unique<HostQueue>(this, queueEvbs[0], fd_));
+    for (size_t i = 1; i < queueEvbs.size(); ++i) {
+      auto fd = attachFD(multiQueue);
+      sysCheckError(fd, "Failed to attach queue ", i, " to ", name_);
+      queues_.push_back(std::make_unique<HostQueue>(this, queueEvbs[i], fd));
+    }
+  }
+
+  XLOG(DBG2) << "Create/attach to tun interface " << name_ << " @ fd " << fd_
+             << " with " << getNumQueues() << " queue(s)";
 }
 
 void TunIntf::closeFD() noexcept {
+  // Unregister the queues from their threads before closing their fds
+  std::vector<int> queueFds;
+  for (const auto& queue : queues_) {
+    if (queue->getFD() != fd_) {
+      queueFds.push_back(queue->getFD());
+    }
+  }
+  queues_.clear();
+  for (auto queueFd : queueFds) {
+    auto ret = close(queueFd);
+    sysLogError(ret, "Failed to close queue fd ", queueFd, " for ", name_);
+  }
   auto ret = close(fd_);
   sysLogError(ret, "Failed to close fd ", fd_, " for interface ", name_);
   if (ret == 0) {
@@ -314,27 +425,41 @@ void TunIntf::disableIPv6AddrGenMode(int ifIndex) {
 
 void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
   CHECK(fd_ != -1);
+  if (!forwardPacketsFromHost(fd_, spare_, kMaxSentOneTime)) {
+    unregisterHandler();
+  }
+}
 
+bool TunIntf::forwardPacketsFromHost(
+    int fd,
+    std::unique_ptr<TxPacket>& spare,
+    int maxPackets) noexcept {
   // Since this is L3 packet size, we should also reserve some space for L2
   // header, which is 18 bytes (including one vlan tag)
   int sent = 0;
   int dropped = 0;
   uint64_t bytes = 0;
   bool fdFail = false;
+  const int mtu = mtu_;
   try {
-    while (sent + dropped < kMaxSentOneTime) {
-      std::unique_ptr<TxPacket> pkt;
-      pkt = sw_->allocateL3TxPacket(mtu_);
+    while (sent + dropped < maxPackets) {
+      std::unique_ptr<TxPacket> pkt = std::move(spare);
+      if (!pkt || pkt->buf()->tailroom() < mtu) {
+        pkt = sw_->allocateL3TxPacket(mtu);
+      }
       auto buf = pkt->buf();
       int ret = 0;
       do {
-        ret = read(fd_, buf->writableTail(), buf->tailroom());
+        ret = read(fd, buf->writableTail(), buf->tailroom());
       } while (ret == -1 && errno == EINTR);
       if (ret < 0) {
         if (errno != EAGAIN) {
-          sysLogError(ret, "Failed to read on ", fd_);
+          sysLogError(ret, "Failed to read on ", fd);
           // Cannot continue read on this fd
           fdFail = true;
+        } else {
+          // Nothing was read into it, keep it for the next wakeup
+          spare = std::move(pkt);
         }
         break;
       } else if (ret == 0) {
@@ -361,16 +486,13 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
                              << folly::exceptionStr(ex);
   }
 
-  if (fdFail) {
-    unregisterHandler();
-  }
-
   XLOG(DBG4) << "Forwarded " << sent << " packets (" << bytes
-             << " bytes) from host @ fd " << fd_ << " for interface " << name_;
+             << " bytes) from host @ fd " << fd << " for interface " << name_;
   if (dropped) {
-    XLOG(DBG3) << "Dropped " << dropped << " packets from host @ fd " << fd_
+    XLOG(DBG3) << "Dropped " << dropped << " packets from host @ fd " << fd
                << " for interface " << name_;
   }
+  return !fdFail;
 }
 
 bool TunIntf::sendPacketToHost(std::unique_ptr<RxPacket> pkt) {
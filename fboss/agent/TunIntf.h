@@ -15,10 +15,15 @@
 #include "fboss/agent/state/StateUtils.h"
 #include "fboss/agent/types.h"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 namespace facebook::fboss {
 
 class SwSwitch;
 class RxPacket;
+class TxPacket;
 
 class TunIntf : private folly::EventHandler {
  public:
@@ -27,13 +32,19 @@ class TunIntf : private folly::EventHandler {
    * status is set to `false` for discovered interfaces because we do not
    * have real port-status info. Once initial config is applied in TunManager
    * their actual status will be reflected.
+   *
+   * If queueEvbs is not empty, the interface is opened with IFF_MULTI_QUEUE
+   * and one queue is attached per EventBase. Packets from the kernel are
+   * then read on those EventBases instead of evb. Interfaces that already
+   * exist in single queue mode keep being served from evb.
    */
   TunIntf(
       SwSwitch* sw,
       folly::EventBase* evb,
       InterfaceID ifID,
       int ifIndex /* linux */,
-      int mtu);
+      int mtu,
+      const std::vector<folly::EventBase*>& queueEvbs = {});
 
   /**
    * This version of constructor creates a Tun interface in Linux as well.
@@ -44,7 +55,8 @@ class TunIntf : private folly::EventHandler {
       InterfaceID ifID, // Switch interface ID
       bool status,
       const Interface::Addresses& addrs,
-      int mtu);
+      int mtu,
+      const std::vector<folly::EventBase*>& queueEvbs = {});
 
   ~TunIntf() override;
 
@@ -123,20 +135,46 @@ class TunIntf : private folly::EventHandler {
     return status_;
   }
 
+  size_t getNumQueues() const {
+    return queues_.empty() ? 1 : queues_.size();
+  }
+
  private:
+  class HostQueue;
+
   /**
    * Callback for event on Tun interface's read socket-fd
    * Override's folly::EventHandler handlerReady callback.
    */
   void handlerReady(uint16_t events) noexcept override;
 
+  /**
+   * Read up to maxPackets packets from fd and forward them to the switch.
+   * spare holds a TX packet left over from the previous call, so the read
+   * that finds the queue empty does not cost an allocation.
+   *
+   * @return false if the fd cannot be read from anymore
+   */
+  bool forwardPacketsFromHost(
+      int fd,
+      std::unique_ptr<TxPacket>& spare,
+      int maxPackets) noexcept;
+
   /**
    * Open/Close a new socket-fd to read/write data from Tun interface.
-   * fd_ is mutated.
+   * fd_ is mutated. With queueEvbs, extra queues are opened and attached to
+   * the interface too.
    */
-  void openFD();
+  void openFD(const std::vector<folly::EventBase*>& queueEvbs = {});
   void closeFD() noexcept;
 
+  /**
+   * Open a file descriptor on /dev/net/tun and attach it to this interface.
+   * Returns -1 with errno set if the interface cannot be attached with the
+   * given flags.
+   */
+  int attachFD(short flags);
+
   /**
    * In newer kernel an interface is automatically gets link-local IPv6 address
    * because of IPv6 autoconf and FBOSS (we) assign one more.
@@ -162,7 +200,15 @@ class TunIntf : private folly::EventHandler {
    * be received from or sent to.
    */
   int fd_{-1};
-  int mtu_{-1};
+  // Read from the queue threads as well
+  std::atomic<int> mtu_{-1};
+
+  // TX packet kept for the next read on fd_
+  std::unique_ptr<TxPacket> spare_;
+
+  // IFF_MULTI_QUEUE queues, the first one reading fd_. Empty in single
+  // queue mode.
+  std::vector<std::unique_ptr<HostQueue>> queues_;
 };
 
 } // namespace facebook::fboss
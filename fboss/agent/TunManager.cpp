@@ -18,6 +18,7 @@ extern "C" {
 #include <sys/ioctl.h>
 }
 
+#include <folly/Conv.h>
 #include <folly/MapUtil.h>
 #include <folly/lang/CString.h>
 #include <folly/logging/xlog.h>
@@ -33,6 +34,17 @@ extern "C" {
 
 #include <boost/container/flat_set.hpp>
 
+DEFINE_bool(
+    tun_multi_queue,
+    false,
+    "Open tun interfaces with IFF_MULTI_QUEUE and read packets from the "
+    "kernel on --tun_num_queues threads");
+DEFINE_int32(
+    tun_num_queues,
+    4,
+    "Number of queues, and threads reading them, per tun interface "
+    "with --tun_multi_queue");
+
 namespace {
 const int kDefaultMtu = 1500;
 }
@@ -51,6 +63,14 @@ TunManager::TunManager(SwSwitch* sw, FbossEventBase* evb) : sw_(sw), evb_(evb) {
   }
   auto error = nl_connect(sock_, NETLINK_ROUTE);
   nlCheckError(error, "failed to connect netlink socket to NETLINK_ROUTE");
+
+  if (FLAGS_tun_multi_queue) {
+    for (auto i = 0; i < std::max(FLAGS_tun_num_queues, 1); ++i) {
+      queueThreads_.push_back(std::make_unique<folly::ScopedEventBaseThread>(
+          folly::to<std::string>("TunQueue", i)));
+      queueEvbs_.push_back(queueThreads_.back()->getEventBase());
+    }
+  }
 }
 
 void TunManager::stopProcessing() {
@@ -110,7 +130,8 @@ void TunManager::addExistingIntf(const std::string& ifName, int ifIndex) {
     intfs_.erase(ret.first);
   };
   ret.first->second.reset(
-      new TunIntf(sw_, evb_, ifID, ifIndex, getInterfaceMtu(ifID)));
+      new TunIntf(
+          sw_, evb_, ifID, ifIndex, getInterfaceMtu(ifID), queueEvbs_));
 }
 
 void TunManager::addNewIntf(
@@ -126,7 +147,7 @@ void TunManager::addNewIntf(
     intfs_.erase(ret.first);
   };
   auto intf = std::make_unique<TunIntf>(
-      sw_, evb_, ifID, isUp, addrs, getInterfaceMtu(ifID));
+      sw_, evb_, ifID, isUp, addrs, getInterfaceMtu(ifID), queueEvbs_);
 
   SCOPE_FAIL {
     intf->setDelete();
@@ -15,6 +15,7 @@
 #include "fboss/agent/types.h"
 
 #include <boost/container/flat_map.hpp>
+#include <folly/io/async/ScopedEventBaseThread.h>
 
 extern "C" {
 #include <netlink/object.h>
@@ -226,6 +227,11 @@ class TunManager : public StateObserver {
   // Netlink socket for managing interface/addresses in Host/Linux
   nl_sock* sock_{nullptr};
 
+  // Threads reading the queues of every tun interface with
+  // --tun_multi_queue. Declared before intfs_ so that they outlive it.
+  std::vector<std::unique_ptr<folly::ScopedEventBaseThread>> queueThreads_;
+  std::vector<folly::EventBase*> queueEvbs_;
+
   /**
    * The mutex used to protect `intfs_` which can be used by
    * sync() could manipulate intfs_. Called on the thread that serves evb_.
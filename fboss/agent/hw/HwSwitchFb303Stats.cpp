@@ -21,6 +21,33 @@ namespace {
 void updateValue(TLTimeseries& counter, int64_t value) {
   counter.addValue(value - facebook::fboss::getCumulativeValue(counter));
 }
+
+std::string stateUpdateStageName(
+    facebook::fboss::HwSwitchFb303Stats::StateUpdateStage stage) {
+  using StateUpdateStage =
+      facebook::fboss::HwSwitchFb303Stats::StateUpdateStage;
+  switch (stage) {
+    case StateUpdateStage::SWITCH_SETTINGS:
+      return "switch_settings";
+    case StateUpdateStage::REMOVED_OBJECTS:
+      return "removed_objects";
+    case StateUpdateStage::PORTS:
+      return "ports";
+    case StateUpdateStage::L2:
+      return "l2";
+    case StateUpdateStage::INTERFACES_AND_NEIGHBORS:
+      return "interfaces_and_neighbors";
+    case StateUpdateStage::ROUTES:
+      return "routes";
+    case StateUpdateStage::FORWARDING_FEATURES:
+      return "forwarding_features";
+    case StateUpdateStage::ACLS:
+      return "acls";
+    case StateUpdateStage::POST_UPDATE:
+      return "post_update";
+  }
+  return "unknown";
+}
 } // namespace
 
 namespace facebook::fboss {
@@ -214,7 +241,18 @@ HwSwitchFb303Stats::HwSwitchFb303Stats(
           map,
           getCounterPrefix() + "phy_info_collection_failed",
           SUM,
-          RATE) {}
+          RATE) {
+  for (size_t i = 0; i < kNumStateUpdateStages; ++i) {
+    // 10ms buckets, up to 10s
+    stateUpdateStageTimeUs_[i] = std::make_unique<TLHistogram>(
+        map,
+        getCounterPrefix() + vendor + ".state_update." +
+            stateUpdateStageName(static_cast<StateUpdateStage>(i)) + ".us",
+        10000,
+        0,
+        10000000);
+  }
+}
 
 void HwSwitchFb303Stats::update(const HwSwitchDropStats& dropStats) {
   if (dropStats.globalDrops().has_value()) {
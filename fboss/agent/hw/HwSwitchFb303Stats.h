@@ -14,6 +14,9 @@
 #include <folly/ThreadLocal.h>
 #include "fboss/agent/hw/gen-cpp2/hardware_stats_types.h"
 
+#include <array>
+#include <memory>
+
 namespace facebook::fboss {
 
 class HwSwitchFb303Stats {
@@ -21,6 +24,26 @@ class HwSwitchFb303Stats {
   using ThreadLocalStatsMap =
       fb303::ThreadCachedServiceData::ThreadLocalStatsMap;
 
+  /*
+   * Stages of programming a state delta, in the order HwSwitch applies
+   * them, one after another. Objects in a stage may depend on objects added
+   * by any earlier stage, and must be removed before the objects they
+   * depend on.
+   */
+  enum class StateUpdateStage {
+    SWITCH_SETTINGS,
+    REMOVED_OBJECTS,
+    PORTS,
+    L2,
+    INTERFACES_AND_NEIGHBORS,
+    ROUTES,
+    FORWARDING_FEATURES,
+    ACLS,
+    POST_UPDATE,
+  };
+  static constexpr size_t kNumStateUpdateStages =
+      static_cast<size_t>(StateUpdateStage::POST_UPDATE) + 1;
+
   HwSwitchFb303Stats(
       ThreadLocalStatsMap* map,
       const std::string& vendor,
@@ -98,6 +121,9 @@ class HwSwitchFb303Stats {
   void statsCollectionFailed() {
     hwStatsCollectionFailed_.addValue(1);
   }
+  void stateUpdateStageTime(StateUpdateStage stage, uint64_t us) {
+    stateUpdateStageTimeUs_[static_cast<size_t>(stage)]->addValue(us);
+  }
   void phyInfoCollectionFailed() {
     phyInfoCollectionFailed_.addValue(1);
   }
@@ -257,6 +283,9 @@ class HwSwitchFb303Stats {
   // info collection failures
   TLTimeseries hwStatsCollectionFailed_;
   TLTimeseries phyInfoCollectionFailed_;
+  // Time spent programming each stage of a state delta
+  std::array<std::unique_ptr<TLHistogram>, kNumStateUpdateStages>
+      stateUpdateStageTimeUs_;
 };
 
 } // namespace facebook::fboss
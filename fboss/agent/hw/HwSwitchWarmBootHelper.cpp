@@ -19,6 +19,7 @@
 #include <folly/FileUtil.h>
 #include <folly/json/json.h>
 #include <folly/logging/xlog.h>
+#include <sys/stat.h>
 #include <optional>
 #include <tuple>
 #include "fboss/lib/CommonFileUtils.h"
@@ -80,6 +81,10 @@ std::string HwSwitchWarmBootHelper::warmBootHwSwitchStateFile() const {
       warmBootDir_, "/", FLAGS_switch_state_file, "_", switchId_);
 }
 
+std::string HwSwitchWarmBootHelper::warmBootHwSwitchBinaryStateFile() const {
+  return folly::to<std::string>(warmBootHwSwitchStateFile(), ".bin");
+}
+
 std::string HwSwitchWarmBootHelper::warmBootThriftSwitchStateFile() const {
   // TODO(pshaikh): delete this method when SwSwitch loads switch state and
   // seeds HwSwitch
@@ -157,6 +162,42 @@ void HwSwitchWarmBootHelper::storeHwSwitchWarmBootState(
   setCanWarmBoot();
 }
 
+void HwSwitchWarmBootHelper::storeHwSwitchBinaryWarmBootState(
+    const std::string& switchState) {
+  auto fileName = warmBootHwSwitchBinaryStateFile();
+  if (!folly::writeFile(switchState, fileName.c_str())) {
+    // Not fatal, the JSON state is still there to warm boot from
+    XLOG(ERR) << "Error while storing binary switch state to file: "
+              << fileName;
+    removeFile(fileName);
+  }
+}
+
+std::optional<std::string>
+HwSwitchWarmBootHelper::getHwSwitchBinaryWarmBootState() const {
+  auto fileName = warmBootHwSwitchBinaryStateFile();
+  struct stat binaryStat;
+  struct stat jsonStat;
+  if (stat(fileName.c_str(), &binaryStat) != 0 ||
+      stat(warmBootHwSwitchStateFile().c_str(), &jsonStat) != 0) {
+    return std::nullopt;
+  }
+  if (std::tie(binaryStat.st_mtim.tv_sec, binaryStat.st_mtim.tv_nsec) <
+      std::tie(jsonStat.st_mtim.tv_sec, jsonStat.st_mtim.tv_nsec)) {
+    XLOG(WARN) << "Ignoring binary hw switch warm boot state " << fileName
+               << ", it is older than the JSON state";
+    return std::nullopt;
+  }
+  std::string switchState;
+  XLOG(INFO) << "reading hw switch warm boot state from : " << fileName;
+  if (!folly::readFile(fileName.c_str(), switchState)) {
+    XLOG(WARN) << "Unable to read binary hw switch warm boot state from : "
+               << fileName;
+    return std::nullopt;
+  }
+  return switchState;
+}
+
 folly::dynamic HwSwitchWarmBootHelper::getHwSwitchWarmBootState() const {
   bool wbStateFileExists = checkFileExists(warmBootHwSwitchStateFile());
   if (wbStateFileExists) {
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <folly/json/dynamic.h>
+#include <optional>
 #include <string>
 #include "fboss/agent/gen-cpp2/switch_state_types.h"
 
@@ -40,6 +41,15 @@ class HwSwitchWarmBootHelper {
 
   folly::dynamic getHwSwitchWarmBootState() const;
 
+  /*
+   * Optional binary warm boot state, stored after the JSON state. It is only
+   * returned if it is not older than the JSON state, so one left behind by
+   * an agent that stored only JSON state since is ignored.
+   * used only in sai
+   */
+  void storeHwSwitchBinaryWarmBootState(const std::string& switchState);
+  std::optional<std::string> getHwSwitchBinaryWarmBootState() const;
+
   // bcm switch specific
   std::string startupSdkDumpFile() const;
   // bcm switch specific
@@ -71,6 +81,7 @@ class HwSwitchWarmBootHelper {
   std::string warmBootFlag() const;
   std::string forceColdBootOnceFlag() const;
   std::string warmBootHwSwitchStateFile() const;
+  std::string warmBootHwSwitchBinaryStateFile() const;
   std::string warmBootThriftSwitchStateFile() const;
 
   void setupWarmBootFile();
@@ -30,6 +30,7 @@
 #include "fboss/lib/FunctionCallTimeReporter.h"
 #include "fboss/lib/platforms/PlatformMode.h"
 
+#include <folly/json/json.h>
 #include <folly/logging/xlog.h>
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 
@@ -297,6 +298,21 @@ void initandExitBenchmarkHelper(
     }
   }
   suspender.rehire();
+  if (ensemble->getSw()->getBootType() == BootType::WARM_BOOT) {
+    // Break warm boot init time down by object type reload time
+    folly::dynamic reloadTimesJson = folly::dynamic::object;
+    for (const auto& [objectType, reloadTime] :
+         ensemble->getHwSwitch()->getObjectReloadTimes()) {
+      reloadTimesJson[objectType] = reloadTime.count();
+    }
+    if (FLAGS_json) {
+      folly::dynamic json = folly::dynamic::object;
+      json["sai_store_reload_usecs"] = std::move(reloadTimesJson);
+      std::cout << toPrettyJson(json) << std::endl;
+    } else {
+      XLOG(DBG2) << "Object reload usecs: " << folly::toJson(reloadTimesJson);
+    }
+  }
   // Fabric switch does not support route programming
   if (switchType != cfg::SwitchType::FABRIC) {
     auto routeChunks = getRoutes(ensemble.get());
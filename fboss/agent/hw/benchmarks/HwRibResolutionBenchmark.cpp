@@ -21,9 +21,20 @@
 #include <folly/Benchmark.h>
 #include <folly/logging/xlog.h>
 
+#include <thread>
+#include <vector>
+
 namespace facebook::fboss {
 
-BENCHMARK(RibResolutionBenchmark) {
+/*
+ * Program the route scale split across numVrfs VRFs, with one update client
+ * per VRF. The total number of routes is the same for any numVrfs, so results
+ * are comparable across VRF counts. Each VRF is given its own copy of VRF 0's
+ * interface routes so that routes resolve identically in every VRF, and its
+ * own SwitchState cookie so FIB computation for different VRFs does not
+ * contend.
+ */
+void ribResolutionBenchmark(int numVrfs) {
   folly::BenchmarkSuspender suspender;
   std::unique_ptr<AgentEnsemble> ensemble{};
 
@@ -38,31 +49,70 @@ BENCHMARK(RibResolutionBenchmark) {
   auto ports = ensemble->masterLogicalPortIds();
 
   utility::THAlpmRouteScaleGenerator gen(ensemble->getSw()->getState());
-  const auto& routeChunks = gen.getThriftRoutes();
+  // Deal each chunk's routes out to the VRFs, keeping the chunking
+  std::vector<utility::RouteDistributionGenerator::ThriftRouteChunks>
+      vrfRouteChunks(numVrfs);
+  for (const auto& routeChunk : gen.getThriftRoutes()) {
+    std::vector<utility::RouteDistributionGenerator::ThriftRouteChunk>
+        vrfChunks(numVrfs);
+    for (size_t i = 0; i < routeChunk.size(); ++i) {
+      vrfChunks[i % numVrfs].push_back(routeChunk[i]);
+    }
+    for (auto vrf = 0; vrf < numVrfs; ++vrf) {
+      if (!vrfChunks[vrf].empty()) {
+        vrfRouteChunks[vrf].push_back(std::move(vrfChunks[vrf]));
+      }
+    }
+  }
+  auto ribThrift = ensemble->getSw()->getRib()->toThrift();
+  for (auto vrf = 1; vrf < numVrfs; ++vrf) {
+    ribThrift[vrf] = ribThrift.at(0);
+  }
   // Create a dummy rib since we don't want to go through
   // HwSwitchEnsemble and write to HW
-  auto rib = RoutingInformationBase::fromThrift(
-      ensemble->getSw()->getRib()->toThrift(), nullptr, nullptr);
-  auto switchState = ensemble->getProgrammedState();
+  auto prevVrfUpdateThreads = FLAGS_rib_vrf_update_threads;
+  FLAGS_rib_vrf_update_threads = numVrfs > 1 ? numVrfs : 0;
+  auto rib = RoutingInformationBase::fromThrift(ribThrift, nullptr, nullptr);
+  FLAGS_rib_vrf_update_threads = prevVrfUpdateThreads;
+  std::vector<std::shared_ptr<SwitchState>> switchStates(
+      numVrfs, ensemble->getProgrammedState());
+  auto resolver = ensemble->getSw()->getScopeResolver();
+  auto programVrf = [&](int vrf) {
+    for (const auto& routeChunk : vrfRouteChunks[vrf]) {
+      rib->update(
+          resolver,
+          RouterID(vrf),
+          ClientID::BGPD,
+          AdminDistance::EBGP,
+          routeChunk,
+          {},
+          false,
+          "resolution only",
+          ribToSwitchStateUpdate,
+          static_cast<void*>(&switchStates[vrf]));
+    }
+  };
   suspender.dismiss();
-  std::for_each(
-      routeChunks.begin(),
-      routeChunks.end(),
-      [&switchState, &rib, resolver = ensemble->getSw()->getScopeResolver()](
-          const auto& routeChunk) {
-        rib->update(
-            resolver,
-            RouterID(0),
-            ClientID::BGPD,
-            AdminDistance::EBGP,
-            routeChunk,
-            {},
-            false,
-            "resolution only",
-            ribToSwitchStateUpdate,
-            static_cast<void*>(&switchState));
-      });
+  std::vector<std::thread> vrfClients;
+  for (auto vrf = 0; vrf < numVrfs; ++vrf) {
+    vrfClients.emplace_back(programVrf, vrf);
+  }
+  for (auto& vrfClient : vrfClients) {
+    vrfClient.join();
+  }
   suspender.rehire();
 }
 
+BENCHMARK(RibResolutionBenchmark) {
+  ribResolutionBenchmark(1);
+}
+
+BENCHMARK(RibResolutionBenchmark4Vrfs) {
+  ribResolutionBenchmark(4);
+}
+
+BENCHMARK(RibResolutionBenchmark16Vrfs) {
+  ribResolutionBenchmark(16);
+}
+
 } // namespace facebook::fboss
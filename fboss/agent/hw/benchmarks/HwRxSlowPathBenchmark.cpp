@@ -34,6 +34,14 @@
 #include <iostream>
 #include <thread>
 
+DEFINE_bool(
+    rx_slow_path_mixed_protocols,
+    false,
+    "Mix DHCPv6 packets into the trapped packet storm, so RX dispatch "
+    "classes compete for the CPU");
+
+DECLARE_bool(rx_dispatch);
+
 namespace facebook::fboss {
 
 const std::string kDstIp = "2620:0:1cfe:face:b00c::4";
@@ -103,8 +111,16 @@ BENCHMARK(RxSlowPathBenchmark) {
   const auto kSrcMac = folly::MacAddress{"fa:ce:b0:00:00:0c"};
   // Send packet
   auto vlanId = utility::firstVlanID(ensemble->getProgrammedState());
+  // L4 ports of the packets looping through the trap ACL. The mixed storm
+  // alternates plain UDP with DHCPv6 client and server packets.
+  std::vector<std::pair<uint16_t, uint16_t>> l4Ports = {{8000, 8001}};
+  if (FLAGS_rx_slow_path_mixed_protocols) {
+    l4Ports.emplace_back(546, 547);
+    l4Ports.emplace_back(547, 546);
+  }
   auto constexpr kPacketToSend = 10;
-  for (int i = 0; i < kPacketToSend; i++) {
+  for (size_t i = 0; i < kPacketToSend * l4Ports.size(); i++) {
+    const auto& [srcPort, dstPort] = l4Ports[i % l4Ports.size()];
     auto txPacket = utility::makeUDPTxPacket(
         ensemble->getSw(),
         vlanId,
@@ -112,8 +128,8 @@ BENCHMARK(RxSlowPathBenchmark) {
         dstMac,
         folly::IPAddressV6("2620:0:1cfe:face:b00c::3"),
         folly::IPAddressV6(kDstIp),
-        8000,
-        8001);
+        srcPort,
+        dstPort);
     ensemble->getSw()->sendPacketSwitchedAsync(std::move(txPacket));
   }
 
@@ -148,11 +164,15 @@ BENCHMARK(RxSlowPathBenchmark) {
     folly::dynamic cpuRxRateJson = folly::dynamic::object;
     cpuRxRateJson["cpu_rx_pps"] = pps;
     cpuRxRateJson["cpu_rx_bytes_per_sec"] = bytesPerSec;
+    cpuRxRateJson["mixed_protocols"] = FLAGS_rx_slow_path_mixed_protocols;
+    cpuRxRateJson["rx_dispatch"] = FLAGS_rx_dispatch;
     std::cout << toPrettyJson(cpuRxRateJson) << std::endl;
   } else {
     XLOG(DBG2) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
                << " interval ms: " << durationMillseconds.count()
-               << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+               << " pps: " << pps << " bytes per sec: " << bytesPerSec
+               << " mixed protocols: " << FLAGS_rx_slow_path_mixed_protocols
+               << " rx dispatch: " << FLAGS_rx_dispatch;
   }
 }
 } // namespace facebook::fboss
@@ -20,10 +20,36 @@
 
 #include <folly/Benchmark.h>
 #include <folly/IPAddress.h>
+#include <folly/json/dynamic.h>
+#include <folly/json/json.h>
 #include <folly/logging/xlog.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
 namespace facebook::fboss {
 
+namespace {
+// Summarize per pass samples, in microseconds
+folly::dynamic summarize(std::vector<int64_t> samples) {
+  folly::dynamic summary = folly::dynamic::object;
+  if (samples.empty()) {
+    return summary;
+  }
+  std::sort(samples.begin(), samples.end());
+  int64_t total = 0;
+  for (auto sample : samples) {
+    total += sample;
+  }
+  summary["avg_us"] = total / static_cast<int64_t>(samples.size());
+  summary["p50_us"] = samples[samples.size() / 2];
+  summary["p99_us"] = samples[samples.size() * 99 / 100];
+  summary["max_us"] = samples.back();
+  return summary;
+}
+} // namespace
+
 RouteNextHopSet makeNextHops(std::vector<std::string> ipsAsStrings) {
   RouteNextHopSet nhops;
   for (const std::string& ipAsString : ipsAsStrings) {
@@ -152,11 +178,32 @@ BENCHMARK(HwStatsCollection) {
     updater.program();
   }
 
+  // Besides total time, report how long each pass takes and how long it
+  // blocks state updates by holding the switch lock
+  std::vector<int64_t> passUs, lockHoldUs;
+  passUs.reserve(iterations);
+  lockHoldUs.reserve(iterations);
   suspender.dismiss();
   for (auto i = 0; i < iterations; ++i) {
+    auto start = std::chrono::steady_clock::now();
     ensemble->getSw()->updateStats();
+    passUs.push_back(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+    lockHoldUs.push_back(
+        ensemble->getHwSwitch()->getLastStatsCollectionLockHoldTime().count());
   }
   suspender.rehire();
+
+  folly::dynamic statsCollectionJson = folly::dynamic::object;
+  statsCollectionJson["pass"] = summarize(std::move(passUs));
+  statsCollectionJson["lock_hold"] = summarize(std::move(lockHoldUs));
+  if (FLAGS_json) {
+    std::cout << toPrettyJson(statsCollectionJson) << std::endl;
+  } else {
+    XLOG(DBG2) << "Stats collection: " << folly::toJson(statsCollectionJson);
+  }
 }
 
 } // namespace facebook::fboss
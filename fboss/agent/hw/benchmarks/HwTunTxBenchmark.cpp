@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/test/ConfigFactory.h"
+#include "fboss/agent/test/EcmpSetupHelper.h"
+
+#include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
+#include "fboss/agent/benchmarks/AgentBenchmarks.h"
+#include "fboss/agent/state/StateUtils.h"
+
+#include <folly/IPAddressV6.h>
+#include <folly/SocketAddress.h>
+#include <folly/json/dynamic.h>
+#include <folly/json/json.h>
+
+#include <folly/Benchmark.h>
+#include <folly/logging/xlog.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+DECLARE_bool(tun_intf);
+DECLARE_bool(tun_multi_queue);
+
+DEFINE_int32(tun_tx_threads, 4, "Number of threads writing to the tun intf");
+
+namespace facebook::fboss {
+
+namespace {
+
+std::pair<uint64_t, uint64_t> getTunOutPktsAndBytes(
+    AgentEnsemble* ensemble,
+    PortID port) {
+  auto stats = ensemble->getLatestPortStats(port);
+  return {*stats.outUnicastPkts_(), *stats.outBytes_()};
+}
+
+/*
+ * Host originated traffic towards a resolved next hop, written by
+ * --tun_tx_threads sockets bound to its tun interface. Every packet is read
+ * from the tun interface by the agent and sent out through sendL3Packet, so
+ * the port TX rate is the rate at which the agent drains the tun interface.
+ */
+void runTunTxBenchmark(bool multiQueue) {
+  constexpr int kEcmpWidth = 1;
+  FLAGS_tun_intf = true;
+  FLAGS_tun_multi_queue = multiQueue;
+
+  AgentEnsembleSwitchConfigFn initialConfigFn =
+      [](const AgentEnsemble& ensemble) {
+        auto ports = ensemble.masterLogicalPortIds();
+        CHECK_GT(ports.size(), 0);
+        return utility::onePortPerInterfaceConfig(ensemble.getSw(), ports);
+      };
+  auto ensemble =
+      createAgentEnsemble(initialConfigFn, false /*disableLinkStateToggler*/);
+
+  auto ecmpHelper = utility::EcmpSetupAnyNPorts6(ensemble->getSw()->getState());
+  auto portDesc = ecmpHelper.ecmpPortDescriptorAt(0);
+  auto portUsed = portDesc.phyPortID();
+  ensemble->applyNewState([&](const std::shared_ptr<SwitchState>& in) {
+    return ecmpHelper.resolveNextHops(in, kEcmpWidth);
+  });
+  ecmpHelper.programRoutes(
+      std::make_unique<SwSwitchRouteUpdateWrapper>(
+          ensemble->getSw(), ensemble->getSw()->getRib()),
+      kEcmpWidth);
+  auto nhop = ecmpHelper.nhop(portDesc);
+  auto tunIntfName = utility::createTunIntfName(nhop.intf);
+
+  std::atomic<bool> packetTxDone{false};
+  std::vector<std::thread> senders;
+  for (auto i = 0; i < std::max(FLAGS_tun_tx_threads, 1); ++i) {
+    // Distinct source ports spread the flows over the tun queues
+    senders.emplace_back([&packetTxDone, &tunIntfName, &nhop, i]() {
+      auto fd = socket(AF_INET6, SOCK_DGRAM, 0);
+      CHECK_GE(fd, 0) << "Failed to open UDP socket";
+      CHECK_EQ(
+          setsockopt(
+              fd,
+              SOL_SOCKET,
+              SO_BINDTODEVICE,
+              tunIntfName.c_str(),
+              tunIntfName.size()),
+          0)
+          << "Failed to bind UDP socket to " << tunIntfName;
+      folly::SocketAddress dst(nhop.ip, 8000 + i);
+      sockaddr_storage addr;
+      auto addrLen = dst.getAddress(&addr);
+      std::array<char, 64> payload{};
+      while (!packetTxDone) {
+        for (auto pkt = 0; pkt < 1'000; ++pkt) {
+          sendto(
+              fd,
+              payload.data(),
+              payload.size(),
+              0,
+              reinterpret_cast<sockaddr*>(&addr),
+              addrLen);
+        }
+      }
+      close(fd);
+    });
+  }
+
+  auto [pktsBefore, bytesBefore] =
+      getTunOutPktsAndBytes(ensemble.get(), PortID(portUsed));
+  auto timeBefore = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::seconds(30));
+  packetTxDone = true;
+  for (auto& sender : senders) {
+    sender.join();
+  }
+  auto timeAfter = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::milli> durationMillseconds =
+      timeAfter - timeBefore;
+  auto pktsAfter = pktsBefore;
+  auto bytesAfter = bytesBefore;
+  auto kMaxIterations = 30;
+  // Wait for the agent to drain the tun queues and for stats to settle
+  for (auto i = 0; i < kMaxIterations; ++i) {
+    auto pktsPrior = pktsAfter;
+    auto bytesPrior = bytesAfter;
+    std::tie(pktsAfter, bytesAfter) =
+        getTunOutPktsAndBytes(ensemble.get(), PortID(portUsed));
+    if (pktsPrior == pktsAfter && bytesPrior == bytesAfter) {
+      break;
+    }
+    XLOG(INFO) << " Stats still incrementing after iteration: " << i + 1;
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+  uint32_t pps = (static_cast<double>(pktsAfter - pktsBefore) /
+                  durationMillseconds.count()) *
+      1000;
+  uint32_t bytesPerSec = (static_cast<double>(bytesAfter - bytesBefore) /
+                          durationMillseconds.count()) *
+      1000;
+
+  if (FLAGS_json) {
+    folly::dynamic tunTxRateJson = folly::dynamic::object;
+    tunTxRateJson["tun_tx_pps"] = pps;
+    tunTxRateJson["tun_tx_bytes_per_sec"] = bytesPerSec;
+    tunTxRateJson["tun_multi_queue"] = multiQueue;
+    std::cout << toPrettyJson(tunTxRateJson) << std::endl;
+  } else {
+    XLOG(DBG2) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
+               << " interval ms: " << durationMillseconds.count()
+               << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+  }
+}
+
+} // namespace
+
+BENCHMARK(runTunTxSingleQueueBenchmark) {
+  runTunTxBenchmark(false /* multiQueue */);
+}
+
+BENCHMARK(runTunTxMultiQueueBenchmark) {
+  runTunTxBenchmark(true /* multiQueue */);
+}
+
+} // namespace facebook::fboss
@@ -21,6 +21,7 @@
 #include <folly/logging/xlog.h>
 
 #include <iterator>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -142,6 +143,40 @@ class RouteApi : public SaiApi<RouteApi> {
       const sai_attribute_t* attr) const {
     return api_->set_route_entry_attribute(routeEntry.entry(), attr);
   }
+  sai_status_t _bulkCreate(
+      const SaiRouteTraits::RouteEntry* routeEntries,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* retStatus,
+      size_t objectCount) const {
+    std::vector<sai_route_entry_t> entries;
+    entries.reserve(objectCount);
+    for (size_t idx = 0; idx < objectCount; idx++) {
+      entries.push_back(*routeEntries[idx].entry());
+    }
+    return api_->create_route_entries(
+        objectCount,
+        entries.data(),
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        retStatus);
+  }
+  sai_status_t _bulkRemove(
+      const SaiRouteTraits::RouteEntry* routeEntries,
+      sai_status_t* retStatus,
+      size_t objectCount) const {
+    std::vector<sai_route_entry_t> entries;
+    entries.reserve(objectCount);
+    for (size_t idx = 0; idx < objectCount; idx++) {
+      entries.push_back(*routeEntries[idx].entry());
+    }
+    return api_->remove_route_entries(
+        objectCount,
+        entries.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        retStatus);
+  }
 
   sai_route_api_t* api_;
   friend class SaiApi<RouteApi>;
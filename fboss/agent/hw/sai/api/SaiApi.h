@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <exception>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -172,6 +173,137 @@ class SaiApi {
     XLOGF(DBG5, "removed SAI object: {}", key);
   }
 
+  /*
+   * Bulk create and remove for objects whose AdapterKey is an entry struct
+   * (routes, neighbors, ...). All objects are programmed in a single SAI
+   * call, taking the api lock once, instead of one call per object.
+   *
+   * bulkCreate is all or nothing: if any object fails to be created, the
+   * ones that were created are removed again before throwing, so callers
+   * don't need to track partially programmed batches.
+   */
+  template <typename SaiObjectTraits>
+  std::enable_if_t<AdapterKeyIsEntryStruct<SaiObjectTraits>::value, void>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& entries,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes) const {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    CHECK_EQ(entries.size(), createAttributes.size());
+    if (UNLIKELY(skipHwWrites()) || entries.empty()) {
+      return;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk create of {} SAI objs, while hw writes are blocked",
+          entries.size());
+    }
+    if (UNLIKELY(logFailHwWrites())) {
+      XLOGF(
+          WARNING,
+          "Attempting bulk create of {} SAI objs, while hw writes are not expected",
+          entries.size());
+    }
+    std::vector<std::vector<sai_attribute_t>> saiAttributeTs;
+    std::vector<uint32_t> attrCounts;
+    std::vector<const sai_attribute_t*> attrLists;
+    saiAttributeTs.reserve(entries.size());
+    attrCounts.reserve(entries.size());
+    attrLists.reserve(entries.size());
+    for (const auto& attributes : createAttributes) {
+      saiAttributeTs.push_back(saiAttrs(attributes));
+      attrCounts.push_back(saiAttributeTs.back().size());
+      attrLists.push_back(saiAttributeTs.back().data());
+    }
+    std::vector<sai_status_t> retStatus(
+        entries.size(), SAI_STATUS_NOT_EXECUTED);
+    auto g{SaiApiLock::getInstance()->lock()};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkCreate(
+          entries.data(),
+          attrCounts.data(),
+          attrLists.data(),
+          retStatus.data(),
+          entries.size());
+    }
+    if (status != SAI_STATUS_SUCCESS) {
+      std::optional<size_t> failed;
+      for (size_t idx = 0; idx < entries.size(); idx++) {
+        if (retStatus[idx] == SAI_STATUS_SUCCESS) {
+          // undo, so either all or none of the batch is programmed
+          auto removeStatus = impl()._remove(entries[idx]);
+          if (removeStatus != SAI_STATUS_SUCCESS) {
+            XLOGF(
+                ERR,
+                "Failed to remove {} after failed bulk create: {}",
+                entries[idx],
+                removeStatus);
+          }
+        } else if (!failed && retStatus[idx] != SAI_STATUS_NOT_EXECUTED) {
+          failed = idx;
+        }
+      }
+      if (failed) {
+        saiApiCheckError(
+            retStatus[*failed],
+            apiType(),
+            fmt::format(
+                "Failed to bulk create sai entity: {}: {}",
+                entries[*failed],
+                createAttributes[*failed]));
+      }
+      saiApiCheckError(
+          status,
+          apiType(),
+          fmt::format("Failed to bulk create {} sai entities", entries.size()));
+    }
+    XLOGF(DBG5, "bulk created {} SAI objects", entries.size());
+  }
+
+  template <typename AdapterKeyT>
+  void bulkRemove(const std::vector<AdapterKeyT>& keys) const {
+    if (UNLIKELY(skipHwWrites()) || keys.empty()) {
+      return;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOGF(
+          FATAL,
+          "Attempting bulk remove of {} SAI objs while hw writes are blocked",
+          keys.size());
+    }
+    if (UNLIKELY(logFailHwWrites())) {
+      XLOGF(
+          WARNING,
+          "Attempting bulk remove of {} SAI objs while hw writes are not expected",
+          keys.size());
+    }
+    std::vector<sai_status_t> retStatus(keys.size(), SAI_STATUS_NOT_EXECUTED);
+    auto g{SaiApiLock::getInstance()->lock()};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkRemove(keys.data(), retStatus.data(), keys.size());
+    }
+    for (size_t idx = 0; idx < keys.size(); idx++) {
+      if (retStatus[idx] != SAI_STATUS_NOT_EXECUTED) {
+        saiApiCheckError(
+            retStatus[idx],
+            apiType(),
+            fmt::format("Failed to bulk remove sai object : {}", keys[idx]));
+      }
+    }
+    saiApiCheckError(
+        status,
+        apiType(),
+        fmt::format("Failed to bulk remove {} sai objects", keys.size()));
+    XLOGF(DBG5, "bulk removed {} SAI objects", keys.size());
+  }
+
   /*
    * We can do getAttribute on top of more complicated types than just
    * attributes. For example, if we overload on tuples and optionals, we
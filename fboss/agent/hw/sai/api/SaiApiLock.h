@@ -35,6 +35,9 @@ class SaiApiLock {
   void setAdaptorIsThreadSafe(bool isThreadSafe) {
     adaptorIsThreadSafe_ = isThreadSafe;
   }
+  bool isAdaptorThreadSafe() const {
+    return adaptorIsThreadSafe_;
+  }
   ScopedApiLock lock() const {
     return {mutex_, adaptorIsThreadSafe_};
   }
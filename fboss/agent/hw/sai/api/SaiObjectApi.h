@@ -10,10 +10,13 @@
 #pragma once
 
 #include "fboss/agent/hw/sai/api/SaiApiError.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
 
+#include <optional>
 #include <type_traits>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -84,4 +87,60 @@ std::vector<typename SaiObjectTraits::AdapterKey> getObjectKeys(
   return ret;
 }
 
+/*
+ * Read the same counters from many objects of one type with a single
+ * sai_bulk_object_get_stats call. Returns std::nullopt if the adapter
+ * doesn't implement bulk stats reads for the object type, so callers can
+ * fall back to reading objects one at a time. Objects whose counters could
+ * not be read (e.g. because they were removed since their ids were
+ * gathered) get an empty counter vector.
+ */
+template <typename SaiObjectTraits>
+std::optional<std::vector<std::vector<uint64_t>>> getObjectStatsBulk(
+    sai_object_id_t switch_id,
+    const std::vector<typename SaiObjectTraits::AdapterKey>& keys,
+    const std::vector<sai_stat_id_t>& counterIds,
+    sai_stats_mode_t mode) {
+  static_assert(
+      AdapterKeyIsObjectId<SaiObjectTraits>::value,
+      "bulk stats only supported for object id keyed objects");
+#if SAI_API_VERSION >= SAI_VERSION(1, 11, 0)
+  std::vector<sai_object_key_t> objectKeys(keys.size());
+  for (auto idx = 0; idx < keys.size(); idx++) {
+    objectKeys[idx].key.object_id = static_cast<sai_object_id_t>(keys[idx]);
+  }
+  std::vector<sai_status_t> statuses(keys.size(), SAI_STATUS_NOT_EXECUTED);
+  std::vector<uint64_t> counters(keys.size() * counterIds.size());
+  sai_status_t status;
+  {
+    auto g{SaiApiLock::getInstance()->lock()};
+    status = sai_bulk_object_get_stats(
+        switch_id,
+        SaiObjectTraits::ObjectType,
+        objectKeys.size(),
+        objectKeys.data(),
+        counterIds.size(),
+        counterIds.data(),
+        mode,
+        statuses.data(),
+        counters.data());
+  }
+  if (status == SAI_STATUS_NOT_IMPLEMENTED ||
+      status == SAI_STATUS_NOT_SUPPORTED) {
+    return std::nullopt;
+  }
+  std::vector<std::vector<uint64_t>> ret(keys.size());
+  for (auto idx = 0; idx < keys.size(); idx++) {
+    if (status != SAI_STATUS_SUCCESS && statuses[idx] != SAI_STATUS_SUCCESS) {
+      continue;
+    }
+    auto begin = counters.begin() + idx * counterIds.size();
+    ret[idx].assign(begin, begin + counterIds.size());
+  }
+  return ret;
+#else
+  return std::nullopt;
+#endif
+}
+
 } // namespace facebook::fboss
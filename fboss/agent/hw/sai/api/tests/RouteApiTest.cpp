@@ -11,6 +11,7 @@
 #include "fboss/agent/hw/sai/api/SaiObjectApi.h"
 #include "fboss/agent/hw/sai/fake/FakeSai.h"
 
+#include <fmt/format.h>
 #include <folly/IPAddress.h>
 #include <folly/logging/xlog.h>
 
@@ -110,6 +111,52 @@ TEST_F(RouteApiTest, createV6Drop) {
       SAI_PACKET_ACTION_DROP);
 }
 
+TEST_F(RouteApiTest, bulkCreateRemoveRoutes) {
+  SaiRouteTraits::Attributes::PacketAction packetActionAttribute{
+      SAI_PACKET_ACTION_FORWARD};
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  std::vector<SaiRouteTraits::CreateAttributes> attributes;
+  for (auto i = 0; i < 3; ++i) {
+    folly::IPAddress prefix(fmt::format("10.0.{}.0", i));
+    entries.emplace_back(0, 0, folly::CIDRNetwork(prefix, 24));
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    attributes.push_back(
+        {packetActionAttribute,
+         SaiRouteTraits::Attributes::NextHopId(i + 1),
+         std::nullopt,
+         std::nullopt});
+#else
+    attributes.push_back(
+        {packetActionAttribute,
+         SaiRouteTraits::Attributes::NextHopId(i + 1),
+         std::nullopt});
+#endif
+  }
+  routeApi->bulkCreate<SaiRouteTraits>(entries, attributes);
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_EQ(
+        routeApi->getAttribute(
+            entries[i], SaiRouteTraits::Attributes::NextHopId()),
+        i + 1);
+  }
+  EXPECT_EQ(fs->routeManager.map().size(), 3);
+
+  // creating an existing route fails the whole batch
+  std::vector<SaiRouteTraits::RouteEntry> newEntries{
+      SaiRouteTraits::RouteEntry(
+          0, 0, folly::CIDRNetwork(folly::IPAddress("10.0.3.0"), 24)),
+      entries[0]};
+  std::vector<SaiRouteTraits::CreateAttributes> newAttributes{
+      attributes[0], attributes[0]};
+  EXPECT_THROW(
+      routeApi->bulkCreate<SaiRouteTraits>(newEntries, newAttributes),
+      SaiApiError);
+  EXPECT_EQ(fs->routeManager.map().size(), 3);
+
+  routeApi->bulkRemove(entries);
+  EXPECT_EQ(fs->routeManager.map().size(), 0);
+}
+
 TEST_F(RouteApiTest, setRouteNextHop) {
   folly::CIDRNetwork prefix(ip4, 24);
   SaiRouteTraits::RouteEntry r(0, 0, prefix);
@@ -597,3 +597,44 @@ sai_status_t sai_get_object_key(
   }
   return SAI_STATUS_SUCCESS;
 }
+
+#if SAI_API_VERSION >= SAI_VERSION(1, 11, 0)
+/*
+ * In fake sai there isn't a dataplane, so all stats stay at 0, whatever
+ * the mode. Only ports and queues, the objects stats are collected for in
+ * bulk, are supported.
+ */
+sai_status_t sai_bulk_object_get_stats(
+    sai_object_id_t /* switch_id */,
+    sai_object_type_t object_type,
+    uint32_t object_count,
+    const sai_object_key_t* object_key,
+    uint32_t number_of_counters,
+    const sai_stat_id_t* /* counter_ids */,
+    sai_stats_mode_t /* mode */,
+    sai_status_t* object_statuses,
+    uint64_t* counters) {
+  if (object_type != SAI_OBJECT_TYPE_PORT &&
+      object_type != SAI_OBJECT_TYPE_QUEUE) {
+    return SAI_STATUS_NOT_SUPPORTED;
+  }
+  auto fs = facebook::fboss::FakeSai::getInstance();
+  auto exists = [&fs, object_type](sai_object_id_t id) {
+    return object_type == SAI_OBJECT_TYPE_PORT ? fs->portManager.exists(id)
+                                               : fs->queueManager.exists(id);
+  };
+  auto status = SAI_STATUS_SUCCESS;
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (!exists(object_key[i].key.object_id)) {
+      object_statuses[i] = SAI_STATUS_INVALID_OBJECT_ID;
+      status = SAI_STATUS_FAILURE;
+      continue;
+    }
+    for (uint32_t j = 0; j < number_of_counters; ++j) {
+      counters[i * number_of_counters + j] = 0;
+    }
+    object_statuses[i] = SAI_STATUS_SUCCESS;
+  }
+  return status;
+}
+#endif
@@ -241,6 +241,17 @@ class SaiObject {
     live_ = true;
   }
 
+  // Adopt an object already created in the adapter, e.g. by a bulk create
+  SaiObject(
+      const typename SaiObjectTraits::AdapterKey& adapterKey,
+      const typename SaiObjectTraits::AdapterHostKey& adapterHostKey,
+      const typename SaiObjectTraits::CreateAttributes& attributes)
+      : adapterKey_(adapterKey),
+        adapterHostKey_(adapterHostKey),
+        attributes_(attributes) {
+    live_ = true;
+  }
+
   bool live() const {
     return live_;
   }
@@ -399,6 +410,22 @@ class SaiObject {
     api.bulkSetAttributes(adapterKeys, attributes);
   }
 
+  static void bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& adapterKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes) {
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    api.template bulkCreate<SaiObjectTraits>(adapterKeys, attributes);
+  }
+
+  static void bulkRemove(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& adapterKeys) {
+    auto& api =
+        SaiApiTable::getInstance()->getApi<typename SaiObjectTraits::SaiApiT>();
+    api.bulkRemove(adapterKeys);
+  }
+
  protected:
   template <typename AttrT>
   void checkAndSetAttribute(AttrT&& newAttr, bool skipHwWrite) {
@@ -63,6 +63,16 @@ class SaiObjectWithCounters : public SaiObject<SaiObjectTraits> {
     fillInStats(counterIds.data(), counters);
   }
 
+  // Record counters that were read outside of this object, e.g. in a bulk
+  // read across many objects of the same type
+  template <typename T = SaiObjectTraits>
+  void setStats(const StatsMap& counters) {
+    static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
+    for (const auto& [counterId, value] : counters) {
+      counterId2Value_[counterId] = value;
+    }
+  }
+
   template <typename T = SaiObjectTraits>
   const StatsMap getStats() const {
     static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
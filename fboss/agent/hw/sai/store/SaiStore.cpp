@@ -10,6 +10,20 @@
 
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+#include <gflags/gflags.h>
+
+#include <algorithm>
+
+DEFINE_int32(
+    sai_store_reload_threads,
+    1,
+    "Number of threads SaiStore::reload() reloads object types on. Object "
+    "types are reloaded independently, SAI calls still serialize on the SAI "
+    "api lock.");
+
 namespace facebook::fboss {
 
 SaiStore::SaiStore() {}
@@ -27,8 +41,10 @@ void SaiStore::setSwitchId(sai_object_id_t switchId) {
 void SaiStore::reload(
     const folly::dynamic* adapterKeysJson,
     const folly::dynamic* adapterKeys2AdapterHostKeyJson) {
+  std::vector<std::pair<std::string, std::function<void()>>> reloads;
   tupleForEach(
-      [adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
+      [adapterKeysJson, adapterKeys2AdapterHostKeyJson, &reloads](
+          auto& store) {
         const folly::dynamic* adapterKeys = adapterKeysJson
             ? adapterKeysJson->get_ptr(store.objectTypeName())
             : nullptr;
@@ -36,9 +52,81 @@ void SaiStore::reload(
             ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
             : nullptr;
 
-        store.reload(adapterKeys, adapterHostKeys);
+        reloads.emplace_back(
+            store.objectTypeName().str(),
+            [&store, adapterKeys, adapterHostKeys]() {
+              store.reload(adapterKeys, adapterHostKeys);
+            });
       },
       stores_);
+  reloadStores(std::move(reloads));
+}
+
+void SaiStore::reload(
+    const SaiStoreWarmbootState* adapterKeys,
+    const SaiStoreWarmbootState* adapterKeys2AdapterHostKey) {
+  auto storeState = [](const SaiStoreWarmbootState* state,
+                       const std::string& objName) {
+    const SaiObjectStoreWarmbootState* ret{nullptr};
+    if (state) {
+      auto itr = state->stores()->find(objName);
+      if (itr != state->stores()->end()) {
+        ret = &itr->second;
+      }
+    }
+    return ret;
+  };
+  std::vector<std::pair<std::string, std::function<void()>>> reloads;
+  tupleForEach(
+      [adapterKeys, adapterKeys2AdapterHostKey, &storeState, &reloads](
+          auto& store) {
+        auto objName = store.objectTypeName().str();
+        auto storeAdapterKeys = storeState(adapterKeys, objName);
+        auto storeAdapterHostKeys =
+            storeState(adapterKeys2AdapterHostKey, objName);
+        reloads.emplace_back(
+            objName, [&store, storeAdapterKeys, storeAdapterHostKeys]() {
+              store.reload(storeAdapterKeys, storeAdapterHostKeys);
+            });
+      },
+      stores_);
+  reloadStores(std::move(reloads));
+}
+
+void SaiStore::reloadStores(
+    std::vector<std::pair<std::string, std::function<void()>>> reloads) {
+  std::vector<std::chrono::microseconds> reloadTimes(reloads.size());
+  auto reloadStore = [&reloads, &reloadTimes](size_t idx) {
+    auto begin = std::chrono::steady_clock::now();
+    reloads[idx].second();
+    reloadTimes[idx] = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin);
+  };
+  auto numThreads = std::min<size_t>(
+      std::max(FLAGS_sai_store_reload_threads, 1), reloads.size());
+  if (numThreads <= 1) {
+    for (size_t idx = 0; idx < reloads.size(); ++idx) {
+      reloadStore(idx);
+    }
+  } else {
+    // Stores only touch their own objects while reloading, so any two
+    // object types can reload at the same time
+    folly::CPUThreadPoolExecutor executor(
+        numThreads, std::make_shared<folly::NamedThreadFactory>("SaiReload"));
+    std::vector<folly::Future<folly::Unit>> futures;
+    futures.reserve(reloads.size());
+    for (size_t idx = 0; idx < reloads.size(); ++idx) {
+      futures.push_back(folly::via(
+          &executor, [&reloadStore, idx]() { reloadStore(idx); }));
+    }
+    for (auto& result : folly::collectAll(std::move(futures)).get()) {
+      result.throwUnlessValue();
+    }
+  }
+  reloadTimes_.clear();
+  for (size_t idx = 0; idx < reloads.size(); ++idx) {
+    reloadTimes_[reloads[idx].first] = reloadTimes[idx];
+  }
 }
 
 void SaiStore::release() {
@@ -91,6 +179,35 @@ folly::dynamic SaiStore::adapterKeys2AdapterHostKeysFollyDynamic() const {
   return storeJson;
 }
 
+SaiStoreWarmbootState SaiStore::warmbootStateThrift() const {
+  SaiStoreWarmbootState state;
+  state.saiApiVersion() = SAI_API_VERSION;
+  tupleForEach(
+      [&state](const auto& store) {
+        state.stores()->emplace(
+            store.objectTypeName().str(), store.warmbootStateThrift());
+      },
+      stores_);
+  return state;
+}
+
+bool SaiStore::isCompatible(const SaiStoreWarmbootState& state) const {
+  if (*state.saiApiVersion() != SAI_API_VERSION) {
+    return false;
+  }
+  bool compatible = true;
+  tupleForEach(
+      [&state, &compatible](const auto& store) {
+        using StoreType = std::decay_t<decltype(store)>;
+        auto itr = state.stores()->find(store.objectTypeName().str());
+        if (itr != state.stores()->end()) {
+          compatible &= StoreType::isCompatible(itr->second);
+        }
+      },
+      stores_);
+  return compatible;
+}
+
 std::string SaiStore::storeStr(sai_object_type_t objType) const {
   std::string output;
   tupleForEach(
@@ -22,10 +22,16 @@
 #include "fboss/agent/hw/sai/store/SaiObject.h"
 #include "fboss/agent/hw/sai/store/SaiObjectWithCounters.h"
 #include "fboss/agent/hw/sai/store/Traits.h"
+#include "fboss/agent/hw/sai/store/gen-cpp2/sai_store_warmboot_types.h"
 #include "fboss/lib/RefMap.h"
 
 #include <folly/json/dynamic.h>
+#include <folly/json/json.h>
 
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -139,39 +145,32 @@ class SaiObjectStore {
   void reload(
       const folly::dynamic* adapterKeysJson,
       const folly::dynamic* adapterKeys2AdapterHostKey) {
-    if (!saiSwitchId_) {
-      XLOG(FATAL)
-          << "Attempted to reload() on a SaiObjectStore without a switchId";
-    }
-    auto keys = getAdapterKeys(adapterKeysJson);
-    if constexpr (SaiObjectHasConditionalAttributes<SaiObjectTraits>::value) {
-      keys.erase(
-          std::remove_if(
-              keys.begin(),
-              keys.end(),
-              [](auto key) {
-                auto conditionAttributes =
-                    SaiApiTable::getInstance()
-                        ->getApi<typename SaiObjectTraits::SaiApiT>()
-                        .getAttribute(
-                            key,
-                            typename SaiObjectTraits::ConditionAttributes{});
-                return conditionAttributes !=
-                    SaiObjectTraits::kConditionAttributes;
-              }),
-          keys.end());
-    }
-    for (const auto& k : keys) {
-      ObjectType obj = getObject(k, adapterKeys2AdapterHostKey);
-      auto adapterHostKey = obj.adapterHostKey();
-      XLOGF(DBG5, "SaiStore reloaded {}", obj);
-      auto ins = objects_.refOrInsert(adapterHostKey, std::move(obj));
-      if (!ins.second) {
-        XLOG(FATAL) << "[" << saiObjectTypeToString(SaiObjectTraits::ObjectType)
-                    << "]" << " Unexpected duplicate adapterHostKey";
+    reloadKeys(
+        adapterKeysJson ? std::make_optional(
+                              adapterKeysFromFollyDynamic(*adapterKeysJson))
+                        : std::nullopt,
+        adapterKeys2AdapterHostKey);
+  }
+
+  void reload(
+      const SaiObjectStoreWarmbootState* adapterKeys,
+      const SaiObjectStoreWarmbootState* adapterKeys2AdapterHostKey) {
+    std::optional<folly::dynamic> adapterKeys2AdapterHostKeyJson;
+    if (adapterKeys2AdapterHostKey) {
+      // Only present for the few object types whose adapter host keys
+      // cannot be recovered, so these stay JSON
+      adapterKeys2AdapterHostKeyJson = folly::dynamic::object;
+      for (const auto& [adapterKey, adapterHostKey] :
+           *adapterKeys2AdapterHostKey->adapterKey2AdapterHostKey()) {
+        (*adapterKeys2AdapterHostKeyJson)[adapterKey] =
+            folly::parseJson(adapterHostKey);
       }
-      warmBootHandles_.emplace(adapterHostKey, ins.first);
     }
+    reloadKeys(
+        adapterKeys ? std::make_optional(adapterKeysFromThrift(*adapterKeys))
+                    : std::nullopt,
+        adapterKeys2AdapterHostKeyJson ? &*adapterKeys2AdapterHostKeyJson
+                                       : nullptr);
   }
 
   // must be invoked during warm boot only, before entry has been warm booted.
@@ -274,6 +273,97 @@ class SaiObjectStore {
     }
   }
 
+  /*
+   * Create objects keyed by entry structs with a single bulk call. Objects
+   * which already exist, or are waiting to be reclaimed after warm boot, are
+   * programmed one at a time like setObject would.
+   */
+  std::vector<std::shared_ptr<ObjectType>> createObjects(
+      const std::vector<typename SaiObjectTraits::AdapterHostKey>&
+          adapterHostKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes) {
+    static_assert(
+        AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+        "bulk create is only supported for objects keyed by entry structs");
+    static_assert(
+        !IsObjectPublisher<SaiObjectTraits>::value,
+        "bulk create is not supported for publisher objects");
+    CHECK_EQ(adapterHostKeys.size(), attributes.size());
+    std::vector<std::shared_ptr<ObjectType>> objects(adapterHostKeys.size());
+    std::vector<typename SaiObjectTraits::AdapterKey> newKeys;
+    std::vector<typename SaiObjectTraits::CreateAttributes> newAttributes;
+    std::vector<size_t> newIdxs;
+    for (auto idx = 0; idx < adapterHostKeys.size(); idx++) {
+      const auto& adapterHostKey = adapterHostKeys[idx];
+      if (objects_.ref(adapterHostKey) ||
+          warmBootHandles_.find(adapterHostKey) != warmBootHandles_.end()) {
+        objects[idx] = program(adapterHostKey, attributes[idx]).first;
+        continue;
+      }
+      newKeys.push_back(adapterHostKey);
+      newAttributes.push_back(attributes[idx]);
+      newIdxs.push_back(idx);
+    }
+    XLOGF(
+        DBG5,
+        "SaiStore bulk creating {} {} objects",
+        newKeys.size(),
+        objectTypeName());
+    SaiObject<SaiObjectTraits>::bulkCreate(newKeys, newAttributes);
+    for (auto idx = 0; idx < newKeys.size(); idx++) {
+      objects[newIdxs[idx]] =
+          objects_
+              .refOrInsert(
+                  newKeys[idx],
+                  ObjectType(newKeys[idx], newKeys[idx], newAttributes[idx]),
+                  true /*force*/)
+              .first;
+    }
+    return objects;
+  }
+
+  /*
+   * Remove objects with a single bulk call. Only objects that are not
+   * referenced anywhere else are removed in bulk, the rest are removed as
+   * usual once their last reference is dropped.
+   */
+  void removeObjects(std::vector<std::shared_ptr<ObjectType>> objects) {
+    static_assert(
+        AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+        "bulk remove is only supported for objects keyed by entry structs");
+    static_assert(
+        !IsObjectPublisher<SaiObjectTraits>::value,
+        "bulk remove is not supported for publisher objects");
+    std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    std::vector<std::shared_ptr<ObjectType>> toRemove;
+    for (auto& object : objects) {
+      if (object && object.use_count() == 1 && !object->isOwnedByAdapter()) {
+        adapterKeys.push_back(object->adapterKey());
+        toRemove.push_back(std::move(object));
+      }
+    }
+    objects.clear();
+    XLOGF(
+        DBG5,
+        "SaiStore bulk removing {} {} objects",
+        adapterKeys.size(),
+        objectTypeName());
+    try {
+      SaiObject<SaiObjectTraits>::bulkRemove(adapterKeys);
+    } catch (const SaiApiError&) {
+      // some of the batch may be gone already, the rest get removed one at
+      // a time as toRemove goes out of scope
+      for (auto& object : toRemove) {
+        object->setIgnoreMissingInHwOnDelete(true);
+      }
+      throw;
+    }
+    for (auto& object : toRemove) {
+      object->release();
+    }
+  }
+
   std::shared_ptr<ObjectType> get(
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey) {
     XLOGF(DBG5, "SaiStore get object {}", adapterHostKey);
@@ -334,6 +424,78 @@ class SaiObjectStore {
     }
     return adapterKeys;
   }
+
+  /*
+   * Binary counterpart of adapterKeysFollyDynamic and
+   * adapterKeys2AdapterHostKeysFollyDynamic. Entry struct keys are stored
+   * as the raw SAI entries, so decoding them is a copy.
+   */
+  SaiObjectStoreWarmbootState warmbootStateThrift() const {
+    SaiObjectStoreWarmbootState state;
+    if constexpr (AdapterKeyIsEntryStruct<SaiObjectTraits>::value) {
+      state.entrySize() = sizeof(EntryType<>);
+      state.entries()->reserve(objects_.size() * sizeof(EntryType<>));
+    } else {
+      state.objectIds()->reserve(objects_.size());
+    }
+    for (const auto& hostKeyAndObj : objects_) {
+      auto obj = hostKeyAndObj.second.lock();
+      if constexpr (!AdapterHostKeyWarmbootRecoverable<
+                        SaiObjectTraits>::value) {
+        state.adapterKey2AdapterHostKey()->emplace(
+            folly::to<std::string>(obj->adapterKey()),
+            folly::toJson(obj->adapterHostKeyToFollyDynamic()));
+      }
+      if (!obj->live()) {
+        continue;
+      }
+      if constexpr (AdapterKeyIsEntryStruct<SaiObjectTraits>::value) {
+        state.entries()->append(
+            reinterpret_cast<const char*>(obj->adapterKey().entry()),
+            sizeof(EntryType<>));
+      } else {
+        state.objectIds()->push_back(static_cast<int64_t>(obj->adapterKey()));
+      }
+    }
+    return state;
+  }
+  static std::vector<typename SaiObjectTraits::AdapterKey>
+  adapterKeysFromThrift(const SaiObjectStoreWarmbootState& state) {
+    std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    if constexpr (AdapterKeyIsEntryStruct<SaiObjectTraits>::value) {
+      if (!isCompatible(state)) {
+        throw FbossError(
+            "Incompatible ",
+            objectTypeName(),
+            " entries in warm boot state, entry size: ",
+            *state.entrySize());
+      }
+      const auto& entries = *state.entries();
+      adapterKeys.reserve(entries.size() / sizeof(EntryType<>));
+      for (size_t offset = 0; offset < entries.size();
+           offset += sizeof(EntryType<>)) {
+        sai_object_key_t key{};
+        std::memcpy(&key.key, entries.data() + offset, sizeof(EntryType<>));
+        adapterKeys.emplace_back(key);
+      }
+    } else {
+      adapterKeys.reserve(state.objectIds()->size());
+      for (auto objectId : *state.objectIds()) {
+        adapterKeys.emplace_back(objectId);
+      }
+    }
+    return adapterKeys;
+  }
+  // Whether entries in state have the layout of this build's SAI entries
+  static bool isCompatible(const SaiObjectStoreWarmbootState& state) {
+    if constexpr (AdapterKeyIsEntryStruct<SaiObjectTraits>::value) {
+      return state.entries()->empty() ||
+          (*state.entrySize() == sizeof(EntryType<>) &&
+           state.entries()->size() % sizeof(EntryType<>) == 0);
+    } else {
+      return true;
+    }
+  }
   void exitForWarmBoot() {
     for (auto itr : objects_) {
       if (auto object = itr.second.lock()) {
@@ -413,6 +575,11 @@ class SaiObjectStore {
   }
 
  private:
+  // sai_*_entry_t of objects keyed by entry structs
+  template <typename T = SaiObjectTraits>
+  using EntryType = std::remove_cv_t<std::remove_pointer_t<
+      decltype(std::declval<typename T::AdapterKey>().entry())>>;
+
   size_t warmBootHandlesCount(bool includeAdapterOwned = false) const {
     return std::count_if(
         std::begin(warmBootHandles_),
@@ -422,6 +589,47 @@ class SaiObjectStore {
         });
   }
 
+  void reloadKeys(
+      std::optional<std::vector<typename SaiObjectTraits::AdapterKey>>
+          adapterKeys,
+      const folly::dynamic* adapterKeys2AdapterHostKey) {
+    if (!saiSwitchId_) {
+      XLOG(FATAL)
+          << "Attempted to reload() on a SaiObjectStore without a switchId";
+    }
+    auto keys = adapterKeys
+        ? std::move(*adapterKeys)
+        : getObjectKeys<SaiObjectTraits>(saiSwitchId_.value());
+    if constexpr (SaiObjectHasConditionalAttributes<SaiObjectTraits>::value) {
+      keys.erase(
+          std::remove_if(
+              keys.begin(),
+              keys.end(),
+              [](auto key) {
+                auto conditionAttributes =
+                    SaiApiTable::getInstance()
+                        ->getApi<typename SaiObjectTraits::SaiApiT>()
+                        .getAttribute(
+                            key,
+                            typename SaiObjectTraits::ConditionAttributes{});
+                return conditionAttributes !=
+                    SaiObjectTraits::kConditionAttributes;
+              }),
+          keys.end());
+    }
+    for (const auto& k : keys) {
+      ObjectType obj = getObject(k, adapterKeys2AdapterHostKey);
+      auto adapterHostKey = obj.adapterHostKey();
+      XLOGF(DBG5, "SaiStore reloaded {}", obj);
+      auto ins = objects_.refOrInsert(adapterHostKey, std::move(obj));
+      if (!ins.second) {
+        XLOG(FATAL) << "[" << saiObjectTypeToString(SaiObjectTraits::ObjectType)
+                    << "]" << " Unexpected duplicate adapterHostKey";
+      }
+      warmBootHandles_.emplace(adapterHostKey, ins.first);
+    }
+  }
+
   ObjectType getObject(
       typename ObjectTraits::AdapterKey key,
       const folly::dynamic* adapterKey2AdapterHostKey) {
@@ -478,13 +686,6 @@ class SaiObjectStore {
     return std::make_pair(ins.first, notify);
   }
 
-  std::vector<typename SaiObjectTraits::AdapterKey> getAdapterKeys(
-      const folly::dynamic* adapterKeysJson) const {
-    return adapterKeysJson
-        ? adapterKeysFromFollyDynamic(*adapterKeysJson)
-        : getObjectKeys<SaiObjectTraits>(saiSwitchId_.value());
-  }
-
   std::optional<typename SaiObjectTraits::AdapterHostKey> getAdapterHostKey(
       const typename SaiObjectTraits::AdapterKey& key,
       const folly::dynamic* adapterKeys2AdapterHostKey) {
@@ -542,6 +743,23 @@ class SaiStore {
       const folly::dynamic* adapterKeys = nullptr,
       const folly::dynamic* adapterKeys2AdapterHostKey = nullptr);
 
+  /*
+   * Reload the SaiStore from the binary warm boot state, see
+   * warmbootStateThrift(). Either may be null, as for the JSON reload.
+   */
+  void reload(
+      const SaiStoreWarmbootState* adapterKeys,
+      const SaiStoreWarmbootState* adapterKeys2AdapterHostKey);
+
+  /*
+   * How long each object type took to reload in the last reload(). With
+   * --sai_store_reload_threads > 1 object types reload concurrently.
+   */
+  const std::map<std::string, std::chrono::microseconds>& getReloadTimes()
+      const {
+    return reloadTimes_;
+  }
+
   /*
    *
    */
@@ -563,6 +781,18 @@ class SaiStore {
 
   folly::dynamic adapterKeys2AdapterHostKeysFollyDynamic() const;
 
+  /*
+   * Compact binary alternative to adapterKeysFollyDynamic() and
+   * adapterKeys2AdapterHostKeysFollyDynamic() for warm boot
+   */
+  SaiStoreWarmbootState warmbootStateThrift() const;
+
+  /*
+   * Whether warm boot state written by another agent can be reloaded here,
+   * i.e. it was written against the same SAI version and entry layouts
+   */
+  bool isCompatible(const SaiStoreWarmbootState& state) const;
+
   void checkUnexpectedUnclaimedWarmbootHandles() const;
 
   void removeUnexpectedUnclaimedWarmbootHandles();
@@ -570,7 +800,11 @@ class SaiStore {
   void printWarmbootHandles() const;
 
  private:
+  void reloadStores(
+      std::vector<std::pair<std::string, std::function<void()>>> reloads);
+
   sai_object_id_t saiSwitchId_{};
+  std::map<std::string, std::chrono::microseconds> reloadTimes_;
   std::tuple<
       SaiObjectStore<SaiAclTableGroupTraits>,
       SaiObjectStore<SaiAclTableGroupMemberTraits>,
@@ -647,6 +881,14 @@ keysForSaiObjStoreFromStoreJson(const folly::dynamic& json) {
   return SaiObjectStore<SaiObjectTraits>::adapterKeysFromFollyDynamic(
       json[saiObjectTypeToString(SaiObjectTraits::ObjectType)]);
 }
+
+template <typename SaiObjectTraits>
+std::vector<typename SaiObjectTraits::AdapterKey>
+keysForSaiObjStoreFromStoreThrift(const SaiStoreWarmbootState& state) {
+  return SaiObjectStore<SaiObjectTraits>::adapterKeysFromThrift(
+      state.stores()->at(
+          saiObjectTypeToString(SaiObjectTraits::ObjectType).str()));
+}
 } // namespace facebook::fboss
 namespace fmt {
 
@@ -0,0 +1,29 @@
+namespace cpp2 facebook.fboss
+namespace py3 neteng.fboss
+
+/*
+ * Warm boot state of one SaiObjectStore
+ */
+struct SaiObjectStoreWarmbootState {
+  // Adapter keys of objects keyed by sai_object_id_t
+  1: list<i64> objectIds;
+  // Adapter keys of objects keyed by entry structs: the sai_*_entry_t
+  // structs laid out back to back, entrySize bytes each
+  2: binary entries;
+  3: i32 entrySize;
+  // adapter key -> adapter host key as JSON, only for object types whose
+  // adapter host key cannot be recovered from the adapter
+  4: map<string, string> adapterKey2AdapterHostKey;
+}
+
+/*
+ * Compact alternative to the adapterKeys and adapterKey2AdapterHostKey JSON
+ * of the SaiSwitch warm boot state
+ */
+struct SaiStoreWarmbootState {
+  // SAI_API_VERSION the state was written with. Entries are raw SAI structs,
+  // so they are only read back by an agent built against the same version.
+  1: i64 saiApiVersion;
+  // Keyed by object type name
+  2: map<string, SaiObjectStoreWarmbootState> stores;
+}
@@ -26,10 +26,15 @@ def _sai_store_lib(sai_impl):
         exported_deps = [
             "fbsource//third-party/fmt:fmt",
             "//fboss/agent/hw/sai/api:sai_api{}".format(impl_suffix),
+            "//fboss/agent/hw/sai/store:sai_store_warmboot-cpp2-types",
             "//fboss/lib:ref_map",
             "//fboss/lib:tuple_utils",
             "//folly:singleton",
         ],
+        deps = [
+            "//folly/executors:cpu_thread_pool_executor",
+            "//folly/futures:core",
+        ],
         versions = to_versions(sai_impl),
     )
 
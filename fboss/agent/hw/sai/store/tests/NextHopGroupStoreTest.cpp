@@ -163,6 +163,7 @@ TEST_F(NextHopGroupStoreTest, nextHopGroupMemberCreateCtor) {
 TEST_F(NextHopGroupStoreTest, nhopGroupSerDeser) {
   auto nextHopGroupId = createNextHopGroup();
   verifyAdapterKeySerDeser<SaiNextHopGroupTraits>({nextHopGroupId});
+  verifyAdapterKeyThriftSerDeser<SaiNextHopGroupTraits>({nextHopGroupId});
 }
 
 TEST_F(NextHopGroupStoreTest, nhopGroupToStr) {
@@ -247,6 +248,33 @@ TEST_F(NextHopGroupStoreTest, nextHopGroupJson) {
   EXPECT_EQ(iter->second, json);
 }
 
+TEST_F(NextHopGroupStoreTest, nextHopGroupThrift) {
+  auto nextHopGroupId = createNextHopGroup();
+  folly::IPAddress ip1{"10.10.10.1"};
+  auto nextHopId1 = createNextHop(ip1);
+  createNextHopGroupMember(nextHopGroupId, nextHopId1, 8);
+
+  SaiStore s(0);
+  s.reload();
+  auto state = s.warmbootStateThrift();
+  const auto& nhgState = state.stores()->at(
+      saiObjectTypeToString(SAI_OBJECT_TYPE_NEXT_HOP_GROUP).str());
+  EXPECT_EQ(nhgState.adapterKey2AdapterHostKey()->size(), 1);
+
+  // Reload from the binary state, recovering next hop group adapter host
+  // keys from it
+  SaiStore s1(0);
+  s1.reload(&state, &state);
+  auto& store0 = s.get<SaiNextHopGroupTraits>();
+  auto& store1 = s1.get<SaiNextHopGroupTraits>();
+  EXPECT_EQ(store0.size(), store1.size());
+  SaiNextHopGroupTraits::AdapterHostKey k;
+  k.insert(std::make_pair(SaiIpNextHopTraits::AdapterHostKey{42, ip1}, 8));
+  auto got = store1.get(k);
+  ASSERT_TRUE(got);
+  EXPECT_EQ(got->adapterKey(), nextHopGroupId);
+}
+
 TEST_F(NextHopGroupStoreTest, bulkSetNextHopGroup) {
 #if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
   // Create a next hop group
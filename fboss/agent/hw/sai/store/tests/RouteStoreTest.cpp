@@ -179,6 +179,7 @@ TEST_F(SaiStoreTest, serDeserV4Route) {
   );
 
   verifyAdapterKeySerDeser<SaiRouteTraits>({r});
+  verifyAdapterKeyThriftSerDeser<SaiRouteTraits>({r});
 }
 
 TEST_F(SaiStoreTest, serDeserV6Route) {
@@ -200,6 +201,7 @@ TEST_F(SaiStoreTest, serDeserV6Route) {
   );
 
   verifyAdapterKeySerDeser<SaiRouteTraits>({r});
+  verifyAdapterKeyThriftSerDeser<SaiRouteTraits>({r});
 }
 
 TEST_F(SaiStoreTest, toStrV4Route) {
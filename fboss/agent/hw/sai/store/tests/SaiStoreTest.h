@@ -15,6 +15,7 @@
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 
 #include <gtest/gtest.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 
 namespace facebook::fboss {
 
@@ -50,6 +51,23 @@ void verifyAdapterKeySerDeser(
   }
 }
 
+template <typename SaiObjectTraits>
+void verifyAdapterKeyThriftSerDeser(
+    const std::vector<typename SaiObjectTraits::AdapterKey>& keys) {
+  SaiStore s(0);
+  s.reload();
+  auto state = s.warmbootStateThrift();
+  EXPECT_TRUE(s.isCompatible(state));
+  auto gotAdapterKeys = keysForSaiObjStoreFromStoreThrift<SaiObjectTraits>(
+      apache::thrift::CompactSerializer::deserialize<SaiStoreWarmbootState>(
+          apache::thrift::CompactSerializer::serialize<std::string>(state)));
+  EXPECT_EQ(keys.size(), gotAdapterKeys.size());
+  for (auto key : keys) {
+    auto itr = std::find(gotAdapterKeys.begin(), gotAdapterKeys.end(), key);
+    EXPECT_TRUE(itr != gotAdapterKeys.end());
+  }
+}
+
 template <typename SaiObjectTraits>
 void verifyToStr() {
   SaiStore s(0);
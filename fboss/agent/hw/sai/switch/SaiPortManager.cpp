@@ -1777,10 +1777,31 @@ void SaiPortManager::updatePrbsStats(PortID portId) {
 #endif
 }
 
+void SaiPortManager::addStatsRequests(
+    PortID portId,
+    bool updateWatermarks,
+    SaiStatsCollector::Requests& requests) {
+  auto handlesItr = handles_.find(portId);
+  if (handlesItr == handles_.end() ||
+      getPortType(portId) == cfg::PortType::EVENTOR_PORT ||
+      portStats_.find(portId) == portStats_.end()) {
+    // Same ports updateStats skips
+    return;
+  }
+  auto* handle = handlesItr->second.get();
+  requests.ports.push_back(
+      {static_cast<sai_object_id_t>(handle->port->adapterKey()),
+       supportedStats(portId),
+       SAI_STATS_MODE_READ});
+  managerTable_->queueManager().addStatsRequests(
+      handle->configuredQueues, updateWatermarks, requests);
+}
+
 void SaiPortManager::updateStats(
     PortID portId,
     bool updateWatermarks,
-    bool updateCableLengths) {
+    bool updateCableLengths,
+    const SaiStatsCollector::Results* collected) {
   auto handlesItr = handles_.find(portId);
   if (handlesItr == handles_.end()) {
     return;
@@ -1814,7 +1835,11 @@ void SaiPortManager::updateStats(
   setUninitializedStatsToZero(*curPortStats.inPause_());
 
   curPortStats.timestamp_() = now.count();
-  handle->port->updateStats(supportedStats(portId), SAI_STATS_MODE_READ);
+  const auto& statsToRead = supportedStats(portId);
+  if (!collected ||
+      !collected->fill(*handle->port, statsToRead, SAI_STATS_MODE_READ)) {
+    handle->port->updateStats(statsToRead, SAI_STATS_MODE_READ);
+  }
 
   bool updateFecStats = false;
   auto lastFecReadTimeIt = lastFecCounterReadTime_.find(portId);
@@ -1873,7 +1898,7 @@ void SaiPortManager::updateStats(
       {*prevPortStats.inDiscardsRaw_(), *curPortStats.inDiscardsRaw_()},
       toSubtractFromInDiscardsRaw);
   managerTable_->queueManager().updateStats(
-      handle->configuredQueues, curPortStats, updateWatermarks);
+      handle->configuredQueues, curPortStats, updateWatermarks, collected);
   managerTable_->macsecManager().updateStats(portId, curPortStats);
   managerTable_->bufferManager().updateIngressPriorityGroupStats(
       portId, curPortStats, updateWatermarks);
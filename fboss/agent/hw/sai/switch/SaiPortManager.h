@@ -20,6 +20,7 @@
 #include "fboss/agent/hw/sai/switch/SaiQosMapManager.h"
 #include "fboss/agent/hw/sai/switch/SaiQueueManager.h"
 #include "fboss/agent/hw/sai/switch/SaiSamplePacketManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/PortQueue.h"
 #include "fboss/agent/state/StateDelta.h"
@@ -213,10 +214,20 @@ class SaiPortManager {
   void clearPortAsicPrbsStats(PortID portId);
   prbs::InterfacePrbsState getPortPrbsState(PortID portId);
   void updatePrbsStats(PortID portId);
+  /*
+   * Record the port and queue counters updateStats would read for a port,
+   * so SaiStatsCollector can read them outside of the switch lock and hand
+   * them back to updateStats in collected.
+   */
+  void addStatsRequests(
+      PortID portID,
+      bool updateWatermarks,
+      SaiStatsCollector::Requests& requests);
   void updateStats(
       PortID portID,
       bool updateWatermarks = false,
-      bool updateCableLengths = false);
+      bool updateCableLengths = false,
+      const SaiStatsCollector::Results* collected = nullptr);
 
   void updateConnectivityStats(PortID portID);
 
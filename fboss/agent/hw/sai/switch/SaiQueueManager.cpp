@@ -496,31 +496,70 @@ SaiQueueManager::supportedWatermarkCounterIdsReadAndClear(int queueType) const {
   return watermarkStats;
 }
 
+void SaiQueueManager::addStatsRequests(
+    const std::vector<SaiQueueHandle*>& queueHandles,
+    bool updateWatermarks,
+    SaiStatsCollector::Requests& requests) {
+  static std::vector<sai_stat_id_t> nonWatermarkStatsReadAndClear(
+      SaiQueueTraits::NonWatermarkCounterIdsToReadAndClear.begin(),
+      SaiQueueTraits::NonWatermarkCounterIdsToReadAndClear.end());
+  for (auto queueHandle : queueHandles) {
+    auto id = static_cast<sai_object_id_t>(queueHandle->queue->adapterKey());
+    auto queueType = GET_ATTR(Queue, Type, queueHandle->queue->attributes());
+    requests.queues.push_back(
+        {id,
+         supportedNonWatermarkCounterIdsRead(queueType, queueHandle),
+         SAI_STATS_MODE_READ});
+    requests.queues.push_back(
+        {id, nonWatermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR});
+    if (updateWatermarks) {
+      requests.queues.push_back(
+          {id,
+           supportedWatermarkCounterIdsReadAndClear(queueType),
+           SAI_STATS_MODE_READ_AND_CLEAR});
+    }
+  }
+}
+
 void SaiQueueManager::updateStats(
     const std::vector<SaiQueueHandle*>& queueHandles,
     HwPortStats& hwPortStats,
-    bool updateWatermarks) {
+    bool updateWatermarks,
+    const SaiStatsCollector::Results* collected) {
   hwPortStats.outCongestionDiscardPkts_() = 0;
   static std::vector<sai_stat_id_t> nonWatermarkStatsReadAndClear(
       SaiQueueTraits::NonWatermarkCounterIdsToReadAndClear.begin(),
       SaiQueueTraits::NonWatermarkCounterIdsToReadAndClear.end());
   for (auto queueHandle : queueHandles) {
+    // Use counters collected outside the switch lock where there are any,
+    // and read the rest from hardware
+    auto updateStats = [&](const std::vector<sai_stat_id_t>& counterIds,
+                           sai_stats_mode_t mode) {
+      if (!collected ||
+          !collected->fill(*queueHandle->queue, counterIds, mode)) {
+        queueHandle->queue->updateStats(counterIds, mode);
+      }
+    };
     /*
      * The WRED_DROPPED_PACKETS counter is needed only for non-CPU
      * ports and on platform supporting ECN/WRED, which is taken
      * care of in the API supportedNonWatermarkCounterIdsRead().
      * Hence, not using queueHandle->queue->updateStats() directly.
+     * Collected counters were requested for the queue type in the
+     * queue's attributes, look them up by the same type.
      */
-    auto queueType = SaiApiTable::getInstance()->queueApi().getAttribute(
-        queueHandle->queue->adapterKey(), SaiQueueTraits::Attributes::Type{});
+    auto queueType = collected
+        ? GET_ATTR(Queue, Type, queueHandle->queue->attributes())
+        : SaiApiTable::getInstance()->queueApi().getAttribute(
+              queueHandle->queue->adapterKey(),
+              SaiQueueTraits::Attributes::Type{});
 
-    queueHandle->queue->updateStats(
+    updateStats(
         supportedNonWatermarkCounterIdsRead(queueType, queueHandle),
         SAI_STATS_MODE_READ);
-    queueHandle->queue->updateStats(
-        nonWatermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR);
+    updateStats(nonWatermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR);
     if (updateWatermarks) {
-      queueHandle->queue->updateStats(
+      updateStats(
           supportedWatermarkCounterIdsReadAndClear(queueType),
           SAI_STATS_MODE_READ_AND_CLEAR);
     }
@@ -557,11 +596,41 @@ void SaiQueueManager::getStats(
   }
 }
 
+void SaiQueueManager::addVoqStatsRequests(
+    const std::vector<SaiQueueHandle*>& queueHandles,
+    bool updateWatermarks,
+    bool updateVoqStats,
+    SaiStatsCollector::Requests& requests) {
+  static std::vector<sai_stat_id_t> nonWatermarkStatsReadAndClear(
+      SaiQueueTraits::VoqNonWatermarkCounterIdsToReadAndClear.begin(),
+      SaiQueueTraits::VoqNonWatermarkCounterIdsToReadAndClear.end());
+  static std::vector<sai_stat_id_t> watermarkStatsReadAndClear(
+      SaiQueueTraits::WatermarkByteCounterIdsToReadAndClear.begin(),
+      SaiQueueTraits::WatermarkByteCounterIdsToReadAndClear.end());
+  for (auto queueHandle : queueHandles) {
+    auto id = static_cast<sai_object_id_t>(queueHandle->queue->adapterKey());
+    auto queueType = GET_ATTR(Queue, Type, queueHandle->queue->attributes());
+    if (updateVoqStats) {
+      requests.queues.push_back(
+          {id,
+           supportedNonWatermarkCounterIdsRead(queueType, queueHandle),
+           SAI_STATS_MODE_READ});
+      requests.queues.push_back(
+          {id, nonWatermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR});
+    }
+    if (updateWatermarks) {
+      requests.queues.push_back(
+          {id, watermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR});
+    }
+  }
+}
+
 void SaiQueueManager::updateStats(
     const std::vector<SaiQueueHandle*>& queueHandles,
     HwSysPortStats& hwSysPortStats,
     bool updateWatermarks,
-    bool updateVoqStats) {
+    bool updateVoqStats,
+    const SaiStatsCollector::Results* collected) {
   static std::vector<sai_stat_id_t> nonWatermarkStatsReadAndClear(
       SaiQueueTraits::VoqNonWatermarkCounterIdsToReadAndClear.begin(),
       SaiQueueTraits::VoqNonWatermarkCounterIdsToReadAndClear.end());
@@ -569,17 +638,24 @@ void SaiQueueManager::updateStats(
       SaiQueueTraits::WatermarkByteCounterIdsToReadAndClear.begin(),
       SaiQueueTraits::WatermarkByteCounterIdsToReadAndClear.end());
   for (auto queueHandle : queueHandles) {
+    // Use counters collected outside the switch lock where there are any,
+    // and read the rest from hardware
+    auto updateStats = [&](const std::vector<sai_stat_id_t>& counterIds,
+                           sai_stats_mode_t mode) {
+      if (!collected ||
+          !collected->fill(*queueHandle->queue, counterIds, mode)) {
+        queueHandle->queue->updateStats(counterIds, mode);
+      }
+    };
     auto queueType = GET_ATTR(Queue, Type, queueHandle->queue->attributes());
     if (updateVoqStats) {
-      queueHandle->queue->updateStats(
+      updateStats(
           supportedNonWatermarkCounterIdsRead(queueType, queueHandle),
           SAI_STATS_MODE_READ);
-      queueHandle->queue->updateStats(
-          nonWatermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR);
+      updateStats(nonWatermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR);
     }
     if (updateWatermarks) {
-      queueHandle->queue->updateStats(
-          watermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR);
+      updateStats(watermarkStatsReadAndClear, SAI_STATS_MODE_READ_AND_CLEAR);
     }
     const auto& counters = queueHandle->queue->getStats();
     auto queueId = SaiApiTable::getInstance()->queueApi().getAttribute(
@@ -16,6 +16,7 @@
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiBufferManager.h"
 #include "fboss/agent/hw/sai/switch/SaiSchedulerManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/hw/sai/switch/SaiWredManager.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/PortQueue.h"
@@ -86,15 +87,31 @@ class SaiQueueManager {
       const SaiQueueHandles& queueHandles,
       const QueueConfig& queues,
       const facebook::fboss::Port* swPort = nullptr);
+  /*
+   * Record the counters updateStats would read for queues, so they can be
+   * read by SaiStatsCollector outside of the switch lock. Counters found in
+   * collected stats are then used by updateStats instead of reading them.
+   */
+  void addStatsRequests(
+      const std::vector<SaiQueueHandle*>& queues,
+      bool updateWatermarks,
+      SaiStatsCollector::Requests& requests);
+  void addVoqStatsRequests(
+      const std::vector<SaiQueueHandle*>& queues,
+      bool updateWatermarks,
+      bool updateVoqStats,
+      SaiStatsCollector::Requests& requests);
   void updateStats(
       const std::vector<SaiQueueHandle*>& queues,
       HwPortStats& stats,
-      bool updateWatermarks);
+      bool updateWatermarks,
+      const SaiStatsCollector::Results* collected = nullptr);
   void updateStats(
       const std::vector<SaiQueueHandle*>& queues,
       HwSysPortStats& stats,
       bool updateWatermarks,
-      bool updateVoqStats);
+      bool updateVoqStats,
+      const SaiStatsCollector::Results* collected = nullptr);
   void getStats(SaiQueueHandles& queueHandles, HwPortStats& hwPortStats);
   void clearStats(const std::vector<SaiQueueHandle*>& queueHandles);
   QueueConfig getQueueSettings(const SaiQueueHandles& queueHandles) const;
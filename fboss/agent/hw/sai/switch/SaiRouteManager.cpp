@@ -22,6 +22,7 @@
 
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 
+#include <algorithm>
 #include <optional>
 
 DEFINE_bool(
@@ -29,6 +30,12 @@ DEFINE_bool(
     false,
     "Disable valid route check when creating or changing routes in SAI switches");
 
+DEFINE_int32(
+    route_bulk_size,
+    0,
+    "Max number of routes to create or remove in a single SAI bulk call. "
+    "0 programs routes one at a time");
+
 namespace facebook::fboss {
 
 sai_object_id_t SaiRouteHandle::nextHopAdapterKey() const {
@@ -411,8 +418,18 @@ void SaiRouteManager::addOrUpdateRoute(
     XLOG(DBG3) << "Route action DROP: " << newRoute->str();
   }
   auto& store = saiStore_->get<SaiRouteTraits>();
-  auto route = store.setObject(entry, attributes.value());
-  routeHandle->route = route;
+  if (bulkRouteProgramming() && !routeHandle->route && !store.get(entry)) {
+    // new route, created with the next bulk create
+    if (auto pendingAttributes =
+            oldRoute ? getPendingRouteCreateAttributes(entry) : nullptr) {
+      *pendingAttributes = attributes.value();
+    } else {
+      pendingRouteCreates_.emplace_back(entry, attributes.value());
+    }
+  } else {
+    auto route = store.setObject(entry, attributes.value());
+    routeHandle->route = route;
+  }
   routeHandle->nexthopHandle_ = nextHopHandle;
   routeHandle->counterHandle_ = counterHandle;
 }
@@ -437,6 +454,8 @@ void SaiRouteManager::changeRoute(
         "Failure to update route. Route does not exist ",
         newSwRoute->prefix().str());
   }
+  // free up resources held by removed routes before programming new ones
+  flushPendingRouteRemoves();
   addOrUpdateRoute(itr->second.get(), routerId, oldSwRoute, newSwRoute);
 }
 
@@ -455,10 +474,15 @@ void SaiRouteManager::addRoute(
     XLOG(DBG3) << "Not a valid route, don't add: " << swRoute->str();
     return;
   }
+  flushPendingRouteRemoves();
   auto routeHandle = std::make_unique<SaiRouteHandle>();
   addOrUpdateRoute(
       routeHandle.get(), routerId, std::shared_ptr<Route<AddrT>>{}, swRoute);
   handles_.emplace(entry, std::move(routeHandle));
+  if (pendingRouteCreates_.size() >=
+      static_cast<size_t>(FLAGS_route_bulk_size)) {
+    flushPendingRouteCreates();
+  }
 }
 
 template <typename AddrT>
@@ -471,11 +495,23 @@ void SaiRouteManager::removeRoute(
   }
   XLOG(DBG3) << "Remove route: " << swRoute->str();
   SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, swRoute);
-  size_t count = handles_.erase(entry);
-  if (!count) {
+  auto itr = handles_.find(entry);
+  if (itr == handles_.end()) {
     throw FbossError(
         "Failed to remove non-existent route to ", swRoute->prefix().str());
   }
+  if (!bulkRouteProgramming()) {
+    handles_.erase(itr);
+    return;
+  }
+  // routes to remove must exist in hw first
+  flushPendingRouteCreates();
+  pendingRouteRemoves_.push_back(std::move(itr->second));
+  handles_.erase(itr);
+  if (pendingRouteRemoves_.size() >=
+      static_cast<size_t>(FLAGS_route_bulk_size)) {
+    flushPendingRouteRemoves();
+  }
 }
 
 template <typename AddrT>
@@ -485,6 +521,12 @@ void SaiRouteManager::removeRouteForRollback(
   XLOG(DBG3) << "Remove route for rollback: " << swRoute->str();
   SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, swRoute);
   handles_.erase(entry);
+  pendingRouteCreates_.erase(
+      std::remove_if(
+          pendingRouteCreates_.begin(),
+          pendingRouteCreates_.end(),
+          [&entry](const auto& pending) { return pending.first == entry; }),
+      pendingRouteCreates_.end());
 }
 
 SaiRouteHandle* SaiRouteManager::getRouteHandle(
@@ -510,14 +552,88 @@ SaiRouteHandle* SaiRouteManager::getRouteHandleImpl(
 }
 
 void SaiRouteManager::clear() {
+  pendingRouteCreates_.clear();
+  pendingRouteRemoves_.clear();
   handles_.clear();
 }
 
+bool SaiRouteManager::bulkRouteProgramming() const {
+  return FLAGS_route_bulk_size > 0;
+}
+
+void SaiRouteManager::flushBulkRouteUpdates() {
+  flushPendingRouteRemoves();
+  flushPendingRouteCreates();
+}
+
+void SaiRouteManager::flushPendingRouteCreates() {
+  if (pendingRouteCreates_.empty()) {
+    return;
+  }
+  auto pendingRouteCreates = std::move(pendingRouteCreates_);
+  pendingRouteCreates_.clear();
+  std::vector<SaiRouteTraits::RouteEntry> entries;
+  std::vector<SaiRouteTraits::CreateAttributes> attributes;
+  entries.reserve(pendingRouteCreates.size());
+  attributes.reserve(pendingRouteCreates.size());
+  for (auto& [entry, attrs] : pendingRouteCreates) {
+    entries.push_back(entry);
+    attributes.push_back(std::move(attrs));
+  }
+  XLOG(DBG3) << "Bulk create " << entries.size() << " routes";
+  std::vector<std::shared_ptr<SaiRoute>> routes;
+  try {
+    routes =
+        saiStore_->get<SaiRouteTraits>().createObjects(entries, attributes);
+  } catch (const std::exception&) {
+    // none of the batch was created, drop the handles waiting on it
+    for (const auto& entry : entries) {
+      handles_.erase(entry);
+    }
+    throw;
+  }
+  for (auto idx = 0; idx < entries.size(); ++idx) {
+    auto itr = handles_.find(entries[idx]);
+    if (itr != handles_.end()) {
+      itr->second->route = std::move(routes[idx]);
+    }
+  }
+}
+
+void SaiRouteManager::flushPendingRouteRemoves() {
+  if (pendingRouteRemoves_.empty()) {
+    return;
+  }
+  auto pendingRouteRemoves = std::move(pendingRouteRemoves_);
+  pendingRouteRemoves_.clear();
+  std::vector<std::shared_ptr<SaiRoute>> routes;
+  routes.reserve(pendingRouteRemoves.size());
+  for (auto& routeHandle : pendingRouteRemoves) {
+    routes.push_back(std::move(routeHandle->route));
+  }
+  XLOG(DBG3) << "Bulk remove " << routes.size() << " routes";
+  saiStore_->get<SaiRouteTraits>().removeObjects(std::move(routes));
+  // routes are gone, next hops and counters they used can go too
+}
+
 std::shared_ptr<SaiObject<SaiRouteTraits>> SaiRouteManager::getRouteObject(
     SaiRouteTraits::AdapterHostKey routeKey) {
   return saiStore_->get<SaiRouteTraits>().get(routeKey);
 }
 
+SaiRouteTraits::CreateAttributes*
+SaiRouteManager::getPendingRouteCreateAttributes(
+    const SaiRouteTraits::RouteEntry& entry) {
+  auto itr = std::find_if(
+      pendingRouteCreates_.begin(),
+      pendingRouteCreates_.end(),
+      [&entry](const auto& pending) { return pending.first == entry; });
+  if (itr == pendingRouteCreates_.end()) {
+    return nullptr;
+  }
+  return &itr->second;
+}
+
 template <typename AddrT>
 std::shared_ptr<SaiCounterHandle> SaiRouteManager::getCounterHandleForRoute(
     const std::shared_ptr<Route<AddrT>>& newRoute,
@@ -613,7 +729,9 @@ void ManagedRouteNextHop<NextHopTraitsT>::afterCreate(
   if (!route) {
     XLOG(DBG2) << "ManagedRouteNextHop afterCreate , route not yet created: "
                << routeKey_.toString();
-    // route is not yet created.
+    // route is not yet created, if it is waiting to be bulk created make
+    // sure it is created pointing to this next hop
+    updatePendingRoute(nexthop->adapterKey(), metadata_);
     return;
   }
   auto& api = SaiApiTable::getInstance()->routeApi();
@@ -646,6 +764,16 @@ void ManagedRouteNextHop<NextHopTraitsT>::beforeRemove() {
              << routeKey_.toString();
 
   auto route = routeManager_->getRouteObject(routeKey_);
+  if (!route) {
+    // route is not yet created, if it is waiting to be bulk created make
+    // sure it is created pointing to CPU
+    updatePendingRoute(
+        static_cast<sai_object_id_t>(cpuPort_),
+        SaiRouteTraits::Attributes::Metadata{
+            static_cast<uint32_t>(cfg::AclLookupClass::DST_CLASS_L3_LOCAL_2)});
+    this->setPublisherObject(nullptr);
+    return;
+  }
   auto& api = SaiApiTable::getInstance()->routeApi();
   SaiRouteTraits::Attributes::Metadata currentMetadata = routeMetadataSupported_
       ? api.getAttribute(
@@ -709,6 +837,24 @@ void ManagedRouteNextHop<NextHopTraitsT>::updateMetadata(
   }
 }
 
+template <typename NextHopTraitsT>
+void ManagedRouteNextHop<NextHopTraitsT>::updatePendingRoute(
+    sai_object_id_t nextHopId,
+    std::optional<SaiRouteTraits::Attributes::Metadata> metadata) const {
+  auto attributes = routeManager_->getPendingRouteCreateAttributes(routeKey_);
+  if (!attributes) {
+    return;
+  }
+  std::get<std::optional<SaiRouteTraits::Attributes::NextHopId>>(
+      *attributes) = nextHopId;
+  if (routeMetadataSupported_) {
+    std::get<std::optional<SaiRouteTraits::Attributes::Metadata>>(
+        *attributes) = metadata;
+  }
+  XLOG(DBG2) << "ManagedRouteNextHop pending route: " << routeKey_.toString()
+             << " assign nextHopId: " << nextHopId;
+}
+
 template <typename NextHopTraitsT>
 typename NextHopTraitsT::AdapterHostKey
 ManagedRouteNextHop<NextHopTraitsT>::adapterHostKey() const {
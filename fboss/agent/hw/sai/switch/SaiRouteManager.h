@@ -22,9 +22,12 @@
 
 #include <memory>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 DECLARE_bool(disable_valid_route_check);
 DECLARE_bool(classid_for_unresolved_routes);
+DECLARE_int32(route_bulk_size);
 
 namespace facebook::fboss {
 
@@ -65,6 +68,9 @@ class ManagedRouteNextHop
  private:
   void updateMetadata(
       SaiRouteTraits::Attributes::Metadata currentMetadata) const;
+  void updatePendingRoute(
+      sai_object_id_t nextHopId,
+      std::optional<SaiRouteTraits::Attributes::Metadata> metadata) const;
 
   PortSaiId cpuPort_;
   SaiRouteManager* routeManager_;
@@ -132,9 +138,25 @@ class SaiRouteManager {
 
   void clear();
 
+  /*
+   * With --route_bulk_size set, route creates and removes are queued and
+   * programmed in SAI bulk calls of up to that many routes. Programs
+   * anything still queued, callers must flush once they are done with a
+   * batch of route updates.
+   */
+  void flushBulkRouteUpdates();
+
   std::shared_ptr<SaiObject<SaiRouteTraits>> getRouteObject(
       SaiRouteTraits::AdapterHostKey routeKey);
 
+  /*
+   * Attributes a route waiting to be bulk created will be created with, or
+   * nullptr if the route is not waiting to be created. Next hop changes
+   * before the create is flushed are applied to these instead.
+   */
+  SaiRouteTraits::CreateAttributes* getPendingRouteCreateAttributes(
+      const SaiRouteTraits::RouteEntry& entry);
+
  private:
   SaiRouteHandle* getRouteHandleImpl(
       const SaiRouteTraits::RouteEntry& entry) const;
@@ -148,6 +170,10 @@ class SaiRouteManager {
   template <typename AddrT>
   bool validRoute(const std::shared_ptr<Route<AddrT>>& swRoute);
 
+  bool bulkRouteProgramming() const;
+  void flushPendingRouteCreates();
+  void flushPendingRouteRemoves();
+
   template <
       typename NextHopTraitsT,
       typename ManagedNextHopT = ManagedNextHop<NextHopTraitsT>,
@@ -169,6 +195,14 @@ class SaiRouteManager {
   const SaiPlatform* platform_;
   folly::F14FastMap<SaiRouteTraits::RouteEntry, std::unique_ptr<SaiRouteHandle>>
       handles_;
+  // routes waiting to be bulk created, their handles are already in
+  // handles_, with a null route until the create is flushed
+  std::vector<
+      std::pair<SaiRouteTraits::RouteEntry, SaiRouteTraits::CreateAttributes>>
+      pendingRouteCreates_;
+  // handles of removed routes waiting to be bulk removed. Keeps the next
+  // hops and counters the routes use alive until the routes are gone.
+  std::vector<std::unique_ptr<SaiRouteHandle>> pendingRouteRemoves_;
 };
 
 } // namespace facebook::fboss
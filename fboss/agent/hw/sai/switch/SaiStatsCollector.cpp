@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
+
+#include "fboss/agent/hw/sai/api/PortApi.h"
+#include "fboss/agent/hw/sai/api/SaiApiLock.h"
+#include "fboss/agent/hw/sai/api/QueueApi.h"
+#include "fboss/agent/hw/sai/api/SaiApiTable.h"
+#include "fboss/agent/hw/sai/api/SaiObjectApi.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/Try.h>
+#include <folly/futures/Future.h>
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace {
+// Don't bother splitting reads across workers below this many objects
+constexpr size_t kMinBatchSize = 16;
+} // namespace
+
+namespace facebook::fboss {
+
+SaiStatsCollector::SaiStatsCollector(sai_object_id_t switchId, int numThreads)
+    : switchId_(switchId), numThreads_(std::max(numThreads, 1)) {
+  if (numThreads_ > 1 && !SaiApiLock::getInstance()->isAdaptorThreadSafe()) {
+    // Every SAI call takes the api lock, reading from several threads
+    // would only add contention
+    XLOG(INFO) << "SAI adaptor is not thread safe, reading stats from a "
+               << "single thread instead of " << numThreads_;
+    numThreads_ = 1;
+  }
+  if (numThreads_ > 1) {
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        numThreads_,
+        std::make_shared<folly::NamedThreadFactory>("SaiStatsCollector"));
+  }
+}
+
+SaiStatsCollector::~SaiStatsCollector() {
+  if (executor_) {
+    executor_->join();
+  }
+}
+
+SaiStatsCollector::Results SaiStatsCollector::collect(
+    const Requests& requests) const {
+  Results results;
+  collect<SaiPortTraits>(requests.ports, results);
+  collect<SaiQueueTraits>(requests.queues, results);
+  return results;
+}
+
+template <typename SaiObjectTraits>
+void SaiStatsCollector::collect(
+    const std::vector<Request>& requests,
+    Results& results) const {
+  using AdapterKey = typename SaiObjectTraits::AdapterKey;
+  // Group objects reading the same counters in the same mode, each group
+  // can then be read with bulk calls
+  std::map<
+      std::pair<sai_stats_mode_t, std::vector<sai_stat_id_t>>,
+      std::vector<AdapterKey>>
+      groups;
+  for (const auto& request : requests) {
+    if (request.counterIds.empty()) {
+      continue;
+    }
+    groups[{request.mode, request.counterIds}].emplace_back(request.id);
+  }
+
+  struct Batch {
+    sai_stats_mode_t mode;
+    const std::vector<sai_stat_id_t>* counterIds;
+    std::vector<AdapterKey> keys;
+  };
+  std::vector<Batch> batches;
+  for (const auto& [group, keys] : groups) {
+    size_t numThreads = numThreads_;
+    auto batchSize =
+        std::max(kMinBatchSize, (keys.size() + numThreads - 1) / numThreads);
+    for (size_t begin = 0; begin < keys.size(); begin += batchSize) {
+      auto end = std::min(keys.size(), begin + batchSize);
+      batches.push_back(Batch{
+          group.first,
+          &group.second,
+          std::vector<AdapterKey>(keys.begin() + begin, keys.begin() + end)});
+    }
+  }
+
+  auto readBatch = [this](const Batch& batch) {
+    auto counters = getObjectStatsBulk<SaiObjectTraits>(
+        switchId_, batch.keys, *batch.counterIds, batch.mode);
+    if (counters) {
+      return std::move(*counters);
+    }
+    std::vector<std::vector<uint64_t>> ret(batch.keys.size());
+    auto& api = SaiApiTable::getInstance()
+                    ->getApi<typename SaiObjectTraits::SaiApiT>();
+    for (auto idx = 0; idx < batch.keys.size(); idx++) {
+      try {
+        ret[idx] = api.template getStats<SaiObjectTraits>(
+            batch.keys[idx], *batch.counterIds, batch.mode);
+      } catch (const SaiApiError& ex) {
+        // Object was likely removed after the request was recorded
+        XLOG(DBG2) << "Failed to read stats for " << batch.keys[idx] << ": "
+                   << ex.what();
+      }
+    }
+    return ret;
+  };
+
+  std::vector<folly::Try<std::vector<std::vector<uint64_t>>>> batchCounters;
+  batchCounters.reserve(batches.size());
+  if (!executor_ || batches.size() == 1) {
+    for (const auto& batch : batches) {
+      batchCounters.push_back(folly::makeTryWith(
+          [&readBatch, &batch]() { return readBatch(batch); }));
+    }
+  } else {
+    std::vector<folly::Future<std::vector<std::vector<uint64_t>>>> futures;
+    futures.reserve(batches.size());
+    for (const auto& batch : batches) {
+      futures.push_back(folly::via(executor_.get(), [&readBatch, &batch]() {
+        return readBatch(batch);
+      }));
+    }
+    batchCounters = folly::collectAll(std::move(futures)).get();
+  }
+
+  for (auto i = 0; i < batches.size(); i++) {
+    const auto& batch = batches[i];
+    if (batchCounters[i].hasException()) {
+      // Leave this batch's objects out of results, they get read the usual
+      // way. Other batches are unaffected.
+      XLOG(ERR) << "Failed to collect stats for " << batch.keys.size()
+                << " objects: " << batchCounters[i].exception().what();
+      results.failedBatches_++;
+      continue;
+    }
+    auto& counters = batchCounters[i].value();
+    for (auto idx = 0; idx < batch.keys.size(); idx++) {
+      if (counters[idx].size() != batch.counterIds->size()) {
+        // read for this object failed
+        continue;
+      }
+      results.add(
+          static_cast<sai_object_id_t>(batch.keys[idx]),
+          *batch.counterIds,
+          batch.mode,
+          std::move(counters[idx]));
+    }
+  }
+}
+
+const std::vector<uint64_t>* SaiStatsCollector::Results::find(
+    sai_object_id_t id,
+    const std::vector<sai_stat_id_t>& counterIds,
+    sai_stats_mode_t mode) const {
+  auto requestItr = collected_.find(RequestKey(mode, counterIds));
+  if (requestItr == collected_.end()) {
+    return nullptr;
+  }
+  auto itr = requestItr->second.find(id);
+  return itr == requestItr->second.end() ? nullptr : &itr->second;
+}
+
+void SaiStatsCollector::Results::add(
+    sai_object_id_t id,
+    const std::vector<sai_stat_id_t>& counterIds,
+    sai_stats_mode_t mode,
+    std::vector<uint64_t> values) {
+  CHECK_EQ(values.size(), counterIds.size());
+  if (collected_[RequestKey(mode, counterIds)]
+          .insert_or_assign(id, std::move(values))
+          .second) {
+    size_++;
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include "folly/container/F14Map.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace folly {
+class CPUThreadPoolExecutor;
+}
+
+namespace facebook::fboss {
+
+/*
+ * Reads port and queue counters outside of saiSwitchMutex_.
+ *
+ * Stats collection runs in three phases:
+ *  - with the switch lock held, managers record the ids of the objects
+ *    and the counters they would read into Requests. These are plain
+ *    values, so they stay valid whatever state updates run afterwards.
+ *  - collect() reads the counters without the switch lock, using bulk
+ *    stats reads where the adapter supports them and per object reads
+ *    otherwise. Reads are spread across a small worker pool only if the
+ *    adapter is thread safe, as otherwise SaiApiLock serializes them
+ *    anyway.
+ *  - with the switch lock held again, managers pick their counters up from
+ *    Results instead of reading them from hardware. Requests that failed, or
+ *    whose objects went away or were created since the requests were
+ *    recorded, are simply not found in Results, and are read (or skipped)
+ *    the usual way.
+ */
+class SaiStatsCollector {
+ public:
+  using Counters = folly::F14FastMap<sai_stat_id_t, uint64_t>;
+
+  struct Request {
+    sai_object_id_t id;
+    std::vector<sai_stat_id_t> counterIds;
+    sai_stats_mode_t mode;
+  };
+
+  struct Requests {
+    std::vector<Request> ports;
+    std::vector<Request> queues;
+  };
+
+  /*
+   * Counters collected for each Request, kept per request rather than per
+   * object. An object with several requests (e.g. a queue's READ and
+   * READ_AND_CLEAR counters) may have some collected and some not, in
+   * which case only the ones not collected need reading again.
+   */
+  class Results {
+   public:
+    // Values read for id's counterIds in mode, in the order of counterIds.
+    // Returns nullptr if that request was not collected, e.g. its read
+    // failed or the object went away.
+    const std::vector<uint64_t>* find(
+        sai_object_id_t id,
+        const std::vector<sai_stat_id_t>& counterIds,
+        sai_stats_mode_t mode) const;
+    // Sets object's counterIds collected in mode on object. Returns false,
+    // leaving object untouched, if that request was not collected. The
+    // caller then reads those counters from hardware itself.
+    template <typename ObjectT>
+    bool fill(
+        ObjectT& object,
+        const std::vector<sai_stat_id_t>& counterIds,
+        sai_stats_mode_t mode) const {
+      if (counterIds.empty()) {
+        // nothing to read
+        return true;
+      }
+      auto values = find(
+          static_cast<sai_object_id_t>(object.adapterKey()), counterIds, mode);
+      if (!values) {
+        return false;
+      }
+      Counters counters;
+      counters.reserve(counterIds.size());
+      for (size_t idx = 0; idx < counterIds.size(); idx++) {
+        counters[counterIds[idx]] = (*values)[idx];
+      }
+      object.setStats(counters);
+      return true;
+    }
+    void add(
+        sai_object_id_t id,
+        const std::vector<sai_stat_id_t>& counterIds,
+        sai_stats_mode_t mode,
+        std::vector<uint64_t> values);
+    // Number of requests collected
+    size_t size() const {
+      return size_;
+    }
+    // Batches whose read failed. Their requests are not in Results and so
+    // are read the usual way.
+    size_t failedBatches() const {
+      return failedBatches_;
+    }
+
+   private:
+    friend class SaiStatsCollector;
+    using RequestKey = std::pair<sai_stats_mode_t, std::vector<sai_stat_id_t>>;
+    std::map<
+        RequestKey,
+        folly::F14FastMap<sai_object_id_t, std::vector<uint64_t>>>
+        collected_;
+    size_t size_{0};
+    size_t failedBatches_{0};
+  };
+
+  SaiStatsCollector(sai_object_id_t switchId, int numThreads);
+  ~SaiStatsCollector();
+
+  Results collect(const Requests& requests) const;
+
+ private:
+  template <typename SaiObjectTraits>
+  void collect(const std::vector<Request>& requests, Results& results) const;
+
+  sai_object_id_t switchId_;
+  int numThreads_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+};
+
+} // namespace facebook::fboss
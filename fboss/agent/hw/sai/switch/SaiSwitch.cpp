@@ -78,6 +78,7 @@
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 
 #include <folly/logging/xlog.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <boost/range/combine.hpp>
 #include <chrono>
@@ -116,6 +117,21 @@ DEFINE_int32(
     "Max number of switch reachability changes that can be enqueued to bottom-half.");
 DECLARE_bool(enable_acl_table_group);
 
+DEFINE_int32(
+    stats_collection_threads,
+    0,
+    "Number of threads reading port and queue counters, without holding the "
+    "switch lock, using bulk stats reads where supported. More than one "
+    "thread is only used if the SAI adaptor is thread safe. 0 reads "
+    "counters one object at a time with the switch lock held");
+
+DEFINE_bool(
+    sai_store_binary_warm_boot,
+    false,
+    "On graceful exit, also store the SaiStore warm boot state in a compact "
+    "binary file. Warm boot reloads from it, instead of the JSON state, "
+    "whenever it is present and current.");
+
 DEFINE_bool(
     force_recreate_acl_tables,
     false,
@@ -154,6 +170,45 @@ std::string fdbEventToString(sai_fdb_event_t event) {
 static std::set<facebook::fboss::cfg::PacketRxReason> kAllowedRxReasons = {
     facebook::fboss::cfg::PacketRxReason::TTL_1};
 
+/*
+ * Records how long each stage of a state update takes in the HwSwitch stats.
+ * A stage ends when the next one starts, or when the timer goes out of scope.
+ */
+class StateUpdateStageTimer {
+ public:
+  using StateUpdateStage =
+      facebook::fboss::HwSwitchFb303Stats::StateUpdateStage;
+
+  explicit StateUpdateStageTimer(facebook::fboss::HwSwitchFb303Stats* stats)
+      : stats_(stats) {}
+  ~StateUpdateStageTimer() {
+    finishStage();
+  }
+
+  void startStage(StateUpdateStage stage) {
+    finishStage();
+    stage_ = stage;
+    stageStart_ = std::chrono::steady_clock::now();
+  }
+
+ private:
+  void finishStage() {
+    if (!stage_) {
+      return;
+    }
+    stats_->stateUpdateStageTime(
+        *stage_,
+        duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - stageStart_)
+            .count());
+    stage_.reset();
+  }
+
+  facebook::fboss::HwSwitchFb303Stats* stats_;
+  std::optional<StateUpdateStage> stage_;
+  std::chrono::steady_clock::time_point stageStart_;
+};
+
 } // namespace
 
 namespace facebook::fboss {
@@ -596,14 +651,24 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
   return stateChangedImplLocked(delta, lockPolicy);
 }
 
+/*
+ * Stages are applied one after another, and so is every object within a
+ * stage. Nothing here runs concurrently, even when the adaptor is thread
+ * safe: managers share SaiStore and the object event publisher, neither of
+ * which is synchronized, and lockPolicy serializes every manager call on
+ * saiSwitchMutex_ anyway. The stage timings only show where the time goes.
+ */
 template <typename LockPolicyT>
 std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
     const StateDelta& delta,
     const LockPolicyT& lockPolicy) {
+  using StateUpdateStage = HwSwitchFb303Stats::StateUpdateStage;
+  StateUpdateStageTimer stageTimer(getSwitchStats());
   // Unsupported features
   checkUnsupportedDelta(
       delta.getTeFlowEntriesDelta(), managerTable_->teFlowEntryManager());
   // update switch settings first
+  stageTimer.startStage(StateUpdateStage::SWITCH_SETTINGS);
   processSwitchSettingsChanged(delta, lockPolicy);
   processLocalCapsuleSwitchIdsDelta(delta, lockPolicy);
 
@@ -619,6 +684,8 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
       false);
   processDefaultDataPlanePolicyDelta(delta, lockPolicy);
 
+  // Remove objects before the objects they depend on
+  stageTimer.startStage(StateUpdateStage::REMOVED_OBJECTS);
   for (const auto& routeDelta : delta.getFibsDelta()) {
     auto routerID = routeDelta.getOld() ? routeDelta.getOld()->getID()
                                         : routeDelta.getNew()->getID();
@@ -635,6 +702,11 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
         &SaiRouteManager::removeRoute<folly::IPAddressV6>,
         routerID);
   }
+  {
+    // program any routes left queued for bulk removal
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    managerTable_->routeManager().flushBulkRouteUpdates();
+  }
 
   for (const auto& vlanDelta : delta.getVlansDelta()) {
     processRemovedDelta(
@@ -706,6 +778,8 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
       managerTable_->portManager(),
       lockPolicy,
       &SaiPortManager::removePort);
+
+  stageTimer.startStage(StateUpdateStage::PORTS);
   processChangedDelta(
       delta.getPortsDelta(),
       managerTable_->portManager(),
@@ -747,6 +821,7 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
       lockPolicy,
       &SaiPortManager::loadPortQueuesForAddedPort);
 
+  stageTimer.startStage(StateUpdateStage::L2);
   // VOQ/Fabric switches require that the packets are not tagged with any
   // VLAN. Thus, no VLAN delta processing is needed for these switches
   if (!(getSwitchType() == cfg::SwitchType::FABRIC ||
@@ -817,6 +892,7 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
         });
   }
 
+  stageTimer.startStage(StateUpdateStage::INTERFACES_AND_NEIGHBORS);
   processChangedDelta(
       delta.getIntfsDelta(),
       managerTable_->routerInterfaceManager(),
@@ -938,6 +1014,7 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
             rid);
       };
 
+  stageTimer.startStage(StateUpdateStage::ROUTES);
   for (const auto& routeDelta : delta.getFibsDelta()) {
     auto routerID = routeDelta.getOld() ? routeDelta.getOld()->getID()
                                         : routeDelta.getNew()->getID();
@@ -946,6 +1023,13 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
     processV6RoutesChangedAndAddedDelta(
         routerID, routeDelta.getFibDelta<folly::IPAddressV6>());
   }
+  {
+    // program any routes left queued for bulk create
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    managerTable_->routeManager().flushBulkRouteUpdates();
+  }
+
+  stageTimer.startStage(StateUpdateStage::FORWARDING_FEATURES);
   {
     auto multiSwitchControlPlaneDelta = delta.getControlPlaneDelta();
     [[maybe_unused]] const auto& lock = lockPolicy.lock();
@@ -1051,6 +1135,7 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
       &SaiTunnelManager::addTunnel,
       &SaiTunnelManager::removeTunnel);
 
+  stageTimer.startStage(StateUpdateStage::ACLS);
 #if defined(TAJO_SDK_VERSION_1_42_8)
   FLAGS_enable_acl_table_group = false;
 #endif
@@ -1110,6 +1195,7 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImplLocked(
         kAclTable1);
   }
 
+  stageTimer.startStage(StateUpdateStage::POST_UPDATE);
   processPfcWatchdogGlobalDelta(delta, lockPolicy);
 
   if (platform_->getAsic()->isSupported(
@@ -1872,6 +1958,12 @@ void SaiSwitch::gracefulExitLocked(const std::lock_guard<std::mutex>& lock) {
   folly::dynamic follySwitchState = folly::dynamic::object;
   follySwitchState[kHwSwitch] = toFollyDynamicLocked(lock);
   platform_->getWarmBootHelper()->storeHwSwitchWarmBootState(follySwitchState);
+  if (FLAGS_sai_store_binary_warm_boot) {
+    // Stored after the JSON state, which it must not be older than
+    platform_->getWarmBootHelper()->storeHwSwitchBinaryWarmBootState(
+        apache::thrift::CompactSerializer::serialize<std::string>(
+            toBinaryWarmBootStateLocked(lock)));
+  }
   std::chrono::steady_clock::time_point wbSaiSwitchWrite =
       std::chrono::steady_clock::now();
   XLOG(DBG2) << "[Exit] SaiSwitch warm boot state write time: "
@@ -2309,6 +2401,7 @@ HwInitResult SaiSwitch::initLocked(
   ret.bootType = bootType_;
   std::unique_ptr<folly::dynamic> adapterKeysJson;
   std::unique_ptr<folly::dynamic> adapterKeys2AdapterHostKeysJson;
+  std::optional<SaiStoreWarmbootState> binaryWarmBootState;
 
   concurrentIndices_ = std::make_unique<ConcurrentIndices>();
   managerTable_ = std::make_unique<SaiManagerTable>(
@@ -2318,8 +2411,11 @@ HwInitResult SaiSwitch::initLocked(
   __gSaiIdToSwitch.insert_or_assign(saiSwitchId_, this);
   SaiApiTable::getInstance()->enableLogging(FLAGS_enable_sai_log);
   if (bootType_ == BootType::WARM_BOOT) {
-    auto switchStateJson = platform_->getWarmBootHelper()->getWarmBootState();
     ret.switchState = std::make_shared<SwitchState>();
+    binaryWarmBootState = getBinaryWarmBootStateLocked(lock);
+  }
+  if (bootType_ == BootType::WARM_BOOT && !binaryWarmBootState) {
+    auto switchStateJson = platform_->getWarmBootHelper()->getWarmBootState();
     if (platform_->getAsic()->isSupported(HwAsic::Feature::OBJECT_KEY_CACHE)) {
       adapterKeysJson = std::make_unique<folly::dynamic>(
           switchStateJson[kHwSwitch][kAdapterKeys]);
@@ -2335,11 +2431,18 @@ HwInitResult SaiSwitch::initLocked(
           switchStateJson[kHwSwitch][kAdapterKey2AdapterHostKey]);
     }
   }
+  const SaiStoreWarmbootState* binaryAdapterKeys{nullptr};
+  if (binaryWarmBootState &&
+      platform_->getAsic()->isSupported(HwAsic::Feature::OBJECT_KEY_CACHE)) {
+    binaryAdapterKeys = &*binaryWarmBootState;
+  }
   initStoreAndManagersLocked(
       lock,
       behavior,
       adapterKeysJson.get(),
-      adapterKeys2AdapterHostKeysJson.get());
+      adapterKeys2AdapterHostKeysJson.get(),
+      binaryAdapterKeys,
+      binaryWarmBootState ? &*binaryWarmBootState : nullptr);
   if (bootType_ != BootType::WARM_BOOT) {
     ret.switchState = getColdBootSwitchState();
     ret.switchState->publish();
@@ -2392,13 +2495,65 @@ void SaiSwitch::setFabricPortOwnershipToAdapter() {
   }
 }
 
+std::optional<SaiStoreWarmbootState> SaiSwitch::getBinaryWarmBootStateLocked(
+    const std::lock_guard<std::mutex>& /*lock*/) const {
+  auto serialized =
+      platform_->getWarmBootHelper()->getHwSwitchBinaryWarmBootState();
+  if (!serialized) {
+    return std::nullopt;
+  }
+  SaiStoreWarmbootState state;
+  try {
+    state = apache::thrift::CompactSerializer::deserialize<
+        SaiStoreWarmbootState>(*serialized);
+  } catch (const std::exception& ex) {
+    XLOG(WARN) << "Ignoring binary warm boot state, failed to decode it: "
+               << ex.what();
+    return std::nullopt;
+  }
+  if (!saiStore_->isCompatible(state)) {
+    XLOG(WARN) << "Ignoring binary warm boot state written against SAI "
+               << "version " << *state.saiApiVersion();
+    return std::nullopt;
+  }
+  if (platform_->getAsic()->isSupported(HwAsic::Feature::OBJECT_KEY_CACHE)) {
+    auto switchKeys = state.stores()->find(
+        saiObjectTypeToString(SaiSwitchTraits::ObjectType).str());
+    CHECK(switchKeys != state.stores()->end());
+    CHECK_EQ(1, switchKeys->second.objectIds()->size());
+  }
+  XLOG(DBG2) << "Warm booting SaiStore from binary warm boot state";
+  return state;
+}
+
+SaiStoreWarmbootState SaiSwitch::toBinaryWarmBootStateLocked(
+    const std::lock_guard<std::mutex>& /* lock */) const {
+  auto state = saiStore_->warmbootStateThrift();
+  auto switchObjName =
+      saiObjectTypeToString(SaiSwitchTraits::ObjectType).str();
+  auto& switchKeys = (*state.stores())[switchObjName];
+  switchKeys.objectIds() = {static_cast<int64_t>(saiSwitchId_)};
+  return state;
+}
+
+std::map<std::string, std::chrono::microseconds>
+SaiSwitch::getObjectReloadTimes() const {
+  return saiStore_->getReloadTimes();
+}
+
 void SaiSwitch::initStoreAndManagersLocked(
     const std::lock_guard<std::mutex>& /*lock*/,
     HwWriteBehavior behavior,
     const folly::dynamic* adapterKeys,
-    const folly::dynamic* adapterKeys2AdapterHostKeys) {
+    const folly::dynamic* adapterKeys2AdapterHostKeys,
+    const SaiStoreWarmbootState* binaryAdapterKeys,
+    const SaiStoreWarmbootState* binaryAdapterKeys2AdapterHostKeys) {
   saiStore_->setSwitchId(saiSwitchId_);
-  saiStore_->reload(adapterKeys, adapterKeys2AdapterHostKeys);
+  if (binaryAdapterKeys2AdapterHostKeys) {
+    saiStore_->reload(binaryAdapterKeys, binaryAdapterKeys2AdapterHostKeys);
+  } else {
+    saiStore_->reload(adapterKeys, adapterKeys2AdapterHostKeys);
+  }
   managerTable_->createSaiTableManagers(
       saiStore_.get(), platform_, concurrentIndices_.get());
   /*
@@ -19,6 +19,7 @@
 #include "fboss/agent/hw/sai/switch/SaiManagerTable.h"
 #include "fboss/agent/hw/sai/switch/SaiPortManager.h"
 #include "fboss/agent/hw/sai/switch/SaiRxPacket.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 #include "folly/MacAddress.h"
 
@@ -37,6 +38,7 @@ namespace facebook::fboss {
 
 struct ConcurrentIndices;
 class SaiStore;
+class SaiStoreWarmbootState;
 
 /*
  * This is equivalent to sai_fdb_event_notification_data_t. Copy only the
@@ -116,6 +118,12 @@ class SaiSwitch : public HwSwitch {
   CpuPortStats getCpuPortStats() const override;
   HwSwitchDropStats getSwitchDropStats() const override;
   HwSwitchWatermarkStats getSwitchWatermarkStats() const override;
+  std::chrono::microseconds getLastStatsCollectionLockHoldTime()
+      const override {
+    return std::chrono::microseconds(lastStatsCollectionLockHoldUs_.load());
+  }
+  std::map<std::string, std::chrono::microseconds> getObjectReloadTimes()
+      const override;
 
   uint64_t getDeviceWatermarkBytes() const override;
 
@@ -290,11 +298,25 @@ class SaiSwitch : public HwSwitch {
       cfg::SwitchType switchType,
       std::optional<int64_t> switchId) noexcept;
 
+  /*
+   * The SaiStore is reloaded from the binary warm boot state if
+   * binaryAdapterKeys2AdapterHostKeys is set, from the JSON one otherwise.
+   */
   void initStoreAndManagersLocked(
       const std::lock_guard<std::mutex>& lk,
       HwWriteBehavior behavior,
       const folly::dynamic* adapterKeys,
-      const folly::dynamic* adapterKeys2AdapterHostKeys);
+      const folly::dynamic* adapterKeys2AdapterHostKeys,
+      const SaiStoreWarmbootState* binaryAdapterKeys = nullptr,
+      const SaiStoreWarmbootState* binaryAdapterKeys2AdapterHostKeys =
+          nullptr);
+
+  /*
+   * Binary warm boot state stored by the last graceful exit, if there is
+   * one this agent can reload from
+   */
+  std::optional<SaiStoreWarmbootState> getBinaryWarmBootStateLocked(
+      const std::lock_guard<std::mutex>& lock) const;
 
   void unregisterCallbacksLocked(
       const std::lock_guard<std::mutex>& lock) noexcept;
@@ -319,6 +341,9 @@ class SaiSwitch : public HwSwitch {
   folly::dynamic toFollyDynamicLocked(
       const std::lock_guard<std::mutex>& lock) const;
 
+  SaiStoreWarmbootState toBinaryWarmBootStateLocked(
+      const std::lock_guard<std::mutex>& lock) const;
+
   void switchRunStateChangedImplLocked(
       const std::lock_guard<std::mutex>& lock,
       SwitchRunState newState);
@@ -603,6 +628,8 @@ class SaiSwitch : public HwSwitch {
   int64_t watermarkStatsUpdateTime_{0};
   int64_t voqStatsUpdateTime_{0};
   int64_t cableLengthStatsUpdateTime_{0};
+  std::unique_ptr<SaiStatsCollector> statsCollector_;
+  std::atomic<int64_t> lastStatsCollectionLockHoldUs_{0};
   cfg::AsicType asicType_;
 
   std::map<PortID, phy::PhyInfo> lastPhyInfos_;
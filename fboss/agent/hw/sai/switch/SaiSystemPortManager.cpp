@@ -309,10 +309,29 @@ SaiSystemPortHandle* SaiSystemPortManager::getSystemPortHandleImpl(
   return itr->second.get();
 }
 
+void SaiSystemPortManager::addStatsRequests(
+    SystemPortID portId,
+    bool updateWatermarks,
+    bool updateVoqStats,
+    SaiStatsCollector::Requests& requests) {
+  auto handlesItr = handles_.find(portId);
+  if (handlesItr == handles_.end() ||
+      portStats_.find(portId) == portStats_.end() ||
+      !(updateVoqStats || updateWatermarks)) {
+    return;
+  }
+  managerTable_->queueManager().addVoqStatsRequests(
+      handlesItr->second->configuredQueues,
+      updateWatermarks,
+      updateVoqStats,
+      requests);
+}
+
 void SaiSystemPortManager::updateStats(
     SystemPortID portId,
     bool updateWatermarks,
-    bool updateVoqStats) {
+    bool updateVoqStats,
+    const SaiStatsCollector::Results* collected) {
   auto handlesItr = handles_.find(portId);
   if (handlesItr == handles_.end()) {
     return;
@@ -335,7 +354,8 @@ void SaiSystemPortManager::updateStats(
         handle->configuredQueues,
         curPortStats,
         updateWatermarks,
-        updateVoqStats);
+        updateVoqStats,
+        collected);
   }
   portStats_[portId]->updateStats(curPortStats, now);
 }
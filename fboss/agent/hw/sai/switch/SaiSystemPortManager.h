@@ -14,6 +14,7 @@
 #include "fboss/agent/hw/sai/store/SaiObject.h"
 #include "fboss/agent/hw/sai/switch/SaiQosMapManager.h"
 #include "fboss/agent/hw/sai/switch/SaiQueueManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SystemPort.h"
 #include "fboss/agent/types.h"
@@ -83,8 +84,16 @@ class SaiSystemPortManager {
   Handles::const_iterator end() const {
     return handles_.end();
   }
-  void
-  updateStats(SystemPortID portId, bool updateWatermarks, bool updateVoqStats);
+  void addStatsRequests(
+      SystemPortID portId,
+      bool updateWatermarks,
+      bool updateVoqStats,
+      SaiStatsCollector::Requests& requests);
+  void updateStats(
+      SystemPortID portId,
+      bool updateWatermarks,
+      bool updateVoqStats,
+      const SaiStatsCollector::Results* collected = nullptr);
 
   void setQosPolicy(
       SystemPortID portId,
@@ -22,7 +22,32 @@
 #include "fboss/agent/hw/sai/switch/SaiSwitchManager.h"
 #include "fboss/agent/hw/sai/switch/SaiSystemPortManager.h"
 
+#include <chrono>
+#include <optional>
+
 DECLARE_int32(update_cable_length_stats_s);
+DECLARE_int32(stats_collection_threads);
+
+namespace {
+// Locks mutex for its lifetime, adding how long it was held to heldFor
+class TimedLockGuard {
+ public:
+  TimedLockGuard(
+      std::mutex& mutex,
+      std::chrono::steady_clock::duration& heldFor)
+      : guard_(mutex),
+        heldFor_(heldFor),
+        start_(std::chrono::steady_clock::now()) {}
+  ~TimedLockGuard() {
+    heldFor_ += std::chrono::steady_clock::now() - start_;
+  }
+
+ private:
+  std::lock_guard<std::mutex> guard_;
+  std::chrono::steady_clock::duration& heldFor_;
+  std::chrono::steady_clock::time_point start_;
+};
+} // namespace
 
 namespace facebook::fboss {
 
@@ -57,12 +82,45 @@ void SaiSwitch::updateStatsImpl() {
   if (updateCableLengths) {
     cableLengthStatsUpdateTime_ = now;
   }
+  std::chrono::steady_clock::duration lockHeld{0};
+
+  // Read port and queue counters up front without holding the switch lock,
+  // managers then pick them up from collected instead of reading them.
+  std::optional<SaiStatsCollector::Results> collected;
+  if (FLAGS_stats_collection_threads > 0) {
+    if (!statsCollector_) {
+      statsCollector_ = std::make_unique<SaiStatsCollector>(
+          saiSwitchId_, FLAGS_stats_collection_threads);
+    }
+    SaiStatsCollector::Requests requests;
+    {
+      TimedLockGuard locked(saiSwitchMutex_, lockHeld);
+      for (auto portsIter = concurrentIndices_->portSaiId2PortInfo.begin();
+           portsIter != concurrentIndices_->portSaiId2PortInfo.end();
+           ++portsIter) {
+        managerTable_->portManager().addStatsRequests(
+            portsIter->second.portID, updateWatermarks, requests);
+      }
+      for (auto sysPortsIter = concurrentIndices_->sysPortIds.begin();
+           sysPortsIter != concurrentIndices_->sysPortIds.end();
+           ++sysPortsIter) {
+        managerTable_->systemPortManager().addStatsRequests(
+            sysPortsIter->second, updateWatermarks, updateVoqStats, requests);
+      }
+    }
+    collected = statsCollector_->collect(requests);
+    if (collected->failedBatches()) {
+      getSwitchStats()->statsCollectionFailed();
+    }
+  }
+  const auto* collectedStats = collected ? &*collected : nullptr;
+
   int64_t missingCount = 0, mismatchCount = 0;
   auto portsIter = concurrentIndices_->portSaiId2PortInfo.begin();
   std::map<PortID, multiswitch::FabricConnectivityDelta> connectivityDelta;
   while (portsIter != concurrentIndices_->portSaiId2PortInfo.end()) {
     {
-      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+      TimedLockGuard locked(saiSwitchMutex_, lockHeld);
       auto endpointOpt = managerTable_->portManager().getFabricConnectivity(
           portsIter->second.portID);
       if (endpointOpt.has_value()) {
@@ -81,7 +139,10 @@ void SaiSwitch::updateStatsImpl() {
         }
       }
       managerTable_->portManager().updateStats(
-          portsIter->second.portID, updateWatermarks, updateCableLengths);
+          portsIter->second.portID,
+          updateWatermarks,
+          updateCableLengths,
+          collectedStats);
     }
     ++portsIter;
   }
@@ -92,46 +153,51 @@ void SaiSwitch::updateStatsImpl() {
   auto sysPortsIter = concurrentIndices_->sysPortIds.begin();
   while (sysPortsIter != concurrentIndices_->sysPortIds.end()) {
     {
-      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+      TimedLockGuard locked(saiSwitchMutex_, lockHeld);
       managerTable_->systemPortManager().updateStats(
-          sysPortsIter->second, updateWatermarks, updateVoqStats);
+          sysPortsIter->second,
+          updateWatermarks,
+          updateVoqStats,
+          collectedStats);
     }
     ++sysPortsIter;
   }
   auto lagsIter = concurrentIndices_->aggregatePortIds.begin();
   while (lagsIter != concurrentIndices_->aggregatePortIds.end()) {
     {
-      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+      TimedLockGuard locked(saiSwitchMutex_, lockHeld);
       managerTable_->lagManager().updateStats(lagsIter->second);
     }
     ++lagsIter;
   }
   if (platform_->getAsic()->isSupported(HwAsic::Feature::CPU_PORT)) {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    TimedLockGuard locked(saiSwitchMutex_, lockHeld);
     managerTable_->hostifManager().updateStats(updateWatermarks);
   }
 
   {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    TimedLockGuard locked(saiSwitchMutex_, lockHeld);
     managerTable_->bufferManager().updateStats();
   }
   {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    TimedLockGuard locked(saiSwitchMutex_, lockHeld);
     HwResourceStatsPublisher(getPlatform()->getMultiSwitchStatsPrefix())
         .publish(hwResourceStats_);
   }
   {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    TimedLockGuard locked(saiSwitchMutex_, lockHeld);
     managerTable_->aclTableManager().updateStats();
   }
   {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    TimedLockGuard locked(saiSwitchMutex_, lockHeld);
     managerTable_->counterManager().updateStats();
   }
   {
-    std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+    TimedLockGuard locked(saiSwitchMutex_, lockHeld);
     managerTable_->switchManager().updateStats(updateWatermarks);
   }
+  lastStatsCollectionLockHoldUs_ =
+      std::chrono::duration_cast<std::chrono::microseconds>(lockHeld).count();
   reportAsymmetricTopology();
   reportInterPortGroupCableSkew();
   if (!connectivityDelta.empty()) {
@@ -32,6 +32,7 @@ _COMMON_SRCS = [
     "SaiRxPacket.cpp",
     "SaiSamplePacketManager.cpp",
     "SaiSchedulerManager.cpp",
+    "SaiStatsCollector.cpp",
     "SaiSwitch.cpp",
     "SaiSwitchManager.cpp",
     "SaiSystemPortManager.cpp",
@@ -157,6 +158,9 @@ def _sai_switch_lib(sai_impl, is_npu):
             "//fboss/lib:ref_map",
             "//folly/concurrency:concurrent_hash_map",
             "//folly/container:f14_hash",
+            "//folly/executors:cpu_thread_pool_executor",
+            "//folly/executors/thread_factory:named_thread_factory",
+            "//folly/futures:core",
             "//thrift/lib/cpp/util:enum_utils",
             "//fboss/lib/phy:phy_utils",
             "//fboss/mka_service/if:mka_structs-cpp2-types",
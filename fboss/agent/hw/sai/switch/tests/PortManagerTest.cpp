@@ -11,6 +11,7 @@
 #include "fboss/agent/hw/StatsConstants.h"
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiPortManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/hw/sai/switch/tests/ManagerTestBase.h"
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 #include "fboss/agent/platforms/sai/SaiPlatformPort.h"
@@ -390,6 +391,69 @@ TEST_F(PortManagerTest, updateStats) {
   }
 }
 
+TEST_F(PortManagerTest, updateStatsFromCollectedStats) {
+  std::shared_ptr<Port> swPort = makePort(p0);
+  saiManagerTable->portManager().addPort(swPort);
+  auto handle = saiManagerTable->portManager().getPortHandle(swPort->getID());
+  auto portSaiId = static_cast<sai_object_id_t>(handle->port->adapterKey());
+  SaiStatsCollector::Requests requests;
+  saiManagerTable->portManager().addStatsRequests(
+      swPort->getID(), true, requests);
+  ASSERT_EQ(requests.ports.size(), 1);
+  const auto& request = requests.ports[0];
+  EXPECT_EQ(request.id, portSaiId);
+  EXPECT_EQ(request.mode, SAI_STATS_MODE_READ);
+  auto inOctetsItr = std::find(
+      request.counterIds.begin(),
+      request.counterIds.end(),
+      SAI_PORT_STAT_IF_IN_OCTETS);
+  ASSERT_NE(inOctetsItr, request.counterIds.end());
+
+  SaiStatsCollector collector(0, 2);
+  auto collected = collector.collect(requests);
+  auto values = collected.find(portSaiId, request.counterIds, request.mode);
+  ASSERT_NE(values, nullptr);
+  EXPECT_EQ(values->size(), request.counterIds.size());
+
+  // Fake SAI counters are always 0, hand updateStats collected values it
+  // could not have read from hardware
+  SaiStatsCollector::Results results;
+  std::vector<uint64_t> collectedValues;
+  for (size_t idx = 0; idx < request.counterIds.size(); idx++) {
+    collectedValues.push_back(1000 + idx);
+  }
+  results.add(portSaiId, request.counterIds, request.mode, collectedValues);
+  saiManagerTable->portManager().updateStats(
+      swPort->getID(), true, false, &results);
+  auto portStats =
+      saiManagerTable->portManager().getPortStats().at(swPort->getID());
+  EXPECT_EQ(
+      *portStats.inBytes_(),
+      1000 + std::distance(request.counterIds.begin(), inOctetsItr));
+}
+
+#if SAI_API_VERSION >= SAI_VERSION(1, 11, 0)
+// Relies on fake bulk stats reads, per port reads in fake sai succeed even
+// for ports that don't exist
+TEST_F(PortManagerTest, collectStatsForRemovedPort) {
+  std::shared_ptr<Port> swPort = makePort(p0);
+  saiManagerTable->portManager().addPort(swPort);
+  auto handle = saiManagerTable->portManager().getPortHandle(swPort->getID());
+  auto portSaiId = static_cast<sai_object_id_t>(handle->port->adapterKey());
+  SaiStatsCollector::Requests requests;
+  saiManagerTable->portManager().addStatsRequests(
+      swPort->getID(), false, requests);
+  // port goes away between recording requests and collecting them
+  saiManagerTable->portManager().removePort(swPort);
+  SaiStatsCollector collector(0, 1);
+  auto collected = collector.collect(requests);
+  EXPECT_EQ(
+      collected.find(
+          portSaiId, requests.ports[0].counterIds, requests.ports[0].mode),
+      nullptr);
+}
+#endif
+
 TEST_F(PortManagerTest, portDisableStopsCounterExport) {
   std::shared_ptr<Port> swPort = makePort(p0);
   CHECK(swPort->isEnabled());
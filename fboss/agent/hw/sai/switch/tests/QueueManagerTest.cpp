@@ -12,12 +12,14 @@
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 #include "fboss/agent/hw/sai/switch/SaiPortManager.h"
 #include "fboss/agent/hw/sai/switch/SaiQueueManager.h"
+#include "fboss/agent/hw/sai/switch/SaiStatsCollector.h"
 #include "fboss/agent/hw/sai/switch/SaiSystemPortManager.h"
 #include "fboss/agent/hw/sai/switch/tests/ManagerTestBase.h"
 #include "fboss/agent/state/PortQueue.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/types.h"
 
+#include <algorithm>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -300,6 +302,65 @@ TEST_F(QueueManagerTest, addPortQueueAndCheckStats) {
       swPort->getName(), queueConfig, ExpectExport::EXPORT, portStat);
 }
 
+TEST_F(QueueManagerTest, updateStatsFromCollectedStats) {
+  auto p0 = testInterfaces[0].remoteHosts[0].port;
+  std::shared_ptr<Port> swPort = makePort(p0);
+  auto newPort = swPort->clone();
+  std::vector<uint8_t> queueIds = {1, 2};
+  newPort->resetPortQueues(makeQueueConfig({queueIds}));
+  saiManagerTable->portManager().changePort(swPort, newPort);
+  auto portId = newPort->getID();
+  SaiStatsCollector::Requests requests;
+  saiManagerTable->portManager().addStatsRequests(
+      portId, true /* updateWatermarks */, requests);
+  ASSERT_FALSE(requests.queues.empty());
+
+  // Fake SAI counters are always 0, so collect base + counter id for each
+  // counter instead. Queue watermarks are left out unless withWatermarks.
+  auto collect = [&requests](uint64_t base, bool withWatermarks) {
+    SaiStatsCollector::Results results;
+    for (const auto& request : requests.queues) {
+      auto isWatermark =
+          std::find(
+              request.counterIds.begin(),
+              request.counterIds.end(),
+              SAI_QUEUE_STAT_WATERMARK_BYTES) != request.counterIds.end();
+      if (request.counterIds.empty() || (isWatermark && !withWatermarks)) {
+        continue;
+      }
+      std::vector<uint64_t> values;
+      for (auto counterId : request.counterIds) {
+        values.push_back(base + counterId);
+      }
+      results.add(
+          request.id, request.counterIds, request.mode, std::move(values));
+    }
+    return results;
+  };
+
+  auto results = collect(1000, true);
+  saiManagerTable->portManager().updateStats(portId, true, false, &results);
+  auto portStats = saiManagerTable->portManager().getPortStats().at(portId);
+  for (auto queueId : queueIds) {
+    EXPECT_EQ(
+        portStats.queueOutBytes_()->at(queueId), 1000 + SAI_QUEUE_STAT_BYTES);
+    EXPECT_EQ(
+        portStats.queueWatermarkBytes_()->at(queueId),
+        1000 + SAI_QUEUE_STAT_WATERMARK_BYTES);
+  }
+
+  // Watermarks not collected, e.g. their batch failed. They are read from
+  // hardware, while the queue counters that were collected are still used.
+  results = collect(2000, false);
+  saiManagerTable->portManager().updateStats(portId, true, false, &results);
+  portStats = saiManagerTable->portManager().getPortStats().at(portId);
+  for (auto queueId : queueIds) {
+    EXPECT_EQ(
+        portStats.queueOutBytes_()->at(queueId), 2000 + SAI_QUEUE_STAT_BYTES);
+    EXPECT_EQ(portStats.queueWatermarkBytes_()->at(queueId), 0);
+  }
+}
+
 TEST_F(QueueManagerTest, checkSysPortVoqStats) {
   auto sysPort = firstSysPort();
   saiManagerTable->systemPortManager().updateStats(
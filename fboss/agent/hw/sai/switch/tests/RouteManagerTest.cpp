@@ -16,6 +16,8 @@
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/types.h"
 
+#include <gflags/gflags.h>
+
 #include <optional>
 
 using namespace facebook::fboss;
@@ -217,6 +219,82 @@ TEST_F(RouteManagerTest, removeRoute) {
   EXPECT_FALSE(saiRouteHandle);
 }
 
+TEST_F(RouteManagerTest, bulkAddRemoveRoutes) {
+  FLAGS_route_bulk_size = 2;
+  auto& routeManager = saiManagerTable->routeManager();
+  auto& routeApi = saiApiTable->routeApi();
+  auto r1 = makeRoute(tr1);
+  tr2.nextHopInterfaces = {testInterfaces.at(1)};
+  auto r2 = makeRoute(tr2);
+  auto entry1 = routeManager.routeEntryFromSwRoute(RouterID(0), r1);
+  auto entry2 = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+  auto numRoutes = fs->routeManager.map().size();
+
+  // first route is queued, second fills the batch and creates both
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  EXPECT_FALSE(routeManager.getRouteHandle(entry1)->route);
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+  auto route1 = routeManager.getRouteHandle(entry1)->route;
+  ASSERT_TRUE(route1);
+  ASSERT_TRUE(routeManager.getRouteHandle(entry2)->route);
+  EXPECT_EQ(
+      routeApi.getAttribute(entry1, SaiRouteTraits::Attributes::NextHopId{}),
+      GET_OPT_ATTR(Route, NextHopId, route1->attributes()));
+  route1.reset();
+
+  routeManager.removeRoute(r1, RouterID(0));
+  EXPECT_FALSE(routeManager.getRouteHandle(entry1));
+  // not removed from hw until the batch is flushed
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 2);
+  routeManager.flushBulkRouteUpdates();
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 1);
+  routeManager.removeRoute(r2, RouterID(0));
+  routeManager.flushBulkRouteUpdates();
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+  FLAGS_route_bulk_size = 0;
+}
+
+TEST_F(RouteManagerTest, bulkRouteNextHopChangeBeforeCreate) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_route_bulk_size = 2;
+  auto& routeManager = saiManagerTable->routeManager();
+  auto& routeApi = saiApiTable->routeApi();
+  auto cpuPort = saiManagerTable->switchManager().getCpuPort();
+  auto intf = testInterfaces.at(1);
+  auto arpEntry = makeArpEntry(intf.id, intf.remoteHosts.at(0));
+  tr1.nextHopInterfaces = {intf};
+  tr2.nextHopInterfaces = {intf};
+  auto r1 = makeRoute(tr1);
+  auto r2 = makeRoute(tr2);
+  auto entry1 = routeManager.routeEntryFromSwRoute(RouterID(0), r1);
+  auto entry2 = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+
+  // next hop goes away while the route waits to be created
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  ASSERT_FALSE(routeManager.getRouteHandle(entry1)->route);
+  saiManagerTable->neighborManager().removeNeighbor(arpEntry);
+  routeManager.flushBulkRouteUpdates();
+  ASSERT_TRUE(routeManager.getRouteHandle(entry1)->route);
+  EXPECT_EQ(
+      routeApi.getAttribute(entry1, SaiRouteTraits::Attributes::NextHopId{}),
+      cpuPort);
+
+  // next hop comes back while the route waits to be created
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+  ASSERT_FALSE(routeManager.getRouteHandle(entry2)->route);
+  saiManagerTable->neighborManager().addNeighbor(arpEntry);
+  routeManager.flushBulkRouteUpdates();
+  auto handle2 = routeManager.getRouteHandle(entry2);
+  ASSERT_TRUE(handle2->route);
+  EXPECT_NE(handle2->nextHopAdapterKey(), cpuPort);
+  EXPECT_EQ(
+      routeApi.getAttribute(entry2, SaiRouteTraits::Attributes::NextHopId{}),
+      handle2->nextHopAdapterKey());
+  EXPECT_EQ(
+      routeApi.getAttribute(entry1, SaiRouteTraits::Attributes::NextHopId{}),
+      handle2->nextHopAdapterKey());
+}
+
 TEST_F(RouteManagerTest, addDupRoute) {
   auto r = makeRoute(tr1);
   saiManagerTable->routeManager().addRoute<folly::IPAddressV4>(r, RouterID(0));
@@ -78,6 +78,47 @@ sai_status_t wrap_get_route_entry_attribute(
       route_entry, attr_count, attr_list);
 }
 
+/*
+ * Bulk calls are logged as one create/remove call per route, so the
+ * generated replayer stays a sequence of single object calls. As with the
+ * single object calls, routes are logged before the bulk call is made.
+ */
+sai_status_t wrap_create_route_entries(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  SaiTracer::getInstance()->logRouteEntryBulkCreateFn(
+      object_count, route_entry, attr_count, attr_list);
+  auto begin = FLAGS_enable_elapsed_time_log
+      ? std::chrono::system_clock::now()
+      : std::chrono::system_clock::time_point::min();
+  auto rv = SaiTracer::getInstance()->routeApi_->create_route_entries(
+      object_count, route_entry, attr_count, attr_list, mode, object_statuses);
+  SaiTracer::getInstance()->logBulkPostInvocation(
+      object_count, object_statuses, rv, begin);
+  return rv;
+}
+
+sai_status_t wrap_remove_route_entries(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  SaiTracer::getInstance()->logRouteEntryBulkRemoveFn(
+      object_count, route_entry);
+  auto begin = FLAGS_enable_elapsed_time_log
+      ? std::chrono::system_clock::now()
+      : std::chrono::system_clock::time_point::min();
+  auto rv = SaiTracer::getInstance()->routeApi_->remove_route_entries(
+      object_count, route_entry, mode, object_statuses);
+  SaiTracer::getInstance()->logBulkPostInvocation(
+      object_count, object_statuses, rv, begin);
+  return rv;
+}
+
 sai_route_api_t* wrappedRouteApi() {
   static sai_route_api_t routeWrappers;
 
@@ -85,6 +126,8 @@ sai_route_api_t* wrappedRouteApi() {
   routeWrappers.remove_route_entry = &wrap_remove_route_entry;
   routeWrappers.set_route_entry_attribute = &wrap_set_route_entry_attribute;
   routeWrappers.get_route_entry_attribute = &wrap_get_route_entry_attribute;
+  routeWrappers.create_route_entries = &wrap_create_route_entries;
+  routeWrappers.remove_route_entries = &wrap_remove_route_entries;
 
   return &routeWrappers;
 }
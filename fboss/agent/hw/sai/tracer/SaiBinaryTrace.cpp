@@ -0,0 +1,313 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/api/SaiVersion.h"
+
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/logging/xlog.h>
+
+namespace {
+
+// Common layout of the sai_*_list_t structs
+struct SaiTraceList {
+  uint32_t count;
+  void* list;
+};
+
+// Flush thread writes at most this many bytes at once
+constexpr size_t kMaxFlushBytes = 1 << 20;
+
+template <typename T>
+T readAt(const sai_attribute_value_t& value, uint16_t offset) {
+  T t;
+  std::memcpy(&t, reinterpret_cast<const uint8_t*>(&value) + offset, sizeof(T));
+  return t;
+}
+
+template <typename T>
+void writeAt(sai_attribute_value_t& value, uint16_t offset, const T& t) {
+  std::memcpy(reinterpret_cast<uint8_t*>(&value) + offset, &t, sizeof(T));
+}
+
+template <typename T>
+void appendBytes(std::string& buf, const T& t) {
+  buf.append(reinterpret_cast<const char*>(&t), sizeof(T));
+}
+
+template <typename T>
+T consume(folly::ByteRange& buf) {
+  if (buf.size() < sizeof(T)) {
+    throw facebook::fboss::FbossError("Truncated SAI binary trace");
+  }
+  T t;
+  std::memcpy(&t, buf.data(), sizeof(T));
+  buf.advance(sizeof(T));
+  return t;
+}
+
+std::string consumeBytes(folly::ByteRange& buf, size_t size) {
+  if (buf.size() < size) {
+    throw facebook::fboss::FbossError("Truncated SAI binary trace");
+  }
+  std::string bytes(reinterpret_cast<const char*>(buf.data()), size);
+  buf.advance(size);
+  return bytes;
+}
+
+std::string consumeString(folly::ByteRange& buf) {
+  auto end = std::find(buf.begin(), buf.end(), '\0');
+  if (end == buf.end()) {
+    throw facebook::fboss::FbossError("Truncated SAI binary trace");
+  }
+  auto str = consumeBytes(buf, end - buf.begin());
+  buf.advance(1);
+  return str;
+}
+
+} // namespace
+
+namespace facebook::fboss {
+
+SaiTraceRecord::SaiTraceRecord() {
+  // Zero the padding as well, records are written as is
+  std::memset(&header, 0, sizeof(header));
+}
+
+SaiTraceRecord::SaiTraceRecord(
+    SaiTraceOp op,
+    int32_t objectType,
+    std::string name)
+    : SaiTraceRecord() {
+  header.op = op;
+  header.objectType = objectType;
+  header.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+  this->name = std::move(name);
+}
+
+void SaiTraceRecord::addAttribute(
+    const sai_attribute_t& attr,
+    SaiTraceAttrKind kind,
+    uint16_t offset,
+    uint32_t elemSize) {
+  SaiTraceAttribute traceAttr;
+  std::memset(&traceAttr, 0, sizeof(traceAttr));
+  traceAttr.id = attr.id;
+  traceAttr.kind = kind;
+  traceAttr.offset = offset;
+  traceAttr.elemSize = elemSize;
+  traceAttr.value = attr.value;
+
+  std::string list;
+  if (kind == SaiTraceAttrKind::LIST || kind == SaiTraceAttrKind::OID_LIST) {
+    auto saiList = readAt<SaiTraceList>(attr.value, offset);
+    if (saiList.list) {
+      list.assign(
+          static_cast<const char*>(saiList.list),
+          static_cast<size_t>(saiList.count) * elemSize);
+      traceAttr.listBytes = list.size();
+      // Pointers are meaningless in the trace, the list is restored on read
+      saiList.list = nullptr;
+      writeAt(traceAttr.value, offset, saiList);
+    } else {
+      // Nothing to follow, keep the NULL list as is
+      traceAttr.kind = SaiTraceAttrKind::PLAIN;
+    }
+  }
+  attributes_.push_back(traceAttr);
+  lists_.push_back(std::move(list));
+}
+
+std::vector<sai_attribute_t> SaiTraceRecord::attributes() {
+  std::vector<sai_attribute_t> attrs(attributes_.size());
+  for (auto i = 0; i < attributes_.size(); ++i) {
+    attrs[i].id = attributes_[i].id;
+    attrs[i].value = attributes_[i].value;
+    if (attributes_[i].listBytes) {
+      auto offset = attributes_[i].offset;
+      auto saiList = readAt<SaiTraceList>(attrs[i].value, offset);
+      saiList.list = lists_[i].data();
+      writeAt(attrs[i].value, offset, saiList);
+    }
+  }
+  return attrs;
+}
+
+void SaiTraceRecord::remapObjectIds(
+    const std::function<sai_object_id_t(sai_object_id_t)>& remap) {
+  for (auto i = 0; i < attributes_.size(); ++i) {
+    auto& attr = attributes_[i];
+    if (attr.kind == SaiTraceAttrKind::OID) {
+      writeAt(
+          attr.value,
+          attr.offset,
+          remap(readAt<sai_object_id_t>(attr.value, attr.offset)));
+    } else if (attr.kind == SaiTraceAttrKind::OID_LIST) {
+      auto* oids = reinterpret_cast<sai_object_id_t*>(lists_[i].data());
+      for (auto j = 0; j < lists_[i].size() / sizeof(sai_object_id_t); ++j) {
+        oids[j] = remap(oids[j]);
+      }
+    }
+  }
+}
+
+std::string SaiTraceRecord::serialize() const {
+  auto recordHeader = header;
+  recordHeader.attrCount = attributes_.size();
+  recordHeader.nameSize = name.size();
+
+  std::string buf;
+  buf.reserve(
+      sizeof(recordHeader) + attributes_.size() * sizeof(SaiTraceAttribute));
+  appendBytes(buf, recordHeader);
+  for (const auto& attr : attributes_) {
+    appendBytes(buf, attr);
+  }
+  for (const auto& list : lists_) {
+    buf.append(list);
+  }
+  buf.append(name);
+  for (const auto& [key, value] : profile) {
+    buf.append(key.c_str(), key.size() + 1);
+    buf.append(value.c_str(), value.size() + 1);
+  }
+
+  // Size is only known once everything is in
+  uint32_t size = buf.size();
+  std::memcpy(buf.data() + offsetof(SaiTraceRecordHeader, size), &size, 4);
+  return buf;
+}
+
+std::optional<SaiTraceRecord> SaiTraceRecord::deserialize(
+    folly::ByteRange& buf) {
+  if (buf.empty()) {
+    return std::nullopt;
+  }
+  auto recordHeader = consume<SaiTraceRecordHeader>(buf);
+  if (recordHeader.size < sizeof(recordHeader) ||
+      recordHeader.size - sizeof(recordHeader) > buf.size()) {
+    throw FbossError("Truncated SAI binary trace record");
+  }
+  auto recordBuf = buf.subpiece(0, recordHeader.size - sizeof(recordHeader));
+  buf.advance(recordBuf.size());
+
+  SaiTraceRecord record;
+  record.header = recordHeader;
+  record.attributes_.reserve(recordHeader.attrCount);
+  for (auto i = 0; i < recordHeader.attrCount; ++i) {
+    record.attributes_.push_back(consume<SaiTraceAttribute>(recordBuf));
+  }
+  for (const auto& attr : record.attributes_) {
+    record.lists_.push_back(consumeBytes(recordBuf, attr.listBytes));
+  }
+  record.name = consumeBytes(recordBuf, recordHeader.nameSize);
+  while (!recordBuf.empty()) {
+    auto key = consumeString(recordBuf);
+    auto value = consumeString(recordBuf);
+    record.profile.emplace_back(std::move(key), std::move(value));
+  }
+  return record;
+}
+
+SaiBinaryTraceWriter::SaiBinaryTraceWriter(
+    const std::string& path,
+    size_t queueSize)
+    : file_(path, O_WRONLY | O_CREAT | O_TRUNC, 0644), queue_(queueSize) {
+  SaiBinaryTraceFileHeader fileHeader;
+  std::memset(&fileHeader, 0, sizeof(fileHeader));
+  fileHeader.magic = kSaiBinaryTraceMagic;
+  fileHeader.version = kSaiBinaryTraceVersion;
+  fileHeader.saiApiVersion = SAI_API_VERSION;
+  fileHeader.attrValueSize = sizeof(sai_attribute_value_t);
+  fileHeader.recordHeaderSize = sizeof(SaiTraceRecordHeader);
+  if (folly::writeFull(file_.fd(), &fileHeader, sizeof(fileHeader)) < 0) {
+    throw FbossError("Failed to write SAI binary trace header to ", path);
+  }
+  flushThread_ = std::thread([this]() { flushLoop(); });
+}
+
+SaiBinaryTraceWriter::~SaiBinaryTraceWriter() {
+  // An empty record tells the flush thread to stop once the queue is drained
+  queue_.blockingWrite(std::string());
+  flushThread_.join();
+  if (auto dropped = totalDropped_.load()) {
+    XLOG(WARN) << "Dropped " << dropped << " records from SAI binary trace";
+  }
+}
+
+void SaiBinaryTraceWriter::append(const SaiTraceRecord& record) {
+  if (auto dropped = dropped_.exchange(0, std::memory_order_relaxed)) {
+    SaiTraceRecord droppedRecord(SaiTraceOp::DROPPED, SAI_OBJECT_TYPE_NULL);
+    droppedRecord.header.objectId = dropped;
+    if (!queue_.writeIfNotFull(droppedRecord.serialize())) {
+      dropped_.fetch_add(dropped, std::memory_order_relaxed);
+    }
+  }
+  if (!queue_.writeIfNotFull(record.serialize())) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    totalDropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void SaiBinaryTraceWriter::flushLoop() {
+  std::string buf;
+  std::string record;
+  bool stop = false;
+  while (!stop) {
+    queue_.blockingRead(record);
+    stop = record.empty();
+    buf.append(record);
+    // Batch whatever else is already queued into the same write
+    while (!stop && buf.size() < kMaxFlushBytes && queue_.read(record)) {
+      stop = record.empty();
+      buf.append(record);
+    }
+    if (folly::writeFull(file_.fd(), buf.data(), buf.size()) < 0) {
+      XLOG(ERR) << "Failed to write SAI binary trace: "
+                << folly::errnoStr(errno);
+    }
+    buf.clear();
+  }
+}
+
+SaiBinaryTraceReader::SaiBinaryTraceReader(const std::string& path) {
+  if (!folly::readFile(path.c_str(), buf_)) {
+    throw FbossError("Failed to read SAI binary trace ", path);
+  }
+  remaining_ = folly::ByteRange(folly::StringPiece(buf_));
+  fileHeader_ = consume<SaiBinaryTraceFileHeader>(remaining_);
+  if (fileHeader_.magic != kSaiBinaryTraceMagic) {
+    throw FbossError(path, " is not a SAI binary trace");
+  }
+  if (fileHeader_.version != kSaiBinaryTraceVersion) {
+    throw FbossError(
+        "Unsupported SAI binary trace version ", fileHeader_.version);
+  }
+  if (fileHeader_.saiApiVersion != SAI_API_VERSION ||
+      fileHeader_.attrValueSize != sizeof(sai_attribute_value_t) ||
+      fileHeader_.recordHeaderSize != sizeof(SaiTraceRecordHeader)) {
+    throw FbossError(
+        "SAI binary trace was written for SAI version ",
+        fileHeader_.saiApiVersion,
+        ", expected ",
+        SAI_API_VERSION);
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,204 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <folly/File.h>
+#include <folly/MPMCQueue.h>
+#include <folly/Range.h>
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace facebook::fboss {
+
+/*
+ * Compact binary alternative to the C source written by SaiTracer.
+ *
+ * A trace is a SaiBinaryTraceFileHeader followed by records, each made of a
+ * SaiTraceRecordHeader, attrCount SaiTraceAttribute, the elements of the list
+ * attributes, the function name and, for API_INITIALIZE, the SAI profile as
+ * NUL terminated key/value pairs. Structs are written as laid out in memory,
+ * so a trace is read back by a binary built for the same architecture and
+ * SAI version.
+ */
+
+constexpr uint32_t kSaiBinaryTraceMagic = 0x54494153; // "SAIT"
+constexpr uint32_t kSaiBinaryTraceVersion = 1;
+
+struct SaiBinaryTraceFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t saiApiVersion;
+  uint32_t attrValueSize;
+  uint32_t recordHeaderSize;
+};
+
+enum class SaiTraceOp : uint16_t {
+  API_INITIALIZE,
+  API_UNINITIALIZE,
+  API_QUERY,
+  CREATE,
+  REMOVE,
+  SET_ATTRIBUTE,
+  // Records dropped because the writer queue was full, objectId holds the
+  // number of records dropped
+  DROPPED,
+};
+
+enum class SaiTraceAttrKind : uint8_t {
+  // Value is replayed as is
+  PLAIN,
+  // Value holds an object id at offset
+  OID,
+  // Value holds a sai_*_list_t at offset, elements follow the attributes
+  LIST,
+  // LIST of object ids
+  OID_LIST,
+};
+
+struct SaiTraceAttribute {
+  sai_attr_id_t id;
+  SaiTraceAttrKind kind;
+  uint8_t reserved;
+  uint16_t offset;
+  uint32_t elemSize;
+  uint32_t listBytes;
+  sai_attribute_value_t value;
+};
+
+union SaiTraceEntry {
+  sai_route_entry_t route;
+  sai_neighbor_entry_t neighbor;
+  sai_fdb_entry_t fdb;
+  sai_inseg_entry_t inseg;
+};
+
+struct SaiTraceRecordHeader {
+  // Size of the whole record, header included
+  uint32_t size;
+  SaiTraceOp op;
+  uint16_t nameSize;
+  // sai_object_type_t, or sai_api_t for API_QUERY
+  int32_t objectType;
+  sai_status_t status;
+  uint32_t attrCount;
+  uint64_t timestampUs;
+  sai_object_id_t objectId;
+  sai_object_id_t switchId;
+  // Key of ROUTE_ENTRY, NEIGHBOR_ENTRY, FDB_ENTRY and INSEG_ENTRY objects
+  SaiTraceEntry entry;
+};
+
+class SaiTraceRecord {
+ public:
+  SaiTraceRecord();
+  SaiTraceRecord(
+      SaiTraceOp op,
+      int32_t objectType,
+      std::string name = std::string());
+
+  SaiTraceRecordHeader header;
+  std::string name;
+  std::vector<std::pair<std::string, std::string>> profile;
+
+  /*
+   * Copy an attribute. For LIST and OID_LIST, the sai_*_list_t at offset is
+   * followed and its elements, elemSize bytes each, are copied as well.
+   */
+  void addAttribute(
+      const sai_attribute_t& attr,
+      SaiTraceAttrKind kind = SaiTraceAttrKind::PLAIN,
+      uint16_t offset = 0,
+      uint32_t elemSize = 0);
+
+  uint32_t attributeCount() const {
+    return attributes_.size();
+  }
+
+  /*
+   * Attributes as passed to SAI. List pointers point into this record, so
+   * they are valid as long as the record is neither modified nor destroyed.
+   */
+  std::vector<sai_attribute_t> attributes();
+
+  // Replace every object id held by the attributes
+  void remapObjectIds(
+      const std::function<sai_object_id_t(sai_object_id_t)>& remap);
+
+  std::string serialize() const;
+
+  /*
+   * Read the record at the front of buf and advance buf past it. Returns
+   * std::nullopt if buf is empty, throws if the record is truncated.
+   */
+  static std::optional<SaiTraceRecord> deserialize(folly::ByteRange& buf);
+
+ private:
+  std::vector<SaiTraceAttribute> attributes_;
+  std::vector<std::string> lists_;
+};
+
+/*
+ * Writes records to a binary trace from a flush thread. Callers only
+ * serialize the record and push it to a lock free queue. When the flush
+ * thread falls behind and the queue is full, records are dropped and a
+ * DROPPED record takes their place in the trace.
+ */
+class SaiBinaryTraceWriter {
+ public:
+  SaiBinaryTraceWriter(const std::string& path, size_t queueSize);
+  ~SaiBinaryTraceWriter();
+
+  void append(const SaiTraceRecord& record);
+
+  uint64_t droppedRecords() const {
+    return totalDropped_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  void flushLoop();
+
+  folly::File file_;
+  folly::MPMCQueue<std::string> queue_;
+  // Dropped since the last DROPPED record
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> totalDropped_{0};
+  std::thread flushThread_;
+};
+
+class SaiBinaryTraceReader {
+ public:
+  explicit SaiBinaryTraceReader(const std::string& path);
+
+  const SaiBinaryTraceFileHeader& fileHeader() const {
+    return fileHeader_;
+  }
+
+  std::optional<SaiTraceRecord> next() {
+    return SaiTraceRecord::deserialize(remaining_);
+  }
+
+ private:
+  std::string buf_;
+  SaiBinaryTraceFileHeader fileHeader_;
+  folly::ByteRange remaining_;
+};
+
+} // namespace facebook::fboss
@@ -8,6 +8,8 @@
  *
  */
 #include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <ostream>
@@ -108,6 +110,19 @@ DEFINE_int32(
     "Log timeout value in milliseconds. Logger will periodically"
     "flush logs even if the buffer is not full");
 
+DEFINE_string(
+    sai_binary_log,
+    "",
+    "File path to a compact binary SAI trace. When set along with "
+    "enable_replayer, calls are traced there instead of to sai_log. "
+    "Use sai_binary_trace to convert or replay it.");
+
+DEFINE_int32(
+    sai_binary_log_queue_size,
+    65536,
+    "Number of records queued for the binary SAI trace flush thread. "
+    "Records are dropped while the queue is full.");
+
 DEFINE_bool(
     log_variable_name,
     false,
@@ -414,7 +429,8 @@ sai_status_t __wrap_sai_get_object_key(
       switch_id, object_type, object_count, object_list);
 
   if (!FLAGS_enable_replayer || *object_count == 0 ||
-      !should_log(object_type)) {
+      !should_log(object_type) ||
+      SaiTracer::getInstance()->binaryTraceEnabled()) {
     return rv;
   }
 
@@ -470,8 +486,185 @@ folly::Singleton<facebook::fboss::SaiTracer> _saiTracer;
 
 namespace facebook::fboss {
 
+namespace {
+
+// Create, remove and set records wait here for the return value
+thread_local std::optional<SaiTraceRecord> pendingBinaryRecord;
+// Same for the per object records of a bulk call
+thread_local std::vector<SaiTraceRecord> pendingBulkBinaryRecords;
+
+using AttributeTypeFunction = std::size_t (*)(int32_t);
+
+const std::map<sai_object_type_t, AttributeTypeFunction> kAttributeTypeFns{
+    {SAI_OBJECT_TYPE_ACL_COUNTER, &getAclCounterAttributeType},
+    {SAI_OBJECT_TYPE_ACL_ENTRY, &getAclEntryAttributeType},
+    {SAI_OBJECT_TYPE_ACL_TABLE, &getAclTableAttributeType},
+    {SAI_OBJECT_TYPE_ACL_TABLE_GROUP, &getAclTableGroupAttributeType},
+    {SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER,
+     &getAclTableGroupMemberAttributeType},
+#if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
+    {SAI_OBJECT_TYPE_ARS, &getArsAttributeType},
+    {SAI_OBJECT_TYPE_ARS_PROFILE, &getArsProfileAttributeType},
+#endif
+    {SAI_OBJECT_TYPE_BRIDGE, &getBridgeAttributeType},
+    {SAI_OBJECT_TYPE_BRIDGE_PORT, &getBridgePortAttributeType},
+    {SAI_OBJECT_TYPE_BUFFER_POOL, &getBufferPoolAttributeType},
+    {SAI_OBJECT_TYPE_BUFFER_PROFILE, &getBufferProfileAttributeType},
+    {SAI_OBJECT_TYPE_COUNTER, &getCounterAttributeType},
+    {SAI_OBJECT_TYPE_DEBUG_COUNTER, &getDebugCounterAttributeType},
+    {SAI_OBJECT_TYPE_FDB_ENTRY, &getFdbEntryAttributeType},
+    {SAI_OBJECT_TYPE_HASH, &getHashAttributeType},
+    {SAI_OBJECT_TYPE_HOSTIF_PACKET, &getHostifPacketAttributeType},
+    {SAI_OBJECT_TYPE_HOSTIF_TRAP, &getHostifTrapAttributeType},
+    {SAI_OBJECT_TYPE_HOSTIF_USER_DEFINED_TRAP,
+     &getHostifUserDefinedTrapAttributeType},
+    {SAI_OBJECT_TYPE_HOSTIF_TRAP_GROUP, &getHostifTrapGroupAttributeType},
+    {SAI_OBJECT_TYPE_INSEG_ENTRY, &getInsegEntryAttributeType},
+    {SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP,
+     &getIngressPriorityGroupAttributeType},
+    {SAI_OBJECT_TYPE_LAG, &getLagAttributeType},
+    {SAI_OBJECT_TYPE_LAG_MEMBER, &getLagMemberAttributeType},
+    {SAI_OBJECT_TYPE_MACSEC, &getMacsecAttributeType},
+    {SAI_OBJECT_TYPE_MACSEC_PORT, &getMacsecPortAttributeType},
+    {SAI_OBJECT_TYPE_MACSEC_FLOW, &getMacsecFlowAttributeType},
+    {SAI_OBJECT_TYPE_MACSEC_SA, &getMacsecSAAttributeType},
+    {SAI_OBJECT_TYPE_MACSEC_SC, &getMacsecSCAttributeType},
+    {SAI_OBJECT_TYPE_MIRROR_SESSION, &getMirrorSessionAttributeType},
+    {SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, &getNeighborEntryAttributeType},
+    {SAI_OBJECT_TYPE_NEXT_HOP, &getNextHopAttributeType},
+    {SAI_OBJECT_TYPE_NEXT_HOP_GROUP, &getNextHopGroupAttributeType},
+    {SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+     &getNextHopGroupMemberAttributeType},
+    {SAI_OBJECT_TYPE_PORT, &getPortAttributeType},
+    {SAI_OBJECT_TYPE_PORT_SERDES, &getPortSerdesAttributeType},
+    {SAI_OBJECT_TYPE_PORT_CONNECTOR, &getPortConnectorAttributeType},
+    {SAI_OBJECT_TYPE_QOS_MAP, &getQosMapAttributeType},
+    {SAI_OBJECT_TYPE_QUEUE, &getQueueAttributeType},
+    {SAI_OBJECT_TYPE_ROUTE_ENTRY, &getRouteEntryAttributeType},
+    {SAI_OBJECT_TYPE_ROUTER_INTERFACE, &getRouterInterfaceAttributeType},
+    {SAI_OBJECT_TYPE_SAMPLEPACKET, &getSamplePacketAttributeType},
+    {SAI_OBJECT_TYPE_SCHEDULER, &getSchedulerAttributeType},
+    {SAI_OBJECT_TYPE_SWITCH, &getSwitchAttributeType},
+    {SAI_OBJECT_TYPE_SYSTEM_PORT, &getSystemPortAttributeType},
+    {SAI_OBJECT_TYPE_TAM, &getTamAttributeType},
+    {SAI_OBJECT_TYPE_TAM_EVENT, &getTamEventAttributeType},
+    {SAI_OBJECT_TYPE_TAM_EVENT_ACTION, &getTamEventActionAttributeType},
+    {SAI_OBJECT_TYPE_TAM_REPORT, &getTamReportAttributeType},
+    {SAI_OBJECT_TYPE_TUNNEL, &getTunnelAttributeType},
+    {SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY, &getTunnelTermAttributeType},
+    {SAI_OBJECT_TYPE_UDF, &getUdfAttributeType},
+    {SAI_OBJECT_TYPE_UDF_MATCH, &getUdfMatchAttributeType},
+    {SAI_OBJECT_TYPE_UDF_GROUP, &getUdfGroupAttributeType},
+    {SAI_OBJECT_TYPE_VIRTUAL_ROUTER, &getVirtualRouterAttributeType},
+    {SAI_OBJECT_TYPE_VLAN, &getVlanAttributeType},
+    {SAI_OBJECT_TYPE_VLAN_MEMBER, &getVlanMemberAttributeType},
+    {SAI_OBJECT_TYPE_WRED, &getWredAttributeType},
+};
+
+std::size_t getAttributeType(sai_object_type_t object_type, int32_t id) {
+  auto iter = kAttributeTypeFns.find(object_type);
+  return iter == kAttributeTypeFns.end() ? 0 : (*iter->second)(id);
+}
+
+struct BinaryAttrLayout {
+  SaiTraceAttrKind kind;
+  uint16_t offset;
+  uint32_t elemSize;
+};
+
+// Attribute types holding object ids or pointers, all others are plain
+// values
+const std::unordered_map<std::size_t, BinaryAttrLayout>&
+getBinaryAttrLayouts() {
+  static const std::unordered_map<std::size_t, BinaryAttrLayout> kLayouts{
+      {TYPE_INDEX(sai_object_id_t),
+       {SaiTraceAttrKind::OID, offsetof(sai_attribute_value_t, oid), 0}},
+      {TYPE_INDEX(SaiObjectIdT),
+       {SaiTraceAttrKind::OID, offsetof(sai_attribute_value_t, oid), 0}},
+      {TYPE_INDEX(AclEntryFieldSaiObjectIdT),
+       {SaiTraceAttrKind::OID,
+        offsetof(sai_attribute_value_t, aclfield.data.oid),
+        0}},
+      {TYPE_INDEX(AclEntryActionSaiObjectIdT),
+       {SaiTraceAttrKind::OID,
+        offsetof(sai_attribute_value_t, aclaction.parameter.oid),
+        0}},
+      {TYPE_INDEX(std::vector<sai_object_id_t>),
+       {SaiTraceAttrKind::OID_LIST,
+        offsetof(sai_attribute_value_t, objlist),
+        sizeof(sai_object_id_t)}},
+      {TYPE_INDEX(AclEntryActionSaiObjectIdList),
+       {SaiTraceAttrKind::OID_LIST,
+        offsetof(sai_attribute_value_t, aclaction.parameter.objlist),
+        sizeof(sai_object_id_t)}},
+      {TYPE_INDEX(std::vector<sai_uint32_t>),
+       {SaiTraceAttrKind::LIST,
+        offsetof(sai_attribute_value_t, u32list),
+        sizeof(sai_uint32_t)}},
+      {TYPE_INDEX(std::vector<sai_int32_t>),
+       {SaiTraceAttrKind::LIST,
+        offsetof(sai_attribute_value_t, s32list),
+        sizeof(sai_int32_t)}},
+      {TYPE_INDEX(std::vector<sai_qos_map_t>),
+       {SaiTraceAttrKind::LIST,
+        offsetof(sai_attribute_value_t, qosmap),
+        sizeof(sai_qos_map_t)}},
+      {TYPE_INDEX(std::vector<sai_map_t>),
+       {SaiTraceAttrKind::LIST,
+        offsetof(sai_attribute_value_t, maplist),
+        sizeof(sai_map_t)}},
+      {TYPE_INDEX(std::vector<sai_system_port_config_t>),
+       {SaiTraceAttrKind::LIST,
+        offsetof(sai_attribute_value_t, sysportconfiglist),
+        sizeof(sai_system_port_config_t)}},
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 3) || defined(TAJO_SDK_VERSION_1_42_8)
+      {TYPE_INDEX(std::vector<sai_port_lane_latch_status_t>),
+       {SaiTraceAttrKind::LIST,
+        offsetof(sai_attribute_value_t, portlanelatchstatuslist),
+        sizeof(sai_port_lane_latch_status_t)}},
+#endif
+#if SAI_API_VERSION >= SAI_VERSION(1, 13, 0)
+      {TYPE_INDEX(std::vector<sai_port_frequency_offset_ppm_values_t>),
+       {SaiTraceAttrKind::LIST,
+        offsetof(sai_attribute_value_t, portfrequencyoffsetppmlist),
+        sizeof(sai_port_frequency_offset_ppm_values_t)}},
+      {TYPE_INDEX(std::vector<sai_port_snr_values_t>),
+       {SaiTraceAttrKind::LIST,
+        offsetof(sai_attribute_value_t, portsnrlist),
+        sizeof(sai_port_snr_values_t)}},
+#endif
+  };
+  return kLayouts;
+}
+
+// Attributes handled by SET_SAI_STRING_ATTRIBUTES whose value is inline
+bool isInlineStringAttribute(sai_object_type_t object_type, int32_t id) {
+  switch (object_type) {
+    case SAI_OBJECT_TYPE_LAG:
+      return id == SAI_LAG_ATTR_LABEL;
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    case SAI_OBJECT_TYPE_COUNTER:
+      return id == SAI_COUNTER_ATTR_LABEL;
+#endif
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 2)
+    case SAI_OBJECT_TYPE_ACL_COUNTER:
+      return id == SAI_ACL_COUNTER_ATTR_LABEL;
+#endif
+    case SAI_OBJECT_TYPE_MACSEC_SA:
+      return id == SAI_MACSEC_SA_ATTR_AUTH_KEY ||
+          id == SAI_MACSEC_SA_ATTR_SAK || id == SAI_MACSEC_SA_ATTR_SALT;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
 SaiTracer::SaiTracer() {
-  if (FLAGS_enable_replayer) {
+  if (FLAGS_enable_replayer && !FLAGS_sai_binary_log.empty()) {
+    binaryTrace_ = std::make_unique<SaiBinaryTraceWriter>(
+        FLAGS_sai_binary_log, FLAGS_sai_binary_log_queue_size);
+  } else if (FLAGS_enable_replayer) {
     asyncLogger_ = std::make_unique<AsyncLogger>(
         FLAGS_sai_log, FLAGS_log_timeout, AsyncLogger::SAI_REPLAYER);
 
@@ -484,7 +677,7 @@ SaiTracer::SaiTracer() {
 }
 
 SaiTracer::~SaiTracer() {
-  if (FLAGS_enable_replayer) {
+  if (asyncLogger_) {
     writeFooter();
     asyncLogger_->forceFlush();
     asyncLogger_->stopFlushThread();
@@ -501,7 +694,7 @@ void SaiTracer::printHex(std::ostringstream& outStringStream, uint8_t u8) {
 }
 
 void SaiTracer::writeToFile(const vector<string>& strVec, bool linefeed) {
-  if (!FLAGS_enable_replayer) {
+  if (!FLAGS_enable_replayer || !asyncLogger_) {
     return;
   }
 
@@ -515,6 +708,16 @@ void SaiTracer::logApiInitialize(
     const char** variables,
     const char** values,
     int size) {
+  if (binaryTrace_) {
+    auto record =
+        binaryRecord(SaiTraceOp::API_INITIALIZE, SAI_OBJECT_TYPE_NULL);
+    for (int i = 0; i < size; ++i) {
+      record.profile.emplace_back(variables[i], values[i]);
+    }
+    binaryTrace_->append(record);
+    return;
+  }
+
   vector<string> lines;
 
   for (int i = 0; i < size; ++i) {
@@ -543,6 +746,12 @@ void SaiTracer::logApiInitialize(
 }
 
 void SaiTracer::logApiUninitialize(void) {
+  if (binaryTrace_) {
+    binaryTrace_->append(
+        binaryRecord(SaiTraceOp::API_UNINITIALIZE, SAI_OBJECT_TYPE_NULL));
+    return;
+  }
+
   vector<string> lines{"sai_api_uninitialize()"};
   writeToFile(lines);
 }
@@ -555,6 +764,13 @@ void SaiTracer::logApiQuery(sai_api_t api_id, const std::string& api_var) {
 
   init_api_.emplace(api_id, api_var);
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::API_QUERY, static_cast<sai_object_type_t>(api_id), api_var);
+    binaryTrace_->append(record);
+    return;
+  }
+
   writeToFile(
       {to<string>("sai_", api_var, "_t* ", api_var),
        to<string>(
@@ -579,6 +795,16 @@ void SaiTracer::logSwitchCreateFn(
     return;
   }
 
+  if (binaryTrace_) {
+    setPendingBinaryRecord(binaryRecord(
+        SaiTraceOp::CREATE,
+        SAI_OBJECT_TYPE_SWITCH,
+        "create_switch",
+        attr_list,
+        attr_count));
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_SWITCH);
@@ -614,6 +840,18 @@ void SaiTracer::logRouteEntryCreateFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::CREATE,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        "create_route_entry",
+        attr_list,
+        attr_count);
+    record.header.entry.route = *route_entry;
+    setPendingBinaryRecord(std::move(record));
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_ROUTE_ENTRY);
@@ -644,6 +882,19 @@ void SaiTracer::logNeighborEntryCreateFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::CREATE,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        "create_neighbor_entry",
+        attr_list,
+        attr_count);
+    record.header.entry.neighbor = *neighbor_entry;
+    record.header.status = rv;
+    binaryTrace_->append(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
@@ -680,6 +931,19 @@ void SaiTracer::logFdbEntryCreateFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::CREATE,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        "create_fdb_entry",
+        attr_list,
+        attr_count);
+    record.header.entry.fdb = *fdb_entry;
+    record.header.status = rv;
+    binaryTrace_->append(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_FDB_ENTRY);
@@ -716,6 +980,19 @@ void SaiTracer::logInsegEntryCreateFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::CREATE,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        "create_inseg_entry",
+        attr_list,
+        attr_count);
+    record.header.entry.inseg = *inseg_entry;
+    record.header.status = rv;
+    binaryTrace_->append(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_INSEG_ENTRY);
@@ -754,6 +1031,14 @@ std::string SaiTracer::logCreateFn(
     return "";
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::CREATE, object_type, fn_name, attr_list, attr_count);
+    record.header.switchId = switch_id;
+    setPendingBinaryRecord(std::move(record));
+    return "";
+  }
+
   // First fill in attribute list
   vector<string> lines = setAttrList(attr_list, attr_count, object_type);
 
@@ -776,6 +1061,14 @@ void SaiTracer::logRouteEntryRemoveFn(const sai_route_entry_t* route_entry) {
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::REMOVE, SAI_OBJECT_TYPE_ROUTE_ENTRY, "remove_route_entry");
+    record.header.entry.route = *route_entry;
+    setPendingBinaryRecord(std::move(record));
+    return;
+  }
+
   vector<string> lines{};
   setRouteEntry(route_entry, lines);
 
@@ -797,6 +1090,17 @@ void SaiTracer::logNeighborEntryRemoveFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::REMOVE,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        "remove_neighbor_entry");
+    record.header.entry.neighbor = *neighbor_entry;
+    record.header.status = rv;
+    binaryTrace_->append(record);
+    return;
+  }
+
   vector<string> lines{};
   setNeighborEntry(neighbor_entry, lines);
 
@@ -824,6 +1128,15 @@ void SaiTracer::logFdbEntryRemoveFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::REMOVE, SAI_OBJECT_TYPE_FDB_ENTRY, "remove_fdb_entry");
+    record.header.entry.fdb = *fdb_entry;
+    record.header.status = rv;
+    binaryTrace_->append(record);
+    return;
+  }
+
   vector<string> lines{};
   setFdbEntry(fdb_entry, lines);
 
@@ -851,6 +1164,15 @@ void SaiTracer::logInsegEntryRemoveFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::REMOVE, SAI_OBJECT_TYPE_INSEG_ENTRY, "remove_inseg_entry");
+    record.header.entry.inseg = *inseg_entry;
+    record.header.status = rv;
+    binaryTrace_->append(record);
+    return;
+  }
+
   vector<string> lines{};
   setInsegEntry(inseg_entry, lines);
 
@@ -879,6 +1201,13 @@ void SaiTracer::logRemoveFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(SaiTraceOp::REMOVE, object_type, fn_name);
+    record.header.objectId = remove_object_id;
+    setPendingBinaryRecord(std::move(record));
+    return;
+  }
+
   vector<string> lines{};
 
   // Make the remove call
@@ -906,6 +1235,18 @@ void SaiTracer::logRouteEntrySetAttrFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_ROUTE_ENTRY,
+        "set_route_entry_attribute",
+        attr,
+        1);
+    record.header.entry.route = *route_entry;
+    setPendingBinaryRecord(std::move(record));
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_ROUTE_ENTRY);
 
@@ -931,6 +1272,19 @@ void SaiTracer::logNeighborEntrySetAttrFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+        "set_neighbor_entry_attribute",
+        attr,
+        1);
+    record.header.entry.neighbor = *neighbor_entry;
+    record.header.status = rv;
+    binaryTrace_->append(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
 
@@ -962,6 +1316,19 @@ void SaiTracer::logFdbEntrySetAttrFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_FDB_ENTRY,
+        "set_fdb_entry_attribute",
+        attr,
+        1);
+    record.header.entry.fdb = *fdb_entry;
+    record.header.status = rv;
+    binaryTrace_->append(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_FDB_ENTRY);
 
@@ -993,6 +1360,19 @@ void SaiTracer::logInsegEntrySetAttrFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::SET_ATTRIBUTE,
+        SAI_OBJECT_TYPE_INSEG_ENTRY,
+        "set_inseg_entry_attribute",
+        attr,
+        1);
+    record.header.entry.inseg = *inseg_entry;
+    record.header.status = rv;
+    binaryTrace_->append(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_INSEG_ENTRY);
 
@@ -1021,7 +1401,7 @@ void SaiTracer::logAttrPreGet(
     uint32_t attr_count,
     const sai_attribute_t* attr,
     sai_object_type_t object_type) {
-  if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log) {
+  if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log || binaryTrace_) {
     return;
   }
 
@@ -1035,7 +1415,7 @@ void SaiTracer::logGetAttrFn(
     const sai_attribute_t* attr,
     sai_object_type_t object_type,
     sai_status_t rv) {
-  if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log) {
+  if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log || binaryTrace_) {
     return;
   }
 
@@ -1073,6 +1453,14 @@ void SaiTracer::logSetAttrFn(
     return;
   }
 
+  if (binaryTrace_) {
+    auto record = binaryRecord(
+        SaiTraceOp::SET_ATTRIBUTE, object_type, fn_name, attr, 1);
+    record.header.objectId = set_object_id;
+    setPendingBinaryRecord(std::move(record));
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, object_type);
 
@@ -1102,6 +1490,28 @@ void SaiTracer::logBulkSetAttrFn(
     return;
   }
 
+  if (binaryTrace_) {
+    // Traced as one set per object, e.g. set_ports_attribute is traced as
+    // set_port_attribute
+    auto singleFnName = fn_name;
+    auto bulkSuffix = singleFnName.rfind("s_attribute");
+    if (bulkSuffix != string::npos) {
+      singleFnName.replace(bulkSuffix, 1, "");
+    }
+    for (int i = 0; i < object_count; ++i) {
+      auto record = binaryRecord(
+          SaiTraceOp::SET_ATTRIBUTE,
+          object_type,
+          singleFnName,
+          &attr_list[i],
+          1);
+      record.header.objectId = object_id[i];
+      record.header.status = object_statuses[i];
+      binaryTrace_->append(record);
+    }
+    return;
+  }
+
   // Setup attributes
   vector<string> lines = setAttrList(attr_list, object_count, object_type);
 
@@ -1139,6 +1549,101 @@ void SaiTracer::logBulkSetAttrFn(
   writeToFile(lines);
 }
 
+void SaiTracer::logRouteEntryBulkCreateFn(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list) {
+  if (!FLAGS_enable_replayer) {
+    return;
+  }
+
+  if (binaryTrace_) {
+    std::vector<SaiTraceRecord> records;
+    records.reserve(object_count);
+    for (uint32_t i = 0; i < object_count; ++i) {
+      auto& record = records.emplace_back(binaryRecord(
+          SaiTraceOp::CREATE,
+          SAI_OBJECT_TYPE_ROUTE_ENTRY,
+          "create_route_entry",
+          attr_list[i],
+          attr_count[i]));
+      record.header.entry.route = route_entry[i];
+    }
+    setPendingBulkBinaryRecords(std::move(records));
+    return;
+  }
+
+  for (uint32_t i = 0; i < object_count; ++i) {
+    logRouteEntryCreateFn(&route_entry[i], attr_count[i], attr_list[i]);
+  }
+}
+
+void SaiTracer::logRouteEntryBulkRemoveFn(
+    uint32_t object_count,
+    const sai_route_entry_t* route_entry) {
+  if (!FLAGS_enable_replayer) {
+    return;
+  }
+
+  if (binaryTrace_) {
+    std::vector<SaiTraceRecord> records;
+    records.reserve(object_count);
+    for (uint32_t i = 0; i < object_count; ++i) {
+      auto& record = records.emplace_back(binaryRecord(
+          SaiTraceOp::REMOVE,
+          SAI_OBJECT_TYPE_ROUTE_ENTRY,
+          "remove_route_entry"));
+      record.header.entry.route = route_entry[i];
+    }
+    setPendingBulkBinaryRecords(std::move(records));
+    return;
+  }
+
+  for (uint32_t i = 0; i < object_count; ++i) {
+    logRouteEntryRemoveFn(&route_entry[i]);
+  }
+}
+
+void SaiTracer::logBulkPostInvocation(
+    uint32_t object_count,
+    const sai_status_t* object_statuses,
+    sai_status_t rv,
+    std::chrono::system_clock::time_point begin) {
+  if (!FLAGS_enable_replayer) {
+    return;
+  }
+
+  if (binaryTrace_) {
+    // Objects the adapter did not get to (SAI_STATUS_NOT_EXECUTED) were
+    // never programmed, so are left out of the trace
+    for (uint32_t i = 0;
+         i < object_count && i < pendingBulkBinaryRecords.size();
+         ++i) {
+      if (object_statuses[i] == SAI_STATUS_NOT_EXECUTED) {
+        continue;
+      }
+      pendingBulkBinaryRecords[i].header.status = object_statuses[i];
+      binaryTrace_->append(pendingBulkBinaryRecords[i]);
+    }
+    pendingBulkBinaryRecords.clear();
+    return;
+  }
+
+  // The C source replays every object of the bulk call. Record which of
+  // them the adapter executed, and check the bulk call's return value.
+  string objectStatusStr = "// Status:";
+  for (uint32_t i = 0; i < object_count; ++i) {
+    objectStatusStr += to<string>(" ", object_statuses[i]);
+  }
+  vector<string> lines;
+  lines.push_back(objectStatusStr);
+  lines.push_back(logTimeAndRv(rv, SAI_NULL_OBJECT_ID, begin));
+  lines.push_back(rvCheck(rv));
+
+  writeToFile(lines);
+}
+
 void SaiTracer::logSendHostifPacketFn(
     sai_object_id_t hostif_id,
     sai_size_t buffer_size,
@@ -1146,7 +1651,7 @@ void SaiTracer::logSendHostifPacketFn(
     uint32_t attr_count,
     const sai_attribute_t* attr_list,
     sai_status_t rv) {
-  if (!FLAGS_enable_replayer || !FLAGS_enable_packet_log) {
+  if (!FLAGS_enable_replayer || !FLAGS_enable_packet_log || binaryTrace_) {
     return;
   }
 
@@ -1202,7 +1707,7 @@ void SaiTracer::logGetStatsFn(
     sai_object_type_t object_type,
     sai_status_t rv,
     int mode) {
-  if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log) {
+  if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log || binaryTrace_) {
     return;
   }
   vector<string> lines = {
@@ -1237,7 +1742,7 @@ void SaiTracer::logClearStatsFn(
     const sai_stat_id_t* counter_ids,
     sai_object_type_t object_type,
     sai_status_t rv) {
-  if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log) {
+  if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log || binaryTrace_) {
     return;
   }
 
@@ -1723,6 +2228,19 @@ void SaiTracer::logPostInvocation(
     sai_object_id_t object_id,
     std::chrono::system_clock::time_point begin,
     std::optional<std::string> varName) {
+  if (binaryTrace_) {
+    if (!pendingBinaryRecord) {
+      return;
+    }
+    pendingBinaryRecord->header.status = rv;
+    if (pendingBinaryRecord->header.op == SaiTraceOp::CREATE) {
+      pendingBinaryRecord->header.objectId = object_id;
+    }
+    binaryTrace_->append(*pendingBinaryRecord);
+    pendingBinaryRecord.reset();
+    return;
+  }
+
   // In the case of create fn, objectID is known after invocation.
   // Therefore, add it to the variable mapping here.
   if (varName && FLAGS_log_variable_name) {
@@ -1739,6 +2257,66 @@ void SaiTracer::logPostInvocation(
   writeToFile(lines);
 }
 
+SaiTraceRecord SaiTracer::binaryRecord(
+    SaiTraceOp op,
+    sai_object_type_t object_type,
+    const std::string& fn_name,
+    const sai_attribute_t* attr_list,
+    uint32_t attr_count) {
+  SaiTraceRecord record(op, object_type, fn_name);
+  const auto& layouts = getBinaryAttrLayouts();
+  for (int i = 0; i < attr_count; ++i) {
+    auto typeIndex = getAttributeType(object_type, attr_list[i].id);
+    auto layout = layouts.find(typeIndex);
+    if (layout != layouts.end()) {
+      record.addAttribute(
+          attr_list[i],
+          layout->second.kind,
+          layout->second.offset,
+          layout->second.elemSize);
+    } else if (
+        primitiveFuncMap_.count(typeIndex) ||
+        attributeFuncMap_.count(typeIndex) ||
+        isInlineStringAttribute(object_type, attr_list[i].id)) {
+      record.addAttribute(attr_list[i]);
+    } else if (
+        object_type == SAI_OBJECT_TYPE_SWITCH &&
+        (attr_list[i].id == SAI_SWITCH_ATTR_SWITCH_HARDWARE_INFO ||
+         attr_list[i].id == SAI_SWITCH_ATTR_FIRMWARE_PATH_NAME)) {
+      record.addAttribute(
+          attr_list[i],
+          SaiTraceAttrKind::LIST,
+          offsetof(sai_attribute_value_t, s8list),
+          sizeof(sai_int8_t));
+    } else {
+      // Unsupported attributes are replayed with a zero value, as in the
+      // C source
+      sai_attribute_t unsupported;
+      std::memset(&unsupported, 0, sizeof(unsupported));
+      unsupported.id = attr_list[i].id;
+      record.addAttribute(unsupported);
+    }
+  }
+  return record;
+}
+
+void SaiTracer::setPendingBinaryRecord(SaiTraceRecord record) {
+  if (pendingBinaryRecord) {
+    // The previous call never completed, trace it without a return value
+    binaryTrace_->append(*pendingBinaryRecord);
+  }
+  pendingBinaryRecord = std::move(record);
+}
+
+void SaiTracer::setPendingBulkBinaryRecords(
+    std::vector<SaiTraceRecord> records) {
+  // The previous bulk call never completed, trace it without return values
+  for (const auto& record : pendingBulkBinaryRecords) {
+    binaryTrace_->append(record);
+  }
+  pendingBulkBinaryRecords = std::move(records);
+}
+
 void SaiTracer::setupGlobals() {
   // TODO(zecheng): Handle list size that's larger than 512 bytes.
   vector<string> globalVar = {to<string>(
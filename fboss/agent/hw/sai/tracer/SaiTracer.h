@@ -17,6 +17,7 @@
 #include "fboss/agent/AsyncLogger.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
 #include "fboss/agent/hw/sai/tracer/Utils.h"
 
 #include <folly/File.h>
@@ -33,6 +34,7 @@ DECLARE_bool(enable_replayer);
 DECLARE_bool(enable_packet_log);
 DECLARE_bool(enable_elapsed_time_log);
 DECLARE_bool(enable_get_attr_log);
+DECLARE_string(sai_binary_log);
 
 using PrimitiveFunction = std::string (*)(const sai_attribute_t*, int);
 using AttributeFunction =
@@ -167,6 +169,27 @@ class SaiTracer {
       sai_object_type_t object_type,
       sai_status_t rv);
 
+  /*
+   * Bulk route calls are traced as one create/remove per route. These log
+   * the calls before the bulk call is made, logBulkPostInvocation() then
+   * logs the per route statuses once it returns.
+   */
+  void logRouteEntryBulkCreateFn(
+      uint32_t object_count,
+      const sai_route_entry_t* route_entry,
+      const uint32_t* attr_count,
+      const sai_attribute_t** attr_list);
+
+  void logRouteEntryBulkRemoveFn(
+      uint32_t object_count,
+      const sai_route_entry_t* route_entry);
+
+  void logBulkPostInvocation(
+      uint32_t object_count,
+      const sai_status_t* object_statuses,
+      sai_status_t rv,
+      std::chrono::system_clock::time_point begin);
+
   void logSendHostifPacketFn(
       sai_object_id_t hostif_id,
       sai_size_t buffer_size,
@@ -208,6 +231,11 @@ class SaiTracer {
       std::chrono::system_clock::time_point begin,
       std::optional<std::string> varName = std::nullopt);
 
+  // Whether calls are traced to --sai_binary_log instead of C source
+  bool binaryTraceEnabled() const {
+    return binaryTrace_ != nullptr;
+  }
+
   sai_acl_api_t* aclApi_;
 #if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
   sai_ars_api_t* arsApi_;
@@ -345,6 +373,19 @@ class SaiTracer {
 
   void checkAttrCount(uint32_t attr_count);
 
+  // Helper methods for the binary trace
+  SaiTraceRecord binaryRecord(
+      SaiTraceOp op,
+      sai_object_type_t object_type,
+      const std::string& fn_name = "",
+      const sai_attribute_t* attr_list = nullptr,
+      uint32_t attr_count = 0);
+
+  // Hold the record until logPostInvocation() provides the return value
+  void setPendingBinaryRecord(SaiTraceRecord record);
+  // Hold the records until logBulkPostInvocation() provides the statuses
+  void setPendingBulkBinaryRecords(std::vector<SaiTraceRecord> records);
+
   // Init functions
   void setupGlobals();
   void initVarCounts();
@@ -355,6 +396,7 @@ class SaiTracer {
   uint32_t maxListCount_;
   uint32_t numCalls_;
   std::unique_ptr<AsyncLogger> asyncLogger_;
+  std::unique_ptr<SaiBinaryTraceWriter> binaryTrace_;
 
   // Variables mappings in generated C code
   // varCounts map from object type to the current counter
@@ -569,7 +611,8 @@ class SaiTracer {
       const sai_attribute_t* attr_list,          \
       uint32_t attr_count,                       \
       std::vector<std::string>& attrLines,       \
-      sai_status_t rv);
+      sai_status_t rv);                          \
+  std::size_t get##obj_type##AttributeType(int32_t id);
 
 #define WRAP_CREATE_FUNC(obj_type, sai_obj_type, api_type)                 \
   sai_status_t wrap_create_##obj_type(                                     \
@@ -936,20 +979,31 @@ class SaiTracer {
   }                                                                          \
   }
 
+// Type index of the attribute, 0 for the attributes handled by
+// SET_SAI_STRING_ATTRIBUTES and unsupported ones
+#define GET_SAI_ATTRIBUTE_TYPE(obj_type)                             \
+  std::size_t get##obj_type##AttributeType(int32_t id) {             \
+    auto iter = _##obj_type##Map.find(id);                           \
+    return iter == _##obj_type##Map.end() ? 0 : iter->second.second; \
+  }
+
 // TODO - Combine this to once macro once the SAI SDK dependency is gone
 #define SET_SAI_ATTRIBUTES(obj_type)   \
   SET_SAI_REGULAR_ATTRIBUTES(obj_type) \
-  SET_SAI_STRING_ATTRIBUTES(obj_type)
+  SET_SAI_STRING_ATTRIBUTES(obj_type)  \
+  GET_SAI_ATTRIBUTE_TYPE(obj_type)
 
 #if SAI_API_VERSION >= SAI_VERSION(1, 10, 2)
-#define SET_SAI_ATTRIBUTES_ACL_COUNTER(obj_type) \
-  SET_SAI_REGULAR_ATTRIBUTES(obj_type)           \
-  SET_SAI_STRING_ATTRIBUTES_ACL_COUNTER(obj_type)
+#define SET_SAI_ATTRIBUTES_ACL_COUNTER(obj_type)  \
+  SET_SAI_REGULAR_ATTRIBUTES(obj_type)            \
+  SET_SAI_STRING_ATTRIBUTES_ACL_COUNTER(obj_type) \
+  GET_SAI_ATTRIBUTE_TYPE(obj_type)
 #else
 #define SET_SAI_ATTRIBUTES_ACL_COUNTER(obj_type) \
   SET_SAI_REGULAR_ATTRIBUTES(obj_type)           \
   }                                              \
-  }
+  }                                              \
+  GET_SAI_ATTRIBUTE_TYPE(obj_type)
 #endif
 
 } // namespace facebook::fboss
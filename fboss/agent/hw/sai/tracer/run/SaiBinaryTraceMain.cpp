@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+#include "fboss/agent/hw/sai/tracer/run/SaiBinaryTraceReplayer.h"
+
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+
+DECLARE_string(sai_log);
+
+DEFINE_string(
+    binary_trace,
+    "",
+    "Binary SAI trace to read, as written by the agent with --sai_binary_log");
+
+DEFINE_bool(
+    replay,
+    false,
+    "Replay the trace against the linked SAI implementation instead of "
+    "converting it to the C source of sai_replayer at --sai_log");
+
+using namespace facebook::fboss;
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  if (FLAGS_binary_trace.empty()) {
+    XLOG(ERR) << "--binary_trace is required";
+    return 1;
+  }
+  SaiBinaryTraceReader reader(FLAGS_binary_trace);
+
+  if (!FLAGS_replay) {
+    // SaiTracer writes the C source as it does for the agent
+    FLAGS_enable_replayer = true;
+    FLAGS_sai_binary_log = "";
+    SaiBinaryTraceConverter converter;
+    uint64_t records = 0;
+    while (auto record = reader.next()) {
+      converter.convert(*record);
+      ++records;
+    }
+    XLOG(INFO) << "Converted " << records << " records to " << FLAGS_sai_log;
+    return 0;
+  }
+
+  FLAGS_enable_replayer = false;
+  SaiBinaryTraceReplayer replayer;
+  while (auto record = reader.next()) {
+    replayer.replay(*record);
+  }
+  XLOG(INFO) << "Replayed " << replayer.calls() << " SAI calls, "
+             << replayer.mismatches() << " returned a different status, "
+             << replayer.dropped() << " were dropped from the trace";
+  return replayer.mismatches() ? 1 : 0;
+}
@@ -0,0 +1,691 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/run/SaiBinaryTraceReplayer.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/api/SaiVersion.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/Conv.h>
+#include <folly/logging/xlog.h>
+
+using folly::to;
+
+namespace {
+
+using CreateFn = sai_status_t (*)(
+    void* api,
+    sai_object_id_t* object_id,
+    sai_object_id_t switch_id,
+    uint32_t attr_count,
+    const sai_attribute_t* attr_list);
+using RemoveFn = sai_status_t (*)(void* api, sai_object_id_t object_id);
+using SetAttributeFn = sai_status_t (*)(
+    void* api,
+    sai_object_id_t object_id,
+    const sai_attribute_t* attr);
+
+struct SaiObjectFns {
+  sai_api_t api;
+  CreateFn create;
+  RemoveFn remove;
+  SetAttributeFn setAttribute;
+};
+
+#define SAI_OBJECT_FNS(sai_obj_type, sai_api, api_type, obj_type)      \
+  {                                                                    \
+    sai_obj_type, SaiObjectFns {                                       \
+      sai_api,                                                         \
+          [](void* api,                                                \
+             sai_object_id_t* object_id,                               \
+             sai_object_id_t switch_id,                                \
+             uint32_t attr_count,                                      \
+             const sai_attribute_t* attr_list) {                       \
+            return static_cast<api_type*>(api)->create_##obj_type(     \
+                object_id, switch_id, attr_count, attr_list);          \
+          },                                                           \
+          [](void* api, sai_object_id_t object_id) {                   \
+            return static_cast<api_type*>(api)->remove_##obj_type(     \
+                object_id);                                            \
+          },                                                           \
+          [](void* api,                                                \
+             sai_object_id_t object_id,                                \
+             const sai_attribute_t* attr) {                            \
+            return static_cast<api_type*>(api)                         \
+                ->set_##obj_type##_attribute(object_id, attr);         \
+          },                                                           \
+    }                                                                  \
+  }
+
+// Object types keyed by sai_object_id_t, as traced by the *ApiTracer
+const std::map<sai_object_type_t, SaiObjectFns> kSaiObjectFns{
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_ACL_COUNTER,
+        SAI_API_ACL,
+        sai_acl_api_t,
+        acl_counter),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_ACL_ENTRY,
+        SAI_API_ACL,
+        sai_acl_api_t,
+        acl_entry),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_ACL_TABLE,
+        SAI_API_ACL,
+        sai_acl_api_t,
+        acl_table),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_ACL_TABLE_GROUP,
+        SAI_API_ACL,
+        sai_acl_api_t,
+        acl_table_group),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER,
+        SAI_API_ACL,
+        sai_acl_api_t,
+        acl_table_group_member),
+#if SAI_API_VERSION >= SAI_VERSION(1, 14, 0)
+    SAI_OBJECT_FNS(SAI_OBJECT_TYPE_ARS, SAI_API_ARS, sai_ars_api_t, ars),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_ARS_PROFILE,
+        SAI_API_ARS_PROFILE,
+        sai_ars_profile_api_t,
+        ars_profile),
+#endif
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_BRIDGE,
+        SAI_API_BRIDGE,
+        sai_bridge_api_t,
+        bridge),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_BRIDGE_PORT,
+        SAI_API_BRIDGE,
+        sai_bridge_api_t,
+        bridge_port),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_BUFFER_POOL,
+        SAI_API_BUFFER,
+        sai_buffer_api_t,
+        buffer_pool),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_BUFFER_PROFILE,
+        SAI_API_BUFFER,
+        sai_buffer_api_t,
+        buffer_profile),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_COUNTER,
+        SAI_API_COUNTER,
+        sai_counter_api_t,
+        counter),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_DEBUG_COUNTER,
+        SAI_API_DEBUG_COUNTER,
+        sai_debug_counter_api_t,
+        debug_counter),
+    SAI_OBJECT_FNS(SAI_OBJECT_TYPE_HASH, SAI_API_HASH, sai_hash_api_t, hash),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_HOSTIF,
+        SAI_API_HOSTIF,
+        sai_hostif_api_t,
+        hostif),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_HOSTIF_TRAP,
+        SAI_API_HOSTIF,
+        sai_hostif_api_t,
+        hostif_trap),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_HOSTIF_USER_DEFINED_TRAP,
+        SAI_API_HOSTIF,
+        sai_hostif_api_t,
+        hostif_user_defined_trap),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_HOSTIF_TRAP_GROUP,
+        SAI_API_HOSTIF,
+        sai_hostif_api_t,
+        hostif_trap_group),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP,
+        SAI_API_BUFFER,
+        sai_buffer_api_t,
+        ingress_priority_group),
+    SAI_OBJECT_FNS(SAI_OBJECT_TYPE_LAG, SAI_API_LAG, sai_lag_api_t, lag),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_LAG_MEMBER,
+        SAI_API_LAG,
+        sai_lag_api_t,
+        lag_member),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_MACSEC,
+        SAI_API_MACSEC,
+        sai_macsec_api_t,
+        macsec),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_MACSEC_PORT,
+        SAI_API_MACSEC,
+        sai_macsec_api_t,
+        macsec_port),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_MACSEC_FLOW,
+        SAI_API_MACSEC,
+        sai_macsec_api_t,
+        macsec_flow),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_MACSEC_SA,
+        SAI_API_MACSEC,
+        sai_macsec_api_t,
+        macsec_sa),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_MACSEC_SC,
+        SAI_API_MACSEC,
+        sai_macsec_api_t,
+        macsec_sc),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_MIRROR_SESSION,
+        SAI_API_MIRROR,
+        sai_mirror_api_t,
+        mirror_session),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_NEXT_HOP,
+        SAI_API_NEXT_HOP,
+        sai_next_hop_api_t,
+        next_hop),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_NEXT_HOP_GROUP,
+        SAI_API_NEXT_HOP_GROUP,
+        sai_next_hop_group_api_t,
+        next_hop_group),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+        SAI_API_NEXT_HOP_GROUP,
+        sai_next_hop_group_api_t,
+        next_hop_group_member),
+    SAI_OBJECT_FNS(SAI_OBJECT_TYPE_PORT, SAI_API_PORT, sai_port_api_t, port),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_PORT_SERDES,
+        SAI_API_PORT,
+        sai_port_api_t,
+        port_serdes),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_PORT_CONNECTOR,
+        SAI_API_PORT,
+        sai_port_api_t,
+        port_connector),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_QOS_MAP,
+        SAI_API_QOS_MAP,
+        sai_qos_map_api_t,
+        qos_map),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_QUEUE,
+        SAI_API_QUEUE,
+        sai_queue_api_t,
+        queue),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+        SAI_API_ROUTER_INTERFACE,
+        sai_router_interface_api_t,
+        router_interface),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_SAMPLEPACKET,
+        SAI_API_SAMPLEPACKET,
+        sai_samplepacket_api_t,
+        samplepacket),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_SCHEDULER,
+        SAI_API_SCHEDULER,
+        sai_scheduler_api_t,
+        scheduler),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_SYSTEM_PORT,
+        SAI_API_SYSTEM_PORT,
+        sai_system_port_api_t,
+        system_port),
+    SAI_OBJECT_FNS(SAI_OBJECT_TYPE_TAM, SAI_API_TAM, sai_tam_api_t, tam),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_TAM_EVENT,
+        SAI_API_TAM,
+        sai_tam_api_t,
+        tam_event),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_TAM_EVENT_ACTION,
+        SAI_API_TAM,
+        sai_tam_api_t,
+        tam_event_action),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_TAM_REPORT,
+        SAI_API_TAM,
+        sai_tam_api_t,
+        tam_report),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_TUNNEL,
+        SAI_API_TUNNEL,
+        sai_tunnel_api_t,
+        tunnel),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY,
+        SAI_API_TUNNEL,
+        sai_tunnel_api_t,
+        tunnel_term_table_entry),
+    SAI_OBJECT_FNS(SAI_OBJECT_TYPE_UDF, SAI_API_UDF, sai_udf_api_t, udf),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_UDF_MATCH,
+        SAI_API_UDF,
+        sai_udf_api_t,
+        udf_match),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_UDF_GROUP,
+        SAI_API_UDF,
+        sai_udf_api_t,
+        udf_group),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_VIRTUAL_ROUTER,
+        SAI_API_VIRTUAL_ROUTER,
+        sai_virtual_router_api_t,
+        virtual_router),
+    SAI_OBJECT_FNS(SAI_OBJECT_TYPE_VLAN, SAI_API_VLAN, sai_vlan_api_t, vlan),
+    SAI_OBJECT_FNS(
+        SAI_OBJECT_TYPE_VLAN_MEMBER,
+        SAI_API_VLAN,
+        sai_vlan_api_t,
+        vlan_member),
+    SAI_OBJECT_FNS(SAI_OBJECT_TYPE_WRED, SAI_API_WRED, sai_wred_api_t, wred),
+};
+
+const auto kNoBegin = std::chrono::system_clock::time_point::min();
+
+// SAI profile of the traced sai_api_initialize() call
+std::unordered_map<std::string, std::string> saiProfileValues;
+
+const char* saiProfileGetValue(
+    sai_switch_profile_id_t /* profile_id */,
+    const char* variable) {
+  auto saiProfileValItr = saiProfileValues.find(variable);
+  return saiProfileValItr != saiProfileValues.end()
+      ? saiProfileValItr->second.c_str()
+      : nullptr;
+}
+
+int saiProfileGetNextValue(
+    sai_switch_profile_id_t /* profile_id */,
+    const char** variable,
+    const char** value) {
+  static auto saiProfileValItr = saiProfileValues.begin();
+  if (!value) {
+    saiProfileValItr = saiProfileValues.begin();
+    return 0;
+  }
+  if (saiProfileValItr == saiProfileValues.end()) {
+    return -1;
+  }
+  *variable = saiProfileValItr->first.c_str();
+  *value = saiProfileValItr->second.c_str();
+  ++saiProfileValItr;
+  return 0;
+}
+
+sai_service_method_table_t kSaiServiceMethodTable = {
+    .profile_get_value = saiProfileGetValue,
+    .profile_get_next_value = saiProfileGetNextValue,
+};
+
+} // namespace
+
+namespace facebook::fboss {
+
+void SaiBinaryTraceConverter::convert(SaiTraceRecord& record) {
+  auto tracer = SaiTracer::getInstance();
+  auto& header = record.header;
+  auto objectType = static_cast<sai_object_type_t>(header.objectType);
+  auto attrs = record.attributes();
+  auto objectId = header.objectId;
+
+  switch (header.op) {
+    case SaiTraceOp::API_INITIALIZE: {
+      std::vector<const char*> variables;
+      std::vector<const char*> values;
+      for (const auto& [variable, value] : record.profile) {
+        variables.push_back(variable.c_str());
+        values.push_back(value.c_str());
+      }
+      tracer->logApiInitialize(
+          variables.data(), values.data(), record.profile.size());
+      break;
+    }
+    case SaiTraceOp::API_UNINITIALIZE:
+      tracer->logApiUninitialize();
+      break;
+    case SaiTraceOp::API_QUERY:
+      tracer->logApiQuery(
+          static_cast<sai_api_t>(header.objectType), record.name);
+      break;
+    case SaiTraceOp::CREATE:
+      switch (objectType) {
+        case SAI_OBJECT_TYPE_SWITCH:
+          tracer->logSwitchCreateFn(&objectId, attrs.size(), attrs.data());
+          tracer->logPostInvocation(header.status, objectId, kNoBegin);
+          break;
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+          tracer->logRouteEntryCreateFn(
+              &header.entry.route, attrs.size(), attrs.data());
+          tracer->logPostInvocation(
+              header.status, SAI_NULL_OBJECT_ID, kNoBegin);
+          break;
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+          tracer->logNeighborEntryCreateFn(
+              &header.entry.neighbor,
+              attrs.size(),
+              attrs.data(),
+              header.status);
+          break;
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+          tracer->logFdbEntryCreateFn(
+              &header.entry.fdb, attrs.size(), attrs.data(), header.status);
+          break;
+        case SAI_OBJECT_TYPE_INSEG_ENTRY:
+          tracer->logInsegEntryCreateFn(
+              &header.entry.inseg, attrs.size(), attrs.data(), header.status);
+          break;
+        default: {
+          auto varName = tracer->logCreateFn(
+              record.name,
+              &objectId,
+              header.switchId,
+              attrs.size(),
+              attrs.data(),
+              objectType);
+          tracer->logPostInvocation(
+              header.status, objectId, kNoBegin, varName);
+          break;
+        }
+      }
+      break;
+    case SaiTraceOp::REMOVE:
+      switch (objectType) {
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+          tracer->logRouteEntryRemoveFn(&header.entry.route);
+          tracer->logPostInvocation(
+              header.status, SAI_NULL_OBJECT_ID, kNoBegin);
+          break;
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+          tracer->logNeighborEntryRemoveFn(
+              &header.entry.neighbor, header.status);
+          break;
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+          tracer->logFdbEntryRemoveFn(&header.entry.fdb, header.status);
+          break;
+        case SAI_OBJECT_TYPE_INSEG_ENTRY:
+          tracer->logInsegEntryRemoveFn(&header.entry.inseg, header.status);
+          break;
+        default:
+          tracer->logRemoveFn(record.name, objectId, objectType);
+          tracer->logPostInvocation(header.status, objectId, kNoBegin);
+          break;
+      }
+      break;
+    case SaiTraceOp::SET_ATTRIBUTE:
+      if (attrs.empty()) {
+        break;
+      }
+      switch (objectType) {
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+          tracer->logRouteEntrySetAttrFn(&header.entry.route, attrs.data());
+          tracer->logPostInvocation(
+              header.status, SAI_NULL_OBJECT_ID, kNoBegin);
+          break;
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+          tracer->logNeighborEntrySetAttrFn(
+              &header.entry.neighbor, attrs.data(), header.status);
+          break;
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+          tracer->logFdbEntrySetAttrFn(
+              &header.entry.fdb, attrs.data(), header.status);
+          break;
+        case SAI_OBJECT_TYPE_INSEG_ENTRY:
+          tracer->logInsegEntrySetAttrFn(
+              &header.entry.inseg, attrs.data(), header.status);
+          break;
+        default:
+          tracer->logSetAttrFn(record.name, objectId, attrs.data(), objectType);
+          tracer->logPostInvocation(header.status, objectId, kNoBegin);
+          break;
+      }
+      break;
+    case SaiTraceOp::DROPPED:
+      tracer->writeToFile({to<std::string>(
+          "printf(\"[WARNING] ",
+          objectId,
+          " SAI calls were dropped from the binary trace\\n\")")});
+      break;
+  }
+}
+
+void SaiBinaryTraceReplayer::replay(SaiTraceRecord& record) {
+  auto& header = record.header;
+  record.remapObjectIds(
+      [this](sai_object_id_t tracedId) { return getObjectId(tracedId); });
+
+  switch (header.op) {
+    case SaiTraceOp::API_INITIALIZE:
+      for (const auto& [variable, value] : record.profile) {
+        // Keep the adapter state of the traced run, as the C source does
+        if (variable == SAI_KEY_WARM_BOOT_WRITE_FILE ||
+            variable == SAI_KEY_WARM_BOOT_READ_FILE) {
+          saiProfileValues.emplace(variable, value + "_replayer");
+        } else {
+          saiProfileValues.emplace(variable, value);
+        }
+      }
+      checkStatus(record, sai_api_initialize(0, &kSaiServiceMethodTable));
+      break;
+    case SaiTraceOp::API_UNINITIALIZE:
+      checkStatus(record, sai_api_uninitialize());
+      break;
+    case SaiTraceOp::API_QUERY:
+      getApi(static_cast<sai_api_t>(header.objectType));
+      break;
+    case SaiTraceOp::CREATE: {
+      sai_object_id_t objectId{SAI_NULL_OBJECT_ID};
+      auto rv = create(record, &objectId);
+      checkStatus(record, rv);
+      if (rv == SAI_STATUS_SUCCESS && header.objectId != SAI_NULL_OBJECT_ID) {
+        objectIds_[header.objectId] = objectId;
+      }
+      break;
+    }
+    case SaiTraceOp::REMOVE: {
+      auto rv = remove(record);
+      checkStatus(record, rv);
+      if (rv == SAI_STATUS_SUCCESS) {
+        objectIds_.erase(header.objectId);
+      }
+      break;
+    }
+    case SaiTraceOp::SET_ATTRIBUTE:
+      checkStatus(record, setAttribute(record));
+      break;
+    case SaiTraceOp::DROPPED:
+      XLOG(WARN) << header.objectId
+                 << " SAI calls were dropped from the trace, replay may "
+                 << "diverge from here";
+      dropped_ += header.objectId;
+      break;
+  }
+}
+
+void* SaiBinaryTraceReplayer::getApi(sai_api_t api) {
+  auto iter = apis_.find(api);
+  if (iter != apis_.end()) {
+    return iter->second;
+  }
+  void* apiTable = nullptr;
+  auto rv = sai_api_query(api, &apiTable);
+  if (rv != SAI_STATUS_SUCCESS || !apiTable) {
+    throw FbossError("Failed to query SAI api ", api, ": ", rv);
+  }
+  apis_.emplace(api, apiTable);
+  return apiTable;
+}
+
+sai_object_id_t SaiBinaryTraceReplayer::getObjectId(
+    sai_object_id_t tracedId) const {
+  // Objects not created in the trace, e.g. the ports of the switch, are
+  // assumed to have the same id as in the traced run
+  auto iter = objectIds_.find(tracedId);
+  return iter == objectIds_.end() ? tracedId : iter->second;
+}
+
+void SaiBinaryTraceReplayer::remapEntry(SaiTraceRecordHeader& header) const {
+  switch (header.objectType) {
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      header.entry.route.switch_id = getObjectId(header.entry.route.switch_id);
+      header.entry.route.vr_id = getObjectId(header.entry.route.vr_id);
+      break;
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      header.entry.neighbor.switch_id =
+          getObjectId(header.entry.neighbor.switch_id);
+      header.entry.neighbor.rif_id = getObjectId(header.entry.neighbor.rif_id);
+      break;
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      header.entry.fdb.switch_id = getObjectId(header.entry.fdb.switch_id);
+      header.entry.fdb.bv_id = getObjectId(header.entry.fdb.bv_id);
+      break;
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      header.entry.inseg.switch_id = getObjectId(header.entry.inseg.switch_id);
+      break;
+    default:
+      break;
+  }
+}
+
+sai_status_t SaiBinaryTraceReplayer::create(
+    SaiTraceRecord& record,
+    sai_object_id_t* objectId) {
+  auto& header = record.header;
+  remapEntry(header);
+  auto attrs = record.attributes();
+  switch (header.objectType) {
+    case SAI_OBJECT_TYPE_SWITCH:
+      return static_cast<sai_switch_api_t*>(getApi(SAI_API_SWITCH))
+          ->create_switch(objectId, attrs.size(), attrs.data());
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      return static_cast<sai_route_api_t*>(getApi(SAI_API_ROUTE))
+          ->create_route_entry(
+              &header.entry.route, attrs.size(), attrs.data());
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      return static_cast<sai_neighbor_api_t*>(getApi(SAI_API_NEIGHBOR))
+          ->create_neighbor_entry(
+              &header.entry.neighbor, attrs.size(), attrs.data());
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      return static_cast<sai_fdb_api_t*>(getApi(SAI_API_FDB))
+          ->create_fdb_entry(&header.entry.fdb, attrs.size(), attrs.data());
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      return static_cast<sai_mpls_api_t*>(getApi(SAI_API_MPLS))
+          ->create_inseg_entry(
+              &header.entry.inseg, attrs.size(), attrs.data());
+    default:
+      break;
+  }
+  auto fns = kSaiObjectFns.find(static_cast<sai_object_type_t>(
+      header.objectType));
+  if (fns == kSaiObjectFns.end()) {
+    throw FbossError("Unsupported object type in trace ", header.objectType);
+  }
+  return fns->second.create(
+      getApi(fns->second.api),
+      objectId,
+      getObjectId(header.switchId),
+      attrs.size(),
+      attrs.data());
+}
+
+sai_status_t SaiBinaryTraceReplayer::remove(SaiTraceRecord& record) {
+  auto& header = record.header;
+  remapEntry(header);
+  switch (header.objectType) {
+    case SAI_OBJECT_TYPE_SWITCH:
+      return static_cast<sai_switch_api_t*>(getApi(SAI_API_SWITCH))
+          ->remove_switch(getObjectId(header.objectId));
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      return static_cast<sai_route_api_t*>(getApi(SAI_API_ROUTE))
+          ->remove_route_entry(&header.entry.route);
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      return static_cast<sai_neighbor_api_t*>(getApi(SAI_API_NEIGHBOR))
+          ->remove_neighbor_entry(&header.entry.neighbor);
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      return static_cast<sai_fdb_api_t*>(getApi(SAI_API_FDB))
+          ->remove_fdb_entry(&header.entry.fdb);
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      return static_cast<sai_mpls_api_t*>(getApi(SAI_API_MPLS))
+          ->remove_inseg_entry(&header.entry.inseg);
+    default:
+      break;
+  }
+  auto fns = kSaiObjectFns.find(static_cast<sai_object_type_t>(
+      header.objectType));
+  if (fns == kSaiObjectFns.end()) {
+    throw FbossError("Unsupported object type in trace ", header.objectType);
+  }
+  return fns->second.remove(
+      getApi(fns->second.api), getObjectId(header.objectId));
+}
+
+sai_status_t SaiBinaryTraceReplayer::setAttribute(SaiTraceRecord& record) {
+  auto& header = record.header;
+  remapEntry(header);
+  auto attrs = record.attributes();
+  if (attrs.empty()) {
+    throw FbossError("Set attribute record without attribute");
+  }
+  switch (header.objectType) {
+    case SAI_OBJECT_TYPE_SWITCH:
+      return static_cast<sai_switch_api_t*>(getApi(SAI_API_SWITCH))
+          ->set_switch_attribute(getObjectId(header.objectId), attrs.data());
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      return static_cast<sai_route_api_t*>(getApi(SAI_API_ROUTE))
+          ->set_route_entry_attribute(&header.entry.route, attrs.data());
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      return static_cast<sai_neighbor_api_t*>(getApi(SAI_API_NEIGHBOR))
+          ->set_neighbor_entry_attribute(
+              &header.entry.neighbor, attrs.data());
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      return static_cast<sai_fdb_api_t*>(getApi(SAI_API_FDB))
+          ->set_fdb_entry_attribute(&header.entry.fdb, attrs.data());
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      return static_cast<sai_mpls_api_t*>(getApi(SAI_API_MPLS))
+          ->set_inseg_entry_attribute(&header.entry.inseg, attrs.data());
+    default:
+      break;
+  }
+  auto fns = kSaiObjectFns.find(static_cast<sai_object_type_t>(
+      header.objectType));
+  if (fns == kSaiObjectFns.end()) {
+    throw FbossError("Unsupported object type in trace ", header.objectType);
+  }
+  return fns->second.setAttribute(
+      getApi(fns->second.api), getObjectId(header.objectId), attrs.data());
+}
+
+void SaiBinaryTraceReplayer::checkStatus(
+    const SaiTraceRecord& record,
+    sai_status_t rv) {
+  ++calls_;
+  if (rv != record.header.status) {
+    ++mismatches_;
+    XLOG(ERR) << "Unexpected rv at " << calls_ << " " << record.name
+              << " with status " << rv << ", traced " << record.header.status;
+  }
+}
+
+} // namespace facebook::fboss
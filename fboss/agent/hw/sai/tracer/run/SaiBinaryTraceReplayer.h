@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <map>
+#include <unordered_map>
+
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace facebook::fboss {
+
+/*
+ * Converts a binary trace to the C source SaiTracer writes to --sai_log,
+ * by handing every record to SaiTracer as if the call was just made.
+ * Timestamps in the generated source are the conversion time.
+ */
+class SaiBinaryTraceConverter {
+ public:
+  void convert(SaiTraceRecord& record);
+};
+
+/*
+ * Replays a binary trace against the SAI implementation the binary is
+ * linked with. Object ids in the trace are translated to the ones returned
+ * by the replayed create calls, and the status of every call is compared
+ * with the traced one.
+ */
+class SaiBinaryTraceReplayer {
+ public:
+  void replay(SaiTraceRecord& record);
+
+  uint64_t calls() const {
+    return calls_;
+  }
+  uint64_t mismatches() const {
+    return mismatches_;
+  }
+  uint64_t dropped() const {
+    return dropped_;
+  }
+
+ private:
+  void* getApi(sai_api_t api);
+  sai_object_id_t getObjectId(sai_object_id_t tracedId) const;
+  void remapEntry(SaiTraceRecordHeader& header) const;
+
+  sai_status_t create(SaiTraceRecord& record, sai_object_id_t* objectId);
+  sai_status_t remove(SaiTraceRecord& record);
+  sai_status_t setAttribute(SaiTraceRecord& record);
+
+  void checkStatus(const SaiTraceRecord& record, sai_status_t rv);
+
+  std::map<sai_api_t, void*> apis_;
+  // Traced object id -> replayed object id
+  std::unordered_map<sai_object_id_t, sai_object_id_t> objectIds_;
+  uint64_t calls_{0};
+  uint64_t mismatches_{0};
+  uint64_t dropped_{0};
+};
+
+} // namespace facebook::fboss
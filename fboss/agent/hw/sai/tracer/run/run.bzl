@@ -1,6 +1,6 @@
 load("@fbcode_macros//build_defs:auto_headers.bzl", "AutoHeaders")
 load("@fbcode_macros//build_defs:cpp_binary.bzl", "cpp_binary")
-load("//fboss/agent/hw/sai/impl:impl.bzl", "SAI_IMPLS", "to_versions")
+load("//fboss/agent/hw/sai/impl:impl.bzl", "SAI_IMPLS", "to_impl_lib_name", "to_impl_suffix", "to_versions")
 
 def _sai_replayer_binary(sai_impl):
     sai_impl_external_deps = []
@@ -23,6 +23,28 @@ def _sai_replayer_binary(sai_impl):
         ] + sai_impl_external_deps,
     )
 
+def _sai_binary_trace_binary(sai_impl):
+    return cpp_binary(
+        name = "sai_binary_trace-{}-{}".format(sai_impl.name, sai_impl.version),
+        srcs = [
+            "SaiBinaryTraceMain.cpp",
+            "SaiBinaryTraceReplayer.cpp",
+        ],
+        auto_headers = AutoHeaders.SOURCES,
+        versions = to_versions(sai_impl),
+        deps = [
+            "//fboss/agent:fboss-error",
+            "//fboss/agent/hw/sai/impl:{}".format(to_impl_lib_name(sai_impl)),
+            "//fboss/agent/hw/sai/tracer:sai_tracer{}".format(to_impl_suffix(sai_impl)),
+            "//folly/init:init",
+            "//folly/logging:logging",
+        ],
+        external_deps = [
+            "gflags",
+        ],
+    )
+
 def all_replayer_binaries():
     for sai_impl in SAI_IMPLS:
         _sai_replayer_binary(sai_impl)
+        _sai_binary_trace_binary(sai_impl)
@@ -0,0 +1,336 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiBinaryTrace.h"
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/lib/CommonUtils.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <folly/FileUtil.h>
+#include <folly/testing/TestUtil.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::fboss;
+
+namespace {
+
+constexpr sai_object_id_t kPortId = 0x1000000000001;
+constexpr sai_object_id_t kSwitchId = 0x21000000000000;
+constexpr sai_object_id_t kQosMapId = 0x14000000000001;
+constexpr uint64_t kTimestampUs = 1234;
+
+const std::vector<uint32_t> kLanes = {1, 2, 3, 4};
+const std::vector<sai_object_id_t> kQueues = {
+    0x15000000000001,
+    0x15000000000002};
+
+// A port create covering each kind of attribute
+SaiTraceRecord makePortRecord() {
+  SaiTraceRecord record(
+      SaiTraceOp::CREATE, SAI_OBJECT_TYPE_PORT, "create_port");
+  record.header.objectId = kPortId;
+  record.header.switchId = kSwitchId;
+  record.header.status = SAI_STATUS_SUCCESS;
+  record.header.timestampUs = kTimestampUs;
+
+  sai_attribute_t adminState;
+  adminState.id = SAI_PORT_ATTR_ADMIN_STATE;
+  adminState.value.booldata = true;
+  record.addAttribute(adminState);
+
+  // The record copies the lists, they need not outlive it
+  auto laneList = kLanes;
+  sai_attribute_t lanes;
+  lanes.id = SAI_PORT_ATTR_HW_LANE_LIST;
+  lanes.value.u32list.count = laneList.size();
+  lanes.value.u32list.list = laneList.data();
+  record.addAttribute(
+      lanes,
+      SaiTraceAttrKind::LIST,
+      offsetof(sai_attribute_value_t, u32list),
+      sizeof(uint32_t));
+
+  auto queueList = kQueues;
+  sai_attribute_t queues;
+  queues.id = SAI_PORT_ATTR_QOS_QUEUE_LIST;
+  queues.value.objlist.count = queueList.size();
+  queues.value.objlist.list = queueList.data();
+  record.addAttribute(
+      queues,
+      SaiTraceAttrKind::OID_LIST,
+      offsetof(sai_attribute_value_t, objlist),
+      sizeof(sai_object_id_t));
+
+  // e.g. a get with only the count filled in
+  sai_attribute_t mirrors;
+  mirrors.id = SAI_PORT_ATTR_INGRESS_MIRROR_SESSION;
+  mirrors.value.objlist.count = 0;
+  mirrors.value.objlist.list = nullptr;
+  record.addAttribute(
+      mirrors,
+      SaiTraceAttrKind::OID_LIST,
+      offsetof(sai_attribute_value_t, objlist),
+      sizeof(sai_object_id_t));
+
+  sai_attribute_t qosMap;
+  qosMap.id = SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP;
+  qosMap.value.oid = kQosMapId;
+  record.addAttribute(
+      qosMap, SaiTraceAttrKind::OID, offsetof(sai_attribute_value_t, oid));
+  return record;
+}
+
+SaiTraceRecord makeInitRecord() {
+  SaiTraceRecord record(
+      SaiTraceOp::API_INITIALIZE, SAI_OBJECT_TYPE_NULL, "sai_api_initialize");
+  record.profile = {{"SAI_KEY_INIT_CONFIG_FILE", "/etc/sai.cfg"}, {"k", ""}};
+  return record;
+}
+
+void checkPortRecord(SaiTraceRecord& record) {
+  EXPECT_EQ(record.header.op, SaiTraceOp::CREATE);
+  EXPECT_EQ(record.header.objectType, SAI_OBJECT_TYPE_PORT);
+  EXPECT_EQ(record.header.objectId, kPortId);
+  EXPECT_EQ(record.header.switchId, kSwitchId);
+  EXPECT_EQ(record.header.status, SAI_STATUS_SUCCESS);
+  EXPECT_EQ(record.header.timestampUs, kTimestampUs);
+  EXPECT_EQ(record.name, "create_port");
+  EXPECT_TRUE(record.profile.empty());
+
+  auto attrs = record.attributes();
+  ASSERT_EQ(attrs.size(), 5);
+  EXPECT_EQ(attrs[0].id, SAI_PORT_ATTR_ADMIN_STATE);
+  EXPECT_TRUE(attrs[0].value.booldata);
+
+  EXPECT_EQ(attrs[1].id, SAI_PORT_ATTR_HW_LANE_LIST);
+  ASSERT_EQ(attrs[1].value.u32list.count, kLanes.size());
+  EXPECT_EQ(
+      std::vector<uint32_t>(
+          attrs[1].value.u32list.list,
+          attrs[1].value.u32list.list + kLanes.size()),
+      kLanes);
+
+  EXPECT_EQ(attrs[2].id, SAI_PORT_ATTR_QOS_QUEUE_LIST);
+  ASSERT_EQ(attrs[2].value.objlist.count, kQueues.size());
+  EXPECT_EQ(
+      std::vector<sai_object_id_t>(
+          attrs[2].value.objlist.list,
+          attrs[2].value.objlist.list + kQueues.size()),
+      kQueues);
+
+  EXPECT_EQ(attrs[3].id, SAI_PORT_ATTR_INGRESS_MIRROR_SESSION);
+  EXPECT_EQ(attrs[3].value.objlist.count, 0);
+  EXPECT_EQ(attrs[3].value.objlist.list, nullptr);
+
+  EXPECT_EQ(attrs[4].id, SAI_PORT_ATTR_QOS_DSCP_TO_TC_MAP);
+  EXPECT_EQ(attrs[4].value.oid, kQosMapId);
+}
+
+std::string makeFileHeader() {
+  SaiBinaryTraceFileHeader fileHeader;
+  std::memset(&fileHeader, 0, sizeof(fileHeader));
+  fileHeader.magic = kSaiBinaryTraceMagic;
+  fileHeader.version = kSaiBinaryTraceVersion;
+  fileHeader.saiApiVersion = SAI_API_VERSION;
+  fileHeader.attrValueSize = sizeof(sai_attribute_value_t);
+  fileHeader.recordHeaderSize = sizeof(SaiTraceRecordHeader);
+  return std::string(
+      reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+}
+
+} // namespace
+
+TEST(SaiBinaryTraceTest, RecordRoundTrip) {
+  auto serialized = makePortRecord().serialize() + makeInitRecord().serialize();
+  auto buf = folly::ByteRange(folly::StringPiece(serialized));
+
+  auto port = SaiTraceRecord::deserialize(buf);
+  ASSERT_TRUE(port.has_value());
+  checkPortRecord(*port);
+
+  auto init = SaiTraceRecord::deserialize(buf);
+  ASSERT_TRUE(init.has_value());
+  EXPECT_EQ(init->header.op, SaiTraceOp::API_INITIALIZE);
+  EXPECT_EQ(init->name, "sai_api_initialize");
+  EXPECT_EQ(init->attributeCount(), 0);
+  EXPECT_EQ(init->profile, makeInitRecord().profile);
+
+  EXPECT_TRUE(buf.empty());
+  EXPECT_FALSE(SaiTraceRecord::deserialize(buf).has_value());
+}
+
+TEST(SaiBinaryTraceTest, RemapObjectIds) {
+  auto serialized = makePortRecord().serialize();
+  auto buf = folly::ByteRange(folly::StringPiece(serialized));
+  auto record = SaiTraceRecord::deserialize(buf);
+  ASSERT_TRUE(record.has_value());
+
+  std::vector<sai_object_id_t> remapped;
+  record->remapObjectIds([&](sai_object_id_t oid) {
+    remapped.push_back(oid);
+    return oid + 100;
+  });
+  // Only OID and non NULL OID_LIST attributes hold object ids
+  EXPECT_EQ(
+      remapped,
+      std::vector<sai_object_id_t>({kQueues[0], kQueues[1], kQosMapId}));
+
+  auto attrs = record->attributes();
+  ASSERT_EQ(attrs.size(), 5);
+  EXPECT_TRUE(attrs[0].value.booldata);
+  EXPECT_EQ(
+      std::vector<uint32_t>(
+          attrs[1].value.u32list.list,
+          attrs[1].value.u32list.list + attrs[1].value.u32list.count),
+      kLanes);
+  ASSERT_EQ(attrs[2].value.objlist.count, 2);
+  EXPECT_EQ(attrs[2].value.objlist.list[0], kQueues[0] + 100);
+  EXPECT_EQ(attrs[2].value.objlist.list[1], kQueues[1] + 100);
+  EXPECT_EQ(attrs[3].value.objlist.list, nullptr);
+  EXPECT_EQ(attrs[4].value.oid, kQosMapId + 100);
+}
+
+TEST(SaiBinaryTraceTest, TruncatedRecord) {
+  auto serialized = makeInitRecord().serialize();
+  for (auto size : {
+           size_t(1),
+           sizeof(SaiTraceRecordHeader) - 1,
+           sizeof(SaiTraceRecordHeader),
+           serialized.size() - 1,
+       }) {
+    auto truncated = serialized.substr(0, size);
+    auto buf = folly::ByteRange(folly::StringPiece(truncated));
+    EXPECT_THROW(SaiTraceRecord::deserialize(buf), FbossError)
+        << "Record truncated to " << size << " bytes";
+  }
+
+  // Profile value missing its NUL terminator
+  auto corrupt = serialized;
+  corrupt.back() = 'x';
+  auto buf = folly::ByteRange(folly::StringPiece(corrupt));
+  EXPECT_THROW(SaiTraceRecord::deserialize(buf), FbossError);
+}
+
+TEST(SaiBinaryTraceTest, WriterReaderRoundTrip) {
+  folly::test::TemporaryDirectory tmpDir;
+  auto path = (tmpDir.path() / "trace.bin").string();
+  {
+    SaiBinaryTraceWriter writer(path, 1024);
+    writer.append(makeInitRecord());
+    writer.append(makePortRecord());
+    EXPECT_EQ(writer.droppedRecords(), 0);
+  }
+
+  SaiBinaryTraceReader reader(path);
+  EXPECT_EQ(reader.fileHeader().magic, kSaiBinaryTraceMagic);
+  EXPECT_EQ(reader.fileHeader().version, kSaiBinaryTraceVersion);
+  EXPECT_EQ(reader.fileHeader().saiApiVersion, SAI_API_VERSION);
+  auto init = reader.next();
+  ASSERT_TRUE(init.has_value());
+  EXPECT_EQ(init->header.op, SaiTraceOp::API_INITIALIZE);
+  EXPECT_EQ(init->profile, makeInitRecord().profile);
+  auto port = reader.next();
+  ASSERT_TRUE(port.has_value());
+  checkPortRecord(*port);
+  EXPECT_FALSE(reader.next().has_value());
+}
+
+TEST(SaiBinaryTraceTest, ReaderRejectsOtherFiles) {
+  folly::test::TemporaryDirectory tmpDir;
+  auto path = (tmpDir.path() / "trace.bin").string();
+  ASSERT_TRUE(
+      folly::writeFile(std::string("not a trace at all"), path.c_str()));
+  EXPECT_THROW(SaiBinaryTraceReader{path}, FbossError);
+
+  auto header = makeFileHeader();
+  header[offsetof(SaiBinaryTraceFileHeader, version)] =
+      kSaiBinaryTraceVersion + 1;
+  ASSERT_TRUE(folly::writeFile(header, path.c_str()));
+  EXPECT_THROW(SaiBinaryTraceReader{path}, FbossError);
+}
+
+TEST(SaiBinaryTraceTest, WriterRecordsDrops) {
+  // Trace to a FIFO that is not read from, so the flush thread blocks on
+  // the first record larger than the pipe buffer and the queue fills up
+  folly::test::TemporaryDirectory tmpDir;
+  auto path = (tmpDir.path() / "trace.fifo").string();
+  ASSERT_EQ(mkfifo(path.c_str(), 0644), 0);
+  auto readFd = open(path.c_str(), O_RDONLY | O_NONBLOCK);
+  ASSERT_GE(readFd, 0);
+
+  SaiTraceRecord bigRecord(
+      SaiTraceOp::SET_ATTRIBUTE,
+      SAI_OBJECT_TYPE_PORT,
+      std::string(128 * 1024, 'x'));
+  const auto recordSize = bigRecord.serialize().size();
+  constexpr auto kRecords = 20;
+
+  auto writer = std::make_unique<SaiBinaryTraceWriter>(path, 2);
+  for (auto i = 0; i < kRecords; ++i) {
+    writer->append(bigRecord);
+  }
+  // At most a flush batch and a full queue are held
+  auto dropped = writer->droppedRecords();
+  EXPECT_GT(dropped, 0);
+
+  std::string trace;
+  std::atomic<size_t> traceSize{0};
+  std::thread drainThread([&]() {
+    fcntl(readFd, F_SETFL, fcntl(readFd, F_GETFL) & ~O_NONBLOCK);
+    char chunk[64 * 1024];
+    ssize_t bytes;
+    while ((bytes = folly::readNoInt(readFd, chunk, sizeof(chunk))) > 0) {
+      trace.append(chunk, bytes);
+      traceSize += bytes;
+    }
+  });
+
+  // Wait for all records that made it in to be flushed, so the queue has
+  // room for the DROPPED record and the next one
+  const auto expectedSize =
+      sizeof(SaiBinaryTraceFileHeader) + (kRecords - dropped) * recordSize;
+  WITH_RETRIES_N_TIMED(100, std::chrono::milliseconds(100), {
+    EXPECT_EVENTUALLY_EQ(traceSize.load(), expectedSize);
+  });
+  SaiTraceRecord lastRecord(
+      SaiTraceOp::REMOVE, SAI_OBJECT_TYPE_PORT, "remove_port");
+  writer->append(lastRecord);
+  EXPECT_EQ(writer->droppedRecords(), dropped);
+  writer.reset();
+  drainThread.join();
+  close(readFd);
+
+  auto buf = folly::ByteRange(folly::StringPiece(trace));
+  buf.advance(sizeof(SaiBinaryTraceFileHeader));
+  std::vector<SaiTraceRecord> records;
+  while (auto record = SaiTraceRecord::deserialize(buf)) {
+    records.push_back(std::move(*record));
+  }
+  ASSERT_EQ(records.size(), kRecords - dropped + 2);
+  for (auto i = 0; i < kRecords - dropped; ++i) {
+    EXPECT_EQ(records[i].header.op, SaiTraceOp::SET_ATTRIBUTE);
+  }
+  const auto& droppedRecord = records[records.size() - 2];
+  EXPECT_EQ(droppedRecord.header.op, SaiTraceOp::DROPPED);
+  EXPECT_EQ(droppedRecord.header.objectId, dropped);
+  EXPECT_EQ(records.back().header.op, SaiTraceOp::REMOVE);
+  EXPECT_EQ(records.back().name, "remove_port");
+}
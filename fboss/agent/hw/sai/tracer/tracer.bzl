@@ -34,6 +34,7 @@ def _sai_api_tracer_impl(sai_impl):
             "QueueApiTracer.cpp",
             "RouteApiTracer.cpp",
             "RouterInterfaceApiTracer.cpp",
+            "SaiBinaryTrace.cpp",
             "SaiTracer.cpp",
             "SamplePacketApiTracer.cpp",
             "SchedulerApiTracer.cpp",
@@ -64,6 +64,17 @@ struct IpPrefix {
   2: i16 prefixLength;
 }
 
+/*
+ * Selects routes for the streaming route table APIs. Routes must match all
+ * fields that are set.
+ */
+struct RouteTableFilter {
+  // Routes equal to or more specific than this prefix
+  1: optional IpPrefix prefix;
+  // Routes with a next hop entry from this client
+  2: optional i16 clientId;
+}
+
 enum RouteForwardAction {
   DROP = 0,
   TO_CPU = 1,
@@ -941,6 +952,23 @@ service FbossCtrl extends phy.FbossCommonPhyCtrl {
   list<RouteDetails> getRouteTableDetailsByClients(
     1: list<i16> clientId,
   ) throws (1: fboss.FbossBaseError error);
+  /*
+   * Streaming versions of getRouteTable and getRouteTableDetails, for route
+   * tables too large to return in a single response. Routes are read from
+   * one SwitchState snapshot and sent in chunks of at most chunkSize routes
+   * (a default is used if chunkSize <= 0), as the client asks for them.
+   *
+   * With filter.clientId set, streamRouteTable returns that client's next
+   * hops for each route, like getRouteTableByClient.
+   */
+  stream<list<UnicastRoute>> streamRouteTable(
+    1: RouteTableFilter filter,
+    2: i32 chunkSize,
+  ) throws (1: fboss.FbossBaseError error);
+  stream<list<RouteDetails>> streamRouteTableDetails(
+    1: RouteTableFilter filter,
+    2: i32 chunkSize,
+  ) throws (1: fboss.FbossBaseError error);
   InterfaceDetail getInterfaceDetail(1: i32 interfaceId) throws (
     1: fboss.FbossBaseError error,
   );
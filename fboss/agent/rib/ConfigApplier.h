@@ -60,7 +60,8 @@ class ConfigApplier {
       folly::Range<StaticIp2MplsRouteIterator> staticIp2MplsRouteRange,
       folly::Range<StaticMplsRouteWithNextHopsIterator> staticMplsRouteRange,
       folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsDropRouteRange,
-      folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsCpuRouteRange);
+      folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsCpuRouteRange,
+      NextHopDependencyIndex* nhopDependencies = nullptr);
 
   void apply();
 
@@ -77,6 +78,7 @@ class ConfigApplier {
   folly::Range<StaticMplsRouteWithNextHopsIterator> staticMplsRouteRange_;
   folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsDropRouteRange_;
   folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsCpuRouteRange_;
+  NextHopDependencyIndex* nhopDependencies_;
 };
 
 } // namespace facebook::fboss
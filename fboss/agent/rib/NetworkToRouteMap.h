@@ -11,7 +11,7 @@
 
 #include "fboss/agent/state/Route.h"
 #include "fboss/agent/types.h"
-#include "fboss/lib/RadixTree.h"
+#include "fboss/lib/PooledRadixTree.h"
 
 #include <folly/IPAddress.h>
 #include <folly/json/dynamic.h>
@@ -38,14 +38,15 @@ class NetworkToRouteMap
           std::is_same_v<LabelID, AddressT>,
           std::unordered_map<LabelID, std::shared_ptr<Route<LabelID>>>,
           facebook::network::
-              RadixTree<AddressT, std::shared_ptr<Route<AddressT>>>> {
+              PooledRadixTree<AddressT, std::shared_ptr<Route<AddressT>>>> {
   static constexpr auto kRoutes = "routes";
 
  public:
   using Base = std::conditional_t<
       std::is_same_v<LabelID, AddressT>,
       std::unordered_map<LabelID, std::shared_ptr<Route<LabelID>>>,
-      facebook::network::RadixTree<AddressT, std::shared_ptr<Route<AddressT>>>>;
+      facebook::network::
+          PooledRadixTree<AddressT, std::shared_ptr<Route<AddressT>>>>;
   using Base::Base;
   /* implicit */ NetworkToRouteMap(Base&& radixTree)
       : Base(std::move(radixTree)) {}
@@ -55,7 +56,7 @@ class NetworkToRouteMap
       std::is_same_v<LabelID, AddressT>,
       std::unordered_map<LabelID, std::shared_ptr<Route<LabelID>>>::iterator,
       typename facebook::network::
-          RadixTree<AddressT, std::shared_ptr<Route<AddressT>>>::Iterator>;
+          PooledRadixTree<AddressT, std::shared_ptr<Route<AddressT>>>::Iterator>;
   using ThriftType = typename NetworkToRouteMapThriftType<AddressT>::type;
   using RouteFilter =
       std::function<bool(const std::shared_ptr<Route<AddressT>>&)>;
@@ -137,8 +138,8 @@ std::shared_ptr<Route<AddrT>>& value(
 
 template <typename AddrT>
 std::shared_ptr<Route<AddrT>>& value(
-    facebook::network::RadixTreeNode<AddrT, std::shared_ptr<Route<AddrT>>>&
-        iter) {
+    facebook::network::
+        PooledRadixTreeNode<AddrT, std::shared_ptr<Route<AddrT>>>& iter) {
   return iter.value();
 }
 
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+
+#include <algorithm>
+
+namespace facebook::fboss {
+
+void NextHopDependencyIndex::clear() {
+  v4NextHopToDependents_.clear();
+  v6NextHopToDependents_.clear();
+  routeToNextHops_.clear();
+}
+
+void NextHopDependencyIndex::setNextHops(
+    const folly::CIDRNetwork& route,
+    NextHops nhops) {
+  std::sort(nhops.begin(), nhops.end());
+  nhops.erase(std::unique(nhops.begin(), nhops.end()), nhops.end());
+  auto itr = routeToNextHops_.find(route);
+  if (itr == routeToNextHops_.end()) {
+    if (nhops.empty()) {
+      return;
+    }
+    itr = routeToNextHops_.emplace(route, NextHops{}).first;
+  } else if (itr->second == nhops) {
+    // Common case, re-resolving a route whose next hops did not change
+    return;
+  }
+  for (const auto& nhop : itr->second) {
+    removeDependent(nhop, route);
+  }
+  for (const auto& nhop : nhops) {
+    addDependent(nhop, route);
+  }
+  if (nhops.empty()) {
+    routeToNextHops_.erase(itr);
+  } else {
+    itr->second = std::move(nhops);
+  }
+}
+
+void NextHopDependencyIndex::erase(const folly::CIDRNetwork& route) {
+  auto itr = routeToNextHops_.find(route);
+  if (itr == routeToNextHops_.end()) {
+    return;
+  }
+  for (const auto& nhop : itr->second) {
+    removeDependent(nhop, route);
+  }
+  routeToNextHops_.erase(itr);
+}
+
+void NextHopDependencyIndex::addDependent(
+    const folly::IPAddress& nhop,
+    const folly::CIDRNetwork& route) {
+  if (nhop.isV4()) {
+    v4NextHopToDependents_[nhop.asV4()].insert(route);
+  } else {
+    v6NextHopToDependents_[nhop.asV6()].insert(route);
+  }
+}
+
+void NextHopDependencyIndex::removeDependent(
+    const folly::IPAddress& nhop,
+    const folly::CIDRNetwork& route) {
+  auto remove = [&route](auto& nhopToDependents, const auto& addr) {
+    auto itr = nhopToDependents.find(addr);
+    if (itr == nhopToDependents.end()) {
+      return;
+    }
+    itr->second.erase(route);
+    if (itr->second.empty()) {
+      nhopToDependents.erase(itr);
+    }
+  };
+  if (nhop.isV4()) {
+    remove(v4NextHopToDependents_, nhop.asV4());
+  } else {
+    remove(v6NextHopToDependents_, nhop.asV6());
+  }
+}
+
+} // namespace facebook::fboss
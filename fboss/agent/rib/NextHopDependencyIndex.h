@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/IPAddress.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * Reverse index from next hop addresses to the IP routes that resolve over
+ * them. RibRouteUpdater uses it to re-resolve only the routes affected by
+ * an update, instead of walking the whole route table.
+ *
+ * A route resolves each of its next hops through a longest match in the
+ * route table, so its resolution can only change if a prefix covering one
+ * of its next hops is added, removed or re-resolved. Dependents are keyed
+ * by next hop address rather than by resolving prefix so that a scan over
+ * the addresses covered by a changed prefix also finds routes that would
+ * move over to a newly added, more specific prefix.
+ *
+ * The index is only accurate as long as all route table changes go through
+ * RibRouteUpdater. Code that modifies route tables any other way (rollback,
+ * importing FIBs) must invalidate() the index. The next update then does a
+ * full resolution and rebuilds it.
+ */
+class NextHopDependencyIndex {
+ public:
+  using NextHops = std::vector<folly::IPAddress>;
+
+  bool isValid() const {
+    return valid_;
+  }
+  void setValid() {
+    valid_ = true;
+  }
+  void invalidate() {
+    clear();
+    valid_ = false;
+  }
+  void clear();
+
+  /*
+   * Record the next hops route resolves over, replacing what was recorded
+   * for it before.
+   */
+  void setNextHops(const folly::CIDRNetwork& route, NextHops nhops);
+  void erase(const folly::CIDRNetwork& route);
+
+  /*
+   * Call fn for every route with a next hop in prefix. The same route may
+   * be visited more than once if several of its next hops are in prefix.
+   */
+  template <typename Fn>
+  void forEachDependent(const folly::CIDRNetwork& prefix, const Fn& fn) const {
+    if (prefix.first.isV4()) {
+      forEachDependentImpl(
+          v4NextHopToDependents_, prefix.first.asV4(), prefix.second, fn);
+    } else {
+      forEachDependentImpl(
+          v6NextHopToDependents_, prefix.first.asV6(), prefix.second, fn);
+    }
+  }
+
+  size_t numRoutes() const {
+    return routeToNextHops_.size();
+  }
+
+ private:
+  using Dependents = std::set<folly::CIDRNetwork>;
+  template <typename AddrT>
+  using NextHopToDependents = std::map<AddrT, Dependents>;
+
+  template <typename AddrT, typename Fn>
+  static void forEachDependentImpl(
+      const NextHopToDependents<AddrT>& nhopToDependents,
+      const AddrT& network,
+      uint8_t mask,
+      const Fn& fn) {
+    // Next hops covered by a prefix are contiguous in address order
+    for (auto itr = nhopToDependents.lower_bound(network.mask(mask));
+         itr != nhopToDependents.end() && itr->first.inSubnet(network, mask);
+         ++itr) {
+      for (const auto& dependent : itr->second) {
+        fn(dependent);
+      }
+    }
+  }
+
+  void addDependent(
+      const folly::IPAddress& nhop,
+      const folly::CIDRNetwork& route);
+  void removeDependent(
+      const folly::IPAddress& nhop,
+      const folly::CIDRNetwork& route);
+
+  NextHopToDependents<folly::IPAddressV4> v4NextHopToDependents_;
+  NextHopToDependents<folly::IPAddressV6> v6NextHopToDependents_;
+  std::map<folly::CIDRNetwork, NextHops> routeToNextHops_;
+  bool valid_{false};
+};
+
+} // namespace facebook::fboss
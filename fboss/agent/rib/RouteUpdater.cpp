@@ -15,6 +15,7 @@
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
 #include <boost/integer/common_factor.hpp>
+#include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 
 #include "fboss/agent/FbossError.h"
@@ -23,6 +24,7 @@
 #include "fboss/agent/state/Route.h"
 
 #include <algorithm>
+#include <set>
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/state/RouteNextHopEntry.h"
 #include "fboss/agent/state/RouteTypes.h"
@@ -52,8 +54,12 @@ RibRouteUpdater::RibRouteUpdater(
 RibRouteUpdater::RibRouteUpdater(
     IPv4NetworkToRouteMap* v4Routes,
     IPv6NetworkToRouteMap* v6Routes,
-    LabelToRouteMap* mplsRoutes)
-    : v4Routes_(v4Routes), v6Routes_(v6Routes), mplsRoutes_(mplsRoutes) {}
+    LabelToRouteMap* mplsRoutes,
+    NextHopDependencyIndex* nhopDependencies)
+    : v4Routes_(v4Routes),
+      v6Routes_(v6Routes),
+      mplsRoutes_(mplsRoutes),
+      nhopDependencies_(nhopDependencies) {}
 
 void RibRouteUpdater::update(
     const std::map<ClientID, std::vector<RouteEntry>>& toAdd,
@@ -132,12 +138,14 @@ void RibRouteUpdater::addOrReplaceRouteImpl(
     if (!existingRouteForClient || !(*existingRouteForClient == entry)) {
       route = writableRoute<AddressT>(it);
       route->update(clientID, entry);
+      routeChanged(prefix, false /* erased */);
     }
     return;
   }
 
   routes->insert(
       prefix, std::make_shared<Route<AddressT>>(prefix, clientID, entry));
+  routeChanged(prefix, false /* erased */);
 }
 
 void RibRouteUpdater::addOrReplaceRoute(
@@ -196,9 +204,11 @@ void RibRouteUpdater::delRouteImpl(
     // If this client's the only entry, simply erase
     XLOG(DBG3) << "Deleting route: " << route->str();
     routes->erase(it);
+    routeChanged(prefix, true /* erased */);
   } else {
     route = writableRoute<AddressT>(it);
     route->delEntryForClient(clientID);
+    routeChanged(prefix, false /* erased */);
 
     XLOG(DBG3) << "Deleted next-hops for prefix " << prefix.str()
                << "from client " << folly::to<std::string>(clientID);
@@ -258,18 +268,24 @@ void RibRouteUpdater::removeAllRoutesFromClientImpl(
     if (!nhopEntry) {
       continue;
     }
+    auto erased = false;
     if (route->numClientEntries() == 1) {
       // This client's is the only entry avoid unnecessary cloning
       // we are going to prune the route anyways
       toDelete.push_back(it);
+      erased = true;
     } else {
       route = writableRoute<AddressT>(it);
       route->delEntryForClient(clientID);
       if (route->hasNoEntry()) {
         // The nexthops we removed was the only one.  Delete the route->
         toDelete.push_back(it);
+        erased = true;
       }
     }
+    if constexpr (!std::is_same_v<LabelID, AddressT>) {
+      routeChanged(route->prefix(), erased);
+    }
   }
 
   // Now, delete whatever routes went from 1 nexthoplist to 0.
@@ -574,6 +590,11 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
   const auto action = bestEntry->getAction();
   const auto counterID = bestEntry->getCounterID();
   const auto classID = bestEntry->getClassID();
+  if constexpr (!std::is_same_v<LabelID, AddressT>) {
+    if (nhopDependencies_) {
+      updateNextHopDependencies(route->prefix(), *bestEntry);
+    }
+  }
   if (action == RouteForwardAction::DROP) {
     hasDrop = true;
   } else if (action == RouteForwardAction::TO_CPU) {
@@ -743,31 +764,150 @@ void RibRouteUpdater::resolve(NetworkToRouteMap<AddressT>* routes) {
   }
 }
 
+template <typename AddressT>
+void RibRouteUpdater::markForResolution(
+    NetworkToRouteMap<AddressT>* routes,
+    const std::vector<Prefix<AddressT>>& prefixes) {
+  for (const auto& prefix : prefixes) {
+    auto ritr = routes->exactMatch(prefix.network(), prefix.mask());
+    if (ritr != routes->end()) {
+      needsResolution_.insert(ritr->value().get());
+    }
+  }
+}
+
+template <typename AddressT>
+void RibRouteUpdater::resolve(
+    NetworkToRouteMap<AddressT>* routes,
+    const std::vector<Prefix<AddressT>>& prefixes) {
+  for (const auto& prefix : prefixes) {
+    auto ritr = routes->exactMatch(prefix.network(), prefix.mask());
+    if (ritr != routes->end() && needResolve(ritr->value())) {
+      resolveOne<AddressT>(ritr);
+    }
+  }
+}
+
+template <typename AddressT>
+void RibRouteUpdater::routeChanged(
+    const Prefix<AddressT>& prefix,
+    bool erased) {
+  if (!nhopDependencies_) {
+    return;
+  }
+  folly::CIDRNetwork network{
+      folly::IPAddress(prefix.network()), prefix.mask()};
+  if (erased) {
+    nhopDependencies_->erase(network);
+  }
+  changedPrefixes_.push_back(std::move(network));
+}
+
+template <typename AddressT>
+void RibRouteUpdater::updateNextHopDependencies(
+    const Prefix<AddressT>& prefix,
+    const RouteNextHopEntry& bestEntry) {
+  NextHopDependencyIndex::NextHops nhops;
+  if (bestEntry.getAction() == RouteForwardAction::NEXTHOPS) {
+    for (const auto& nh : bestEntry.getNextHopSet()) {
+      // Next hops with an interface resolve without a route lookup
+      if (!nh.intfID().has_value()) {
+        nhops.push_back(nh.addr());
+      }
+    }
+  }
+  nhopDependencies_->setNextHops(
+      {folly::IPAddress(prefix.network()), prefix.mask()}, std::move(nhops));
+}
+
 template <typename AddressT>
 bool RibRouteUpdater::needResolve(
     const std::shared_ptr<Route<AddressT>>& route) const {
   return needsResolution_.find(route.get()) != needsResolution_.end();
 }
 
-void RibRouteUpdater::updateDone() {
+void RibRouteUpdater::resolveAll() {
   // Record all routes as needing resolution
-  auto markForResolution = [this](const auto& routes) {
+  auto markAllForResolution = [this](const auto& routes) {
     std::for_each(routes->begin(), routes->end(), [this](auto& route) {
       needsResolution_.insert(value(route).get());
     });
   };
-  markForResolution(v4Routes_);
-  markForResolution(v6Routes_);
-  if (mplsRoutes_) {
-    markForResolution(mplsRoutes_);
+  markAllForResolution(v4Routes_);
+  markAllForResolution(v6Routes_);
+  if (nhopDependencies_) {
+    // Rebuilt as routes get resolved
+    nhopDependencies_->clear();
+  }
+  resolve(v4Routes_);
+  resolve(v6Routes_);
+  if (nhopDependencies_) {
+    nhopDependencies_->setValid();
+  }
+}
+
+void RibRouteUpdater::resolveChanged() {
+  // Routes that need resolution are the changed routes and, transitively,
+  // all routes with a next hop covered by a route needing resolution. A
+  // deleted route has no route to resolve, but its dependents still need to
+  // move over to the next longest match.
+  std::set<folly::CIDRNetwork> toResolve;
+  auto pending = std::move(changedPrefixes_);
+  while (!pending.empty()) {
+    auto prefix = std::move(pending.back());
+    pending.pop_back();
+    if (!toResolve.insert(prefix).second) {
+      continue;
+    }
+    nhopDependencies_->forEachDependent(
+        prefix, [&toResolve, &pending](const auto& dependent) {
+          if (toResolve.find(dependent) == toResolve.end()) {
+            pending.push_back(dependent);
+          }
+        });
+  }
+  std::vector<Prefix<IPAddressV4>> v4Prefixes;
+  std::vector<Prefix<IPAddressV6>> v6Prefixes;
+  for (const auto& [network, mask] : toResolve) {
+    if (network.isV4()) {
+      v4Prefixes.push_back({network.asV4(), mask});
+    } else {
+      v6Prefixes.push_back({network.asV6(), mask});
+    }
   }
+  XLOG(DBG3) << "Resolving " << toResolve.size() << " of "
+             << v4Routes_->size() + v6Routes_->size() << " routes";
+  // Mark all before resolving any, so that resolveOne recursively resolves
+  // the routes a route resolves over first
+  markForResolution(v4Routes_, v4Prefixes);
+  markForResolution(v6Routes_, v6Prefixes);
+  resolve(v4Routes_, v4Prefixes);
+  resolve(v6Routes_, v6Prefixes);
+}
+
+void RibRouteUpdater::updateDone() {
   SCOPE_EXIT {
     needsResolution_.clear();
     unresolvedToResolvedNhops_.clear();
+    changedPrefixes_.clear();
   };
-  resolve(v4Routes_);
-  resolve(v6Routes_);
+  SCOPE_FAIL {
+    if (nhopDependencies_) {
+      // Resolution was cut short, index may be partially updated
+      nhopDependencies_->invalidate();
+    }
+  };
+  if (nhopDependencies_ && nhopDependencies_->isValid()) {
+    resolveChanged();
+  } else {
+    resolveAll();
+  }
+  // MPLS routes resolve over IP routes, so IP routes are all resolved by now
   if (mplsRoutes_) {
+    std::for_each(
+        mplsRoutes_->begin(), mplsRoutes_->end(), [this](auto& route) {
+          needsResolution_.insert(value(route).get());
+        });
     resolve(mplsRoutes_);
   }
 }
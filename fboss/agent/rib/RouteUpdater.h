@@ -13,6 +13,7 @@
 #include "fboss/agent/types.h"
 
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
 
 #include <folly/IPAddress.h>
 
@@ -41,6 +42,12 @@ namespace facebook::fboss {
  *    only IP nexthops will be in the final ECMP group.
  * 5. If and only if TO_CPU is the only nexthop (directly or indirectly) of
  *    a route, TO_CPU action will be only path in the resolved ECMP group.
+ *
+ * Without a NextHopDependencyIndex every update re-resolves all routes.
+ * With one, the first update resolves all routes and builds the index,
+ * later updates only re-resolve the IP routes that were changed and the
+ * routes that (transitively) resolve over them. MPLS routes are always
+ * fully re-resolved.
  */
 class RibRouteUpdater {
  public:
@@ -51,7 +58,8 @@ class RibRouteUpdater {
   RibRouteUpdater(
       IPv4NetworkToRouteMap* v4Routes,
       IPv6NetworkToRouteMap* v6Routes,
-      LabelToRouteMap* mplsRoutes);
+      LabelToRouteMap* mplsRoutes,
+      NextHopDependencyIndex* nhopDependencies = nullptr);
 
   struct RouteEntry {
     folly::CIDRNetwork prefix;
@@ -146,6 +154,24 @@ class RibRouteUpdater {
   template <typename AddressT>
   void resolve(NetworkToRouteMap<AddressT>* routes);
 
+  template <typename AddressT>
+  void markForResolution(
+      NetworkToRouteMap<AddressT>* routes,
+      const std::vector<Prefix<AddressT>>& prefixes);
+  template <typename AddressT>
+  void resolve(
+      NetworkToRouteMap<AddressT>* routes,
+      const std::vector<Prefix<AddressT>>& prefixes);
+  void resolveAll();
+  void resolveChanged();
+
+  template <typename AddressT>
+  void routeChanged(const Prefix<AddressT>& prefix, bool erased);
+  template <typename AddressT>
+  void updateNextHopDependencies(
+      const Prefix<AddressT>& prefix,
+      const RouteNextHopEntry& bestEntry);
+
   template <typename AddressT>
   std::shared_ptr<Route<AddressT>> resolveOne(
       typename NetworkToRouteMap<AddressT>::Iterator ritr);
@@ -177,6 +203,9 @@ class RibRouteUpdater {
   IPv6NetworkToRouteMap* v6Routes_{nullptr};
   LabelToRouteMap* mplsRoutes_{nullptr};
   std::unordered_set<void*> needsResolution_;
+  NextHopDependencyIndex* nhopDependencies_{nullptr};
+  // IP routes added, modified or deleted in this update
+  std::vector<folly::CIDRNetwork> changedPrefixes_;
   /*
    * Cache for next hop to FWD informatio. For our use case
    * its pretty common for the same next hops to repeat, so
@@ -30,9 +30,19 @@
 #include <type_traits>
 #include <utility>
 
+#include <folly/Conv.h>
 #include <folly/ScopeGuard.h>
+#include <folly/futures/Future.h>
 #include <folly/logging/xlog.h>
 
+DEFINE_int32(
+    rib_vrf_update_threads,
+    0,
+    "Number of threads to process RIB updates on. When > 0, route updates, "
+    "resolution and FIB computation for different VRFs run in parallel, "
+    "with each VRF pinned to one of these threads. 0 processes all VRFs "
+    "serially on a single RIB update thread");
+
 namespace facebook::fboss {
 
 namespace {
@@ -159,15 +169,28 @@ void reconstructRibFromFib(
 }
 } // namespace
 
+void RibRouteTables::runVrfTasksSerially(
+    const std::vector<RouterID>& vrfs,
+    const std::function<void(RouterID)>& fn) {
+  for (auto vrf : vrfs) {
+    fn(vrf);
+  }
+}
+
+std::shared_ptr<RibRouteTables::SynchronizedRouteTable>
+RibRouteTables::getRouteTableIf(RouterID vrf) const {
+  auto lockedRouteTables = synchronizedRouteTables_.rlock();
+  auto it = lockedRouteTables->find(vrf);
+  return it == lockedRouteTables->end() ? nullptr : it->second;
+}
+
 template <typename RibUpdateFn>
 void RibRouteTables::updateRib(RouterID vrf, const RibUpdateFn& updateRibFn) {
-  auto lockedRouteTables = synchronizedRouteTables_.wlock();
-  auto it = lockedRouteTables->find(vrf);
-  if (it == lockedRouteTables->end()) {
+  auto routeTable = getRouteTableIf(vrf);
+  if (!routeTable) {
     throw FbossError("VRF ", vrf, " not configured");
   }
-  auto& routeTable = it->second;
-  updateRibFn(routeTable);
+  updateRibFn(*routeTable->wlock());
 }
 
 void RibRouteTables::reconfigure(
@@ -182,7 +205,8 @@ void RibRouteTables::reconfigure(
     const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToNull,
     const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToCpu,
     FibUpdateFunction updateFibCallback,
-    void* cookie) {
+    void* cookie,
+    const VrfTaskRunner& runVrfTasks) {
   // Config application is accomplished in the following sequence of steps:
   // 1. Update the VRFs held in RoutingInformationBase's
   // SynchronizedRouteTables data-structure
@@ -234,37 +258,46 @@ void RibRouteTables::reconfigure(
           folly::range(
               staticMplsRoutesToNull.cbegin(), staticMplsRoutesToNull.cend()),
           folly::range(
-              staticMplsRoutesToCpu.cbegin(), staticMplsRoutesToCpu.cend()));
+              staticMplsRoutesToCpu.cbegin(), staticMplsRoutesToCpu.cend()),
+          &(routeTable.nhopDependencies));
       // Apply config
       configApplier.apply();
     });
-    updateFib(resolver, vrf, updateFibCallback, cookie);
   };
-  // Because of this sequential loop over each VRF, config application scales
-  // linearly with the number of VRFs. If FBOSS is run in a multi-VRF routing
-  // architecture in the future, this slow-down can be avoided by
-  // parallelizing this loop. Converting this loop to use task-level
-  // parallelism should be straightfoward because it has been written to avoid
-  // dependencies across different iterations of the loop.
+  // FIB callbacks for all VRFs share cookie, so they are run one at a time
+  // on the calling thread, in VRF order, once the RIBs have been updated.
+  auto updateFibs = [&](const std::vector<RouterID>& vrfs) {
+    for (auto vrf : vrfs) {
+      updateFib(resolver, vrf, updateFibCallback, cookie);
+    }
+  };
+  // RIB updates and resolution have no dependencies across VRFs, so
+  // runVrfTasks is free to configure VRFs in parallel.
+  // First handle the VRFs for which no interface routes exist
+  std::vector<RouterID> vrfsNotInConfig;
   for (const auto& vrf : existingVrfs) {
-    // First handle the VRFs for which no interface routes exist
-    if (configRouterIDToInterfaceRoutes.find(vrf) !=
+    if (configRouterIDToInterfaceRoutes.find(vrf) ==
         configRouterIDToInterfaceRoutes.end()) {
-      continue;
+      vrfsNotInConfig.push_back(vrf);
     }
+  }
+  runVrfTasks(vrfsNotInConfig, [&](RouterID vrf) {
     configureRoutesForVrf(
         vrf, {} /* No interface routes*/
     );
-  }
+  });
+  updateFibs(vrfsNotInConfig);
   {
     auto lockedRouteTables = synchronizedRouteTables_.wlock();
     *lockedRouteTables = constructRouteTables(
         lockedRouteTables, configRouterIDToInterfaceRoutes);
   }
-  for (auto& vrf : getVrfList()) {
+  auto configVrfs = getVrfList();
+  runVrfTasks(configVrfs, [&](RouterID vrf) {
     const auto& interfaceRoutes = configRouterIDToInterfaceRoutes.at(vrf);
     configureRoutesForVrf(vrf, interfaceRoutes);
-  }
+  });
+  updateFibs(configVrfs);
 }
 
 void RibRouteTables::updateRemoteInterfaceRoutes(
@@ -305,7 +338,8 @@ void RibRouteTables::updateRemoteInterfaceRoutes(
         RibRouteUpdater updater(
             &(routeTable.v4NetworkToRoute),
             &(routeTable.v6NetworkToRoute),
-            &(routeTable.labelToRoute));
+            &(routeTable.labelToRoute),
+            &(routeTable.nhopDependencies));
         updater.update(
             {{ClientID::REMOTE_INTERFACE_ROUTE, toAddRoutes}},
             {{ClientID::REMOTE_INTERFACE_ROUTE, toDelRoutes}},
@@ -318,24 +352,19 @@ void RibRouteTables::updateRemoteInterfaceRoutes(
 
 template <typename RouteType, typename RouteIdType>
 void RibRouteTables::update(
-    const SwitchIdScopeResolver* resolver,
     RouterID routerID,
     ClientID clientID,
-    AdminDistance adminDistanceFromClientID,
     const std::vector<RouteType>& toAddRoutes,
     const std::vector<RouteIdType>& toDelPrefixes,
-    bool resetClientsRoutes,
-    folly::StringPiece updateType,
-    const FibUpdateFunction& fibUpdateCallback,
-    void* cookie) {
+    bool resetClientsRoutes) {
   updateRib(routerID, [&](auto& routeTable) {
     RibRouteUpdater updater(
         &(routeTable.v4NetworkToRoute),
         &(routeTable.v6NetworkToRoute),
-        &(routeTable.labelToRoute));
+        &(routeTable.labelToRoute),
+        &(routeTable.nhopDependencies));
     updater.update(clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
   });
-  updateFib(resolver, routerID, fibUpdateCallback, cookie);
 }
 
 void RibRouteTables::updateFib(
@@ -343,15 +372,18 @@ void RibRouteTables::updateFib(
     RouterID vrf,
     const FibUpdateFunction& fibUpdateCallback,
     void* cookie) {
+  auto synchronizedRouteTable = getRouteTableIf(vrf);
+  if (!synchronizedRouteTable) {
+    throw FbossError("VRF ", vrf, " not configured");
+  }
   try {
-    auto lockedRouteTables = synchronizedRouteTables_.rlock();
-    auto& routeTable = lockedRouteTables->find(vrf)->second;
+    auto routeTable = synchronizedRouteTable->rlock();
     fibUpdateCallback(
         resolver,
         vrf,
-        routeTable.v4NetworkToRoute,
-        routeTable.v6NetworkToRoute,
-        routeTable.labelToRoute,
+        routeTable->v4NetworkToRoute,
+        routeTable->v6NetworkToRoute,
+        routeTable->labelToRoute,
         cookie);
   } catch (const FbossHwUpdateError& hwUpdateError) {
     {
@@ -359,8 +391,10 @@ void RibRouteTables::updateFib(
         XLOG(FATAL) << " RIB Rollback failed, aborting program";
       };
       auto fib = hwUpdateError.appliedState->getFibs()->getNode(vrf);
-      auto lockedRouteTables = synchronizedRouteTables_.wlock();
-      auto& routeTable = lockedRouteTables->find(vrf)->second;
+      auto lockedRouteTable = synchronizedRouteTable->wlock();
+      auto& routeTable = *lockedRouteTable;
+      // Routes are replaced wholesale from the FIB below
+      routeTable.nhopDependencies.invalidate();
       reconstructRibFromFib<
           folly::IPAddressV4,
           ForwardingInformationBase<folly::IPAddressV4>>(
@@ -383,13 +417,15 @@ void RibRouteTables::updateFib(
 void RibRouteTables::ensureVrf(RouterID rid) {
   auto lockedRouteTables = synchronizedRouteTables_.wlock();
   if (lockedRouteTables->find(rid) == lockedRouteTables->end()) {
-    lockedRouteTables->insert(std::make_pair(rid, RouteTable()));
+    lockedRouteTables->insert(
+        std::make_pair(rid, std::make_shared<SynchronizedRouteTable>()));
   }
 }
 
 std::vector<RouterID> RibRouteTables::getVrfList() const {
   auto lockedRouteTables = synchronizedRouteTables_.rlock();
-  std::vector<RouterID> res(lockedRouteTables->size());
+  std::vector<RouterID> res;
+  res.reserve(lockedRouteTables->size());
   for (const auto& entry : *lockedRouteTables) {
     res.push_back(entry.first);
   }
@@ -397,12 +433,9 @@ std::vector<RouterID> RibRouteTables::getVrfList() const {
 }
 
 void RibRouteTables::setClassID(
-    const SwitchIdScopeResolver* resolver,
     RouterID rid,
     const std::vector<folly::CIDRNetwork>& prefixes,
-    FibUpdateFunction fibUpdateCallback,
-    std::optional<cfg::AclLookupClass> classId,
-    void* cookie) {
+    std::optional<cfg::AclLookupClass> classId) {
   updateRib(rid, [&](auto& routeTable) {
     // Update rib
     auto updateRoute = [&classId](auto& rib, auto ip, uint8_t mask) {
@@ -424,7 +457,6 @@ void RibRouteTables::setClassID(
       }
     }
   });
-  updateFib(resolver, rid, fibUpdateCallback, cookie);
 }
 
 template <typename AddressT>
@@ -432,10 +464,8 @@ std::shared_ptr<Route<AddressT>> RibRouteTables::longestMatch(
     const AddressT& address,
     RouterID vrf) const {
   StopWatch lookupTimer(std::nullopt, false);
-  auto ribTables = synchronizedRouteTables_.rlock();
-  auto vrfIt = ribTables->find(vrf);
-  auto rt =
-      vrfIt == ribTables->end() ? nullptr : vrfIt->second.longestMatch(address);
+  auto routeTable = getRouteTableIf(vrf);
+  auto rt = routeTable ? routeTable->rlock()->longestMatch(address) : nullptr;
   if (lookupTimer.msecsElapsed().count() > 1000) {
     XLOG(WARNING) << " Lookup for : " << address
                   << " took: " << lookupTimer.msecsElapsed().count() << " ms ";
@@ -455,7 +485,9 @@ RibRouteTables::RouterIDToRouteTable RibRouteTables::constructRouteTables(
     const RouterID configVrf = routerIDAndInterfaceRoutes.first;
 
     newRouteTablesIter = newRouteTables.emplace_hint(
-        newRouteTables.cend(), configVrf, RouteTable());
+        newRouteTables.cend(),
+        configVrf,
+        std::make_shared<SynchronizedRouteTable>());
 
     auto oldRouteTablesIter = lockedRouteTables->find(configVrf);
     if (oldRouteTablesIter == lockedRouteTables->end()) {
@@ -464,9 +496,9 @@ RibRouteTables::RouterIDToRouteTable RibRouteTables::constructRouteTables(
       continue;
     }
 
-    // configVrf exists in the RIB, so it will be shallow copied into
-    // newRouteTables.
-    newRouteTablesIter->second = std::move(oldRouteTablesIter->second);
+    // configVrf exists in the RIB, so its RouteTable (and lock) will be
+    // carried over into newRouteTables.
+    newRouteTablesIter->second = oldRouteTablesIter->second;
   }
 
   return newRouteTables;
@@ -477,6 +509,15 @@ RoutingInformationBase::RoutingInformationBase() {
     initThread("ribUpdateThread");
     ribUpdateEventBase_.loopForever();
   });
+  for (auto i = 0; i < FLAGS_rib_vrf_update_threads; ++i) {
+    auto vrfUpdateThread = std::make_unique<VrfUpdateThread>();
+    auto eventBase = &vrfUpdateThread->eventBase;
+    vrfUpdateThread->thread = std::make_unique<std::thread>([eventBase, i] {
+      initThread(folly::to<std::string>("ribVrfUpdate", i));
+      eventBase->loopForever();
+    });
+    vrfUpdateThreads_.push_back(std::move(vrfUpdateThread));
+  }
 }
 
 RoutingInformationBase::~RoutingInformationBase() {
@@ -490,6 +531,87 @@ void RoutingInformationBase::stop() {
     ribUpdateThread_->join();
     ribUpdateThread_.reset();
   }
+  for (auto& vrfUpdateThread : vrfUpdateThreads_) {
+    if (vrfUpdateThread->thread) {
+      auto eventBase = &vrfUpdateThread->eventBase;
+      eventBase->runInFbossEventBaseThread(
+          [eventBase] { eventBase->terminateLoopSoon(); });
+      vrfUpdateThread->thread->join();
+      vrfUpdateThread->thread.reset();
+    }
+  }
+}
+
+FbossEventBase& RoutingInformationBase::getVrfUpdateEventBase(RouterID vrf) {
+  if (vrfUpdateThreads_.empty()) {
+    return ribUpdateEventBase_;
+  }
+  return vrfUpdateThreads_[static_cast<uint32_t>(vrf) %
+                           vrfUpdateThreads_.size()]
+      ->eventBase;
+}
+
+void RoutingInformationBase::runVrfTasks(
+    const std::vector<RouterID>& vrfs,
+    const std::function<void(RouterID)>& fn) {
+  if (!parallelVrfUpdatesEnabled()) {
+    RibRouteTables::runVrfTasksSerially(vrfs, fn);
+    return;
+  }
+  std::vector<folly::Future<folly::Unit>> vrfTasks;
+  vrfTasks.reserve(vrfs.size());
+  for (auto vrf : vrfs) {
+    vrfTasks.push_back(
+        folly::via(&getVrfUpdateEventBase(vrf), [&fn, vrf] { fn(vrf); }));
+  }
+  // Wait for all VRFs to finish before surfacing the first failure, so
+  // that no task is left running against state owned by the caller
+  for (auto& result : folly::collectAll(std::move(vrfTasks)).get()) {
+    result.throwUnlessValue();
+  }
+}
+
+void RoutingInformationBase::runVrfUpdate(
+    RouterID vrf,
+    std::function<void()> ribUpdateFn,
+    std::function<void()> fibUpdateFn,
+    bool async) {
+  if (!parallelVrfUpdatesEnabled()) {
+    auto updateFn = [ribUpdateFn = std::move(ribUpdateFn),
+                     fibUpdateFn = std::move(fibUpdateFn)] {
+      ribUpdateFn();
+      fibUpdateFn();
+    };
+    if (async) {
+      ribUpdateEventBase_.runInFbossEventBaseThread(std::move(updateFn));
+    } else {
+      ribUpdateEventBase_.runInFbossEventBaseThreadAndWait(updateFn);
+    }
+    return;
+  }
+  // The RIB thread may itself be waiting on VRF update threads (see
+  // reconfigure), so VRF update threads only ever queue work on the RIB
+  // thread and never wait for it
+  auto& vrfEventBase = getVrfUpdateEventBase(vrf);
+  if (async) {
+    vrfEventBase.runInFbossEventBaseThread(
+        [this,
+         ribUpdateFn = std::move(ribUpdateFn),
+         fibUpdateFn = std::move(fibUpdateFn)]() mutable {
+          ribUpdateFn();
+          ribUpdateEventBase_.runInFbossEventBaseThread(std::move(fibUpdateFn));
+        });
+  } else {
+    vrfEventBase.runInFbossEventBaseThreadAndWait(ribUpdateFn);
+    ribUpdateEventBase_.runInFbossEventBaseThreadAndWait(fibUpdateFn);
+  }
+}
+
+void RoutingInformationBase::waitForVrfUpdates() {
+  for (auto& vrfUpdateThread : vrfUpdateThreads_) {
+    vrfUpdateThread->eventBase.runInFbossEventBaseThreadAndWait(
+        [] { return; });
+  }
 }
 
 void RoutingInformationBase::ensureRunning() const {
@@ -525,7 +647,8 @@ void RoutingInformationBase::reconfigure(
         staticMplsRoutesToNull,
         staticMplsRoutesToCpu,
         updateFibCallback,
-        cookie);
+        cookie,
+        [this](const auto& vrfs, const auto& fn) { runVrfTasks(vrfs, fn); });
   };
   ribUpdateEventBase_.runInFbossEventBaseThreadAndWait(updateFn);
 }
@@ -560,7 +683,7 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::updateImpl(
   std::shared_ptr<SwitchState> appliedState;
   Timer updateTimer(&duration);
   std::exception_ptr updateException;
-  auto updateFn = [&]() {
+  auto ribUpdateFn = [&]() {
     std::vector<typename TraitsType::RibRoute> toAddRoutes;
     toAddRoutes.reserve(toAdd.size());
 
@@ -582,21 +705,22 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::updateImpl(
           });
 
       ribTables_.update(
-          resolver,
-          routerID,
-          clientID,
-          adminDistanceFromClientID,
-          toAddRoutes,
-          toDelPrefixes,
-          resetClientsRoutes,
-          updateType,
-          fibUpdateCallback,
-          cookie);
+          routerID, clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
     } catch (const std::exception&) {
       updateException = std::current_exception();
     }
   };
-  ribUpdateEventBase_.runInFbossEventBaseThreadAndWait(updateFn);
+  auto fibUpdateFn = [&]() {
+    if (updateException) {
+      return;
+    }
+    try {
+      ribTables_.updateFib(resolver, routerID, fibUpdateCallback, cookie);
+    } catch (const std::exception&) {
+      updateException = std::current_exception();
+    }
+  };
+  runVrfUpdate(routerID, ribUpdateFn, fibUpdateFn, false /* async */);
   if (updateException) {
     std::rethrow_exception(updateException);
   }
@@ -613,15 +737,13 @@ void RoutingInformationBase::setClassIDImpl(
     void* cookie,
     bool async) {
   ensureRunning();
-  auto updateFn = [=, this]() {
-    ribTables_.setClassID(
-        resolver, rid, prefixes, fibUpdateCallback, classId, cookie);
+  auto ribUpdateFn = [=, this]() {
+    ribTables_.setClassID(rid, prefixes, classId);
   };
-  if (async) {
-    ribUpdateEventBase_.runInFbossEventBaseThread(updateFn);
-  } else {
-    ribUpdateEventBase_.runInFbossEventBaseThreadAndWait(updateFn);
-  }
+  auto fibUpdateFn = [=, this]() {
+    ribTables_.updateFib(resolver, rid, fibUpdateCallback, cookie);
+  };
+  runVrfUpdate(rid, ribUpdateFn, fibUpdateFn, async);
 }
 
 RibRouteTables RibRouteTables::fromThrift(
@@ -632,9 +754,11 @@ RibRouteTables RibRouteTables::fromThrift(
   auto lockedRouteTables = rib.synchronizedRouteTables_.wlock();
 
   for (const auto& [rid, table] : ribThrift) {
-    RouteTable rtable = RouteTable::fromThrift(table);
     auto vrf = RouterID(rid);
-    lockedRouteTables->emplace(vrf, std::move(rtable));
+    lockedRouteTables->emplace(
+        vrf,
+        std::make_shared<SynchronizedRouteTable>(
+            RouteTable::fromThrift(table)));
   }
 
   if (fibs) {
@@ -654,11 +778,10 @@ std::unique_ptr<RoutingInformationBase> RoutingInformationBase::fromThrift(
 
 std::vector<MplsRouteDetails> RibRouteTables::getMplsRouteTableDetails() const {
   std::vector<MplsRouteDetails> mplsRouteDetails;
-  synchronizedRouteTables_.withRLock([&](const auto& synchronizedRouteTables) {
-    const auto it = synchronizedRouteTables.find(RouterID(0));
-    if (it != synchronizedRouteTables.end()) {
-      for (auto rit = it->second.labelToRoute.begin();
-           rit != it->second.labelToRoute.end();
+  if (auto synchronizedRouteTable = getRouteTableIf(RouterID(0))) {
+    synchronizedRouteTable->withRLock([&](const auto& routeTable) {
+      for (auto rit = routeTable.labelToRoute.begin();
+           rit != routeTable.labelToRoute.end();
            ++rit) {
         MplsRouteDetails mplsRouteDetail;
         auto routeDetails = rit->second->toRouteDetails();
@@ -670,29 +793,28 @@ std::vector<MplsRouteDetails> RibRouteTables::getMplsRouteTableDetails() const {
         }
         mplsRouteDetails.emplace_back(mplsRouteDetail);
       }
-    }
-  });
+    });
+  }
   return mplsRouteDetails;
 }
 
 std::vector<RouteDetails> RibRouteTables::getRouteTableDetails(
     RouterID rid) const {
   std::vector<RouteDetails> routeDetails;
-  synchronizedRouteTables_.withRLock([&](const auto& synchronizedRouteTables) {
-    const auto it = synchronizedRouteTables.find(rid);
-    if (it != synchronizedRouteTables.end()) {
-      for (auto rit = it->second.v4NetworkToRoute.begin();
-           rit != it->second.v4NetworkToRoute.end();
+  if (auto synchronizedRouteTable = getRouteTableIf(rid)) {
+    synchronizedRouteTable->withRLock([&](const auto& routeTable) {
+      for (auto rit = routeTable.v4NetworkToRoute.begin();
+           rit != routeTable.v4NetworkToRoute.end();
            ++rit) {
         routeDetails.emplace_back(rit->value()->toRouteDetails());
       }
-      for (auto rit = it->second.v6NetworkToRoute.begin();
-           rit != it->second.v6NetworkToRoute.end();
+      for (auto rit = routeTable.v6NetworkToRoute.begin();
+           rit != routeTable.v6NetworkToRoute.end();
            ++rit) {
         routeDetails.emplace_back(rit->value()->toRouteDetails());
       }
-    }
-  });
+    });
+  }
   return routeDetails;
 }
 
@@ -747,6 +869,7 @@ RoutingInformationBase::UpdateStatistics RoutingInformationBase::update(
 void RoutingInformationBase::updateStateInRibThread(
     const std::function<void()>& fn) {
   ensureRunning();
+  waitForVrfUpdates();
   ribUpdateEventBase_.runInEventBaseThreadAndWait([fn] { fn(); });
 }
 
@@ -781,7 +904,7 @@ std::map<int32_t, state::RouteTableFields> RibRouteTables::toThrift() const {
   std::map<int32_t, state::RouteTableFields> obj{};
   auto routeTables = synchronizedRouteTables_.rlock();
   for (const auto& [rid, routeTable] : *routeTables) {
-    obj.emplace(rid, routeTable.toThrift());
+    obj.emplace(rid, routeTable->rlock()->toThrift());
   }
   return obj;
 }
@@ -791,7 +914,7 @@ std::map<int32_t, state::RouteTableFields> RibRouteTables::warmBootState()
   std::map<int32_t, state::RouteTableFields> obj{};
   const auto& routeTables = *synchronizedRouteTables_.rlock();
   for (const auto& [rid, routeTable] : routeTables) {
-    obj.emplace(rid, routeTable.warmBootState());
+    obj.emplace(rid, routeTable->rlock()->warmBootState());
   }
   return obj;
 }
@@ -804,7 +927,8 @@ RibRouteTables RibRouteTables::fromThrift(
     // @lint-ignore CLANGTIDY
     routeTables->emplace(
         RouterID(rid),
-        RibRouteTables::RouteTable::fromThrift(routeTableFields));
+        std::make_shared<SynchronizedRouteTable>(
+            RibRouteTables::RouteTable::fromThrift(routeTableFields)));
   }
   return ribRouteTables;
 }
@@ -846,10 +970,15 @@ void RibRouteTables::importFibs(
   for (const auto& [_, fibs] : std::as_const(*multiSwitchfibs)) {
     for (const auto& iter : std::as_const(*fibs)) {
       const auto& fib = iter.second;
-      auto& routeTables = (*lockedRouteTables)[fib->getID()];
-      importRoutes(fib->getFibV6(), &routeTables.v6NetworkToRoute);
-      importRoutes(fib->getFibV4(), &routeTables.v4NetworkToRoute);
-      auto mplsTable = &routeTables.labelToRoute;
+      auto& synchronizedRouteTable = (*lockedRouteTables)[fib->getID()];
+      if (!synchronizedRouteTable) {
+        synchronizedRouteTable = std::make_shared<SynchronizedRouteTable>();
+      }
+      auto routeTables = synchronizedRouteTable->wlock();
+      routeTables->nhopDependencies.invalidate();
+      importRoutes(fib->getFibV6(), &routeTables->v6NetworkToRoute);
+      importRoutes(fib->getFibV4(), &routeTables->v4NetworkToRoute);
+      auto mplsTable = &routeTables->labelToRoute;
       if (FLAGS_mpls_rib && labelFibs) {
         for (const auto& [_, labelFib] : std::as_const(*labelFibs)) {
           for (const auto& entry : std::as_const(*labelFib)) {
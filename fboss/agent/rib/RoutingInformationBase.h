@@ -25,6 +25,7 @@
 #include <vector>
 
 DECLARE_bool(mpls_rib);
+DECLARE_int32(rib_vrf_update_threads);
 
 namespace facebook::fboss {
 class SwitchState;
@@ -47,25 +48,43 @@ using FibUpdateFunction = std::function<std::shared_ptr<SwitchState>(
  */
 class RibRouteTables {
  public:
+  /*
+   * Run fn for every VRF in vrfs and return once all of them have completed.
+   * Callers may run these concurrently, since work for a VRF only ever
+   * touches that VRF's RouteTable. Used to fan out per VRF RIB work such as
+   * config application and resolution. FIB callbacks share their cookie
+   * across VRFs and so are never run from these tasks.
+   */
+  using VrfTaskRunner = std::function<void(
+      const std::vector<RouterID>& vrfs,
+      const std::function<void(RouterID)>& fn)>;
+  static void runVrfTasksSerially(
+      const std::vector<RouterID>& vrfs,
+      const std::function<void(RouterID)>& fn);
+
+  /*
+   * update() and setClassID() only update and resolve the VRF's RIB. Callers
+   * are responsible for following them up with updateFib(), which lets the
+   * FIB callbacks for different VRFs be serialized even when RIB updates to
+   * those VRFs are not.
+   */
   template <typename RouteType, typename RouteIdType>
   void update(
-      const SwitchIdScopeResolver* resolver,
       RouterID routerID,
       ClientID clientID,
-      AdminDistance adminDistanceFromClientID,
       const std::vector<RouteType>& toAddRoutes,
       const std::vector<RouteIdType>& toDelPrefixes,
-      bool resetClientsRoutes,
-      folly::StringPiece updateType,
-      const FibUpdateFunction& fibUpdateCallback,
-      void* cookie);
+      bool resetClientsRoutes);
 
   void setClassID(
-      const SwitchIdScopeResolver* resolver,
       RouterID rid,
       const std::vector<folly::CIDRNetwork>& prefixes,
-      FibUpdateFunction fibUpdateCallback,
-      std::optional<cfg::AclLookupClass> classId,
+      std::optional<cfg::AclLookupClass> classId);
+
+  void updateFib(
+      const SwitchIdScopeResolver* resolver,
+      RouterID vrf,
+      const FibUpdateFunction& fibUpdateCallback,
       void* cookie);
   /*
    * VrfAndNetworkToInterfaceRoute is conceptually a mapping from the pair
@@ -94,7 +113,8 @@ class RibRouteTables {
       const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToNull,
       const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToCpu,
       FibUpdateFunction fibUpdateCallback,
-      void* cookie);
+      void* cookie,
+      const VrfTaskRunner& runVrfTasks = runVrfTasksSerially);
 
   void updateRemoteInterfaceRoutes(
       const SwitchIdScopeResolver* resolver,
@@ -136,6 +156,9 @@ class RibRouteTables {
     IPv4NetworkToRouteMap v4NetworkToRoute;
     IPv6NetworkToRouteMap v6NetworkToRoute;
     LabelToRouteMap labelToRoute;
+    // Routes resolving over each next hop, lets RibRouteUpdater only
+    // re-resolve routes affected by an update
+    NextHopDependencyIndex nhopDependencies;
 
     bool operator==(const RouteTable& other) const {
       return v4NetworkToRoute == other.v4NetworkToRoute &&
@@ -159,24 +182,23 @@ class RibRouteTables {
     state::RouteTableFields warmBootState() const;
   };
 
-  void updateFib(
-      const SwitchIdScopeResolver* resolver,
-      RouterID vrf,
-      const FibUpdateFunction& fibUpdateCallback,
-      void* cookie);
   template <typename RibUpdateFn>
   void updateRib(RouterID vrf, const RibUpdateFn& updateRib);
 
   /*
-   * Currently, route updates to separate VRFs are made to be sequential. In the
-   * event FBOSS has to operate in a routing architecture with numerous VRFs,
-   * we can avoid a slow down by a factor of number of VRFs by parallelizing
-   * route updates across VRFs. This can be accomplished simply by associating
-   * the mutex implicit in folly::Synchronized with an individual RouteTable.
+   * Each RouteTable is guarded by its own lock, so that updates (and the
+   * resolution and FIB computation that follow them) to separate VRFs do
+   * not serialize behind each other. The lock over RouterIDToRouteTable
+   * only guards the set of VRFs and is held just long enough to look up
+   * a VRF's RouteTable.
    */
-  using RouterIDToRouteTable = boost::container::flat_map<RouterID, RouteTable>;
+  using SynchronizedRouteTable = folly::Synchronized<RouteTable>;
+  using RouterIDToRouteTable = boost::container::
+      flat_map<RouterID, std::shared_ptr<SynchronizedRouteTable>>;
   using SynchronizedRouteTables = folly::Synchronized<RouterIDToRouteTable>;
 
+  std::shared_ptr<SynchronizedRouteTable> getRouteTableIf(RouterID vrf) const;
+
   void importFibs(
       const SynchronizedRouteTables::WLockedPtr& lockedRouteTables,
       const std::shared_ptr<MultiSwitchForwardingInformationBaseMap>& fibs,
@@ -208,11 +230,14 @@ class RoutingInformationBase {
   };
 
   /*
-   * `update()` first acquires exclusive ownership of the RIB and executes the
+   * `update()` first acquires exclusive ownership of the RIB (or, in parallel
+   * VRF update mode, of the VRF's route table) and executes the
    * following sequence of actions:
    * 1. Injects and removes routes in `toAdd` and `toDelete`, respectively.
    * 2. Triggers recursive (IP) resolution.
-   * 3. Updates the FIB synchronously.
+   * 3. Updates the FIB synchronously. In parallel VRF update mode steps 1
+   * and 2 run on the VRF's update thread while step 3 always runs on the RIB
+   * thread, so FIB callbacks are never run concurrently.
    * NOTE : there is no order guarantee b/w toAdd and toDelete. We may do
    * either first. This does not matter for non overlapping add/del, but
    * can be meaningful for overlaps. If so, the caller is responsible for
@@ -339,6 +364,9 @@ class RoutingInformationBase {
   }
   void waitForRibUpdates() {
     ensureRunning();
+    // VRF updates queue their FIB updates on the RIB thread, so drain them
+    // first
+    waitForVrfUpdates();
     ribUpdateEventBase_.runInFbossEventBaseThreadAndWait([] { return; });
   }
 
@@ -356,7 +384,40 @@ class RoutingInformationBase {
       const std::map<int32_t, state::RouteTableFields>&);
   std::map<int32_t, state::RouteTableFields> warmBootState() const;
 
+  /*
+   * Whether updates to different VRFs are processed concurrently. See
+   * FLAGS_rib_vrf_update_threads
+   */
+  bool parallelVrfUpdatesEnabled() const {
+    return !vrfUpdateThreads_.empty();
+  }
+
  private:
+  /*
+   * In parallel VRF update mode, VRFs are sharded across a fixed set of
+   * update threads. All updates to a given VRF are always processed on the
+   * same thread, so per VRF update ordering is identical to the single
+   * threaded mode.
+   */
+  struct VrfUpdateThread {
+    std::unique_ptr<std::thread> thread;
+    FbossEventBase eventBase;
+  };
+  FbossEventBase& getVrfUpdateEventBase(RouterID vrf);
+  /*
+   * Run ribUpdateFn for vrf followed by fibUpdateFn. ribUpdateFn runs on the
+   * VRF's update thread, fibUpdateFn always runs on the RIB thread.
+   */
+  void runVrfUpdate(
+      RouterID vrf,
+      std::function<void()> ribUpdateFn,
+      std::function<void()> fibUpdateFn,
+      bool async);
+  void waitForVrfUpdates();
+  void runVrfTasks(
+      const std::vector<RouterID>& vrfs,
+      const std::function<void(RouterID)>& fn);
+
   void ensureRunning() const;
   void setClassIDImpl(
       const SwitchIdScopeResolver* resolver,
@@ -382,6 +443,7 @@ class RoutingInformationBase {
 
   std::unique_ptr<std::thread> ribUpdateThread_;
   FbossEventBase ribUpdateEventBase_;
+  std::vector<std::unique_ptr<VrfUpdateThread>> vrfUpdateThreads_;
   RibRouteTables ribTables_;
 };
 
@@ -19,7 +19,10 @@
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/TestUtils.h"
 
+#include <folly/Conv.h>
+
 #include <memory>
+#include <string>
 #include <utility>
 
 using namespace facebook::fboss;
@@ -129,6 +132,27 @@ cfg::SwitchConfig dualVrfConfig() {
   return config;
 }
 
+cfg::SwitchConfig multiVrfConfig(int numVrfs) {
+  cfg::SwitchConfig config;
+  config.vlans()->resize(numVrfs);
+  config.interfaces()->resize(numVrfs);
+  for (auto i = 0; i < numVrfs; ++i) {
+    *config.vlans()[i].id() = i + 1;
+
+    *config.interfaces()[i].intfID() = i + 1;
+    *config.interfaces()[i].vlanID() = i + 1;
+    *config.interfaces()[i].routerID() = i;
+    config.interfaces()[i].mac() =
+        folly::to<std::string>("00:00:00:00:00:1", i);
+    config.interfaces()[i].ipAddresses()->resize(2);
+    config.interfaces()[i].ipAddresses()[0] =
+        folly::to<std::string>(i + 1, ".1.1.1/24");
+    config.interfaces()[i].ipAddresses()[1] =
+        folly::to<std::string>(i + 1, "::1/48");
+  }
+  return config;
+}
+
 template <typename AddressT>
 void checkFibRoute(
     const std::shared_ptr<facebook::fboss::Route<AddressT>>& route,
@@ -341,3 +365,59 @@ TEST(ConfigApplication, MultiVrfColdBoot) {
   fibContainer = fibMap->getNode(RouterID(1));
   EXPECT_NE(nullptr, fibContainer);
 }
+
+TEST(ConfigApplication, MultiVrfParallelUpdates) {
+  auto prevVrfUpdateThreads = FLAGS_rib_vrf_update_threads;
+  FLAGS_rib_vrf_update_threads = 4;
+  RoutingInformationBase rib;
+  FLAGS_rib_vrf_update_threads = prevVrfUpdateThreads;
+  ASSERT_TRUE(rib.parallelVrfUpdatesEnabled());
+
+  auto emptyState = std::make_shared<SwitchState>();
+  auto platform = createMockPlatform();
+  // More VRFs than update threads, so that some threads configure several.
+  // Limited to 10 by the MAC addresses multiVrfConfig() hands out
+  constexpr auto kNumVrfs = 8;
+  auto config = multiVrfConfig(kNumVrfs);
+
+  auto state = publishAndApplyConfig(emptyState, &config, platform.get(), &rib);
+  ASSERT_NE(nullptr, state);
+
+  // Every VRF's FIB update must be reflected in the resulting state
+  auto fibMap = state->getFibs();
+  EXPECT_EQ(fibMap->numNodes(), kNumVrfs);
+  for (auto i = 0; i < kNumVrfs; ++i) {
+    auto fibContainer = fibMap->getNode(RouterID(i));
+    ASSERT_NE(nullptr, fibContainer);
+
+    auto v4Fib = fibContainer->getFibV4();
+    EXPECT_EQ(v4Fib->size(), 1);
+    folly::IPAddressV4 v4Network(folly::to<std::string>(i + 1, ".1.1.0"));
+    auto v4Route = v4Fib->exactMatch(RoutePrefixV4{v4Network, 24});
+    ASSERT_NE(nullptr, v4Route);
+    checkFibRoute(
+        v4Route,
+        v4Network,
+        24,
+        folly::IPAddressV4(folly::to<std::string>(i + 1, ".1.1.1")),
+        InterfaceID(i + 1));
+
+    folly::IPAddressV6 v6Network(folly::to<std::string>(i + 1, "::"));
+    auto v6Route =
+        fibContainer->getFibV6()->exactMatch(RoutePrefixV6{v6Network, 48});
+    ASSERT_NE(nullptr, v6Route);
+    checkFibRoute(
+        v6Route,
+        v6Network,
+        48,
+        folly::IPAddressV6(folly::to<std::string>(i + 1, "::1")),
+        InterfaceID(i + 1));
+  }
+
+  uint64_t v4RouteCount = 0;
+  uint64_t v6RouteCount = 0;
+  std::tie(v4RouteCount, v6RouteCount) = fibMap->getRouteCount();
+  EXPECT_EQ(v4RouteCount, kNumVrfs);
+  // Each VRF also has the fe80::/64 link local route
+  EXPECT_EQ(v6RouteCount, 2 * kNumVrfs);
+}
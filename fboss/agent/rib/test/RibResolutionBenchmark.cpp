@@ -0,0 +1,123 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
+#include "fboss/agent/rib/RouteUpdater.h"
+
+DEFINE_int32(
+    num_bgp_routes,
+    500000,
+    "Number of BGP routes resolving over interface routes");
+
+using namespace facebook::fboss;
+using folly::IPAddress;
+using folly::IPAddressV4;
+
+namespace {
+constexpr auto kNumInterfaces = 64;
+constexpr auto kEcmpWidth = 4;
+const auto kBgpClient = ClientID::BGPD;
+
+struct RouteTables {
+  IPv4NetworkToRouteMap v4;
+  IPv6NetworkToRouteMap v6;
+  NextHopDependencyIndex nhopDependencies;
+};
+
+folly::CIDRNetwork interfaceNetwork(int intf) {
+  return {IPAddress(fmt::format("10.0.{}.0", intf)), 24};
+}
+
+RibRouteUpdater::RouteEntry interfaceRoute(int intf) {
+  ResolvedNextHop nhop(
+      IPAddress(fmt::format("10.0.{}.1", intf)),
+      InterfaceID(intf + 1),
+      UCMP_DEFAULT_WEIGHT);
+  return RibRouteUpdater::RouteEntry(
+      interfaceNetwork(intf),
+      RouteNextHopEntry(
+          static_cast<NextHop>(nhop), AdminDistance::DIRECTLY_CONNECTED));
+}
+
+/*
+ * kNumInterfaces interface routes and FLAGS_num_bgp_routes /24 BGP routes.
+ * BGP routes are spread over next hop groups of kEcmpWidth interfaces each,
+ * so flapping one interface affects 1/(kNumInterfaces / kEcmpWidth) of
+ * the BGP routes.
+ */
+void setupRoutes(RouteTables& tables, NextHopDependencyIndex* nhopDeps) {
+  std::vector<RibRouteUpdater::RouteEntry> interfaceRoutes;
+  for (auto intf = 0; intf < kNumInterfaces; ++intf) {
+    interfaceRoutes.push_back(interfaceRoute(intf));
+  }
+  std::vector<RouteNextHopEntry> nhopGroups;
+  for (auto group = 0; group < kNumInterfaces / kEcmpWidth; ++group) {
+    RouteNextHopSet nhops;
+    for (auto intf = group * kEcmpWidth; intf < (group + 1) * kEcmpWidth;
+         ++intf) {
+      nhops.emplace(UnresolvedNextHop(
+          IPAddress(fmt::format("10.0.{}.10", intf)), ECMP_WEIGHT));
+    }
+    nhopGroups.emplace_back(nhops, AdminDistance::EBGP);
+  }
+  std::vector<RibRouteUpdater::RouteEntry> bgpRoutes;
+  bgpRoutes.reserve(FLAGS_num_bgp_routes);
+  for (auto i = 0; i < FLAGS_num_bgp_routes; ++i) {
+    auto network =
+        IPAddressV4::fromLongHBO((64u << 24) + (static_cast<uint32_t>(i) << 8));
+    bgpRoutes.emplace_back(
+        folly::CIDRNetwork{network, 24}, nhopGroups[i % nhopGroups.size()]);
+  }
+  RibRouteUpdater updater(&tables.v4, &tables.v6, nullptr, nhopDeps);
+  updater.update<RibRouteUpdater::RouteEntry, folly::CIDRNetwork>(
+      ClientID::INTERFACE_ROUTE, interfaceRoutes, {}, false);
+  updater.update<RibRouteUpdater::RouteEntry, folly::CIDRNetwork>(
+      kBgpClient, bgpRoutes, {}, false);
+}
+
+/*
+ * Time taking an interface down and back up, with or without a next hop
+ * dependency index.
+ */
+void interfaceFlap(bool incremental) {
+  auto tables = std::make_unique<RouteTables>();
+  auto nhopDeps = incremental ? &tables->nhopDependencies : nullptr;
+  BENCHMARK_SUSPEND {
+    setupRoutes(*tables, nhopDeps);
+  }
+  RibRouteUpdater updater(&tables->v4, &tables->v6, nullptr, nhopDeps);
+  updater.update<RibRouteUpdater::RouteEntry, folly::CIDRNetwork>(
+      ClientID::INTERFACE_ROUTE, {}, {interfaceNetwork(0)}, false);
+  updater.update<RibRouteUpdater::RouteEntry, folly::CIDRNetwork>(
+      ClientID::INTERFACE_ROUTE, {interfaceRoute(0)}, {}, false);
+  BENCHMARK_SUSPEND {
+    tables.reset();
+  }
+}
+} // namespace
+
+BENCHMARK(RibFullResolutionInterfaceFlap) {
+  interfaceFlap(false);
+}
+
+BENCHMARK_RELATIVE(RibIncrementalResolutionInterfaceFlap) {
+  interfaceFlap(true);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
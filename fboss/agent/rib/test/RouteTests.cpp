@@ -11,6 +11,7 @@
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/NextHopDependencyIndex.h"
 #include "fboss/agent/state/RouteNextHop.h"
 
 #include "fboss/agent/rib/RouteUpdater.h"
@@ -166,4 +167,103 @@ TEST(Route, serializeRouteTable) {
       false);
 }
 
+
+/*
+ * Apply the same sequence of updates to a pair of route tables, one fully
+ * re-resolved on every update and one incrementally re-resolved via a
+ * NextHopDependencyIndex. Resolution results must always match.
+ */
+TEST(Route, incrementalResolutionMatchesFullResolution) {
+  IPv4NetworkToRouteMap v4Full, v4Incremental;
+  IPv6NetworkToRouteMap v6Full, v6Incremental;
+  NextHopDependencyIndex nhopDependencies;
+  using RouteEntry = RibRouteUpdater::RouteEntry;
+
+  auto update = [&](ClientID client,
+                    const std::vector<RouteEntry>& toAdd,
+                    const std::vector<folly::CIDRNetwork>& toDel) {
+    RibRouteUpdater fullUpdater(&v4Full, &v6Full);
+    fullUpdater.update<RouteEntry, folly::CIDRNetwork>(
+        client, toAdd, toDel, false);
+    RibRouteUpdater incrementalUpdater(
+        &v4Incremental, &v6Incremental, nullptr, &nhopDependencies);
+    incrementalUpdater.update<RouteEntry, folly::CIDRNetwork>(
+        client, toAdd, toDel, false);
+    EXPECT_TRUE(nhopDependencies.isValid());
+    EXPECT_ROUTES_MATCH(&v4Full, &v4Incremental);
+    EXPECT_ROUTES_MATCH(&v6Full, &v6Incremental);
+  };
+  auto interfaceRoute = [](const std::string& network,
+                           uint8_t mask,
+                           const std::string& address,
+                           int interfaceID) {
+    ResolvedNextHop nhop(
+        IPAddress(address), InterfaceID(interfaceID), UCMP_DEFAULT_WEIGHT);
+    return RouteEntry(
+        {IPAddress(network), mask},
+        RouteNextHopEntry(
+            static_cast<NextHop>(nhop), AdminDistance::DIRECTLY_CONNECTED));
+  };
+  auto route = [](const std::string& network,
+                  uint8_t mask,
+                  std::vector<std::string> nhops) {
+    return RouteEntry(
+        {IPAddress(network), mask},
+        RouteNextHopEntry(makeNextHops(std::move(nhops)), kDistance));
+  };
+  auto isResolved = [&](const std::string& network, uint8_t mask) {
+    auto ritr = v4Incremental.exactMatch(IPAddressV4(network), mask);
+    return ritr != v4Incremental.end() && ritr->value()->isResolved();
+  };
+
+  update(
+      ClientID::INTERFACE_ROUTE,
+      {interfaceRoute("1.1.1.0", 24, "1.1.1.1", 1),
+       interfaceRoute("2.2.2.0", 24, "2.2.2.1", 2),
+       interfaceRoute("1::", 64, "1::1", 1)},
+      {});
+  update(
+      kClientA,
+      {route("10.1.1.0", 24, {"1.1.1.10"}),
+       route("20.1.1.0", 24, {"2.2.2.10"}),
+       // Recursively resolves over 10.1.1.0/24
+       route("30.1.1.0", 24, {"10.1.1.5"}),
+       route("40.0.0.0", 8, {"1.1.1.10", "2.2.2.10"}),
+       route("1001::", 48, {"1::10"}),
+       // v4 route over v6 next hop
+       route("50.1.1.0", 24, {"1::20"})},
+      {});
+  EXPECT_TRUE(isResolved("30.1.1.0", 24));
+  EXPECT_TRUE(isResolved("50.1.1.0", 24));
+
+  // Interface flap, dependents (including recursive ones) lose resolution
+  update(ClientID::INTERFACE_ROUTE, {}, {{IPAddress("1.1.1.0"), 24}});
+  EXPECT_FALSE(isResolved("10.1.1.0", 24));
+  EXPECT_FALSE(isResolved("30.1.1.0", 24));
+  EXPECT_TRUE(isResolved("40.0.0.0", 8));
+  EXPECT_TRUE(isResolved("20.1.1.0", 24));
+
+  // A less specific route picks up next hops of the flapped interface
+  update(kClientB, {route("1.0.0.0", 8, {"2.2.2.20"})}, {});
+  EXPECT_TRUE(isResolved("30.1.1.0", 24));
+
+  // Interface comes back, more specific than 1.0.0.0/8
+  update(
+      ClientID::INTERFACE_ROUTE,
+      {interfaceRoute("1.1.1.0", 24, "1.1.1.1", 1)},
+      {});
+
+  // Delete an intermediate route, then add a default route to fall back on
+  update(kClientA, {}, {{IPAddress("10.1.1.0"), 24}});
+  EXPECT_FALSE(isResolved("30.1.1.0", 24));
+  update(kClientB, {route("0.0.0.0", 0, {"2.2.2.30"})}, {});
+  EXPECT_TRUE(isResolved("30.1.1.0", 24));
+
+  // Change next hops of an existing route
+  update(kClientA, {route("20.1.1.0", 24, {"1.1.1.20"})}, {});
+  update(kClientA, {route("1001::", 48, {"2001::1"})}, {});
+  update(ClientID::INTERFACE_ROUTE, {}, {{IPAddress("1::"), 64}});
+  EXPECT_FALSE(isResolved("50.1.1.0", 24));
+}
+
 } // namespace facebook::fboss
@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/HwAsicTable.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/hw/mock/MockPlatformMapping.h"
+#include "fboss/agent/state/AclEntry.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/Port.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <set>
+
+using namespace facebook::fboss;
+using std::make_shared;
+using std::shared_ptr;
+using Section = ConfigFingerprint::Section;
+
+namespace {
+
+class ConfigFingerprintTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_enable_acl_table_group = false;
+    platform_ = createMockPlatform();
+    config_ = testConfigA();
+    addAcl("acl0", "10.0.0.0/24");
+    hwAsicTable_ = std::make_unique<HwAsicTable>(
+        *config_.switchSettings()->switchIdToSwitchInfo(), std::nullopt);
+  }
+
+  shared_ptr<SwitchState> apply(
+      const shared_ptr<SwitchState>& state,
+      ConfigFingerprint* fingerprint) {
+    state->publish();
+    return applyThriftConfig(
+        state,
+        &config_,
+        platform_->supportsAddRemovePort(),
+        &platformMapping_,
+        hwAsicTable_.get(),
+        static_cast<RoutingInformationBase*>(nullptr),
+        nullptr /* aclNexthopHandler */,
+        fingerprint);
+  }
+
+  void addAcl(const std::string& name, const std::string& dstIp) {
+    cfg::AclEntry acl;
+    acl.name() = name;
+    acl.actionType() = cfg::AclActionType::DENY;
+    acl.dstIp() = dstIp;
+    config_.acls()->push_back(acl);
+  }
+
+  void expectSkipped(
+      const ConfigFingerprint& fingerprint,
+      const std::set<Section>& evaluated) {
+    for (size_t idx = 0; idx < ConfigFingerprint::kNumSections; ++idx) {
+      auto section = static_cast<Section>(idx);
+      EXPECT_EQ(
+          fingerprint.wasSkipped(section),
+          evaluated.find(section) == evaluated.end())
+          << "section " << idx;
+    }
+  }
+
+ protected:
+  // Restores FLAGS_enable_acl_table_group once the test is done
+  gflags::FlagSaver flagSaver_;
+  std::unique_ptr<MockPlatform> platform_;
+  MockPlatformMapping platformMapping_;
+  std::unique_ptr<HwAsicTable> hwAsicTable_;
+  cfg::SwitchConfig config_;
+};
+
+} // namespace
+
+TEST_F(ConfigFingerprintTest, skipUnchangedSections) {
+  ConfigFingerprint fingerprint;
+  auto stateV1 = apply(make_shared<SwitchState>(), &fingerprint);
+  ASSERT_NE(nullptr, stateV1);
+  // Nothing to compare against on the first apply
+  expectSkipped(
+      fingerprint,
+      {Section::PORTS,
+       Section::AGGREGATE_PORTS,
+       Section::MIRRORS,
+       Section::ACLS,
+       Section::QOS_POLICIES,
+       Section::SFLOW_COLLECTORS,
+       Section::LOAD_BALANCERS,
+       Section::IP_TUNNELS,
+       Section::DSF_NODES});
+
+  EXPECT_EQ(nullptr, apply(stateV1, &fingerprint));
+  expectSkipped(fingerprint, {});
+
+  // Only the ACL section is evaluated again
+  addAcl("acl1", "10.0.1.0/24");
+  auto stateV2 = apply(stateV1, &fingerprint);
+  ASSERT_NE(nullptr, stateV2);
+  expectSkipped(fingerprint, {Section::ACLS});
+  EXPECT_NE(nullptr, stateV2->getAcl("acl1"));
+  EXPECT_EQ(stateV1->getPorts(), stateV2->getPorts());
+
+  // Same result as evaluating the full config
+  auto expected = apply(stateV1, nullptr);
+  ASSERT_NE(nullptr, expected);
+  EXPECT_EQ(expected->getAcls()->toThrift(), stateV2->getAcls()->toThrift());
+  EXPECT_EQ(expected->getPorts()->toThrift(), stateV2->getPorts()->toThrift());
+}
+
+TEST_F(ConfigFingerprintTest, reevaluateNodesChangedOutsideConfig) {
+  ConfigFingerprint fingerprint;
+  auto stateV1 = apply(make_shared<SwitchState>(), &fingerprint);
+  ASSERT_NE(nullptr, stateV1);
+  stateV1->publish();
+
+  auto portId = PortID(*config_.ports()[0].logicalID());
+  auto stateV2 = stateV1->clone();
+  auto port = stateV2->getPorts()->getNodeIf(portId)->modify(&stateV2);
+  auto cfgAdminState = port->getAdminState();
+  port->setAdminState(
+      cfgAdminState == cfg::PortState::ENABLED ? cfg::PortState::DISABLED
+                                               : cfg::PortState::ENABLED);
+
+  // The config is unchanged, but ports no longer match what it produced
+  auto stateV3 = apply(stateV2, &fingerprint);
+  ASSERT_NE(nullptr, stateV3);
+  EXPECT_FALSE(fingerprint.wasSkipped(Section::PORTS));
+  EXPECT_TRUE(fingerprint.wasSkipped(Section::ACLS));
+  EXPECT_EQ(
+      cfgAdminState, stateV3->getPorts()->getNodeIf(portId)->getAdminState());
+}
+
+TEST_F(ConfigFingerprintTest, clear) {
+  ConfigFingerprint fingerprint;
+  auto stateV1 = apply(make_shared<SwitchState>(), &fingerprint);
+  ASSERT_NE(nullptr, stateV1);
+  fingerprint.clear();
+  EXPECT_EQ(nullptr, apply(stateV1, &fingerprint));
+  EXPECT_FALSE(fingerprint.wasSkipped(Section::PORTS));
+  EXPECT_FALSE(fingerprint.wasSkipped(Section::ACLS));
+}
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/Format.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/HwAsicTable.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/hw/mock/MockPlatformMapping.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <array>
+
+DEFINE_int32(
+    num_remote_dsf_nodes,
+    128,
+    "Number of remote interface nodes in the benchmark config");
+DEFINE_int32(num_acls, 2000, "Number of ACLs in the benchmark config");
+
+namespace facebook::fboss {
+
+namespace {
+
+// VOQ switch config with remote DSF nodes and ACLs at scale
+cfg::SwitchConfig fullScaleConfig() {
+  auto config = testConfigA(cfg::SwitchType::VOQ);
+  for (int i = 1; i <= FLAGS_num_remote_dsf_nodes; ++i) {
+    // Keep system port ranges of remote nodes apart
+    auto node = makeDsfNodeCfg(i * 4);
+    config.dsfNodes()->insert({*node.switchId(), node});
+  }
+  for (int i = 0; i < FLAGS_num_acls; ++i) {
+    cfg::AclEntry acl;
+    acl.name() = folly::sformat("acl{}", i);
+    acl.actionType() = cfg::AclActionType::DENY;
+    acl.dstIp() = folly::sformat("2401:db00:{:x}::/64", i);
+    config.acls()->push_back(std::move(acl));
+  }
+  return config;
+}
+
+// Alternately apply two full scale configs that differ in a single ACL
+void applyOneLineChange(uint32_t iters, bool useFingerprint) {
+  std::array<cfg::SwitchConfig, 2> configs;
+  std::unique_ptr<MockPlatform> platform;
+  std::unique_ptr<MockPlatformMapping> platformMapping;
+  std::unique_ptr<HwAsicTable> hwAsicTable;
+  std::unique_ptr<RoutingInformationBase> rib;
+  ConfigFingerprint fingerprint;
+  std::shared_ptr<SwitchState> state;
+  auto apply = [&](const cfg::SwitchConfig& config) {
+    auto newState = applyThriftConfig(
+        state,
+        &config,
+        platform->supportsAddRemovePort(),
+        platformMapping.get(),
+        hwAsicTable.get(),
+        rib.get(),
+        nullptr /* aclNexthopHandler */,
+        useFingerprint ? &fingerprint : nullptr);
+    CHECK(newState);
+    newState->publish();
+    state = newState;
+  };
+
+  BENCHMARK_SUSPEND {
+    configs[0] = fullScaleConfig();
+    configs[1] = configs[0];
+    configs[1].acls()->back().dstIp() = "2401:db01::/64";
+    platform = createMockPlatform(cfg::SwitchType::VOQ, kVoqSwitchIdBegin);
+    platformMapping = std::make_unique<MockPlatformMapping>();
+    hwAsicTable = std::make_unique<HwAsicTable>(
+        *configs[0].switchSettings()->switchIdToSwitchInfo(), std::nullopt);
+    rib = std::make_unique<RoutingInformationBase>();
+    state = std::make_shared<SwitchState>();
+    addSwitchInfo(state, cfg::SwitchType::VOQ, kVoqSwitchIdBegin);
+    state->publish();
+    apply(configs[1]);
+  }
+  for (uint32_t i = 0; i < iters; ++i) {
+    apply(configs[i % 2]);
+  }
+  BENCHMARK_SUSPEND {
+    state.reset();
+    rib.reset();
+  }
+}
+
+} // namespace
+
+BENCHMARK(ApplyOneLineConfigChange, iters) {
+  applyOneLineChange(iters, false);
+}
+
+BENCHMARK_RELATIVE(ApplyOneLineConfigChangeFingerprinted, iters) {
+  applyOneLineChange(iters, true);
+}
+
+} // namespace facebook::fboss
+
+int main(int argc, char* argv[]) {
+  folly::Init init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
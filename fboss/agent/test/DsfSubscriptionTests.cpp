@@ -3,6 +3,7 @@
 #include "fboss/agent/AgentFeatures.h"
 #include "fboss/agent/AgentFsdbSyncManager.h"
 #include "fboss/agent/DsfSubscription.h"
+#include "fboss/agent/DsfUpdateBatcher.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/hw/mock/MockPlatform.h"
 #include "fboss/agent/test/CounterCache.h"
@@ -121,6 +122,8 @@ class DsfSubscriptionTest : public ::testing::Test {
             "DsfSubscriberStreamServe"));
     hwUpdatePool_ = std::make_unique<folly::IOThreadPoolExecutor>(
         1, std::make_shared<folly::NamedThreadFactory>("DsfHwUpdate"));
+    updateBatcher_ = std::make_unique<DsfUpdateBatcher>(
+        hwUpdatePool_->getEventBase(), sw_);
   }
 
   void TearDown() override {
@@ -184,7 +187,7 @@ class DsfSubscriptionTest : public ::testing::Test {
         std::move(opts),
         streamConnectPool_->getEventBase(),
         streamServePool_->getEventBase(),
-        hwUpdatePool_->getEventBase(),
+        updateBatcher_.get(),
         "local",
         "remote",
         remoteSwitchIds(),
@@ -247,6 +250,7 @@ class DsfSubscriptionTest : public ::testing::Test {
   std::unique_ptr<folly::IOThreadPoolExecutor> streamConnectPool_;
   std::unique_ptr<folly::IOThreadPoolExecutor> streamServePool_;
   std::unique_ptr<folly::IOThreadPoolExecutor> hwUpdatePool_;
+  std::unique_ptr<DsfUpdateBatcher> updateBatcher_;
   std::optional<ReconnectingThriftClient::ServerOptions> serverOptions_;
   std::unique_ptr<HwTestHandle> handle_;
   std::shared_ptr<DsfSubscription> subscription_;
@@ -392,6 +396,108 @@ TYPED_TEST(DsfSubscriptionTest, DataUpdate) {
       this->getRemoteSystemPorts()->size(), this->kNumRemoteSwitchAsics + 1));
 }
 
+TYPED_TEST(DsfSubscriptionTest, incrementalUpdate) {
+  this->createPublisher();
+  auto state = this->makeSwitchState();
+  this->publishSwitchState(state);
+  this->subscription_ = this->createSubscription();
+
+  WITH_RETRIES({
+    ASSERT_EVENTUALLY_EQ(
+        this->getRemoteSystemPorts()->size(), this->kNumRemoteSwitchAsics);
+    ASSERT_EVENTUALLY_EQ(
+        this->getRemoteInterfaces()->size(), this->kNumRemoteSwitchAsics);
+  });
+  const auto sysPort1Id = SystemPortID(kSysPortRangeMin + 1);
+  auto sysPort1 = this->getRemoteSystemPorts()->at(sysPort1Id);
+  auto rif1 = this->getRemoteInterfaces()->at(InterfaceID(sysPort1Id));
+
+  // Only the new sys port should get applied
+  auto sysPort2 = makeSysPort(
+      std::nullopt, SystemPortID(kSysPortRangeMin + 2), kRemoteSwitchIdBegin);
+  auto portMap = state->getSystemPorts()->modify(&state);
+  portMap->addNode(sysPort2, this->matcher());
+  this->publishSwitchState(state);
+
+  WITH_RETRIES(ASSERT_EVENTUALLY_EQ(
+      this->getRemoteSystemPorts()->size(), this->kNumRemoteSwitchAsics + 1));
+  EXPECT_EQ(this->getRemoteSystemPorts()->at(sysPort1Id), sysPort1);
+  EXPECT_EQ(this->getRemoteInterfaces()->at(InterfaceID(sysPort1Id)), rif1);
+
+  // Neighbor change only touches its rif
+  auto [ndpTable, arpTable] = makeNbrs();
+  auto intfMap = state->getInterfaces()->modify(&state);
+  auto intf = intfMap->getNode(InterfaceID(sysPort1Id))->clone();
+  intf->setNdpTable(ndpTable);
+  intfMap->updateNode(intf, this->matcher());
+  this->publishSwitchState(state);
+
+  WITH_RETRIES(ASSERT_EVENTUALLY_NE(
+      this->getRemoteInterfaces()->at(InterfaceID(sysPort1Id)), rif1));
+  EXPECT_EQ(this->getRemoteSystemPorts()->at(sysPort1Id), sysPort1);
+}
+
+TYPED_TEST(DsfSubscriptionTest, reconnectRemovesStaleObjects) {
+  FLAGS_dsf_gr_hold_time = 5;
+  const auto sysPort2Id = SystemPortID(kSysPortRangeMin + 2);
+  auto stateA = this->makeSwitchState();
+  auto stateAB = this->makeSwitchState();
+  auto sysPort2Map = std::make_shared<SystemPortMap>();
+  sysPort2Map->addNode(
+      makeSysPort(std::nullopt, sysPort2Id, kRemoteSwitchIdBegin));
+  auto rif2Map = makeRifs(sysPort2Map.get());
+  stateAB->getSystemPorts()->modify(&stateAB)->addNode(
+      sysPort2Map->at(sysPort2Id), this->matcher());
+  stateAB->getInterfaces()->modify(&stateAB)->addNode(
+      rif2Map->at(InterfaceID(sysPort2Id)), this->matcher());
+
+  auto verifyRemoteObjects = [this, sysPort2Id](bool expectSysPort2) {
+    size_t numExpected = this->kNumRemoteSwitchAsics + (expectSysPort2 ? 1 : 0);
+    WITH_RETRIES({
+      ASSERT_EVENTUALLY_EQ(this->getRemoteSystemPorts()->size(), numExpected);
+      ASSERT_EVENTUALLY_EQ(this->getRemoteInterfaces()->size(), numExpected);
+      EXPECT_EVENTUALLY_EQ(
+          this->getRemoteSystemPorts()->getNodeIf(sysPort2Id) != nullptr,
+          expectSysPort2);
+      EXPECT_EVENTUALLY_EQ(
+          this->getRemoteInterfaces()->getNodeIf(InterfaceID(sysPort2Id)) !=
+              nullptr,
+          expectSysPort2);
+    });
+  };
+
+  this->createPublisher();
+  this->publishSwitchState(stateAB);
+  this->subscription_ = this->createSubscription();
+  verifyRemoteObjects(true);
+
+  // Remote node restarts without sys port 2
+  this->stopPublisher(true);
+  this->createPublisher();
+  this->publishSwitchState(stateA);
+  verifyRemoteObjects(false);
+
+  // Same after GR expiry, when remote objects are left STALE in local
+  // state and the update baseline is reset
+  this->publishSwitchState(stateAB);
+  verifyRemoteObjects(true);
+  CounterCache counters(this->sw_);
+  this->stopPublisher(true);
+  auto grExpiredCounter =
+      SwitchStats::kCounterPrefix + "dsfsession_gr_expired.sum.60";
+  WITH_RETRIES({
+    counters.update();
+    ASSERT_EVENTUALLY_TRUE(counters.checkExist(grExpiredCounter));
+    ASSERT_EVENTUALLY_EQ(counters.value(grExpiredCounter), 1);
+  });
+  EXPECT_EQ(
+      this->getRemoteSystemPorts()->at(sysPort2Id)->getRemoteLivenessStatus(),
+      LivenessStatus::STALE);
+  this->createPublisher();
+  this->publishSwitchState(stateA);
+  verifyRemoteObjects(false);
+}
+
 TYPED_TEST(DsfSubscriptionTest, updateFailed) {
   CounterCache counters(this->sw_);
   this->createPublisher();
@@ -635,4 +741,45 @@ TYPED_TEST(DsfSubscriptionTest, setupNeighbors) {
   verifySetupNeighbors(false /* publishState */);
   verifySetupNeighbors(true /* publishState */);
 }
+
+TEST(DsfRemoteChangesTest, merge) {
+  auto sysPorts = makeSysPortsForSwitchIds(
+      std::set<SwitchID>({SwitchID(kRemoteSwitchIdBegin)}), 3);
+  auto rifs = makeRifs(sysPorts.get());
+  const auto sysPort1Id = SystemPortID(kSysPortRangeMin + 1);
+  const auto sysPort2Id = SystemPortID(kSysPortRangeMin + 2);
+  const auto sysPort3Id = SystemPortID(kSysPortRangeMin + 3);
+
+  DsfRemoteChanges changes;
+  changes.changedSystemPorts[sysPort1Id] = sysPorts->at(sysPort1Id);
+  changes.removedSystemPorts.insert(sysPort2Id);
+  changes.changedIntfs[InterfaceID(sysPort1Id)] =
+      rifs->at(InterfaceID(sysPort1Id));
+
+  // Later update removes sys port 1 and adds back sys port 2
+  DsfRemoteChanges newer;
+  newer.removedSystemPorts.insert(sysPort1Id);
+  newer.changedSystemPorts[sysPort2Id] = sysPorts->at(sysPort2Id);
+  newer.changedSystemPorts[sysPort3Id] = sysPorts->at(sysPort3Id);
+  changes.merge(std::move(newer));
+
+  EXPECT_EQ(changes.removedSystemPorts, std::set<SystemPortID>({sysPort1Id}));
+  EXPECT_EQ(changes.changedSystemPorts.size(), 2);
+  EXPECT_EQ(changes.changedSystemPorts.count(sysPort1Id), 0);
+  EXPECT_EQ(
+      changes.changedSystemPorts.at(sysPort2Id), sysPorts->at(sysPort2Id));
+  EXPECT_EQ(changes.changedIntfs.size(), 1);
+  EXPECT_TRUE(changes.removedIntfs.empty());
+
+  // Full syncs of other switches accumulate
+  DsfRemoteChanges fullSync;
+  fullSync.fullSyncSwitchIds.insert(SwitchID(kRemoteSwitchIdBegin + 1));
+  changes.merge(std::move(fullSync));
+  EXPECT_EQ(
+      changes.fullSyncSwitchIds,
+      std::set<SwitchID>({SwitchID(kRemoteSwitchIdBegin + 1)}));
+
+  changes.clear();
+  EXPECT_TRUE(changes.empty());
+}
 } // namespace facebook::fboss
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "fboss/agent/L2Entry.h"
+#include "fboss/agent/L2LearnEventObserver.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <atomic>
+
+DEFINE_int32(num_learn_events, 100000, "Number of L2 learn events to replay");
+
+DECLARE_int32(l2_learn_batch_max_events);
+
+namespace facebook::fboss {
+
+namespace {
+
+// Counts the replayed events, so the run checks none were lost
+class LearnEventCounter : public L2LearnEventObserverIf {
+ public:
+  size_t count() const {
+    return count_.load();
+  }
+
+ private:
+  void l2LearningUpdateReceived(
+      const L2Entry& /* l2Entry */,
+      const L2EntryUpdateType& /* l2EntryUpdateType */) noexcept override {
+    ++count_;
+  }
+
+  std::atomic<size_t> count_{0};
+};
+
+/*
+ * Replay num_learn_events learns of distinct MACs on VLAN 1, spread over
+ * its ports, and wait until all of them are in the switch state. Each MAC
+ * is then learnt again on the next port, as in a MAC move storm.
+ */
+void replayLearnEvents(
+    uint32_t iters,
+    int32_t batchMaxEvents,
+    folly::UserCounters& counters) {
+  gflags::FlagSaver flagSaver;
+  std::unique_ptr<HwTestHandle> handle;
+  SwSwitch* sw{nullptr};
+  LearnEventCounter counter;
+  std::vector<folly::MacAddress> macs;
+  BENCHMARK_SUSPEND {
+    FLAGS_l2_learn_batch_max_events = batchMaxEvents;
+    handle = createTestHandle(testStateA());
+    sw = handle->getSw();
+    sw->getL2LearnEventObservers()->registerL2LearnEventObserver(
+        &counter, "MacLearnBenchmark");
+    macs.reserve(FLAGS_num_learn_events);
+    for (auto i = 0; i < FLAGS_num_learn_events; ++i) {
+      macs.emplace_back(folly::MacAddress::fromHBO(0x020000000000 + i));
+    }
+  }
+
+  auto startGeneration = sw->getState()->getGeneration();
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    for (size_t i = 0; i < macs.size(); ++i) {
+      sw->l2LearningUpdateReceived(
+          L2Entry(
+              macs[i],
+              VlanID(1),
+              PortDescriptor(PortID((i + iter) % 10 + 1)),
+              L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING),
+          L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+    }
+    waitForBackgroundThread(sw);
+    waitForStateUpdates(sw);
+  }
+
+  BENCHMARK_SUSPEND {
+    CHECK_EQ(counter.count(), macs.size() * iters);
+    auto numUpdates = sw->getState()->getGeneration() - startGeneration;
+    counters["state_updates"] =
+        folly::UserMetric(static_cast<int64_t>(numUpdates));
+    sw->getL2LearnEventObservers()->unregisterL2LearnEventObserver(
+        &counter, "MacLearnBenchmark");
+    handle.reset();
+  }
+}
+
+} // namespace
+
+BENCHMARK_COUNTERS(ReplayLearnEventsUnbatched, counters, iters) {
+  replayLearnEvents(iters, 1, counters);
+}
+
+BENCHMARK_COUNTERS_RELATIVE(ReplayLearnEventsBatched, counters, iters) {
+  replayLearnEvents(iters, 1024, counters);
+}
+
+} // namespace facebook::fboss
+
+int main(int argc, char* argv[]) {
+  folly::Init init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
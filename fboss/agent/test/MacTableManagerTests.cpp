@@ -18,6 +18,9 @@
 #include "fboss/agent/test/TestUtils.h"
 
 #include <folly/MacAddress.h>
+#include <gflags/gflags.h>
+
+DECLARE_int32(l2_learn_batch_max_events);
 
 namespace facebook::fboss {
 
@@ -56,12 +59,23 @@ class MacTableManagerTest : public ::testing::Test {
         facebook::fboss::L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD, wait);
   }
 
+  void triggerMacLearnedCb(PortID port, bool wait) {
+    triggerMacCbHelper(
+        facebook::fboss::L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD,
+        wait,
+        port);
+  }
+
   void triggerMacAgedCb(bool wait = true) {
     triggerMacCbHelper(
         facebook::fboss::L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE, wait);
   }
 
   void verifyMacIsAdded() {
+    verifyMacIsAdded(kPortID());
+  }
+
+  void verifyMacIsAdded(PortID port) {
     verifyStateUpdate([=]() {
       auto vlan = sw_->getState()->getVlans()->getNode(kVlan());
       auto* macTable = vlan->getMacTable().get();
@@ -69,7 +83,7 @@ class MacTableManagerTest : public ::testing::Test {
 
       EXPECT_NE(nullptr, node);
       EXPECT_EQ(kMacAddress(), node->getMac());
-      EXPECT_EQ(kPortID(), node->getPort().phyPortID());
+      EXPECT_EQ(port, node->getPort().phyPortID());
     });
   }
 
@@ -99,11 +113,12 @@ class MacTableManagerTest : public ::testing::Test {
 
   void triggerMacCbHelper(
       L2EntryUpdateType l2EntryUpdateType,
-      bool wait = true) {
+      bool wait = true,
+      std::optional<PortID> port = std::nullopt) {
     auto l2Entry = L2Entry(
         kMacAddress(),
         kVlan(),
-        PortDescriptor(kPortID()),
+        PortDescriptor(port.value_or(kPortID())),
         L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING);
 
     sw_->l2LearningUpdateReceived(l2Entry, l2EntryUpdateType);
@@ -153,6 +168,31 @@ TEST_F(MacTableManagerTest, MacAgedLearnedCb) {
   EXPECT_TRUE(macAdded2.wait());
 }
 
+TEST_F(MacTableManagerTest, MacMovedBeforeBatchApplied) {
+  // Both learns land in the same batch, the later port wins
+  triggerMacLearnedCb(kPortID(), false);
+  triggerMacLearnedCb(PortID(2), true);
+
+  verifyMacIsAdded(PortID(2));
+}
+
+TEST_F(MacTableManagerTest, MacLearnedAgedInSameBatch) {
+  triggerMacLearnedCb(false);
+  triggerMacAgedCb(true);
+
+  verifyMacIsDeleted();
+}
+
+TEST_F(MacTableManagerTest, MacLearnedCbBatchFull) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_l2_learn_batch_max_events = 1;
+  WaitForMacEntryAddedOrDeleted macAdded(
+      getSw(), kMacAddress(), kVlan(), true);
+  // A full batch is applied right away, without the background thread
+  triggerMacLearnedCb(false);
+  EXPECT_TRUE(macAdded.wait());
+}
+
 TEST_F(MacTableManagerTest, MacAgedCb) {
   triggerMacLearnedCb();
   triggerMacAgedCb();
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketDispatcher.h"
+#include "fboss/agent/SwRxPacket.h"
+
+#include <folly/Format.h>
+#include <folly/String.h>
+#include <folly/io/IOBuf.h>
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace facebook::fboss;
+
+namespace {
+
+using PacketClass = RxPacketDispatcher::PacketClass;
+
+const std::string kMacs =
+    "02 00 00 00 00 01"
+    "02 00 00 00 00 02";
+
+std::unique_ptr<SwRxPacket> makePacket(const std::string& hex) {
+  auto bytes = folly::unhexlify(folly::removeSpaces(kMacs + hex));
+  // Pad to the minimum ethernet frame size
+  bytes.resize(std::max<size_t>(bytes.size(), 64));
+  return std::make_unique<SwRxPacket>(folly::IOBuf::copyBuffer(bytes));
+}
+
+std::unique_ptr<SwRxPacket> makeUdpV4Packet(uint16_t dstPort) {
+  return makePacket(folly::sformat(
+      "08 00"
+      "45 00 00 30 00 00 00 00 40 11 00 00 0a 00 00 01 0a 00 00 02"
+      "12 34 {:04x} 00 1c 00 00",
+      dstPort));
+}
+
+std::unique_ptr<SwRxPacket> makeIPv6Packet(
+    uint8_t nextHeader,
+    uint16_t dstPort = 0) {
+  return makePacket(folly::sformat(
+      "86 dd"
+      "60 00 00 00 00 08 {:02x} ff"
+      "fe 80 00 00 00 00 00 00 00 00 00 00 00 00 00 01"
+      "fe 80 00 00 00 00 00 00 00 00 00 00 00 00 00 02"
+      "12 34 {:04x} 00 08 00 00",
+      nextHeader,
+      dstPort));
+}
+
+} // namespace
+
+TEST(RxPacketDispatcherTest, classify) {
+  auto classify = [](const std::unique_ptr<SwRxPacket>& pkt) {
+    return RxPacketDispatcher::classify(pkt.get());
+  };
+  // LACP, LLDP, EAPOL
+  EXPECT_EQ(classify(makePacket("88 09 01")), PacketClass::CONTROL);
+  EXPECT_EQ(classify(makePacket("88 cc")), PacketClass::CONTROL);
+  EXPECT_EQ(classify(makePacket("88 8e")), PacketClass::CONTROL);
+  // Tagged LLDP
+  EXPECT_EQ(classify(makePacket("81 00 00 05 88 cc")), PacketClass::CONTROL);
+  // ARP, NDP
+  EXPECT_EQ(classify(makePacket("08 06")), PacketClass::NEIGHBOR);
+  EXPECT_EQ(classify(makeIPv6Packet(58)), PacketClass::NEIGHBOR);
+  // DHCP
+  EXPECT_EQ(classify(makeUdpV4Packet(67)), PacketClass::DHCP);
+  EXPECT_EQ(classify(makeUdpV4Packet(68)), PacketClass::DHCP);
+  EXPECT_EQ(classify(makeIPv6Packet(17, 546)), PacketClass::DHCP);
+  EXPECT_EQ(classify(makeIPv6Packet(17, 547)), PacketClass::DHCP);
+  // Everything else
+  EXPECT_EQ(classify(makeUdpV4Packet(8000)), PacketClass::OTHER);
+  EXPECT_EQ(classify(makeIPv6Packet(17, 8000)), PacketClass::OTHER);
+  EXPECT_EQ(classify(makeIPv6Packet(6)), PacketClass::OTHER);
+  EXPECT_EQ(classify(makePacket("88 47")), PacketClass::OTHER);
+  // Truncated
+  auto truncated = std::make_unique<SwRxPacket>(
+      folly::IOBuf::copyBuffer(folly::unhexlify("020000000001")));
+  EXPECT_EQ(classify(truncated), PacketClass::OTHER);
+}
+
+TEST(RxPacketDispatcherTest, dispatchInOrder) {
+  constexpr int kNumPackets = 100;
+  std::mutex lock;
+  std::vector<uint16_t> handled;
+  folly::Baton<> done;
+  RxPacketDispatcher dispatcher(
+      [&](std::unique_ptr<RxPacket> pkt) {
+        auto data = pkt->buf()->data();
+        // Destination port of the UDP header
+        uint16_t port = (data[36] << 8) | data[37];
+        std::lock_guard<std::mutex> g(lock);
+        handled.push_back(port);
+        if (handled.size() == kNumPackets) {
+          done.post();
+        }
+      },
+      kNumPackets);
+  for (int i = 0; i < kNumPackets; ++i) {
+    // Like the SDK, hand over a buffer we reuse once dispatch returns
+    std::vector<uint8_t> sdkBuf(64);
+    auto orig = makeUdpV4Packet(1000 + i);
+    memcpy(sdkBuf.data(), orig->buf()->data(), sdkBuf.size());
+    auto pkt = std::make_unique<SwRxPacket>(
+        folly::IOBuf::wrapBuffer(sdkBuf.data(), sdkBuf.size()));
+    EXPECT_TRUE(dispatcher.dispatch(std::move(pkt)));
+    std::fill(sdkBuf.begin(), sdkBuf.end(), 0);
+  }
+  done.wait();
+  dispatcher.stop();
+  ASSERT_EQ(handled.size(), kNumPackets);
+  for (int i = 0; i < kNumPackets; ++i) {
+    EXPECT_EQ(handled[i], 1000 + i);
+  }
+  EXPECT_EQ(dispatcher.getDispatched(PacketClass::OTHER), kNumPackets);
+  EXPECT_EQ(dispatcher.getDropped(PacketClass::OTHER), 0);
+}
+
+TEST(RxPacketDispatcherTest, dropWhenQueueFull) {
+  constexpr int kQueueSize = 4;
+  folly::Baton<> started;
+  folly::Baton<> unblock;
+  std::atomic<int> numHandled{0};
+  RxPacketDispatcher dispatcher(
+      [&](std::unique_ptr<RxPacket> /*pkt*/) {
+        if (numHandled++ == 0) {
+          started.post();
+          unblock.wait();
+        }
+      },
+      kQueueSize);
+  // Block the DHCP worker on the first packet
+  EXPECT_TRUE(dispatcher.dispatch(makeUdpV4Packet(67)));
+  started.wait();
+  for (int i = 0; i < kQueueSize; ++i) {
+    EXPECT_TRUE(dispatcher.dispatch(makeUdpV4Packet(67)));
+  }
+  EXPECT_FALSE(dispatcher.dispatch(makeUdpV4Packet(67)));
+  // Other classes are unaffected
+  EXPECT_TRUE(dispatcher.dispatch(makePacket("88 cc")));
+
+  unblock.post();
+  dispatcher.stop();
+  EXPECT_EQ(numHandled.load(), kQueueSize + 2);
+  EXPECT_EQ(dispatcher.getDispatched(PacketClass::DHCP), kQueueSize + 1);
+  EXPECT_EQ(dispatcher.getDropped(PacketClass::DHCP), 1);
+  EXPECT_EQ(dispatcher.getDispatched(PacketClass::CONTROL), 1);
+  EXPECT_EQ(dispatcher.getDropped(PacketClass::CONTROL), 0);
+  // Packets are rejected once stopped
+  EXPECT_TRUE(dispatcher.isStopped());
+  EXPECT_FALSE(dispatcher.dispatch(makePacket("88 cc")));
+}
@@ -28,6 +28,7 @@
 #include "fboss/agent/test/TestUtils.h"
 
 #include <folly/IPAddress.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
 #include <gtest/gtest.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
@@ -1802,6 +1803,157 @@ TEST_F(ThriftTest, getRouteTableByClient) {
   // 6 intf routes + 2 default routes + 1 link local route
   EXPECT_EQ(7, routeTable.size());
 }
+
+#if FOLLY_HAS_COROUTINES
+namespace {
+template <typename RouteT>
+std::vector<std::vector<RouteT>> drainRouteStream(
+    apache::thrift::ServerStream<std::vector<RouteT>> stream) {
+  folly::ScopedEventBaseThread evbThread;
+  std::vector<std::vector<RouteT>> chunks;
+  std::move(stream)
+      .toClientStreamUnsafeDoNotUse(evbThread.getEventBase())
+      .subscribeInline([&chunks](folly::Try<std::vector<RouteT>>&& chunk) {
+        if (chunk.hasException()) {
+          ADD_FAILURE() << chunk.exception().what();
+        } else if (chunk.hasValue()) {
+          chunks.push_back(std::move(*chunk));
+        }
+      });
+  return chunks;
+}
+
+template <typename RouteT>
+std::vector<RouteT> flattenChunks(std::vector<std::vector<RouteT>> chunks) {
+  std::vector<RouteT> routes;
+  for (auto& chunk : chunks) {
+    routes.insert(
+        routes.end(),
+        std::make_move_iterator(chunk.begin()),
+        std::make_move_iterator(chunk.end()));
+  }
+  return routes;
+}
+
+std::vector<IpPrefix> routePrefixes(const std::vector<UnicastRoute>& routes) {
+  std::vector<IpPrefix> prefixes;
+  for (const auto& route : routes) {
+    prefixes.push_back(*route.dest());
+  }
+  return prefixes;
+}
+} // namespace
+
+TEST_F(ThriftTest, streamRouteTable) {
+  ThriftHandler handler(sw_);
+  std::vector<UnicastRoute> routeTable;
+  handler.getRouteTable(routeTable);
+
+  auto chunks = drainRouteStream(handler.streamRouteTable(
+      std::make_unique<RouteTableFilter>(), 0 /* default chunk size */));
+  ASSERT_EQ(1, chunks.size());
+  EXPECT_EQ(routeTable, chunks[0]);
+
+  chunks = drainRouteStream(
+      handler.streamRouteTable(std::make_unique<RouteTableFilter>(), 3));
+  ASSERT_EQ((routeTable.size() + 2) / 3, chunks.size());
+  for (size_t i = 0; i + 1 < chunks.size(); ++i) {
+    EXPECT_EQ(3, chunks[i].size());
+  }
+  EXPECT_EQ(routeTable, flattenChunks(std::move(chunks)));
+}
+
+TEST_F(ThriftTest, streamRouteTableMultiVrf) {
+  auto config = testConfigA();
+  config.interfaces()[1].routerID() = 1;
+  sw_->applyConfig("Move interface 55 to VRF 1", config);
+
+  ThriftHandler handler(sw_);
+  std::vector<UnicastRoute> routeTable;
+  handler.getRouteTable(routeTable);
+  EXPECT_THAT(
+      routePrefixes(routeTable),
+      ::testing::IsSupersetOf(
+          {ipPrefix("10.0.0.0", 24), ipPrefix("10.0.55.0", 24)}));
+
+  auto routes = flattenChunks(drainRouteStream(
+      handler.streamRouteTable(std::make_unique<RouteTableFilter>(), 2)));
+  EXPECT_EQ(routeTable, routes);
+
+  std::vector<RouteDetails> routeDetails;
+  handler.getRouteTableDetails(routeDetails);
+  auto details = flattenChunks(drainRouteStream(handler.streamRouteTableDetails(
+      std::make_unique<RouteTableFilter>(), 2)));
+  EXPECT_EQ(routeDetails, details);
+}
+
+TEST_F(ThriftTest, streamRouteTablePrefixFilter) {
+  ThriftHandler handler(sw_);
+  auto streamPrefixes = [&handler](StringPiece ip, int length) {
+    auto filter = std::make_unique<RouteTableFilter>();
+    filter->prefix() = ipPrefix(ip, length);
+    return routePrefixes(flattenChunks(
+        drainRouteStream(handler.streamRouteTable(std::move(filter), 0))));
+  };
+  // Only routes equal to or more specific than the filter, default routes
+  // and the other address family are left out.
+  EXPECT_THAT(
+      streamPrefixes("10.0.0.0", 8),
+      UnorderedElementsAreArray(
+          {ipPrefix("10.0.0.0", 24), ipPrefix("10.0.55.0", 24)}));
+  EXPECT_THAT(
+      streamPrefixes("10.0.0.0", 24),
+      UnorderedElementsAreArray({ipPrefix("10.0.0.0", 24)}));
+  EXPECT_THAT(
+      streamPrefixes("2401:db00:2110::", 48),
+      UnorderedElementsAreArray(
+          {ipPrefix("2401:db00:2110:3001::", 64),
+           ipPrefix("2401:db00:2110:3055::", 64)}));
+  EXPECT_TRUE(streamPrefixes("10.0.0.0", 25).empty());
+
+  auto filter = std::make_unique<RouteTableFilter>();
+  filter->prefix() = ipPrefix("10.0.0.0", 8);
+  auto details = flattenChunks(
+      drainRouteStream(handler.streamRouteTableDetails(std::move(filter), 0)));
+  std::vector<IpPrefix> detailPrefixes;
+  for (const auto& route : details) {
+    detailPrefixes.push_back(*route.dest());
+  }
+  EXPECT_THAT(
+      detailPrefixes,
+      UnorderedElementsAreArray(
+          {ipPrefix("10.0.0.0", 24), ipPrefix("10.0.55.0", 24)}));
+}
+
+TEST_F(ThriftTest, streamRouteTableClientFilter) {
+  ThriftHandler handler(sw_);
+  auto bgpClient = static_cast<int16_t>(ClientID::BGPD);
+  handler.addUnicastRoute(
+      bgpClient,
+      makeUnicastRoute(
+          "aaaa:1::0/64",
+          "2401:db00:2110:3001::0011",
+          sw_->clientIdToAdminDistance(bgpClient)));
+
+  for (auto client :
+       {bgpClient, static_cast<int16_t>(ClientID::INTERFACE_ROUTE)}) {
+    std::vector<UnicastRoute> routeTable;
+    handler.getRouteTableByClient(routeTable, client);
+    auto filter = std::make_unique<RouteTableFilter>();
+    filter->clientId() = client;
+    auto routes = flattenChunks(
+        drainRouteStream(handler.streamRouteTable(std::move(filter), 0)));
+    EXPECT_EQ(routeTable, routes);
+  }
+
+  // Prefix and client filters combine
+  auto filter = std::make_unique<RouteTableFilter>();
+  filter->clientId() = bgpClient;
+  filter->prefix() = ipPrefix("10.0.0.0", 8);
+  EXPECT_TRUE(drainRouteStream(handler.streamRouteTable(std::move(filter), 0))
+                  .empty());
+}
+#endif
 std::unique_ptr<MplsRoute> makeMplsRoute(
     int32_t mplsLabel,
     std::string nxtHop,
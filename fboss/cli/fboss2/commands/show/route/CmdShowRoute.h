@@ -13,8 +13,11 @@
 #include <fboss/agent/if/gen-cpp2/ctrl_types.h>
 #include <fboss/cli/fboss2/utils/CmdUtils.h>
 #include <folly/String.h>
+#include <thrift/lib/cpp/TApplicationException.h>
+#include <thrift/lib/cpp2/async/ClientBufferedStream.h>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <type_traits>
 #include "fboss/agent/if/gen-cpp2/common_types.h"
 #include "fboss/cli/fboss2/CmdHandler.h"
@@ -34,14 +37,38 @@ class CmdShowRoute : public CmdHandler<CmdShowRoute, CmdShowRouteTraits> {
  public:
   using NextHopThrift = facebook::fboss::NextHopThrift;
   using UnicastRoute = facebook::fboss::UnicastRoute;
+  using RouteStream =
+      apache::thrift::ClientBufferedStream<std::vector<UnicastRoute>>;
 
   RetType queryClient(const HostInfo& hostInfo) {
-    std::vector<UnicastRoute> entries;
     auto client =
         utils::createClient<facebook::fboss::FbossCtrlAsyncClient>(hostInfo);
 
-    client->sync_getRouteTable(entries);
-    return createModel(entries);
+    std::optional<RouteStream> stream;
+    try {
+      stream = client->sync_streamRouteTable(RouteTableFilter(), kChunkSize);
+    } catch (const apache::thrift::TApplicationException&) {
+      // Agent doesn't support streaming yet, fetch the table in one go
+      std::vector<UnicastRoute> entries;
+      client->sync_getRouteTable(entries);
+      return createModel(entries);
+    }
+    // Convert routes a chunk at a time, so the full table is never held as
+    // both thrift routes and model entries
+    RetType model;
+    folly::exception_wrapper error;
+    std::move(*stream).subscribeInline(
+        [&](folly::Try<std::vector<UnicastRoute>>&& chunk) {
+          if (chunk.hasException()) {
+            error = std::move(chunk.exception());
+          } else if (chunk.hasValue()) {
+            addRoutes(*chunk, model);
+          }
+        });
+    if (error) {
+      error.throw_exception();
+    }
+    return model;
   }
 
   void printOutput(const RetType& model, std::ostream& out = std::cout) {
@@ -74,7 +101,13 @@ class CmdShowRoute : public CmdHandler<CmdShowRoute, CmdShowRouteTraits> {
   RetType createModel(
       std::vector<facebook::fboss::UnicastRoute>& routeEntries) {
     RetType model;
+    addRoutes(routeEntries, model);
+    return model;
+  }
 
+  void addRoutes(
+      const std::vector<facebook::fboss::UnicastRoute>& routeEntries,
+      RetType& model) {
     for (const auto& entry : routeEntries) {
       auto& nextHops = entry.get_nextHops();
 
@@ -103,10 +136,12 @@ class CmdShowRoute : public CmdHandler<CmdShowRoute, CmdShowRouteTraits> {
           routeEntry.nextHops()->emplace_back(nextHopInfo);
         }
       }
-      model.routeEntries()->emplace_back(routeEntry);
+      model.routeEntries()->emplace_back(std::move(routeEntry));
     }
-    return model;
   }
+
+ private:
+  static constexpr int32_t kChunkSize = 1000;
 };
 
 } // namespace facebook::fboss
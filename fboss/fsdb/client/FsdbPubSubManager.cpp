@@ -637,6 +637,12 @@ void FsdbPubSubManager::removeStateExtDeltaSubscription(
   removeSubscriptionImpl(
       subscribePaths, fsdbHost, true /*delta*/, false /*subscribeStats*/);
 }
+void FsdbPubSubManager::removeStateExtPathSubscription(
+    const std::vector<ExtendedOperPath>& subscribePaths,
+    const std::string& fsdbHost) {
+  removeSubscriptionImpl(
+      subscribePaths, fsdbHost, false /*delta*/, false /*subscribeStats*/);
+}
 void FsdbPubSubManager::removeStatExtDeltaSubscription(
     const std::vector<ExtendedOperPath>& subscribePaths,
     const std::string& fsdbHost) {
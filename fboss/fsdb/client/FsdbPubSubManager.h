@@ -188,6 +188,9 @@ class FsdbPubSubManager {
   void removeStateExtDeltaSubscription(
       const std::vector<ExtendedOperPath>& subscribePath,
       const std::string& fsdbHost = "::1");
+  void removeStateExtPathSubscription(
+      const std::vector<ExtendedOperPath>& subscribePath,
+      const std::string& fsdbHost = "::1");
   void removeStatExtDeltaSubscription(
       const std::vector<ExtendedOperPath>& subscribePath,
       const std::string& fsdbHost = "::1");
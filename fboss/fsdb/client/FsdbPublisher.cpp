@@ -2,17 +2,44 @@
 
 #include "fboss/fsdb/client/FsdbPublisher.h"
 
+#include "fboss/fsdb/common/Utils.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_common_types.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 
+#include <fb303/ServiceData.h>
 #include <folly/logging/xlog.h>
 #include <chrono>
 #include <memory>
 #include <type_traits>
 #include <utility>
 
+DEFINE_bool(
+    fsdb_publisher_coalesce_on_full_queue,
+    false,
+    "When the publish queue is full, merge pub units in to one until the "
+    "queue has room for it, instead of disconnecting and doing a full sync");
+
 namespace facebook::fboss::fsdb {
 
+namespace {
+/*
+ * Merge pub unit from, written after into, in to into. Path publishers
+ * send the whole state each time, so the later state replaces the earlier.
+ */
+template <typename PubUnit>
+bool mergePubUnit(PubUnit& into, PubUnit&& from) {
+  if constexpr (std::is_same_v<PubUnit, OperDelta>) {
+    mergeDelta(into, std::move(from));
+    return true;
+  } else if constexpr (std::is_same_v<PubUnit, Patch>) {
+    return mergePatch(into, std::move(from));
+  } else {
+    into = std::move(from);
+    return true;
+  }
+}
+} // namespace
+
 template <typename PubUnit>
 std::string FsdbPublisher<PubUnit>::typeStr() {
   if constexpr (std::is_same_v<PubUnit, OperDelta>) {
@@ -48,9 +75,61 @@ void FsdbPublisher<PubUnit>::handleStateChange(
     queueSize_ = 0;
   } else {
     *pipeWPtr = makePipe();
+    queueHighWatermark_ = 0;
+    fb303::fbData->setCounter(getCounterPrefix() + ".queueHighWatermark", 0);
   }
+  overflow_.lock()->reset();
 #endif
 }
+
+template <typename PubUnit>
+void FsdbPublisher<PubUnit>::enqueued() {
+  auto queueSize = ++queueSize_;
+  pubUnits_.addValue(1);
+  auto highWatermark = queueHighWatermark_.load();
+  while (queueSize > highWatermark &&
+         !queueHighWatermark_.compare_exchange_weak(highWatermark, queueSize)) {
+  }
+  if (queueSize > highWatermark) {
+    fb303::fbData->setCounter(
+        getCounterPrefix() + ".queueHighWatermark", queueSize);
+  }
+}
+
+#if FOLLY_HAS_COROUTINES
+template <typename PubUnit>
+bool FsdbPublisher<PubUnit>::writeOrCoalesce(PipeT& pipe, PubUnit&& pubUnit) {
+  auto overflow = overflow_.lock();
+  if (!overflow->has_value()) {
+    if (pipe.try_write(std::move(pubUnit))) {
+      enqueued();
+      return true;
+    }
+    // try_write leaves pubUnit alone when the queue is full
+    XLOG(DBG2) << "Publish queue full, coalescing pub units";
+    overflow->emplace(std::move(pubUnit));
+    return true;
+  }
+  if (!mergePubUnit(**overflow, std::move(pubUnit))) {
+    XLOG(ERR) << "Could not coalesce pub unit";
+    return false;
+  }
+  coalescedPubUnits_.addValue(1);
+  flushOverflow(pipe, *overflow);
+  return true;
+}
+
+template <typename PubUnit>
+void FsdbPublisher<PubUnit>::flushOverflow(
+    PipeT& pipe,
+    std::optional<PubUnit>& overflow) {
+  if (overflow.has_value() && pipe.try_write(std::move(*overflow))) {
+    overflow.reset();
+    enqueued();
+  }
+}
+#endif
+
 template <typename PubUnit>
 bool FsdbPublisher<PubUnit>::write(PubUnit&& pubUnit) {
   pubUnit.metadata().ensure();
@@ -62,7 +141,16 @@ bool FsdbPublisher<PubUnit>::write(PubUnit&& pubUnit) {
   }
 #if FOLLY_HAS_COROUTINES
   auto pipeUPtr = asyncPipe_.ulock();
-  if (!(*pipeUPtr) || !(*pipeUPtr)->second.try_write(std::move(pubUnit))) {
+  bool queued = false;
+  if (*pipeUPtr) {
+    if (FLAGS_fsdb_publisher_coalesce_on_full_queue) {
+      queued = writeOrCoalesce((*pipeUPtr)->second, std::move(pubUnit));
+    } else if ((*pipeUPtr)->second.try_write(std::move(pubUnit))) {
+      enqueued();
+      queued = true;
+    }
+  }
+  if (!queued) {
     XLOG(ERR) << "Could not enqueue pub unit";
     if (*pipeUPtr) {
       XLOG(ERR) << "Queue overflow, reset queue pointer";
@@ -70,12 +158,12 @@ bool FsdbPublisher<PubUnit>::write(PubUnit&& pubUnit) {
       // back to full sync protocol
       pipeUPtr.moveFromUpgradeToWrite()->reset();
       queueSize_ = 0;
+      overflow_.lock()->reset();
     }
     writeErrors_.addValue(1);
     return false;
   }
 #endif
-  queueSize_++;
   return true;
 }
 
@@ -87,6 +175,11 @@ FsdbPublisher<PubUnit>::createGenerator() {
     {
       auto pipeRPtr = asyncPipe_.rlock();
       if (*pipeRPtr) {
+        // Room frees up in the queue as pub units are consumed, move the
+        // coalesced one in so it is not held back until the next write
+        if (FLAGS_fsdb_publisher_coalesce_on_full_queue) {
+          flushOverflow((*pipeRPtr)->second, *overflow_.lock());
+        }
         auto pubUnit = co_await (*pipeRPtr)->first.next();
         if (!pubUnit) {
           continue;
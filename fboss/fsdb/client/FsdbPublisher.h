@@ -11,8 +11,12 @@
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 
 #include <atomic>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 
+DECLARE_bool(fsdb_publisher_coalesce_on_full_queue);
+
 namespace facebook::fboss::fsdb {
 template <typename PubUnit>
 class FsdbPublisher : public FsdbStreamClient {
@@ -72,6 +76,16 @@ class FsdbPublisher : public FsdbStreamClient {
             fb303::ThreadCachedServiceData::get()->getThreadStats(),
             getCounterPrefix() + ".writeErrors",
             fb303::SUM,
+            fb303::RATE),
+        pubUnits_(
+            fb303::ThreadCachedServiceData::get()->getThreadStats(),
+            getCounterPrefix() + ".pubUnits",
+            fb303::SUM,
+            fb303::RATE),
+        coalescedPubUnits_(
+            fb303::ThreadCachedServiceData::get()->getThreadStats(),
+            getCounterPrefix() + ".coalescedPubUnits",
+            fb303::SUM,
             fb303::RATE) {
   }
 
@@ -85,6 +99,13 @@ class FsdbPublisher : public FsdbStreamClient {
   size_t queueCapacity() const {
     return kPubQueueCapacity;
   }
+  // Highest queue size since the last (re)connect
+  ssize_t queueHighWatermark() const {
+    return queueHighWatermark_;
+  }
+  bool hasCoalescedPubUnit() const {
+    return overflow_.lock()->has_value();
+  }
 
  protected:
 #if FOLLY_HAS_COROUTINES
@@ -96,12 +117,25 @@ class FsdbPublisher : public FsdbStreamClient {
 
  private:
   void handleStateChange(State oldState, State newState);
+  void enqueued();
+#if FOLLY_HAS_COROUTINES
+  bool writeOrCoalesce(PipeT& pipe, PubUnit&& pubUnit);
+  void flushOverflow(PipeT& pipe, std::optional<PubUnit>& overflow);
+#endif
 // Note unique_ptr is synchronized, not GenT/PipeT. The latter manages its
 // own synchronization
 #if FOLLY_HAS_COROUTINES
   folly::Synchronized<std::unique_ptr<GenPipeT>> asyncPipe_;
 #endif
   std::atomic<ssize_t> queueSize_{0};
+  std::atomic<ssize_t> queueHighWatermark_{0};
+  // With --fsdb_publisher_coalesce_on_full_queue, pub units written while
+  // the queue is full, merged in to one until the queue has room for it.
+  // Always locked after asyncPipe_.
+  folly::Synchronized<std::optional<PubUnit>, std::mutex> overflow_;
   fb303::ThreadCachedServiceData::TLTimeseries writeErrors_;
+  // pubUnits / coalescedPubUnits is the coalescing ratio
+  fb303::ThreadCachedServiceData::TLTimeseries pubUnits_;
+  fb303::ThreadCachedServiceData::TLTimeseries coalescedPubUnits_;
 };
 } // namespace facebook::fboss::fsdb
@@ -7,4 +7,11 @@ DEFINE_bool(
     false,
     "Publish paths using thrift ids rather than names");
 
+DEFINE_int32(
+    fsdb_sync_min_publish_interval_ms,
+    0,
+    "Minimum interval between publishes of a sync manager. Updates made "
+    "within the interval are merged in to a single delta or patch published "
+    "once it elapses. 0 to publish every update");
+
 namespace facebook::fboss::fsdb {} // namespace facebook::fboss::fsdb
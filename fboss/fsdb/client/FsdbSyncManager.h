@@ -11,11 +11,14 @@
 #include "fboss/fsdb/client/FsdbStreamClient.h"
 #include "fboss/thrift_cow/storage/CowStorageMgr.h"
 
+#include <folly/io/async/AsyncTimeout.h>
 #include <folly/io/async/EventBase.h>
 #include <atomic>
+#include <chrono>
 #include <memory>
 
 DECLARE_bool(publish_use_id_paths);
+DECLARE_int32(fsdb_sync_min_publish_interval_ms);
 
 namespace facebook::fboss::fsdb {
 
@@ -125,6 +128,8 @@ class FsdbSyncManager {
     storage_.getEventBase()->runInEventBaseThreadAndWait(
         [this, gracefulStop]() {
           readyForPublishing_.store(false);
+          publishTimer_.reset();
+          unpublishedFrom_.reset();
           stopInternal(gracefulStop);
         });
   }
@@ -150,18 +155,60 @@ class FsdbSyncManager {
       const std::shared_ptr<CowState>& oldState,
       const std::shared_ptr<CowState>& newState) {
     // TODO: hold lock here to sync with stop()?
-    if (readyForPublishing_.load()) {
-      switch (pubType_) {
-        case PubSubType::DELTA:
-          publishDelta(oldState, newState);
-          break;
-        case PubSubType::PATH:
-          publishPath(newState);
-          break;
-        case PubSubType::PATCH:
-          publishPatch(oldState, newState);
-          break;
-      }
+    if (!readyForPublishing_.load()) {
+      return;
+    }
+    if (FLAGS_fsdb_sync_min_publish_interval_ms <= 0) {
+      publishChange(oldState, newState);
+      return;
+    }
+    if (unpublishedFrom_) {
+      // Already waiting for the interval to elapse, this update goes out
+      // with the pending ones
+      return;
+    }
+    auto interval =
+        std::chrono::milliseconds(FLAGS_fsdb_sync_min_publish_interval_ms);
+    auto sinceLastPublish = std::chrono::steady_clock::now() - lastPublished_;
+    if (sinceLastPublish >= interval) {
+      publishChange(oldState, newState);
+      lastPublished_ = std::chrono::steady_clock::now();
+      return;
+    }
+    unpublishedFrom_ = oldState;
+    if (!publishTimer_) {
+      publishTimer_ = folly::AsyncTimeout::make(
+          *storage_.getEventBase(), [this]() noexcept { publishPending(); });
+    }
+    publishTimer_->scheduleTimeout(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            interval - sinceLastPublish));
+  }
+
+  // Publish all updates since unpublishedFrom_ as one delta or patch
+  void publishPending() {
+    auto oldState = std::move(unpublishedFrom_);
+    unpublishedFrom_.reset();
+    if (!oldState || !readyForPublishing_.load()) {
+      return;
+    }
+    publishChange(oldState, storage_.getState());
+    lastPublished_ = std::chrono::steady_clock::now();
+  }
+
+  void publishChange(
+      const std::shared_ptr<CowState>& oldState,
+      const std::shared_ptr<CowState>& newState) {
+    switch (pubType_) {
+      case PubSubType::DELTA:
+        publishDelta(oldState, newState);
+        break;
+      case PubSubType::PATH:
+        publishPath(newState);
+        break;
+      case PubSubType::PATCH:
+        publishPatch(oldState, newState);
+        break;
     }
   }
 
@@ -181,6 +228,12 @@ class FsdbSyncManager {
 
   void doInitialSync() {
     CHECK(storage_.getEventBase()->isInEventBaseThread());
+    // The initial sync covers any updates still waiting to be published
+    if (publishTimer_) {
+      publishTimer_->cancelTimeout();
+    }
+    unpublishedFrom_.reset();
+    lastPublished_ = std::chrono::steady_clock::now();
     const auto currentState = storage_.getState();
     switch (pubType_) {
       case PubSubType::DELTA:
@@ -287,6 +340,11 @@ class FsdbSyncManager {
   CowStorageManager storage_;
   std::atomic_bool readyForPublishing_ = false;
   bool useIdPaths_ = false;
+  // Throttling of publishes to --fsdb_sync_min_publish_interval_ms, only
+  // accessed on the storage event base
+  std::unique_ptr<folly::AsyncTimeout> publishTimer_;
+  std::shared_ptr<CowState> unpublishedFrom_;
+  std::chrono::steady_clock::time_point lastPublished_;
 };
 
 } // namespace facebook::fboss::fsdb
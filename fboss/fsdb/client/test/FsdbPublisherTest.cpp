@@ -7,10 +7,14 @@
 #include <folly/coro/AsyncGenerator.h>
 #include <folly/coro/AsyncPipe.h>
 #include <folly/io/async/ScopedEventBaseThread.h>
+#include <folly/Synchronized.h>
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <atomic>
+#include <string>
+#include <vector>
 
 namespace facebook::fboss::fsdb::test {
 
@@ -43,6 +47,7 @@ class TestFsdbStreamPublisher : public FsdbPublisher<OperDelta> {
         XLOG(DBG2) << " Detected cancellation";
         break;
       }
+      received_.wlock()->push_back(std::move(*pubUnit));
     }
     co_return;
   }
@@ -53,11 +58,24 @@ class TestFsdbStreamPublisher : public FsdbPublisher<OperDelta> {
   void startGenerator() {
     generatorStart_.post();
   }
+  std::vector<OperDelta> received() const {
+    return received_.copy();
+  }
 
  private:
   folly::Baton<> generatorStart_;
+  folly::Synchronized<std::vector<OperDelta>> received_;
 };
 
+OperDelta makeDelta(int i) {
+  OperDeltaUnit unit;
+  unit.path()->raw() = {"agent", std::to_string(i)};
+  unit.newState() = std::to_string(i);
+  OperDelta delta;
+  delta.changes()->push_back(std::move(unit));
+  return delta;
+}
+
 } // namespace
 class StreamPublisherTest : public ::testing::Test {
  public:
@@ -94,6 +112,9 @@ TEST_F(StreamPublisherTest, overflowQueue) {
     streamPublisher_->write(OperDelta{});
   }
   EXPECT_EQ(streamPublisher_->queueSize(), streamPublisher_->queueCapacity());
+  EXPECT_EQ(
+      streamPublisher_->queueHighWatermark(), streamPublisher_->queueCapacity());
+  EXPECT_FALSE(streamPublisher_->hasCoalescedPubUnit());
 #if FOLLY_HAS_COROUTINES
   // Queue capacity is not precise (~10% slack is typical), try to
   // push 2Xcapacity elements
@@ -126,4 +147,53 @@ TEST_F(StreamPublisherTest, overflowQueue) {
 #endif
 }
 
+TEST_F(StreamPublisherTest, overflowQueueCoalesce) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_fsdb_publisher_coalesce_on_full_queue = true;
+  streamPublisher_->markConnecting();
+  WITH_RETRIES(
+      { EXPECT_EVENTUALLY_TRUE(streamPublisher_->isConnectedToServer()); });
+
+#if FOLLY_HAS_COROUTINES
+  // Fill the queue until a write has to be held back. Queue capacity is not
+  // precise, so go up to 2Xcapacity
+  int written = 0;
+  while (!streamPublisher_->hasCoalescedPubUnit() &&
+         written < 2 * streamPublisher_->queueCapacity()) {
+    EXPECT_TRUE(streamPublisher_->write(makeDelta(written++)));
+  }
+  ASSERT_TRUE(streamPublisher_->hasCoalescedPubUnit());
+  auto enqueued = written - 1;
+  EXPECT_EQ(streamPublisher_->queueSize(), enqueued);
+  EXPECT_EQ(streamPublisher_->queueHighWatermark(), enqueued);
+
+  // Further writes merge in to the held back delta instead of failing
+  constexpr auto kCoalesced = 10;
+  for (auto i = 0; i < kCoalesced; ++i) {
+    EXPECT_TRUE(streamPublisher_->write(makeDelta(written++)));
+  }
+  EXPECT_TRUE(streamPublisher_->hasCoalescedPubUnit());
+  EXPECT_EQ(streamPublisher_->queueSize(), enqueued);
+  EXPECT_TRUE(streamPublisher_->isConnectedToServer());
+
+  // Once the queue drains, the merged delta is published after the rest
+  streamPublisher_->startGenerator();
+  WITH_RETRIES({
+    EXPECT_EVENTUALLY_EQ(streamPublisher_->received().size(), enqueued + 1);
+  });
+  EXPECT_FALSE(streamPublisher_->hasCoalescedPubUnit());
+  auto received = streamPublisher_->received();
+  const auto& merged = received.back();
+  ASSERT_EQ(merged.changes()->size(), kCoalesced + 1);
+  for (auto i = 0; i <= kCoalesced; ++i) {
+    const auto& change = merged.changes()->at(i);
+    EXPECT_EQ(
+        *change.path()->raw(),
+        std::vector<std::string>({"agent", std::to_string(enqueued + i)}));
+    EXPECT_EQ(*change.newState(), std::to_string(enqueued + i));
+  }
+  EXPECT_TRUE(streamPublisher_->isConnectedToServer());
+#endif
+}
+
 } // namespace facebook::fboss::fsdb::test
@@ -0,0 +1,109 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/fsdb/client/FsdbSyncManager.h"
+#include "fboss/fsdb/client/instantiations/FsdbCowStateSubManager.h"
+#include "fboss/fsdb/common/Flags.h"
+#include "fboss/fsdb/if/FsdbModel.h"
+#include "fboss/fsdb/tests/utils/FsdbTestServer.h"
+#include "fboss/lib/CommonUtils.h"
+
+#include <fb303/ServiceData.h>
+#include <fb303/ThreadCachedServiceData.h>
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+namespace facebook::fboss::fsdb::test {
+
+namespace {
+using TestSyncManager = FsdbSyncManager<AgentData>;
+
+void setCommandLineArg(TestSyncManager& syncManager, const std::string& arg) {
+  syncManager.updateState([arg](const auto& in) {
+    auto data = in->toThrift();
+    data.config()->defaultCommandLineArgs()[arg] = arg;
+    auto out = in->clone();
+    out->fromThrift(data);
+    return out;
+  });
+}
+} // namespace
+
+class FsdbSyncManagerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_publish_state_to_fsdb = true;
+    fsdbTestServer_ = std::make_unique<FsdbTestServer>();
+    FLAGS_fsdbPort = fsdbTestServer_->getFsdbPort();
+  }
+
+  void TearDown() override {
+    fsdbTestServer_.reset();
+  }
+
+  bool publisherReady() {
+    return fsdbTestServer_->getPublisherRootMetadata("agent", false)
+        .has_value();
+  }
+
+  int64_t pubUnits() {
+    fb303::ThreadCachedServiceData::get()->publishStats();
+    return fb303::ServiceData::get()->getCounter(
+        "fsdbDeltaStatePublisher_agent.pubUnits.sum.60");
+  }
+
+  std::unique_ptr<FsdbCowStateSubManager> createSubscriber() {
+    auto subscriber = std::make_unique<FsdbCowStateSubManager>(
+        SubscriptionOptions("test", false /* subscribeStats */),
+        ReconnectingThriftClient::ServerOptions(
+            "::1", fsdbTestServer_->getFsdbPort()));
+    subscriber->addPath(root_.agent().config().defaultCommandLineArgs());
+    return subscriber;
+  }
+
+ protected:
+  gflags::FlagSaver flagSaver_;
+  thriftpath::RootThriftPath<FsdbOperStateRoot> root_;
+  std::unique_ptr<FsdbTestServer> fsdbTestServer_;
+};
+
+TEST_F(FsdbSyncManagerTest, coalescePublishesWithinInterval) {
+  FLAGS_fsdb_sync_min_publish_interval_ms = 5000;
+  TestSyncManager syncManager(
+      "agent", {"agent"}, false /* isStats */, PubSubType::DELTA);
+  syncManager.start();
+  WITH_RETRIES(EXPECT_EVENTUALLY_TRUE(publisherReady()));
+  // initial sync
+  WITH_RETRIES(EXPECT_EVENTUALLY_EQ(pubUnits(), 1));
+
+  auto subscriber = createSubscriber();
+  auto boundData = subscriber->subscribeBound();
+
+  // Updates made right after the initial sync are held back until the
+  // interval elapses, then published as a single delta
+  for (const auto& arg : {"foo", "bar", "baz"}) {
+    setCommandLineArg(syncManager, arg);
+  }
+  std::map<std::string, std::string> expected = {
+      {"foo", "foo"}, {"bar", "bar"}, {"baz", "baz"}};
+  WITH_RETRIES(EXPECT_EVENTUALLY_EQ(
+      *syncManager.getState()->toThrift().config()->defaultCommandLineArgs(),
+      expected));
+  EXPECT_EQ(pubUnits(), 1);
+
+  WITH_RETRIES({
+    ASSERT_EVENTUALLY_TRUE(*boundData.rlock());
+    EXPECT_EVENTUALLY_EQ(
+        *(*boundData.rlock())
+             ->toThrift()
+             .agent()
+             ->config()
+             ->defaultCommandLineArgs(),
+        expected);
+  });
+  EXPECT_EQ(pubUnits(), 2);
+
+  subscriber.reset();
+  syncManager.stop();
+}
+
+} // namespace facebook::fboss::fsdb::test
@@ -1,14 +1,93 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
 #include "fboss/fsdb/common/Utils.h"
+#include "fboss/thrift_cow/visitors/PatchHelpers.h"
 #include <fmt/format.h>
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
 #include <folly/system/ThreadName.h>
+#include <map>
 #include <sstream>
 
 namespace facebook::fboss::fsdb {
 
+namespace {
+
+bool mergePatchNode(thrift_cow::PatchNode& into, thrift_cow::PatchNode&& from);
+
+template <typename ChildrenT>
+bool mergePatchChildren(ChildrenT& into, ChildrenT&& from) {
+  for (auto& [key, child] : from) {
+    auto itr = into.find(key);
+    if (itr == into.end()) {
+      into.emplace(key, std::move(child));
+    } else if (!mergePatchNode(itr->second, std::move(child))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool mergePatchNode(thrift_cow::PatchNode& into, thrift_cow::PatchNode&& from) {
+  using PatchNode = thrift_cow::PatchNode;
+  if (from.getType() == PatchNode::Type::__EMPTY__) {
+    return true;
+  }
+  if (into.getType() == PatchNode::Type::__EMPTY__ ||
+      from.getType() == PatchNode::Type::del ||
+      from.getType() == PatchNode::Type::val) {
+    // Later full values and deletes override anything patched before
+    into = std::move(from);
+    return true;
+  }
+  if (into.getType() != from.getType()) {
+    // Patching fields of a value set or deleted whole needs the value itself
+    return false;
+  }
+  thrift_cow::decompressPatch(into);
+  thrift_cow::decompressPatch(from);
+  switch (from.getType()) {
+    case PatchNode::Type::struct_node:
+      return mergePatchChildren(
+          *into.mutable_struct_node().children(),
+          std::move(*from.mutable_struct_node().children()));
+    case PatchNode::Type::map_node:
+      return mergePatchChildren(
+          *into.mutable_map_node().children(),
+          std::move(*from.mutable_map_node().children()));
+    case PatchNode::Type::list_node:
+      return mergePatchChildren(
+          *into.mutable_list_node().children(),
+          std::move(*from.mutable_list_node().children()));
+    case PatchNode::Type::set_node:
+      return mergePatchChildren(
+          *into.mutable_set_node().children(),
+          std::move(*from.mutable_set_node().children()));
+    case PatchNode::Type::variant_node: {
+      auto& intoVariant = into.mutable_variant_node();
+      auto& fromVariant = from.mutable_variant_node();
+      if (*intoVariant.id() != *fromVariant.id() ||
+          !intoVariant.child().has_value()) {
+        into = std::move(from);
+        return true;
+      }
+      if (!fromVariant.child().has_value()) {
+        return true;
+      }
+      auto child = *intoVariant.child();
+      if (!mergePatchNode(child, std::move(*fromVariant.child()))) {
+        return false;
+      }
+      intoVariant.child() = std::move(child);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
 OperDelta createDelta(std::vector<OperDeltaUnit>&& deltaUnits) {
   OperDelta delta;
   delta.changes() = deltaUnits;
@@ -16,4 +95,46 @@ OperDelta createDelta(std::vector<OperDeltaUnit>&& deltaUnits) {
   return delta;
 }
 
+void mergeDelta(OperDelta& into, OperDelta&& from) {
+  auto& changes = *into.changes();
+  std::map<std::vector<std::string>, size_t> pathToChange;
+  for (size_t i = 0; i < changes.size(); ++i) {
+    pathToChange[*changes[i].path()->raw()] = i;
+  }
+  std::vector<bool> replaced(changes.size(), false);
+  for (auto& unit : *from.changes()) {
+    auto itr = pathToChange.find(*unit.path()->raw());
+    if (itr != pathToChange.end() && itr->second < replaced.size()) {
+      unit.oldState().move_from(changes[itr->second].oldState());
+      replaced[itr->second] = true;
+    }
+    pathToChange[*unit.path()->raw()] = changes.size();
+    changes.emplace_back(std::move(unit));
+  }
+  size_t kept = 0;
+  for (size_t i = 0; i < changes.size(); ++i) {
+    if (i < replaced.size() && replaced[i]) {
+      continue;
+    }
+    if (kept != i) {
+      changes[kept] = std::move(changes[i]);
+    }
+    ++kept;
+  }
+  changes.resize(kept);
+  into.metadata().move_from(from.metadata());
+}
+
+bool mergePatch(Patch& into, Patch&& from) {
+  if (*into.basePath() != *from.basePath() ||
+      *into.protocol() != *from.protocol()) {
+    return false;
+  }
+  if (!mergePatchNode(*into.patch(), std::move(*from.patch()))) {
+    return false;
+  }
+  into.metadata() = std::move(*from.metadata());
+  return true;
+}
+
 } // namespace facebook::fboss::fsdb
@@ -59,6 +59,22 @@ OperDeltaUnit buildOperDeltaUnit(
 
 OperDelta createDelta(std::vector<OperDeltaUnit>&& deltaUnits);
 
+/*
+ * Merge the changes in from in to into, as if they had been sent as one
+ * delta. Changes to a path already in into replace the earlier change,
+ * keeping its old state, so the merged delta does not grow past the number
+ * of distinct paths changed.
+ */
+void mergeDelta(OperDelta& into, OperDelta&& from);
+
+/*
+ * Merge patch from, applied after into, in to into so that applying into
+ * alone has the same effect. Returns false, leaving into in an unspecified
+ * but valid state, if the patches cannot be merged: they have different base
+ * paths, or from patches fields of a node that into sets or deletes whole.
+ */
+bool mergePatch(Patch& into, Patch&& from);
+
 template <typename Node>
 fsdb::OperDelta computeOperDelta(
     const std::shared_ptr<Node>& oldNode,
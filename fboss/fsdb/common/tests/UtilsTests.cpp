@@ -0,0 +1,77 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <fboss/fsdb/common/Utils.h>
+#include <fboss/thrift_cow/visitors/PatchHelpers.h>
+
+#include <folly/io/IOBuf.h>
+#include <gtest/gtest.h>
+
+namespace facebook::fboss::fsdb::test {
+
+namespace {
+thrift_cow::PatchNode makeValPatch(const std::string& val) {
+  thrift_cow::PatchNode node;
+  node.set_val(*folly::IOBuf::copyBuffer(val));
+  return node;
+}
+
+Patch makeStructPatch(std::map<int16_t, thrift_cow::PatchNode> children) {
+  thrift_cow::StructPatch structPatch;
+  structPatch.children() = std::move(children);
+  Patch patch;
+  patch.basePath() = {"test"};
+  patch.patch()->set_struct_node(std::move(structPatch));
+  return patch;
+}
+} // namespace
+
+TEST(MergePatchTests, MergeStructChildren) {
+  auto into =
+      makeStructPatch({{1, makeValPatch("a1")}, {2, makeValPatch("b")}});
+  auto from =
+      makeStructPatch({{1, makeValPatch("a2")}, {3, makeValPatch("c")}});
+  from.metadata()->lastConfirmedAt() = 5;
+  ASSERT_TRUE(mergePatch(into, std::move(from)));
+
+  const auto& children = *into.patch()->get_struct_node().children();
+  ASSERT_EQ(children.size(), 3);
+  EXPECT_EQ(children.at(1).get_val().to<std::string>(), "a2");
+  EXPECT_EQ(children.at(2).get_val().to<std::string>(), "b");
+  EXPECT_EQ(children.at(3).get_val().to<std::string>(), "c");
+  EXPECT_EQ(*into.metadata()->lastConfirmedAt(), 5);
+}
+
+TEST(MergePatchTests, MergeCompressedChildren) {
+  auto into = makeStructPatch({{1, makeValPatch("a1")}});
+  auto from = makeStructPatch({{2, makeValPatch("b")}});
+  thrift_cow::compressPatch(*into.patch());
+  thrift_cow::compressPatch(*from.patch());
+  ASSERT_TRUE(mergePatch(into, std::move(from)));
+  thrift_cow::decompressPatch(*into.patch());
+  EXPECT_EQ(into.patch()->get_struct_node().children()->size(), 2);
+}
+
+TEST(MergePatchTests, ValueReplacesPatch) {
+  auto into = makeStructPatch({{1, makeValPatch("a1")}});
+  Patch from;
+  from.basePath() = {"test"};
+  from.patch() = makeValPatch("whole");
+  ASSERT_TRUE(mergePatch(into, std::move(from)));
+  EXPECT_EQ(into.patch()->get_val().to<std::string>(), "whole");
+}
+
+TEST(MergePatchTests, CannotMerge) {
+  // Different base paths
+  auto into = makeStructPatch({{1, makeValPatch("a1")}});
+  auto from = makeStructPatch({{1, makeValPatch("a2")}});
+  from.basePath() = {"other"};
+  EXPECT_FALSE(mergePatch(into, std::move(from)));
+
+  // Patching fields of a value set whole
+  Patch valPatch;
+  valPatch.basePath() = {"test"};
+  valPatch.patch() = makeValPatch("whole");
+  EXPECT_FALSE(mergePatch(valPatch, makeStructPatch({{1, makeValPatch("a")}})));
+}
+
+} // namespace facebook::fboss::fsdb::test
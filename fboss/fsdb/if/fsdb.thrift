@@ -42,6 +42,12 @@ struct OperSubscriberInfo {
   // Paths for Patch apis
   // TODO: replace path above
   7: optional map<fsdb_oper.SubscriptionKey, fsdb_oper.RawOperPath> paths;
+  // Subscriber queue state, for path and delta subscriptions: updates
+  // waiting to be consumed, updates merged while the subscriber was behind
+  // and heartbeats dropped because its queue was full
+  8: optional i64 queueDepth;
+  9: optional i64 coalescedUpdates;
+  10: optional i64 droppedHeartbeats;
 }
 
 @cpp.Type{template = "folly::F14FastMap"}
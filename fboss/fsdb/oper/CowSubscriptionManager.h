@@ -15,6 +15,7 @@
 #include <fboss/fsdb/oper/CowInitialSyncTraverseHelper.h>
 #include <fboss/fsdb/oper/CowPublishAndAddTraverseHelper.h>
 #include <fboss/fsdb/oper/CowSubscriptionTraverseHelper.h>
+#include <fboss/fsdb/oper/SerializationCache.h>
 #include <fboss/fsdb/oper/SubscriptionManager.h>
 #include <fboss/thrift_cow/storage/CowStorage.h>
 #include <fboss/thrift_cow/visitors/DeltaVisitor.h>
@@ -48,8 +49,12 @@ class OperUnitCache {
       const std::vector<std::string>& path,
       // TODO: use serializable
       const NodeT& oldNode,
-      const NodeT& newNode)
-      : path_(path), oldNode_(oldNode), newNode_(newNode) {}
+      const NodeT& newNode,
+      SerializationCache* serializationCache = nullptr)
+      : path_(path),
+        oldNode_(oldNode),
+        newNode_(newNode),
+        serializationCache_(serializationCache) {}
 
   const OperDeltaUnit& getEncodedDelta(const fsdb::OperProtocol& protocol) {
     switch (protocol) {
@@ -86,7 +91,56 @@ class OperUnitCache {
     throw std::runtime_error("Unsupported protocol");
   }
 
+  /*
+   * Patch subscribers take the new state as an IOBuf. The buffer is built
+   * once per protocol and each caller gets a clone sharing its storage.
+   */
+  std::optional<folly::IOBuf> getEncodedStateBuf(
+      const fsdb::OperProtocol& protocol) {
+    auto& buf = [&]() -> std::optional<folly::IOBuf>& {
+      switch (protocol) {
+        case fsdb::OperProtocol::BINARY:
+          return newStateBufBinary_;
+        case fsdb::OperProtocol::COMPACT:
+          return newStateBufCompact_;
+        case fsdb::OperProtocol::SIMPLE_JSON:
+          return newStateBufJson_;
+      }
+      throw std::runtime_error("Unsupported protocol");
+    }();
+    if (!buf.has_value()) {
+      if (!newNode_) {
+        return std::nullopt;
+      }
+      if (hasEncodedNewState(protocol)) {
+        // a path or delta subscriber already encoded this node
+        const auto& state = getEncodedState(protocol);
+        buf = folly::IOBuf(
+            folly::IOBuf::COPY_BUFFER, state->data(), state->length());
+      } else {
+        // encode straight into the buffer rather than into a string that
+        // would then be copied
+        folly::IOBufQueue queue;
+        newNode_->encodeInto(protocol, queue);
+        buf = queue.moveAsValue();
+      }
+    }
+    return buf->cloneAsValue();
+  }
+
  private:
+  bool hasEncodedNewState(const fsdb::OperProtocol& protocol) const {
+    switch (protocol) {
+      case fsdb::OperProtocol::BINARY:
+        return newStateBinary_.has_value();
+      case fsdb::OperProtocol::COMPACT:
+        return newStateCompact_.has_value();
+      case fsdb::OperProtocol::SIMPLE_JSON:
+        return newStateJson_.has_value();
+    }
+    return false;
+  }
+
   const OperDeltaUnit& getOrBuildDelta(
       std::optional<OperDeltaUnit>& unit,
       const fsdb::OperProtocol& protocol) {
@@ -106,6 +160,12 @@ class OperUnitCache {
       bool newState = true) {
     const auto& node = newState ? newNode_ : oldNode_;
     if (!state.has_value() && node) {
+      if constexpr (is_shared_ptr_v<NodeT>) {
+        if (serializationCache_) {
+          state = serializationCache_->getEncoded(node, protocol);
+          return state;
+        }
+      }
       state = node->encode(protocol);
     }
     return state;
@@ -114,11 +174,14 @@ class OperUnitCache {
   const std::vector<std::string>& path_;
   const NodeT& oldNode_;
   const NodeT& newNode_;
+  SerializationCache* serializationCache_;
   std::optional<OperDeltaUnit> binaryUnit_, compactUnit_, jsonUnit_;
   std::optional<folly::fbstring> newStateBinary_, newStateCompact_,
       newStateJson_;
   std::optional<folly::fbstring> oldStateBinary_, oldStateCompact_,
       oldStateJson_;
+  std::optional<folly::IOBuf> newStateBufBinary_, newStateBufCompact_,
+      newStateBufJson_;
 };
 } // namespace csm_detail
 
@@ -131,6 +194,7 @@ class CowSubscriptionManager
 
   using Base::Base;
   using Base::patchOperProtocol;
+  using Base::addPaths;
   using Base::publishAndAddPaths;
   using Base::serveSubscriptions;
 
@@ -180,7 +244,8 @@ class CowSubscriptionManager
       CHECK(lookup);
       CHECK(node);
       auto oldNode = std::remove_cvref_t<decltype(node)>();
-      csm_detail::OperUnitCache operUnitCache(traverser.path(), oldNode, node);
+      csm_detail::OperUnitCache operUnitCache(
+          traverser.path(), oldNode, node, this->serializationCache());
 
       // TODO: maybe switch to reverse iter to erase is cheaper
       auto& subscriptions = lookup->subscriptions();
@@ -212,12 +277,10 @@ class CowSubscriptionManager
           auto patchSubscription =
               static_cast<PatchSubscription*>(subscription);
           thrift_cow::PatchNode patchNode;
-          // TODO: try to change to a shared holding a IOBuf instead of
-          // copying from an fbstring
-          auto& state =
-              operUnitCache.getEncodedState(subscription->operProtocol());
-          auto buf = folly::IOBuf::copyBuffer(state->data(), state->length());
-          patchNode.set_val(*buf);
+          if (auto buf = operUnitCache.getEncodedStateBuf(
+                  subscription->operProtocol())) {
+            patchNode.set_val(std::move(*buf));
+          }
           patchSubscription->offer(std::move(patchNode));
         }
         store.lookup().add(subscription);
@@ -227,6 +290,8 @@ class CowSubscriptionManager
       }
     };
 
+    // subscriptions may point inside hybrid nodes, the traverse helper
+    // stops the walk wherever there is nothing left to sync
     auto traverser = CowInitialSyncTraverseHelper(&store.initialSyncNeeded());
     thrift_cow::RootRecurseVisitor::visit(
         traverser,
@@ -234,7 +299,8 @@ class CowSubscriptionManager
         thrift_cow::RecurseVisitOptions(
             thrift_cow::RecurseVisitMode::FULL,
             thrift_cow::RecurseVisitOrder::CHILDREN_FIRST,
-            this->useIdPaths_),
+            this->useIdPaths_,
+            true /* hybridNodeDeepTraversal */),
         std::move(processPath));
     if (this->requireResponseOnInitialSync_) {
       for (auto& [_, subscription] : store.subscriptions()) {
@@ -308,6 +374,23 @@ class CowSubscriptionManager
         std::move(processPath));
   }
 
+  void addPaths(SubscriptionStore& store, std::shared_ptr<Root>& root) {
+    // unlike publishAndAddPaths, nodes are left unpublished so the same
+    // root can be traversed by other subscription managers afterwards
+    auto processPath = [](const std::vector<std::string>& /*path*/,
+                          auto&& /*node*/) {};
+
+    CowPublishAndAddTraverseHelper traverser(&store.lookup(), &store);
+    thrift_cow::RootRecurseVisitor::visit(
+        traverser,
+        root,
+        thrift_cow::RecurseVisitOptions(
+            thrift_cow::RecurseVisitMode::UNPUBLISHED,
+            thrift_cow::RecurseVisitOrder::CHILDREN_FIRST,
+            this->useIdPaths_),
+        std::move(processPath));
+  }
+
   void pruneDeletedPaths(
       SubscriptionPathStore* lookup,
       const std::shared_ptr<Root>& oldRoot,
@@ -390,7 +473,8 @@ class CowSubscriptionManager
 
       auto& path = traverser.path();
 
-      csm_detail::OperUnitCache operUnitCache(path, oldNode, newNode);
+      csm_detail::OperUnitCache operUnitCache(
+          path, oldNode, newNode, this->serializationCache());
 
       if (lookup) {
         const auto& exactSubscriptions = lookup->subscriptions();
@@ -398,7 +482,6 @@ class CowSubscriptionManager
           if (relevant->type() == PubSubType::PATH) {
             auto* pathSubscription =
                 static_cast<BasePathSubscription*>(relevant);
-            // TODO: cache encoded state
             servePathEncoded(
                 pathSubscription,
                 operUnitCache,
@@ -455,6 +538,8 @@ class CowSubscriptionManager
     }
     CowSubscriptionTraverseHelper traverser(&store.lookup(), patchBuilder);
     if (oldRoot && newRoot) {
+      // hybrid nodes are only descended into when there are subscriptions
+      // at or below them, otherwise they are served as a single change
       thrift_cow::RootDeltaVisitor::visit(
           traverser,
           oldRoot,
@@ -462,7 +547,8 @@ class CowSubscriptionManager
           thrift_cow::DeltaVisitOptions(
               thrift_cow::DeltaVisitMode::FULL,
               thrift_cow::DeltaVisitOrder::CHILDREN_FIRST,
-              this->useIdPaths_),
+              this->useIdPaths_,
+              true /* hybridNodeDeepTraversal */),
           std::move(processChange));
     } else if (!oldRoot || !newRoot) {
       processChange(
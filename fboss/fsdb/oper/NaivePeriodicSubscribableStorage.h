@@ -9,6 +9,7 @@
 #include <fboss/fsdb/oper/SubscribableStorage.h>
 #include <fboss/thrift_cow/storage/CowStorage.h>
 #include <fboss/thrift_cow/storage/Storage.h>
+#include <fboss/thrift_cow/visitors/VisitorUtils.h>
 
 #include <folly/Expected.h>
 #include <folly/coro/Sleep.h>
@@ -65,11 +66,14 @@ class NaivePeriodicSubscribableStorage
             metricPrefix,
             convertToIDPaths),
         currentState_(std::in_place, initialState),
-        lastPublishedState_(*currentState_.rlock()),
-        subscriptions_(patchOperProtocol_, requireResponseOnInitialSync) {
+        lastPublishedState_(*currentState_.rlock()) {
+    for (size_t shard = 0; shard < numServeShards_; ++shard) {
+      subscriptions_.push_back(std::make_unique<SubscribeManager>(
+          patchOperProtocol_, requireResponseOnInitialSync));
 #ifdef ENABLE_PATCH_APIS
-    subscriptions_.useIdPaths(convertToIDPaths);
+      subscriptions_.back()->useIdPaths(convertToIDPaths);
 #endif
+    }
     auto currentState = currentState_.wlock();
     currentState->publish();
   }
@@ -243,7 +247,18 @@ class NaivePeriodicSubscribableStorage
 
     if (oldRoot != newRoot) {
       // make sure newRoot is fully published before swapping
-      subscriptions_.publishAndAddPaths(newRoot);
+      if (numServeShards_ == 1) {
+        subscriptions_.front()->publishAndAddPaths(newRoot);
+      } else {
+        // every shard needs to see the new paths before anything is
+        // published. Traversing unpublished nodes is not safe to do
+        // concurrently, so shards add paths one at a time and newRoot is
+        // fully published before shards are served in parallel.
+        for (auto& subscriptions : subscriptions_) {
+          subscriptions->addPaths(newRoot);
+        }
+        newRoot->publish();
+      }
     }
 
     *lastState = Storage(*currentState);
@@ -259,7 +274,12 @@ class NaivePeriodicSubscribableStorage
       }
 
       auto [oldRoot, newRoot, metadataServer] = publishCurrentState();
-      subscriptions_.serveSubscriptions(oldRoot, newRoot, metadataServer);
+      forEachServeShard([&](size_t shard) {
+        auto shardStart = std::chrono::steady_clock::now();
+        subscriptions_[shard]->serveSubscriptions(
+            oldRoot, newRoot, metadataServer);
+        exportShardServeMetrics(shard, shardStart);
+      });
 
       exportServeMetrics(start);
 
@@ -270,6 +290,7 @@ class NaivePeriodicSubscribableStorage
   using NaivePeriodicSubscribableStorageBase::getSubscriptions;
   using NaivePeriodicSubscribableStorageBase::numPathStores;
   using NaivePeriodicSubscribableStorageBase::numSubscriptions;
+  using NaivePeriodicSubscribableStorageBase::serializationCacheStats;
   using NaivePeriodicSubscribableStorageBase::setConvertToIDPaths;
 
   /*
@@ -287,22 +308,25 @@ class NaivePeriodicSubscribableStorage
   }
 
  protected:
-  const SubscriptionManagerBase& subMgr() const override {
-    return subscriptions_;
+  const SubscriptionManagerBase& subMgr(size_t shard) const override {
+    return *subscriptions_.at(shard);
   }
 
-  SubscriptionManagerBase& subMgr() override {
-    return subscriptions_;
+  SubscriptionManagerBase& subMgr(size_t shard) override {
+    return *subscriptions_.at(shard);
   }
 
   ConcretePath convertPath(ConcretePath&& path) const override;
 
   ExtPath convertPath(const ExtPath& path) const override;
 
+  std::string rootTokenToId(const std::string& token) const override;
+
   folly::Synchronized<Storage> currentState_;
   folly::Synchronized<Storage> lastPublishedState_;
 
-  SubscribeManager subscriptions_;
+  // one per serve shard
+  std::vector<std::unique_ptr<SubscribeManager>> subscriptions_;
 };
 
 // To avoid compiler inlining these heavy functions and allow for caching
@@ -333,6 +357,19 @@ NaivePeriodicSubscribableStorage<Storage, SubscribeManager>::convertPath(
 #endif
 }
 
+template <typename Storage, typename SubscribeManager>
+std::string
+NaivePeriodicSubscribableStorage<Storage, SubscribeManager>::rootTokenToId(
+    const std::string& token) const {
+  using Members = typename apache::thrift::reflect_struct<RootT>::members;
+  std::string id = token;
+  thrift_cow::visitMember<Members>(token, [&](auto tag) {
+    using member = decltype(fatal::tag_type(tag));
+    id = thrift_cow::getMemberName<member>(true /* useId */);
+  });
+  return id;
+}
+
 template <typename Root>
 using NaivePeriodicSubscribableCowStorage = NaivePeriodicSubscribableStorage<
     CowStorage<Root>,
@@ -4,6 +4,8 @@
 
 #include <fb303/ThreadCachedServiceData.h>
 #include <folly/coro/BlockingWait.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/system/ThreadName.h>
 
 #ifndef IS_OSS
@@ -29,9 +31,32 @@ DEFINE_bool(
     serveHeartbeats,
     false,
     "Whether or not to serve hearbeats in subscription streams");
+DEFINE_int32(
+    storage_serve_shards,
+    1,
+    "Number of shards subscriptions are partitioned in to, by publisher "
+    "root. Shards are served in parallel, each on its own worker thread");
 
 namespace facebook::fboss::fsdb {
 
+namespace {
+// First token of a subscription path, or nullopt if the path is the root
+// itself or starts with a wildcard
+std::optional<std::string> rootToken(const std::vector<std::string>& path) {
+  if (path.empty()) {
+    return std::nullopt;
+  }
+  return path.front();
+}
+
+std::optional<std::string> rootToken(const std::vector<OperPathElem>& path) {
+  if (path.empty() || path.front().getType() != OperPathElem::Type::raw) {
+    return std::nullopt;
+  }
+  return *path.front().raw_ref();
+}
+} // namespace
+
 NaivePeriodicSubscribableStorageBase::NaivePeriodicSubscribableStorageBase(
     std::chrono::milliseconds subscriptionServeInterval,
     std::chrono::milliseconds subscriptionHeartbeatInterval,
@@ -42,9 +67,14 @@ NaivePeriodicSubscribableStorageBase::NaivePeriodicSubscribableStorageBase(
       subscriptionHeartbeatInterval_(subscriptionHeartbeatInterval),
       trackMetadata_(trackMetadata),
       convertSubsToIDPaths_(convertToIDPaths),
+      numServeShards_(std::max(FLAGS_storage_serve_shards, 1)),
       rss_(fmt::format("{}.{}", metricPrefix, kRss)),
       serveSubMs_(fmt::format("{}.{}", metricPrefix, kServeSubMs)),
-      serveSubNum_(fmt::format("{}.{}", metricPrefix, kServeSubNum)) {
+      serveSubNum_(fmt::format("{}.{}", metricPrefix, kServeSubNum)),
+      serializationCacheHits_(
+          fmt::format("{}.{}", metricPrefix, kSerializationCacheHits)),
+      serializationCacheMisses_(
+          fmt::format("{}.{}", metricPrefix, kSerializationCacheMisses)) {
   if (trackMetadata) {
     metadataTracker_ = std::make_unique<FsdbOperTreeMetadataTracker>();
   }
@@ -62,6 +92,19 @@ NaivePeriodicSubscribableStorageBase::NaivePeriodicSubscribableStorageBase(
   fb303::ThreadCachedServiceData::get()->addStatExportType(
       serveSubNum_, fb303::SUM);
 
+  if (numServeShards_ > 1) {
+    serveShardExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        numServeShards_,
+        std::make_shared<folly::NamedThreadFactory>("ServeShard"));
+    // elapsed time to serve each shard, same range as serveSubMs_
+    for (size_t shard = 0; shard < numServeShards_; ++shard) {
+      auto& name = serveShardMs_.emplace_back(
+          fmt::format("{}.{}.{}", metricPrefix, kServeShardMs, shard));
+      fb303::ThreadCachedServiceData::get()->addHistogram(name, 10, 0, 1000);
+      fb303::ThreadCachedServiceData::get()->exportHistogram(name, 50, 95, 99);
+    }
+  }
+
   if (FLAGS_serveHeartbeats) {
     heartbeatThread_ = std::make_unique<folly::ScopedEventBaseThread>(
         "SubscriptionHeartbeats");
@@ -154,9 +197,11 @@ void NaivePeriodicSubscribableStorageBase::unregisterPublisher(
     CHECK(publisherRoot);
     tracker->unregisterPublisherRoot(*publisherRoot);
     if (!tracker->getPublisherRootMetadata(*publisherRoot)) {
-      subMgr().closeNoPublisherActiveSubscriptions(
-          SubscriptionMetadataServer(tracker->getAllMetadata()),
-          disconnectReason);
+      for (size_t shard = 0; shard < numServeShards_; ++shard) {
+        subMgr(shard).closeNoPublisherActiveSubscriptions(
+            SubscriptionMetadataServer(tracker->getAllMetadata()),
+            disconnectReason);
+      }
     }
   });
 }
@@ -186,6 +231,154 @@ void NaivePeriodicSubscribableStorageBase::exportServeMetrics(
   }
   fb303::ThreadCachedServiceData::get()->addStatValue(
       serveSubNum_, 1, fb303::SUM);
+
+  // cumulative counts of encodes shared across subscriptions vs done
+  auto cacheStats = serializationCacheStats();
+  fb303::ThreadCachedServiceData::get()->setCounter(
+      serializationCacheHits_, cacheStats.hits);
+  fb303::ThreadCachedServiceData::get()->setCounter(
+      serializationCacheMisses_, cacheStats.misses);
+}
+
+void NaivePeriodicSubscribableStorageBase::exportShardServeMetrics(
+    size_t shard,
+    std::chrono::steady_clock::time_point serveStartTime) const {
+  if (shard >= serveShardMs_.size()) {
+    return;
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - serveStartTime);
+  if (elapsed.count() > 0) {
+    fb303::ThreadCachedServiceData::get()->addHistogramValue(
+        serveShardMs_[shard], elapsed.count());
+  }
+}
+
+void NaivePeriodicSubscribableStorageBase::forEachServeShard(
+    const std::function<void(size_t)>& fn) {
+  if (!serveShardExecutor_) {
+    fn(0);
+    return;
+  }
+  std::vector<folly::Future<folly::Unit>> shardsDone;
+  shardsDone.reserve(numServeShards_);
+  for (size_t shard = 0; shard < numServeShards_; ++shard) {
+    shardsDone.push_back(folly::via(
+        serveShardExecutor_.get(), [&fn, shard]() { fn(shard); }));
+  }
+  // rethrow the first exception, if any, once all shards are done
+  for (auto& result : folly::collectAll(std::move(shardsDone)).get()) {
+    result.throwUnlessValue();
+  }
+}
+
+size_t NaivePeriodicSubscribableStorageBase::serveShard(
+    const ConcretePath& path) {
+  return serveShard(
+      std::vector<std::optional<std::string>>{rootToken(path)});
+}
+
+size_t NaivePeriodicSubscribableStorageBase::serveShard(
+    const std::vector<ExtendedOperPath>& paths) {
+  std::vector<std::optional<std::string>> rootTokens;
+  rootTokens.reserve(paths.size());
+  for (const auto& path : paths) {
+    rootTokens.emplace_back(rootToken(*path.path()));
+  }
+  return serveShard(rootTokens);
+}
+
+size_t NaivePeriodicSubscribableStorageBase::serveShard(
+    const std::map<SubscriptionKey, RawOperPath>& paths) {
+  std::vector<std::optional<std::string>> rootTokens;
+  rootTokens.reserve(paths.size());
+  for (const auto& [_, path] : paths) {
+    rootTokens.emplace_back(rootToken(*path.path()));
+  }
+  return serveShard(rootTokens);
+}
+
+size_t NaivePeriodicSubscribableStorageBase::serveShard(
+    const std::map<SubscriptionKey, ExtendedOperPath>& paths) {
+  std::vector<std::optional<std::string>> rootTokens;
+  rootTokens.reserve(paths.size());
+  for (const auto& [_, path] : paths) {
+    rootTokens.emplace_back(rootToken(*path.path()));
+  }
+  return serveShard(rootTokens);
+}
+
+size_t NaivePeriodicSubscribableStorageBase::serveShard(
+    const std::vector<std::optional<std::string>>& rootTokens) {
+  std::optional<std::string> rootId;
+  for (const auto& token : rootTokens) {
+    if (!token) {
+      return kRootServeShard;
+    }
+    auto tokenId = rootTokenToId(*token);
+    if (rootId && *rootId != tokenId) {
+      return kRootServeShard;
+    }
+    rootId = std::move(tokenId);
+  }
+  if (!rootId) {
+    return kRootServeShard;
+  }
+  auto rootTokenToShard = rootTokenToShard_.wlock();
+  auto itr = rootTokenToShard->find(*rootId);
+  if (itr == rootTokenToShard->end()) {
+    auto shard = rootTokenToShard->size() % numServeShards_;
+    itr = rootTokenToShard->emplace(*rootId, shard).first;
+  }
+  return itr->second;
+}
+
+size_t NaivePeriodicSubscribableStorageBase::numSubscriptions() const {
+  size_t numSubscriptions{0};
+  for (size_t shard = 0; shard < numServeShards_; ++shard) {
+    numSubscriptions += subMgr(shard).numSubscriptions();
+  }
+  return numSubscriptions;
+}
+
+std::vector<OperSubscriberInfo>
+NaivePeriodicSubscribableStorageBase::getSubscriptions() const {
+  std::vector<OperSubscriberInfo> subscriptions;
+  for (size_t shard = 0; shard < numServeShards_; ++shard) {
+    auto shardSubscriptions = subMgr(shard).getSubscriptions();
+    subscriptions.insert(
+        subscriptions.end(),
+        std::make_move_iterator(shardSubscriptions.begin()),
+        std::make_move_iterator(shardSubscriptions.end()));
+  }
+  return subscriptions;
+}
+
+size_t NaivePeriodicSubscribableStorageBase::numPathStores() const {
+  size_t numPathStores{0};
+  for (size_t shard = 0; shard < numServeShards_; ++shard) {
+    numPathStores += subMgr(shard).numPathStores();
+  }
+  return numPathStores;
+}
+
+SerializationCache::Stats
+NaivePeriodicSubscribableStorageBase::serializationCacheStats() const {
+  SerializationCache::Stats stats;
+  for (size_t shard = 0; shard < numServeShards_; ++shard) {
+    auto shardStats = subMgr(shard).serializationCacheStats();
+    stats.hits += shardStats.hits;
+    stats.misses += shardStats.misses;
+  }
+  return stats;
+}
+
+void NaivePeriodicSubscribableStorageBase::setConvertToIDPaths(
+    bool convertToIDPaths) {
+  convertSubsToIDPaths_ = convertToIDPaths;
+  for (size_t shard = 0; shard < numServeShards_; ++shard) {
+    subMgr(shard).useIdPaths(convertToIDPaths);
+  }
 }
 
 std::optional<std::string>
@@ -283,7 +476,7 @@ NaivePeriodicSubscribableStorageBase::subscribe_encoded_impl(
       getPublisherRoot(path.begin(), path.end()),
       heartbeatThread_ ? heartbeatThread_->getEventBase() : nullptr,
       subscriptionHeartbeatInterval_);
-  subMgr().registerSubscription(std::move(subscription));
+  subMgrFor(path).registerSubscription(std::move(subscription));
   return std::move(gen);
 }
 
@@ -302,7 +495,7 @@ NaivePeriodicSubscribableStorageBase::subscribe_delta_impl(
       getPublisherRoot(path.begin(), path.end()),
       heartbeatThread_ ? heartbeatThread_->getEventBase() : nullptr,
       subscriptionHeartbeatInterval_);
-  subMgr().registerSubscription(std::move(subscription));
+  subMgrFor(path).registerSubscription(std::move(subscription));
   return std::move(gen);
 }
 
@@ -320,7 +513,7 @@ NaivePeriodicSubscribableStorageBase::subscribe_encoded_extended_impl(
       protocol,
       heartbeatThread_ ? heartbeatThread_->getEventBase() : nullptr,
       subscriptionHeartbeatInterval_);
-  subMgr().registerExtendedSubscription(std::move(subscription));
+  subMgrFor(paths).registerExtendedSubscription(std::move(subscription));
   return std::move(gen);
 }
 
@@ -338,7 +531,7 @@ NaivePeriodicSubscribableStorageBase::subscribe_delta_extended_impl(
       protocol,
       heartbeatThread_ ? heartbeatThread_->getEventBase() : nullptr,
       subscriptionHeartbeatInterval_);
-  subMgr().registerExtendedSubscription(std::move(subscription));
+  subMgrFor(paths).registerExtendedSubscription(std::move(subscription));
   return std::move(gen);
 }
 
@@ -10,18 +10,26 @@
 #include "fboss/thrift_cow/gen-cpp2/patch_types.h"
 
 #include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
 #include <folly/coro/AsyncScope.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/ScopedEventBaseThread.h>
 
 DECLARE_int32(storage_thread_heartbeat_ms);
 DECLARE_bool(serveHeartbeats);
+DECLARE_int32(storage_serve_shards);
 
 namespace facebook::fboss::fsdb {
 
 inline constexpr std::string_view kServeSubMs{"storage.serve_sub_ms"};
 inline constexpr std::string_view kServeSubNum{"storage.serve_sub_num"};
+inline constexpr std::string_view kServeShardMs{"storage.serve_shard_ms"};
 inline constexpr std::string_view kRss{"rss"};
+inline constexpr std::string_view kSerializationCacheHits{
+    "storage.serialization_cache_hits"};
+inline constexpr std::string_view kSerializationCacheMisses{
+    "storage.serialization_cache_misses"};
 
 // non-templated parts of NaivePeriodicSubscribableStorage to help with
 // compilation
@@ -125,7 +133,7 @@ class NaivePeriodicSubscribableStorageBase {
         std::move(root),
         heartbeatThread_ ? heartbeatThread_->getEventBase() : nullptr,
         subscriptionHeartbeatInterval_);
-    subMgr().registerExtendedSubscription(std::move(subscription));
+    subMgrFor(rawPaths).registerExtendedSubscription(std::move(subscription));
     return std::move(gen);
   }
 
@@ -145,36 +153,63 @@ class NaivePeriodicSubscribableStorageBase {
         std::move(root),
         heartbeatThread_ ? heartbeatThread_->getEventBase() : nullptr,
         subscriptionHeartbeatInterval_);
-    subMgr().registerExtendedSubscription(std::move(subscription));
+    subMgrFor(paths).registerExtendedSubscription(std::move(subscription));
     return std::move(gen);
   }
 #endif
 
-  size_t numSubscriptions() const {
-    return subMgr().numSubscriptions();
-  }
-  std::vector<OperSubscriberInfo> getSubscriptions() const {
-    return subMgr().getSubscriptions();
-  }
-  size_t numPathStores() const {
-    return subMgr().numPathStores();
-  }
+  size_t numSubscriptions() const;
+  std::vector<OperSubscriberInfo> getSubscriptions() const;
+  size_t numPathStores() const;
+  SerializationCache::Stats serializationCacheStats() const;
 
-  void setConvertToIDPaths(bool convertToIDPaths) {
-    convertSubsToIDPaths_ = convertToIDPaths;
-    subMgr().useIdPaths(convertToIDPaths);
+  void setConvertToIDPaths(bool convertToIDPaths);
+
+  size_t numServeShards() const {
+    return numServeShards_;
   }
 
  protected:
   virtual folly::coro::Task<void> serveSubscriptions() = 0;
   virtual ConcretePath convertPath(ConcretePath&& path) const = 0;
   virtual ExtPath convertPath(const ExtPath& path) const = 0;
-  virtual const SubscriptionManagerBase& subMgr() const = 0;
-  virtual SubscriptionManagerBase& subMgr() = 0;
+  // Subscriptions are split over numServeShards() subscription managers,
+  // each with its own SubscriptionStore, that are served in parallel.
+  virtual const SubscriptionManagerBase& subMgr(size_t shard) const = 0;
+  virtual SubscriptionManagerBase& subMgr(size_t shard) = 0;
+
+  // Id form of a top level member of the root, e.g. "agent" -> "1". Tokens
+  // that are not members of the root are returned unchanged.
+  virtual std::string rootTokenToId(const std::string& token) const = 0;
+
+  /*
+   * Subscription manager to register a new subscription to. Subscriptions
+   * are partitioned by the top level member of the root they are under,
+   * with members assigned to shards round robin as they are first subscribed
+   * to. Name and id forms of a member map to the same shard. Subscriptions
+   * to the root itself, to paths starting with a wildcard, or spanning more
+   * than one member are always served from kRootServeShard.
+   */
+  template <typename Paths>
+  SubscriptionManagerBase& subMgrFor(const Paths& paths) {
+    if (numServeShards_ == 1) {
+      return subMgr(0);
+    }
+    return subMgr(serveShard(paths));
+  }
+
+  /*
+   * Run fn(shard) for every serve shard, in parallel on the shard worker
+   * pool when sharded. Returns once all shards are done.
+   */
+  void forEachServeShard(const std::function<void(size_t)>& fn);
 
   SubscriptionMetadataServer getCurrentMetadataServer();
   void exportServeMetrics(
       std::chrono::steady_clock::time_point serveStartTime) const;
+  void exportShardServeMetrics(
+      size_t shard,
+      std::chrono::steady_clock::time_point serveStartTime) const;
 
   std::optional<std::string> getPublisherRoot(PathIter begin, PathIter end)
       const;
@@ -213,7 +248,17 @@ class NaivePeriodicSubscribableStorageBase {
   // instead of letting the client choose
   const OperProtocol patchOperProtocol_{OperProtocol::COMPACT};
 
+  const size_t numServeShards_{1};
+
  private:
+  static constexpr size_t kRootServeShard = 0;
+
+  size_t serveShard(const ConcretePath& path);
+  size_t serveShard(const std::vector<ExtendedOperPath>& paths);
+  size_t serveShard(const std::map<SubscriptionKey, RawOperPath>& paths);
+  size_t serveShard(const std::map<SubscriptionKey, ExtendedOperPath>& paths);
+  size_t serveShard(const std::vector<std::optional<std::string>>& rootTokens);
+
   folly::coro::CancellableAsyncScope backgroundScope_;
   std::unique_ptr<std::thread> subscriptionServingThread_;
   folly::EventBase evb_;
@@ -221,10 +266,19 @@ class NaivePeriodicSubscribableStorageBase {
 
   std::shared_ptr<ThreadHeartbeat> threadHeartbeat_;
 
+  // only created when serving is sharded
+  std::unique_ptr<folly::CPUThreadPoolExecutor> serveShardExecutor_;
+  // keyed by id form of the top level member
+  folly::Synchronized<folly::F14FastMap<std::string, size_t>>
+      rootTokenToShard_;
+
   // metric names
   const std::string rss_{""};
   const std::string serveSubMs_{""};
   const std::string serveSubNum_{""};
+  const std::string serializationCacheHits_{""};
+  const std::string serializationCacheMisses_{""};
+  std::vector<std::string> serveShardMs_;
 
   // delete copy constructors
   NaivePeriodicSubscribableStorageBase(
@@ -0,0 +1,105 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
+
+#include <folly/FBString.h>
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace facebook::fboss::fsdb {
+
+/*
+ * Encoded node state, keyed by (node, protocol), shared by all
+ * subscriptions served in a serve cycle.
+ *
+ * Published cow nodes are immutable, so a node's encoding stays valid for
+ * as long as the node is alive. Entries hold a reference to their node so
+ * its address can't be reused by a different node while cached.
+ *
+ * Entries are kept for one extra serve cycle: a node that was encoded as
+ * the new state in one cycle is usually the old state of the next change
+ * to the same path, and can be served from here instead of being encoded
+ * again. Anything not looked up for a whole cycle is dropped.
+ *
+ * Not thread safe, SubscriptionManager only accesses it with the
+ * subscription store locked.
+ */
+class SerializationCache {
+ public:
+  struct Stats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+  };
+
+  template <typename NodeT>
+  const folly::fbstring& getEncoded(
+      const std::shared_ptr<NodeT>& node,
+      OperProtocol protocol) {
+    Key key{node.get(), protocol};
+    if (auto itr = current_.find(key); itr != current_.end()) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return itr->second.encoded;
+    }
+    if (auto itr = previous_.find(key); itr != previous_.end()) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      auto& entry =
+          current_.emplace(key, std::move(itr->second)).first->second;
+      previous_.erase(itr);
+      return entry.encoded;
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    auto& entry =
+        current_.emplace(key, Entry{node, node->encode(protocol)}).first->second;
+    return entry.encoded;
+  }
+
+  // Called at the start of every serve cycle with changes to serve
+  void startCycle() {
+    previous_ = std::move(current_);
+    current_.clear();
+  }
+
+  void clear() {
+    previous_.clear();
+    current_.clear();
+  }
+
+  size_t size() const {
+    return current_.size() + previous_.size();
+  }
+
+  Stats stats() const {
+    return Stats{
+        hits_.load(std::memory_order_relaxed),
+        misses_.load(std::memory_order_relaxed)};
+  }
+
+ private:
+  using Key = std::pair<const void*, OperProtocol>;
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      return folly::hash::hash_combine(
+          key.first, static_cast<int>(key.second));
+    }
+  };
+  struct Entry {
+    std::shared_ptr<const void> node;
+    folly::fbstring encoded;
+  };
+  // node map so references handed out stay valid as the cache grows
+  using EntryMap = folly::F14NodeMap<Key, Entry, KeyHash>;
+
+  EntryMap current_;
+  EntryMap previous_;
+  // read by stats export outside of the store lock
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace facebook::fboss::fsdb
@@ -5,8 +5,16 @@
 #include <boost/core/noncopyable.hpp>
 #include <folly/coro/BlockingWait.h>
 #include <folly/coro/Sleep.h>
+#include <map>
 #include <optional>
 
+DEFINE_int32(
+    subscriptionQueueMaxDepth,
+    1000,
+    "Max number of updates queued to a path or delta subscriber. Once "
+    "reached, further updates are coalesced until the subscriber catches "
+    "up. 0 for unbounded queues");
+
 namespace facebook::fboss::fsdb {
 
 namespace {
@@ -88,6 +96,46 @@ std::optional<OperDelta> BaseDeltaSubscription::moveFromCurrDelta(
   return toServe;
 }
 
+void PathSubscription::offer(DeltaValue<OperState> newVal) {
+  if (!pending_ && !queueFull()) {
+    queued();
+    pipe_.write(std::move(newVal));
+    return;
+  }
+  // Subscriber is behind, only keep the latest value. The old value stays
+  // what the subscriber last saw.
+  if (pending_) {
+    pending_->newVal = std::move(newVal.newVal);
+    coalesced();
+  } else {
+    pending_ = std::move(newVal);
+  }
+}
+
+void PathSubscription::flush(
+    const SubscriptionMetadataServer& /*metadataServer*/) {
+  // values are written directly to the pipe in offer, unless the queue
+  // was full
+  if (pending_ && !queueFull()) {
+    queued();
+    pipe_.write(std::move(*pending_));
+    pending_.reset();
+  }
+}
+
+void PathSubscription::serveHeartbeat() {
+  if (queueFull()) {
+    dropped();
+    return;
+  }
+  value_type t;
+  t.newVal = OperState();
+  // need to explicitly set a flag for OperState else it looks like a deletion
+  t.newVal->isHeartbeat() = true;
+  queued();
+  pipe_.write(std::move(t));
+}
+
 std::pair<
     folly::coro::AsyncGenerator<OperDelta&&>,
     std::unique_ptr<DeltaSubscription>>
@@ -109,18 +157,34 @@ DeltaSubscription::create(
       std::move(publisherRoot),
       std::move(heartbeatEvb),
       std::move(heartbeatInterval));
-  return std::make_pair(std::move(generator), std::move(subscription));
+  auto trackedGenerator = subscription->trackQueueDepth(std::move(generator));
+  return std::make_pair(std::move(trackedGenerator), std::move(subscription));
 }
 
 void DeltaSubscription::flush(
     const SubscriptionMetadataServer& metadataServer) {
-  auto delta = moveFromCurrDelta(metadataServer);
-  if (delta) {
-    pipe_.write(*delta);
+  if (auto delta = moveFromCurrDelta(metadataServer)) {
+    if (pending_) {
+      // Subscriber is behind, fold this delta in to the one still waiting
+      mergeDelta(*pending_, std::move(*delta));
+      coalesced();
+    } else {
+      pending_ = std::move(delta);
+    }
+  }
+  if (pending_ && !queueFull()) {
+    queued();
+    pipe_.write(std::move(*pending_));
+    pending_.reset();
   }
 }
 
 void DeltaSubscription::serveHeartbeat() {
+  if (queueFull()) {
+    dropped();
+    return;
+  }
+  queued();
   pipe_.write(OperDelta());
 }
 
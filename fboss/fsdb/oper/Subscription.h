@@ -11,10 +11,17 @@
 #include "fboss/thrift_cow/gen-cpp2/patch_types.h"
 
 #include <boost/core/noncopyable.hpp>
+#include <folly/coro/AsyncGenerator.h>
 #include <folly/coro/AsyncPipe.h>
 #include <folly/coro/AsyncScope.h>
+#include <folly/coro/Invoke.h>
 #include <folly/io/async/EventBase.h>
 #include <folly/json/dynamic.h>
+#include <gflags/gflags.h>
+
+#include <atomic>
+
+DECLARE_int32(subscriptionQueueMaxDepth);
 
 namespace facebook::fboss::fsdb {
 
@@ -73,6 +80,22 @@ class BaseSubscription {
     return heartbeatInterval_;
   }
 
+  struct QueueStats {
+    // updates written to the subscriber but not yet consumed
+    int64_t depth{0};
+    // updates merged in to an update still waiting for queue space
+    int64_t coalesced{0};
+    // heartbeats not sent because the queue was full
+    int64_t dropped{0};
+  };
+
+  QueueStats queueStats() const {
+    return QueueStats{
+        queueDepth_->load(std::memory_order_relaxed),
+        coalesced_.load(std::memory_order_relaxed),
+        dropped_.load(std::memory_order_relaxed)};
+  }
+
  protected:
   BaseSubscription(
       SubscriberId subscriber,
@@ -81,6 +104,43 @@ class BaseSubscription {
       folly::EventBase* heartbeatEvb,
       std::chrono::milliseconds heartbeatInterval);
 
+  /*
+   * Helpers for subscriptions that bound the number of updates queued to
+   * the subscriber. The generator handed to the subscriber must be wrapped
+   * with trackQueueDepth, and every write to the pipe must be accounted for
+   * with queued().
+   */
+  template <typename T>
+  folly::coro::AsyncGenerator<T&&> trackQueueDepth(
+      folly::coro::AsyncGenerator<T&&> gen) {
+    return folly::coro::co_invoke(
+        [gen = std::move(gen),
+         depth = queueDepth_]() mutable -> folly::coro::AsyncGenerator<T&&> {
+          while (auto item = co_await gen.next()) {
+            depth->fetch_sub(1, std::memory_order_relaxed);
+            co_yield std::move(*item);
+          }
+        });
+  }
+
+  bool queueFull() const {
+    return FLAGS_subscriptionQueueMaxDepth > 0 &&
+        queueDepth_->load(std::memory_order_relaxed) >=
+        FLAGS_subscriptionQueueMaxDepth;
+  }
+
+  void queued() {
+    queueDepth_->fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void coalesced() {
+    coalesced_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void dropped() {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+
  private:
   folly::coro::Task<void> heartbeatLoop();
 
@@ -90,6 +150,12 @@ class BaseSubscription {
   folly::EventBase* heartbeatEvb_;
   folly::coro::CancellableAsyncScope backgroundScope_;
   std::chrono::milliseconds heartbeatInterval_;
+  // shared with the generator returned to the subscriber, which may
+  // outlive the subscription
+  std::shared_ptr<std::atomic<int64_t>> queueDepth_{
+      std::make_shared<std::atomic<int64_t>>(0)};
+  std::atomic<int64_t> coalesced_{0};
+  std::atomic<int64_t> dropped_{0};
 };
 
 class Subscription : public BaseSubscription {
@@ -200,10 +266,7 @@ class PathSubscription : public BasePathSubscription,
   virtual ~PathSubscription() override = default;
   using PathIter = std::vector<std::string>::const_iterator;
 
-  void offer(DeltaValue<OperState> newVal) override {
-    // use bounded pipe?
-    pipe_.write(std::move(newVal));
-  }
+  void offer(DeltaValue<OperState> newVal) override;
 
   bool isActive() const override {
     return !pipe_.isClosed();
@@ -230,7 +293,10 @@ class PathSubscription : public BasePathSubscription,
         std::move(publisherRoot),
         std::move(heartbeatEvb),
         std::move(heartbeatInterval));
-    return std::make_pair(std::move(generator), std::move(subscription));
+    auto trackedGenerator =
+        subscription->trackQueueDepth(std::move(generator));
+    return std::make_pair(
+        std::move(trackedGenerator), std::move(subscription));
   }
 
   bool shouldConvertToDynamic() const override {
@@ -242,17 +308,9 @@ class PathSubscription : public BasePathSubscription,
     pipe_.write(Utils::createFsdbException(disconnectReason, msg));
   }
 
-  void flush(const SubscriptionMetadataServer& /*metadataServer*/) override {
-    // no-op, we write directly to the pipe in offer
-  }
+  void flush(const SubscriptionMetadataServer& metadataServer) override;
 
-  void serveHeartbeat() override {
-    value_type t;
-    t.newVal = OperState();
-    // need to explicitly set a flag for OperState else it looks like a deletion
-    t.newVal->isHeartbeat() = true;
-    pipe_.write(std::move(t));
-  }
+  void serveHeartbeat() override;
 
   PathSubscription(
       SubscriberId subscriber,
@@ -273,6 +331,8 @@ class PathSubscription : public BasePathSubscription,
 
  private:
   folly::coro::AsyncPipe<value_type> pipe_;
+  // latest value not yet written because the subscriber's queue was full
+  std::optional<value_type> pending_;
 };
 
 class BaseDeltaSubscription : public Subscription {
@@ -356,6 +416,8 @@ class DeltaSubscription : public BaseDeltaSubscription,
 
  private:
   folly::coro::AsyncPipe<OperDelta> pipe_;
+  // changes not yet written because the subscriber's queue was full
+  std::optional<OperDelta> pending_;
 };
 
 class ExtendedPathSubscription;
@@ -6,6 +6,11 @@
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
 
+DEFINE_bool(
+    serveSerializationCache,
+    true,
+    "Share encoded node state across subscriptions and serve cycles");
+
 namespace facebook::fboss::fsdb {
 
 void SubscriptionManagerBase::registerExtendedSubscription(
@@ -49,6 +54,10 @@ std::vector<OperSubscriberInfo> SubscriptionManagerBase::getSubscriptions()
     OperPath p;
     p.raw() = subscription->path();
     info.path() = std::move(p);
+    auto queueStats = subscription->queueStats();
+    info.queueDepth() = queueStats.depth;
+    info.coalescedUpdates() = queueStats.coalesced;
+    info.droppedHeartbeats() = queueStats.dropped;
     toRet.push_back(std::move(info));
   }
   return toRet;
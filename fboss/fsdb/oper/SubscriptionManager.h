@@ -5,13 +5,17 @@
 #include "fboss/fsdb/if/gen-cpp2/fsdb_common_types.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_types.h"
+#include "fboss/fsdb/oper/SerializationCache.h"
 #include "fboss/fsdb/oper/Subscription.h"
 #include "fboss/fsdb/oper/SubscriptionStore.h"
 
 #include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
 #include <string>
 #include <vector>
 
+DECLARE_bool(serveSerializationCache);
+
 namespace facebook::fboss::fsdb {
 
 class SubscriptionMetadataServer;
@@ -59,6 +63,10 @@ class SubscriptionManagerBase {
     return patchOperProtocol_;
   }
 
+  SerializationCache::Stats serializationCacheStats() const {
+    return serializationCache_.stats();
+  }
+
  private:
   void registerSubscription(
       std::string name,
@@ -71,7 +79,14 @@ class SubscriptionManagerBase {
  protected:
   void registerPendingSubscriptions(SubscriptionStore& store);
 
+  // Shared encoding cache for the current serve cycle, nullptr if disabled.
+  // Only to be used with store_ locked.
+  SerializationCache* serializationCache() {
+    return FLAGS_serveSerializationCache ? &serializationCache_ : nullptr;
+  }
+
   folly::Synchronized<SubscriptionStore> store_;
+  SerializationCache serializationCache_;
 
   bool useIdPaths_{false};
 
@@ -99,6 +114,14 @@ class SubscriptionManager : public SubscriptionManagerBase {
     static_cast<Impl*>(this)->publishAndAddPaths(*store, root);
   }
 
+  // Same as publishAndAddPaths, but leaves publishing root to the caller.
+  // Lets several subscription managers add paths from the same root before
+  // it is published.
+  void addPaths(std::shared_ptr<Root>& root) {
+    auto store = store_.wlock();
+    static_cast<Impl*>(this)->addPaths(*store, root);
+  }
+
   void serveSubscriptions(
       const std::shared_ptr<Root>& oldRoot,
       const std::shared_ptr<Root>& newRoot,
@@ -110,6 +133,12 @@ class SubscriptionManager : public SubscriptionManagerBase {
 
     store->pruneCancelledSubscriptions();
 
+    if (!FLAGS_serveSerializationCache) {
+      serializationCache_.clear();
+    } else if (oldRoot != newRoot) {
+      // only age out entries on cycles that have changes to serve
+      serializationCache_.startCycle();
+    }
     if (oldRoot != newRoot) {
       try {
         impl->serveSubscriptions(*store, oldRoot, newRoot, metadataServer);
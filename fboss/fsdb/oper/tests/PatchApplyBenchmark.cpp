@@ -0,0 +1,159 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/io/IOBufQueue.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/gen-cpp2/agent_stats_fatal_types.h"
+#include "fboss/agent/gen-cpp2/agent_stats_types.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
+#include "fboss/thrift_cow/nodes/Types.h"
+#include "fboss/thrift_cow/visitors/PatchApplier.h"
+
+DEFINE_int32(num_ports, 512, "Number of ports in the patched stats");
+DEFINE_int32(
+    frame_size,
+    4096,
+    "Size of each buffer in the chain, mimicking thrift stream frames");
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::thrift_cow;
+
+namespace {
+
+constexpr auto kProtocol = fsdb::OperProtocol::COMPACT;
+
+using PortStatsMap =
+    folly::remove_cvref_t<decltype(*std::declval<AgentStats&>().hwPortStats())>;
+using PortStatsMapTC = apache::thrift::type_class::map<
+    apache::thrift::type_class::string,
+    apache::thrift::type_class::structure>;
+using PortStatsMapNode =
+    ThriftMapNode<ThriftMapTraits<PortStatsMapTC, PortStatsMap>>;
+
+PortStatsMap buildPortStats(int64_t generation) {
+  PortStatsMap stats;
+  for (auto port = 0; port < FLAGS_num_ports; ++port) {
+    HwPortStats portStats;
+    portStats.inBytes_() = generation * 1000 + port;
+    portStats.outBytes_() = generation * 2000 + port;
+    portStats.inUnicastPkts_() = generation * 10 + port;
+    portStats.outUnicastPkts_() = generation * 20 + port;
+    for (int16_t queue = 0; queue < 8; ++queue) {
+      portStats.queueOutBytes_()[queue] = generation * 100 + queue;
+      portStats.queueOutDiscardBytes_()[queue] = generation + queue;
+    }
+    portStats.timestamp_() = generation;
+    portStats.portName_() = fmt::format("eth1/{}/1", port + 1);
+    stats.emplace(*portStats.portName_(), std::move(portStats));
+  }
+  return stats;
+}
+
+// Re-chain a contiguous buffer into frame_size pieces, as a payload
+// received over a thrift stream would be
+folly::IOBuf toChain(const folly::IOBuf& buf) {
+  folly::IOBufQueue queue;
+  auto contiguous = buf.cloneCoalescedAsValue();
+  auto data = contiguous.data();
+  auto remaining = contiguous.length();
+  while (remaining > 0) {
+    auto len = std::min<size_t>(remaining, FLAGS_frame_size);
+    queue.append(folly::IOBuf::copyBuffer(data, len));
+    data += len;
+    remaining -= len;
+  }
+  return queue.moveAsValue();
+}
+
+// One val patch per port, each carrying the port's encoded stats as a chain
+PatchNode buildPatch(const PortStatsMap& stats) {
+  MapPatch mapPatch;
+  for (const auto& [name, portStats] : stats) {
+    auto buf = serializeBuf<apache::thrift::type_class::structure>(
+        kProtocol, portStats);
+    PatchNode child;
+    child.set_val(toChain(buf));
+    mapPatch.children()->emplace(name, std::move(child));
+  }
+  PatchNode patch;
+  patch.set_map_node(std::move(mapPatch));
+  return patch;
+}
+
+/*
+ * Decode of a whole stats map from an fbstring, as for OperDelta units.
+ * The copying variant is the decode path used before in-place decoding.
+ */
+template <bool Copy>
+void decodeEncoded(uint32_t iters) {
+  folly::BenchmarkSuspender suspender;
+  auto encoded = serialize<PortStatsMapTC>(kProtocol, buildPortStats(1));
+  suspender.dismiss();
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    if constexpr (Copy) {
+      auto buf = folly::IOBuf::copyBuffer(encoded.data(), encoded.length());
+      folly::doNotOptimizeAway(
+          deserializeBuf<PortStatsMapTC, PortStatsMap>(
+              kProtocol, std::move(*buf)));
+    } else {
+      folly::doNotOptimizeAway(
+          deserialize<PortStatsMapTC, PortStatsMap>(kProtocol, encoded));
+    }
+  }
+  suspender.rehire();
+}
+
+/*
+ * Full patch apply per iteration: every port's stats are replaced by a val
+ * patch whose buffer is a chain of stream frames. The coalescing variant
+ * flattens each buffer first, matching the cost of the copying decode path.
+ */
+template <bool Coalesce>
+void applyPatch(uint32_t iters) {
+  folly::BenchmarkSuspender suspender;
+  std::array<PortStatsMap, 2> stats{buildPortStats(0), buildPortStats(1)};
+  auto root = std::make_shared<PortStatsMapNode>(stats[0]);
+  size_t numFailed{0};
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    auto patch = buildPatch(stats[(iter + 1) % 2]);
+    suspender.dismiss();
+    if constexpr (Coalesce) {
+      for (auto& entry : *patch.mutable_map_node().children()) {
+        entry.second.set_val(entry.second.get_val().cloneCoalescedAsValue());
+      }
+    }
+    auto result = PatchApplier<PortStatsMapTC>::apply(
+        *root, std::move(patch), kProtocol);
+    suspender.rehire();
+    numFailed += result != PatchApplyResult::OK;
+  }
+  folly::doNotOptimizeAway(numFailed);
+}
+
+} // namespace
+
+BENCHMARK(DecodeCopiedOperState, iters) {
+  decodeEncoded<true>(iters);
+}
+
+BENCHMARK_RELATIVE(DecodeInPlaceOperState, iters) {
+  decodeEncoded<false>(iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(ApplyPatchCoalesced, iters) {
+  applyPatch<true>(iters);
+}
+
+BENCHMARK_RELATIVE(ApplyPatchChained, iters) {
+  applyPatch<false>(iters);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
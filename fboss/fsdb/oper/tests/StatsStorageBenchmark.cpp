@@ -0,0 +1,162 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <malloc.h>
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/memory/Malloc.h>
+#include <folly/memory/MallctlHelper.h>
+#include <gflags/gflags.h>
+
+#include "fboss/agent/gen-cpp2/agent_stats_fatal_types.h"
+#include "fboss/agent/gen-cpp2/agent_stats_types.h"
+#include "fboss/thrift_cow/nodes/Types.h"
+#include "fboss/thrift_cow/visitors/DeltaVisitor.h"
+#include "fboss/thrift_cow/visitors/TraverseHelper.h"
+
+DEFINE_int32(num_ports, 512, "Number of ports in the published stats");
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::thrift_cow;
+
+namespace {
+
+// Same type as agent.hwPortStats in the fsdb stats model
+using PortStatsMap =
+    folly::remove_cvref_t<decltype(*std::declval<AgentStats&>().hwPortStats())>;
+using PortStatsMapTC = apache::thrift::type_class::map<
+    apache::thrift::type_class::string,
+    apache::thrift::type_class::structure>;
+
+// Stores each port's stats as a single hybrid node, as if HwPortStats were
+// annotated with allow_skip_thrift_cow. The production struct is not, so
+// that subscribers can keep resolving paths within it.
+template <typename TC, typename TType>
+struct HybridNodeTraits : ConvertToNodeTraits<TC, TType> {};
+
+template <typename TType>
+struct HybridNodeTraits<apache::thrift::type_class::structure, TType> {
+  using type = std::shared_ptr<
+      ThriftHybridNode<apache::thrift::type_class::structure, TType>>;
+  using isChild = std::true_type;
+};
+
+// Baseline, storing every counter of every port as its own node
+using FullCowMap = ThriftMapNode<ThriftMapTraits<PortStatsMapTC, PortStatsMap>>;
+using HybridMap = ThriftMapNode<
+    ThriftMapTraits<PortStatsMapTC, PortStatsMap, HybridNodeTraits>>;
+
+static_assert(is_hybrid_node_v<HybridMap::value_type::element_type>);
+static_assert(!is_hybrid_node_v<FullCowMap::value_type::element_type>);
+
+PortStatsMap buildPortStats(int64_t generation) {
+  PortStatsMap stats;
+  for (auto port = 0; port < FLAGS_num_ports; ++port) {
+    HwPortStats portStats;
+    portStats.inBytes_() = generation * 1000 + port;
+    portStats.outBytes_() = generation * 2000 + port;
+    portStats.inUnicastPkts_() = generation * 10 + port;
+    portStats.outUnicastPkts_() = generation * 20 + port;
+    for (int16_t queue = 0; queue < 8; ++queue) {
+      portStats.queueOutBytes_()[queue] = generation * 100 + queue;
+      portStats.queueOutDiscardBytes_()[queue] = generation + queue;
+    }
+    portStats.timestamp_() = generation;
+    portStats.portName_() = fmt::format("eth1/{}/1", port + 1);
+    stats.emplace(*portStats.portName_(), std::move(portStats));
+  }
+  return stats;
+}
+
+size_t allocatedBytes() {
+  if (folly::usingJEMalloc()) {
+    // refresh jemalloc stats before reading them
+    folly::mallctlWrite<uint64_t>("epoch", 1);
+    size_t allocated{0};
+    folly::mallctlRead("stats.allocated", &allocated);
+    return allocated;
+  }
+  return mallinfo2().uordblks;
+}
+
+/*
+ * Memory held by the stats of all ports, reported per port.
+ */
+template <typename MapNode>
+void buildStorage(uint32_t iters, folly::UserCounters& counters) {
+  folly::BenchmarkSuspender suspender;
+  auto stats = buildPortStats(0);
+  std::shared_ptr<MapNode> node;
+  size_t bytes{0};
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    node.reset();
+    auto before = allocatedBytes();
+    suspender.dismiss();
+    node = std::make_shared<MapNode>(stats);
+    node->publish();
+    suspender.rehire();
+    bytes = allocatedBytes() - before;
+  }
+  counters["bytes_per_port"] =
+      folly::UserMetric(static_cast<int64_t>(bytes / FLAGS_num_ports));
+}
+
+/*
+ * One stats publish per iteration: every port's counters change, the new
+ * version is published and diffed against the previous one, the way fsdb
+ * does before serving subscribers.
+ */
+template <typename MapNode>
+void publishStats(uint32_t iters) {
+  folly::BenchmarkSuspender suspender;
+  std::array<PortStatsMap, 2> stats{buildPortStats(0), buildPortStats(1)};
+  auto root = std::make_shared<MapNode>(stats[0]);
+  root->publish();
+  size_t numDeltas{0};
+
+  suspender.dismiss();
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    auto newRoot = root->clone();
+    newRoot->fromThrift(stats[(iter + 1) % 2]);
+    newRoot->publish();
+
+    SimpleTraverseHelper traverser;
+    DeltaVisitor<PortStatsMapTC>::visit(
+        traverser,
+        root,
+        newRoot,
+        DeltaVisitOptions(DeltaVisitMode::MINIMAL),
+        [&](const std::vector<std::string>& /* path */,
+            auto&& /* oldValue */,
+            auto&& /* newValue */,
+            auto&& /* tag */) { ++numDeltas; });
+    root = std::move(newRoot);
+  }
+  folly::doNotOptimizeAway(numDeltas);
+  suspender.rehire();
+}
+
+} // namespace
+
+BENCHMARK_COUNTERS(BuildFullCowStats, counters, iters) {
+  buildStorage<FullCowMap>(iters, counters);
+}
+
+BENCHMARK_COUNTERS_RELATIVE(BuildHybridStats, counters, iters) {
+  buildStorage<HybridMap>(iters, counters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(PublishFullCowStats, iters) {
+  publishStats<FullCowMap>(iters);
+}
+
+BENCHMARK_RELATIVE(PublishHybridStats, iters) {
+  publishStats<HybridMap>(iters);
+}
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
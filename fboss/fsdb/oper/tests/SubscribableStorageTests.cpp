@@ -125,6 +125,115 @@ TEST_P(SubscribableStorageTests, SubscribeOne) {
   EXPECT_EQ(deltaVal.newVal, false);
 }
 
+TEST_P(SubscribableStorageTests, SubscribeSharedSerialization) {
+  auto storage = TestSubscribableStorage(testStruct);
+  storage.start();
+  auto generator1 = storage.subscribe(kSubscriber, root.member());
+  auto generator2 = storage.subscribe(kSubscriber, root.member());
+  for (auto* generator : {&generator1, &generator2}) {
+    auto deltaVal = folly::coro::blockingWait(
+        folly::coro::timeout(consumeOne(*generator), std::chrono::seconds(1)));
+    EXPECT_EQ(deltaVal.newVal, testStruct.member().value());
+  }
+  auto initialStats = storage.serializationCacheStats();
+  EXPECT_GT(initialStats.misses, 0);
+
+  TestStructSimple newMember;
+  newMember.min() = 50;
+  newMember.max() = 60;
+  EXPECT_EQ(storage.set(root.member(), newMember), std::nullopt);
+  for (auto* generator : {&generator1, &generator2}) {
+    auto deltaVal = folly::coro::blockingWait(
+        folly::coro::timeout(consumeOne(*generator), std::chrono::seconds(1)));
+    EXPECT_EQ(deltaVal.oldVal, testStruct.member().value());
+    EXPECT_EQ(deltaVal.newVal, newMember);
+  }
+  // old state was already encoded for the initial sync
+  EXPECT_GT(storage.serializationCacheStats().hits, initialStats.hits);
+}
+
+TEST_P(SubscribableStorageTests, SubscribeShardedServe) {
+  FLAGS_storage_serve_shards = 4;
+  auto storage = TestSubscribableStorage(testStruct);
+  FLAGS_storage_serve_shards = 1;
+  EXPECT_EQ(storage.numServeShards(), 4);
+
+  // subscriptions under different publisher roots, including one to a path
+  // that only exists after the first update
+  auto memberGen = storage.subscribe(kSubscriber, root.member());
+  auto txGen = storage.subscribe(kSubscriber, root.tx());
+  auto newPathGen = storage.subscribe(kSubscriber, root.structMap()[99].min());
+  storage.start();
+
+  auto memberVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(memberGen), std::chrono::seconds(1)));
+  EXPECT_EQ(memberVal.newVal, testStruct.member().value());
+  auto txVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(txGen), std::chrono::seconds(1)));
+  EXPECT_EQ(txVal.newVal, true);
+  WITH_RETRIES(EXPECT_EVENTUALLY_EQ(storage.numSubscriptions(), 3));
+
+  TestStructSimple newStruct;
+  newStruct.min() = 999;
+  newStruct.max() = 1001;
+  EXPECT_EQ(storage.set(root.structMap()[99], newStruct), std::nullopt);
+  EXPECT_EQ(storage.set(root.tx(), false), std::nullopt);
+
+  auto newPathVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(newPathGen), std::chrono::seconds(5)));
+  EXPECT_EQ(newPathVal.oldVal, std::nullopt);
+  EXPECT_EQ(newPathVal.newVal, 999);
+  txVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(txGen), std::chrono::seconds(1)));
+  EXPECT_EQ(txVal.oldVal, true);
+  EXPECT_EQ(txVal.newVal, false);
+}
+
+TEST_P(SubscribableStorageTests, SubscribeShardedRootAndIdPaths) {
+  FLAGS_storage_serve_shards = 4;
+  auto storage = TestSubscribableStorage(testStruct);
+  FLAGS_storage_serve_shards = 1;
+
+  // root subscription has no top level member to shard by
+  auto rootGen =
+      storage.subscribe_delta(kSubscriber, root, OperProtocol::SIMPLE_JSON);
+  // name and id forms of the same member
+  auto txNameGen = storage.subscribe_encoded(
+      kSubscriber,
+      std::vector<std::string>{"tx"},
+      OperProtocol::SIMPLE_JSON);
+  auto txIdGen = storage.subscribe_encoded(
+      kSubscriber,
+      std::vector<std::string>{
+          folly::to<std::string>(TestStructMembers::tx::id::value)},
+      OperProtocol::SIMPLE_JSON);
+  storage.start();
+  WITH_RETRIES(EXPECT_EVENTUALLY_EQ(storage.numSubscriptions(), 3));
+
+  auto rootDelta = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(rootGen), std::chrono::seconds(5)));
+  EXPECT_EQ(rootDelta.changes()->size(), 1);
+  folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(txNameGen), std::chrono::seconds(5)));
+  folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(txIdGen), std::chrono::seconds(5)));
+
+  EXPECT_EQ(storage.set(root.tx(), false), std::nullopt);
+
+  rootDelta = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(rootGen), std::chrono::seconds(5)));
+  ASSERT_EQ(rootDelta.changes()->size(), 1);
+  EXPECT_THAT(
+      *rootDelta.changes()->at(0).path()->raw(),
+      ::testing::ContainerEq(std::vector<std::string>({"tx"})));
+  auto txNameVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(txNameGen), std::chrono::seconds(5)));
+  EXPECT_TRUE(txNameVal.newVal.has_value());
+  auto txIdVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(txIdGen), std::chrono::seconds(5)));
+  EXPECT_TRUE(txIdVal.newVal.has_value());
+}
+
 TEST_P(SubscribableStorageTests, SubscribePathAddRemoveParent) {
   // add subscription for a path that doesn't exist yet, then add parent
   auto storage = TestSubscribableStorage(testStruct);
@@ -592,6 +701,125 @@ TEST_P(SubscribableStorageTests, SubscribeExtendedDeltaSimple) {
   EXPECT_EQ(deserialized, 998);
 }
 
+TEST_P(SubscribableStorageTests, SubscribeBelowHybridNode) {
+  // hybrid nodes hold a plain thrift object, subscriptions to fields inside
+  // it should still be synced and served
+  testStruct.hybridStatsMap()["eth1"].inBytes() = 10;
+  testStruct.hybridStatsMap()["eth1"].outBytes() = 20;
+  auto storage = TestSubscribableStorage(testStruct);
+  storage.start();
+
+  const auto& path = root.hybridStatsMap()["eth1"].inBytes();
+  auto generator = storage.subscribe(kSubscriber, path);
+  auto deltaVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(generator), std::chrono::seconds(1)));
+  EXPECT_EQ(deltaVal.oldVal, std::nullopt);
+  EXPECT_EQ(deltaVal.newVal, 10);
+
+  // a change to a sibling field is not served to this subscription
+  EXPECT_EQ(
+      storage.set(root.hybridStatsMap()["eth1"].outBytes(), 30), std::nullopt);
+  EXPECT_EQ(storage.set(path, 11), std::nullopt);
+  deltaVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(generator), std::chrono::seconds(1)));
+  EXPECT_EQ(deltaVal.oldVal, 10);
+  EXPECT_EQ(deltaVal.newVal, 11);
+
+  // replacing the whole hybrid object is served as a change to the field
+  auto stats = storage.get(root.hybridStatsMap()["eth1"]).value();
+  stats.inBytes() = 12;
+  EXPECT_EQ(storage.set(root.hybridStatsMap()["eth1"], stats), std::nullopt);
+  deltaVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(generator), std::chrono::seconds(1)));
+  EXPECT_EQ(deltaVal.oldVal, 11);
+  EXPECT_EQ(deltaVal.newVal, 12);
+}
+
+TEST_P(SubscribableStorageTests, SubscribeDeltaBelowHybridNode) {
+  testStruct.hybridStatsMap()["eth1"].queueOutBytes()[0] = 5;
+  auto storage = TestSubscribableStorage(testStruct);
+  storage.start();
+
+  const auto& path = root.hybridStatsMap()["eth1"].queueOutBytes()[0];
+  auto generator =
+      storage.subscribe_delta(kSubscriber, path, OperProtocol::SIMPLE_JSON);
+  auto deltaVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(generator), std::chrono::seconds(1)));
+  ASSERT_EQ(deltaVal.changes()->size(), 1);
+  auto first = deltaVal.changes()->at(0);
+  EXPECT_TRUE(first.path()->raw()->empty());
+  EXPECT_FALSE(first.oldState());
+  ASSERT_TRUE(first.newState());
+  EXPECT_EQ(
+      (facebook::fboss::thrift_cow::
+           deserialize<apache::thrift::type_class::integral, int64_t>(
+               OperProtocol::SIMPLE_JSON, *first.newState())),
+      5);
+
+  EXPECT_EQ(storage.set(path, 6), std::nullopt);
+  deltaVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(generator), std::chrono::seconds(1)));
+  ASSERT_EQ(deltaVal.changes()->size(), 1);
+  auto second = deltaVal.changes()->at(0);
+  EXPECT_TRUE(second.path()->raw()->empty());
+  ASSERT_TRUE(second.oldState());
+  ASSERT_TRUE(second.newState());
+  EXPECT_EQ(
+      (facebook::fboss::thrift_cow::
+           deserialize<apache::thrift::type_class::integral, int64_t>(
+               OperProtocol::SIMPLE_JSON, *second.oldState())),
+      5);
+  EXPECT_EQ(
+      (facebook::fboss::thrift_cow::
+           deserialize<apache::thrift::type_class::integral, int64_t>(
+               OperProtocol::SIMPLE_JSON, *second.newState())),
+      6);
+}
+
+TEST_P(SubscribableStorageTests, SubscribeExtendedPathBelowHybridNode) {
+  testStruct.hybridStatsMap()["eth1"].inBytes() = 10;
+  testStruct.hybridStatsMap()["eth2"].inBytes() = 20;
+  auto storage = TestSubscribableStorage(testStruct);
+  auto path =
+      ext_path_builder::raw("hybridStatsMap").any().raw("inBytes").get();
+  auto generator = storage.subscribe_encoded_extended(
+      kSubscriber, {path}, OperProtocol::SIMPLE_JSON);
+  storage.start();
+
+  auto streamedVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(generator), std::chrono::seconds(5)));
+  std::map<std::vector<std::string>, int64_t> expected = {
+      {{"hybridStatsMap", "eth1", "inBytes"}, 10},
+      {{"hybridStatsMap", "eth2", "inBytes"}, 20},
+  };
+  EXPECT_EQ(streamedVal.size(), expected.size());
+  for (const auto& deltaVal : streamedVal) {
+    ASSERT_TRUE(deltaVal.newVal);
+    const auto& elemPath = *deltaVal.newVal->path()->path();
+    auto deserialized = facebook::fboss::thrift_cow::
+        deserialize<apache::thrift::type_class::integral, int64_t>(
+            OperProtocol::SIMPLE_JSON, *deltaVal.newVal->state()->contents());
+    EXPECT_EQ(expected[elemPath], deserialized)
+        << "Mismatch at /" + folly::join('/', elemPath);
+  }
+
+  EXPECT_EQ(
+      storage.set(root.hybridStatsMap()["eth2"].inBytes(), 21), std::nullopt);
+  streamedVal = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(generator), std::chrono::seconds(5)));
+  ASSERT_EQ(streamedVal.size(), 1);
+  ASSERT_TRUE(streamedVal.at(0).newVal);
+  EXPECT_THAT(
+      *streamedVal.at(0).newVal->path()->path(),
+      ::testing::ElementsAre("hybridStatsMap", "eth2", "inBytes"));
+  EXPECT_EQ(
+      (facebook::fboss::thrift_cow::
+           deserialize<apache::thrift::type_class::integral, int64_t>(
+               OperProtocol::SIMPLE_JSON,
+               *streamedVal.at(0).newVal->state()->contents())),
+      21);
+}
+
 class SubscribableStorageTestsPathDelta
     : public Test,
       public WithParamInterface<std::tuple<bool, bool>> {
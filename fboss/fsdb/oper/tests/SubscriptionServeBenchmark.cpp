@@ -0,0 +1,149 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/coro/AsyncGenerator.h>
+#include <folly/coro/BlockingWait.h>
+#include <gflags/gflags.h>
+
+#include "fboss/fsdb/oper/CowSubscriptionManager.h"
+#include "fboss/fsdb/oper/SubscriptionMetadataServer.h"
+#include "fboss/fsdb/tests/gen-cpp2/thriftpath_test_types.h"
+#include "fboss/thrift_cow/storage/CowStorage.h"
+
+DEFINE_int32(
+    struct_map_size,
+    1000,
+    "Number of entries in the map subscribers are subscribed to");
+
+using namespace facebook::fboss::fsdb;
+
+namespace {
+
+using TestRoot = facebook::fboss::thrift_cow::ThriftStructNode<TestStruct>;
+using TestSubscriptionManager = CowSubscriptionManager<TestRoot>;
+
+const std::vector<std::string> kSubscribedPath{"structMap"};
+
+TestStruct createTestStruct() {
+  TestStruct testStruct;
+  for (auto i = 0; i < FLAGS_struct_map_size; ++i) {
+    TestStructSimple member;
+    member.min() = i;
+    member.max() = i + 100;
+    testStruct.structMap()[i] = std::move(member);
+  }
+  return testStruct;
+}
+
+/*
+ * Serve one change to a single map entry per iteration, to numSubscribers
+ * subscribers of the whole map. Subscribers alternate between path and
+ * delta subscriptions, and between binary and compact protocols, the way
+ * a mix of on box agents and off box collectors would.
+ */
+void serveSubscriptions(
+    uint32_t iters,
+    size_t numSubscribers,
+    bool serializationCache) {
+  folly::BenchmarkSuspender suspender;
+  FLAGS_serveSerializationCache = serializationCache;
+
+  TestSubscriptionManager manager;
+  CowStorage<TestStruct> storage(createTestStruct());
+  SubscriptionMetadataServer metadataServer(std::nullopt);
+
+  std::vector<folly::coro::AsyncGenerator<DeltaValue<OperState>&&>> pathGens;
+  std::vector<folly::coro::AsyncGenerator<OperDelta&&>> deltaGens;
+  for (size_t i = 0; i < numSubscribers; ++i) {
+    auto protocol = (i / 2) % 2 ? OperProtocol::COMPACT : OperProtocol::BINARY;
+    auto subscriber = fmt::format("subscriber{}", i);
+    if (i % 2) {
+      auto [gen, subscription] = DeltaSubscription::create(
+          subscriber,
+          kSubscribedPath.begin(),
+          kSubscribedPath.end(),
+          protocol,
+          std::nullopt,
+          nullptr,
+          std::chrono::milliseconds(0));
+      manager.registerSubscription(std::move(subscription));
+      deltaGens.push_back(std::move(gen));
+    } else {
+      auto [gen, subscription] = PathSubscription::create(
+          subscriber,
+          kSubscribedPath.begin(),
+          kSubscribedPath.end(),
+          protocol,
+          std::nullopt,
+          nullptr,
+          std::chrono::milliseconds(0));
+      manager.registerSubscription(std::move(subscription));
+      pathGens.push_back(std::move(gen));
+    }
+  }
+
+  // every subscriber gets exactly one update per serve, drain them so
+  // subscription pipes don't keep growing
+  auto drain = [&]() {
+    for (auto& gen : pathGens) {
+      folly::coro::blockingWait(gen.next());
+    }
+    for (auto& gen : deltaGens) {
+      folly::coro::blockingWait(gen.next());
+    }
+  };
+
+  auto root = storage.root();
+  manager.publishAndAddPaths(root);
+  // register subscriptions and serve initial sync
+  manager.serveSubscriptions(root, root, metadataServer);
+  drain();
+
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    auto oldRoot = storage.root();
+    std::vector<std::string> changedPath{
+        "structMap",
+        folly::to<std::string>(iter % FLAGS_struct_map_size),
+        "min"};
+    storage.set(changedPath, static_cast<int32_t>(iter));
+    auto newRoot = storage.root();
+    manager.publishAndAddPaths(newRoot);
+
+    suspender.dismiss();
+    manager.serveSubscriptions(oldRoot, newRoot, metadataServer);
+    suspender.rehire();
+
+    drain();
+  }
+  FLAGS_serveSerializationCache = true;
+}
+
+void serveUncached(uint32_t iters, size_t numSubscribers) {
+  serveSubscriptions(iters, numSubscribers, false);
+}
+
+void serveCached(uint32_t iters, size_t numSubscribers) {
+  serveSubscriptions(iters, numSubscribers, true);
+}
+
+} // namespace
+
+BENCHMARK_PARAM(serveUncached, 1);
+BENCHMARK_RELATIVE_PARAM(serveCached, 1);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(serveUncached, 8);
+BENCHMARK_RELATIVE_PARAM(serveCached, 8);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(serveUncached, 32);
+BENCHMARK_RELATIVE_PARAM(serveCached, 32);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(serveUncached, 64);
+BENCHMARK_RELATIVE_PARAM(serveCached, 64);
+
+int main(int argc, char** argv) {
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -5,6 +5,7 @@
 #include <folly/coro/BlockingWait.h>
 #include <folly/coro/Timeout.h>
 #include <folly/io/async/ScopedEventBaseThread.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
 namespace facebook::fboss::fsdb::test {
@@ -52,4 +53,112 @@ TYPED_TEST(SubscriptionTests, verifyHeartbeat) {
       folly::coro::timeout(consumeOne(gen), std::chrono::seconds{1}));
 }
 
+namespace {
+OperState makeState(const std::string& contents) {
+  OperState state;
+  state.contents() = contents;
+  state.protocol() = OperProtocol::BINARY;
+  return state;
+}
+
+OperDeltaUnit makeDeltaUnit(
+    const std::string& key,
+    const std::string& oldState,
+    const std::string& newState) {
+  OperDeltaUnit unit;
+  unit.path()->raw() = {"test", key};
+  unit.oldState() = oldState;
+  unit.newState() = newState;
+  return unit;
+}
+
+class BoundedQueueTests : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_subscriptionQueueMaxDepth = 2;
+  }
+
+ protected:
+  gflags::FlagSaver flagSaver_;
+  template <typename SubscriptionT>
+  auto makeSubscription() {
+    std::vector<std::string> path = {"test"};
+    return SubscriptionT::create(
+        "test-sub",
+        path.begin(),
+        path.end(),
+        OperProtocol::BINARY,
+        std::nullopt,
+        nullptr,
+        std::chrono::milliseconds(0));
+  }
+
+  const SubscriptionMetadataServer metadataServer_{std::nullopt};
+};
+} // namespace
+
+TEST_F(BoundedQueueTests, PathSubscriptionKeepsLatest) {
+  auto [gen, sub] = makeSubscription<PathSubscription>();
+  for (auto i = 1; i <= 5; ++i) {
+    sub->offer(DeltaValue<OperState>(
+        makeState(std::to_string(i - 1)), makeState(std::to_string(i))));
+    sub->flush(metadataServer_);
+  }
+  auto stats = sub->queueStats();
+  EXPECT_EQ(stats.depth, 2);
+  EXPECT_EQ(stats.coalesced, 2);
+
+  // heartbeats don't fit either
+  sub->serveHeartbeat();
+  EXPECT_EQ(sub->queueStats().dropped, 1);
+
+  for (auto i = 1; i <= 2; ++i) {
+    auto value = folly::coro::blockingWait(
+        folly::coro::timeout(consumeOne(gen), std::chrono::seconds{1}));
+    EXPECT_EQ(*value.newVal->contents(), std::to_string(i));
+    sub->flush(metadataServer_);
+  }
+  // 3 and 4 are skipped, the subscriber goes from 2 straight to 5
+  auto value = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(gen), std::chrono::seconds{1}));
+  EXPECT_EQ(*value.oldVal->contents(), "2");
+  EXPECT_EQ(*value.newVal->contents(), "5");
+  EXPECT_EQ(sub->queueStats().depth, 0);
+}
+
+TEST_F(BoundedQueueTests, DeltaSubscriptionMergesDeltas) {
+  auto [gen, sub] = makeSubscription<DeltaSubscription>();
+  for (auto i = 1; i <= 4; ++i) {
+    sub->appendRootDeltaUnit(
+        makeDeltaUnit("a", std::to_string(i - 1), std::to_string(i)));
+    if (i == 4) {
+      sub->appendRootDeltaUnit(makeDeltaUnit("b", "0", "1"));
+    }
+    sub->flush(metadataServer_);
+  }
+  auto stats = sub->queueStats();
+  EXPECT_EQ(stats.depth, 2);
+  EXPECT_EQ(stats.coalesced, 1);
+
+  for (auto i = 1; i <= 2; ++i) {
+    auto delta = folly::coro::blockingWait(
+        folly::coro::timeout(consumeOne(gen), std::chrono::seconds{1}));
+    ASSERT_EQ(delta.changes()->size(), 1);
+    EXPECT_EQ(*delta.changes()->at(0).newState(), std::to_string(i));
+    sub->flush(metadataServer_);
+  }
+  // changes from the last two flushes come as one delta, with a single
+  // change per path
+  auto delta = folly::coro::blockingWait(
+      folly::coro::timeout(consumeOne(gen), std::chrono::seconds{1}));
+  ASSERT_EQ(delta.changes()->size(), 2);
+  const auto& changeA = delta.changes()->at(0);
+  EXPECT_EQ(*changeA.path()->raw(), std::vector<std::string>{"a"});
+  EXPECT_EQ(*changeA.oldState(), "2");
+  EXPECT_EQ(*changeA.newState(), "4");
+  const auto& changeB = delta.changes()->at(1);
+  EXPECT_EQ(*changeB.path()->raw(), std::vector<std::string>{"b"});
+  EXPECT_EQ(sub->queueStats().depth, 0);
+}
+
 } // namespace facebook::fboss::fsdb::test
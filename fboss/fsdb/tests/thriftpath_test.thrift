@@ -33,6 +33,13 @@ union UnionSimple {
   3: string str;
 }
 
+// Stored as a hybrid node by thrift_cow, like the hardware stats structs
+struct TestHybridStats {
+  1: i64 inBytes;
+  2: i64 outBytes;
+  3: map<i16, i64> queueOutBytes;
+} (allow_skip_thrift_cow = "true")
+
 struct TestStruct {
   1: bool tx = false;
   2: bool rx = false;
@@ -52,4 +59,5 @@ struct TestStruct {
   15: set<i32> setOfI32;
   16: map<string, TestStructSimple> stringToStruct = {};
   17: ListTypedef listTypedef = [];
+  18: map<string, TestHybridStats> hybridStatsMap = {};
 } (thriftpath.root)
@@ -1,15 +1,62 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
 #include "fboss/led_service/FsdbSwitchStateSubscriber.h"
+#include <folly/Conv.h>
+#include <folly/String.h>
 #include <folly/logging/xlog.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include "fboss/fsdb/client/FsdbPubSubManager.h"
 #include "fboss/fsdb/common/Flags.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 #include "fboss/led_service/LedManager.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
 
 namespace facebook::fboss {
 
+namespace {
+
+// Fields of state::PortFields used by LED Service
+constexpr auto kPortName = "portName";
+constexpr auto kPortProfileID = "portProfileID";
+constexpr auto kPortOperState = "portOperState";
+constexpr auto kPortLedExternalState = "portLedExternalState";
+constexpr auto kPortActiveState = "portActiveState";
+constexpr auto kDrainState = "drainState";
+
+const std::vector<std::string> kPortFieldNames = {
+    kPortName,
+    kPortProfileID,
+    kPortOperState,
+    kPortLedExternalState,
+    kPortActiveState,
+    kDrainState,
+};
+
+template <typename TC, typename T>
+T deserializeField(const fsdb::OperState& state) {
+  return thrift_cow::deserialize<TC, T>(*state.protocol(), *state.contents());
+}
+
+LedManager::LedSwitchStateUpdate toLedSwitchStateUpdate(
+    int16_t portId,
+    const state::PortFields& portInfo) {
+  LedManager::LedSwitchStateUpdate update;
+  update.swPortId = portId;
+  update.portName = portInfo.portName().value();
+  update.portProfile = portInfo.portProfileID().value();
+  update.operState = portInfo.portOperState().value();
+  if (portInfo.portLedExternalState().has_value()) {
+    update.ledExternalState = portInfo.portLedExternalState().value();
+  }
+  if (auto activeState = portInfo.portActiveState()) {
+    update.activeState = *activeState;
+  }
+  update.drained = portInfo.get_drainState() == cfg::PortDrainState::DRAINED;
+  return update;
+}
+
+} // namespace
+
 /*
  * subscribeToSwitchState
  *
@@ -17,7 +64,7 @@ namespace facebook::fboss {
  * callback will update the Led Manager synchronized port info map
  */
 void FsdbSwitchStateSubscriber::subscribeToSwitchState(LedManager* ledManager) {
-  subscribeToState(getSwitchStatePath(), ledManager);
+  subscribeToState(getPortFieldPaths(), ledManager);
 }
 
 /*
@@ -26,17 +73,142 @@ void FsdbSwitchStateSubscriber::subscribeToSwitchState(LedManager* ledManager) {
  * This function removes the switch state subscription from FSDB
  */
 void FsdbSwitchStateSubscriber::removeSwitchStateSubscription() {
-  removeStateSubscribe(getSwitchStatePath());
+  removeStateSubscribe(getPortFieldPaths());
+}
+
+/*
+ * getPortFieldPaths
+ *
+ * Returns one extended path per port field used by LED Service, matching that
+ * field in every port of every switch:
+ *   <switch state>/portMaps/<any switch>/<any port>/<field>
+ */
+std::vector<fsdb::ExtendedOperPath>
+FsdbSwitchStateSubscriber::getPortFieldPaths() {
+  std::vector<fsdb::ExtendedOperPath> paths;
+  for (const auto& field : kPortFieldNames) {
+    fsdb::ExtendedOperPath path;
+    for (const auto& token : getSwitchStatePath()) {
+      path.path()->emplace_back().raw_ref() = token;
+    }
+    path.path()->emplace_back().raw_ref() = "portMaps";
+    path.path()->emplace_back().any_ref() = true;
+    path.path()->emplace_back().any_ref() = true;
+    path.path()->emplace_back().raw_ref() = field;
+    paths.push_back(std::move(path));
+  }
+  return paths;
+}
+
+/*
+ * processPortFieldChanges
+ *
+ * Decode the port fields in an FSDB update and apply them to the cached
+ * ports. Only the changed fields are sent by FSDB, so this never decodes
+ * anything but the few port fields LED Service cares about.
+ */
+std::set<int16_t> FsdbSwitchStateSubscriber::processPortFieldChanges(
+    fsdb::OperSubPathUnit&& update) {
+  // <switch state>/portMaps/<switch>/<port>/<field>
+  const auto portIdIndex = getSwitchStatePath().size() + 2;
+
+  std::set<int16_t> changedPorts;
+  for (const auto& change : *update.changes()) {
+    const auto& path = *change.path()->path();
+    if (path.size() != portIdIndex + 2) {
+      XLOG(ERR) << "Unexpected FSDB path " << folly::join("/", path);
+      continue;
+    }
+    auto portId = folly::tryTo<int16_t>(path[portIdIndex]);
+    if (!portId.hasValue()) {
+      XLOG(ERR) << "Invalid port id in FSDB path " << folly::join("/", path);
+      continue;
+    }
+    const auto& field = path.back();
+    const auto& state = *change.state();
+
+    if (!state.contents().has_value()) {
+      // Field was removed. Optional fields are reset, the port is forgotten
+      // when it goes away altogether.
+      if (field == kPortName) {
+        ports_.erase(*portId);
+      } else if (auto port = ports_.find(*portId); port != ports_.end()) {
+        if (field == kPortLedExternalState) {
+          port->second.portLedExternalState().reset();
+          changedPorts.insert(*portId);
+        } else if (field == kPortActiveState) {
+          port->second.portActiveState().reset();
+          changedPorts.insert(*portId);
+        }
+      }
+      continue;
+    }
+
+    auto& port = ports_[*portId];
+    if (field == kPortName) {
+      port.portName() = deserializeField<
+          apache::thrift::type_class::string,
+          std::string>(state);
+    } else if (field == kPortProfileID) {
+      port.portProfileID() = deserializeField<
+          apache::thrift::type_class::string,
+          std::string>(state);
+    } else if (field == kPortOperState) {
+      port.portOperState() =
+          deserializeField<apache::thrift::type_class::integral, bool>(state);
+    } else if (field == kPortLedExternalState) {
+      port.portLedExternalState() = deserializeField<
+          apache::thrift::type_class::enumeration,
+          PortLedExternalState>(state);
+    } else if (field == kPortActiveState) {
+      port.portActiveState() =
+          deserializeField<apache::thrift::type_class::integral, bool>(state);
+    } else if (field == kDrainState) {
+      port.drainState() = deserializeField<
+          apache::thrift::type_class::enumeration,
+          cfg::PortDrainState>(state);
+    } else {
+      XLOG(ERR) << "Unexpected port field " << field;
+      continue;
+    }
+    changedPorts.insert(*portId);
+  }
+
+  // Ports are only reported to LED Manager once their name and profile are
+  // known, LED Manager can't map a port without a profile
+  for (auto it = changedPorts.begin(); it != changedPorts.end();) {
+    auto port = ports_.find(*it);
+    if (port == ports_.end() || port->second.portName()->empty() ||
+        port->second.portProfileID()->empty()) {
+      it = changedPorts.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return changedPorts;
+}
+
+/*
+ * processSubscriptionStateChange
+ *
+ * Clear the cached ports on (re)connect, FSDB follows up with a full sync of
+ * the port fields
+ */
+void FsdbSwitchStateSubscriber::processSubscriptionStateChange(
+    fsdb::SubscriptionState newState) {
+  if (newState == fsdb::SubscriptionState::CONNECTED) {
+    ports_.clear();
+  }
 }
 
 /*
  * subscribeToState
  *
  * A helper function to subscribe to the state callback to FSDB for updates on
- * a given path.
+ * the given extended paths.
  */
 void FsdbSwitchStateSubscriber::subscribeToState(
-    std::vector<std::string> path,
+    std::vector<fsdb::ExtendedOperPath> paths,
     LedManager* ledManager) {
   // Subscribe to FSDB only if the LED config is enabled
   if (!ledManager || !ledManager->isLedControlledThroughService()) {
@@ -44,51 +216,40 @@ void FsdbSwitchStateSubscriber::subscribeToState(
     return;
   }
 
-  auto stateCb = [](fsdb::SubscriptionState /*old*/,
-                    fsdb::SubscriptionState /*new*/) {};
-  auto dataCb = [=](fsdb::OperState&& state) {
-    if (auto contents = state.contents()) {
-      // Deserialize the FSDB update to switch state struct. This will be
-      // used by LED manager thread later
-      auto newSwitchStateData = apache::thrift::BinarySerializer::deserialize<
-          fboss::state::SwitchState>(*contents);
-      auto swPortMaps = newSwitchStateData.portMaps().value();
-
-      std::map<short, LedManager::LedSwitchStateUpdate> ledSwitchStateUpdate;
-
-      for (auto& [switchStr, oneSwPortMap] : swPortMaps) {
-        for (auto& [onePortId, onePortInfo] : oneSwPortMap) {
-          ledSwitchStateUpdate[onePortId].swPortId = onePortId;
-          ledSwitchStateUpdate[onePortId].portName =
-              onePortInfo.portName().value();
-          ledSwitchStateUpdate[onePortId].portProfile =
-              onePortInfo.portProfileID().value();
-          ledSwitchStateUpdate[onePortId].operState =
-              onePortInfo.portOperState().value();
-          if (onePortInfo.portLedExternalState().has_value()) {
-            ledSwitchStateUpdate[onePortId].ledExternalState =
-                onePortInfo.portLedExternalState().value();
-          }
-          if (auto activeState = onePortInfo.portActiveState()) {
-            ledSwitchStateUpdate[onePortId].activeState = *activeState;
-          }
-          ledSwitchStateUpdate[onePortId].drained =
-              onePortInfo.get_drainState() == cfg::PortDrainState::DRAINED;
-        }
-      }
+  // Called in the FSDB callback thread, right before the initial sync
+  auto stateCb = [this](
+                     fsdb::SubscriptionState /*old*/,
+                     fsdb::SubscriptionState newState) {
+    processSubscriptionStateChange(newState);
+  };
+  auto dataCb = [this, ledManager](fsdb::OperSubPathUnit&& update) {
+    auto changedPorts = processPortFieldChanges(std::move(update));
+    if (changedPorts.empty()) {
+      return;
+    }
 
-      if (ledManager) {
-        folly::via(ledManager->getEventBase()).thenValue([=](auto&&) {
-          ledManager->updateLedStatus(ledSwitchStateUpdate);
-        });
+    // Only the ports that changed are sent to LED manager thread
+    std::map<short, LedManager::LedSwitchStateUpdate> ledSwitchStateUpdate;
+    for (auto portId : changedPorts) {
+      ledSwitchStateUpdate[portId] =
+          toLedSwitchStateUpdate(portId, ports_.at(portId));
+    }
 
-      } else {
-        XLOG(ERR) << "Subscribed data came for invalid LED Manager";
-      }
+    if (ledManager) {
+      folly::via(ledManager->getEventBase()).thenValue([=](auto&&) {
+        ledManager->updateLedStatus(ledSwitchStateUpdate);
+      });
+
+    } else {
+      XLOG(ERR) << "Subscribed data came for invalid LED Manager";
     }
   };
-  pubSubMgr()->addStatePathSubscription(path, stateCb, dataCb);
-  XLOG(INFO) << "LED Service Subscribed to FSDB switch state path";
+  pubSubMgr()->addStateExtPathSubscription(
+      paths,
+      stateCb,
+      dataCb,
+      fsdb::FsdbStreamClient::ServerOptions("::1", FLAGS_fsdbPort));
+  XLOG(INFO) << "LED Service Subscribed to FSDB switch state port fields";
 }
 
 /*
@@ -98,8 +259,8 @@ void FsdbSwitchStateSubscriber::subscribeToState(
  * path
  */
 void FsdbSwitchStateSubscriber::removeStateSubscribe(
-    std::vector<std::string> path) {
-  pubSubMgr()->removeStatePathSubscription(path);
+    std::vector<fsdb::ExtendedOperPath> paths) {
+  pubSubMgr()->removeStateExtPathSubscription(paths);
   XLOG(INFO) << "LED Service Removed from FSDB subscription";
 }
 
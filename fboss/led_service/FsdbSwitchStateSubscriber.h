@@ -6,7 +6,9 @@
 #include "fboss/fsdb/client/FsdbPubSubManager.h"
 #include "fboss/fsdb/client/FsdbStreamClient.h"
 
+#include <map>
 #include <memory>
+#include <set>
 
 namespace facebook::fboss {
 namespace fsdb {
@@ -18,9 +20,11 @@ class LedManager;
 /*
  * FsdbSwitchStateSubscriber class:
  *
- * This class subscribes to FSDB for the Port Info state path. The callback
- * function is called in FSDB callback thread and it will update the Port Info
- * map in Led Service.
+ * This class subscribes to FSDB for the port fields LED Service needs, for
+ * every port in the switch state port maps. FSDB only sends the fields that
+ * changed, so the callback decodes just those, applies them to the ports it
+ * caches and updates the Port Info map in Led Service for the ports that
+ * changed. The callback is called in FSDB callback thread.
  */
 class FsdbSwitchStateSubscriber {
  public:
@@ -36,11 +40,36 @@ class FsdbSwitchStateSubscriber {
 
   static std::vector<std::string> getSwitchStatePath();
 
+  // Extended paths of the port fields used by LED Service, for all ports
+  static std::vector<fsdb::ExtendedOperPath> getPortFieldPaths();
+
+  /*
+   * Apply the port field changes of an FSDB update to the cached ports.
+   * Returns the ids of the ports whose fields changed.
+   */
+  std::set<int16_t> processPortFieldChanges(fsdb::OperSubPathUnit&& update);
+
+  /*
+   * FSDB resends every port field when the subscription (re)connects, so
+   * the cached ports are dropped then. Ports removed while disconnected
+   * would otherwise linger in the cache.
+   */
+  void processSubscriptionStateChange(fsdb::SubscriptionState newState);
+
+  const std::map<int16_t, state::PortFields>& getCachedPorts() const {
+    return ports_;
+  }
+
  private:
-  void subscribeToState(std::vector<std::string> path, LedManager* ledManager);
-  void removeStateSubscribe(std::vector<std::string> path);
+  void subscribeToState(
+      std::vector<fsdb::ExtendedOperPath> paths,
+      LedManager* ledManager);
+  void removeStateSubscribe(std::vector<fsdb::ExtendedOperPath> paths);
 
   fsdb::FsdbPubSubManager* fsdbPubSubMgr_;
+  // Port fields received from FSDB so far, only accessed from the FSDB
+  // callback thread
+  std::map<int16_t, state::PortFields> ports_;
 };
 
 } // namespace facebook::fboss
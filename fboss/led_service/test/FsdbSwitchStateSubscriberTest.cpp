@@ -0,0 +1,278 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <folly/Conv.h>
+#include <folly/IPAddress.h>
+#include <gtest/gtest.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "fboss/agent/AddressUtil.h"
+#include "fboss/led_service/FsdbSwitchStateSubscriber.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
+
+namespace facebook::fboss {
+
+namespace {
+
+constexpr auto kSwitchId = "id=0";
+constexpr int16_t kNumPorts = 64;
+
+state::PortFields makePort(int16_t portId) {
+  state::PortFields port;
+  port.portId() = portId;
+  port.portName() = folly::to<std::string>("eth1/", portId, "/1");
+  port.portProfileID() = "PROFILE_100G_4_NRZ_RS528_COPPER";
+  port.portOperState() = portId % 2;
+  port.drainState() = cfg::PortDrainState::UNDRAINED;
+  if (portId % 3 == 0) {
+    port.portActiveState() = true;
+  }
+  return port;
+}
+
+state::SwitchState makeSwitchState(int numRoutes) {
+  state::SwitchState switchState;
+  auto& ports = (*switchState.portMaps())[kSwitchId];
+  for (int16_t portId = 1; portId <= kNumPorts; ++portId) {
+    ports[portId] = makePort(portId);
+  }
+
+  auto& fib = (*switchState.fibsMap())[kSwitchId][0];
+  fib.vrf() = 0;
+  NextHopThrift nextHop;
+  nextHop.address() =
+      network::toBinaryAddress(folly::IPAddress("2401:db00::1"));
+  for (int i = 0; i < numRoutes; ++i) {
+    auto bytes = folly::IPAddressV6("2401:db00:1::").toByteArray();
+    bytes[8] = (i >> 24) & 0xff;
+    bytes[9] = (i >> 16) & 0xff;
+    bytes[10] = (i >> 8) & 0xff;
+    bytes[11] = i & 0xff;
+    folly::IPAddressV6 prefix(bytes);
+
+    state::RouteFields route;
+    route.prefix()->v6() = true;
+    route.prefix()->prefix() = network::toBinaryAddress(prefix);
+    route.prefix()->mask() = 64;
+    route.fwd()->action() = RouteForwardAction::NEXTHOPS;
+    route.fwd()->nexthops()->push_back(nextHop);
+    (*fib.fibV6())[folly::to<std::string>(prefix.str(), "/64")] =
+        std::move(route);
+  }
+  return switchState;
+}
+
+template <typename TC, typename T>
+fsdb::TaggedOperState makeFieldState(
+    int16_t portId,
+    const std::string& field,
+    const std::optional<T>& value) {
+  fsdb::TaggedOperState taggedState;
+  auto path = FsdbSwitchStateSubscriber::getSwitchStatePath();
+  path.insert(
+      path.end(),
+      {"portMaps", kSwitchId, folly::to<std::string>(portId), field});
+  taggedState.path()->path() = std::move(path);
+  taggedState.state()->protocol() = fsdb::OperProtocol::BINARY;
+  if (value.has_value()) {
+    taggedState.state()->contents() =
+        thrift_cow::serialize<TC>(fsdb::OperProtocol::BINARY, *value);
+  }
+  return taggedState;
+}
+
+// What FSDB sends on initial sync of the port field paths
+fsdb::OperSubPathUnit makeInitialSync(const state::SwitchState& switchState) {
+  using StringTC = apache::thrift::type_class::string;
+  using BoolTC = apache::thrift::type_class::integral;
+  using EnumTC = apache::thrift::type_class::enumeration;
+
+  fsdb::OperSubPathUnit update;
+  auto& changes = *update.changes();
+  for (const auto& [switchStr, ports] : *switchState.portMaps()) {
+    for (const auto& [portId, port] : ports) {
+      changes.push_back(makeFieldState<StringTC, std::string>(
+          portId, "portName", *port.portName()));
+      changes.push_back(makeFieldState<StringTC, std::string>(
+          portId, "portProfileID", *port.portProfileID()));
+      changes.push_back(makeFieldState<BoolTC, bool>(
+          portId, "portOperState", *port.portOperState()));
+      changes.push_back(makeFieldState<EnumTC, cfg::PortDrainState>(
+          portId, "drainState", *port.drainState()));
+      if (port.portLedExternalState().has_value()) {
+        changes.push_back(makeFieldState<EnumTC, PortLedExternalState>(
+            portId, "portLedExternalState", *port.portLedExternalState()));
+      }
+      if (port.portActiveState().has_value()) {
+        changes.push_back(makeFieldState<BoolTC, bool>(
+            portId, "portActiveState", *port.portActiveState()));
+      }
+    }
+  }
+  return update;
+}
+
+void checkPorts(
+    const FsdbSwitchStateSubscriber& subscriber,
+    const state::SwitchState& switchState) {
+  const auto& ports = switchState.portMaps()->at(kSwitchId);
+  ASSERT_EQ(subscriber.getCachedPorts().size(), ports.size());
+  for (const auto& [portId, port] : ports) {
+    const auto& cached = subscriber.getCachedPorts().at(portId);
+    EXPECT_EQ(*cached.portName(), *port.portName());
+    EXPECT_EQ(*cached.portProfileID(), *port.portProfileID());
+    EXPECT_EQ(*cached.portOperState(), *port.portOperState());
+    EXPECT_EQ(*cached.drainState(), *port.drainState());
+    EXPECT_EQ(
+        cached.portLedExternalState().to_optional(),
+        port.portLedExternalState().to_optional());
+    EXPECT_EQ(
+        cached.portActiveState().to_optional(),
+        port.portActiveState().to_optional());
+  }
+}
+
+} // namespace
+
+TEST(FsdbSwitchStateSubscriberTest, initialSync) {
+  auto switchState = makeSwitchState(0);
+  FsdbSwitchStateSubscriber subscriber(nullptr);
+
+  auto changedPorts =
+      subscriber.processPortFieldChanges(makeInitialSync(switchState));
+  EXPECT_EQ(changedPorts.size(), static_cast<size_t>(kNumPorts));
+  checkPorts(subscriber, switchState);
+}
+
+TEST(FsdbSwitchStateSubscriberTest, portFieldChanges) {
+  auto switchState = makeSwitchState(0);
+  FsdbSwitchStateSubscriber subscriber(nullptr);
+  subscriber.processPortFieldChanges(makeInitialSync(switchState));
+
+  auto& port = switchState.portMaps()->at(kSwitchId).at(5);
+  port.portOperState() = !*port.portOperState();
+  port.portLedExternalState() = PortLedExternalState::CABLING_ERROR;
+  auto& otherPort = switchState.portMaps()->at(kSwitchId).at(6);
+  otherPort.drainState() = cfg::PortDrainState::DRAINED;
+
+  fsdb::OperSubPathUnit update;
+  update.changes()->push_back(
+      makeFieldState<apache::thrift::type_class::integral, bool>(
+          5, "portOperState", *port.portOperState()));
+  update.changes()->push_back(makeFieldState<
+                              apache::thrift::type_class::enumeration,
+                              PortLedExternalState>(
+      5, "portLedExternalState", *port.portLedExternalState()));
+  update.changes()->push_back(makeFieldState<
+                              apache::thrift::type_class::enumeration,
+                              cfg::PortDrainState>(
+      6, "drainState", *otherPort.drainState()));
+
+  auto changedPorts = subscriber.processPortFieldChanges(std::move(update));
+  EXPECT_EQ(changedPorts, std::set<int16_t>({5, 6}));
+  checkPorts(subscriber, switchState);
+}
+
+TEST(FsdbSwitchStateSubscriberTest, portFieldRemoved) {
+  auto switchState = makeSwitchState(0);
+  FsdbSwitchStateSubscriber subscriber(nullptr);
+  subscriber.processPortFieldChanges(makeInitialSync(switchState));
+
+  // Optional field goes away
+  auto& port = switchState.portMaps()->at(kSwitchId).at(3);
+  port.portActiveState().reset();
+  fsdb::OperSubPathUnit update;
+  update.changes()->push_back(
+      makeFieldState<apache::thrift::type_class::integral, bool>(
+          3, "portActiveState", std::nullopt));
+  EXPECT_EQ(
+      subscriber.processPortFieldChanges(std::move(update)),
+      std::set<int16_t>({3}));
+  checkPorts(subscriber, switchState);
+
+  // Whole port goes away
+  switchState.portMaps()->at(kSwitchId).erase(4);
+  update = fsdb::OperSubPathUnit();
+  update.changes()->push_back(
+      makeFieldState<apache::thrift::type_class::string, std::string>(
+          4, "portName", std::nullopt));
+  EXPECT_TRUE(subscriber.processPortFieldChanges(std::move(update)).empty());
+  checkPorts(subscriber, switchState);
+}
+
+TEST(FsdbSwitchStateSubscriberTest, newPortReportedOnceProfileKnown) {
+  using StringTC = apache::thrift::type_class::string;
+  auto switchState = makeSwitchState(0);
+  FsdbSwitchStateSubscriber subscriber(nullptr);
+  subscriber.processPortFieldChanges(makeInitialSync(switchState));
+
+  // Only the name of a new port is known so far
+  constexpr int16_t kNewPort = kNumPorts + 1;
+  fsdb::OperSubPathUnit update;
+  update.changes()->push_back(makeFieldState<StringTC, std::string>(
+      kNewPort, "portName", std::string("eth1/65/1")));
+  EXPECT_TRUE(subscriber.processPortFieldChanges(std::move(update)).empty());
+
+  update = fsdb::OperSubPathUnit();
+  update.changes()->push_back(makeFieldState<StringTC, std::string>(
+      kNewPort,
+      "portProfileID",
+      std::string("PROFILE_100G_4_NRZ_RS528_COPPER")));
+  EXPECT_EQ(
+      subscriber.processPortFieldChanges(std::move(update)),
+      std::set<int16_t>({kNewPort}));
+}
+
+TEST(FsdbSwitchStateSubscriberTest, resyncAfterReconnect) {
+  auto switchState = makeSwitchState(0);
+  FsdbSwitchStateSubscriber subscriber(nullptr);
+  subscriber.processSubscriptionStateChange(fsdb::SubscriptionState::CONNECTED);
+  subscriber.processPortFieldChanges(makeInitialSync(switchState));
+
+  // Port goes away while disconnected, the resync after reconnecting no
+  // longer carries it
+  subscriber.processSubscriptionStateChange(
+      fsdb::SubscriptionState::DISCONNECTED);
+  EXPECT_EQ(subscriber.getCachedPorts().size(), static_cast<size_t>(kNumPorts));
+  switchState.portMaps()->at(kSwitchId).erase(4);
+  subscriber.processSubscriptionStateChange(fsdb::SubscriptionState::CONNECTED);
+  auto changedPorts =
+      subscriber.processPortFieldChanges(makeInitialSync(switchState));
+  EXPECT_EQ(changedPorts.size(), static_cast<size_t>(kNumPorts - 1));
+  EXPECT_EQ(changedPorts.count(4), 0);
+  checkPorts(subscriber, switchState);
+}
+
+/*
+ * A port flap with routes in the switch state: a whole switch state
+ * subscription, as LED Service used, decodes every route along with the
+ * ports, while the port field subscription decodes only the changed field.
+ */
+TEST(FsdbSwitchStateSubscriberTest, portFlapDecodesChangedField) {
+  constexpr size_t kNumRoutes = 4096;
+  auto switchState = makeSwitchState(kNumRoutes);
+  auto& port = switchState.portMaps()->at(kSwitchId).at(1);
+  port.portOperState() = !*port.portOperState();
+
+  FsdbSwitchStateSubscriber subscriber(nullptr);
+  subscriber.processPortFieldChanges(makeInitialSync(switchState));
+
+  auto decoded =
+      apache::thrift::BinarySerializer::deserialize<state::SwitchState>(
+          apache::thrift::BinarySerializer::serialize<std::string>(
+              switchState));
+  EXPECT_EQ(
+      decoded.fibsMap()->at(kSwitchId).at(0).fibV6()->size(), kNumRoutes);
+  EXPECT_EQ(
+      decoded.portMaps()->at(kSwitchId).size(),
+      static_cast<size_t>(kNumPorts));
+
+  fsdb::OperSubPathUnit update;
+  update.changes()->push_back(
+      makeFieldState<apache::thrift::type_class::integral, bool>(
+          1, "portOperState", *port.portOperState()));
+  auto changedPorts = subscriber.processPortFieldChanges(std::move(update));
+  EXPECT_EQ(changedPorts, std::set<int16_t>({1}));
+  checkPorts(subscriber, switchState);
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,388 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+#ifndef POOLED_RADIX_TREE_H
+#error "This should only be included by PooledRadixTree.h"
+#endif
+
+namespace facebook::network {
+
+template <typename IPADDRTYPE, typename T>
+typename PooledRadixTreeNode<IPADDRTYPE, T>::TreeDirection
+PooledRadixTreeNode<IPADDRTYPE, T>::searchDirection(
+    const IPADDRTYPE& toSearch,
+    uint8_t toSearchMasklen) const {
+  // See RadixTreeNode::searchDirection
+  if (masklen_ < toSearchMasklen) {
+    if (toSearch.mask(masklen_) == ipAddress_) {
+      return toSearch.getNthMSBit(masklen_) == 1 ? TreeDirection::RIGHT
+                                                 : TreeDirection::LEFT;
+    } else {
+      return TreeDirection::PARENT;
+    }
+  }
+  if (masklen_ == toSearchMasklen && ipAddress_ == toSearch) {
+    return TreeDirection::THIS_NODE;
+  }
+  return TreeDirection::PARENT;
+}
+
+template <typename IPADDRTYPE, typename T>
+typename PooledRadixTree<IPADDRTYPE, T>::Index
+PooledRadixTree<IPADDRTYPE, T>::allocNode(
+    const IPADDRTYPE& ip,
+    uint8_t masklen) {
+  Index index;
+  if (freeList_ != kNullIndex) {
+    index = freeList_;
+    freeList_ = node(index).parent_;
+  } else {
+    CHECK_LT(nextUnused_, kNullIndex);
+    if ((nextUnused_ >> kSlabBits) == slabs_.size()) {
+      // Growing slabs_ moves the slab pointers, but not the slabs, so
+      // outstanding node references remain valid.
+      slabs_.push_back(std::make_unique<TreeNode[]>(kSlabSize));
+    }
+    index = nextUnused_++;
+  }
+  auto& newNode = node(index);
+  newNode.ipAddress_ = ip;
+  newNode.masklen_ = masklen;
+  newNode.left_ = kNullIndex;
+  newNode.right_ = kNullIndex;
+  newNode.parent_ = kNullIndex;
+  ++numNodes_;
+  return index;
+}
+
+template <typename IPADDRTYPE, typename T>
+void PooledRadixTree<IPADDRTYPE, T>::freeNode(Index index) {
+  auto& toFree = node(index);
+  toFree.makeNonValueNode();
+  toFree.left_ = kNullIndex;
+  toFree.right_ = kNullIndex;
+  toFree.parent_ = freeList_;
+  freeList_ = index;
+  --numNodes_;
+}
+
+template <typename IPADDRTYPE, typename T>
+typename PooledRadixTree<IPADDRTYPE, T>::Index
+PooledRadixTree<IPADDRTYPE, T>::longestMatchImpl(
+    const IPADDRTYPE& ipaddr,
+    uint8_t masklen,
+    bool& foundExact,
+    bool includeNonValueNodes) const {
+  // Can't trust the clients to have 0s in all bits after mask length
+  const auto toMatch = ipaddr.mask(masklen);
+
+  Index parent = kNullIndex;
+  Index lastValueNodeSeen = kNullIndex;
+  auto curIndex = root_;
+  auto done = false;
+  while (curIndex != kNullIndex && !done) {
+    const auto& curNode = node(curIndex);
+    auto searchDirection = curNode.searchDirection(toMatch, masklen);
+    switch (searchDirection) {
+      case TreeDirection::THIS_NODE:
+        lastValueNodeSeen =
+            curNode.isValueNode() ? curIndex : lastValueNodeSeen;
+        foundExact = curNode.isValueNode() || includeNonValueNodes;
+        done = true;
+        break;
+      case TreeDirection::LEFT:
+        lastValueNodeSeen =
+            curNode.isValueNode() ? curIndex : lastValueNodeSeen;
+        if (curNode.left_ != kNullIndex) {
+          parent = curIndex;
+          curIndex = curNode.left_;
+        } else {
+          done = true;
+        }
+        break;
+      case TreeDirection::RIGHT:
+        lastValueNodeSeen =
+            curNode.isValueNode() ? curIndex : lastValueNodeSeen;
+        if (curNode.right_ != kNullIndex) {
+          parent = curIndex;
+          curIndex = curNode.right_;
+        } else {
+          done = true;
+        }
+        break;
+      case TreeDirection::PARENT:
+        // We took one extra step in the hope of getting a better
+        // match but this didn't succeed. So back up one step
+        curIndex = parent;
+        done = true;
+        break;
+    }
+  }
+  return includeNonValueNodes ? curIndex : lastValueNodeSeen;
+}
+
+/*
+ * Mirrors RadixTree::insert, see there for why each case maintains the
+ * invariant that all non value nodes have 2 children.
+ */
+template <typename IPADDRTYPE, typename T>
+template <typename VALUE>
+std::pair<typename PooledRadixTree<IPADDRTYPE, T>::Iterator, bool>
+PooledRadixTree<IPADDRTYPE, T>::insert(
+    const IPADDRTYPE& ipaddr,
+    uint8_t mask,
+    VALUE&& value) {
+  auto foundExact = false;
+  // Can't trust the clients to have 0s in all bits after mask length
+  auto toAdd = ipaddr.mask(mask);
+  auto bestMatch = longestMatchImpl(
+      toAdd, mask, foundExact, true /*include non value nodes*/);
+  if (foundExact) {
+    // Found exact match. Check if in use
+    CHECK_NE(bestMatch, kNullIndex);
+    auto& bestMatchNode = node(bestMatch);
+    if (bestMatchNode.isNonValueNode()) {
+      bestMatchNode.setValue(std::forward<VALUE>(value));
+      ++size_;
+      return std::make_pair(Iterator(this, bestMatch), true);
+    }
+    // Prefix already exists in the tree
+    return std::make_pair(Iterator(this, bestMatch), false);
+  }
+  auto newNode = allocNode(toAdd, mask);
+  node(newNode).setValue(std::forward<VALUE>(value));
+  if (bestMatch == kNullIndex) {
+    // No match found
+    if (root_ == kNullIndex) {
+      // Empty tree, make this the root
+      makeRoot(newNode);
+    } else {
+      // The root exists but this ipaddr, mask failed to
+      // match even the root->ipaddr/mask. We need a less
+      // specific root.
+      const auto& rootNode = node(root_);
+      auto prefix = IPADDRTYPE::longestCommonPrefix(
+          {rootNode.ipAddress(), rootNode.masklen()}, {toAdd, mask});
+      auto newNodeIsRoot = prefix.first == toAdd && prefix.second == mask;
+      // Either the to be added node is the new root, or we add a new root
+      // as a non value internal node
+      auto newRoot =
+          newNodeIsRoot ? newNode : allocNode(prefix.first, prefix.second);
+      auto oldRoot = root_;
+      auto oldRootDirection = node(newRoot).searchDirection(node(oldRoot));
+      CHECK(
+          oldRootDirection == TreeDirection::LEFT ||
+          oldRootDirection == TreeDirection::RIGHT);
+      setChild(newRoot, oldRootDirection, oldRoot);
+      if (!newNodeIsRoot) {
+        setChild(
+            newRoot,
+            oldRootDirection == TreeDirection::LEFT ? TreeDirection::RIGHT
+                                                    : TreeDirection::LEFT,
+            newNode);
+      }
+      makeRoot(newRoot);
+    }
+  } else {
+    auto toAddDirection = node(bestMatch).searchDirection(toAdd, mask);
+    CHECK(
+        toAddDirection == TreeDirection::LEFT ||
+        toAddDirection == TreeDirection::RIGHT);
+    auto bestMatchChild = toAddDirection == TreeDirection::LEFT
+        ? node(bestMatch).left_
+        : node(bestMatch).right_;
+    if (bestMatchChild == kNullIndex) {
+      setChild(bestMatch, toAddDirection, newNode);
+    } else {
+      const auto& bestMatchChildNode = node(bestMatchChild);
+      auto prefix = IPADDRTYPE::longestCommonPrefix(
+          {bestMatchChildNode.ipAddress(), bestMatchChildNode.masklen()},
+          {toAdd, mask});
+      // Prefix should not already exist in the tree, see RadixTree::insert
+      DCHECK(exactMatch(prefix.first, prefix.second) == end());
+      if (prefix.first != toAdd || prefix.second != mask) {
+        // We need to insert a non value internal node as a parent of
+        // bestMatchChild and new node.
+        auto internalNode = allocNode(prefix.first, prefix.second);
+        setChild(bestMatch, toAddDirection, internalNode);
+        auto newNodeDirection =
+            node(internalNode).searchDirection(node(newNode));
+        CHECK(
+            newNodeDirection == TreeDirection::LEFT ||
+            newNodeDirection == TreeDirection::RIGHT);
+        if (newNodeDirection == TreeDirection::LEFT) {
+          setChild(internalNode, TreeDirection::LEFT, newNode);
+          setChild(internalNode, TreeDirection::RIGHT, bestMatchChild);
+        } else {
+          setChild(internalNode, TreeDirection::RIGHT, newNode);
+          setChild(internalNode, TreeDirection::LEFT, bestMatchChild);
+        }
+      } else {
+        // New node needs to be inserted  b/w bestMatch and bestMatchChild
+        setChild(bestMatch, toAddDirection, newNode);
+        auto bestMatchChildDirection =
+            node(newNode).searchDirection(node(bestMatchChild));
+        DCHECK(
+            bestMatchChildDirection == TreeDirection::LEFT ||
+            bestMatchChildDirection == TreeDirection::RIGHT);
+        setChild(newNode, bestMatchChildDirection, bestMatchChild);
+      }
+    }
+  }
+  ++size_;
+  return std::make_pair(Iterator(this, newNode), true);
+}
+
+/*
+ * Mirrors RadixTree::erase, see there for why each case maintains the
+ * invariant that all non value nodes have 2 children.
+ */
+template <typename IPADDRTYPE, typename T>
+bool PooledRadixTree<IPADDRTYPE, T>::eraseImpl(Index toDelete) {
+  if (toDelete == kNullIndex) {
+    return false;
+  }
+  auto& toDeleteNode = node(toDelete);
+  CHECK(toDeleteNode.isValueNode());
+  auto parent = toDeleteNode.parent_;
+  auto left = toDeleteNode.left_;
+  auto right = toDeleteNode.right_;
+  if (left != kNullIndex && right != kNullIndex) {
+    // Prefix is the longest common prefix of its children, keep it around
+    // as a non value node.
+    toDeleteNode.makeNonValueNode();
+  } else if (left != kNullIndex || right != kNullIndex) {
+    // toDelete has just one child, let the child's grandparent
+    // adopt it since toDelete is about to got away.
+    auto child = left != kNullIndex ? left : right;
+    if (parent != kNullIndex) {
+      replaceChild(parent, toDelete, child);
+    } else {
+      CHECK_EQ(root_, toDelete);
+      makeRoot(child);
+    }
+    freeNode(toDelete);
+  } else {
+    // toDelete has no children.
+    if (parent != kNullIndex) {
+      auto& parentNode = node(parent);
+      (parentNode.left_ == toDelete ? parentNode.left_ : parentNode.right_) =
+          kNullIndex;
+      freeNode(toDelete);
+      if (parentNode.isNonValueNode()) {
+        // toDelete's parent is a non value node and would be left with
+        // just one child, so it needs to go as well.
+        auto grandParent = parentNode.parent_;
+        auto toDeleteSibling = parentNode.left_ != kNullIndex
+            ? parentNode.left_
+            : parentNode.right_;
+        CHECK_NE(toDeleteSibling, kNullIndex);
+        parentNode.left_ = kNullIndex;
+        parentNode.right_ = kNullIndex;
+        if (grandParent != kNullIndex) {
+          replaceChild(grandParent, parent, toDeleteSibling);
+        } else {
+          CHECK_EQ(root_, parent);
+          makeRoot(toDeleteSibling);
+        }
+        freeNode(parent);
+      }
+    } else {
+      // To be deleted node has no parent and no children.
+      // Its thus the root (and only node) in the tree.
+      CHECK_EQ(root_, toDelete);
+      freeNode(toDelete);
+      root_ = kNullIndex;
+    }
+  }
+  --size_;
+  return true;
+}
+
+template <typename IPADDRTYPE, typename T>
+bool PooledRadixTree<IPADDRTYPE, T>::subTreesEqual(
+    const PooledRadixTree& r,
+    Index nodeA,
+    Index nodeB) const {
+  if (nodeA != kNullIndex && nodeB != kNullIndex) {
+    const auto& a = node(nodeA);
+    const auto& b = r.node(nodeB);
+    return a.equalSansLinks(b) && subTreesEqual(r, a.left_, b.left_) &&
+        subTreesEqual(r, a.right_, b.right_);
+  }
+  return nodeA == kNullIndex && nodeB == kNullIndex;
+}
+
+template <typename IPADDRTYPE, typename T>
+template <typename U>
+typename std::enable_if<
+    std::is_copy_constructible<U>::value,
+    PooledRadixTree<IPADDRTYPE, T>>::type
+PooledRadixTree<IPADDRTYPE, T>::clone() const {
+  static_assert(
+      std::is_same<T, U>::value,
+      "clone template type must be the same as Radix tree value type");
+  // Copy slabs node for node so that all indices (including the free
+  // list) remain valid in the copy.
+  PooledRadixTree copy;
+  copy.slabs_.reserve(slabs_.size());
+  for (Index index = 0; index < nextUnused_; ++index) {
+    if ((index >> kSlabBits) == copy.slabs_.size()) {
+      copy.slabs_.push_back(std::make_unique<TreeNode[]>(kSlabSize));
+    }
+    const auto& from = node(index);
+    auto& to = copy.node(index);
+    to.ipAddress_ = from.ipAddress_;
+    to.masklen_ = from.masklen_;
+    to.left_ = from.left_;
+    to.right_ = from.right_;
+    to.parent_ = from.parent_;
+    if (from.isValueNode()) {
+      to.setValue(from.value());
+    }
+  }
+  copy.root_ = root_;
+  copy.freeList_ = freeList_;
+  copy.nextUnused_ = nextUnused_;
+  copy.numNodes_ = numNodes_;
+  copy.size_ = size_;
+  return copy;
+}
+
+template <typename IPADDRTYPE, typename T, bool IsConst>
+void PooledRadixTreeIterator<IPADDRTYPE, T, IsConst>::increment() {
+  // Same walk as RadixTreeIteratorImpl::radixTreeItrIncrement
+  Index previous = kNullIndex;
+  auto done = false;
+  while (!done && cursor_ != kNullIndex) {
+    const auto& cursorNode = tree_->node(cursor_);
+    if (previous == kNullIndex || cursorNode.parent_ == previous) {
+      // Going down the tree
+      previous = cursor_;
+      if (cursorNode.left_ != kNullIndex) {
+        cursor_ = cursorNode.left_;
+      } else if (cursorNode.right_ != kNullIndex) {
+        cursor_ = cursorNode.right_;
+      } else {
+        cursor_ = cursorNode.parent_;
+        continue;
+      }
+    } else if (cursorNode.left_ == previous) {
+      // Coming up the tree from left.
+      previous = cursor_;
+      if (cursorNode.right_ != kNullIndex) {
+        cursor_ = cursorNode.right_;
+      } else {
+        cursor_ = cursorNode.parent_;
+        continue;
+      }
+    } else if (cursorNode.right_ == previous) {
+      // Coming up the tree from right
+      previous = cursor_;
+      cursor_ = cursorNode.parent_;
+      continue;
+    }
+    done = cursor_ == kNullIndex || includeNonValueNodes_ ||
+        tree_->node(cursor_).isValueNode();
+  }
+}
+
+} // namespace facebook::network
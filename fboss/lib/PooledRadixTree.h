@@ -0,0 +1,478 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#ifndef POOLED_RADIX_TREE_H
+#define POOLED_RADIX_TREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include <folly/Conv.h>
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+
+namespace facebook::network {
+
+template <typename IPADDRTYPE, typename T>
+class PooledRadixTree;
+
+template <typename IPADDRTYPE, typename T, bool IsConst>
+class PooledRadixTreeIterator;
+
+/*
+ * Node in PooledRadixTree. Semantically identical to RadixTreeNode, but
+ * nodes are carved out of slabs owned by the tree rather than individually
+ * heap allocated. Links to left, right and parent are 32 bit slab indices
+ * rather than pointers, there is no per node delete callback and the value
+ * is stored inline with its presence tracked by a flag that packs in with
+ * the mask length. For a std::shared_ptr value this halves the size of a V6
+ * node, before accounting for the malloc overhead RadixTreeNode pays per
+ * node.
+ *
+ * Nodes never move once allocated, so references to a node stay valid
+ * until that node is erased.
+ */
+template <typename IPADDRTYPE, typename T>
+class PooledRadixTreeNode {
+ public:
+  using Index = uint32_t;
+  static constexpr Index kNullIndex = std::numeric_limits<Index>::max();
+
+  enum class TreeDirection { LEFT, RIGHT, PARENT, THIS_NODE };
+
+  PooledRadixTreeNode() {}
+  ~PooledRadixTreeNode() {
+    makeNonValueNode();
+  }
+  PooledRadixTreeNode(const PooledRadixTreeNode&) = delete;
+  PooledRadixTreeNode& operator=(const PooledRadixTreeNode&) = delete;
+
+  const IPADDRTYPE& ipAddress() const {
+    return ipAddress_;
+  }
+  bool isNonValueNode() const {
+    return !isValueNode();
+  }
+  bool isValueNode() const {
+    return hasValue_;
+  }
+  uint32_t masklen() const {
+    return masklen_;
+  }
+  bool isLeaf() const {
+    return left_ == kNullIndex && right_ == kNullIndex;
+  }
+  const T& value() const {
+    DCHECK(hasValue_);
+    return value_;
+  }
+  T& value() {
+    DCHECK(hasValue_);
+    return value_;
+  }
+  std::string str(bool printValue = true) const {
+    auto nodeStr = folly::to<std::string>(ipAddress_.str(), "/", masklen_);
+    if (printValue) {
+      nodeStr += isNonValueNode()
+          ? "(*)"
+          : folly::to<std::string>("(", this->value(), ")");
+    }
+    return nodeStr;
+  }
+
+  // Given a IP, mask pair determine where that might lie w.r.t. this node
+  TreeDirection searchDirection(const IPADDRTYPE& toSearch, uint8_t masklen)
+      const;
+
+  TreeDirection searchDirection(const PooledRadixTreeNode& node) const {
+    return searchDirection(node.ipAddress_, node.masklen_);
+  }
+
+  // Comparison with links (left, right, parent) ignored
+  bool equalSansLinks(const PooledRadixTreeNode& r) const {
+    return ipAddress_ == r.ipAddress_ && masklen_ == r.masklen_ &&
+        isValueNode() == r.isValueNode() &&
+        (!isValueNode() || this->value() == r.value());
+  }
+
+  template <typename VALUE>
+  void setValue(VALUE&& newValue) {
+    if (hasValue_) {
+      value_ = std::forward<VALUE>(newValue);
+    } else {
+      new (&value_) T(std::forward<VALUE>(newValue));
+      hasValue_ = true;
+    }
+  }
+
+  void makeNonValueNode() {
+    if (hasValue_) {
+      value_.~T();
+      hasValue_ = false;
+    }
+  }
+
+ private:
+  friend class PooledRadixTree<IPADDRTYPE, T>;
+  friend class PooledRadixTreeIterator<IPADDRTYPE, T, true>;
+  friend class PooledRadixTreeIterator<IPADDRTYPE, T, false>;
+
+  IPADDRTYPE ipAddress_;
+  uint8_t masklen_{0}; // Number of bits to match.
+  bool hasValue_{false};
+  Index left_{kNullIndex};
+  Index right_{kNullIndex};
+  // Parent while the node is in the tree, next free node while it is on the
+  // tree's free list.
+  Index parent_{kNullIndex};
+  union {
+    T value_;
+  };
+};
+
+/*
+ * Forward Iterator to traverse a PooledRadixTree in the same DFS/preorder
+ * as RadixTreeIterator.
+ */
+template <typename IPADDRTYPE, typename T, bool IsConst>
+class PooledRadixTreeIterator {
+ public:
+  using Tree = std::conditional_t<
+      IsConst,
+      const PooledRadixTree<IPADDRTYPE, T>,
+      PooledRadixTree<IPADDRTYPE, T>>;
+  using TreeNode = std::conditional_t<
+      IsConst,
+      const PooledRadixTreeNode<IPADDRTYPE, T>,
+      PooledRadixTreeNode<IPADDRTYPE, T>>;
+  using Index = typename PooledRadixTreeNode<IPADDRTYPE, T>::Index;
+  static constexpr Index kNullIndex =
+      PooledRadixTreeNode<IPADDRTYPE, T>::kNullIndex;
+
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::remove_const_t<TreeNode>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = TreeNode*;
+  using reference = TreeNode&;
+
+  // default constructor
+  PooledRadixTreeIterator() {}
+  PooledRadixTreeIterator(
+      Tree* tree,
+      Index cursor,
+      bool includeNonValNodes = false)
+      : tree_(tree),
+        cursor_(cursor),
+        includeNonValueNodes_(includeNonValNodes) {
+    if (cursor_ != kNullIndex && !includeNonValueNodes_ &&
+        node().isNonValueNode()) {
+      ++(*this);
+    }
+  }
+
+  // Allow implicit conversion of a iterator to a const iterator
+  template <
+      bool OtherIsConst,
+      typename = std::enable_if_t<IsConst && !OtherIsConst>>
+  /* implicit */ PooledRadixTreeIterator(
+      const PooledRadixTreeIterator<IPADDRTYPE, T, OtherIsConst>& itr)
+      : tree_(itr.tree_),
+        cursor_(itr.cursor_),
+        includeNonValueNodes_(itr.includeNonValueNodes_) {}
+
+  PooledRadixTreeIterator& operator++() {
+    checkDereference(); // check if we are already at end
+    increment();
+    return *this;
+  }
+
+  PooledRadixTreeIterator operator++(int) {
+    PooledRadixTreeIterator tmp(*this);
+    ++(*this);
+    return tmp;
+  }
+
+  bool operator==(const PooledRadixTreeIterator& r) const {
+    return cursor_ == r.cursor_;
+  }
+
+  bool operator!=(const PooledRadixTreeIterator& r) const {
+    return cursor_ != r.cursor_;
+  }
+
+  TreeNode& operator*() const {
+    checkDereference();
+    return node();
+  }
+
+  TreeNode* operator->() const {
+    checkDereference();
+    return &node();
+  }
+
+  bool atEnd() const {
+    return cursor_ == kNullIndex;
+  }
+
+  bool includeNonValueNodes() const {
+    return includeNonValueNodes_;
+  }
+
+  template <typename VALUE>
+  void setValue(VALUE&& value) const {
+    static_assert(!IsConst, "Cannot set value through a const iterator");
+    checkDereference();
+    CHECK(node().isValueNode());
+    node().setValue(std::forward<VALUE>(value));
+  }
+
+ private:
+  friend class PooledRadixTree<IPADDRTYPE, T>;
+  friend class PooledRadixTreeIterator<IPADDRTYPE, T, !IsConst>;
+
+  void increment();
+  TreeNode& node() const {
+    return tree_->node(cursor_);
+  }
+  void checkDereference() const {
+    CHECK(!atEnd());
+  }
+
+  Tree* tree_{nullptr};
+  Index cursor_{kNullIndex};
+  bool includeNonValueNodes_{false};
+};
+
+/*
+ * Slab allocated radix tree with the same semantics (and tree shape, and
+ * hence iteration order) as RadixTree<IPADDRTYPE, T>, meant for trees with
+ * millions of entries where per node allocations dominate memory use and
+ * lookup cost.
+ *
+ * Nodes are allocated from fixed size slabs of kSlabSize nodes which are
+ * never moved or returned to the allocator until the tree is cleared or
+ * destroyed. Erased nodes are recycled through a free list.
+ */
+template <typename IPADDRTYPE, typename T>
+class PooledRadixTree {
+ public:
+  typedef PooledRadixTreeNode<IPADDRTYPE, T> TreeNode;
+  typedef typename TreeNode::Index Index;
+  typedef typename TreeNode::TreeDirection TreeDirection;
+  typedef PooledRadixTreeIterator<IPADDRTYPE, T, false> Iterator;
+  typedef PooledRadixTreeIterator<IPADDRTYPE, T, true> ConstIterator;
+  static constexpr Index kNullIndex = TreeNode::kNullIndex;
+  static constexpr uint32_t kSlabBits = 12;
+  static constexpr uint32_t kSlabSize = 1 << kSlabBits;
+
+  PooledRadixTree() {}
+
+  PooledRadixTree(const PooledRadixTree& r) = delete;
+  PooledRadixTree& operator=(const PooledRadixTree& r) = delete;
+
+  PooledRadixTree(PooledRadixTree&& r) noexcept {
+    *this = std::move(r);
+  }
+  PooledRadixTree& operator=(PooledRadixTree&& r) noexcept {
+    slabs_ = std::move(r.slabs_);
+    root_ = std::exchange(r.root_, kNullIndex);
+    freeList_ = std::exchange(r.freeList_, kNullIndex);
+    nextUnused_ = std::exchange(r.nextUnused_, 0);
+    numNodes_ = std::exchange(r.numNodes_, 0);
+    size_ = std::exchange(r.size_, 0);
+    r.slabs_.clear();
+    return *this;
+  }
+
+  Iterator begin() {
+    return Iterator(this, root_);
+  }
+  Iterator end() {
+    return Iterator(this, kNullIndex);
+  }
+  ConstIterator begin() const {
+    return ConstIterator(this, root_);
+  }
+  ConstIterator end() const {
+    return ConstIterator(this, kNullIndex);
+  }
+
+  // Free all nodes and clear the tree.
+  void clear() {
+    slabs_.clear();
+    root_ = kNullIndex;
+    freeList_ = kNullIndex;
+    nextUnused_ = 0;
+    numNodes_ = 0;
+    size_ = 0;
+  }
+
+  // Clone this radix tree onto another
+  template <typename U = T>
+  typename std::
+      enable_if<std::is_copy_constructible<U>::value, PooledRadixTree>::type
+      clone() const;
+
+  /*
+   * Insert a IP, mask, value in tree. Returns inserted node, true
+   * if a node was inserted. If a node for IP, mask already existed
+   * in the tree we return that node, false.
+   */
+  template <typename VALUE>
+  std::pair<Iterator, bool>
+  insert(const IPADDRTYPE& ipaddr, uint8_t masklen, VALUE&& value);
+
+  // Erase a IP, mask
+  bool erase(const IPADDRTYPE& ipaddr, uint8_t masklen) {
+    return erase(exactMatch(ipaddr, masklen));
+  }
+
+  // Erase node pointed to be iterator
+  bool erase(Iterator itr) {
+    return eraseImpl(itr.cursor_);
+  }
+
+  // Given a IP, mask return the node with longest match for it
+  // NOTE: masklen is unsigned and must be <= ipaddr.bitCount()
+  ConstIterator longestMatch(const IPADDRTYPE& ipaddr, uint8_t masklen) const {
+    auto foundExact = false;
+    return ConstIterator(this, longestMatchImpl(ipaddr, masklen, foundExact));
+  }
+
+  // Non const longest match
+  Iterator longestMatch(const IPADDRTYPE& ipaddr, uint8_t masklen) {
+    auto foundExact = false;
+    return Iterator(this, longestMatchImpl(ipaddr, masklen, foundExact));
+  }
+
+  /*
+   * Given a IP, mask return node whose IP, mask which matches this prefix
+   * exactly
+   */
+  ConstIterator exactMatch(const IPADDRTYPE& ipaddr, uint8_t masklen) const {
+    auto foundExact = false;
+    auto match = longestMatchImpl(ipaddr, masklen, foundExact);
+    return ConstIterator(this, foundExact ? match : kNullIndex);
+  }
+
+  // Non const exact match
+  Iterator exactMatch(const IPADDRTYPE& ipaddr, uint8_t masklen) {
+    auto foundExact = false;
+    auto match = longestMatchImpl(ipaddr, masklen, foundExact);
+    return Iterator(this, foundExact ? match : kNullIndex);
+  }
+
+  // Equality
+  bool operator==(const PooledRadixTree& r) const {
+    return size_ == r.size_ && subTreesEqual(r, root_, r.root_);
+  }
+
+  // Inequality
+  bool operator!=(const PooledRadixTree& r) const {
+    return !(*this == r);
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  /*
+   * Structural accessors, return nullptr where RadixTreeNode would return
+   * a null link.
+   */
+  const TreeNode* root() const {
+    return nodeIf(root_);
+  }
+  const TreeNode* left(const TreeNode& node) const {
+    return nodeIf(node.left_);
+  }
+  const TreeNode* right(const TreeNode& node) const {
+    return nodeIf(node.right_);
+  }
+  const TreeNode* parent(const TreeNode& node) const {
+    return nodeIf(node.parent_);
+  }
+
+  // Number of value and non value nodes currently in the tree
+  size_t numNodes() const {
+    return numNodes_;
+  }
+  // Bytes held by the node slabs, including free and never used nodes
+  size_t allocatedBytes() const {
+    return slabs_.size() * kSlabSize * sizeof(TreeNode) +
+        slabs_.capacity() * sizeof(typename decltype(slabs_)::value_type);
+  }
+
+ private:
+  friend class PooledRadixTreeIterator<IPADDRTYPE, T, true>;
+  friend class PooledRadixTreeIterator<IPADDRTYPE, T, false>;
+
+  TreeNode& node(Index index) {
+    return slabs_[index >> kSlabBits][index & (kSlabSize - 1)];
+  }
+  const TreeNode& node(Index index) const {
+    return slabs_[index >> kSlabBits][index & (kSlabSize - 1)];
+  }
+  const TreeNode* nodeIf(Index index) const {
+    return index == kNullIndex ? nullptr : &node(index);
+  }
+
+  Index allocNode(const IPADDRTYPE& ip, uint8_t masklen);
+  void freeNode(Index index);
+
+  void makeRoot(Index newRoot) {
+    root_ = newRoot;
+    if (newRoot != kNullIndex) {
+      node(newRoot).parent_ = kNullIndex;
+    }
+  }
+  void setChild(Index parent, TreeDirection direction, Index child) {
+    auto& parentNode = node(parent);
+    (direction == TreeDirection::LEFT ? parentNode.left_ : parentNode.right_) =
+        child;
+    if (child != kNullIndex) {
+      node(child).parent_ = parent;
+    }
+  }
+  void replaceChild(Index parent, Index oldChild, Index newChild) {
+    setChild(
+        parent,
+        node(parent).left_ == oldChild ? TreeDirection::LEFT
+                                       : TreeDirection::RIGHT,
+        newChild);
+  }
+
+  bool eraseImpl(Index toDelete);
+
+  // Worker function to do the actual longest match lookup.
+  Index longestMatchImpl(
+      const IPADDRTYPE& ipaddr,
+      uint8_t masklen,
+      bool& foundExact,
+      bool includeNonValueNodes = false) const;
+
+  bool subTreesEqual(const PooledRadixTree& r, Index nodeA, Index nodeB) const;
+
+  std::vector<std::unique_ptr<TreeNode[]>> slabs_;
+  Index root_{kNullIndex};
+  Index freeList_{kNullIndex};
+  // Nodes with index >= nextUnused_ have never been handed out
+  Index nextUnused_{0};
+  size_t numNodes_{0};
+  size_t size_{0};
+};
+
+} // namespace facebook::network
+
+#include "fboss/lib/PooledRadixTree-inl.h"
+
+#endif // POOLED_RADIX_TREE_H
@@ -0,0 +1,244 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+
+#include <folly/IPAddressV4.h>
+#include <folly/IPAddressV6.h>
+#include "common/base/Random.h"
+
+#include "fboss/lib/PooledRadixTree.h"
+#include "fboss/lib/RadixTree.h"
+
+using namespace facebook;
+using namespace facebook::network;
+using namespace std;
+
+namespace {
+using IPAddressV4 = folly::IPAddressV4;
+using IPAddressV6 = folly::IPAddressV6;
+
+template <typename IPAddrType>
+IPAddrType randomIP();
+
+template <>
+IPAddressV4 randomIP<IPAddressV4>() {
+  return IPAddressV4::fromLongHBO(folly::Random::rand32());
+}
+
+template <>
+IPAddressV6 randomIP<IPAddressV6>() {
+  std::array<uint8_t, 16> bytes;
+  for (auto& byte : bytes) {
+    byte = folly::Random::rand32(256);
+  }
+  return IPAddressV6::fromBinary(folly::ByteRange(bytes.data(), bytes.size()));
+}
+
+/*
+ * Walk both trees in lock step, every node (value and non value) must
+ * match in prefix, value and position.
+ */
+template <typename IPAddrType>
+bool sameShape(
+    const PooledRadixTree<IPAddrType, int>& pooled,
+    const PooledRadixTreeNode<IPAddrType, int>* pooledNode,
+    const RadixTreeNode<IPAddrType, int>* node) {
+  if (!pooledNode || !node) {
+    return !pooledNode && !node;
+  }
+  if (pooledNode->ipAddress() != node->ipAddress() ||
+      pooledNode->masklen() != node->masklen() ||
+      pooledNode->isValueNode() != node->isValueNode()) {
+    return false;
+  }
+  if (node->isValueNode() && pooledNode->value() != node->value()) {
+    return false;
+  }
+  return sameShape(pooled, pooled.left(*pooledNode), node->left()) &&
+      sameShape(pooled, pooled.right(*pooledNode), node->right());
+}
+
+template <typename IPAddrType>
+void expectSameTree(
+    const PooledRadixTree<IPAddrType, int>& pooled,
+    const RadixTree<IPAddrType, int>& rtree) {
+  EXPECT_EQ(rtree.size(), pooled.size());
+  EXPECT_TRUE(sameShape(pooled, pooled.root(), rtree.root()));
+  // Iteration order must match as well
+  auto pitr = pooled.begin();
+  for (auto ritr = rtree.begin(); ritr != rtree.end(); ++ritr, ++pitr) {
+    ASSERT_NE(pitr, pooled.end());
+    EXPECT_EQ(ritr->ipAddress(), pitr->ipAddress());
+    EXPECT_EQ(ritr->masklen(), pitr->masklen());
+  }
+  EXPECT_EQ(pitr, pooled.end());
+}
+
+/*
+ * Insert random prefixes into both a RadixTree and a PooledRadixTree,
+ * randomly erase some and insert again (so free nodes get reused), and
+ * check that the trees and their lookups stay identical throughout.
+ */
+template <typename IPAddrType>
+void compareWithRadixTree() {
+  RadixTree<IPAddrType, int> rtree;
+  PooledRadixTree<IPAddrType, int> pooled;
+  std::vector<std::pair<IPAddrType, uint8_t>> inserted;
+  auto const kBitCount = IPAddrType::bitCount();
+  auto const kInsertCount = 2000;
+  auto const kEraseCount = 800;
+  auto insertRandom = [&](int count) {
+    for (auto i = 0; i < count; ++i) {
+      auto mask = folly::Random::rand32(kBitCount + 1);
+      auto ip = randomIP<IPAddrType>().mask(mask);
+      auto rret = rtree.insert(ip, mask, i);
+      auto pret = pooled.insert(ip, mask, i);
+      EXPECT_EQ(rret.second, pret.second);
+      EXPECT_EQ(rret.first->value(), pret.first->value());
+      if (pret.second) {
+        inserted.emplace_back(ip, mask);
+      }
+    }
+  };
+  auto eraseRandom = [&](int count) {
+    for (auto i = 0; i < count && !inserted.empty(); ++i) {
+      auto idx = folly::Random::rand32(inserted.size());
+      auto [ip, mask] = inserted[idx];
+      EXPECT_EQ(rtree.erase(ip, mask), pooled.erase(ip, mask));
+      inserted[idx] = inserted.back();
+      inserted.pop_back();
+    }
+  };
+  auto compareLookups = [&]() {
+    for (auto i = 0; i < 1000; ++i) {
+      auto ip = randomIP<IPAddrType>();
+      auto ritr = rtree.longestMatch(ip, kBitCount);
+      auto pitr = pooled.longestMatch(ip, kBitCount);
+      ASSERT_EQ(ritr == rtree.end(), pitr == pooled.end());
+      if (ritr != rtree.end()) {
+        EXPECT_EQ(ritr->ipAddress(), pitr->ipAddress());
+        EXPECT_EQ(ritr->masklen(), pitr->masklen());
+        EXPECT_EQ(ritr->value(), pitr->value());
+      }
+    }
+  };
+
+  insertRandom(kInsertCount);
+  expectSameTree(pooled, rtree);
+  compareLookups();
+
+  eraseRandom(kEraseCount);
+  expectSameTree(pooled, rtree);
+  compareLookups();
+
+  insertRandom(kEraseCount);
+  expectSameTree(pooled, rtree);
+  compareLookups();
+}
+} // namespace
+
+TEST(PooledRadixTree, CompareWithRadixTree4) {
+  compareWithRadixTree<IPAddressV4>();
+}
+
+TEST(PooledRadixTree, CompareWithRadixTree6) {
+  compareWithRadixTree<IPAddressV6>();
+}
+
+TEST(PooledRadixTree, ExactAndLongestMatch) {
+  PooledRadixTree<IPAddressV4, int> tree;
+  tree.insert(IPAddressV4("10.0.0.0"), 8, 1);
+  tree.insert(IPAddressV4("10.1.0.0"), 16, 2);
+  tree.insert(IPAddressV4("10.2.0.0"), 16, 3);
+  // 10.1/16 and 10.2/16 need a non value node at 10.0/14
+  EXPECT_EQ(3, tree.size());
+  EXPECT_EQ(4, tree.numNodes());
+
+  EXPECT_EQ(tree.end(), tree.exactMatch(IPAddressV4("10.0.0.0"), 14));
+  EXPECT_EQ(2, tree.exactMatch(IPAddressV4("10.1.0.0"), 16)->value());
+  EXPECT_EQ(2, tree.longestMatch(IPAddressV4("10.1.2.3"), 32)->value());
+  EXPECT_EQ(1, tree.longestMatch(IPAddressV4("10.3.2.3"), 32)->value());
+  EXPECT_EQ(tree.end(), tree.longestMatch(IPAddressV4("11.0.0.1"), 32));
+  // Clients need not zero out bits beyond the mask
+  EXPECT_EQ(3, tree.exactMatch(IPAddressV4("10.2.255.255"), 16)->value());
+
+  // Re-inserting an existing prefix does not overwrite it
+  auto ret = tree.insert(IPAddressV4("10.1.0.0"), 16, 20);
+  EXPECT_FALSE(ret.second);
+  EXPECT_EQ(2, ret.first->value());
+  ret.first.setValue(20);
+  EXPECT_EQ(20, tree.exactMatch(IPAddressV4("10.1.0.0"), 16)->value());
+
+  // Erasing 10.2/16 leaves the 10.0/14 non value node with a single
+  // child, so it goes away too
+  EXPECT_TRUE(tree.erase(IPAddressV4("10.2.0.0"), 16));
+  EXPECT_FALSE(tree.erase(IPAddressV4("10.2.0.0"), 16));
+  EXPECT_EQ(2, tree.size());
+  EXPECT_EQ(2, tree.numNodes());
+
+  EXPECT_TRUE(tree.erase(tree.exactMatch(IPAddressV4("10.0.0.0"), 8)));
+  EXPECT_TRUE(tree.erase(tree.begin()));
+  EXPECT_EQ(0, tree.size());
+  EXPECT_EQ(0, tree.numNodes());
+  EXPECT_EQ(tree.begin(), tree.end());
+}
+
+TEST(PooledRadixTree, NodesAreRecycled) {
+  PooledRadixTree<IPAddressV4, int> tree;
+  std::vector<std::pair<IPAddressV4, uint8_t>> prefixes;
+  for (auto i = 0; i < 10000; ++i) {
+    auto mask = folly::Random::rand32(33);
+    prefixes.emplace_back(
+        IPAddressV4::fromLongHBO(folly::Random::rand32()).mask(mask), mask);
+  }
+  size_t allocatedBytes = 0;
+  for (auto round = 0; round < 3; ++round) {
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+      tree.insert(prefixes[i].first, prefixes[i].second, i);
+    }
+    if (round == 0) {
+      allocatedBytes = tree.allocatedBytes();
+    }
+    // Churning the same prefixes must be served from the free list
+    EXPECT_EQ(allocatedBytes, tree.allocatedBytes());
+    for (const auto& [ip, mask] : prefixes) {
+      tree.erase(ip, mask);
+    }
+    EXPECT_EQ(0, tree.size());
+    EXPECT_EQ(0, tree.numNodes());
+  }
+}
+
+TEST(PooledRadixTree, CloneAndMove) {
+  PooledRadixTree<IPAddressV6, std::shared_ptr<int>> tree;
+  // Ensure clone() works on empty trees.
+  EXPECT_TRUE(tree == tree.clone());
+  for (auto i = 0; i < 100; ++i) {
+    tree.insert(
+        randomIP<IPAddressV6>(),
+        folly::Random::rand32(129),
+        std::make_shared<int>(i));
+  }
+  // Leave some nodes on the free list, clone must preserve them
+  tree.erase(tree.begin());
+  tree.erase(tree.begin());
+
+  auto copy = tree.clone();
+  EXPECT_TRUE(tree == copy);
+  EXPECT_EQ(tree.size(), copy.size());
+  EXPECT_EQ(tree.numNodes(), copy.numNodes());
+  copy.insert(IPAddressV6("2401:db00::"), 32, std::make_shared<int>(-1));
+  EXPECT_TRUE(tree != copy);
+
+  auto size = tree.size();
+  auto moved = std::move(tree);
+  EXPECT_EQ(size, moved.size());
+  EXPECT_EQ(0, tree.size());
+  EXPECT_EQ(tree.begin(), tree.end());
+  moved = std::move(copy);
+  EXPECT_EQ(size + 1, moved.size());
+  EXPECT_EQ(
+      -1, *moved.exactMatch(IPAddressV6("2401:db00::"), 32)->value());
+}
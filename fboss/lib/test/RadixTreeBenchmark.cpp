@@ -3,10 +3,13 @@
 #include <folly/Benchmark.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
+#include <folly/memory/Malloc.h>
+#include <memory>
 #include <set>
 #include <vector>
 #include "common/base/Random.h"
 #include "common/init/Init.h"
+#include "fboss/lib/PooledRadixTree.h"
 #include "fboss/lib/RadixTree.h"
 #include "fboss/lib/test/PyRadixWrapper.h"
 
@@ -27,6 +30,10 @@ DEFINE_int32(
     lookup_count,
     5000,
     "The number of elements to look up on each lookup iteration");
+DEFINE_int32(
+    full_table_count,
+    1000000,
+    "The number of prefixes in the full table longest match benchmarks");
 namespace {
 set<Prefix4> insertSet4;
 set<Prefix4> eraseSet4;
@@ -38,6 +45,16 @@ set<Prefix6> exactMatchSet6;
 set<Prefix6> longestMatchSet6;
 vector<int> valueSet;
 
+// Full table trees are built once in main, values are shared_ptrs like in
+// the RIB so that node sizes are representative.
+using FullTableValue = std::shared_ptr<int>;
+std::unique_ptr<RadixTree<IPAddressV4, FullTableValue>> fullTable4;
+std::unique_ptr<PooledRadixTree<IPAddressV4, FullTableValue>> pooledFullTable4;
+std::unique_ptr<RadixTree<IPAddressV6, FullTableValue>> fullTable6;
+std::unique_ptr<PooledRadixTree<IPAddressV6, FullTableValue>> pooledFullTable6;
+vector<IPAddressV4> fullTableLookups4;
+vector<IPAddressV6> fullTableLookups6;
+
 // V4 Benchmarks
 template <typename TREE>
 void setupTree4(TREE& tree) {
@@ -57,6 +74,11 @@ BENCHMARK_RELATIVE(RadixTreeInsert4) {
   setupTree4(rtree);
 }
 
+BENCHMARK_RELATIVE(PooledRadixTreeInsert4) {
+  PooledRadixTree<IPAddressV4, int> rtree;
+  setupTree4(rtree);
+}
+
 BENCHMARK(PyRadixErase4) {
   PyRadixWrapper<IPAddressV4, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -77,6 +99,16 @@ BENCHMARK_RELATIVE(RadixTreeErase4) {
   }
 }
 
+BENCHMARK_RELATIVE(PooledRadixTreeErase4) {
+  PooledRadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  for (auto pfx : eraseSet4) {
+    rtree.erase(pfx.ip, pfx.mask);
+  }
+}
+
 BENCHMARK(PyRadixExactMatch4) {
   PyRadixWrapper<IPAddressV4, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -97,6 +129,16 @@ BENCHMARK_RELATIVE(RadixTreeExactMatch4) {
   }
 }
 
+BENCHMARK_RELATIVE(PooledRadixTreeExactMatch4) {
+  PooledRadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  for (auto pfx : exactMatchSet4) {
+    rtree.exactMatch(pfx.ip, pfx.mask);
+  }
+}
+
 BENCHMARK(PyRadixLongestMatch4) {
   PyRadixWrapper<IPAddressV4, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -117,6 +159,16 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch4) {
   }
 }
 
+BENCHMARK_RELATIVE(PooledRadixTreeLongestMatch4) {
+  PooledRadixTree<IPAddressV4, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree4(rtree);
+  }
+  for (auto pfx : longestMatchSet4) {
+    rtree.longestMatch(pfx.ip, pfx.mask);
+  }
+}
+
 // V6 benchmarks
 
 template <typename TREE>
@@ -137,6 +189,11 @@ BENCHMARK_RELATIVE(RadixTreeInsert6) {
   setupTree6(rtree);
 }
 
+BENCHMARK_RELATIVE(PooledRadixTreeInsert6) {
+  PooledRadixTree<IPAddressV6, int> rtree;
+  setupTree6(rtree);
+}
+
 BENCHMARK(PyRadixErase6) {
   PyRadixWrapper<IPAddressV6, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -157,6 +214,16 @@ BENCHMARK_RELATIVE(RadixTreeErase6) {
   }
 }
 
+BENCHMARK_RELATIVE(PooledRadixTreeErase6) {
+  PooledRadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  for (auto pfx : eraseSet6) {
+    rtree.erase(pfx.ip, pfx.mask);
+  }
+}
+
 BENCHMARK(PyRadixExactMatch6) {
   PyRadixWrapper<IPAddressV6, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -177,6 +244,16 @@ BENCHMARK_RELATIVE(RadixTreeExactMatch6) {
   }
 }
 
+BENCHMARK_RELATIVE(PooledRadixTreeExactMatch6) {
+  PooledRadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  for (auto pfx : exactMatchSet6) {
+    rtree.exactMatch(pfx.ip, pfx.mask);
+  }
+}
+
 BENCHMARK(PyRadixLongestMatch6) {
   PyRadixWrapper<IPAddressV6, int> pyrtree;
   BENCHMARK_SUSPEND {
@@ -197,6 +274,96 @@ BENCHMARK_RELATIVE(RadixTreeLongestMatch6) {
   }
 }
 
+BENCHMARK_RELATIVE(PooledRadixTreeLongestMatch6) {
+  PooledRadixTree<IPAddressV6, int> rtree;
+  BENCHMARK_SUSPEND {
+    setupTree6(rtree);
+  }
+  for (auto pfx : longestMatchSet6) {
+    rtree.longestMatch(pfx.ip, pfx.mask);
+  }
+}
+
+// Full table longest match benchmarks, lookups are for host addresses
+// as in the forwarding path.
+
+BENCHMARK(RadixTreeFullTableLongestMatch4) {
+  for (const auto& ip : fullTableLookups4) {
+    folly::doNotOptimizeAway(fullTable4->longestMatch(ip, 32));
+  }
+}
+
+BENCHMARK_RELATIVE(PooledRadixTreeFullTableLongestMatch4) {
+  for (const auto& ip : fullTableLookups4) {
+    folly::doNotOptimizeAway(pooledFullTable4->longestMatch(ip, 32));
+  }
+}
+
+BENCHMARK(RadixTreeFullTableLongestMatch6) {
+  for (const auto& ip : fullTableLookups6) {
+    folly::doNotOptimizeAway(fullTable6->longestMatch(ip, 128));
+  }
+}
+
+BENCHMARK_RELATIVE(PooledRadixTreeFullTableLongestMatch6) {
+  for (const auto& ip : fullTableLookups6) {
+    folly::doNotOptimizeAway(pooledFullTable6->longestMatch(ip, 128));
+  }
+}
+
+template <typename NODE>
+size_t countNodes(const NODE* node) {
+  return node ? 1 + countNodes(node->left()) + countNodes(node->right()) : 0;
+}
+
+/*
+ * RadixTree allocates every node separately, so estimate its footprint
+ * as node count times the malloc size class of a node. PooledRadixTree
+ * reports what its slabs actually take up.
+ */
+template <typename IPAddrType>
+void reportMemoryPerRoute(
+    const RadixTree<IPAddrType, FullTableValue>& rtree,
+    const PooledRadixTree<IPAddrType, FullTableValue>& pooled) {
+  auto nodes = countNodes(rtree.root());
+  auto rtreeBytes = nodes *
+      folly::goodMallocSize(
+          sizeof(RadixTreeNode<IPAddrType, FullTableValue>));
+  auto pooledBytes = pooled.allocatedBytes();
+  LOG(INFO) << "V" << (IPAddrType::bitCount() == 32 ? 4 : 6) << " "
+            << rtree.size() << " routes, " << nodes << " nodes"
+            << ", RadixTree bytes/route: " << rtreeBytes / rtree.size()
+            << ", PooledRadixTree bytes/route: "
+            << pooledBytes / pooled.size();
+}
+
+template <typename IPAddrType, typename RandomIP>
+void setupFullTable(
+    std::unique_ptr<RadixTree<IPAddrType, FullTableValue>>& rtree,
+    std::unique_ptr<PooledRadixTree<IPAddrType, FullTableValue>>& pooled,
+    vector<IPAddrType>& lookups,
+    RandomIP randomIP) {
+  rtree = std::make_unique<RadixTree<IPAddrType, FullTableValue>>();
+  pooled = std::make_unique<PooledRadixTree<IPAddrType, FullTableValue>>();
+  auto value = std::make_shared<int>(0);
+  // Internet tables are dominated by long prefixes, /24s for V4 and /48s
+  // for V6, skew masks towards those.
+  auto const kBitCount = IPAddrType::bitCount();
+  auto const kMinMask = kBitCount == 32 ? 8 : 16;
+  auto const kMaxMask = kBitCount == 32 ? 24 : 48;
+  while (rtree->size() < FLAGS_full_table_count) {
+    auto mask = kMaxMask - folly::Random::rand32(kMaxMask - kMinMask + 1) / 4;
+    auto ip = randomIP().mask(mask);
+    if (rtree->insert(ip, mask, value).second) {
+      pooled->insert(ip, mask, value);
+    }
+  }
+  lookups.clear();
+  for (auto i = 0; i < FLAGS_lookup_count; ++i) {
+    lookups.push_back(randomIP());
+  }
+}
+
 } // namespace
 
 int main(int /*argc*/, char* /*argv*/[]) {
@@ -252,5 +419,17 @@ int main(int /*argc*/, char* /*argv*/[]) {
     auto newIp = pfx.ip.mask(newMask);
     longestMatchSet6.insert(Prefix6(newIp, newMask));
   }
+
+  setupFullTable(fullTable4, pooledFullTable4, fullTableLookups4, []() {
+    return IPAddressV4::fromLongHBO(folly::Random::rand32());
+  });
+  setupFullTable(fullTable6, pooledFullTable6, fullTableLookups6, []() {
+    ByteArray16 ba;
+    *(uint64_t*)(ba.data()) = folly::Random::rand64();
+    *(uint64_t*)(&ba[8]) = folly::Random::rand64();
+    return IPAddressV6(ba);
+  });
+  reportMemoryPerRoute(*fullTable4, *pooledFullTable4);
+  reportMemoryPerRoute(*fullTable6, *pooledFullTable6);
   runBenchmarks();
 }
@@ -2,9 +2,15 @@
 
 #include "fboss/platform/helpers/PlatformFsUtils.h"
 
+#include <poll.h>
+#include <sys/inotify.h>
+#include <algorithm>
+#include <array>
 #include <filesystem>
+#include <thread>
 
 #include <folly/FileUtil.h>
+#include <folly/ScopeGuard.h>
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
 
@@ -12,6 +18,10 @@ namespace fs = std::filesystem;
 
 namespace {
 
+// Interval at which waitForPath re-checks the path in absence of inotify
+// events.
+constexpr auto kWaitForPathRecheckInterval = std::chrono::milliseconds(50);
+
 // Convenience function. We do not use path::append (/), because for (/), if the
 // RHS is an absolute path, the LHS is just discarded, whereas we explicitly
 // treat absolute paths as relative to rootDir_. We still introduce a path
@@ -78,6 +88,71 @@ bool PlatformFsUtils::exists(const fs::path& path) const {
   return fs::exists(concat(rootDir_, path));
 }
 
+bool PlatformFsUtils::isSymlink(const fs::path& path) const {
+  std::error_code errCode;
+  return fs::is_symlink(concat(rootDir_, path), errCode);
+}
+
+bool PlatformFsUtils::waitForPath(
+    const fs::path& path,
+    std::chrono::milliseconds timeout) const {
+  const auto prefixedPath = concat(rootDir_, path);
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  // Without inotify, fall back to only re-checking periodically.
+  int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  SCOPE_EXIT {
+    if (inotifyFd >= 0) {
+      folly::closeNoInt(inotifyFd);
+    }
+  };
+  int watchFd = -1;
+  fs::path watchedPath{};
+  std::error_code errCode;
+  while (true) {
+    if (fs::exists(prefixedPath, errCode)) {
+      return true;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      return false;
+    }
+    if (inotifyFd >= 0) {
+      // Intermediate directories may show up while waiting, so keep watching
+      // the deepest one which exists.
+      auto ancestor = prefixedPath.parent_path();
+      while (ancestor.has_relative_path() && !fs::exists(ancestor, errCode)) {
+        ancestor = ancestor.parent_path();
+      }
+      if (ancestor != watchedPath) {
+        if (watchFd >= 0) {
+          inotify_rm_watch(inotifyFd, watchFd);
+        }
+        watchFd = inotify_add_watch(
+            inotifyFd, ancestor.c_str(), IN_CREATE | IN_MOVED_TO | IN_ATTRIB);
+        watchedPath = ancestor;
+        // The path may have shown up before the watch was added.
+        continue;
+      }
+    }
+    auto waitTime = std::min(
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now),
+        kWaitForPathRecheckInterval);
+    if (inotifyFd < 0) {
+      std::this_thread::sleep_for(waitTime);
+      continue;
+    }
+    struct pollfd pollFd {
+      inotifyFd, POLLIN, 0
+    };
+    if (poll(&pollFd, 1, waitTime.count()) > 0) {
+      // Drain the events, the path is checked on the next iteration.
+      std::array<char, 4096> events;
+      while (folly::readNoInt(inotifyFd, events.data(), events.size()) > 0) {
+      }
+    }
+  }
+}
+
 fs::directory_iterator PlatformFsUtils::ls(const fs::path& path) const {
   return fs::directory_iterator(concat(rootDir_, path));
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <filesystem>
 #include <optional>
 #include <string>
@@ -35,6 +36,18 @@ class PlatformFsUtils {
 
   bool exists(const std::filesystem::path& path) const;
 
+  // Whether the path itself is a symlink, without following it.
+  bool isSymlink(const std::filesystem::path& path) const;
+
+  // Wait for at most `timeout` for the given path to show up, e.g. for the
+  // kernel to create a device node. Returns as soon as the path exists, and
+  // whether it does. The deepest existing ancestor of the path is watched
+  // with inotify, and the path is also re-checked periodically since sysfs
+  // does not generate inotify events.
+  bool waitForPath(
+      const std::filesystem::path& path,
+      std::chrono::milliseconds timeout) const;
+
   std::filesystem::directory_iterator ls(
       const std::filesystem::path& path) const;
 
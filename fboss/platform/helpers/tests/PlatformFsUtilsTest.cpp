@@ -2,7 +2,9 @@
 
 #include "fboss/platform/helpers/PlatformFsUtils.h"
 
+#include <chrono>
 #include <filesystem>
+#include <thread>
 
 #include <folly/testing/TestUtil.h>
 #include <gtest/gtest.h>
@@ -67,4 +69,49 @@ TEST(PlatformFsUtilsTest, TemporaryRoot) {
       utils.getStringFileContent(tmpFilePathRelative), readContent.value());
 }
 
+TEST(PlatformFsUtilsTest, IsSymlink) {
+  auto tmpDir = folly::test::TemporaryDirectory();
+  fs::path tmpDirPath{tmpDir.path().string()};
+  PlatformFsUtils utils{tmpDirPath};
+  EXPECT_TRUE(utils.createDirectories("/sys/bus/i2c/drivers/lm75"));
+  EXPECT_TRUE(utils.createDirectories("/sys/bus/i2c/devices/1-0048"));
+  EXPECT_TRUE(utils.createDirectories("/sys/bus/i2c/devices/1-0049/driver"));
+  fs::create_directory_symlink(
+      tmpDirPath / "sys/bus/i2c/drivers/lm75",
+      tmpDirPath / "sys/bus/i2c/devices/1-0048/driver");
+
+  // Paths are relative to rootDir, and the link itself is checked.
+  EXPECT_TRUE(utils.isSymlink("/sys/bus/i2c/devices/1-0048/driver"));
+  EXPECT_TRUE(utils.exists("/sys/bus/i2c/devices/1-0048/driver"));
+  EXPECT_FALSE(utils.isSymlink("/sys/bus/i2c/devices/1-0049/driver"));
+  EXPECT_FALSE(utils.isSymlink("/sys/bus/i2c/devices/1-0050/driver"));
+}
+
+TEST(PlatformFsUtilsTest, WaitForPath) {
+  auto tmpDir = folly::test::TemporaryDirectory();
+  PlatformFsUtils utils{fs::path(tmpDir.path().string())};
+  EXPECT_TRUE(utils.createDirectories("/sys/devices"));
+
+  // Path never shows up.
+  auto begin = std::chrono::steady_clock::now();
+  EXPECT_FALSE(
+      utils.waitForPath("/sys/devices/1-0050", std::chrono::milliseconds(200)));
+  EXPECT_GE(
+      std::chrono::steady_clock::now() - begin, std::chrono::milliseconds(200));
+
+  // Path is created along with its parent directory while waiting.
+  std::thread creator([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(utils.writeStringToFile("24c64", "/sys/devices/1-0050/name"));
+  });
+  begin = std::chrono::steady_clock::now();
+  EXPECT_TRUE(
+      utils.waitForPath("/sys/devices/1-0050/name", std::chrono::seconds(5)));
+  EXPECT_LT(std::chrono::steady_clock::now() - begin, std::chrono::seconds(5));
+  creator.join();
+
+  // Path already exists.
+  EXPECT_TRUE(utils.waitForPath("/sys/devices", std::chrono::seconds(0)));
+}
+
 } // namespace facebook::fboss::platform
@@ -12,6 +12,7 @@ DataStore::DataStore(const PlatformConfig& config) : platformConfig_(config) {}
 uint16_t DataStore::getI2cBusNum(
     const std::optional<std::string>& slotPath,
     const std::string& pmUnitScopeBusName) const {
+  std::shared_lock lock(mutex_);
   auto it = i2cBusNums_.find(std::make_pair(std::nullopt, pmUnitScopeBusName));
   if (it != i2cBusNums_.end()) {
     return it->second;
@@ -30,6 +31,7 @@ void DataStore::updateI2cBusNum(
     const std::optional<std::string>& slotPath,
     const std::string& pmUnitScopeBusName,
     uint16_t busNum) {
+  std::unique_lock lock(mutex_);
   XLOG(INFO) << fmt::format(
       "Updating bus {} in {} to bus number {} (i2c-{})",
       pmUnitScopeBusName,
@@ -40,6 +42,7 @@ void DataStore::updateI2cBusNum(
 }
 
 PmUnitInfo DataStore::getPmUnitInfo(const std::string& slotPath) const {
+  std::shared_lock lock(mutex_);
   if (slotPathToPmUnitInfo.find(slotPath) != slotPathToPmUnitInfo.end()) {
     return slotPathToPmUnitInfo.at(slotPath);
   }
@@ -48,10 +51,12 @@ PmUnitInfo DataStore::getPmUnitInfo(const std::string& slotPath) const {
 }
 
 bool DataStore::hasPmUnit(const std::string& slotPath) const {
+  std::shared_lock lock(mutex_);
   return slotPathToPmUnitInfo.find(slotPath) != slotPathToPmUnitInfo.end();
 }
 
 std::string DataStore::getSysfsPath(const std::string& devicePath) const {
+  std::shared_lock lock(mutex_);
   auto itr = pciSubDevicePathToSysfsPath_.find(devicePath);
   if (itr != pciSubDevicePathToSysfsPath_.end()) {
     return itr->second;
@@ -63,17 +68,20 @@ std::string DataStore::getSysfsPath(const std::string& devicePath) const {
 void DataStore::updateSysfsPath(
     const std::string& devicePath,
     const std::string& sysfsPath) {
+  std::unique_lock lock(mutex_);
   XLOG(INFO) << fmt::format(
       "Updating SysfsPath for {} to {}", devicePath, sysfsPath);
   pciSubDevicePathToSysfsPath_[devicePath] = sysfsPath;
 }
 
 bool DataStore::hasSysfsPath(const std::string& devicePath) const {
+  std::shared_lock lock(mutex_);
   return pciSubDevicePathToSysfsPath_.find(devicePath) !=
       pciSubDevicePathToSysfsPath_.end();
 }
 
 std::string DataStore::getCharDevPath(const std::string& devicePath) const {
+  std::shared_lock lock(mutex_);
   auto itr = pciSubDevicePathToCharDevPath_.find(devicePath);
   if (itr != pciSubDevicePathToCharDevPath_.end()) {
     return itr->second;
@@ -85,6 +93,7 @@ std::string DataStore::getCharDevPath(const std::string& devicePath) const {
 void DataStore::updateCharDevPath(
     const std::string& devicePath,
     const std::string& charDevPath) {
+  std::unique_lock lock(mutex_);
   XLOG(INFO) << fmt::format(
       "Updating CharDevPath for {} to {}", devicePath, charDevPath);
   pciSubDevicePathToCharDevPath_[devicePath] = charDevPath;
@@ -125,10 +134,12 @@ void DataStore::updatePmUnitInfo(
                 *productVersion,
                 *productSubVersion)
           : "");
+  std::unique_lock lock(mutex_);
   slotPathToPmUnitInfo[slotPath] = pmUnitInfo;
 }
 
 PmUnitConfig DataStore::resolvePmUnitConfig(const std::string& slotPath) const {
+  std::shared_lock lock(mutex_);
   if (slotPathToPmUnitInfo.find(slotPath) == slotPathToPmUnitInfo.end()) {
     throw std::runtime_error(
         fmt::format("Unable to resolve PmUnitInfo for {}", slotPath));
@@ -4,11 +4,13 @@
 
 #include <map>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_config_types.h"
 
 namespace facebook::fboss::platform::platform_manager {
+// Thread safe, as sibling slots may be explored concurrently.
 class DataStore {
  public:
   explicit DataStore(const PlatformConfig& config);
@@ -94,5 +96,7 @@ class DataStore {
   std::map<std::string, PmUnitInfo> slotPathToPmUnitInfo{};
 
   const PlatformConfig& platformConfig_;
+
+  mutable std::shared_mutex mutex_;
 };
 } // namespace facebook::fboss::platform::platform_manager
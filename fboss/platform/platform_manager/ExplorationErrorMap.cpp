@@ -20,6 +20,7 @@ ExplorationErrorMap::ExplorationErrorMap(
 void ExplorationErrorMap::add(
     const std::string& devicePath,
     const std::string& message) {
+  std::lock_guard lock(mutex_);
   if (auto it = devicePathToErrors_.find(devicePath);
       it != devicePathToErrors_.end()) {
     auto& errorMessages = it->second;
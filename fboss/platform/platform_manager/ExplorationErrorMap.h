@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -43,7 +44,8 @@ class ExplorationErrorMap {
       const PlatformConfig& config,
       const DataStore& dataStore);
   virtual ~ExplorationErrorMap() = default;
-  // Add the error message happened at the devicePath.
+  // Add the error message happened at the devicePath. Thread safe, errors
+  // may be added while exploring sibling slots concurrently.
   void add(const std::string& devicePath, const std::string& message);
   void add(
       const std::string& slotPath,
@@ -65,5 +67,6 @@ class ExplorationErrorMap {
   // A map of errors occured at the devicePath.
   DeviceToErrorsMap devicePathToErrors_{};
   uint nExpectedErrs{0};
+  std::mutex mutex_;
 };
 } // namespace facebook::fboss::platform::platform_manager
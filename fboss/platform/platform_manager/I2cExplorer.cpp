@@ -6,6 +6,7 @@
 #include <folly/FileUtil.h>
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
+#include <chrono>
 #include <filesystem>
 #include <stdexcept>
 
@@ -14,7 +15,7 @@ namespace fs = std::filesystem;
 namespace {
 
 const re2::RE2 kI2cMuxChannelRegex{"channel-\\d+"};
-constexpr auto kI2cDevCreationWaitSecs = 5;
+constexpr auto kI2cDevCreationWaitSecs = std::chrono::seconds(5);
 constexpr auto kCpuI2cBusNumsWaitSecs = 1;
 
 std::string getI2cAdapterName(const fs::path& busPath) {
@@ -51,7 +52,7 @@ std::map<std::string, uint16_t> I2cExplorer::getBusNums(
   const int maxRetries = 10;
   for (int attempt = 1; attempt <= maxRetries; attempt++) {
     XLOG(INFO) << "Probing CPU I2C BusNums -- Attempt #" << attempt;
-    for (const auto& dirEntry : fs::directory_iterator(deviceRoot)) {
+    for (const auto& dirEntry : platformFsUtils_->ls(deviceRoot)) {
       if (re2::RE2::FullMatch(
               dirEntry.path().filename().string(), kI2cBusNameRegex)) {
         auto i2cAdapterName = getI2cAdapterName(dirEntry.path());
@@ -77,23 +78,22 @@ std::map<std::string, uint16_t> I2cExplorer::getBusNums(
 bool I2cExplorer::isI2cDevicePresent(uint16_t busNum, const I2cAddr& addr)
     const {
   auto path = fs::path(getDeviceI2cPath(busNum, addr)) / "driver";
-  return fs::exists(path) && fs::directory_entry(path).is_symlink();
+  return platformFsUtils_->exists(path) && platformFsUtils_->isSymlink(path);
 }
 
 std::optional<std::string> I2cExplorer::getI2cDeviceName(
     uint16_t busNum,
     const I2cAddr& addr) {
-  std::string deviceName{};
   auto deviceNameFile = fs::path(getDeviceI2cPath(busNum, addr)) / "name";
-  if (!fs::exists(deviceNameFile)) {
+  if (!platformFsUtils_->exists(deviceNameFile)) {
     XLOG(ERR) << fmt::format("{} does not exist", deviceNameFile.string());
     return std::nullopt;
   }
-  if (!folly::readFile(deviceNameFile.string().c_str(), deviceName)) {
+  auto deviceName = platformFsUtils_->getStringFileContent(deviceNameFile);
+  if (!deviceName) {
     XLOG(ERR) << fmt::format("Could not read {}", deviceNameFile.string());
-    return std::nullopt;
   }
-  return folly::trimWhitespace(deviceName).str();
+  return deviceName;
 }
 
 void I2cExplorer::setupI2cDevice(
@@ -225,11 +225,15 @@ bool I2cExplorer::isI2cDeviceCreated(uint16_t busNum, const I2cAddr& addr)
     return true;
   }
   XLOG(INFO) << fmt::format(
-      "I2cDevice at busNum: {} and addr: {} is not yet created. Waiting for {}s",
+      "I2cDevice at busNum: {} and addr: {} is not yet created. Waiting for "
+      "up to {}s",
       busNum,
       addr.hex4Str(),
+      kI2cDevCreationWaitSecs.count());
+  // The driver link shows up once the driver is bound to the device.
+  platformFsUtils_->waitForPath(
+      fs::path(getDeviceI2cPath(busNum, addr)) / "driver",
       kI2cDevCreationWaitSecs);
-  sleep(kI2cDevCreationWaitSecs);
   return isI2cDevicePresent(busNum, addr);
 }
 
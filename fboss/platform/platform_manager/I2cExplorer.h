@@ -14,6 +14,7 @@
 #include <folly/logging/xlog.h>
 #include <re2/re2.h>
 
+#include "fboss/platform/helpers/PlatformFsUtils.h"
 #include "fboss/platform/helpers/PlatformUtils.h"
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_config_types.h"
 
@@ -53,8 +54,10 @@ class I2cExplorer {
   virtual ~I2cExplorer() = default;
   I2cExplorer(
       const std::shared_ptr<PlatformUtils>& platformUtils =
-          std::make_shared<PlatformUtils>())
-      : platformUtils_(platformUtils) {}
+          std::make_shared<PlatformUtils>(),
+      const std::shared_ptr<PlatformFsUtils>& platformFsUtils =
+          std::make_shared<PlatformFsUtils>())
+      : platformUtils_(platformUtils), platformFsUtils_(platformFsUtils) {}
 
   const re2::RE2 kI2cBusNameRegex{"i2c-\\d+"};
 
@@ -109,6 +112,7 @@ class I2cExplorer {
  private:
   virtual bool isI2cDeviceCreated(uint16_t busNum, const I2cAddr& addr) const;
   std::shared_ptr<PlatformUtils> platformUtils_{};
+  std::shared_ptr<PlatformFsUtils> platformFsUtils_{};
 };
 
 } // namespace facebook::fboss::platform::platform_manager
@@ -2,11 +2,12 @@
 #include "fboss/platform/platform_manager/PciExplorer.h"
 
 #include <sys/ioctl.h>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <stdexcept>
+#include <thread>
 
-#include <folly/FileUtil.h>
 #include <folly/String.h>
 #include <folly/logging/xlog.h>
 
@@ -19,8 +20,10 @@ using namespace facebook::fboss::platform::platform_manager;
 namespace {
 const re2::RE2 kSpiBusRe{"spi\\d+"};
 const re2::RE2 kSpiDevIdRe{"spi(?P<BusNum>\\d+).(?P<ChipSelect>\\d+)"};
-// TODO (T181346009) for more granular interval retries.
-constexpr auto kPciWaitSecs = 5;
+constexpr auto kPciWaitSecs = std::chrono::seconds(5);
+// Interval at which PciSubDevice readiness is re-checked while waiting.
+constexpr auto kPciSubDeviceRecheckInterval = std::chrono::milliseconds(50);
+const auto kPciDevicesSysfsPath = fs::path("/sys/bus/pci/devices");
 
 bool hasEnding(std::string const& input, std::string const& ending) {
   if (input.length() >= ending.length()) {
@@ -56,7 +59,8 @@ PciDevice::PciDevice(
     const std::string& vendorId,
     const std::string& deviceId,
     const std::string& subSystemVendorId,
-    const std::string& subSystemDeviceId) {
+    const std::string& subSystemDeviceId,
+    const std::shared_ptr<PlatformFsUtils>& platformFsUtils) {
   charDevPath_ = fmt::format(
       "/dev/fbiob_{}.{}.{}.{}",
       std::string(vendorId, 2, 4),
@@ -64,15 +68,15 @@ PciDevice::PciDevice(
       std::string(subSystemVendorId, 2, 4),
       std::string(subSystemDeviceId, 2, 4));
 
-  if (!fs::exists(charDevPath_)) {
+  if (!platformFsUtils->exists(charDevPath_)) {
     XLOG(INFO) << fmt::format(
-        "No character device found at {} for {}. Waiting for {}s",
+        "No character device found at {} for {}. Waiting for up to {}s",
         charDevPath_,
         name,
-        kPciWaitSecs);
-    sleep(kPciWaitSecs);
+        kPciWaitSecs.count());
+    platformFsUtils->waitForPath(charDevPath_, kPciWaitSecs);
   }
-  if (!fs::exists(charDevPath_)) {
+  if (!platformFsUtils->exists(charDevPath_)) {
     throw std::runtime_error(fmt::format(
         "No character device found at {} for {}. This could either mean the "
         "FPGA does not show up as PCI device (see lspci output), or the kmods "
@@ -84,31 +88,30 @@ PciDevice::PciDevice(
   XLOG(INFO) << fmt::format(
       "Found character device {} for {}", charDevPath_, name);
 
-  for (const auto& dirEntry : fs::directory_iterator("/sys/bus/pci/devices")) {
-    std::string vendor, device, subSystemVendor, subSystemDevice;
-    auto deviceFilePath = dirEntry.path() / "device";
-    auto vendorFilePath = dirEntry.path() / "vendor";
-    auto subSystemVendorFilePath = dirEntry.path() / "subsystem_vendor";
-    auto subSystemDeviceFilePath = dirEntry.path() / "subsystem_device";
-    if (!folly::readFile(vendorFilePath.c_str(), vendor)) {
-      XLOG(ERR) << "Failed to read vendor file from " << dirEntry.path();
+  for (const auto& dirEntry : platformFsUtils->ls(kPciDevicesSysfsPath)) {
+    auto devicePath = kPciDevicesSysfsPath / dirEntry.path().filename();
+    auto vendor = platformFsUtils->getStringFileContent(devicePath / "vendor");
+    auto device = platformFsUtils->getStringFileContent(devicePath / "device");
+    auto subSystemVendor =
+        platformFsUtils->getStringFileContent(devicePath / "subsystem_vendor");
+    auto subSystemDevice =
+        platformFsUtils->getStringFileContent(devicePath / "subsystem_device");
+    if (!vendor) {
+      XLOG(ERR) << "Failed to read vendor file from " << devicePath;
     }
-    if (!folly::readFile(deviceFilePath.c_str(), device)) {
-      XLOG(ERR) << "Failed to read device file from " << dirEntry.path();
+    if (!device) {
+      XLOG(ERR) << "Failed to read device file from " << devicePath;
     }
-    if (!folly::readFile(subSystemVendorFilePath.c_str(), subSystemVendor)) {
-      XLOG(ERR) << "Failed to read subsystem_vendor file from "
-                << dirEntry.path();
+    if (!subSystemVendor) {
+      XLOG(ERR) << "Failed to read subsystem_vendor file from " << devicePath;
     }
-    if (!folly::readFile(subSystemDeviceFilePath.c_str(), subSystemDevice)) {
-      XLOG(ERR) << "Failed to read subsystem_device file from "
-                << dirEntry.path();
+    if (!subSystemDevice) {
+      XLOG(ERR) << "Failed to read subsystem_device file from " << devicePath;
     }
-    if (folly::trimWhitespace(vendor).str() == vendorId &&
-        folly::trimWhitespace(device).str() == deviceId &&
-        folly::trimWhitespace(subSystemVendor).str() == subSystemVendorId &&
-        folly::trimWhitespace(subSystemDevice).str() == subSystemDeviceId) {
-      sysfsPath_ = dirEntry.path().string();
+    if (vendor == vendorId && device == deviceId &&
+        subSystemVendor == subSystemVendorId &&
+        subSystemDevice == subSystemDeviceId) {
+      sysfsPath_ = devicePath.string();
       XLOG(INFO) << fmt::format(
           "Found sysfs path {} for device {}", sysfsPath_, name);
     }
@@ -566,15 +569,20 @@ bool PciExplorer::checkPciSubDeviceReadiness(
   }
   XLOG(INFO) << fmt::format(
       "PciSubDevice {} with deviceName {} and instId {} is not yet created "
-      "at {}. Waiting for {}s",
+      "at {}. Waiting for up to {}s",
       *fpgaIpBlockConfig.pmUnitScopedName(),
       *fpgaIpBlockConfig.deviceName(),
       instanceId,
       pciDevice.sysfsPath(),
-      kPciWaitSecs);
-  sleep(kPciWaitSecs);
-  if (isPciSubDeviceReady(pciDevice, fpgaIpBlockConfig, instanceId)) {
-    return true;
+      kPciWaitSecs.count());
+  // The name of the sub device directory is only known by its suffix, and
+  // sysfs does not generate inotify events, so poll for it.
+  auto deadline = std::chrono::steady_clock::now() + kPciWaitSecs;
+  while (std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(kPciSubDeviceRecheckInterval);
+    if (isPciSubDeviceReady(pciDevice, fpgaIpBlockConfig, instanceId)) {
+      return true;
+    }
   }
   return false;
 }
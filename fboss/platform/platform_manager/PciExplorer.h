@@ -2,8 +2,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include <re2/re2.h>
 
+#include "fboss/platform/helpers/PlatformFsUtils.h"
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_config_types.h"
 #include "fboss/platform/platform_manager/uapi/fbiob-ioctl.h"
 
@@ -16,7 +19,9 @@ struct PciDevice {
       const std::string& vendorId,
       const std::string& deviceId,
       const std::string& subSystemVendorId,
-      const std::string& subSystemDeviceId);
+      const std::string& subSystemDeviceId,
+      const std::shared_ptr<PlatformFsUtils>& platformFsUtils =
+          std::make_shared<PlatformFsUtils>());
   std::string sysfsPath() const;
   std::string charDevPath() const;
 
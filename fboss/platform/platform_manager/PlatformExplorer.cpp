@@ -6,6 +6,7 @@
 #include <chrono>
 #include <exception>
 #include <filesystem>
+#include <future>
 #include <ranges>
 #include <stdexcept>
 #include <string>
@@ -22,6 +23,13 @@
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_config_constants.h"
 #include "fboss/platform/weutil/IoctlSmbusEepromReader.h"
 
+DEFINE_bool(
+    explore_slots_concurrently,
+    false,
+    "Explore the outgoing slots of a PmUnit concurrently instead of one "
+    "after another. Kernel assigned instance and bus numbers are then no "
+    "longer stable across explorations.");
+
 namespace facebook::fboss::platform::platform_manager {
 namespace {
 constexpr auto kTotalFailures = "total_failures";
@@ -161,8 +169,10 @@ namespace constants = platform_manager_config_constants;
 
 PlatformExplorer::PlatformExplorer(
     const PlatformConfig& config,
-    const std::shared_ptr<PlatformFsUtils> platformFsUtils)
+    const std::shared_ptr<PlatformFsUtils> platformFsUtils,
+    const std::shared_ptr<PlatformUtils> platformUtils)
     : platformConfig_(config),
+      i2cExplorer_(platformUtils, platformFsUtils),
       dataStore_(platformConfig_),
       devicePathResolver_(platformConfig_, dataStore_, i2cExplorer_),
       presenceChecker_(devicePathResolver_),
@@ -236,9 +246,38 @@ void PlatformExplorer::explorePmUnit(
       pmUnitName,
       slotPath,
       pmUnitConfig.outgoingSlotConfigs_ref()->size());
-  for (const auto& [slotName, slotConfig] :
-       *pmUnitConfig.outgoingSlotConfigs()) {
-    exploreSlot(slotPath, slotName, slotConfig);
+  if (!FLAGS_explore_slots_concurrently) {
+    for (const auto& [slotName, slotConfig] :
+         *pmUnitConfig.outgoingSlotConfigs()) {
+      exploreSlot(slotPath, slotName, slotConfig);
+    }
+    return;
+  }
+  // Each slot only reads the state of this PmUnit and writes to its own
+  // SlotPath, so the slots can be explored in parallel. Most of the time
+  // is spent waiting for the kernel to create devices, so a thread per slot
+  // is fine.
+  std::vector<std::future<void>> slotExplorations;
+  for (const auto& slot : *pmUnitConfig.outgoingSlotConfigs()) {
+    slotExplorations.push_back(
+        std::async(std::launch::async, [this, &slotPath, &slot]() {
+          exploreSlot(slotPath, slot.first, slot.second);
+        }));
+  }
+  // Wait for all the slots before propagating a failure, the tasks refer
+  // to pmUnitConfig.
+  std::exception_ptr slotException;
+  for (auto& slotExploration : slotExplorations) {
+    try {
+      slotExploration.get();
+    } catch (...) {
+      if (!slotException) {
+        slotException = std::current_exception();
+      }
+    }
+  }
+  if (slotException) {
+    std::rethrow_exception(slotException);
   }
 }
 
@@ -340,17 +379,18 @@ std::optional<std::string> PlatformExplorer::getPmUnitNameFromSlot(
       eepromPath = eepromPath + "/eeprom";
     }
     try {
+      auto eepromParser = eepromParser_.wlock();
       pmUnitNameInEeprom =
-          eepromParser_.getProductName(eepromPath, *idpromConfig.offset());
+          eepromParser->getProductName(eepromPath, *idpromConfig.offset());
       // TODO: Avoid this side effect in this function.
       // I think we can refactor this simpler once I2CDevicePaths are also
       // stored in DataStore. 1/ Create IDPROMs 2/ Read contents from eepromPath
       // stored in DataStore.
-      productProductionStateInEeprom = eepromParser_.getProdutProductionState(
+      productProductionStateInEeprom = eepromParser->getProdutProductionState(
           eepromPath, *idpromConfig.offset());
       productVersionInEeprom =
-          eepromParser_.getProductVersion(eepromPath, *idpromConfig.offset());
-      productSubVersionInEeprom = eepromParser_.getProductSubVersion(
+          eepromParser->getProductVersion(eepromPath, *idpromConfig.offset());
+      productSubVersionInEeprom = eepromParser->getProductSubVersion(
           eepromPath, *idpromConfig.offset());
       XLOG(INFO) << fmt::format(
           "Found ProductProductionState `{}` ProductVersion `{}` ProductSubVersion `{}` in IDPROM {} at {}",
@@ -484,7 +524,8 @@ void PlatformExplorer::explorePciDevices(
           *pciDeviceConfig.vendorId(),
           *pciDeviceConfig.deviceId(),
           *pciDeviceConfig.subSystemVendorId(),
-          *pciDeviceConfig.subSystemDeviceId());
+          *pciDeviceConfig.subSystemDeviceId(),
+          platformFsUtils_);
       auto charDevPath = pciDevice.charDevPath();
       auto instId =
           getFpgaInstanceId(slotPath, *pciDeviceConfig.pmUnitScopedName());
@@ -584,11 +625,12 @@ uint32_t PlatformExplorer::getFpgaInstanceId(
     const std::string& slotPath,
     const std::string& fpgaName) {
   auto key = std::make_pair(slotPath, fpgaName);
-  auto it = fpgaInstanceIds_.find(key);
-  if (it == fpgaInstanceIds_.end()) {
-    fpgaInstanceIds_[key] = 1000 * (fpgaInstanceIds_.size() + 1);
+  auto fpgaInstanceIds = fpgaInstanceIds_.wlock();
+  auto it = fpgaInstanceIds->find(key);
+  if (it == fpgaInstanceIds->end()) {
+    (*fpgaInstanceIds)[key] = 1000 * (fpgaInstanceIds->size() + 1);
   }
-  return fpgaInstanceIds_[key];
+  return (*fpgaInstanceIds)[key];
 }
 
 void PlatformExplorer::createDeviceSymLink(
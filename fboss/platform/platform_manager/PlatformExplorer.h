@@ -6,7 +6,11 @@
 #include <memory>
 #include <string>
 
+#include <folly/Synchronized.h>
+#include <gflags/gflags.h>
+
 #include "fboss/platform/helpers/PlatformFsUtils.h"
+#include "fboss/platform/helpers/PlatformUtils.h"
 #include "fboss/platform/platform_manager/DataStore.h"
 #include "fboss/platform/platform_manager/DevicePathResolver.h"
 #include "fboss/platform/platform_manager/ExplorationErrorMap.h"
@@ -17,6 +21,8 @@
 #include "fboss/platform/platform_manager/gen-cpp2/platform_manager_service_types.h"
 #include "fboss/platform/weutil/CachedFbossEepromParser.h"
 
+DECLARE_bool(explore_slots_concurrently);
+
 namespace facebook::fboss::platform::platform_manager {
 class PlatformExplorer {
  public:
@@ -31,14 +37,18 @@ class PlatformExplorer {
   explicit PlatformExplorer(
       const PlatformConfig& config,
       const std::shared_ptr<PlatformFsUtils> platformFsUtils =
-          std::make_shared<PlatformFsUtils>());
+          std::make_shared<PlatformFsUtils>(),
+      const std::shared_ptr<PlatformUtils> platformUtils =
+          std::make_shared<PlatformUtils>());
 
   virtual ~PlatformExplorer() = default;
 
   // Explore the platform.
   void explore();
 
-  // Explore the PmUnit present at the given slotPath.
+  // Explore the PmUnit present at the given slotPath. The outgoing slots of
+  // the PmUnit are independent of each other, so with
+  // FLAGS_explore_slots_concurrently they are explored in parallel.
   void explorePmUnit(
       const std::string& slotPath,
       const std::string& pmUnitName);
@@ -108,9 +118,9 @@ class PlatformExplorer {
       const I2cAddr& addr);
 
   PlatformConfig platformConfig_{};
-  I2cExplorer i2cExplorer_{};
+  I2cExplorer i2cExplorer_;
   PciExplorer pciExplorer_{};
-  CachedFbossEepromParser eepromParser_{};
+  folly::Synchronized<CachedFbossEepromParser> eepromParser_{};
   DataStore dataStore_;
   DevicePathResolver devicePathResolver_;
   PresenceChecker presenceChecker_;
@@ -128,7 +138,8 @@ class PlatformExplorer {
       i2cBusNums_{};
 
   // Map from <slotPath, PmUnitScopedName> to instance ids for FPGAs.
-  std::map<std::pair<std::string, std::string>, uint32_t> fpgaInstanceIds_{};
+  folly::Synchronized<std::map<std::pair<std::string, std::string>, uint32_t>>
+      fpgaInstanceIds_{};
 
   // Map from <SlotPath, GpioChipDeviceName> to gpio chip number.
   std::map<std::pair<std::string, std::string>, uint16_t> gpioChipNums_{};
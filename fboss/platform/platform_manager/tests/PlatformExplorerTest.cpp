@@ -1,11 +1,18 @@
 // (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
 
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
 #include <fb303/ServiceData.h>
 #include <folly/FileUtil.h>
 #include <folly/testing/TestUtil.h>
 #include <gtest/gtest.h>
+#include <re2/re2.h>
 
 #include "fboss/platform/helpers/PlatformFsUtils.h"
+#include "fboss/platform/helpers/PlatformUtils.h"
 #include "fboss/platform/platform_manager/PlatformExplorer.h"
 
 using namespace ::testing;
@@ -40,6 +47,192 @@ void expectVersions(
           versionString)),
       1);
 }
+
+constexpr auto kNumLineCards = 8;
+constexpr auto kNumPortsPerLineCard = 4;
+// Time the fake kernel takes to probe a new i2c device.
+constexpr auto kI2cDeviceProbeTime = std::chrono::milliseconds(20);
+
+// Creates the sysfs entries of i2c devices instantiated through new_device
+// under rootDir, after kI2cDeviceProbeTime, the same way the kernel binds a
+// driver to the device asynchronously. platformFsUtils must be rooted at
+// rootDir.
+class FakeKernelPlatformUtils : public PlatformUtils {
+ public:
+  FakeKernelPlatformUtils(
+      const std::shared_ptr<PlatformFsUtils>& platformFsUtils,
+      const std::filesystem::path& rootDir)
+      : platformFsUtils_(platformFsUtils),
+        rootDir_(rootDir),
+        driverPath_(rootDir / "sys/bus/i2c/drivers/fake") {
+    std::filesystem::create_directories(driverPath_);
+  }
+
+  ~FakeKernelPlatformUtils() override {
+    std::lock_guard lock(mutex_);
+    for (auto& probe : probes_) {
+      probe.join();
+    }
+  }
+
+  std::pair<int, std::string> execCommand(
+      const std::string& cmd) const override {
+    static const re2::RE2 kNewDeviceRe{
+        "echo (\\S+) 0x([0-9a-f]+) > "
+        "/sys/bus/i2c/devices/i2c-(\\d+)/new_device"};
+    std::string deviceName, addr, busNum;
+    if (!re2::RE2::FullMatch(cmd, kNewDeviceRe, &deviceName, &addr, &busNum)) {
+      return {1, ""};
+    }
+    auto devicePath = fmt::format(
+        "/sys/bus/i2c/devices/{}-{:0>4}", busNum, addr);
+    std::lock_guard lock(mutex_);
+    probes_.emplace_back([this, devicePath, deviceName]() {
+      std::this_thread::sleep_for(kI2cDeviceProbeTime);
+      platformFsUtils_->writeStringToFile(deviceName, devicePath + "/name");
+      // The driver entry is a link to the driver bound to the device
+      std::error_code errCode;
+      std::filesystem::create_directory_symlink(
+          driverPath_,
+          rootDir_ / std::filesystem::path(devicePath).relative_path() /
+              "driver",
+          errCode);
+      EXPECT_FALSE(errCode) << errCode.message();
+    });
+    return {0, ""};
+  }
+
+ private:
+  std::shared_ptr<PlatformFsUtils> platformFsUtils_;
+  std::filesystem::path rootDir_;
+  std::filesystem::path driverPath_;
+  mutable std::mutex mutex_;
+  mutable std::vector<std::thread> probes_;
+};
+
+I2cDeviceConfig makeI2cDevice(
+    const std::string& name,
+    const std::string& busName,
+    const std::string& address) {
+  I2cDeviceConfig i2cDeviceConfig;
+  i2cDeviceConfig.pmUnitScopedName() = name;
+  i2cDeviceConfig.busName() = busName;
+  i2cDeviceConfig.address() = address;
+  i2cDeviceConfig.kernelDeviceName() = "lm75";
+  return i2cDeviceConfig;
+}
+
+// A modular platform with line cards, each with pluggable port modules. Every
+// PmUnit gets its own CPU buses so that all the i2c devices are distinct.
+PlatformConfig makeModularPlatformConfig() {
+  PlatformConfig config;
+  config.platformName() = "test_modular";
+  config.rootSlotType() = "ROOT_SLOT";
+  config.rootPmUnitName() = "ROOT";
+  for (const auto& [slotType, pmUnitName] :
+       {std::pair{"ROOT_SLOT", "ROOT"},
+        std::pair{"LC_SLOT", "LC"},
+        std::pair{"PORT_SLOT", "PORT"}}) {
+    SlotTypeConfig slotTypeConfig;
+    slotTypeConfig.pmUnitName() = pmUnitName;
+    config.slotTypeConfigs()[slotType] = slotTypeConfig;
+  }
+
+  config.i2cAdaptersFromCpu()->push_back("CPU_BUS_ROOT");
+  PmUnitConfig root;
+  root.pluggedInSlotType() = "ROOT_SLOT";
+  root.i2cDeviceConfigs()->push_back(
+      makeI2cDevice("ROOT_SENSOR_0", "CPU_BUS_ROOT", "0x48"));
+  root.i2cDeviceConfigs()->push_back(
+      makeI2cDevice("ROOT_SENSOR_1", "CPU_BUS_ROOT", "0x49"));
+  for (int lc = 0; lc < kNumLineCards; lc++) {
+    SlotConfig lcSlot;
+    lcSlot.slotType() = "LC_SLOT";
+    for (int bus = 0; bus <= kNumPortsPerLineCard; bus++) {
+      auto busName = fmt::format("CPU_BUS_LC{}_{}", lc, bus);
+      config.i2cAdaptersFromCpu()->push_back(busName);
+      lcSlot.outgoingI2cBusNames()->push_back(busName);
+    }
+    root.outgoingSlotConfigs()[fmt::format("LC_SLOT@{}", lc)] = lcSlot;
+  }
+  config.pmUnitConfigs()["ROOT"] = root;
+
+  PmUnitConfig lineCard;
+  lineCard.pluggedInSlotType() = "LC_SLOT";
+  for (int i = 0; i < 4; i++) {
+    lineCard.i2cDeviceConfigs()->push_back(makeI2cDevice(
+        fmt::format("LC_SENSOR_{}", i),
+        "INCOMING@0",
+        fmt::format("0x{:02x}", 0x48 + i)));
+  }
+  for (int port = 0; port < kNumPortsPerLineCard; port++) {
+    SlotConfig portSlot;
+    portSlot.slotType() = "PORT_SLOT";
+    portSlot.outgoingI2cBusNames()->push_back(
+        fmt::format("INCOMING@{}", port + 1));
+    lineCard.outgoingSlotConfigs()[fmt::format("PORT_SLOT@{}", port)] =
+        portSlot;
+  }
+  config.pmUnitConfigs()["LC"] = lineCard;
+
+  PmUnitConfig portModule;
+  portModule.pluggedInSlotType() = "PORT_SLOT";
+  portModule.i2cDeviceConfigs()->push_back(
+      makeI2cDevice("PORT_SENSOR", "INCOMING@0", "0x48"));
+  portModule.i2cDeviceConfigs()->push_back(
+      makeI2cDevice("PORT_EEPROM", "INCOMING@0", "0x50"));
+  config.pmUnitConfigs()["PORT"] = portModule;
+  return config;
+}
+
+// Explore the modular platform against a fresh fake sysfs, returns the
+// exploration wall time.
+std::chrono::milliseconds exploreModularPlatform(
+    const PlatformConfig& config,
+    size_t* numI2cDevices) {
+  auto tmpDir = folly::test::TemporaryDirectory();
+  auto platformFsUtils =
+      std::make_shared<PlatformFsUtils>(tmpDir.path().string());
+  auto busNum = 0;
+  for (const auto& adapterName : *config.i2cAdaptersFromCpu()) {
+    EXPECT_TRUE(platformFsUtils->writeStringToFile(
+        adapterName,
+        fmt::format("/sys/bus/i2c/devices/i2c-{}/name", busNum++)));
+  }
+  auto platformUtils = std::make_shared<FakeKernelPlatformUtils>(
+      platformFsUtils, std::filesystem::path(tmpDir.path().string()));
+  PlatformExplorer explorer(config, platformFsUtils, platformUtils);
+
+  auto begin = std::chrono::steady_clock::now();
+  explorer.explore();
+  auto wallTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - begin);
+
+  EXPECT_EQ(
+      *explorer.getPMStatus().explorationStatus(),
+      ExplorationStatus::SUCCEEDED);
+  for (int lc = 0; lc < kNumLineCards; lc++) {
+    auto lcSlotPath = fmt::format("/LC_SLOT@{}", lc);
+    EXPECT_EQ(*explorer.getPmUnitInfo(lcSlotPath).name(), "LC");
+    for (int port = 0; port < kNumPortsPerLineCard; port++) {
+      EXPECT_EQ(
+          *explorer
+               .getPmUnitInfo(fmt::format("{}/PORT_SLOT@{}", lcSlotPath, port))
+               .name(),
+          "PORT");
+    }
+  }
+  *numI2cDevices = 0;
+  for (const auto& entry : platformFsUtils->ls("/sys/bus/i2c/devices")) {
+    if (platformFsUtils->exists(
+            fmt::format(
+                "/sys/bus/i2c/devices/{}/driver",
+                entry.path().filename().string()))) {
+      (*numI2cDevices)++;
+    }
+  }
+  return wallTime;
+}
 } // namespace
 
 namespace facebook::fboss::platform::platform_manager {
@@ -97,4 +290,36 @@ TEST(PlatformExplorerTest, PublishFirmwareVersions) {
   expectVersions("TEST_CPLD_BADFWVER", "ERROR_INVALID_STRING", 0);
 }
 
+/*
+ * Exploration wall time of a modular platform, with slots explored one after
+ * another and concurrently. I2c devices are ready as soon as the fake kernel
+ * probes them, where exploration used to sleep 5s for each one.
+ */
+TEST(PlatformExplorerTest, ExplorationWallTime) {
+  auto config = makeModularPlatformConfig();
+  size_t numI2cDevices{0};
+
+  auto serialTime = exploreModularPlatform(config, &numI2cDevices);
+  EXPECT_EQ(
+      numI2cDevices,
+      2 + kNumLineCards * (4 + kNumPortsPerLineCard * 2));
+
+  FLAGS_explore_slots_concurrently = true;
+  auto concurrentTime = exploreModularPlatform(config, &numI2cDevices);
+  FLAGS_explore_slots_concurrently = false;
+  EXPECT_EQ(
+      numI2cDevices,
+      2 + kNumLineCards * (4 + kNumPortsPerLineCard * 2));
+
+  XLOG(INFO) << fmt::format(
+      "Explored {} PmUnits with {} i2c devices: {}ms serially, {}ms with "
+      "concurrent slots, {}s with fixed 5s waits",
+      1 + kNumLineCards * (1 + kNumPortsPerLineCard),
+      numI2cDevices,
+      serialTime.count(),
+      concurrentTime.count(),
+      numI2cDevices * 5);
+  EXPECT_LT(concurrentTime, serialTime);
+}
+
 } // namespace facebook::fboss::platform::platform_manager
@@ -1,5 +1,6 @@
 // Copyright 2021-present Facebook. All Rights Reserved.
 #include "ModbusDevice.h"
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include "Log.h"
@@ -164,18 +165,23 @@ void ModbusDevice::setBaudrate(uint32_t baud) {
   }
 }
 
-bool ModbusDevice::reloadRegister(
+bool ModbusDevice::isReloadDue(
     RegisterStore& registerStore,
-    bool singleShot) {
+    bool singleShot,
+    time_t now) {
   if (!registerStore.isEnabled()) {
     return false;
   }
   const auto& lastReg = registerStore.back();
-  time_t reloadTime = getCurrentTime();
   if (!singleShot && lastReg &&
-      (time_t)lastReg.timestamp + registerStore.interval() > reloadTime) {
+      (time_t)lastReg.timestamp + registerStore.interval() > now) {
     return false;
   }
+  return true;
+}
+
+void ModbusDevice::reloadRegister(RegisterStore& registerStore) {
+  time_t reloadTime = getCurrentTime();
   uint16_t registerOffset = registerStore.regAddr();
   try {
     std::vector<uint16_t>& value = registerStore.beginReloadRegister();
@@ -201,7 +207,56 @@ bool ModbusDevice::reloadRegister(
             << std::hex << registerOffset << ' ' << registerStore.name()
             << " caught: " << e.what() << std::endl;
   }
-  return true;
+}
+
+void ModbusDevice::reloadRegisterRange(const RegisterRead& read) {
+  if (read.registers.size() == 1) {
+    reloadRegister(*read.registers.front());
+    return;
+  }
+  time_t reloadTime = getCurrentTime();
+  std::vector<uint16_t> values(read.length);
+  try {
+    readHoldingRegisters(read.regAddr, values);
+  } catch (ModbusError& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadRange 0x" << std::hex << read.regAddr << " len "
+            << std::dec << read.length << " caught: " << e.what()
+            << std::endl;
+    if (e.errorCode == ModbusErrorCode::ILLEGAL_DATA_ADDRESS) {
+      // Either one of the registers is unsupported or the device
+      // does not allow reading through the gaps. Read them one by
+      // one to find out.
+      bool anyDisabled = false;
+      for (RegisterStore* registerStore : read.registers) {
+        if (exclusiveMode_) {
+          return;
+        }
+        reloadRegister(*registerStore);
+        if (!registerStore->isEnabled()) {
+          readPlanner_.exclude(*registerStore);
+          anyDisabled = true;
+        }
+      }
+      if (!anyDisabled) {
+        readPlanner_.isolate(read);
+      }
+    }
+    return;
+  } catch (std::exception& e) {
+    logInfo << "DEV:0x" << std::hex << int(info_.deviceAddress)
+            << " ReadRange 0x" << std::hex << read.regAddr << " len "
+            << std::dec << read.length << " caught: " << e.what()
+            << std::endl;
+    return;
+  }
+  // Split the range back into the individual registers.
+  for (RegisterStore* registerStore : read.registers) {
+    std::vector<uint16_t>& value = registerStore->beginReloadRegister();
+    auto begin = values.begin() + (registerStore->regAddr() - read.regAddr);
+    std::copy(begin, begin + value.size(), value.begin());
+    registerStore->endReloadRegister(reloadTime);
+  }
 }
 
 void ModbusDevice::reloadRegisters() {
@@ -217,15 +272,21 @@ void ModbusDevice::reloadRegisters() {
   }
   bool singleShot = singleShotReload_;
   singleShotReload_ = false;
+  time_t now = getCurrentTime();
+  std::vector<RegisterStore*> dueRegisters{};
   for (auto& registerStore : info_.registerList) {
+    if (isReloadDue(registerStore, singleShot, now)) {
+      dueRegisters.push_back(&registerStore);
+    }
+  }
+  for (const auto& read : readPlanner_.plan(dueRegisters)) {
     // Break early, if we are entering exclusive mode
     if (exclusiveMode_) {
       break;
     }
-    if (reloadRegister(registerStore, singleShot)) {
-      // Release thread to allow for higher priority tasks to execute.
-      std::this_thread::yield();
-    }
+    reloadRegisterRange(read);
+    // Release thread to allow for higher priority tasks to execute.
+    std::this_thread::yield();
   }
 }
 
@@ -238,6 +299,7 @@ void ModbusDevice::setActive() {
   for (auto& registerStore : info_.registerList) {
     registerStore.enable();
   }
+  readPlanner_.reset();
   // Clear the num failures so we consider it active.
   info_.numConsecutiveFailures = 0;
   info_.mode = ModbusDeviceMode::ACTIVE;
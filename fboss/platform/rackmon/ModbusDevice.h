@@ -9,6 +9,7 @@
 #include "Modbus.h"
 #include "ModbusCmds.h"
 #include "Register.h"
+#include "RegisterReadPlanner.h"
 
 namespace rackmon {
 
@@ -92,6 +93,7 @@ class ModbusDevice {
   bool setBaudEnabled_ = true;
   std::atomic<bool> singleShotReload_{false};
   std::atomic<bool> exclusiveMode_{false};
+  RegisterReadPlanner readPlanner_{};
 
   void handleCommandFailure(std::exception& baseException);
 
@@ -106,7 +108,9 @@ class ModbusDevice {
     setBaudrate(info_.preferredBaudrate);
   }
 
-  bool reloadRegister(RegisterStore& registerStore, bool singleShot);
+  bool isReloadDue(RegisterStore& registerStore, bool singleShot, time_t now);
+  void reloadRegister(RegisterStore& registerStore);
+  void reloadRegisterRange(const RegisterRead& read);
 
  protected:
   virtual time_t getCurrentTime() {
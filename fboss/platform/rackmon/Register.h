@@ -261,6 +261,11 @@ struct RegisterStore {
     return desc_.name;
   }
 
+  // Number of 16bit registers
+  uint16_t length() const {
+    return desc_.length;
+  }
+
   time_t interval() const {
     return desc_.interval;
   }
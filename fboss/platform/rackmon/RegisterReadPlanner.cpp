@@ -0,0 +1,49 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#include "RegisterReadPlanner.h"
+#include <algorithm>
+
+namespace rackmon {
+
+std::vector<RegisterRead> RegisterReadPlanner::plan(
+    const std::vector<RegisterStore*>& registers) const {
+  std::vector<RegisterRead> reads{};
+  // One past the last address covered by the current read.
+  uint32_t end = 0;
+  // Whether more registers can be added to the current read.
+  bool canExtend = false;
+  for (RegisterStore* reg : registers) {
+    uint32_t regBegin = reg->regAddr();
+    uint32_t regEnd = regBegin + reg->length();
+    bool isolated = isIsolated(*reg);
+    if (canExtend && !isolated && regBegin <= end + maxGap_ &&
+        !isExcluded(end, regBegin)) {
+      uint32_t newEnd = std::max(end, regEnd);
+      RegisterRead& read = reads.back();
+      if (newEnd - read.regAddr <= maxReadLength_) {
+        end = newEnd;
+        read.length = end - read.regAddr;
+        read.registers.push_back(reg);
+        continue;
+      }
+    }
+    reads.push_back(RegisterRead{reg->regAddr(), reg->length(), {reg}});
+    end = regEnd;
+    canExtend = !isolated && reg->length() <= maxReadLength_;
+  }
+  return reads;
+}
+
+void RegisterReadPlanner::isolate(const RegisterRead& read) {
+  for (const RegisterStore* reg : read.registers) {
+    isolated_.insert(reg->regAddr());
+  }
+}
+
+bool RegisterReadPlanner::isExcluded(uint32_t begin, uint32_t end) const {
+  return std::any_of(
+      excluded_.begin(), excluded_.end(), [begin, end](const auto& range) {
+        return range.first < end && range.first + range.second > begin;
+      });
+}
+
+} // namespace rackmon
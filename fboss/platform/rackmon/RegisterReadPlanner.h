@@ -0,0 +1,82 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#pragma once
+
+#include <map>
+#include <set>
+#include <vector>
+#include "Msg.h"
+#include "Register.h"
+
+namespace rackmon {
+
+// A single read holding registers transaction covering one or
+// more registers of the register map.
+struct RegisterRead {
+  // First address and number of registers to read.
+  uint16_t regAddr = 0;
+  uint16_t length = 0;
+  // Registers whose values are contained in the read, in
+  // address order.
+  std::vector<RegisterStore*> registers{};
+};
+
+// Plans the reads needed to reload a set of registers. On a RS485
+// bus every transaction pays for the request, the response header,
+// the inter-frame silence and the device turnaround, which at the
+// baudrates used are worth several registers of payload. Registers
+// which are adjacent or separated by a small gap are thus coalesced
+// into a single range read, the registers in the gap are read and
+// discarded.
+class RegisterReadPlanner {
+ public:
+  // Largest read which fits in a ReadHoldingRegistersResp,
+  // addr(1) + func(1) + bytes(1) + data(2 * N) + crc(2).
+  static constexpr uint16_t kMaxReadLength =
+      (Msg::kMaxModbusLength - 5) / 2;
+  // Largest gap (in registers) to read through, reading more
+  // than this costs more bus time than an extra transaction.
+  static constexpr uint16_t kDefaultMaxGap = 8;
+
+  explicit RegisterReadPlanner(
+      uint16_t maxGap = kDefaultMaxGap,
+      uint16_t maxReadLength = kMaxReadLength)
+      : maxGap_(maxGap), maxReadLength_(maxReadLength) {}
+
+  // Returns the reads needed for the given registers. registers
+  // is expected to be sorted by address.
+  std::vector<RegisterRead> plan(
+      const std::vector<RegisterStore*>& registers) const;
+
+  // Never coalesce the registers of the given read again. Used
+  // when the device rejected a coalesced read of registers it
+  // supports, usually because it does not allow reads through
+  // a gap in its register map.
+  void isolate(const RegisterRead& read);
+
+  // Never read through the addresses of the given register, as
+  // the device does not support it.
+  void exclude(const RegisterStore& reg) {
+    excluded_[reg.regAddr()] = reg.length();
+  }
+
+  // Forget what was learnt about the device, in case it was
+  // replaced by one with a different register set.
+  void reset() {
+    isolated_.clear();
+    excluded_.clear();
+  }
+
+ private:
+  uint16_t maxGap_;
+  uint16_t maxReadLength_;
+  std::set<uint16_t> isolated_{};
+  // Address and length of unsupported registers.
+  std::map<uint16_t, uint16_t> excluded_{};
+
+  bool isIsolated(const RegisterStore& reg) const {
+    return isolated_.find(reg.regAddr()) != isolated_.end();
+  }
+  bool isExcluded(uint32_t begin, uint32_t end) const;
+};
+
+} // namespace rackmon
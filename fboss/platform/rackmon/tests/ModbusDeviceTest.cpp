@@ -2,6 +2,7 @@
 #include "ModbusDevice.h"
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <set>
 #include <thread>
 
 using namespace std;
@@ -884,3 +885,137 @@ TEST(ModbusDeviceBaudrate, BaudrateNegotiationRejection) {
         std::get<std::string>(data.registerList[0].history[0].value), "abcd");
   }
 }
+
+// Simulates a device on a RS485 bus serving read holding registers,
+// each register reads back as its own address. Keeps track of the
+// time the transactions would keep the bus busy.
+class SimulatedUARTModbus : public Modbus {
+  // start(1) + data(8) + parity(1) + stop(1)
+  static constexpr double kBitsPerChar = 11.0;
+  // Silent interval following each frame, in chars.
+  static constexpr double kInterFrameChars = 3.5;
+  // Time taken by the device to start responding.
+  static constexpr double kTurnaroundUsec = 1000.0;
+  std::set<uint16_t> unsupported_;
+
+ public:
+  double busTimeUsec = 0;
+  int transactions = 0;
+
+  explicit SimulatedUARTModbus(const std::set<uint16_t>& unsupported)
+      : Modbus(), unsupported_(unsupported) {}
+  void command(Msg& req, Msg& resp, uint32_t baudrate, ModbusTime, Parity)
+      override {
+    Encoder::encode(req);
+    uint8_t addr = req.raw[0];
+    uint16_t offset = (req.raw[2] << 8) | req.raw[3];
+    uint16_t count = (req.raw[4] << 8) | req.raw[5];
+    bool supported = true;
+    for (uint32_t reg = offset; reg < uint32_t(offset + count); reg++) {
+      supported = supported && unsupported_.count(reg) == 0;
+    }
+    resp.clear();
+    if (supported) {
+      resp << addr << uint8_t(0x3) << uint8_t(count * 2);
+      for (uint32_t reg = offset; reg < uint32_t(offset + count); reg++) {
+        resp << uint16_t(reg);
+      }
+    } else {
+      // Illegal data address
+      resp << addr << uint8_t(0x83) << uint8_t(0x2);
+    }
+    Encoder::finalize(resp);
+    double charUsec = kBitsPerChar * 1000000.0 / baudrate;
+    busTimeUsec += (req.len + resp.len + 2 * kInterFrameChars) * charUsec +
+        kTurnaroundUsec;
+    transactions++;
+    Encoder::decode(resp);
+  }
+};
+
+TEST(ModbusDeviceBusTime, CoalescedMonitorCycle) {
+  // Layout similar to a PSU, an identification block of strings,
+  // a block of sensors, scattered flags and a few config registers
+  // far apart.
+  nlohmann::json regs = nlohmann::json::array();
+  auto addReg = [&regs](uint16_t begin, uint16_t length) {
+    nlohmann::json reg;
+    reg["begin"] = begin;
+    reg["length"] = length;
+    reg["name"] = "REG_" + std::to_string(begin);
+    regs.push_back(reg);
+  };
+  for (uint16_t i = 0; i < 6; i++) {
+    addReg(i * 8, 8);
+  }
+  for (uint16_t i = 0; i < 24; i++) {
+    addReg(0x40 + i, 1);
+  }
+  for (uint16_t i = 0; i < 8; i++) {
+    addReg(0x60 + i * 2, 1);
+  }
+  addReg(0x100, 2);
+  addReg(0x200, 2);
+  addReg(0x300, 2);
+  RegisterMap regmap;
+  regmap = nlohmann::json::parse(R"({
+    "name": "sim_psu",
+    "address_range": [[110, 140]],
+    "probe_register": 0,
+    "default_baudrate": 19200,
+    "preferred_baudrate": 19200,
+    "registers": []
+  })");
+  for (const auto& reg : regs) {
+    RegisterDescriptor desc = reg;
+    regmap.registerDescriptors[desc.begin] = desc;
+  }
+  // One of the sensors is not supported by this device.
+  constexpr uint16_t kUnsupported = 0x45;
+  SimulatedUARTModbus bus({kUnsupported});
+
+  // Before: every register is read on its own.
+  ModbusDevice perRegisterDev(bus, 0x32, regmap, 1);
+  for (auto& reg : perRegisterDev.getRawData().registerList) {
+    if (reg.regAddr() == kUnsupported) {
+      continue;
+    }
+    std::vector<uint16_t> value(reg.length());
+    perRegisterDev.readHoldingRegisters(reg.regAddr(), value);
+  }
+  double beforeUsec = bus.busTimeUsec;
+  // All 41 registers but the unsupported one.
+  EXPECT_EQ(bus.transactions, 40);
+
+  // First cycle learns about the unsupported register. Strings, sensors
+  // with the flags and the 3 config registers, then the 32 sensors and
+  // flags one by one after the range read containing it fails.
+  ModbusDeviceMockTime dev(bus, 0x32, regmap, std::time(nullptr), 1);
+  bus.busTimeUsec = 0;
+  bus.transactions = 0;
+  dev.reloadRegisters();
+  EXPECT_EQ(bus.transactions, 5 + 32);
+
+  // After: steady state monitor cycle.
+  dev.incTime(RegisterDescriptor::kDefaultInterval);
+  bus.busTimeUsec = 0;
+  bus.transactions = 0;
+  dev.reloadRegisters();
+  // Strings, sensors before 0x45, sensors after 0x45 with the flags
+  // and the 3 config registers.
+  EXPECT_EQ(bus.transactions, 6);
+  EXPECT_LT(bus.busTimeUsec, beforeUsec);
+
+  // Values are split back into the right registers.
+  for (auto& reg : dev.getRawData().registerList) {
+    if (reg.regAddr() == kUnsupported) {
+      EXPECT_FALSE(reg.isEnabled());
+      continue;
+    }
+    ASSERT_TRUE(reg.back());
+    ASSERT_EQ(reg.back().value.size(), reg.length());
+    for (uint16_t i = 0; i < reg.length(); i++) {
+      EXPECT_EQ(reg.back().value[i], reg.regAddr() + i);
+    }
+  }
+}
@@ -0,0 +1,109 @@
+// Copyright 2021-present Facebook. All Rights Reserved.
+#include "RegisterReadPlanner.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace testing;
+using namespace rackmon;
+
+class RegisterReadPlannerTest : public ::testing::Test {
+ protected:
+  // Descriptors must outlive the stores referring to them.
+  std::vector<RegisterDescriptor> descs_{};
+  std::vector<RegisterStore> stores_{};
+
+  void setRegisters(const std::vector<std::pair<uint16_t, uint16_t>>& regs) {
+    for (const auto& [begin, length] : regs) {
+      RegisterDescriptor desc{};
+      desc.begin = begin;
+      desc.length = length;
+      desc.name = "REG_" + std::to_string(begin);
+      descs_.push_back(desc);
+    }
+    for (const auto& desc : descs_) {
+      stores_.emplace_back(desc);
+    }
+  }
+
+  std::vector<RegisterStore*> registers() {
+    std::vector<RegisterStore*> ret{};
+    for (auto& store : stores_) {
+      ret.push_back(&store);
+    }
+    return ret;
+  }
+};
+
+TEST_F(RegisterReadPlannerTest, CoalesceAdjacent) {
+  setRegisters({{0, 8}, {8, 8}, {16, 2}, {18, 1}});
+  RegisterReadPlanner planner;
+  auto reads = planner.plan(registers());
+  ASSERT_EQ(reads.size(), 1);
+  EXPECT_EQ(reads[0].regAddr, 0);
+  EXPECT_EQ(reads[0].length, 19);
+  EXPECT_EQ(reads[0].registers.size(), 4);
+}
+
+TEST_F(RegisterReadPlannerTest, CoalesceNearAdjacent) {
+  // Gap of 4 is read through, gap of 9 is not.
+  setRegisters({{0, 2}, {6, 2}, {17, 2}});
+  RegisterReadPlanner planner(8);
+  auto reads = planner.plan(registers());
+  ASSERT_EQ(reads.size(), 2);
+  EXPECT_EQ(reads[0].regAddr, 0);
+  EXPECT_EQ(reads[0].length, 8);
+  EXPECT_EQ(reads[0].registers.size(), 2);
+  EXPECT_EQ(reads[1].regAddr, 17);
+  EXPECT_EQ(reads[1].length, 2);
+  EXPECT_EQ(reads[1].registers.size(), 1);
+
+  RegisterReadPlanner noGapPlanner(0);
+  EXPECT_EQ(noGapPlanner.plan(registers()).size(), 3);
+}
+
+TEST_F(RegisterReadPlannerTest, ProtocolLimit) {
+  EXPECT_EQ(RegisterReadPlanner::kMaxReadLength, 124);
+  // 3 registers of 50 do not fit in a single read.
+  setRegisters({{0, 50}, {50, 50}, {100, 50}, {150, 200}});
+  RegisterReadPlanner planner;
+  auto reads = planner.plan(registers());
+  ASSERT_EQ(reads.size(), 3);
+  EXPECT_EQ(reads[0].regAddr, 0);
+  EXPECT_EQ(reads[0].length, 100);
+  EXPECT_EQ(reads[1].regAddr, 100);
+  EXPECT_EQ(reads[1].length, 50);
+  // Larger than the limit, read on its own as before.
+  EXPECT_EQ(reads[2].regAddr, 150);
+  EXPECT_EQ(reads[2].length, 200);
+  EXPECT_EQ(reads[2].registers.size(), 1);
+}
+
+TEST_F(RegisterReadPlannerTest, IsolateAndExclude) {
+  setRegisters({{0, 2}, {2, 2}, {4, 2}, {8, 2}, {10, 2}});
+  RegisterReadPlanner planner;
+  auto all = registers();
+  ASSERT_EQ(planner.plan(all).size(), 1);
+
+  // Device rejected reading through the gap.
+  RegisterRead rejected{4, 8, {all[2], all[3], all[4]}};
+  planner.isolate(rejected);
+  auto reads = planner.plan(all);
+  ASSERT_EQ(reads.size(), 4);
+  EXPECT_EQ(reads[0].regAddr, 0);
+  EXPECT_EQ(reads[0].length, 4);
+  EXPECT_EQ(reads[1].regAddr, 4);
+  EXPECT_EQ(reads[2].regAddr, 8);
+  EXPECT_EQ(reads[3].regAddr, 10);
+
+  // Register 2 is unsupported, do not read through it.
+  planner.reset();
+  planner.exclude(*all[1]);
+  reads = planner.plan({all[0], all[2], all[3], all[4]});
+  ASSERT_EQ(reads.size(), 2);
+  EXPECT_EQ(reads[0].regAddr, 0);
+  EXPECT_EQ(reads[0].length, 2);
+  EXPECT_EQ(reads[1].regAddr, 4);
+  EXPECT_EQ(reads[1].length, 8);
+  EXPECT_EQ(reads[1].registers.size(), 3);
+}
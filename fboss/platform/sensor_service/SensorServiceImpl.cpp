@@ -12,6 +12,9 @@
 
 #include <fb303/ServiceData.h>
 #include <folly/FileUtil.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/json/dynamic.h>
 #include <folly/json/json.h>
 #include <folly/logging/xlog.h>
@@ -28,6 +31,11 @@ DEFINE_int32(
     5,
     "Interval at which stats subscriptions are served");
 
+DEFINE_uint32(
+    sensor_fetch_threads,
+    4,
+    "Number of threads reading sensors, each PmUnit is read by one thread");
+
 namespace facebook::fboss::platform::sensor_service {
 
 SensorServiceImpl::SensorServiceImpl() {
@@ -45,6 +53,12 @@ SensorServiceImpl::SensorServiceImpl() {
           fruName);
     }
   }
+  compileExpressions();
+  if (FLAGS_sensor_fetch_threads > 1) {
+    fetchExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_sensor_fetch_threads,
+        std::make_shared<folly::NamedThreadFactory>("SensorFetch"));
+  }
   fsdbSyncer_ = std::make_unique<FsdbSyncer>();
   XLOG(INFO) << "========================================================";
 }
@@ -54,6 +68,44 @@ SensorServiceImpl::~SensorServiceImpl() {
     fsdbSyncer_->stop();
   }
   fsdbSyncer_.reset();
+  if (fetchExecutor_) {
+    fetchExecutor_->join();
+  }
+}
+
+void SensorServiceImpl::compileExpressions() {
+  auto compile = [this](const std::optional<std::string>& compute) {
+    if (compute && !compiledExpressions_.count(*compute)) {
+      compiledExpressions_.emplace(*compute, CompiledExpression(*compute));
+    }
+  };
+  for (const auto& [fruName, sensorMap] : *sensorConfig_.sensorMapList()) {
+    for (const auto& [sensorName, sensor] : sensorMap) {
+      compile(sensor.compute().to_optional());
+    }
+  }
+  for (const auto& pmUnitSensors : *sensorConfig_.pmUnitSensorsList()) {
+    for (const auto& sensor : *pmUnitSensors.sensors()) {
+      compile(sensor.compute().to_optional());
+    }
+    for (const auto& versionedSensors : *pmUnitSensors.versionedSensors()) {
+      for (const auto& sensor : *versionedSensors.sensors()) {
+        compile(sensor.compute().to_optional());
+      }
+    }
+  }
+  XLOG(INFO) << fmt::format(
+      "Compiled {} sensor compute expressions", compiledExpressions_.size());
+}
+
+float SensorServiceImpl::computeExpression(
+    const std::string& compute,
+    float input) const {
+  auto it = compiledExpressions_.find(compute);
+  if (it != compiledExpressions_.end()) {
+    return it->second.evaluate(input);
+  }
+  return Utils::computeExpression(compute, input);
 }
 
 std::vector<SensorData> SensorServiceImpl::getSensorsData(
@@ -79,43 +131,57 @@ void SensorServiceImpl::fetchSensorData() {
   // Not all platforms have new sensor thrift structs.
   // If it's defined, we will use new sensor structs
   // Otherwise fall back to the existing sensors structs.
+  std::vector<FetchJob> fetchJobs;
   if (!sensorConfig_.pmUnitSensorsList()->empty()) {
     XLOG(INFO) << "Reading SensorData using PM based sensor structs...";
     for (const auto& pmUnitSensors : *sensorConfig_.pmUnitSensorsList()) {
-      auto pmSensors = *pmUnitSensors.sensors();
-      if (auto versionedPmSensors = Utils().resolveVersionedSensors(
-              pmUnitInfoFetcher_,
-              *pmUnitSensors.slotPath(),
-              *pmUnitSensors.versionedSensors())) {
+      fetchJobs.emplace_back([this, &pmUnitSensors](
+                                 uint& jobReadFailures,
+                                 std::map<std::string, SensorData>&
+                                     jobPolledData) {
+        auto pmSensors = *pmUnitSensors.sensors();
+        if (auto versionedPmSensors = Utils().resolveVersionedSensors(
+                pmUnitInfoFetcher_,
+                *pmUnitSensors.slotPath(),
+                *pmUnitSensors.versionedSensors())) {
+          XLOG(INFO) << fmt::format(
+              "Resolved to versionedPmSensors config with version {}.{}.{} for pmUnit {} at {}",
+              *versionedPmSensors->productProductionState(),
+              *versionedPmSensors->productVersion(),
+              *versionedPmSensors->productSubVersion(),
+              *pmUnitSensors.pmUnitName(),
+              *pmUnitSensors.slotPath());
+          pmSensors.insert(
+              pmSensors.end(),
+              versionedPmSensors->sensors()->begin(),
+              versionedPmSensors->sensors()->end());
+        }
         XLOG(INFO) << fmt::format(
-            "Resolved to versionedPmSensors config with version {}.{}.{} for pmUnit {} at {}",
-            *versionedPmSensors->productProductionState(),
-            *versionedPmSensors->productVersion(),
-            *versionedPmSensors->productSubVersion(),
+            "Processing {} unit {} sensors",
             *pmUnitSensors.pmUnitName(),
-            *pmUnitSensors.slotPath());
-        pmSensors.insert(
-            pmSensors.end(),
-            versionedPmSensors->sensors()->begin(),
-            versionedPmSensors->sensors()->end());
-      }
-      XLOG(INFO) << fmt::format(
-          "Processing {} unit {} sensors",
-          *pmUnitSensors.pmUnitName(),
-          pmSensors.size());
-      for (const auto& sensor : pmSensors) {
-        fetchSensorDataImpl(sensor, readFailures, polledData);
-      }
+            pmSensors.size());
+        for (const auto& sensor : pmSensors) {
+          fetchSensorDataImpl(sensor, jobReadFailures, jobPolledData);
+        }
+      });
     }
   } else {
     XLOG(INFO) << "Fetching using legacy sensor structs...";
     for (const auto& [fruName, sensorMap] : *sensorConfig_.sensorMapList()) {
-      for (const auto& [sensorName, sensor] : sensorMap) {
-        fetchSensorDataImpl(
-            std::make_pair(sensorName, sensor), readFailures, polledData);
-      }
+      fetchJobs.emplace_back([this, &sensorMap = sensorMap](
+                                 uint& jobReadFailures,
+                                 std::map<std::string, SensorData>&
+                                     jobPolledData) {
+        for (const auto& [sensorName, sensor] : sensorMap) {
+          fetchSensorDataImpl(
+              std::make_pair(sensorName, sensor),
+              jobReadFailures,
+              jobPolledData);
+        }
+      });
     }
   }
+  runFetchJobs(fetchJobs, readFailures, polledData);
   fb303::fbData->setCounter(kReadTotal, polledData.size());
   fb303::fbData->setCounter(kTotalReadFailure, readFailures);
   fb303::fbData->setCounter(kHasReadFailure, readFailures > 0 ? 1 : 0);
@@ -139,6 +205,35 @@ void SensorServiceImpl::fetchSensorData() {
   }
 }
 
+void SensorServiceImpl::runFetchJobs(
+    const std::vector<FetchJob>& jobs,
+    uint& readFailures,
+    std::map<std::string, SensorData>& polledData) {
+  if (!fetchExecutor_ || jobs.size() <= 1) {
+    for (const auto& job : jobs) {
+      job(readFailures, polledData);
+    }
+    return;
+  }
+  using JobResult = std::pair<uint, std::map<std::string, SensorData>>;
+  std::vector<folly::Future<JobResult>> futures;
+  futures.reserve(jobs.size());
+  for (const auto& job : jobs) {
+    futures.push_back(folly::via(fetchExecutor_.get(), [&job]() {
+      JobResult result{0, {}};
+      job(result.first, result.second);
+      return result;
+    }));
+  }
+  for (auto& result : folly::collectAll(std::move(futures)).get()) {
+    auto& [jobReadFailures, jobPolledData] = result.value();
+    readFailures += jobReadFailures;
+    for (auto& [sensorName, sensorData] : jobPolledData) {
+      polledData[sensorName] = std::move(sensorData);
+    }
+  }
+}
+
 template <typename T, typename>
 void SensorServiceImpl::fetchSensorDataImpl(
     const T& sensor,
@@ -194,8 +289,7 @@ SensorData SensorServiceImpl::createSensorData(
     sensorData.value() = folly::to<float>(sensorValue);
     sensorData.timeStamp() = Utils::nowInSecs();
     if (compute) {
-      sensorData.value() =
-          Utils::computeExpression(*compute, *sensorData.value());
+      sensorData.value() = computeExpression(*compute, *sensorData.value());
     }
     XLOG(DBG1) << fmt::format(
         "{} ({}) : {}", sensorName, sysfsPath, *sensorData.value());
@@ -10,18 +10,26 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 #include <folly/Synchronized.h>
 
 #include "fboss/platform/sensor_service/FsdbSyncer.h"
 #include "fboss/platform/sensor_service/PmUnitInfoFetcher.h"
+#include "fboss/platform/sensor_service/Utils.h"
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_config_types.h"
 #include "fboss/platform/sensor_service/if/gen-cpp2/sensor_service_types.h"
 
 DECLARE_int32(fsdb_statsStream_interval_seconds);
+DECLARE_uint32(sensor_fetch_threads);
+
+namespace folly {
+class CPUThreadPoolExecutor;
+}
 
 namespace facebook::fboss::platform::sensor_service {
 using namespace facebook::fboss::platform::sensor_config;
@@ -58,6 +66,16 @@ class SensorServiceImpl {
       const T& sensor,
       uint& readFailures,
       std::map<std::string, SensorData>& polledData);
+  using FetchJob =
+      std::function<void(uint&, std::map<std::string, SensorData>&)>;
+  // Run jobs on fetchExecutor_ if there is one, merging their results into
+  // readFailures and polledData.
+  void runFetchJobs(
+      const std::vector<FetchJob>& jobs,
+      uint& readFailures,
+      std::map<std::string, SensorData>& polledData);
+  void compileExpressions();
+  float computeExpression(const std::string& compute, float input) const;
   SensorData createSensorData(
       const std::string& name,
       const std::string& sysfsPath,
@@ -71,6 +89,9 @@ class SensorServiceImpl {
       publishedStatsToFsdbAt_;
   SensorConfig sensorConfig_{};
   PmUnitInfoFetcher pmUnitInfoFetcher_{};
+  // Sensor compute expressions, compiled once at config load
+  std::unordered_map<std::string, CompiledExpression> compiledExpressions_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> fetchExecutor_;
 };
 
 } // namespace facebook::fboss::platform::sensor_service
@@ -4,6 +4,7 @@
 
 #include <array>
 #include <chrono>
+#include <mutex>
 
 #include <exprtk.hpp>
 #include <re2/re2.h>
@@ -49,28 +50,49 @@ uint64_t Utils::nowInSecs() {
       .count();
 }
 
-float Utils::computeExpression(
-    const std::string& equation,
-    float input,
-    const std::string& symbol) {
-  std::string temp_equation = equation;
+struct CompiledExpression::Impl {
+  // Bound by reference into symbolTable, so Impl must not move
+  float input{0};
+  std::mutex mutex;
+  exprtk::symbol_table<float> symbolTable;
+  exprtk::expression<float> expr;
+};
+
+CompiledExpression::CompiledExpression(
+    const std::string& expression,
+    const std::string& symbol)
+    : impl_(std::make_unique<Impl>()) {
+  std::string temp_equation = expression;
 
   // Replace "@" with a valid symbol
   static const re2::RE2 atRegex("@");
 
   re2::RE2::GlobalReplace(&temp_equation, atRegex, symbol);
 
-  exprtk::symbol_table<float> symbolTable;
+  impl_->symbolTable.add_variable(symbol, impl_->input);
+  impl_->expr.register_symbol_table(impl_->symbolTable);
 
-  symbolTable.add_variable(symbol, input);
+  exprtk::parser<float> parser;
+  parser.compile(temp_equation, impl_->expr);
+}
 
-  exprtk::expression<float> expr;
-  expr.register_symbol_table(symbolTable);
+CompiledExpression::~CompiledExpression() = default;
+CompiledExpression::CompiledExpression(CompiledExpression&&) noexcept =
+    default;
+CompiledExpression& CompiledExpression::operator=(
+    CompiledExpression&&) noexcept = default;
 
-  exprtk::parser<float> parser;
-  parser.compile(temp_equation, expr);
+float CompiledExpression::evaluate(float input) const {
+  std::lock_guard<std::mutex> lock(impl_->mutex);
+  impl_->input = input;
+  return impl_->expr.value();
+}
 
-  return expr.value();
+float Utils::computeExpression(
+    const std::string& equation,
+    float input,
+    const std::string& symbol) {
+  return CompiledExpression(equation, symbol).evaluate(input);
 }
 
 std::optional<VersionedPmSensor> Utils::resolveVersionedSensors(
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,27 @@
 namespace facebook::fboss::platform::sensor_service {
 using namespace facebook::fboss::platform::sensor_config;
 
+// Expression compiled once, to be evaluated against every sample of a
+// sensor. Accepts the same expressions as Utils::computeExpression, without
+// paying for the symbol replacement, symbol table and parse on each call.
+class CompiledExpression {
+ public:
+  explicit CompiledExpression(
+      const std::string& expression,
+      const std::string& symbol = "x");
+  ~CompiledExpression();
+  CompiledExpression(CompiledExpression&&) noexcept;
+  CompiledExpression& operator=(CompiledExpression&&) noexcept;
+
+  // Safe to call from multiple threads, evaluations are serialized since
+  // they share the input variable bound into the compiled expression.
+  float evaluate(float input) const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 class Utils {
  public:
   static uint64_t nowInSecs();
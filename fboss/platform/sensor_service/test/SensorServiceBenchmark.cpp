@@ -0,0 +1,109 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include <folly/Benchmark.h>
+#include <folly/FileUtil.h>
+#include <folly/init/Init.h>
+#include <folly/testing/TestUtil.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "fboss/platform/config_lib/ConfigLib.h"
+#include "fboss/platform/sensor_service/SensorServiceImpl.h"
+#include "fboss/platform/sensor_service/Utils.h"
+
+DEFINE_int32(num_pm_units, 16, "Number of PmUnits in the sensor config");
+DEFINE_int32(
+    sensors_per_pm_unit,
+    32,
+    "Number of sensors in each PmUnit of the sensor config");
+
+using namespace facebook::fboss::platform::sensor_service;
+
+namespace {
+
+const std::vector<std::string> kComputes = {
+    "@/1000",
+    "@ * 0.1 + 5",
+    "(@ / 0.1 + 300) / (1000 * 10 + 5)",
+    "@ * 2"};
+
+// Writes a sensor config of num_pm_units x sensors_per_pm_unit sensors, each
+// backed by a file under dir, and points the config lib at it
+void writeLargeSensorConfig(const std::string& dir) {
+  SensorConfig config;
+  for (int unit = 0; unit < FLAGS_num_pm_units; unit++) {
+    PmUnitSensors pmUnitSensors;
+    pmUnitSensors.pmUnitName() = fmt::format("PM_UNIT_{}", unit);
+    pmUnitSensors.slotPath() = fmt::format("/SLOT@{}", unit);
+    for (int idx = 0; idx < FLAGS_sensors_per_pm_unit; idx++) {
+      PmSensor sensor;
+      sensor.name() = fmt::format("PM_UNIT_{}_SENSOR_{}", unit, idx);
+      sensor.sysfsPath() = fmt::format("{}/unit{}_sensor{}", dir, unit, idx);
+      sensor.type() = SensorType::TEMPERTURE;
+      sensor.compute() = kComputes[idx % kComputes.size()];
+      folly::writeFile(std::string("25000"), sensor.sysfsPath()->c_str());
+      pmUnitSensors.sensors()->push_back(std::move(sensor));
+    }
+    config.pmUnitSensorsList()->push_back(std::move(pmUnitSensors));
+  }
+  std::string fileName = dir + "/sensor_config";
+  folly::writeFile(
+      apache::thrift::SimpleJSONSerializer::serialize<std::string>(config),
+      fileName.c_str());
+  FLAGS_config_file = fileName;
+}
+
+void runPollCycles(uint32_t iters, uint32_t fetchThreads) {
+  std::unique_ptr<SensorServiceImpl> sensorServiceImpl;
+  folly::test::TemporaryDirectory tmpDir;
+  BENCHMARK_SUSPEND {
+    writeLargeSensorConfig(tmpDir.path().string());
+    FLAGS_sensor_fetch_threads = fetchThreads;
+    sensorServiceImpl = std::make_unique<SensorServiceImpl>();
+  }
+  for (uint32_t i = 0; i < iters; i++) {
+    sensorServiceImpl->fetchSensorData();
+  }
+  BENCHMARK_SUSPEND {
+    sensorServiceImpl.reset();
+  }
+}
+
+} // namespace
+
+BENCHMARK(SensorPollCycleSerial, iters) {
+  runPollCycles(iters, 1);
+}
+
+BENCHMARK_RELATIVE(SensorPollCycleParallel, iters) {
+  runPollCycles(iters, 4);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(ComputeExpressionParsed, iters) {
+  float value = 0;
+  for (uint32_t i = 0; i < iters; i++) {
+    value += Utils::computeExpression(kComputes[i % kComputes.size()], i);
+  }
+  folly::doNotOptimizeAway(value);
+}
+
+BENCHMARK_RELATIVE(ComputeExpressionCompiled, iters) {
+  std::vector<CompiledExpression> compiled;
+  BENCHMARK_SUSPEND {
+    for (const auto& compute : kComputes) {
+      compiled.emplace_back(compute);
+    }
+  }
+  float value = 0;
+  for (uint32_t i = 0; i < iters; i++) {
+    value += compiled[i % compiled.size()].evaluate(i);
+  }
+  folly::doNotOptimizeAway(value);
+}
+
+int main(int argc, char* argv[]) {
+  folly::Init init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
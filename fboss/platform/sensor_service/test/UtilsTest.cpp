@@ -55,6 +55,19 @@ TEST_F(UtilsTests, Equal) {
       0.0019354839);
 }
 
+TEST_F(UtilsTests, CompiledExpression) {
+  CompiledExpression expr("(@ / 0.1+300)/ (1000*10 + @ * 10000)");
+  EXPECT_FLOAT_EQ(expr.evaluate(30.0), 0.0019354839);
+  // Re-evaluating with a different input reuses the compiled expression
+  EXPECT_FLOAT_EQ(
+      expr.evaluate(10.0),
+      Utils::computeExpression(
+          "(@ / 0.1+300)/ (1000*10 + @ * 10000)", 10.0, "x"));
+  CompiledExpression exprY("y * 0.1/100", "y");
+  EXPECT_FLOAT_EQ(exprY.evaluate(10.0), 0.01);
+  EXPECT_FLOAT_EQ(exprY.evaluate(20.0), 0.02);
+}
+
 TEST_F(UtilsTests, PmUnitInfoFetcherTest) {
   std::optional<VersionedPmSensor> resolvedVersionedSensor;
   // Case-0: Empty version config
@@ -17,6 +17,7 @@
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "fboss/lib/phy/gen-cpp2/prbs_types.h"
 #include "fboss/lib/thrift_service_client/ThriftServiceClient.h"
+#include "fboss/qsfp_service/TransceiverRefreshScheduler.h"
 #include "fboss/qsfp_service/TransceiverStateMachineUpdate.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
@@ -59,6 +60,12 @@ DEFINE_bool(
     false,
     "Enable transceiver validation feature in qsfp_service");
 
+DEFINE_bool(
+    publish_tcvrs_as_refreshed,
+    false,
+    "Publish each transceiver to fsdb as soon as it is refreshed, instead of "
+    "publishing all of them once every transceiver is refreshed");
+
 namespace {
 constexpr auto kForceColdBootFileName = "cold_boot_once_qsfp_service";
 constexpr auto kWarmBootFlag = "can_warm_boot";
@@ -2744,7 +2751,13 @@ Transceiver* FOLLY_NULLABLE TransceiverManager::overrideTransceiverForTesting(
 std::vector<TransceiverID> TransceiverManager::refreshTransceivers(
     const std::unordered_set<TransceiverID>& transceivers) {
   std::vector<TransceiverID> transceiverIds;
-  std::vector<folly::Future<folly::Unit>> futs;
+  TransceiverRefreshScheduler::RefreshedFn onRefreshed;
+  if (FLAGS_publish_tcvrs_as_refreshed) {
+    onRefreshed = [this](const Transceiver& transceiver) {
+      publishTransceiverToFsdb(
+          transceiver.getID(), transceiver.getTransceiverInfo());
+    };
+  }
 
   {
     auto lockedTransceivers = transceivers_.rlock();
@@ -2752,6 +2765,7 @@ std::vector<TransceiverID> TransceiverManager::refreshTransceivers(
         transceivers.empty() ? lockedTransceivers->size() : transceivers.size();
     XLOG(INFO) << "Start refreshing " << nTransceivers << " transceivers...";
 
+    std::vector<Transceiver*> toRefresh;
     for (const auto& transceiver : *lockedTransceivers) {
       TransceiverID id = TransceiverID(transceiver.second->getID());
       // If we're trying to refresh a subset and this transceiver is not in
@@ -2762,14 +2776,16 @@ std::vector<TransceiverID> TransceiverManager::refreshTransceivers(
       }
       XLOG(DBG3) << "Fired to refresh TransceiverID=" << id;
       transceiverIds.push_back(id);
-      futs.push_back(transceiver.second->futureRefresh());
+      toRefresh.push_back(transceiver.second.get());
     }
 
-    folly::collectAll(futs.begin(), futs.end()).wait();
+    TransceiverRefreshScheduler(std::move(onRefreshed)).refresh(toRefresh);
     XLOG(INFO) << "Finished refreshing " << nTransceivers << " transceivers";
   }
 
-  publishTransceiversToFsdb(transceiverIds);
+  if (!FLAGS_publish_tcvrs_as_refreshed) {
+    publishTransceiversToFsdb(transceiverIds);
+  }
 
   return transceiverIds;
 }
@@ -140,6 +140,13 @@ class TransceiverManager {
   virtual void publishTransceiversToFsdb(
       const std::vector<TransceiverID>& ids) = 0;
 
+  /// Called to publish a transceiver as soon as it is refreshed, with
+  /// --publish_tcvrs_as_refreshed. Runs on the thread that refreshed it,
+  /// while transceivers_ is locked, so must not access transceivers_.
+  virtual void publishTransceiverToFsdb(
+      TransceiverID /* id */,
+      TransceiverInfo&& /* info */) {}
+
   virtual int scanTransceiverPresence(
       std::unique_ptr<std::vector<int32_t>> ids) = 0;
 
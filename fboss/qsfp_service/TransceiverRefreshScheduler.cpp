@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/qsfp_service/TransceiverRefreshScheduler.h"
+
+#include "fboss/qsfp_service/module/Transceiver.h"
+
+#include <folly/futures/Future.h>
+#include <folly/logging/xlog.h>
+
+#include <set>
+
+namespace facebook::fboss {
+
+void TransceiverRefreshScheduler::refresh(
+    const std::vector<Transceiver*>& transceivers) const {
+  std::vector<folly::Future<folly::Unit>> futs;
+  futs.reserve(transceivers.size());
+  std::vector<Transceiver*> sharedBusTransceivers;
+  std::set<const folly::EventBase*> controllers;
+
+  for (auto* transceiver : transceivers) {
+    if (!transceiver->getEvb()) {
+      sharedBusTransceivers.push_back(transceiver);
+      continue;
+    }
+    controllers.insert(transceiver->getEvb());
+    // The continuation runs on the controller's event base, right after
+    // the refresh
+    futs.push_back(transceiver->futureRefresh().thenValue(
+        [this, transceiver](auto&&) { refreshed(*transceiver); }));
+  }
+  XLOG(DBG3) << "Queued refreshes of " << futs.size() << " transceivers on "
+             << controllers.size() << " I2C controllers, refreshing "
+             << sharedBusTransceivers.size() << " on the shared bus";
+
+  // Without an event base futureRefresh() refreshes inline
+  for (auto* transceiver : sharedBusTransceivers) {
+    futs.push_back(transceiver->futureRefresh().thenValue(
+        [this, transceiver](auto&&) { refreshed(*transceiver); }));
+  }
+
+  folly::collectAll(futs.begin(), futs.end()).wait();
+}
+
+void TransceiverRefreshScheduler::refreshed(
+    const Transceiver& transceiver) const {
+  if (!onRefreshed_) {
+    return;
+  }
+  try {
+    onRefreshed_(transceiver);
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Transceiver " << transceiver.getID()
+              << ": Error handling refreshed transceiver: " << ex.what();
+  }
+}
+
+} // namespace facebook::fboss
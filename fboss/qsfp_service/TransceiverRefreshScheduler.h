@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss {
+
+class Transceiver;
+
+/*
+ * Refreshes transceivers according to the I2C bus they are behind.
+ *
+ * Transceivers behind an I2C controller with its own event base (the FPGA
+ * I2C controllers) are refreshed on it, so controllers work in parallel and
+ * each one refreshes its transceivers back to back. The other transceivers
+ * share a single bus, serialized by the platform bus lock (e.g.
+ * WedgeI2CBusLock), and are refreshed on the calling thread. That happens
+ * only after refreshes were queued on every controller, so that the shared
+ * bus does not hold them back.
+ *
+ * What each refresh reads is up to the transceiver, which refreshes its DOM
+ * and its static pages at their own cadences.
+ */
+class TransceiverRefreshScheduler {
+ public:
+  /*
+   * Called once a transceiver is refreshed, on the thread that refreshed it,
+   * so its data can be used without waiting for slower buses
+   */
+  using RefreshedFn = std::function<void(const Transceiver&)>;
+
+  explicit TransceiverRefreshScheduler(RefreshedFn onRefreshed = nullptr)
+      : onRefreshed_(std::move(onRefreshed)) {}
+
+  /*
+   * Returns once all the transceivers are refreshed and onRefreshed has
+   * returned for each of them
+   */
+  void refresh(const std::vector<Transceiver*>& transceivers) const;
+
+ private:
+  void refreshed(const Transceiver& transceiver) const;
+
+  RefreshedFn onRefreshed_;
+};
+
+} // namespace facebook::fboss
@@ -97,6 +97,24 @@ void QsfpFsdbSyncManager::updateTcvrStats(std::map<int, TcvrStats>&& stats) {
   });
 }
 
+void QsfpFsdbSyncManager::updateTcvrStats(
+    int32_t tcvrId,
+    TcvrStats&& stats) {
+  if (!FLAGS_publish_stats_to_fsdb) {
+    return;
+  }
+
+  statsSyncer_->updateState([tcvrId, stats = std::move(stats)](const auto& in) {
+    auto out = in->clone();
+    out->template modify<stats::qsfp_stats_tags::strings::tcvrStats>();
+    auto& tcvrStats =
+        out->template ref<stats::qsfp_stats_tags::strings::tcvrStats>();
+    tcvrStats->modify(folly::to<std::string>(tcvrId));
+    tcvrStats->ref(tcvrId)->fromThrift(stats);
+    return out;
+  });
+}
+
 void QsfpFsdbSyncManager::updatePhyState(
     std::string&& portName,
     std::optional<phy::PhyState>&& newState) {
@@ -37,6 +37,7 @@ class QsfpFsdbSyncManager {
   void updateConfig(cfg::QsfpServiceConfig newConfig);
   void updateTcvrState(int32_t tcvrId, TcvrState&& newState);
   void updateTcvrStats(TcvrStatsMap&& stats);
+  void updateTcvrStats(int32_t tcvrId, TcvrStats&& stats);
   void updatePhyState(
       std::string&& portName,
       std::optional<phy::PhyState>&& newState);
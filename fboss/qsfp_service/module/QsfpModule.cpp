@@ -27,6 +27,12 @@ DEFINE_int32(
     qsfp_data_refresh_interval,
     10,
     "how often to refetch qsfp data that changes frequently");
+DEFINE_int32(
+    qsfp_static_pages_refresh_interval,
+    0,
+    "how often to also refetch the qsfp pages that are static, such as "
+    "vendor info and capabilities. 0 only fetches them when a module is "
+    "detected or its cached data is invalidated");
 DEFINE_int32(
     customize_interval,
     30,
@@ -808,6 +814,7 @@ void QsfpModule::refreshLocked() {
     // make sure data is up to date before trying to customize.
     ensureOutOfReset();
     updateQsfpData(true);
+    lastStaticPagesRefreshTime_ = std::time(nullptr);
     updateCmisStateChanged(moduleStatus);
     if (present_) {
       // Data has been read for the new optics
@@ -824,9 +831,16 @@ void QsfpModule::refreshLocked() {
     }
   }
 
-  // If it's just regular refresh
+  // If it's just regular refresh. Static pages are refreshed at their own,
+  // slower cadence if one is set
   if (willRefresh) {
-    updateQsfpData(false);
+    auto refreshStaticPages = FLAGS_qsfp_static_pages_refresh_interval > 0 &&
+        std::time(nullptr) - lastStaticPagesRefreshTime_ >=
+            FLAGS_qsfp_static_pages_refresh_interval;
+    updateQsfpData(refreshStaticPages);
+    if (refreshStaticPages) {
+      lastStaticPagesRefreshTime_ = std::time(nullptr);
+    }
     updateCmisStateChanged(moduleStatus);
   }
 
@@ -350,6 +350,7 @@ class QsfpModule : public Transceiver {
    * too frequently. These MUST be accessed holding qsfpModuleMutex_.
    */
   time_t lastRefreshTime_{0};
+  time_t lastStaticPagesRefreshTime_{0};
   time_t lastRemediateTime_{0};
 
   // last time we know that no port was up on this transceiver.
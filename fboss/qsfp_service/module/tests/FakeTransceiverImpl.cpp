@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 namespace {
 // Create a copy of the lower page that's passed in, and set the module ID byte
 template <typename ArrayT, size_t MemberCount = std::extent<ArrayT>::value>
@@ -32,6 +34,10 @@ int FakeTransceiverImpl::readTransceiver(
   auto offset = param.offset;
   auto len = param.len;
   EXPECT_TRUE(dataAddress == 0x50 || dataAddress == 0x51);
+  if (readLatency_.count()) {
+    /* sleep override */
+    std::this_thread::sleep_for(readLatency_);
+  }
 
   if (offset < QsfpModule::MAX_QSFP_PAGE_SIZE) {
     read = len;
@@ -102,7 +108,10 @@ void FakeTransceiverImpl::triggerQsfpHardReset() {
 
 void FakeTransceiverImpl::updateTransceiverState(
     TransceiverStateMachineEvent event) {
-  tcvrManager_->updateStateBlocking(TransceiverID(module_), event);
+  // Transceivers may be used without a manager, e.g. in benchmarks
+  if (tcvrManager_) {
+    tcvrManager_->updateStateBlocking(TransceiverID(module_), event);
+  }
 };
 
 // Below are randomly generated eeprom maps for testing purpose and doesn't
@@ -4,6 +4,8 @@
 
 #include "fboss/qsfp_service/module/TransceiverImpl.h"
 
+#include <chrono>
+
 namespace facebook {
 namespace fboss {
 
@@ -41,6 +43,18 @@ class FakeTransceiverImpl : public TransceiverImpl {
   int getNum() const override;
   void triggerQsfpHardReset() override;
   void updateTransceiverState(TransceiverStateMachineEvent event) override;
+  folly::EventBase* getI2cEventBase() override {
+    return i2cEvb_;
+  }
+
+  /*
+   * Place the transceiver behind an I2C controller with its own event base,
+   * whose reads take readLatency each
+   */
+  void setI2cBus(folly::EventBase* i2cEvb, std::chrono::microseconds latency) {
+    i2cEvb_ = i2cEvb;
+    readLatency_ = latency;
+  }
 
  private:
   int module_{0};
@@ -49,6 +63,8 @@ class FakeTransceiverImpl : public TransceiverImpl {
   std::map<uint8_t, std::map<int, std::array<uint8_t, 128>>> upperPages_;
   std::map<uint8_t, std::array<uint8_t, 128>> lowerPages_;
   TransceiverManager* tcvrManager_;
+  folly::EventBase* i2cEvb_{nullptr};
+  std::chrono::microseconds readLatency_{0};
 };
 
 class SffDacTransceiver : public FakeTransceiverImpl {
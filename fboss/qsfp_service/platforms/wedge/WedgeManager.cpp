@@ -519,6 +519,23 @@ void WedgeManager::publishTransceiversToFsdb(
   fsdbSyncManager_->updateTcvrStats(std::move(stats));
 }
 
+void WedgeManager::publishTransceiverToFsdb(
+    TransceiverID id,
+    TransceiverInfo&& info) {
+  if (!FLAGS_publish_stats_to_fsdb) {
+    return;
+  }
+
+  try {
+    info.tcvrState()->stateMachineState() = getCurrentState(id);
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Transceiver " << id
+              << ": Error calling getCurrentState(): " << ex.what();
+  }
+  updateTcvrStateInFsdb(id, std::move(*info.tcvrState()));
+  fsdbSyncManager_->updateTcvrStats(id, std::move(*info.tcvrStats()));
+}
+
 int WedgeManager::scanTransceiverPresence(
     std::unique_ptr<std::vector<int32_t>> ids) {
   // If the id list is empty, we default to scan the presence of all the
@@ -63,6 +63,8 @@ class WedgeManager : public TransceiverManager {
   std::vector<TransceiverID> refreshTransceivers() override;
   void publishTransceiversToFsdb(
       const std::vector<TransceiverID>& ids) override;
+  void publishTransceiverToFsdb(TransceiverID id, TransceiverInfo&& info)
+      override;
 
   int scanTransceiverPresence(
       std::unique_ptr<std::vector<int32_t>> ids) override;
@@ -3,6 +3,7 @@
 #include "fboss/qsfp_service/test/TransceiverManagerTestHelper.h"
 
 #include "fboss/lib/CommonFileUtils.h"
+#include "fboss/qsfp_service/TransceiverRefreshScheduler.h"
 
 namespace facebook::fboss {
 
@@ -143,4 +144,21 @@ TEST_F(TransceiverManagerTest, getInterfacePhyInfo) {
       FbossError);
 }
 
+TEST_F(TransceiverManagerTest, refreshSchedulerReportsEachTransceiver) {
+  std::vector<Transceiver*> transceivers;
+  for (const auto& [id, transceiver] :
+       *transceiverManager_->getSynchronizedTransceivers().rlock()) {
+    transceivers.push_back(transceiver.get());
+  }
+  ASSERT_FALSE(transceivers.empty());
+
+  std::set<TransceiverID> refreshed;
+  TransceiverRefreshScheduler([&refreshed](const Transceiver& transceiver) {
+    refreshed.insert(transceiver.getID());
+    // Failing to handle one transceiver doesn't affect the others
+    throw FbossError("Mock FbossError");
+  }).refresh(transceivers);
+  EXPECT_EQ(refreshed.size(), transceivers.size());
+}
+
 } // namespace facebook::fboss
@@ -8,13 +8,102 @@
  *
  */
 #include <folly/Benchmark.h>
+#include <folly/Synchronized.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include <algorithm>
+#include <chrono>
+#include <numeric>
 #include <unordered_set>
 
+#include "fboss/qsfp_service/TransceiverRefreshScheduler.h"
+#include "fboss/qsfp_service/module/cmis/CmisModule.h"
+#include "fboss/qsfp_service/module/tests/FakeTransceiverImpl.h"
 #include "fboss/qsfp_service/platforms/wedge/WedgeManager.h"
 #include "fboss/qsfp_service/test/benchmarks/HwBenchmarkUtils.h"
 
 namespace facebook::fboss {
 
+namespace {
+
+constexpr int kNumFakeI2cBuses = 4;
+constexpr int kNumFakeTcvrsPerBus = 8;
+// Read latency of the first bus, each following bus is slower by as much
+constexpr auto kFakeI2cBusReadLatency = std::chrono::microseconds(100);
+
+/*
+ * Refresh CMIS modules on FakeTransceiverImpl, spread over I2C buses of
+ * increasing latency, and report how long after the start of the refresh
+ * each module could be published: once all modules are refreshed, or as
+ * soon as it is refreshed.
+ */
+void refreshFakeTcvrs(
+    uint32_t iters,
+    bool publishAsRefreshed,
+    folly::UserCounters& counters) {
+  folly::BenchmarkSuspender suspender;
+  gflags::SetCommandLineOptionWithMode(
+      "qsfp_data_refresh_interval", "0", gflags::SET_FLAGS_DEFAULT);
+  auto tcvrConfig =
+      std::make_shared<const TransceiverConfig>(TransceiverOverrides());
+  std::vector<std::unique_ptr<folly::ScopedEventBaseThread>> buses;
+  std::vector<std::unique_ptr<FakeTransceiverImpl>> impls;
+  std::vector<std::unique_ptr<CmisModule>> modules;
+  std::vector<Transceiver*> transceivers;
+  for (int bus = 0; bus < kNumFakeI2cBuses; ++bus) {
+    buses.push_back(std::make_unique<folly::ScopedEventBaseThread>(
+        folly::to<std::string>("FakeI2cBus", bus)));
+    for (int i = 0; i < kNumFakeTcvrsPerBus; ++i) {
+      impls.push_back(std::make_unique<Cmis400GLr4Transceiver>(
+          bus * kNumFakeTcvrsPerBus + i, nullptr /* mgr */));
+      impls.back()->setI2cBus(
+          buses.back()->getEventBase(), kFakeI2cBusReadLatency * (bus + 1));
+      modules.push_back(std::make_unique<CmisModule>(
+          std::set<std::string>(),
+          impls.back().get(),
+          tcvrConfig,
+          false /* supportRemediate */));
+      transceivers.push_back(modules.back().get());
+    }
+  }
+  // The first refresh reads all pages of the newly detected modules
+  TransceiverRefreshScheduler().refresh(transceivers);
+
+  folly::Synchronized<std::vector<int64_t>> publishDelays;
+  auto start = std::chrono::steady_clock::now();
+  auto publish = [&publishDelays, &start](const Transceiver& /* tcvr */) {
+    publishDelays.wlock()->push_back(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+  };
+  for (uint32_t iter = 0; iter < iters; ++iter) {
+    start = std::chrono::steady_clock::now();
+    suspender.dismiss();
+    if (publishAsRefreshed) {
+      TransceiverRefreshScheduler(publish).refresh(transceivers);
+    } else {
+      TransceiverRefreshScheduler().refresh(transceivers);
+      for (auto* transceiver : transceivers) {
+        publish(*transceiver);
+      }
+    }
+    suspender.rehire();
+  }
+
+  auto delays = publishDelays.copy();
+  CHECK_EQ(delays.size(), transceivers.size() * iters);
+  if (delays.empty()) {
+    return;
+  }
+  counters["avg_publish_delay_us"] = folly::UserMetric(
+      std::accumulate(delays.begin(), delays.end(), int64_t(0)) /
+      static_cast<int64_t>(delays.size()));
+  counters["max_publish_delay_us"] =
+      folly::UserMetric(*std::max_element(delays.begin(), delays.end()));
+}
+
+} // namespace
+
 BENCHMARK_MULTI(RefreshTransceiver_CR4_100G) {
   return refreshTcvrs(MediaInterfaceCode::CR4_100G);
 }
@@ -35,4 +124,15 @@ BENCHMARK_MULTI(RefreshTransceiver_LR4_400G_10KM) {
   return refreshTcvrs(MediaInterfaceCode::LR4_400G_10KM);
 }
 
+BENCHMARK_COUNTERS(RefreshFakeTransceivers_PublishAfterAll, counters, iters) {
+  refreshFakeTcvrs(iters, false /* publishAsRefreshed */, counters);
+}
+
+BENCHMARK_COUNTERS_RELATIVE(
+    RefreshFakeTransceivers_PublishAsRefreshed,
+    counters,
+    iters) {
+  refreshFakeTcvrs(iters, true /* publishAsRefreshed */, counters);
+}
+
 } // namespace facebook::fboss
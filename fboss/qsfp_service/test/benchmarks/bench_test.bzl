@@ -43,7 +43,12 @@ def _qsfp_bench_test_lib(impl):
         versions = to_versions(impl),
         exported_deps = [
             "//folly:benchmark",
+            "//folly:synchronized",
+            "//folly/io/async:scoped_event_base_thread",
             ":hw_bench_utils{}".format(impl_suffix),
+            "//fboss/qsfp_service:transceiver-manager",
+            "//fboss/qsfp_service/module:qsfp-module",
+            "//fboss/qsfp_service/module/tests:fake-transceiver-impl",
             "//fboss/qsfp_service/platforms/wedge:wedge-platform{}".format(core_suffix),
         ],
     )
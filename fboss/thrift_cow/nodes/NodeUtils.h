@@ -38,4 +38,15 @@ using is_cow_type = std::is_base_of<Serializable, std::remove_cvref_t<T>>;
 template <typename T>
 constexpr bool is_cow_type_v = is_cow_type<T>::value;
 
+struct HybridNodeType;
+
+// Hybrid nodes are cow types that hold a plain thrift object
+template <typename T, typename = void>
+struct is_hybrid_node : std::false_type {};
+template <typename T>
+struct is_hybrid_node<T, std::void_t<typename std::remove_cvref_t<T>::CowType>>
+    : std::is_same<typename std::remove_cvref_t<T>::CowType, HybridNodeType> {};
+template <typename T>
+constexpr bool is_hybrid_node_v = is_hybrid_node<T>::value;
+
 } // namespace facebook::fboss::thrift_cow
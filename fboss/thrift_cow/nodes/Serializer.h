@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <folly/io/Cursor.h>
 #include <folly/io/IOBufQueue.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <thrift/lib/cpp2/protocol/detail/protocol_methods.h>
@@ -78,70 +79,60 @@ struct Serializer {
     return str;
   }
 
+  template <typename TC, typename TType>
+  static folly::IOBuf serializeBuf(const TType& ttype) {
+    folly::IOBufQueue queue;
+    serializeInto<TC>(ttype, queue);
+    return queue.moveAsValue();
+  }
+
+  /*
+   * Appends the encoded value to an existing queue, so callers building a
+   * larger payload can avoid an intermediate buffer per value.
+   */
   template <
       typename TC,
       typename TType,
       std::enable_if_t<detail::tc_is_struct_or_union<TC>, bool> = true>
-  static folly::IOBuf serializeBuf(const TType& ttype) {
-    folly::IOBufQueue queue;
+  static void serializeInto(const TType& ttype, folly::IOBufQueue& queue) {
     TSerializer::serialize(ttype, &queue);
-    return queue.moveAsValue();
   }
 
   template <
       typename TC,
       typename TType,
       std::enable_if_t<!detail::tc_is_struct_or_union<TC>, bool> = true>
-  static folly::IOBuf serializeBuf(const TType& ttype) {
-    folly::IOBufQueue queue;
+  static void serializeInto(const TType& ttype, folly::IOBufQueue& queue) {
     Writer writer;
     writer.setOutput(&queue);
     apache::thrift::detail::pm::protocol_methods<TC, TType>::write(
         writer, ttype);
-    return queue.moveAsValue();
   }
 
-  template <
-      typename TC,
-      typename TType,
-      std::enable_if_t<detail::tc_is_struct_or_union<TC>, bool> = true>
-  static TType deserialize(const folly::fbstring& encoded) {
-    return TSerializer::template deserialize<TType>(encoded.toStdString());
-  }
-
-  template <
-      typename TC,
-      typename TType,
-      std::enable_if_t<!detail::tc_is_struct_or_union<TC>, bool> = true>
-  static TType deserialize(const folly::fbstring& encoded) {
+  /*
+   * Decodes in place from the cursor, which may span a chain of buffers as
+   * received from a thrift stream. No copy of the input is made.
+   */
+  template <typename TC, typename TType>
+  static TType deserialize(folly::io::Cursor cursor) {
     Reader reader;
-    auto buf = folly::IOBuf::copyBuffer(encoded.data(), encoded.length());
-    reader.setInput(buf.get());
+    reader.setInput(cursor);
     TType recovered;
     apache::thrift::detail::pm::protocol_methods<TC, TType>::read(
         reader, recovered);
     return recovered;
   }
 
-  template <
-      typename TC,
-      typename TType,
-      std::enable_if_t<detail::tc_is_struct_or_union<TC>, bool> = true>
-  static TType deserializeBuf(folly::IOBuf&& buf) {
-    return TSerializer::template deserialize<TType>(&buf);
+  template <typename TC, typename TType>
+  static TType deserialize(const folly::fbstring& encoded) {
+    auto buf =
+        folly::IOBuf::wrapBufferAsValue(encoded.data(), encoded.length());
+    return deserialize<TC, TType>(folly::io::Cursor(&buf));
   }
 
-  template <
-      typename TC,
-      typename TType,
-      std::enable_if_t<!detail::tc_is_struct_or_union<TC>, bool> = true>
+  template <typename TC, typename TType>
   static TType deserializeBuf(folly::IOBuf&& buf) {
-    Reader reader;
-    reader.setInput(&buf);
-    TType recovered;
-    apache::thrift::detail::pm::protocol_methods<TC, TType>::read(
-        reader, recovered);
-    return recovered;
+    return deserialize<TC, TType>(folly::io::Cursor(&buf));
   }
 };
 
@@ -179,6 +170,43 @@ folly::IOBuf serializeBuf(fsdb::OperProtocol proto, const TType& ttype) {
   }
 }
 
+template <typename TC, typename TType>
+void serializeInto(
+    fsdb::OperProtocol proto,
+    const TType& ttype,
+    folly::IOBufQueue& queue) {
+  switch (proto) {
+    case fsdb::OperProtocol::BINARY:
+      return Serializer<fsdb::OperProtocol::BINARY>::template serializeInto<
+          TC>(ttype, queue);
+    case fsdb::OperProtocol::SIMPLE_JSON:
+      return Serializer<fsdb::OperProtocol::SIMPLE_JSON>::
+          template serializeInto<TC>(ttype, queue);
+    case fsdb::OperProtocol::COMPACT:
+      return Serializer<fsdb::OperProtocol::COMPACT>::template serializeInto<
+          TC>(ttype, queue);
+    default:
+      throw std::logic_error("Unexpected protocol");
+  }
+}
+
+template <typename TC, typename TType>
+TType deserialize(fsdb::OperProtocol proto, folly::io::Cursor cursor) {
+  switch (proto) {
+    case fsdb::OperProtocol::BINARY:
+      return Serializer<
+          fsdb::OperProtocol::BINARY>::template deserialize<TC, TType>(cursor);
+    case fsdb::OperProtocol::SIMPLE_JSON:
+      return Serializer<fsdb::OperProtocol::SIMPLE_JSON>::
+          template deserialize<TC, TType>(cursor);
+    case fsdb::OperProtocol::COMPACT:
+      return Serializer<fsdb::OperProtocol::COMPACT>::
+          template deserialize<TC, TType>(cursor);
+    default:
+      throw std::logic_error("Unexpected protocol");
+  }
+}
+
 template <typename TC, typename TType>
 TType deserialize(fsdb::OperProtocol proto, const folly::fbstring& encoded) {
   switch (proto) {
@@ -222,6 +250,11 @@ struct Serializable {
 
   virtual folly::IOBuf encodeBuf(fsdb::OperProtocol proto) const = 0;
 
+  // Appends the encoded buffer chain to the queue without copying it
+  void encodeInto(fsdb::OperProtocol proto, folly::IOBufQueue& queue) const {
+    queue.append(encodeBuf(proto));
+  }
+
   void fromEncoded(fsdb::OperProtocol proto, const folly::fbstring& encoded) {
     auto buf =
         folly::IOBuf::wrapBufferAsValue(encoded.data(), encoded.length());
@@ -0,0 +1,228 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <folly/Conv.h>
+#include <folly/json/dynamic.h>
+#include <thrift/lib/cpp2/folly_dynamic/folly_dynamic.h>
+#include <thrift/lib/cpp2/reflection/reflection.h>
+#include "fboss/agent/state/NodeBase-defs.h"
+#include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
+#include "fboss/thrift_cow/nodes/NodeUtils.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
+#include "fboss/thrift_cow/visitors/VisitorUtils.h"
+
+namespace facebook::fboss::thrift_cow {
+
+/*
+ * Hybrid nodes keep a whole subtree as a plain thrift object instead of a
+ * tree of thrift_cow nodes, so a struct with hundreds of counters costs one
+ * allocation instead of one per field. Copy-on-write happens at the
+ * granularity of the subtree: cloning a hybrid node copies the thrift object.
+ *
+ * Structs annotated with (allow_skip_thrift_cow = "true") are stored as
+ * hybrid nodes wherever they appear in a thrift_cow tree. PathVisitor,
+ * ExtendedPathVisitor and PatchApplier traverse into the thrift object.
+ * DeltaVisitor and RecurseVisitor treat the hybrid node as a leaf unless
+ * asked for hybridNodeDeepTraversal, which subscription serving uses to
+ * reach subscriptions below hybrid nodes.
+ *
+ * Subscription path stores are not created inside hybrid nodes, and
+ * modifyPath only creates optional members one level below them. Only
+ * annotate structs that are not subscribed to with wildcards below the
+ * struct itself.
+ */
+template <typename TType>
+struct ThriftHybridFields {
+  ThriftHybridFields() = default;
+  explicit ThriftHybridFields(TType thrift) : obj(std::move(thrift)) {}
+
+  template <typename Fn>
+  void forEachChild(Fn /* fn */) {
+    // thrift object has no child nodes to publish
+  }
+
+  TType obj;
+};
+
+template <typename TypeClass, typename TType>
+class ThriftHybridNode : public NodeBaseT<
+                             ThriftHybridNode<TypeClass, TType>,
+                             ThriftHybridFields<TType>>,
+                         public thrift_cow::Serializable {
+ public:
+  using Self = ThriftHybridNode<TypeClass, TType>;
+  using Fields = ThriftHybridFields<TType>;
+  using BaseT = NodeBaseT<Self, Fields>;
+  using CowType = HybridNodeType;
+  using TC = TypeClass;
+  using ThriftType = TType;
+  using Tag =
+      apache::thrift::type::infer_tag<TType, true /* GuessStringTag */>;
+  using PathIter = typename std::vector<std::string>::const_iterator;
+
+  using BaseT::BaseT;
+
+  ThriftHybridNode() : BaseT(TType{}) {}
+
+  TType toThrift() const {
+    return cref();
+  }
+
+  void fromThrift(const TType& thrift) {
+    ref() = thrift;
+  }
+
+#ifdef ENABLE_DYNAMIC_APIS
+  folly::dynamic toFollyDynamic() const override {
+    folly::dynamic out;
+    facebook::thrift::to_dynamic<Tag>(
+        out, cref(), facebook::thrift::dynamic_format::JSON_1);
+    return out;
+  }
+
+  void fromFollyDynamic(const folly::dynamic& value) {
+    facebook::thrift::from_dynamic<Tag>(
+        ref(), value, facebook::thrift::dynamic_format::JSON_1);
+  }
+#else
+  folly::dynamic toFollyDynamic() const override {
+    return {};
+  }
+#endif
+
+  folly::IOBuf encodeBuf(fsdb::OperProtocol proto) const override {
+    return serializeBuf<TC>(proto, cref());
+  }
+
+  void fromEncodedBuf(fsdb::OperProtocol proto, folly::IOBuf&& encoded)
+      override {
+    ref() = deserializeBuf<TC, TType>(proto, std::move(encoded));
+  }
+
+  TType& ref() {
+    return this->writableFields()->obj;
+  }
+
+  const TType& ref() const {
+    return this->getFields()->obj;
+  }
+
+  const TType& cref() const {
+    return this->getFields()->obj;
+  }
+
+  /*
+   * Called on each hop of a path being modified. The thrift object is
+   * already writable once this node is, so we only need to make sure an
+   * optional struct member exists before the path goes through it.
+   */
+  void modify(const std::string& token) {
+    if constexpr (std::is_same_v<TC, apache::thrift::type_class::structure>) {
+      bool found{false};
+      visitMember<typename apache::thrift::reflect_struct<TType>::members>(
+          token, [&](auto tag) {
+            using member = decltype(fatal::tag_type(tag));
+            found = true;
+            if constexpr (isOptional<member>()) {
+              typename member::field_ref_getter{}(ref()).ensure();
+            }
+          });
+      if (!found) {
+        throw std::runtime_error(folly::to<std::string>(
+            "Unable to find struct child named ", token));
+      }
+    }
+  }
+
+  static void modify(std::shared_ptr<Self>* node, std::string token) {
+    auto newNode = ((*node)->isPublished()) ? (*node)->clone() : *node;
+    newNode->modify(token);
+    node->swap(newNode);
+  }
+
+  bool remove(const std::string& token) {
+    if constexpr (std::is_same_v<TC, apache::thrift::type_class::structure>) {
+      bool ret{false}, found{false};
+      visitMember<typename apache::thrift::reflect_struct<TType>::members>(
+          token, [&](auto tag) {
+            using member = decltype(fatal::tag_type(tag));
+            found = true;
+            if constexpr (isOptional<member>()) {
+              auto field = typename member::field_ref_getter{}(ref());
+              ret = field.has_value();
+              field.reset();
+            } else {
+              throw std::runtime_error("Cannot remove non-optional member");
+            }
+          });
+      if (!found) {
+        throw std::runtime_error(folly::to<std::string>(
+            "Unable to find struct child named ", token));
+      }
+      return ret;
+    } else if constexpr (is_map_or_set_tc<TC>::value) {
+      using key_type = typename TType::key_type;
+      if (auto key = tryParseKey<key_type, typename is_map_or_set_tc<TC>::Key>(
+              token)) {
+        return ref().erase(*key);
+      }
+      return false;
+    } else if constexpr (is_list_tc<TC>::value) {
+      auto index = folly::tryTo<size_t>(token);
+      if (index.hasValue() && *index < cref().size()) {
+        ref().erase(ref().begin() + *index);
+        return true;
+      }
+      return false;
+    } else {
+      throw std::runtime_error(folly::to<std::string>(
+          "Cannot remove a child from a primitive node: ", token));
+    }
+  }
+
+  bool operator==(const Self& that) const {
+    return cref() == that.cref();
+  }
+
+  bool operator!=(const Self& that) const {
+    return !(*this == that);
+  }
+
+ private:
+  template <typename TCType>
+  struct is_list_tc : std::false_type {};
+  template <typename ValueTC>
+  struct is_list_tc<apache::thrift::type_class::list<ValueTC>>
+      : std::true_type {};
+
+  template <typename TCType>
+  struct is_map_or_set_tc : std::false_type {};
+  template <typename KeyTC, typename MappedTC>
+  struct is_map_or_set_tc<apache::thrift::type_class::map<KeyTC, MappedTC>>
+      : std::true_type {
+    using Key = KeyTC;
+  };
+  template <typename ValueTC>
+  struct is_map_or_set_tc<apache::thrift::type_class::set<ValueTC>>
+      : std::true_type {
+    using Key = ValueTC;
+  };
+
+  template <typename Member>
+  static constexpr bool isOptional() {
+    return Member::optional::value == apache::thrift::optionality::optional;
+  }
+
+  friend class CloneAllocator;
+};
+
+} // namespace facebook::fboss::thrift_cow
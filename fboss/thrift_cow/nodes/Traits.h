@@ -63,8 +63,26 @@ struct ConvertToNodeTraits {
   using isChild = std::false_type;
 };
 
+namespace detail {
+
+// Structs annotated with (allow_skip_thrift_cow = "true") are stored as a
+// single ThriftHybridNode holding the thrift object rather than a tree of
+// nodes
+template <typename Annotations, typename = void>
+struct AllowSkipThriftCow : std::false_type {};
+
+template <typename Annotations>
+struct AllowSkipThriftCow<
+    Annotations,
+    std::void_t<typename Annotations::keys::allow_skip_thrift_cow>>
+    : std::true_type {};
+
 template <typename TType>
-struct ConvertToNodeTraits<apache::thrift::type_class::structure, TType> {
+constexpr bool allowSkipThriftCow = AllowSkipThriftCow<
+    typename apache::thrift::reflect_struct<TType>::annotations>::value;
+
+template <typename TType, bool Hybrid = allowSkipThriftCow<TType>>
+struct StructNodeTraits {
   using default_type = ThriftStructNode<TType, ThriftStructResolver<TType>>;
   using struct_type = ResolvedType<TType>;
   static_assert(
@@ -75,6 +93,19 @@ struct ConvertToNodeTraits<apache::thrift::type_class::structure, TType> {
       "Resolved type should not define any members. All data needs to be stored in defined thrift struct");
 
   using type = std::shared_ptr<struct_type>;
+};
+
+template <typename TType>
+struct StructNodeTraits<TType, true> {
+  using type = std::shared_ptr<
+      ThriftHybridNode<apache::thrift::type_class::structure, TType>>;
+};
+
+} // namespace detail
+
+template <typename TType>
+struct ConvertToNodeTraits<apache::thrift::type_class::structure, TType> {
+  using type = typename detail::StructNodeTraits<TType>::type;
   using isChild = std::true_type;
 };
 
@@ -94,6 +94,9 @@ struct NodeType {};
 
 struct FieldsType {};
 
+// nodes storing a whole subtree as a plain thrift object
+struct HybridNodeType {};
+
 template <typename TType, typename Derived>
 struct ThriftStructFields;
 
@@ -127,10 +130,17 @@ class ThriftSetNode;
 template <typename TypeClass, typename TType, bool Immutable = false>
 class ThriftPrimitiveNode;
 
+template <typename TType>
+struct ThriftHybridFields;
+
+template <typename TypeClass, typename TType>
+class ThriftHybridNode;
+
 } // namespace facebook::fboss::thrift_cow
 
 // clang-format off
 #include "fboss/thrift_cow/nodes/ThriftPrimitiveNode-inl.h"
+#include "fboss/thrift_cow/nodes/ThriftHybridNode-inl.h"
 #include "fboss/thrift_cow/nodes/Traits.h"
 #include "fboss/thrift_cow/nodes/ThriftStructNode-inl.h"
 #include "fboss/thrift_cow/nodes/ThriftListNode-inl.h"
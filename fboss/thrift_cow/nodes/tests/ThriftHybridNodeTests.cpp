@@ -0,0 +1,285 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/String.h>
+#include <thrift/lib/cpp2/folly_dynamic/folly_dynamic.h>
+#include <thrift/lib/cpp2/reflection/reflection.h>
+#include "fboss/agent/gen-cpp2/switch_config_fatal_types.h"
+#include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
+#include "fboss/thrift_cow/gen-cpp2/patch_types.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
+#include "fboss/thrift_cow/nodes/Types.h"
+#include "fboss/thrift_cow/nodes/tests/gen-cpp2/test_fatal_types.h"
+#include "fboss/thrift_cow/visitors/DeltaVisitor.h"
+#include "fboss/thrift_cow/visitors/PatchApplier.h"
+#include "fboss/thrift_cow/visitors/PathVisitor.h"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <type_traits>
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::thrift_cow;
+
+using k = test_tags::strings;
+using HybridMembers = apache::thrift::reflect_struct<TestHybridStruct>::member;
+using ParentMembers = apache::thrift::reflect_struct<TestHybridParent>::member;
+
+namespace {
+
+using HybridNode =
+    ThriftHybridNode<apache::thrift::type_class::structure, TestHybridStruct>;
+using ParentNode = ThriftStructNode<TestHybridParent>;
+
+TestHybridStruct buildHybridStruct(int val) {
+  TestHybridStruct data;
+  data.inlineInt() = val;
+  data.mapOfI32ToI32() = {{1, val * 10}, {3, val * 30}};
+  data.listOfPrimitives() = {val, val + 1};
+  return data;
+}
+
+TestHybridParent buildParent() {
+  TestHybridParent data;
+  data.hybridMap() = {
+      {"port1", buildHybridStruct(1)}, {"port2", buildHybridStruct(2)}};
+  data.hybridStruct() = buildHybridStruct(3);
+  return data;
+}
+
+folly::dynamic getDynamic(
+    const ParentNode& node,
+    const std::vector<std::string>& path,
+    ThriftTraverseResult expected = ThriftTraverseResult::OK) {
+  folly::dynamic dyn;
+  auto op = pvlambda([&dyn](auto& node) { dyn = node.toFollyDynamic(); });
+  auto result = RootPathVisitor::visit(
+      node, path.begin(), path.end(), PathVisitMode::LEAF, op);
+  EXPECT_EQ(result, expected);
+  return dyn;
+}
+
+template <typename TType>
+ThriftTraverseResult
+setValue(ParentNode& node, const std::vector<std::string>& path, TType value) {
+  auto op = pvlambda([&value](auto& node) {
+    using NodeT = folly::remove_cvref_t<decltype(node)>;
+    if constexpr (std::is_same_v<typename NodeT::ThriftType, TType>) {
+      node.fromThrift(value);
+    } else {
+      throw std::runtime_error("type mismatch");
+    }
+  });
+  return RootPathVisitor::visit(
+      node, path.begin(), path.end(), PathVisitMode::LEAF, op);
+}
+
+} // namespace
+
+TEST(ThriftHybridNodeTests, AnnotatedStructIsHybrid) {
+  static_assert(std::is_same_v<
+                ConvertToNodeTraits<
+                    apache::thrift::type_class::structure,
+                    TestHybridStruct>::type,
+                std::shared_ptr<HybridNode>>);
+  static_assert(std::is_same_v<
+                ConvertToNodeTraits<
+                    apache::thrift::type_class::structure,
+                    TestHybridParent>::type,
+                std::shared_ptr<ParentNode>>);
+  static_assert(is_hybrid_node_v<HybridNode>);
+  static_assert(!is_hybrid_node_v<ParentNode>);
+
+  auto node = std::make_shared<ParentNode>(buildParent());
+  EXPECT_EQ(node->toThrift(), buildParent());
+  EXPECT_EQ(
+      node->template ref<k::hybridStruct>()->cref(), buildHybridStruct(3));
+  EXPECT_FALSE(node->template ref<k::optionalHybrid>());
+}
+
+TEST(ThriftHybridNodeTests, CopyOnWrite) {
+  auto node = std::make_shared<ParentNode>(buildParent());
+  node->publish();
+  auto oldChild = node->template ref<k::hybridStruct>();
+  EXPECT_TRUE(oldChild->isPublished());
+
+  auto newNode = node->clone();
+  auto& newChild = newNode->template modify<k::hybridStruct>();
+  EXPECT_NE(oldChild, newChild);
+  EXPECT_FALSE(newChild->isPublished());
+  newChild->ref().inlineInt() = 99;
+
+  EXPECT_EQ(*oldChild->cref().inlineInt(), 3);
+  EXPECT_EQ(*newChild->cref().inlineInt(), 99);
+  // other children are still shared
+  EXPECT_EQ(
+      node->template ref<k::hybridMap>(),
+      newNode->template ref<k::hybridMap>());
+}
+
+TEST(ThriftHybridNodeTests, VisitPathIntoHybrid) {
+  auto node = std::make_shared<ParentNode>(buildParent());
+
+  EXPECT_EQ(getDynamic(*node, {"hybridMap", "port2", "inlineInt"}).asInt(), 2);
+  EXPECT_EQ(
+      getDynamic(*node, {"hybridMap", "port1", "mapOfI32ToI32", "3"}).asInt(),
+      30);
+  EXPECT_EQ(getDynamic(*node, {"2", "5", "1"}).asInt(), 4);
+  EXPECT_EQ(
+      getDynamic(*node, {"hybridStruct"})["inlineInt"].asInt(),
+      *buildHybridStruct(3).inlineInt());
+
+  getDynamic(
+      *node,
+      {"hybridStruct", "optionalString"},
+      ThriftTraverseResult::NON_EXISTENT_NODE);
+  getDynamic(
+      *node,
+      {"hybridStruct", "mapOfI32ToI32", "2"},
+      ThriftTraverseResult::NON_EXISTENT_NODE);
+  getDynamic(
+      *node,
+      {"hybridStruct", "listOfPrimitives", "5"},
+      ThriftTraverseResult::INVALID_ARRAY_INDEX);
+  getDynamic(
+      *node,
+      {"hybridStruct", "noSuchMember"},
+      ThriftTraverseResult::INVALID_STRUCT_MEMBER);
+
+  // const traversal
+  const auto& constNode = *node;
+  EXPECT_EQ(getDynamic(constNode, {"hybridStruct", "inlineInt"}).asInt(), 3);
+}
+
+TEST(ThriftHybridNodeTests, SetPathIntoHybrid) {
+  auto node = std::make_shared<ParentNode>(buildParent());
+  node->publish();
+  auto oldNode = node;
+
+  std::vector<std::string> path{"hybridMap", "port1", "inlineInt"};
+  EXPECT_EQ(
+      ParentNode::modifyPath(&node, path.begin(), path.end()),
+      ThriftTraverseResult::OK);
+  EXPECT_NE(node, oldNode);
+  EXPECT_EQ(setValue(*node, path, int32_t(42)), ThriftTraverseResult::OK);
+  EXPECT_EQ(*node->toThrift().hybridMap()->at("port1").inlineInt(), 42);
+  EXPECT_EQ(*oldNode->toThrift().hybridMap()->at("port1").inlineInt(), 1);
+
+  // modifying the path creates a missing optional member
+  path = {"hybridStruct", "optionalString"};
+  EXPECT_EQ(
+      ParentNode::modifyPath(&node, path.begin(), path.end()),
+      ThriftTraverseResult::OK);
+  EXPECT_EQ(
+      setValue(*node, path, std::string("hello")), ThriftTraverseResult::OK);
+  EXPECT_EQ(*node->toThrift().hybridStruct()->optionalString(), "hello");
+
+  // type mismatch leaves the value alone
+  EXPECT_EQ(
+      setValue(*node, path, int32_t(1)),
+      ThriftTraverseResult::VISITOR_EXCEPTION);
+  EXPECT_EQ(*node->toThrift().hybridStruct()->optionalString(), "hello");
+
+  node->publish();
+  EXPECT_EQ(
+      ParentNode::removePath(&node, path.begin(), path.end()),
+      ThriftTraverseResult::OK);
+  EXPECT_FALSE(node->toThrift().hybridStruct()->optionalString().has_value());
+
+  path = {"hybridMap", "port1", "mapOfI32ToI32", "3"};
+  EXPECT_EQ(
+      ParentNode::removePath(&node, path.begin(), path.end()),
+      ThriftTraverseResult::OK);
+  EXPECT_EQ(
+      node->toThrift().hybridMap()->at("port1").mapOfI32ToI32()->size(), 1);
+}
+
+TEST(ThriftHybridNodeTests, DeltaAtHybridNode) {
+  auto dataB = buildParent();
+  dataB.hybridMap()->at("port1").mapOfI32ToI32()->at(1) = 1234;
+  dataB.hybridMap()->emplace("port3", buildHybridStruct(4));
+  dataB.optionalHybrid() = buildHybridStruct(5);
+
+  auto nodeA = std::make_shared<ParentNode>(buildParent());
+  auto nodeB = std::make_shared<ParentNode>(dataB);
+
+  std::set<std::string> differingPaths;
+  auto processChange = [&](const std::vector<std::string>& path,
+                           auto&& /*oldValue*/,
+                           auto&& /*newValue*/,
+                           auto&& /*tag*/) {
+    differingPaths.emplace("/" + folly::join('/', path));
+  };
+
+  auto result = RootDeltaVisitor::visit(
+      nodeA, nodeB, DeltaVisitOptions(DeltaVisitMode::MINIMAL), processChange);
+  EXPECT_TRUE(result);
+  EXPECT_EQ(
+      differingPaths,
+      std::set<std::string>(
+          {"/hybridMap/port1", "/hybridMap/port3", "/optionalHybrid"}));
+
+  // equal thrift objects in different nodes are not a delta
+  differingPaths.clear();
+  auto nodeC = std::make_shared<ParentNode>(dataB);
+  EXPECT_FALSE(RootDeltaVisitor::visit(
+      nodeB, nodeC, DeltaVisitOptions(DeltaVisitMode::FULL), processChange));
+  EXPECT_TRUE(differingPaths.empty());
+}
+
+TEST(ThriftHybridNodeTests, PatchIntoHybrid) {
+  auto node = std::make_shared<ParentNode>(buildParent());
+
+  PatchNode intPatch;
+  intPatch.set_val(serializeBuf<apache::thrift::type_class::integral>(
+      fsdb::OperProtocol::COMPACT, 50));
+  MapPatch countersPatch;
+  countersPatch.children() = {{"5", intPatch}};
+  PatchNode countersNode;
+  countersNode.set_map_node(std::move(countersPatch));
+
+  PatchNode delPatch;
+  delPatch.set_del();
+  StructPatch portPatch;
+  portPatch.children() = {
+      {HybridMembers::inlineInt::id(), intPatch},
+      {HybridMembers::mapOfI32ToI32::id(), countersNode}};
+  PatchNode portNode;
+  portNode.set_struct_node(std::move(portPatch));
+
+  MapPatch mapPatch;
+  mapPatch.children() = {{"port1", portNode}, {"port2", delPatch}};
+  PatchNode mapNode;
+  mapNode.set_map_node(std::move(mapPatch));
+
+  StructPatch rootPatch;
+  rootPatch.children() = {{ParentMembers::hybridMap::id(), mapNode}};
+  PatchNode n;
+  n.set_struct_node(std::move(rootPatch));
+
+  auto ret = RootPatchApplier::apply(*node, std::move(n));
+  EXPECT_EQ(ret, PatchApplyResult::OK);
+
+  auto expected = buildParent();
+  expected.hybridMap()->at("port1").inlineInt() = 50;
+  expected.hybridMap()->at("port1").mapOfI32ToI32()->emplace(5, 50);
+  expected.hybridMap()->erase("port2");
+  EXPECT_EQ(node->toThrift(), expected);
+
+  // replace the whole hybrid node
+  PatchNode valPatch;
+  valPatch.set_val(serializeBuf<apache::thrift::type_class::structure>(
+      fsdb::OperProtocol::COMPACT, buildHybridStruct(7)));
+  ret = PatchApplier<apache::thrift::type_class::structure>::apply(
+      *node->template ref<k::hybridStruct>(), std::move(valPatch));
+  EXPECT_EQ(ret, PatchApplyResult::OK);
+  EXPECT_EQ(
+      node->template ref<k::hybridStruct>()->cref(), buildHybridStruct(7));
+}
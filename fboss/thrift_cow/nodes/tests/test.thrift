@@ -62,3 +62,17 @@ struct TestStruct {
 struct ParentTestStruct {
   1: TestStruct childStruct;
 }
+
+struct TestHybridStruct {
+  1: i32 inlineInt;
+  2: map<i32, i32> mapOfI32ToI32;
+  3: optional string optionalString;
+  4: optional switch_config.L4PortRange optionalStruct;
+  5: list<i32> listOfPrimitives;
+} (allow_skip_thrift_cow = "true")
+
+struct TestHybridParent {
+  1: map<string, TestHybridStruct> hybridMap;
+  2: TestHybridStruct hybridStruct;
+  3: optional TestHybridStruct optionalHybrid;
+}
@@ -177,12 +177,21 @@ class CowStorage : public Storage<Root, CowStorage<Root, Node>> {
 
   std::optional<StorageError>
   set_encoded_impl(PathIter begin, PathIter end, const OperState& state) {
+    return set_encoded_impl(begin, end, *state.protocol(), *state.contents());
+  }
+
+  // Decodes directly from the caller's buffer, e.g. an OperDelta unit,
+  // instead of first copying it into an OperState
+  std::optional<StorageError> set_encoded_impl(
+      PathIter begin,
+      PathIter end,
+      OperProtocol protocol,
+      const folly::fbstring& contents) {
     auto modifyResult = StorageImpl::modifyPath(&root_, begin, end);
     if (modifyResult != thrift_cow::ThriftTraverseResult::OK) {
       return detail::parseTraverseResult(modifyResult);
     }
-    thrift_cow::SetEncodedPathVisitorOperator op(
-        *state.protocol(), *state.contents());
+    thrift_cow::SetEncodedPathVisitorOperator op(protocol, contents);
     auto traverseResult = thrift_cow::RootPathVisitor::visit(
         *root_, begin, end, thrift_cow::PathVisitMode::LEAF, op);
     return detail::parseTraverseResult(traverseResult);
@@ -222,15 +231,15 @@ class CowStorage : public Storage<Root, CowStorage<Root, Node>> {
         break;
       }
 
-      auto rawPath = *unit.path()->raw();
+      const auto& rawPath = *unit.path()->raw();
       // TODO: verify old state matches expected?
 
       if (unit.newState()) {
-        OperState newState;
-        newState.contents() = *unit.newState();
-        newState.protocol() = *delta.protocol();
         result = this->set_encoded_impl(
-            rawPath.begin(), rawPath.end(), std::move(newState));
+            rawPath.begin(),
+            rawPath.end(),
+            *delta.protocol(),
+            *unit.newState());
       } else {
         result = this->remove_impl(rawPath.begin(), rawPath.end());
       }
@@ -241,13 +250,12 @@ class CowStorage : public Storage<Root, CowStorage<Root, Node>> {
   std::optional<StorageError> patch_impl(
       const fsdb::TaggedOperState& taggedState) {
     std::optional<StorageError> result;
-    auto rawPath = *taggedState.path()->path();
-    OperState newState;
-    newState.protocol() = *taggedState.state()->protocol();
-    newState.contents() = *taggedState.state()->contents();
-
+    const auto& rawPath = *taggedState.path()->path();
     result = this->set_encoded_impl(
-        rawPath.begin(), rawPath.end(), std::move(newState));
+        rawPath.begin(),
+        rawPath.end(),
+        *taggedState.state()->protocol(),
+        *taggedState.state()->contents());
     return result;
   }
 
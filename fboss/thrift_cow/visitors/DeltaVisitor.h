@@ -35,6 +35,7 @@ struct DeltaVisitor;
 
 struct NodeType;
 struct FieldsType;
+struct HybridNodeType;
 
 /*
  * We pass this tag to visitors to signal additional information about
@@ -87,12 +88,19 @@ struct DeltaVisitOptions {
   explicit DeltaVisitOptions(
       DeltaVisitMode mode,
       DeltaVisitOrder order = DeltaVisitOrder::PARENTS_FIRST,
-      bool outputIdPaths = false)
-      : mode(mode), order(order), outputIdPaths(outputIdPaths) {}
+      bool outputIdPaths = false,
+      bool hybridNodeDeepTraversal = false)
+      : mode(mode),
+        order(order),
+        outputIdPaths(outputIdPaths),
+        hybridNodeDeepTraversal(hybridNodeDeepTraversal) {}
 
   DeltaVisitMode mode;
   DeltaVisitOrder order;
   bool outputIdPaths;
+  // Emit deltas for the values inside hybrid nodes, through temporary nodes,
+  // when the traverse helper wants to recurse below the hybrid node
+  bool hybridNodeDeepTraversal;
 };
 
 namespace dv_detail {
@@ -251,7 +259,10 @@ void visitAddedOrRemovedNode(
         traverser,
         target,
         RecurseVisitOptions(
-            RecurseVisitMode::FULL, subtreeVisitOrder, options.outputIdPaths),
+            RecurseVisitMode::FULL,
+            subtreeVisitOrder,
+            options.outputIdPaths,
+            options.hybridNodeDeepTraversal),
         std::move(processChange));
   }
 
@@ -265,6 +276,574 @@ void visitAddedOrRemovedNode(
   }
 }
 
+/*
+ * Plain thrift values held by hybrid nodes. Deltas are emitted the same way
+ * as for a tree of nodes, with each changed value handed to the visitor as a
+ * temporary node.
+ */
+template <typename TC>
+struct ThriftValueDeltaVisitor;
+
+template <typename TC, typename TType, typename TraverseHelper, typename Func>
+void invokeThriftValueVisitorFn(
+    TraverseHelper& traverser,
+    const TType* oldValue,
+    const TType* newValue,
+    DeltaElemTag deltaElemTag,
+    Func&& f) {
+  using NodePtr = decltype(makeHybridValueNode<TC>(std::declval<TType>()));
+  const NodePtr oldNode =
+      oldValue ? makeHybridValueNode<TC>(*oldValue) : NodePtr{};
+  const NodePtr newNode =
+      newValue ? makeHybridValueNode<TC>(*newValue) : NodePtr{};
+  invokeVisitorFnHelper(
+      traverser, oldNode, newNode, deltaElemTag, std::forward<Func>(f));
+}
+
+template <typename TC, typename TType, typename TraverseHelper, typename Func>
+bool visitThriftValue(
+    TraverseHelper& traverser,
+    const TType& oldValue,
+    const TType& newValue,
+    const DeltaVisitOptions& options,
+    Func&& f) {
+  if (traverser.shouldShortCircuit(VisitorType::DELTA)) {
+    return false;
+  }
+
+  auto hasDifferences = ThriftValueDeltaVisitor<TC>::visitChildren(
+      traverser, oldValue, newValue, options, std::forward<Func>(f));
+
+  if (hasDifferences &&
+      (options.mode == DeltaVisitMode::PARENTS ||
+       options.mode == DeltaVisitMode::FULL)) {
+    invokeThriftValueVisitorFn<TC>(
+        traverser,
+        &oldValue,
+        &newValue,
+        DeltaElemTag::NOT_MINIMAL,
+        std::forward<Func>(f));
+  }
+
+  return hasDifferences;
+}
+
+/*
+ * Visits the children of an added or removed value. The value itself is
+ * visited by the caller.
+ */
+template <typename TC, typename TType, typename TraverseHelper, typename Func>
+void visitAddedOrRemovedThriftValueChildren(
+    TraverseHelper& traverser,
+    const TType& value,
+    bool isAdd,
+    const DeltaVisitOptions& options,
+    Func&& f) {
+  auto processChange = [isAdd, &f](
+                           TraverseHelper& subTraverser, const auto& node) {
+    using SubNode = folly::remove_cvref_t<decltype(node)>;
+    const SubNode oldSubNode = (isAdd) ? SubNode{} : node;
+    const SubNode newSubNode = (isAdd) ? node : SubNode{};
+    invokeVisitorFnHelper(
+        subTraverser,
+        oldSubNode,
+        newSubNode,
+        DeltaElemTag::NOT_MINIMAL,
+        std::forward<Func>(f));
+  };
+
+  auto subtreeVisitOrder = (options.order == DeltaVisitOrder::PARENTS_FIRST)
+      ? RecurseVisitOrder::PARENTS_FIRST
+      : RecurseVisitOrder::CHILDREN_FIRST;
+  rv_detail::ThriftValueRecurseVisitor<TC>::visitChildren(
+      traverser,
+      value,
+      RecurseVisitOptions(
+          RecurseVisitMode::FULL,
+          subtreeVisitOrder,
+          options.outputIdPaths,
+          true /* hybridNodeDeepTraversal */),
+      std::move(processChange));
+}
+
+template <typename TC, typename TType, typename TraverseHelper, typename Func>
+void visitAddedOrRemovedThriftValue(
+    TraverseHelper& traverser,
+    const TType* oldValue,
+    const TType* newValue,
+    const DeltaVisitOptions& options,
+    Func&& f) {
+  // Exactly one value must be non-null
+  DCHECK(static_cast<bool>(oldValue) != static_cast<bool>(newValue));
+
+  if (options.order == DeltaVisitOrder::PARENTS_FIRST) {
+    invokeThriftValueVisitorFn<TC>(
+        traverser,
+        oldValue,
+        newValue,
+        DeltaElemTag::MINIMAL,
+        std::forward<Func>(f));
+  }
+
+  if constexpr (TCType<TC> != ThriftTCType::PRIMITIVE) {
+    if (options.mode == DeltaVisitMode::FULL &&
+        !traverser.shouldShortCircuit(VisitorType::DELTA)) {
+      bool isAdd = static_cast<bool>(newValue);
+      visitAddedOrRemovedThriftValueChildren<TC>(
+          traverser,
+          isAdd ? *newValue : *oldValue,
+          isAdd,
+          options,
+          std::forward<Func>(f));
+    }
+  }
+
+  if (options.order != DeltaVisitOrder::PARENTS_FIRST) {
+    invokeThriftValueVisitorFn<TC>(
+        traverser,
+        oldValue,
+        newValue,
+        DeltaElemTag::MINIMAL,
+        std::forward<Func>(f));
+  }
+}
+
+template <typename ValueTypeClass>
+struct ThriftValueDeltaVisitor<
+    apache::thrift::type_class::set<ValueTypeClass>> {
+  using TC = apache::thrift::type_class::set<ValueTypeClass>;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visit(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    return visitThriftValue<TC>(
+        traverser, oldValue, newValue, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visitChildren(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    bool hasDifferences{false};
+    for (const auto& val : oldValue) {
+      if (newValue.find(val) == newValue.end()) {
+        hasDifferences = true;
+        traverser.push(folly::to<std::string>(val), TCType<ValueTypeClass>);
+        visitAddedOrRemovedThriftValue<ValueTypeClass>(
+            traverser, &val, nullptr, options, std::forward<Func>(f));
+        traverser.pop(TCType<ValueTypeClass>);
+      }
+    }
+    for (const auto& val : newValue) {
+      if (oldValue.find(val) == oldValue.end()) {
+        hasDifferences = true;
+        traverser.push(folly::to<std::string>(val), TCType<ValueTypeClass>);
+        visitAddedOrRemovedThriftValue<ValueTypeClass>(
+            traverser, nullptr, &val, options, std::forward<Func>(f));
+        traverser.pop(TCType<ValueTypeClass>);
+      }
+    }
+    return hasDifferences;
+  }
+};
+
+template <typename ValueTypeClass>
+struct ThriftValueDeltaVisitor<
+    apache::thrift::type_class::list<ValueTypeClass>> {
+  using TC = apache::thrift::type_class::list<ValueTypeClass>;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visit(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    return visitThriftValue<TC>(
+        traverser, oldValue, newValue, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visitChildren(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    int minSize = std::min(oldValue.size(), newValue.size());
+
+    bool hasDifferences{false};
+
+    if (oldValue.size() > newValue.size()) { // entries removed
+      hasDifferences = true;
+      // loop in reverse order for removals
+      for (int i = oldValue.size() - 1; i >= minSize; --i) {
+        traverser.push(folly::to<std::string>(i), TCType<ValueTypeClass>);
+        visitAddedOrRemovedThriftValue<ValueTypeClass>(
+            traverser, &oldValue[i], nullptr, options, std::forward<Func>(f));
+        traverser.pop(TCType<ValueTypeClass>);
+      }
+    } else if (oldValue.size() < newValue.size()) { // entries added
+      hasDifferences = true;
+      for (int i = minSize; i < newValue.size(); ++i) {
+        traverser.push(folly::to<std::string>(i), TCType<ValueTypeClass>);
+        visitAddedOrRemovedThriftValue<ValueTypeClass>(
+            traverser, nullptr, &newValue[i], options, std::forward<Func>(f));
+        traverser.pop(TCType<ValueTypeClass>);
+      }
+    }
+
+    for (int i = 0; i < minSize; ++i) {
+      if (oldValue[i] != newValue[i]) {
+        traverser.push(folly::to<std::string>(i), TCType<ValueTypeClass>);
+        if (ThriftValueDeltaVisitor<ValueTypeClass>::visit(
+                traverser,
+                oldValue[i],
+                newValue[i],
+                options,
+                std::forward<Func>(f))) {
+          hasDifferences = true;
+        }
+        traverser.pop(TCType<ValueTypeClass>);
+      }
+    }
+
+    return hasDifferences;
+  }
+};
+
+template <typename KeyTypeClass, typename MappedTypeClass>
+struct ThriftValueDeltaVisitor<
+    apache::thrift::type_class::map<KeyTypeClass, MappedTypeClass>> {
+  using TC = apache::thrift::type_class::map<KeyTypeClass, MappedTypeClass>;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visit(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    return visitThriftValue<TC>(
+        traverser, oldValue, newValue, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visitChildren(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    bool hasDifferences{false};
+
+    // changed and removed entries
+    for (const auto& [key, val] : oldValue) {
+      auto it = newValue.find(key);
+      if (it != newValue.end() && it->second == val) {
+        continue;
+      }
+      traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+      if (it != newValue.end()) {
+        if (ThriftValueDeltaVisitor<MappedTypeClass>::visit(
+                traverser, val, it->second, options, std::forward<Func>(f))) {
+          hasDifferences = true;
+        }
+      } else {
+        hasDifferences = true;
+        visitAddedOrRemovedThriftValue<MappedTypeClass>(
+            traverser, &val, nullptr, options, std::forward<Func>(f));
+      }
+      traverser.pop(TCType<MappedTypeClass>);
+    }
+
+    // added entries
+    for (const auto& [key, val] : newValue) {
+      if (oldValue.find(key) == oldValue.end()) {
+        hasDifferences = true;
+        traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+        visitAddedOrRemovedThriftValue<MappedTypeClass>(
+            traverser, nullptr, &val, options, std::forward<Func>(f));
+        traverser.pop(TCType<MappedTypeClass>);
+      }
+    }
+
+    return hasDifferences;
+  }
+};
+
+template <>
+struct ThriftValueDeltaVisitor<apache::thrift::type_class::variant> {
+  using TC = apache::thrift::type_class::variant;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visit(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    return visitThriftValue<TC>(
+        traverser, oldValue, newValue, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visitChildren(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    using descriptors =
+        typename apache::thrift::reflect_variant<TType>::traits::descriptors;
+
+    bool hasDifferences{false};
+    fatal::foreach<descriptors>([&](auto tag) {
+      using descriptor = decltype(fatal::tag_type(tag));
+      using getter = typename descriptor::getter;
+      using tc = typename descriptor::metadata::type_class;
+      constexpr auto id = descriptor::metadata::id::value;
+
+      bool wasSet = oldValue.getType() == id;
+      bool isSet = newValue.getType() == id;
+      if (!wasSet && !isSet) {
+        return;
+      }
+
+      traverser.push(
+          getMemberName<typename descriptor::metadata>(options.outputIdPaths),
+          TCType<tc>);
+      if (wasSet && isSet) {
+        if (ThriftValueDeltaVisitor<tc>::visit(
+                traverser,
+                getter()(oldValue),
+                getter()(newValue),
+                options,
+                std::forward<Func>(f))) {
+          hasDifferences = true;
+        }
+      } else {
+        hasDifferences = true;
+        visitAddedOrRemovedThriftValue<tc>(
+            traverser,
+            wasSet ? &getter()(oldValue) : nullptr,
+            isSet ? &getter()(newValue) : nullptr,
+            options,
+            std::forward<Func>(f));
+      }
+      traverser.pop(TCType<tc>);
+    });
+
+    return hasDifferences;
+  }
+};
+
+template <>
+struct ThriftValueDeltaVisitor<apache::thrift::type_class::structure> {
+  using TC = apache::thrift::type_class::structure;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visit(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    return visitThriftValue<TC>(
+        traverser, oldValue, newValue, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visitChildren(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    using Members = typename apache::thrift::reflect_struct<TType>::members;
+
+    bool hasDifferences{false};
+
+    fatal::foreach<Members>([&](auto indexed) {
+      using member = decltype(fatal::tag_type(indexed));
+      using tc = typename member::type_class;
+
+      auto oldField = typename member::field_ref_getter{}(oldValue);
+      auto newField = typename member::field_ref_getter{}(newValue);
+
+      if constexpr (
+          member::optional::value == apache::thrift::optionality::optional) {
+        if (!oldField.has_value() && !newField.has_value()) {
+          return;
+        } else if (!oldField.has_value() || !newField.has_value()) {
+          hasDifferences = true;
+          traverser.push(
+              getMemberName<member>(options.outputIdPaths), TCType<tc>);
+          visitAddedOrRemovedThriftValue<tc>(
+              traverser,
+              oldField.has_value() ? &*oldField : nullptr,
+              newField.has_value() ? &*newField : nullptr,
+              options,
+              std::forward<Func>(f));
+          traverser.pop(TCType<tc>);
+          return;
+        }
+      }
+
+      // skip unchanged members without touching the traverse helper
+      if (*oldField == *newField) {
+        return;
+      }
+
+      traverser.push(getMemberName<member>(options.outputIdPaths), TCType<tc>);
+      if (ThriftValueDeltaVisitor<tc>::visit(
+              traverser, *oldField, *newField, options, std::forward<Func>(f))) {
+        hasDifferences = true;
+      }
+      traverser.pop(TCType<tc>);
+    });
+
+    return hasDifferences;
+  }
+};
+
+// Primitives
+template <typename TC>
+struct ThriftValueDeltaVisitor {
+  template <typename TType, typename TraverseHelper, typename Func>
+  static bool visit(
+      TraverseHelper& traverser,
+      const TType& oldValue,
+      const TType& newValue,
+      const DeltaVisitOptions& /*options*/,
+      Func&& f) {
+    if (oldValue != newValue) {
+      invokeThriftValueVisitorFn<TC>(
+          traverser,
+          &oldValue,
+          &newValue,
+          DeltaElemTag::MINIMAL,
+          std::forward<Func>(f));
+      return true;
+    }
+    return false;
+  }
+};
+
+/*
+ * Hybrid nodes hold a plain thrift object. By default deltas end at the
+ * hybrid node itself, reported as a minimal change. With
+ * hybridNodeDeepTraversal, and only if the traverse helper wants to recurse
+ * below the hybrid node, deltas are emitted for the values inside the thrift
+ * object as they would be for a tree of nodes.
+ */
+template <
+    typename TC,
+    typename Node,
+    typename TraverseHelper,
+    typename Func,
+    // only enable for hybrid nodes
+    std::enable_if_t<
+        std::is_same_v<typename Node::CowType, HybridNodeType>,
+        bool> = true>
+bool visitHybridNode(
+    TraverseHelper& traverser,
+    const std::shared_ptr<Node>& oldNode,
+    const std::shared_ptr<Node>& newNode,
+    const DeltaVisitOptions& options,
+    Func&& f) {
+  if (oldNode == newNode) {
+    return false;
+  }
+
+  if (!options.hybridNodeDeepTraversal ||
+      traverser.shouldShortCircuit(VisitorType::RECURSE)) {
+    if (*oldNode == *newNode) {
+      return false;
+    }
+    invokeVisitorFnHelper(
+        traverser,
+        oldNode,
+        newNode,
+        DeltaElemTag::MINIMAL,
+        std::forward<Func>(f));
+    return true;
+  }
+
+  auto hasDifferences = ThriftValueDeltaVisitor<TC>::visitChildren(
+      traverser,
+      oldNode->cref(),
+      newNode->cref(),
+      options,
+      std::forward<Func>(f));
+
+  if (hasDifferences &&
+      (options.mode == DeltaVisitMode::PARENTS ||
+       options.mode == DeltaVisitMode::FULL)) {
+    invokeVisitorFnHelper(
+        traverser,
+        oldNode,
+        newNode,
+        DeltaElemTag::NOT_MINIMAL,
+        std::forward<Func>(f));
+  }
+
+  return hasDifferences;
+}
+
+template <
+    typename TC,
+    typename Node,
+    typename TraverseHelper,
+    typename Func,
+    // only enable for hybrid nodes
+    std::enable_if_t<
+        std::is_same_v<typename Node::CowType, HybridNodeType>,
+        bool> = true>
+void visitAddedOrRemovedNode(
+    TraverseHelper& traverser,
+    const std::shared_ptr<Node>& oldNode,
+    const std::shared_ptr<Node>& newNode,
+    const DeltaVisitOptions& options,
+    Func&& f) {
+  // Exactly one node must be non-null
+  DCHECK(static_cast<bool>(oldNode) != static_cast<bool>(newNode));
+
+  if (options.order == DeltaVisitOrder::PARENTS_FIRST) {
+    invokeVisitorFnHelper(
+        traverser,
+        oldNode,
+        newNode,
+        DeltaElemTag::MINIMAL,
+        std::forward<Func>(f));
+  }
+
+  if (options.hybridNodeDeepTraversal &&
+      options.mode == DeltaVisitMode::FULL &&
+      !traverser.shouldShortCircuit(VisitorType::RECURSE)) {
+    bool isAdd = static_cast<bool>(newNode);
+    const auto& target = (newNode) ? newNode : oldNode;
+    visitAddedOrRemovedThriftValueChildren<TC>(
+        traverser, target->cref(), isAdd, options, std::forward<Func>(f));
+  }
+
+  if (options.order != DeltaVisitOrder::PARENTS_FIRST) {
+    invokeVisitorFnHelper(
+        traverser,
+        oldNode,
+        newNode,
+        DeltaElemTag::MINIMAL,
+        std::forward<Func>(f));
+  }
+}
+
 template <typename TC, typename Node, typename TraverseHelper, typename Func>
 void visitAddedOrRemovedNode(
     TraverseHelper& traverser,
@@ -680,6 +1259,24 @@ struct DeltaVisitor<apache::thrift::type_class::structure> {
         traverser, oldNode, newNode, options, std::forward<Func>(f));
   }
 
+  template <
+      typename Node,
+      typename TraverseHelper,
+      typename Func,
+      // only enable for hybrid nodes
+      std::enable_if_t<
+          std::is_same_v<typename Node::CowType, HybridNodeType>,
+          bool> = true>
+  static inline bool visit(
+      TraverseHelper& traverser,
+      const std::shared_ptr<Node>& oldNode,
+      const std::shared_ptr<Node>& newNode,
+      const DeltaVisitOptions& options,
+      Func&& f) {
+    return dv_detail::visitHybridNode<TC>(
+        traverser, oldNode, newNode, options, std::forward<Func>(f));
+  }
+
   template <
       typename Fields,
       typename TraverseHelper,
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <type_traits>
+#include <utility>
 
 #include <fboss/thrift_cow/visitors/VisitorUtils.h>
 #include <re2/re2.h>
@@ -26,6 +27,7 @@ struct ExtendedPathVisitor;
 
 struct NodeType;
 struct FieldsType;
+struct HybridNodeType;
 
 struct ExtPathVisitorOptions {
   explicit ExtPathVisitorOptions(bool outputIdPaths = false)
@@ -124,6 +126,192 @@ std::optional<std::string> matchingToken(
   return std::nullopt;
 }
 
+/*
+ * Plain thrift values held by hybrid nodes. Matching paths inside the thrift
+ * object are visited through a temporary node.
+ */
+template <typename TC>
+struct ThriftValueExtPathVisitor;
+
+template <typename TC, typename TType, typename Func>
+void visitThriftValue(
+    std::vector<std::string>& path,
+    const TType& value,
+    ExtPathIter begin,
+    ExtPathIter end,
+    const ExtPathVisitorOptions& options,
+    Func&& f) {
+  if (begin == end) {
+    const auto node = makeHybridValueNode<TC>(value);
+    f(path, std::as_const(*node));
+    return;
+  }
+  ThriftValueExtPathVisitor<TC>::visitChildren(
+      path, value, begin, end, options, std::forward<Func>(f));
+}
+
+template <typename ValueTypeClass>
+struct ThriftValueExtPathVisitor<
+    apache::thrift::type_class::set<ValueTypeClass>> {
+  template <typename TType, typename Func>
+  static void visitChildren(
+      std::vector<std::string>& path,
+      const TType& value,
+      ExtPathIter begin,
+      ExtPathIter end,
+      const ExtPathVisitorOptions& options,
+      Func&& f) {
+    const auto& elem = *begin++;
+    for (const auto& val : value) {
+      if (auto matching = matchingToken<ValueTypeClass>(val, elem)) {
+        path.push_back(*matching);
+        visitThriftValue<ValueTypeClass>(
+            path, val, begin, end, options, std::forward<Func>(f));
+        path.pop_back();
+      }
+    }
+  }
+};
+
+template <typename ValueTypeClass>
+struct ThriftValueExtPathVisitor<
+    apache::thrift::type_class::list<ValueTypeClass>> {
+  template <typename TType, typename Func>
+  static void visitChildren(
+      std::vector<std::string>& path,
+      const TType& value,
+      ExtPathIter begin,
+      ExtPathIter end,
+      const ExtPathVisitorOptions& options,
+      Func&& f) {
+    const auto& elem = *begin++;
+    for (int i = 0; i < value.size(); ++i) {
+      if (auto matching =
+              matchingToken<apache::thrift::type_class::integral>(i, elem)) {
+        path.push_back(*matching);
+        visitThriftValue<ValueTypeClass>(
+            path, value[i], begin, end, options, std::forward<Func>(f));
+        path.pop_back();
+      }
+    }
+  }
+};
+
+template <typename KeyTypeClass, typename MappedTypeClass>
+struct ThriftValueExtPathVisitor<
+    apache::thrift::type_class::map<KeyTypeClass, MappedTypeClass>> {
+  template <typename TType, typename Func>
+  static void visitChildren(
+      std::vector<std::string>& path,
+      const TType& value,
+      ExtPathIter begin,
+      ExtPathIter end,
+      const ExtPathVisitorOptions& options,
+      Func&& f) {
+    const auto& elem = *begin++;
+    for (const auto& [key, val] : value) {
+      if (auto matching = matchingToken<KeyTypeClass>(key, elem)) {
+        path.push_back(*matching);
+        visitThriftValue<MappedTypeClass>(
+            path, val, begin, end, options, std::forward<Func>(f));
+        path.pop_back();
+      }
+    }
+  }
+};
+
+template <>
+struct ThriftValueExtPathVisitor<apache::thrift::type_class::variant> {
+  template <typename TType, typename Func>
+  static void visitChildren(
+      std::vector<std::string>& path,
+      const TType& value,
+      ExtPathIter begin,
+      ExtPathIter end,
+      const ExtPathVisitorOptions& options,
+      Func&& f) {
+    const auto& elem = *begin++;
+    auto raw = elem.raw_ref();
+    if (!raw) {
+      // wildcards not supported for variant members
+      return;
+    }
+
+    using descriptors =
+        typename apache::thrift::reflect_variant<TType>::traits::descriptors;
+    fatal::foreach<descriptors>([&](auto tag) {
+      using descriptor = decltype(fatal::tag_type(tag));
+      using metadata = typename descriptor::metadata;
+      using tc = typename metadata::type_class;
+      if ((*raw != getMemberName<metadata>(false) &&
+           *raw != getMemberName<metadata>(true)) ||
+          value.getType() != metadata::id::value) {
+        return;
+      }
+      path.push_back(getMemberName<metadata>(options.outputIdPaths));
+      visitThriftValue<tc>(
+          path,
+          typename descriptor::getter()(value),
+          begin,
+          end,
+          options,
+          std::forward<Func>(f));
+      path.pop_back();
+    });
+  }
+};
+
+template <>
+struct ThriftValueExtPathVisitor<apache::thrift::type_class::structure> {
+  template <typename TType, typename Func>
+  static void visitChildren(
+      std::vector<std::string>& path,
+      const TType& value,
+      ExtPathIter begin,
+      ExtPathIter end,
+      const ExtPathVisitorOptions& options,
+      Func&& f) {
+    const auto& elem = *begin++;
+    auto raw = elem.raw_ref();
+    if (!raw) {
+      // wildcards not supported for struct members
+      return;
+    }
+
+    using Members = typename apache::thrift::reflect_struct<TType>::members;
+    visitMember<Members>(*raw, [&](auto indexed) {
+      using member = decltype(fatal::tag_type(indexed));
+      using tc = typename member::type_class;
+
+      auto field = typename member::field_ref_getter{}(value);
+      if constexpr (
+          member::optional::value == apache::thrift::optionality::optional) {
+        if (!field.has_value()) {
+          // cannot traverse through missing optional child
+          return;
+        }
+      }
+      path.push_back(getMemberName<member>(options.outputIdPaths));
+      visitThriftValue<tc>(
+          path, *field, begin, end, options, std::forward<Func>(f));
+      path.pop_back();
+    });
+  }
+};
+
+// Primitives have no children to match
+template <typename TC>
+struct ThriftValueExtPathVisitor {
+  template <typename TType, typename Func>
+  static void visitChildren(
+      std::vector<std::string>& /* path */,
+      const TType& /* value */,
+      ExtPathIter /* begin */,
+      ExtPathIter /* end */,
+      const ExtPathVisitorOptions& /* options */,
+      Func&& /* f */) {}
+};
+
 } // namespace epv_detail
 
 /**
@@ -420,6 +608,29 @@ struct ExtendedPathVisitor<apache::thrift::type_class::structure> {
         path, node, begin, end, options, std::forward<Func>(f));
   }
 
+  template <
+      typename Node,
+      typename Func,
+      // only enable for hybrid nodes
+      std::enable_if_t<
+          std::is_same_v<typename Node::CowType, HybridNodeType>,
+          bool> = true>
+  static inline void visit(
+      std::vector<std::string>& path,
+      Node& node,
+      epv_detail::ExtPathIter begin,
+      epv_detail::ExtPathIter end,
+      const ExtPathVisitorOptions& options,
+      Func&& f) {
+    if (begin == end) {
+      f(path, node);
+      return;
+    }
+    // the rest of the path is matched inside the thrift object
+    epv_detail::ThriftValueExtPathVisitor<TC>::visitChildren(
+        path, node.cref(), begin, end, options, std::forward<Func>(f));
+  }
+
   template <
       typename Fields,
       typename Func,
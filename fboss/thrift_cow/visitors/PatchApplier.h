@@ -34,6 +34,16 @@ patchNode(Node& n, ByteBuffer&& buf, const fsdb::OperProtocol& protocol) {
   return PatchApplyResult::OK;
 }
 
+// Hybrid nodes are patched through the thrift object they hold
+template <typename Node>
+inline auto& patchTarget(Node& node) {
+  if constexpr (is_hybrid_node_v<Node>) {
+    return node.ref();
+  } else {
+    return node;
+  }
+}
+
 std::vector<int> getSortedIndices(const ListPatch& node);
 } // namespace pa_detail
 
@@ -67,7 +77,8 @@ struct PatchApplier<
       PatchNode&& patch,
       const fsdb::OperProtocol& protocol = fsdb::OperProtocol::COMPACT) {
     PatchTraverser traverser;
-    return apply(node, std::move(patch), protocol, traverser);
+    return apply(
+        pa_detail::patchTarget(node), std::move(patch), protocol, traverser);
   }
 
   template <typename Node>
@@ -151,7 +162,8 @@ struct PatchApplier<apache::thrift::type_class::list<ValueTypeClass>> {
       PatchNode&& patch,
       const fsdb::OperProtocol& protocol = fsdb::OperProtocol::COMPACT) {
     PatchTraverser traverser;
-    return apply(node, std::move(patch), protocol, traverser);
+    return apply(
+        pa_detail::patchTarget(node), std::move(patch), protocol, traverser);
   }
 
   template <typename Node>
@@ -240,7 +252,8 @@ struct PatchApplier<apache::thrift::type_class::set<KeyTypeClass>> {
       PatchNode&& patch,
       const fsdb::OperProtocol& protocol = fsdb::OperProtocol::COMPACT) {
     PatchTraverser traverser;
-    return apply(node, std::move(patch), protocol, traverser);
+    return apply(
+        pa_detail::patchTarget(node), std::move(patch), protocol, traverser);
   }
 
   template <typename Node>
@@ -306,7 +319,8 @@ struct PatchApplier<apache::thrift::type_class::variant> {
       PatchNode&& patch,
       const fsdb::OperProtocol& protocol = fsdb::OperProtocol::COMPACT) {
     PatchTraverser traverser;
-    return apply(node, std::move(patch), protocol, traverser);
+    return apply(
+        pa_detail::patchTarget(node), std::move(patch), protocol, traverser);
   }
 
   template <typename Node>
@@ -408,7 +422,8 @@ struct PatchApplier<apache::thrift::type_class::structure> {
       PatchNode&& patch,
       const fsdb::OperProtocol& protocol = fsdb::OperProtocol::COMPACT) {
     PatchTraverser traverser;
-    return apply(node, std::move(patch), protocol, traverser);
+    return apply(
+        pa_detail::patchTarget(node), std::move(patch), protocol, traverser);
   }
 
   template <typename Node>
@@ -530,7 +545,8 @@ struct PatchApplier {
       PatchNode&& patch,
       const fsdb::OperProtocol& protocol = fsdb::OperProtocol::COMPACT) {
     PatchTraverser traverser;
-    return apply(node, std::move(patch), protocol, traverser);
+    return apply(
+        pa_detail::patchTarget(node), std::move(patch), protocol, traverser);
   }
 
   template <typename Fields>
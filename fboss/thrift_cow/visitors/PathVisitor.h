@@ -122,6 +122,10 @@ enum class ThriftTraverseResult {
 
 struct NodeType;
 struct FieldsType;
+struct HybridNodeType;
+
+template <typename TypeClass, typename TType>
+class ThriftHybridNode;
 
 enum class PathVisitMode {
   /*
@@ -206,6 +210,213 @@ ThriftTraverseResult visitNode(
   }
 }
 
+/**
+ * Plain thrift objects held by hybrid nodes. There are no nodes below a
+ * hybrid node, so the end of the path is wrapped in a temporary
+ * ThriftHybridNode for the operator to visit. Changes made by the operator
+ * are copied back into the thrift object.
+ */
+template <typename TC>
+struct ThriftValueVisitor;
+
+template <typename TC, typename Value, typename Op>
+ThriftTraverseResult
+visitThriftValue(Value& value, PathIter begin, PathIter end, Op& op) {
+  using Wrapper = ThriftHybridNode<TC, std::remove_const_t<Value>>;
+  try {
+    if constexpr (std::is_const_v<Value>) {
+      const Wrapper wrapper(value);
+      op.visitTyped(wrapper, begin, end);
+    } else {
+      Wrapper wrapper(value);
+      op.visitTyped(wrapper, begin, end);
+      value = std::move(wrapper.ref());
+    }
+  } catch (const std::exception& ex) {
+    XLOG(ERR) << "Exception while traversing path: " << ex.what();
+    return ThriftTraverseResult::VISITOR_EXCEPTION;
+  }
+  return ThriftTraverseResult::OK;
+}
+
+template <typename ValueTypeClass>
+struct ThriftValueVisitor<apache::thrift::type_class::set<ValueTypeClass>> {
+  using TC = apache::thrift::type_class::set<ValueTypeClass>;
+
+  template <typename Value, typename Op>
+  static ThriftTraverseResult
+  visit(Value& value, PathIter begin, PathIter end, Op& op) {
+    if (begin == end) {
+      return visitThriftValue<TC>(value, begin, end, op);
+    }
+    using ValueTType = typename std::remove_const_t<Value>::value_type;
+    if (auto member = tryParseKey<ValueTType, ValueTypeClass>(*begin++)) {
+      if (auto it = value.find(*member); it != value.end()) {
+        // set members are always const
+        const auto& next = *it;
+        return ThriftValueVisitor<ValueTypeClass>::visit(next, begin, end, op);
+      }
+      return ThriftTraverseResult::NON_EXISTENT_NODE;
+    }
+    return ThriftTraverseResult::INVALID_SET_MEMBER;
+  }
+};
+
+template <typename ValueTypeClass>
+struct ThriftValueVisitor<apache::thrift::type_class::list<ValueTypeClass>> {
+  using TC = apache::thrift::type_class::list<ValueTypeClass>;
+
+  template <typename Value, typename Op>
+  static ThriftTraverseResult
+  visit(Value& value, PathIter begin, PathIter end, Op& op) {
+    if (begin == end) {
+      return visitThriftValue<TC>(value, begin, end, op);
+    }
+    auto index = folly::tryTo<size_t>(*begin++);
+    if (index.hasError() || index.value() >= value.size()) {
+      return ThriftTraverseResult::INVALID_ARRAY_INDEX;
+    }
+    return ThriftValueVisitor<ValueTypeClass>::visit(
+        value[index.value()], begin, end, op);
+  }
+};
+
+template <typename KeyTypeClass, typename MappedTypeClass>
+struct ThriftValueVisitor<
+    apache::thrift::type_class::map<KeyTypeClass, MappedTypeClass>> {
+  using TC = apache::thrift::type_class::map<KeyTypeClass, MappedTypeClass>;
+
+  template <typename Value, typename Op>
+  static ThriftTraverseResult
+  visit(Value& value, PathIter begin, PathIter end, Op& op) {
+    if (begin == end) {
+      return visitThriftValue<TC>(value, begin, end, op);
+    }
+    using key_type = typename std::remove_const_t<Value>::key_type;
+    if (auto key = tryParseKey<key_type, KeyTypeClass>(*begin++)) {
+      if (auto it = value.find(key.value()); it != value.end()) {
+        return ThriftValueVisitor<MappedTypeClass>::visit(
+            it->second, begin, end, op);
+      }
+      return ThriftTraverseResult::NON_EXISTENT_NODE;
+    }
+    return ThriftTraverseResult::INVALID_MAP_KEY;
+  }
+};
+
+template <>
+struct ThriftValueVisitor<apache::thrift::type_class::variant> {
+  using TC = apache::thrift::type_class::variant;
+
+  template <typename Value, typename Op>
+  static ThriftTraverseResult
+  visit(Value& value, PathIter begin, PathIter end, Op& op) {
+    if (begin == end) {
+      return visitThriftValue<TC>(value, begin, end, op);
+    }
+    using descriptors = typename apache::thrift::reflect_variant<
+        std::remove_const_t<Value>>::traits::descriptors;
+
+    auto key = *begin++;
+    auto result = ThriftTraverseResult::INVALID_VARIANT_MEMBER;
+    fatal::foreach<descriptors>([&](auto tag) {
+      using descriptor = decltype(fatal::tag_type(tag));
+      using tc = typename descriptor::metadata::type_class;
+      if (key != getMemberName<typename descriptor::metadata>(false) &&
+          key != getMemberName<typename descriptor::metadata>(true)) {
+        return;
+      }
+      if (value.getType() != descriptor::metadata::id::value) {
+        result = ThriftTraverseResult::INCORRECT_VARIANT_MEMBER;
+        return;
+      }
+      result = ThriftValueVisitor<tc>::visit(
+          typename descriptor::getter()(value), begin, end, op);
+    });
+    return result;
+  }
+};
+
+template <>
+struct ThriftValueVisitor<apache::thrift::type_class::structure> {
+  using TC = apache::thrift::type_class::structure;
+
+  template <typename Value, typename Op>
+  static ThriftTraverseResult
+  visit(Value& value, PathIter begin, PathIter end, Op& op) {
+    if (begin == end) {
+      return visitThriftValue<TC>(value, begin, end, op);
+    }
+    using Members = typename apache::thrift::reflect_struct<
+        std::remove_const_t<Value>>::members;
+
+    auto key = *begin++;
+    auto result = ThriftTraverseResult::INVALID_STRUCT_MEMBER;
+    visitMember<Members>(key, [&](auto indexed) {
+      using member = decltype(fatal::tag_type(indexed));
+      using tc = typename member::type_class;
+      auto field = typename member::field_ref_getter{}(value);
+      if constexpr (
+          member::optional::value == apache::thrift::optionality::optional) {
+        if (!field.has_value()) {
+          // cannot traverse through missing optional child
+          result = ThriftTraverseResult::NON_EXISTENT_NODE;
+          return;
+        }
+      }
+      result = ThriftValueVisitor<tc>::visit(*field, begin, end, op);
+    });
+    return result;
+  }
+};
+
+// Primitives
+template <typename TC>
+struct ThriftValueVisitor {
+  template <typename Value, typename Op>
+  static ThriftTraverseResult
+  visit(Value& value, PathIter begin, PathIter end, Op& op) {
+    if (begin == end) {
+      return visitThriftValue<TC>(value, begin, end, op);
+    }
+    return ThriftTraverseResult::NON_EXISTENT_NODE;
+  }
+};
+
+template <
+    typename TC,
+    typename Node,
+    typename Op,
+    // only enable for hybrid nodes
+    std::enable_if_t<
+        std::is_same_v<typename Node::CowType, HybridNodeType>,
+        bool> = true>
+ThriftTraverseResult visitHybridNode(
+    Node& node,
+    PathIter begin,
+    PathIter end,
+    const PathVisitMode& mode,
+    Op& op) {
+  if (mode == PathVisitMode::FULL || begin == end) {
+    try {
+      op.visitTyped(node, begin, end);
+      if (begin == end) {
+        return ThriftTraverseResult::OK;
+      }
+    } catch (const std::exception& ex) {
+      XLOG(ERR) << "Exception while traversing path: " << ex.what();
+      return ThriftTraverseResult::VISITOR_EXCEPTION;
+    }
+  }
+
+  // only the end of the path is visited inside the thrift object
+  if constexpr (std::is_const_v<Node>) {
+    return ThriftValueVisitor<TC>::visit(node.cref(), begin, end, op);
+  } else {
+    return ThriftValueVisitor<TC>::visit(node.ref(), begin, end, op);
+  }
+}
+
 /**
  * Set
  */
@@ -464,6 +675,22 @@ struct PathVisitorImpl<apache::thrift::type_class::structure> {
     return pv_detail::visitNode<TC>(node, begin, end, mode, op);
   }
 
+  template <
+      typename Node,
+      typename Op,
+      // only enable for hybrid nodes
+      std::enable_if_t<
+          std::is_same_v<typename Node::CowType, HybridNodeType>,
+          bool> = true>
+  static inline ThriftTraverseResult visit(
+      Node& node,
+      pv_detail::PathIter begin,
+      pv_detail::PathIter end,
+      const PathVisitMode& mode,
+      Op& op) {
+    return pv_detail::visitHybridNode<TC>(node, begin, end, mode, op);
+  }
+
   template <
       typename Fields,
       typename Op,
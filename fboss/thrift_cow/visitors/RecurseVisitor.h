@@ -43,11 +43,18 @@ struct RecurseVisitOptions {
   RecurseVisitOptions(
       RecurseVisitMode mode,
       RecurseVisitOrder order,
-      bool outputIdPaths = false)
-      : mode(mode), order(order), outputIdPaths(outputIdPaths) {}
+      bool outputIdPaths = false,
+      bool hybridNodeDeepTraversal = false)
+      : mode(mode),
+        order(order),
+        outputIdPaths(outputIdPaths),
+        hybridNodeDeepTraversal(hybridNodeDeepTraversal) {}
   RecurseVisitMode mode;
   RecurseVisitOrder order;
   bool outputIdPaths;
+  // Visit the values inside hybrid nodes through temporary nodes, instead of
+  // treating hybrid nodes as leaves
+  bool hybridNodeDeepTraversal;
 };
 
 template <typename>
@@ -55,6 +62,7 @@ struct RecurseVisitor;
 
 struct NodeType;
 struct FieldsType;
+struct HybridNodeType;
 
 namespace rv_detail {
 
@@ -124,6 +132,279 @@ void visitNode(
   }
 }
 
+/*
+ * Plain thrift values held by hybrid nodes. These are walked like the node
+ * visitors below walk nodes, with each visited value handed to the visitor
+ * as a temporary node.
+ */
+template <typename TC>
+struct ThriftValueRecurseVisitor;
+
+template <typename TC, typename TType, typename TraverseHelper, typename Func>
+void visitThriftValueNode(
+    TraverseHelper& traverser,
+    const TType& value,
+    Func&& f) {
+  const auto node = makeHybridValueNode<TC>(value);
+  invokeVisitorFnHelper(traverser, node, std::forward<Func>(f));
+}
+
+template <typename TC, typename TType, typename TraverseHelper, typename Func>
+void visitThriftValue(
+    TraverseHelper& traverser,
+    const TType& value,
+    RecurseVisitOptions options,
+    Func&& f) {
+  if (traverser.shouldShortCircuit(VisitorType::RECURSE)) {
+    return;
+  }
+
+  bool visitIntermediate = options.mode == RecurseVisitMode::FULL ||
+      options.mode == RecurseVisitMode::UNPUBLISHED;
+  if (visitIntermediate && options.order == RecurseVisitOrder::PARENTS_FIRST) {
+    visitThriftValueNode<TC>(traverser, value, std::forward<Func>(f));
+  }
+
+  ThriftValueRecurseVisitor<TC>::visitChildren(
+      traverser, value, options, std::forward<Func>(f));
+
+  if (visitIntermediate && options.order == RecurseVisitOrder::CHILDREN_FIRST) {
+    visitThriftValueNode<TC>(traverser, value, std::forward<Func>(f));
+  }
+}
+
+template <typename ValueTypeClass>
+struct ThriftValueRecurseVisitor<
+    apache::thrift::type_class::set<ValueTypeClass>> {
+  using TC = apache::thrift::type_class::set<ValueTypeClass>;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visit(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions options,
+      Func&& f) {
+    visitThriftValue<TC>(traverser, value, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visitChildren(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions /*options*/,
+      Func&& f) {
+    for (const auto& val : value) {
+      traverser.push(folly::to<std::string>(val), TCType<ValueTypeClass>);
+      visitThriftValueNode<ValueTypeClass>(
+          traverser, val, std::forward<Func>(f));
+      traverser.pop(TCType<ValueTypeClass>);
+    }
+  }
+};
+
+template <typename ValueTypeClass>
+struct ThriftValueRecurseVisitor<
+    apache::thrift::type_class::list<ValueTypeClass>> {
+  using TC = apache::thrift::type_class::list<ValueTypeClass>;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visit(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions options,
+      Func&& f) {
+    visitThriftValue<TC>(traverser, value, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visitChildren(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions options,
+      Func&& f) {
+    for (int i = 0; i < value.size(); ++i) {
+      traverser.push(folly::to<std::string>(i), TCType<ValueTypeClass>);
+      ThriftValueRecurseVisitor<ValueTypeClass>::visit(
+          traverser, value[i], options, std::forward<Func>(f));
+      traverser.pop(TCType<ValueTypeClass>);
+    }
+  }
+};
+
+template <typename KeyTypeClass, typename MappedTypeClass>
+struct ThriftValueRecurseVisitor<
+    apache::thrift::type_class::map<KeyTypeClass, MappedTypeClass>> {
+  using TC = apache::thrift::type_class::map<KeyTypeClass, MappedTypeClass>;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visit(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions options,
+      Func&& f) {
+    visitThriftValue<TC>(traverser, value, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visitChildren(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions options,
+      Func&& f) {
+    for (const auto& [key, val] : value) {
+      traverser.push(folly::to<std::string>(key), TCType<MappedTypeClass>);
+      ThriftValueRecurseVisitor<MappedTypeClass>::visit(
+          traverser, val, options, std::forward<Func>(f));
+      traverser.pop(TCType<MappedTypeClass>);
+    }
+  }
+};
+
+template <>
+struct ThriftValueRecurseVisitor<apache::thrift::type_class::variant> {
+  using TC = apache::thrift::type_class::variant;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visit(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions options,
+      Func&& f) {
+    visitThriftValue<TC>(traverser, value, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visitChildren(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions options,
+      Func&& f) {
+    using descriptors =
+        typename apache::thrift::reflect_variant<TType>::traits::descriptors;
+
+    fatal::foreach<descriptors>([&](auto tag) {
+      using descriptor = decltype(fatal::tag_type(tag));
+      using tc = typename descriptor::metadata::type_class;
+      if (value.getType() != descriptor::metadata::id::value) {
+        return;
+      }
+
+      traverser.push(
+          getMemberName<typename descriptor::metadata>(options.outputIdPaths),
+          TCType<tc>);
+      ThriftValueRecurseVisitor<tc>::visit(
+          traverser,
+          typename descriptor::getter()(value),
+          options,
+          std::forward<Func>(f));
+      traverser.pop(TCType<tc>);
+    });
+  }
+};
+
+template <>
+struct ThriftValueRecurseVisitor<apache::thrift::type_class::structure> {
+  using TC = apache::thrift::type_class::structure;
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visit(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions options,
+      Func&& f) {
+    visitThriftValue<TC>(traverser, value, options, std::forward<Func>(f));
+  }
+
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visitChildren(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions options,
+      Func&& f) {
+    using Members = typename apache::thrift::reflect_struct<TType>::members;
+
+    fatal::foreach<Members>([&](auto indexed) {
+      using member = decltype(fatal::tag_type(indexed));
+      using tc = typename member::type_class;
+
+      auto field = typename member::field_ref_getter{}(value);
+      if constexpr (
+          member::optional::value == apache::thrift::optionality::optional) {
+        if (!field.has_value()) {
+          return;
+        }
+      }
+
+      traverser.push(
+          getMemberName<member>(options.outputIdPaths), TCType<tc>);
+      ThriftValueRecurseVisitor<tc>::visit(
+          traverser, *field, options, std::forward<Func>(f));
+      traverser.pop(TCType<tc>);
+    });
+  }
+};
+
+// Primitives
+template <typename TC>
+struct ThriftValueRecurseVisitor {
+  template <typename TType, typename TraverseHelper, typename Func>
+  static void visit(
+      TraverseHelper& traverser,
+      const TType& value,
+      RecurseVisitOptions /*options*/,
+      Func&& f) {
+    visitThriftValueNode<TC>(traverser, value, std::forward<Func>(f));
+  }
+};
+
+/*
+ * Hybrid nodes hold a plain thrift object. They are visited as leaves unless
+ * hybridNodeDeepTraversal is set, in which case the thrift object is walked
+ * as if it were a tree of nodes.
+ */
+template <
+    typename TC,
+    typename NodePtr,
+    typename TraverseHelper,
+    typename Func,
+    // only enable for hybrid nodes
+    std::enable_if_t<
+        std::is_same_v<
+            typename folly::remove_cvref_t<NodePtr>::element_type::CowType,
+            HybridNodeType>,
+        bool> = true>
+void visitHybridNode(
+    TraverseHelper& traverser,
+    NodePtr& node,
+    RecurseVisitOptions options,
+    Func&& f) {
+  if (options.mode == RecurseVisitMode::UNPUBLISHED && node->isPublished()) {
+    return;
+  }
+
+  if (!options.hybridNodeDeepTraversal) {
+    invokeVisitorFnHelper(traverser, node, std::forward<Func>(f));
+    return;
+  }
+
+  if (traverser.shouldShortCircuit(VisitorType::RECURSE)) {
+    return;
+  }
+
+  bool visitIntermediate = options.mode == RecurseVisitMode::FULL ||
+      options.mode == RecurseVisitMode::UNPUBLISHED;
+  if (visitIntermediate && options.order == RecurseVisitOrder::PARENTS_FIRST) {
+    invokeVisitorFnHelper(traverser, node, std::forward<Func>(f));
+  }
+
+  ThriftValueRecurseVisitor<TC>::visitChildren(
+      traverser, node->cref(), options, std::forward<Func>(f));
+
+  if (visitIntermediate && options.order == RecurseVisitOrder::CHILDREN_FIRST) {
+    invokeVisitorFnHelper(traverser, node, std::forward<Func>(f));
+  }
+}
+
 } // namespace rv_detail
 
 /**
@@ -384,6 +665,25 @@ struct RecurseVisitor<apache::thrift::type_class::structure> {
         traverser, node, options, std::forward<Func>(f));
   }
 
+  template <
+      typename NodePtr,
+      typename TraverseHelper,
+      typename Func,
+      // only enable for hybrid nodes
+      std::enable_if_t<
+          std::is_same_v<
+              typename folly::remove_cvref_t<NodePtr>::element_type::CowType,
+              HybridNodeType>,
+          bool> = true>
+  static inline void visit(
+      TraverseHelper& traverser,
+      NodePtr& node,
+      RecurseVisitOptions options,
+      Func&& f) {
+    return rv_detail::visitHybridNode<TC>(
+        traverser, node, options, std::forward<Func>(f));
+  }
+
   template <
       typename Fields,
       typename TraverseHelper,
@@ -3,10 +3,14 @@
 #pragma once
 
 #include <thrift/lib/cpp2/reflection/reflection.h>
+#include <memory>
 #include "folly/Conv.h"
 
 namespace facebook::fboss::thrift_cow {
 
+template <typename TypeClass, typename TType>
+class ThriftHybridNode;
+
 template <typename Meta>
 std::string getMemberName(bool useId) {
   using name = typename Meta::name;
@@ -31,4 +35,14 @@ void visitMember(const std::string& key, Func&& f) {
   }
 }
 
+/*
+ * Values inside a hybrid node have no nodes of their own. Visitors that
+ * descend into them hand out a temporary node holding a copy of the value.
+ */
+template <typename TC, typename TType>
+std::shared_ptr<ThriftHybridNode<TC, TType>> makeHybridValueNode(
+    const TType& value) {
+  return std::make_shared<ThriftHybridNode<TC, TType>>(value);
+}
+
 } // namespace facebook::fboss::thrift_cow
@@ -72,6 +72,42 @@ TEST(PatchApplierTests, ModifyStructMember) {
   EXPECT_EQ(*nodeA->template ref<k::inlineString>(), "new val");
 }
 
+TEST(PatchApplierTests, ModifyStructFromChainedBuffer) {
+  auto structA = createSimpleTestStruct();
+  auto structB = createSimpleTestStruct();
+  structB.inlineString() = "from chain";
+  structB.inlineInt() = 4321;
+
+  // Split the encoded struct across several buffers, as when it arrives in
+  // multiple frames of a thrift stream
+  folly::IOBufQueue encoded;
+  serializeInto<apache::thrift::type_class::structure>(
+      fsdb::OperProtocol::COMPACT, structB, encoded);
+  auto contiguous = encoded.move();
+  contiguous->coalesce();
+  folly::IOBufQueue chained;
+  for (size_t offset = 0; offset < contiguous->length(); offset += 7) {
+    chained.append(folly::IOBuf::copyBuffer(
+        contiguous->data() + offset,
+        std::min<size_t>(7, contiguous->length() - offset)));
+  }
+  auto buf = chained.moveAsValue();
+  ASSERT_TRUE(buf.isChained());
+
+  PatchNode n;
+  n.set_val(std::move(buf));
+
+  auto nodeA = std::make_shared<ThriftStructNode<TestStruct>>(structA);
+  auto ret = RootPatchApplier::apply(*nodeA, PatchNode(n));
+  EXPECT_EQ(ret, PatchApplyResult::OK);
+  EXPECT_EQ(nodeA->toThrift(), structB);
+
+  // patch non cow struct
+  ret = RootPatchApplier::apply(structA, std::move(n));
+  EXPECT_EQ(ret, PatchApplyResult::OK);
+  EXPECT_EQ(structA, structB);
+}
+
 TEST(PatchApplierTests, ModifyMapMember) {
   auto structA = createSimpleTestStruct();
   structA.mapOfI32ToI32() = {{123, 456}};